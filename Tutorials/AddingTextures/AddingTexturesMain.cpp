@@ -18,11 +18,18 @@ AddingTexturesMain::AddingTexturesMain()
 	m_timer.SetFixedTimeStep(true);
 	m_timer.SetTargetElapsedSeconds(1.0 / 60);
 	*/
+
+	// 고정 timestep 모드에서 느린 프레임이 Update 호출을 계속 늘리지 않도록 틱당 Update 수를 제한합니다.
+	// 예산을 초과한 지연은 버리고, 렌더링은 GetInterpolationAlpha()로 시뮬레이션 상태 사이를 보간합니다.
+	m_timer.SetMaxUpdatesPerTick(DX::StepTimer::c_defaultMaxUpdatesPerTick);
+	m_timer.SetBacklogPolicy(DX::FixedStepBacklogPolicy::DropWholeSteps);
 }
 
 // 렌더러를 만들고 초기화합니다.
 void AddingTexturesMain::CreateRenderers(const std::shared_ptr<DX::DeviceResources>& deviceResources)
 {
+	m_deviceResources = deviceResources;
+
 	// TODO: 이 항목을 앱 콘텐츠 초기화로 대체합니다.
 	m_sceneRenderer = std::unique_ptr<Sample3DSceneRenderer>(new Sample3DSceneRenderer(deviceResources));
 
@@ -38,6 +45,9 @@ void AddingTexturesMain::Update()
 		// TODO: 이 항목을 앱 콘텐츠 업데이트 함수로 대체합니다.
 		m_sceneRenderer->Update(m_timer);
 	});
+
+	// 이번 프레임에 Update가 호출되지 않았더라도 보간된 상태로 상수 버퍼를 씁니다.
+	m_sceneRenderer->Interpolate(m_timer);
 }
 
 // 현재 응용 프로그램 상태에 따라 현재 프레임을 렌더링합니다.
@@ -72,6 +82,9 @@ void AddingTexturesMain::OnSuspending()
 
 	m_sceneRenderer->SaveState();
 
+	// 이번 실행에서 컴파일한 파이프라인 blob을 저장하여 다음 실행의 시작 시간을 줄입니다.
+	m_deviceResources->GetPipelineStateCache()->Save();
+
 	// 응용 프로그램에서 다시 만들기가 쉬운 비디오 메모리 할당을 사용하는 경우,
 	// 해당 메모리를 릴리스하여 다른 응용 프로그램이 사용할 수 있도록 해보세요.
 }
@@ -89,4 +102,5 @@ void AddingTexturesMain::OnDeviceRemoved()
 	// 및 더 이상 유효하지 않은 리소스입니다.
 	m_sceneRenderer->SaveState();
 	m_sceneRenderer = nullptr;
+	m_deviceResources = nullptr;
 }
@@ -21,6 +21,9 @@ namespace AddingTextures
 		void OnDeviceRemoved();
 
 	private:
+		// 장치 리소스에 대한 캐시된 포인터입니다.
+		std::shared_ptr<DX::DeviceResources> m_deviceResources;
+
 		// TODO: 사용자 콘텐츠 렌더러로 대체합니다.
 		std::unique_ptr<Sample3DSceneRenderer> m_sceneRenderer;
 
@@ -1,7 +1,9 @@
 ﻿#include "pch.h"
 #include "App.h"
 
+#include <fstream>
 #include <ppltasks.h>
+#include "Common\CpuProfiler.h"
 
 using namespace AddingTextures;
 
@@ -14,9 +16,35 @@ using namespace Windows::UI::Input;
 using namespace Windows::System;
 using namespace Windows::Foundation;
 using namespace Windows::Graphics::Display;
+using namespace Windows::Storage;
 
 using Microsoft::WRL::ComPtr;
 
+// 진행 중인 프레임 수에 대한 로컬 설정 키입니다. 배포마다 지연 시간과 처리량 사이의 균형을 조정할 수 있습니다.
+Platform::String^ FramesInFlightKey = "FramesInFlight";
+
+static UINT LoadFrameCountSetting()
+{
+	auto values = ApplicationData::Current->LocalSettings->Values;
+	if (values->HasKey(FramesInFlightKey))
+	{
+		return safe_cast<IPropertyValue^>(values->Lookup(FramesInFlightKey))->GetUInt32();
+	}
+	return DX::c_defaultFrameCount;
+}
+
+// CPU 구간 추적을 내보내는 키입니다. 파일은 chrome://tracing 또는 Perfetto에서 열 수 있습니다.
+static const VirtualKey ExportCpuTraceKey = VirtualKey::F9;
+
+static void ExportCpuTrace()
+{
+	std::wstring path(ApplicationData::Current->LocalFolder->Path->Data());
+	path += L"\\CpuTrace.json";
+
+	std::ofstream stream(path, std::ios::trunc);
+	DX::CpuProfiler::Get().ExportChromeTrace(stream);
+}
+
 // DirectX 12 응용 프로그램 템플릿에 대한 설명은 http://go.microsoft.com/fwlink/?LinkID=613670&clcid=0x409에 나와 있습니다.
 
 // main 함수는 IFrameworkView 클래스 초기화에만 사용됩니다.
@@ -66,6 +94,9 @@ void App::SetWindow(CoreWindow^ window)
 	window->Closed += 
 		ref new TypedEventHandler<CoreWindow^, CoreWindowEventArgs^>(this, &App::OnWindowClosed);
 
+	window->KeyDown +=
+		ref new TypedEventHandler<CoreWindow^, KeyEventArgs^>(this, &App::OnKeyDown);
+
 	DisplayInformation^ currentDisplayInformation = DisplayInformation::GetForCurrentView();
 
 	currentDisplayInformation->DpiChanged +=
@@ -90,21 +121,27 @@ void App::Load(Platform::String^ entryPoint)
 // 이 메서드는 창이 활성화된 후 호출됩니다.
 void App::Run()
 {
+	DX::CpuProfiler::Get().SetCurrentThreadName("Main");
+
 	while (!m_windowClosed)
 	{
 		if (m_windowVisible)
 		{
+			DX_CPU_ZONE("App::Run");
+
 			CoreWindow::GetForCurrentThread()->Dispatcher->ProcessEvents(CoreProcessEventsOption::ProcessAllIfPresent);
 
 			auto commandQueue = GetDeviceResources()->GetCommandQueue();
 			PIXBeginEvent(commandQueue, 0, L"Update");
 			{
+				DX_CPU_ZONE("Update");
 				m_main->Update();
 			}
 			PIXEndEvent(commandQueue);
 
 			PIXBeginEvent(commandQueue, 0, L"Render");
 			{
+				DX_CPU_ZONE("Render");
 				if (m_main->Render())
 				{
 					GetDeviceResources()->Present();
@@ -156,6 +193,9 @@ void App::OnResuming(Platform::Object^ sender, Platform::Object^ args)
 	// 응용 프로그램을 이전에 종료한 경우 발생하지 않습니다.
 
 	m_main->OnResuming();
+
+	// 일시 중단된 동안 바뀐 프레임 수 설정을 다시 시작하지 않고 적용합니다.
+	GetDeviceResources()->SetFrameCount(LoadFrameCountSetting());
 }
 
 // 창 이벤트 처리기입니다.
@@ -199,6 +239,14 @@ void App::OnDisplayContentsInvalidated(DisplayInformation^ sender, Object^ args)
 	GetDeviceResources()->ValidateDevice();
 }
 
+void App::OnKeyDown(CoreWindow^ sender, KeyEventArgs^ args)
+{
+	if (args->VirtualKey == ExportCpuTraceKey)
+	{
+		ExportCpuTrace();
+	}
+}
+
 std::shared_ptr<DX::DeviceResources> App::GetDeviceResources()
 {
 	if (m_deviceResources != nullptr && m_deviceResources->IsDeviceRemoved())
@@ -220,7 +268,7 @@ std::shared_ptr<DX::DeviceResources> App::GetDeviceResources()
 
 	if (m_deviceResources == nullptr)
 	{
-		m_deviceResources = std::make_shared<DX::DeviceResources>();
+		m_deviceResources = std::make_shared<DX::DeviceResources>(DXGI_FORMAT_B8G8R8A8_UNORM, DXGI_FORMAT_D32_FLOAT, LoadFrameCountSetting());
 		m_deviceResources->SetWindow(CoreWindow::GetForCurrentThread());
 		m_main->CreateRenderers(m_deviceResources);
 	}
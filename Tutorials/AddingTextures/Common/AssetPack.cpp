@@ -0,0 +1,77 @@
+﻿#include "pch.h"
+#include "AssetPack.h"
+
+#if defined(_WIN32)
+#include "DirectXHelper.h"
+#else
+#include <stdexcept>
+#endif
+
+using namespace DX;
+
+namespace
+{
+#if defined(_WIN32)
+	void ThrowInvalidData()
+	{
+		DX::ThrowIfFailed(HRESULT_FROM_WIN32(ERROR_INVALID_DATA));
+	}
+
+	void ThrowNotFound()
+	{
+		DX::ThrowIfFailed(HRESULT_FROM_WIN32(ERROR_NOT_FOUND));
+	}
+#else
+	void ThrowInvalidData()
+	{
+		throw std::runtime_error("invalid asset pack");
+	}
+
+	void ThrowNotFound()
+	{
+		throw std::out_of_range("asset not found");
+	}
+#endif
+}
+
+std::shared_ptr<const AssetPack> AssetPack::Open(const MappedFilePath& path)
+{
+	std::shared_ptr<const MappedFile> file = MappedFile::Open(path);
+
+	std::uint32_t entryCount = 0;
+	if (!ValidateAssetPack(file->GetData(), file->GetSize(), &entryCount))
+	{
+		ThrowInvalidData();
+	}
+
+	return std::shared_ptr<const AssetPack>(new AssetPack(file, entryCount));
+}
+
+AssetPack::AssetPack(const std::shared_ptr<const MappedFile>& file, std::uint32_t entryCount) :
+	m_file(file),
+	m_entryCount(entryCount)
+{
+}
+
+AssetView AssetPack::Load(AssetId id) const
+{
+	AssetPackEntry entry;
+	if (!Find(id, &entry))
+	{
+		ThrowNotFound();
+	}
+
+	const std::uint8_t* stored = m_file->GetData() + entry.offset;
+	if ((entry.flags & c_assetEntryCompressed) == 0)
+	{
+		return AssetView(stored, static_cast<std::size_t>(entry.size), m_file);
+	}
+
+	auto decompressed = std::make_shared<std::vector<std::uint8_t>>(static_cast<std::size_t>(entry.size));
+	if (!Lz4DecompressBlock(stored, static_cast<std::size_t>(entry.storedSize), decompressed->data(), decompressed->size()))
+	{
+		ThrowInvalidData();
+	}
+
+	return AssetView(decompressed->data(), decompressed->size(), decompressed);
+}
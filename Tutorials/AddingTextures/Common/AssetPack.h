@@ -0,0 +1,55 @@
+﻿#pragma once
+
+#include "AssetPackFormat.h"
+#include "MappedFile.h"
+
+namespace DX
+{
+	// 에셋 데이터의 읽기 전용 보기입니다. 압축되지 않은 항목은 팩의 매핑을 직접 가리키고,
+	// 압축된 항목은 압축을 푼 사본을 가리킵니다. 보기가 살아 있는 동안 참조하는 메모리도 유지됩니다.
+	class AssetView
+	{
+	public:
+		AssetView() : m_data(nullptr), m_size(0) {}
+		AssetView(const std::uint8_t* data, std::size_t size, const std::shared_ptr<const void>& owner) :
+			m_data(data), m_size(size), m_owner(owner) {}
+
+		// 개별 파일 전체의 보기입니다.
+		explicit AssetView(const std::shared_ptr<const MappedFile>& file) :
+			m_data(file->GetData()), m_size(file->GetSize()), m_owner(file) {}
+
+		const std::uint8_t* GetData() const	{ return m_data; }
+		std::size_t GetSize() const			{ return m_size; }
+		bool IsValid() const				{ return m_owner != nullptr; }
+
+	private:
+		const std::uint8_t*			m_data;
+		std::size_t					m_size;
+		std::shared_ptr<const void>	m_owner;
+	};
+
+	// 시작 시 한 번 메모리 매핑하는 단일 파일 에셋 팩입니다.
+	// 조회는 정렬된 목차에 대한 이진 검색이며 문자열이나 메모리를 할당하지 않습니다. 여러 스레드에서 호출할 수 있습니다.
+	class AssetPack
+	{
+	public:
+		// 팩을 매핑하고 목차를 검증합니다. 열 수 없거나 형식이 맞지 않으면 예외가 발생합니다.
+		static std::shared_ptr<const AssetPack> Open(const MappedFilePath& path);
+
+		bool Find(AssetId id, AssetPackEntry* entry) const	{ return FindAssetPackEntry(m_file->GetData(), m_entryCount, id, entry); }
+		bool Contains(AssetId id) const						{ AssetPackEntry entry; return Find(id, &entry); }
+
+		// 에셋을 가져옵니다. 압축되지 않은 항목은 복사하지 않습니다. 항목이 없거나 압축을 풀 수 없으면 예외가 발생합니다.
+		AssetView Load(AssetId id) const;
+
+		std::uint32_t GetEntryCount() const	{ return m_entryCount; }
+
+	private:
+		AssetPack(const std::shared_ptr<const MappedFile>& file, std::uint32_t entryCount);
+		AssetPack(const AssetPack&);
+		AssetPack& operator=(const AssetPack&);
+
+		std::shared_ptr<const MappedFile>	m_file;
+		std::uint32_t						m_entryCount;
+	};
+}
@@ -0,0 +1,203 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "Lz4Block.h"
+
+namespace DX
+{
+	// 에셋 팩 파일의 형식입니다. 플랫폼 API에 의존하지 않으므로 패커 도구와 앱이 함께 사용합니다.
+	//
+	// 헤더	: magic, version, entryCount, reserved (각 uint32)
+	// 목차	: AssetId 오름차순으로 정렬된 entryCount개의 AssetPackEntry
+	// 데이터	: 항목마다 지정한 정렬(기본 4KB, 큰 리소스는 64KB)에 맞춘 페이로드
+	// 모든 값은 little-endian입니다.
+	static const std::uint32_t c_assetPackMagic = 0x4B415041;	// 'APAK'
+	static const std::uint32_t c_assetPackVersion = 1;
+	static const std::uint32_t c_assetPackDefaultAlignment = 4096;
+	static const std::uint32_t c_assetPackLargeAlignment = 65536;
+
+	static const std::uint32_t c_assetEntryCompressed = 0x1;	// 페이로드가 LZ4 블록입니다.
+
+	// 에셋 이름의 64비트 FNV-1a 해시입니다. 문자열 리터럴에 사용하면 컴파일 타임에 계산됩니다.
+	typedef std::uint64_t AssetId;
+
+	namespace AssetIdDetail
+	{
+		constexpr AssetId Hash(const char* name, AssetId hash)
+		{
+			return *name == '\0' ? hash : Hash(name + 1, (hash ^ static_cast<std::uint8_t>(*name)) * 1099511628211ull);
+		}
+	}
+
+	constexpr AssetId MakeAssetId(const char* name)
+	{
+		return AssetIdDetail::Hash(name, 14695981039346656037ull);
+	}
+
+	struct AssetPackEntry
+	{
+		AssetId			id;
+		std::uint64_t	offset;			// 파일 시작 기준입니다.
+		std::uint64_t	storedSize;		// 파일에 저장된 크기입니다.
+		std::uint64_t	size;			// 압축을 푼 크기입니다.
+		std::uint32_t	flags;
+		std::uint32_t	alignment;
+	};
+	static_assert(sizeof(AssetPackEntry) == 40, "AssetPackEntry는 파일의 목차 레코드와 같은 배치여야 합니다.");
+
+	static const std::size_t c_assetPackHeaderSize = 4 * sizeof(std::uint32_t);
+
+	// 패커에 전달하는 항목입니다.
+	struct AssetPackInput
+	{
+		AssetId						id;
+		std::vector<std::uint8_t>	data;
+		std::uint32_t				alignment;	// 2의 거듭제곱이어야 합니다.
+		bool						compress;	// 압축해서 작아지는 경우에만 압축된 상태로 저장합니다.
+	};
+
+	// 팩 파일을 만듭니다. 정렬이 2의 거듭제곱이 아니거나 ID가 중복되면(이름 해시 충돌 포함) false를 반환합니다.
+	inline bool SerializeAssetPack(const std::vector<AssetPackInput>& inputs, std::vector<std::uint8_t>* file)
+	{
+		file->clear();
+
+		std::vector<const AssetPackInput*> sorted;
+		sorted.reserve(inputs.size());
+		for (const auto& input : inputs)
+		{
+			if (input.alignment == 0 || (input.alignment & (input.alignment - 1)) != 0)
+			{
+				return false;
+			}
+			sorted.push_back(&input);
+		}
+
+		std::sort(sorted.begin(), sorted.end(), [](const AssetPackInput* a, const AssetPackInput* b) { return a->id < b->id; });
+		for (std::size_t i = 1; i < sorted.size(); i++)
+		{
+			if (sorted[i - 1]->id == sorted[i]->id)
+			{
+				return false;
+			}
+		}
+
+		const std::uint32_t header[4] = { c_assetPackMagic, c_assetPackVersion, static_cast<std::uint32_t>(sorted.size()), 0 };
+		std::vector<AssetPackEntry> table(sorted.size());
+
+		file->resize(c_assetPackHeaderSize + table.size() * sizeof(AssetPackEntry));
+		for (std::size_t i = 0; i < sorted.size(); i++)
+		{
+			const AssetPackInput& input = *sorted[i];
+			AssetPackEntry& entry = table[i];
+			entry.id = input.id;
+			entry.size = input.data.size();
+			entry.flags = 0;
+			entry.alignment = input.alignment;
+
+			std::vector<std::uint8_t> compressed;
+			if (input.compress && !input.data.empty())
+			{
+				compressed = Lz4CompressBlock(input.data.data(), input.data.size());
+			}
+
+			const bool useCompressed = !compressed.empty() && compressed.size() < input.data.size();
+			const std::vector<std::uint8_t>& payload = useCompressed ? compressed : input.data;
+			if (useCompressed)
+			{
+				entry.flags |= c_assetEntryCompressed;
+			}
+
+			const std::size_t offset = (file->size() + input.alignment - 1) & ~static_cast<std::size_t>(input.alignment - 1);
+			entry.offset = offset;
+			entry.storedSize = payload.size();
+
+			file->resize(offset + payload.size());
+			if (!payload.empty())
+			{
+				std::memcpy(file->data() + offset, payload.data(), payload.size());
+			}
+		}
+
+		std::memcpy(file->data(), header, sizeof(header));
+		if (!table.empty())
+		{
+			std::memcpy(file->data() + c_assetPackHeaderSize, table.data(), table.size() * sizeof(AssetPackEntry));
+		}
+		return true;
+	}
+
+	// 헤더와 목차 전체를 검증하고 항목 수를 반환합니다. 팩을 열 때 한 번 호출하면 이후 조회에서는 범위를 다시 검사하지 않아도 됩니다.
+	inline bool ValidateAssetPack(const std::uint8_t* data, std::size_t size, std::uint32_t* entryCount)
+	{
+		std::uint32_t header[4];
+		if (data == nullptr || size < sizeof(header))
+		{
+			return false;
+		}
+
+		std::memcpy(header, data, sizeof(header));
+		if (header[0] != c_assetPackMagic || header[1] != c_assetPackVersion)
+		{
+			return false;
+		}
+
+		const std::uint64_t count = header[2];
+		if (count > (size - c_assetPackHeaderSize) / sizeof(AssetPackEntry))
+		{
+			return false;
+		}
+
+		const std::uint8_t* table = data + c_assetPackHeaderSize;
+		AssetId previous = 0;
+		for (std::uint64_t i = 0; i < count; i++)
+		{
+			AssetPackEntry entry;
+			std::memcpy(&entry, table + i * sizeof(AssetPackEntry), sizeof(entry));
+
+			if ((i > 0 && entry.id <= previous) ||
+				entry.offset > size || entry.storedSize > size - entry.offset ||
+				((entry.flags & c_assetEntryCompressed) == 0 && entry.storedSize != entry.size))
+			{
+				return false;
+			}
+			previous = entry.id;
+		}
+
+		*entryCount = header[2];
+		return true;
+	}
+
+	// 검증된 팩의 목차에서 이진 검색으로 항목을 찾습니다. 메모리를 할당하지 않습니다.
+	inline bool FindAssetPackEntry(const std::uint8_t* data, std::uint32_t entryCount, AssetId id, AssetPackEntry* entry)
+	{
+		const std::uint8_t* table = data + c_assetPackHeaderSize;
+
+		std::uint32_t first = 0;
+		std::uint32_t last = entryCount;
+		while (first < last)
+		{
+			const std::uint32_t middle = first + (last - first) / 2;
+
+			AssetId middleId;
+			std::memcpy(&middleId, table + middle * sizeof(AssetPackEntry), sizeof(middleId));
+			if (middleId < id)
+			{
+				first = middle + 1;
+			}
+			else if (id < middleId)
+			{
+				last = middle;
+			}
+			else
+			{
+				std::memcpy(entry, table + middle * sizeof(AssetPackEntry), sizeof(*entry));
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
@@ -0,0 +1,980 @@
+﻿#include "pch.h"
+#include "BlockCompression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "ParallelFor.h"
+
+#if defined(_WIN32)
+#include "DirectXHelper.h"
+#else
+#include <stdexcept>
+#endif
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <emmintrin.h>
+#define DX_BLOCK_COMPRESSION_SSE2
+#elif defined(_M_ARM) || defined(_M_ARM64) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DX_BLOCK_COMPRESSION_NEON
+#endif
+
+using namespace DX;
+
+namespace
+{
+	// 한 작업이 인코딩할 최소 원본 바이트 수입니다. 블록 인코딩은 비싸므로 절차적 텍스처보다 작게 나눕니다.
+	const std::size_t c_minBytesPerBlock = 64 * 1024;
+
+	const std::uint32_t c_blockPixelCount = 16;
+	const std::uint32_t c_allPixels = 0xffff;
+
+	// 팔레트를 SIMD 폭에 맞출 때 채우는 값입니다. 제곱해도 float 범위 안이며 어떤 픽셀보다도 멉니다.
+	const float c_unusedPaletteValue = 1e9f;
+
+	// BC1 알파가 이 값보다 작은 픽셀은 투명한 검정으로 인코딩합니다.
+	const std::uint8_t c_bc1AlphaThreshold = 128;
+
+	// BC7 4비트 인덱스의 보간 가중치(64분율)입니다.
+	const std::uint32_t c_bc7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	void ThrowInvalidArgument()
+	{
+#if defined(_WIN32)
+		DX::ThrowIfFailed(E_INVALIDARG);
+#else
+		throw std::invalid_argument("invalid block compression argument");
+#endif
+	}
+
+	typedef float BlockPixels[c_blockPixelCount][4];
+
+	// 디코더가 만드는 팔레트입니다. 채널별로 저장하며, 사용하지 않는 항목은 c_unusedPaletteValue로 채웁니다.
+	struct Palette
+	{
+		alignas(16) float channels[4][16];
+		std::uint32_t count;
+	};
+
+	void ClearPalette(Palette* palette, std::uint32_t count)
+	{
+		for (auto& channel : palette->channels)
+		{
+			std::fill(channel, channel + 16, c_unusedPaletteValue);
+		}
+		palette->count = count;
+	}
+
+	// mask에 있는 픽셀마다 가장 가까운 팔레트 항목을 indices에 쓰고 오차 제곱합을 돌려줍니다.
+	// 팔레트 네 항목과의 거리를 한 벡터로 계산합니다.
+	float AssignIndices(const BlockPixels& pixels, std::uint32_t mask, const Palette& palette, std::uint32_t channelCount, std::uint8_t* indices)
+	{
+		const std::uint32_t groupCount = (palette.count + 3) / 4;
+		float totalError = 0.0f;
+
+		for (std::uint32_t i = 0; i < c_blockPixelCount; i++)
+		{
+			if ((mask & (1u << i)) == 0)
+			{
+				continue;
+			}
+
+			float bestError = 3.4e38f;
+			std::uint32_t bestIndex = 0;
+#if defined(DX_BLOCK_COMPRESSION_SSE2) || defined(DX_BLOCK_COMPRESSION_NEON)
+			for (std::uint32_t group = 0; group < groupCount; group++)
+			{
+				alignas(16) float distances[4];
+#if defined(DX_BLOCK_COMPRESSION_SSE2)
+				__m128 distance = _mm_setzero_ps();
+				for (std::uint32_t c = 0; c < channelCount; c++)
+				{
+					const __m128 difference = _mm_sub_ps(_mm_load_ps(&palette.channels[c][group * 4]), _mm_set1_ps(pixels[i][c]));
+					distance = _mm_add_ps(distance, _mm_mul_ps(difference, difference));
+				}
+				_mm_store_ps(distances, distance);
+#else
+				float32x4_t distance = vdupq_n_f32(0.0f);
+				for (std::uint32_t c = 0; c < channelCount; c++)
+				{
+					const float32x4_t difference = vsubq_f32(vld1q_f32(&palette.channels[c][group * 4]), vdupq_n_f32(pixels[i][c]));
+					distance = vaddq_f32(distance, vmulq_f32(difference, difference));
+				}
+				vst1q_f32(distances, distance);
+#endif
+				for (std::uint32_t lane = 0; lane < 4; lane++)
+				{
+					if (distances[lane] < bestError)
+					{
+						bestError = distances[lane];
+						bestIndex = group * 4 + lane;
+					}
+				}
+			}
+#else
+			for (std::uint32_t entry = 0; entry < groupCount * 4; entry++)
+			{
+				float distance = 0.0f;
+				for (std::uint32_t c = 0; c < channelCount; c++)
+				{
+					const float difference = palette.channels[c][entry] - pixels[i][c];
+					distance += difference * difference;
+				}
+				if (distance < bestError)
+				{
+					bestError = distance;
+					bestIndex = entry;
+				}
+			}
+#endif
+			indices[i] = static_cast<std::uint8_t>(bestIndex);
+			totalError += bestError;
+		}
+		return totalError;
+	}
+
+	// 픽셀을 (1 - t) * a + t * b로 근사할 때 오차 제곱합이 가장 작은 a, b를 구합니다. t는 픽셀마다 고른 인덱스의 보간 비율입니다.
+	bool SolveEndpoints(const BlockPixels& pixels, std::uint32_t mask, const float* t, std::uint32_t channelCount, float* a, float* b)
+	{
+		float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+		float ax[4] = {}, bx[4] = {};
+		for (std::uint32_t i = 0; i < c_blockPixelCount; i++)
+		{
+			if ((mask & (1u << i)) == 0)
+			{
+				continue;
+			}
+			const float beta = t[i];
+			const float alpha = 1.0f - beta;
+			aa += alpha * alpha;
+			bb += beta * beta;
+			ab += alpha * beta;
+			for (std::uint32_t c = 0; c < channelCount; c++)
+			{
+				ax[c] += alpha * pixels[i][c];
+				bx[c] += beta * pixels[i][c];
+			}
+		}
+
+		const float determinant = aa * bb - ab * ab;
+		if (std::fabs(determinant) < 1e-6f)
+		{
+			return false;
+		}
+		const float inverse = 1.0f / determinant;
+		for (std::uint32_t c = 0; c < channelCount; c++)
+		{
+			a[c] = (std::min)((std::max)((ax[c] * bb - bx[c] * ab) * inverse, 0.0f), 255.0f);
+			b[c] = (std::min)((std::max)((bx[c] * aa - ax[c] * ab) * inverse, 0.0f), 255.0f);
+		}
+		return true;
+	}
+
+	// 채널별 최솟값과 최댓값을 끝점으로 삼습니다. 범위가 가장 큰 채널과 반대로 움직이는 채널은 끝점을 바꾸어 대각선을 맞춥니다.
+	void ComputeBoundingEndpoints(const BlockPixels& pixels, std::uint32_t mask, std::uint32_t channelCount, float* a, float* b)
+	{
+		float mean[4] = {};
+		std::uint32_t count = 0;
+		for (std::uint32_t c = 0; c < channelCount; c++)
+		{
+			a[c] = 255.0f;
+			b[c] = 0.0f;
+		}
+		for (std::uint32_t i = 0; i < c_blockPixelCount; i++)
+		{
+			if ((mask & (1u << i)) == 0)
+			{
+				continue;
+			}
+			for (std::uint32_t c = 0; c < channelCount; c++)
+			{
+				a[c] = (std::min)(a[c], pixels[i][c]);
+				b[c] = (std::max)(b[c], pixels[i][c]);
+				mean[c] += pixels[i][c];
+			}
+			count++;
+		}
+		if (count == 0)
+		{
+			return;
+		}
+
+		std::uint32_t major = 0;
+		for (std::uint32_t c = 1; c < channelCount; c++)
+		{
+			if (b[c] - a[c] > b[major] - a[major])
+			{
+				major = c;
+			}
+		}
+
+		for (std::uint32_t c = 0; c < channelCount; c++)
+		{
+			mean[c] /= count;
+		}
+		for (std::uint32_t c = 0; c < channelCount; c++)
+		{
+			if (c == major)
+			{
+				continue;
+			}
+			float covariance = 0.0f;
+			for (std::uint32_t i = 0; i < c_blockPixelCount; i++)
+			{
+				if ((mask & (1u << i)) != 0)
+				{
+					covariance += (pixels[i][c] - mean[c]) * (pixels[i][major] - mean[major]);
+				}
+			}
+			if (covariance < 0.0f)
+			{
+				std::swap(a[c], b[c]);
+			}
+		}
+	}
+
+	// 공분산 행렬의 주성분 축에 픽셀을 투영하여 양 끝을 끝점으로 삼습니다.
+	void ComputePrincipalEndpoints(const BlockPixels& pixels, std::uint32_t mask, std::uint32_t channelCount, float* a, float* b)
+	{
+		float mean[4] = {};
+		std::uint32_t count = 0;
+		for (std::uint32_t i = 0; i < c_blockPixelCount; i++)
+		{
+			if ((mask & (1u << i)) != 0)
+			{
+				for (std::uint32_t c = 0; c < channelCount; c++)
+				{
+					mean[c] += pixels[i][c];
+				}
+				count++;
+			}
+		}
+		if (count == 0)
+		{
+			return;
+		}
+		for (std::uint32_t c = 0; c < channelCount; c++)
+		{
+			mean[c] /= count;
+		}
+
+		float covariance[4][4] = {};
+		for (std::uint32_t i = 0; i < c_blockPixelCount; i++)
+		{
+			if ((mask & (1u << i)) == 0)
+			{
+				continue;
+			}
+			for (std::uint32_t r = 0; r < channelCount; r++)
+			{
+				for (std::uint32_t c = 0; c < channelCount; c++)
+				{
+					covariance[r][c] += (pixels[i][r] - mean[r]) * (pixels[i][c] - mean[c]);
+				}
+			}
+		}
+
+		// 경계 상자의 대각선에서 시작하여 거듭제곱법으로 축을 구합니다.
+		float axis[4];
+		ComputeBoundingEndpoints(pixels, mask, channelCount, a, b);
+		for (std::uint32_t c = 0; c < channelCount; c++)
+		{
+			axis[c] = b[c] - a[c];
+		}
+		for (std::uint32_t iteration = 0; iteration < 8; iteration++)
+		{
+			float next[4] = {};
+			float length = 0.0f;
+			for (std::uint32_t r = 0; r < channelCount; r++)
+			{
+				for (std::uint32_t c = 0; c < channelCount; c++)
+				{
+					next[r] += covariance[r][c] * axis[c];
+				}
+				length = (std::max)(length, std::fabs(next[r]));
+			}
+			if (length < 1e-6f)
+			{
+				break;
+			}
+			for (std::uint32_t c = 0; c < channelCount; c++)
+			{
+				axis[c] = next[c] / length;
+			}
+		}
+
+		float axisLengthSquared = 0.0f;
+		for (std::uint32_t c = 0; c < channelCount; c++)
+		{
+			axisLengthSquared += axis[c] * axis[c];
+		}
+		if (axisLengthSquared < 1e-12f)
+		{
+			for (std::uint32_t c = 0; c < channelCount; c++)
+			{
+				a[c] = b[c] = mean[c];
+			}
+			return;
+		}
+
+		float minimum = 3.4e38f, maximum = -3.4e38f;
+		for (std::uint32_t i = 0; i < c_blockPixelCount; i++)
+		{
+			if ((mask & (1u << i)) == 0)
+			{
+				continue;
+			}
+			float projection = 0.0f;
+			for (std::uint32_t c = 0; c < channelCount; c++)
+			{
+				projection += (pixels[i][c] - mean[c]) * axis[c];
+			}
+			minimum = (std::min)(minimum, projection);
+			maximum = (std::max)(maximum, projection);
+		}
+		for (std::uint32_t c = 0; c < channelCount; c++)
+		{
+			a[c] = (std::min)((std::max)(mean[c] + axis[c] * minimum / axisLengthSquared, 0.0f), 255.0f);
+			b[c] = (std::min)((std::max)(mean[c] + axis[c] * maximum / axisLengthSquared, 0.0f), 255.0f);
+		}
+	}
+
+	std::uint32_t GetRefinementCount(BlockCompressionQuality quality)
+	{
+		switch (quality)
+		{
+		case BlockCompressionQuality::Fast:		return 0;
+		case BlockCompressionQuality::Normal:	return 1;
+		default:								return 3;
+		}
+	}
+
+	void ComputeInitialEndpoints(const BlockPixels& pixels, std::uint32_t mask, std::uint32_t channelCount, BlockCompressionQuality quality, float* a, float* b)
+	{
+		if (quality == BlockCompressionQuality::Fast)
+		{
+			ComputeBoundingEndpoints(pixels, mask, channelCount, a, b);
+		}
+		else
+		{
+			ComputePrincipalEndpoints(pixels, mask, channelCount, a, b);
+		}
+	}
+
+	// BC1 색 블록입니다.
+
+	std::uint32_t Expand5(std::uint32_t value)	{ return (value << 3) | (value >> 2); }
+	std::uint32_t Expand6(std::uint32_t value)	{ return (value << 2) | (value >> 4); }
+
+	std::uint16_t QuantizeRgb565(const float* color)
+	{
+		const std::uint32_t r = static_cast<std::uint32_t>(color[0] * (31.0f / 255.0f) + 0.5f);
+		const std::uint32_t g = static_cast<std::uint32_t>(color[1] * (63.0f / 255.0f) + 0.5f);
+		const std::uint32_t b = static_cast<std::uint32_t>(color[2] * (31.0f / 255.0f) + 0.5f);
+		return static_cast<std::uint16_t>(((std::min)(r, 31u) << 11) | ((std::min)(g, 63u) << 5) | (std::min)(b, 31u));
+	}
+
+	void ExpandRgb565(std::uint16_t color, std::uint32_t* rgb)
+	{
+		rgb[0] = Expand5((color >> 11) & 31);
+		rgb[1] = Expand6((color >> 5) & 63);
+		rgb[2] = Expand5(color & 31);
+	}
+
+	// 한 채널 값 v를 (2 * e0 + e1) / 3로 가장 가깝게 만드는 양자화된 끝점 쌍입니다. 단색 블록에 사용합니다.
+	struct SingleColorTable
+	{
+		explicit SingleColorTable(std::uint32_t bits)
+		{
+			const std::uint32_t levels = 1u << bits;
+			for (std::uint32_t value = 0; value < 256; value++)
+			{
+				std::uint32_t bestError = ~0u;
+				for (std::uint32_t e0 = 0; e0 < levels; e0++)
+				{
+					for (std::uint32_t e1 = 0; e1 < levels; e1++)
+					{
+						const std::uint32_t v0 = bits == 5 ? Expand5(e0) : Expand6(e0);
+						const std::uint32_t v1 = bits == 5 ? Expand5(e1) : Expand6(e1);
+						const std::uint32_t interpolated = (2 * v0 + v1) / 3;
+						// 같은 오차이면 끝점이 가까운 쌍을 골라 디코더마다 다른 반올림의 영향을 줄입니다.
+						const std::uint32_t error = static_cast<std::uint32_t>(std::abs(static_cast<int>(interpolated) - static_cast<int>(value))) * 1024 +
+							static_cast<std::uint32_t>(std::abs(static_cast<int>(v0) - static_cast<int>(v1)));
+						if (error < bestError)
+						{
+							bestError = error;
+							endpoints[value][0] = static_cast<std::uint8_t>(e0);
+							endpoints[value][1] = static_cast<std::uint8_t>(e1);
+						}
+					}
+				}
+			}
+		}
+
+		std::uint8_t endpoints[256][2];
+	};
+
+	struct ColorBlockTrial
+	{
+		std::uint16_t	color0;
+		std::uint16_t	color1;
+		std::uint8_t	indices[c_blockPixelCount];
+		float			error;
+	};
+
+	// 디코더 규칙대로 팔레트를 만듭니다. 3색 모드의 3번 항목(투명한 검정)은 불투명 픽셀이 고르지 않도록 팔레트에서 뺍니다.
+	bool BuildColorPalette(std::uint16_t color0, std::uint16_t color1, bool alwaysFourColor, Palette* palette)
+	{
+		std::uint32_t c0[3], c1[3];
+		ExpandRgb565(color0, c0);
+		ExpandRgb565(color1, c1);
+
+		const bool fourColor = alwaysFourColor || color0 > color1;
+		ClearPalette(palette, fourColor ? 4 : 3);
+		for (std::uint32_t c = 0; c < 3; c++)
+		{
+			palette->channels[c][0] = static_cast<float>(c0[c]);
+			palette->channels[c][1] = static_cast<float>(c1[c]);
+			if (fourColor)
+			{
+				palette->channels[c][2] = static_cast<float>((2 * c0[c] + c1[c]) / 3);
+				palette->channels[c][3] = static_cast<float>((c0[c] + 2 * c1[c]) / 3);
+			}
+			else
+			{
+				palette->channels[c][2] = static_cast<float>((c0[c] + c1[c]) / 2);
+			}
+		}
+		return fourColor;
+	}
+
+	void EvaluateColorEndpoints(const BlockPixels& pixels, std::uint32_t opaqueMask, std::uint16_t color0, std::uint16_t color1, bool alwaysFourColor, ColorBlockTrial* trial)
+	{
+		Palette palette;
+		BuildColorPalette(color0, color1, alwaysFourColor, &palette);
+
+		trial->color0 = color0;
+		trial->color1 = color1;
+		std::fill(trial->indices, trial->indices + c_blockPixelCount, static_cast<std::uint8_t>(3));
+		trial->error = AssignIndices(pixels, opaqueMask, palette, 3, trial->indices);
+	}
+
+	// 끝점을 양자화하고, 원하는 모드가 되도록 순서를 정한 다음 평가합니다. 3색 모드는 color0 <= color1이어야 합니다.
+	void EvaluateColorCandidate(const BlockPixels& pixels, std::uint32_t opaqueMask, const float* a, const float* b, bool fourColor, bool alwaysFourColor, ColorBlockTrial* trial)
+	{
+		std::uint16_t color0 = QuantizeRgb565(a);
+		std::uint16_t color1 = QuantizeRgb565(b);
+		if (!alwaysFourColor && (fourColor ? color0 < color1 : color0 > color1))
+		{
+			std::swap(color0, color1);
+		}
+		EvaluateColorEndpoints(pixels, opaqueMask, color0, color1, alwaysFourColor, trial);
+	}
+
+	// 고른 인덱스로 끝점을 최소 제곱으로 다시 구하고, 오차가 줄어드는 동안 반복합니다.
+	void RefineColorTrial(const BlockPixels& pixels, std::uint32_t opaqueMask, bool alwaysFourColor, std::uint32_t iterations, ColorBlockTrial* best)
+	{
+		for (std::uint32_t iteration = 0; iteration < iterations; iteration++)
+		{
+			const bool fourColor = alwaysFourColor || best->color0 > best->color1;
+			const float fourColorT[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+			const float threeColorT[4] = { 0.0f, 1.0f, 0.5f, 0.0f };
+			float t[c_blockPixelCount];
+			for (std::uint32_t i = 0; i < c_blockPixelCount; i++)
+			{
+				t[i] = (fourColor ? fourColorT : threeColorT)[best->indices[i]];
+			}
+
+			float a[4], b[4];
+			if (!SolveEndpoints(pixels, opaqueMask, t, 3, a, b))
+			{
+				return;
+			}
+
+			ColorBlockTrial trial;
+			EvaluateColorCandidate(pixels, opaqueMask, a, b, fourColor, alwaysFourColor, &trial);
+			if (trial.error >= best->error)
+			{
+				return;
+			}
+			*best = trial;
+		}
+	}
+
+	void WriteColorBlock(const ColorBlockTrial& trial, std::uint8_t* block)
+	{
+		std::uint32_t indexBits = 0;
+		for (std::uint32_t i = 0; i < c_blockPixelCount; i++)
+		{
+			indexBits |= static_cast<std::uint32_t>(trial.indices[i]) << (i * 2);
+		}
+		block[0] = static_cast<std::uint8_t>(trial.color0);
+		block[1] = static_cast<std::uint8_t>(trial.color0 >> 8);
+		block[2] = static_cast<std::uint8_t>(trial.color1);
+		block[3] = static_cast<std::uint8_t>(trial.color1 >> 8);
+		for (std::uint32_t i = 0; i < 4; i++)
+		{
+			block[4 + i] = static_cast<std::uint8_t>(indexBits >> (i * 8));
+		}
+	}
+
+	// BC1 색 블록을 인코딩합니다. BC3의 색 블록은 항상 4색으로 디코딩되므로 alwaysFourColor를 사용합니다.
+	void EncodeColorBlock(const std::uint8_t* source, const BlockPixels& pixels, bool alwaysFourColor, BlockCompressionQuality quality, std::uint8_t* block)
+	{
+		std::uint32_t opaqueMask = c_allPixels;
+		if (!alwaysFourColor)
+		{
+			for (std::uint32_t i = 0; i < c_blockPixelCount; i++)
+			{
+				if (source[i * 4 + 3] < c_bc1AlphaThreshold)
+				{
+					opaqueMask &= ~(1u << i);
+				}
+			}
+		}
+		const bool hasTransparency = opaqueMask != c_allPixels;
+
+		ColorBlockTrial best;
+		if (opaqueMask == 0)
+		{
+			// 모두 투명합니다.
+			EvaluateColorEndpoints(pixels, opaqueMask, 0, 0, false, &best);
+			WriteColorBlock(best, block);
+			return;
+		}
+
+		// 단색 블록은 표에서 2/3 보간 값이 그 색에 가장 가까운 끝점을 찾습니다.
+		std::uint32_t first = 0;
+		while ((opaqueMask & (1u << first)) == 0)
+		{
+			first++;
+		}
+		bool solid = !hasTransparency;
+		for (std::uint32_t i = first + 1; i < c_blockPixelCount && solid; i++)
+		{
+			solid = memcmp(source + i * 4, source + first * 4, 3) == 0;
+		}
+		if (solid)
+		{
+			static const SingleColorTable s_table5(5);
+			static const SingleColorTable s_table6(6);
+			const std::uint8_t* color = source + first * 4;
+			const std::uint16_t color0 = static_cast<std::uint16_t>((s_table5.endpoints[color[0]][0] << 11) | (s_table6.endpoints[color[1]][0] << 5) | s_table5.endpoints[color[2]][0]);
+			const std::uint16_t color1 = static_cast<std::uint16_t>((s_table5.endpoints[color[0]][1] << 11) | (s_table6.endpoints[color[1]][1] << 5) | s_table5.endpoints[color[2]][1]);
+			if (alwaysFourColor || color0 > color1)
+			{
+				EvaluateColorEndpoints(pixels, opaqueMask, color0, color1, alwaysFourColor, &best);
+			}
+			else
+			{
+				EvaluateColorEndpoints(pixels, opaqueMask, color1, color0, alwaysFourColor, &best);
+			}
+			WriteColorBlock(best, block);
+			return;
+		}
+
+		float a[4], b[4];
+		ComputeInitialEndpoints(pixels, opaqueMask, 3, quality, a, b);
+		if (quality == BlockCompressionQuality::Fast)
+		{
+			// 경계 상자는 바깥쪽 픽셀에 끌리므로 범위의 1/16만큼 안쪽으로 당깁니다.
+			for (std::uint32_t c = 0; c < 3; c++)
+			{
+				const float inset = (b[c] - a[c]) / 16.0f;
+				a[c] += inset;
+				b[c] -= inset;
+			}
+		}
+
+		const std::uint32_t iterations = GetRefinementCount(quality);
+		EvaluateColorCandidate(pixels, opaqueMask, a, b, !hasTransparency, alwaysFourColor, &best);
+		RefineColorTrial(pixels, opaqueMask, alwaysFourColor, iterations, &best);
+
+		// 불투명 블록도 3색 모드(중간값 하나)가 더 나을 수 있으므로 높은 품질에서는 함께 비교합니다.
+		if (quality == BlockCompressionQuality::High && !hasTransparency && !alwaysFourColor)
+		{
+			ColorBlockTrial threeColor;
+			EvaluateColorCandidate(pixels, opaqueMask, a, b, false, false, &threeColor);
+			RefineColorTrial(pixels, opaqueMask, false, iterations, &threeColor);
+			if (threeColor.error < best.error)
+			{
+				best = threeColor;
+			}
+		}
+
+		WriteColorBlock(best, block);
+	}
+
+	// BC3 알파 블록(BC4)입니다.
+
+	struct AlphaBlockTrial
+	{
+		std::uint8_t	alpha0;
+		std::uint8_t	alpha1;
+		std::uint8_t	indices[c_blockPixelCount];
+		std::uint32_t	error;
+	};
+
+	void EvaluateAlphaEndpoints(const std::uint8_t* alphas, std::uint32_t alpha0, std::uint32_t alpha1, AlphaBlockTrial* trial)
+	{
+		// 디코더 규칙대로 팔레트를 만듭니다. alpha0 > alpha1이면 8단계 보간, 아니면 6단계 보간과 0, 255입니다.
+		std::uint32_t palette[8];
+		palette[0] = alpha0;
+		palette[1] = alpha1;
+		if (alpha0 > alpha1)
+		{
+			for (std::uint32_t i = 1; i < 7; i++)
+			{
+				palette[i + 1] = ((7 - i) * alpha0 + i * alpha1 + 3) / 7;
+			}
+		}
+		else
+		{
+			for (std::uint32_t i = 1; i < 5; i++)
+			{
+				palette[i + 1] = ((5 - i) * alpha0 + i * alpha1 + 2) / 5;
+			}
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+
+		trial->alpha0 = static_cast<std::uint8_t>(alpha0);
+		trial->alpha1 = static_cast<std::uint8_t>(alpha1);
+		trial->error = 0;
+		for (std::uint32_t i = 0; i < c_blockPixelCount; i++)
+		{
+			std::uint32_t bestError = ~0u;
+			for (std::uint32_t entry = 0; entry < 8; entry++)
+			{
+				const int difference = static_cast<int>(palette[entry]) - alphas[i];
+				const std::uint32_t error = static_cast<std::uint32_t>(difference * difference);
+				if (error < bestError)
+				{
+					bestError = error;
+					trial->indices[i] = static_cast<std::uint8_t>(entry);
+				}
+			}
+			trial->error += bestError;
+		}
+	}
+
+	void EncodeAlphaBlock(const std::uint8_t* source, BlockCompressionQuality quality, std::uint8_t* block)
+	{
+		std::uint8_t alphas[c_blockPixelCount];
+		std::uint32_t minimum = 255, maximum = 0;
+		std::uint32_t innerMinimum = 255, innerMaximum = 0;
+		for (std::uint32_t i = 0; i < c_blockPixelCount; i++)
+		{
+			const std::uint32_t alpha = source[i * 4 + 3];
+			alphas[i] = static_cast<std::uint8_t>(alpha);
+			minimum = (std::min)(minimum, alpha);
+			maximum = (std::max)(maximum, alpha);
+			if (alpha != 0 && alpha != 255)
+			{
+				innerMinimum = (std::min)(innerMinimum, alpha);
+				innerMaximum = (std::max)(innerMaximum, alpha);
+			}
+		}
+
+		AlphaBlockTrial best;
+		EvaluateAlphaEndpoints(alphas, maximum, minimum, &best);
+
+		if (quality != BlockCompressionQuality::Fast && best.error != 0)
+		{
+			// 0과 255를 직접 표현하는 6단계 모드는 완전히 투명하거나 불투명한 픽셀이 섞인 블록에 유리합니다.
+			if (innerMinimum <= innerMaximum)
+			{
+				AlphaBlockTrial trial;
+				EvaluateAlphaEndpoints(alphas, innerMinimum, innerMaximum, &trial);
+				if (trial.error < best.error)
+				{
+					best = trial;
+				}
+			}
+
+			// 높은 품질에서는 8단계 모드의 끝점을 조금씩 움직여 봅니다.
+			if (quality == BlockCompressionQuality::High)
+			{
+				const int radius = 2;
+				for (int d0 = -radius; d0 <= radius; d0++)
+				{
+					for (int d1 = -radius; d1 <= radius; d1++)
+					{
+						const int alpha0 = static_cast<int>(maximum) + d0;
+						const int alpha1 = static_cast<int>(minimum) + d1;
+						if (alpha0 > 255 || alpha1 < 0 || alpha0 <= alpha1)
+						{
+							continue;
+						}
+						AlphaBlockTrial trial;
+						EvaluateAlphaEndpoints(alphas, static_cast<std::uint32_t>(alpha0), static_cast<std::uint32_t>(alpha1), &trial);
+						if (trial.error < best.error)
+						{
+							best = trial;
+						}
+					}
+				}
+			}
+		}
+
+		block[0] = best.alpha0;
+		block[1] = best.alpha1;
+		std::uint64_t indexBits = 0;
+		for (std::uint32_t i = 0; i < c_blockPixelCount; i++)
+		{
+			indexBits |= static_cast<std::uint64_t>(best.indices[i]) << (i * 3);
+		}
+		for (std::uint32_t i = 0; i < 6; i++)
+		{
+			block[2 + i] = static_cast<std::uint8_t>(indexBits >> (i * 8));
+		}
+	}
+
+	// BC7 모드 6 블록입니다.
+
+	struct Bc7BlockTrial
+	{
+		std::uint8_t	endpoints[2][4];	// 7비트 양자화 값입니다.
+		std::uint8_t	pBits[2];
+		std::uint8_t	indices[c_blockPixelCount];
+		float			error;
+	};
+
+	// 끝점을 p 비트와 함께 7비트로 양자화합니다. 디코딩 값은 (q << 1) | p입니다.
+	float QuantizeBc7Endpoint(const float* endpoint, std::uint32_t pBit, std::uint8_t* quantized)
+	{
+		float error = 0.0f;
+		for (std::uint32_t c = 0; c < 4; c++)
+		{
+			const int q = static_cast<int>(std::floor((endpoint[c] - pBit) * 0.5f + 0.5f));
+			quantized[c] = static_cast<std::uint8_t>((std::min)((std::max)(q, 0), 127));
+			const float difference = static_cast<float>((quantized[c] << 1) | pBit) - endpoint[c];
+			error += difference * difference;
+		}
+		return error;
+	}
+
+	void EvaluateBc7Endpoints(const BlockPixels& pixels, const float* a, const float* b, std::uint32_t pBit0, std::uint32_t pBit1, Bc7BlockTrial* trial)
+	{
+		QuantizeBc7Endpoint(a, pBit0, trial->endpoints[0]);
+		QuantizeBc7Endpoint(b, pBit1, trial->endpoints[1]);
+		trial->pBits[0] = static_cast<std::uint8_t>(pBit0);
+		trial->pBits[1] = static_cast<std::uint8_t>(pBit1);
+
+		Palette palette;
+		ClearPalette(&palette, 16);
+		for (std::uint32_t c = 0; c < 4; c++)
+		{
+			const std::uint32_t e0 = (trial->endpoints[0][c] << 1) | pBit0;
+			const std::uint32_t e1 = (trial->endpoints[1][c] << 1) | pBit1;
+			for (std::uint32_t i = 0; i < 16; i++)
+			{
+				palette.channels[c][i] = static_cast<float>(((64 - c_bc7Weights[i]) * e0 + c_bc7Weights[i] * e1 + 32) >> 6);
+			}
+		}
+		trial->error = AssignIndices(pixels, c_allPixels, palette, 4, trial->indices);
+	}
+
+	// 보통 품질은 끝점마다 양자화 오차가 작은 p 비트를, 높은 품질은 네 조합을 모두 평가하여 고릅니다.
+	void EvaluateBc7Candidate(const BlockPixels& pixels, const float* a, const float* b, BlockCompressionQuality quality, Bc7BlockTrial* best)
+	{
+		if (quality == BlockCompressionQuality::High)
+		{
+			best->error = 3.4e38f;
+			for (std::uint32_t p = 0; p < 4; p++)
+			{
+				Bc7BlockTrial trial;
+				EvaluateBc7Endpoints(pixels, a, b, p & 1, p >> 1, &trial);
+				if (trial.error < best->error)
+				{
+					*best = trial;
+				}
+			}
+			return;
+		}
+
+		std::uint8_t quantized[4];
+		const std::uint32_t pBit0 = QuantizeBc7Endpoint(a, 1, quantized) < QuantizeBc7Endpoint(a, 0, quantized) ? 1 : 0;
+		const std::uint32_t pBit1 = QuantizeBc7Endpoint(b, 1, quantized) < QuantizeBc7Endpoint(b, 0, quantized) ? 1 : 0;
+		EvaluateBc7Endpoints(pixels, a, b, pBit0, pBit1, best);
+	}
+
+	// 블록에 비트를 낮은 자리부터 차례로 씁니다.
+	class BitWriter
+	{
+	public:
+		explicit BitWriter(std::uint8_t* data) : m_data(data), m_position(0) {}
+
+		void Write(std::uint32_t value, std::uint32_t bitCount)
+		{
+			for (std::uint32_t i = 0; i < bitCount; i++, m_position++)
+			{
+				m_data[m_position >> 3] |= static_cast<std::uint8_t>(((value >> i) & 1) << (m_position & 7));
+			}
+		}
+
+	private:
+		std::uint8_t*	m_data;
+		std::uint32_t	m_position;
+	};
+
+	void EncodeBc7Block(const BlockPixels& pixels, BlockCompressionQuality quality, std::uint8_t* block)
+	{
+		float a[4], b[4];
+		ComputeInitialEndpoints(pixels, c_allPixels, 4, quality, a, b);
+
+		Bc7BlockTrial best;
+		EvaluateBc7Candidate(pixels, a, b, quality, &best);
+
+		const std::uint32_t iterations = GetRefinementCount(quality);
+		for (std::uint32_t iteration = 0; iteration < iterations && best.error > 0.0f; iteration++)
+		{
+			float t[c_blockPixelCount];
+			for (std::uint32_t i = 0; i < c_blockPixelCount; i++)
+			{
+				t[i] = c_bc7Weights[best.indices[i]] / 64.0f;
+			}
+			if (!SolveEndpoints(pixels, c_allPixels, t, 4, a, b))
+			{
+				break;
+			}
+
+			Bc7BlockTrial trial;
+			EvaluateBc7Candidate(pixels, a, b, quality, &trial);
+			if (trial.error >= best.error)
+			{
+				break;
+			}
+			best = trial;
+		}
+
+		// 첫 픽셀(고정 인덱스)의 인덱스는 최상위 비트가 0이어야 하므로 필요하면 끝점을 바꾸고 인덱스를 뒤집습니다.
+		if (best.indices[0] >= 8)
+		{
+			for (std::uint32_t c = 0; c < 4; c++)
+			{
+				std::swap(best.endpoints[0][c], best.endpoints[1][c]);
+			}
+			std::swap(best.pBits[0], best.pBits[1]);
+			for (auto& index : best.indices)
+			{
+				index = static_cast<std::uint8_t>(15 - index);
+			}
+		}
+
+		memset(block, 0, 16);
+		BitWriter writer(block);
+		writer.Write(1u << 6, 7);
+		for (std::uint32_t c = 0; c < 4; c++)
+		{
+			writer.Write(best.endpoints[0][c], 7);
+			writer.Write(best.endpoints[1][c], 7);
+		}
+		writer.Write(best.pBits[0], 1);
+		writer.Write(best.pBits[1], 1);
+		writer.Write(best.indices[0], 3);
+		for (std::uint32_t i = 1; i < c_blockPixelCount; i++)
+		{
+			writer.Write(best.indices[i], 4);
+		}
+	}
+
+	void LoadBlock(const std::uint8_t* source, std::uint32_t width, std::uint32_t height, std::size_t rowPitch, std::uint32_t blockX, std::uint32_t blockY, std::uint8_t* pixels)
+	{
+		for (std::uint32_t y = 0; y < 4; y++)
+		{
+			const std::uint8_t* row = source + rowPitch * (std::min)(blockY * 4 + y, height - 1);
+			if (blockX * 4 + 4 <= width)
+			{
+				memcpy(pixels + y * 16, row + blockX * 16, 16);
+				continue;
+			}
+			for (std::uint32_t x = 0; x < 4; x++)
+			{
+				memcpy(pixels + y * 16 + x * 4, row + (std::min)(blockX * 4 + x, width - 1) * 4, 4);
+			}
+		}
+	}
+}
+
+std::uint32_t DX::GetBlockSize(BlockFormat format)
+{
+	return format == BlockFormat::BC1 ? 8 : 16;
+}
+
+#if defined(_WIN32)
+DXGI_FORMAT DX::GetDxgiFormat(BlockFormat format, bool srgb)
+{
+	switch (format)
+	{
+	case BlockFormat::BC1:	return srgb ? DXGI_FORMAT_BC1_UNORM_SRGB : DXGI_FORMAT_BC1_UNORM;
+	case BlockFormat::BC3:	return srgb ? DXGI_FORMAT_BC3_UNORM_SRGB : DXGI_FORMAT_BC3_UNORM;
+	default:				return srgb ? DXGI_FORMAT_BC7_UNORM_SRGB : DXGI_FORMAT_BC7_UNORM;
+	}
+}
+#endif
+
+void DX::CompressBlock(const std::uint8_t* pixels, BlockFormat format, BlockCompressionQuality quality, std::uint8_t* block)
+{
+	BlockPixels values;
+	for (std::uint32_t i = 0; i < c_blockPixelCount; i++)
+	{
+		for (std::uint32_t c = 0; c < 4; c++)
+		{
+			values[i][c] = pixels[i * 4 + c];
+		}
+	}
+
+	switch (format)
+	{
+	case BlockFormat::BC1:
+		EncodeColorBlock(pixels, values, false, quality, block);
+		break;
+
+	case BlockFormat::BC3:
+		EncodeAlphaBlock(pixels, quality, block);
+		EncodeColorBlock(pixels, values, true, quality, block + 8);
+		break;
+
+	default:
+		EncodeBc7Block(values, quality, block);
+		break;
+	}
+}
+
+void DX::CompressTexture(
+	const std::uint8_t* source,
+	std::uint32_t width,
+	std::uint32_t height,
+	std::size_t sourceRowPitch,
+	BlockFormat format,
+	BlockCompressionQuality quality,
+	std::uint8_t* destination,
+	std::size_t destinationRowPitch)
+{
+	if (source == nullptr || destination == nullptr || width == 0 || height == 0 ||
+		sourceRowPitch < static_cast<std::size_t>(width) * 4 ||
+		destinationRowPitch < GetBlockCompressedRowPitch(format, width))
+	{
+		ThrowInvalidArgument();
+	}
+
+	const std::uint32_t blocksWide = GetBlockCount(width);
+	const std::uint32_t blocksHigh = GetBlockCount(height);
+	const std::uint32_t blockSize = GetBlockSize(format);
+
+	ParallelForRowBlocks(blocksHigh, static_cast<std::size_t>(width) * 16, c_minBytesPerBlock, [&](std::uint32_t begin, std::uint32_t end)
+	{
+		std::uint8_t pixels[c_blockPixelCount * 4];
+		for (std::uint32_t blockY = begin; blockY < end; blockY++)
+		{
+			std::uint8_t* blockRow = destination + destinationRowPitch * blockY;
+			for (std::uint32_t blockX = 0; blockX < blocksWide; blockX++)
+			{
+				LoadBlock(source, width, height, sourceRowPitch, blockX, blockY, pixels);
+				CompressBlock(pixels, format, quality, blockRow + blockX * blockSize);
+			}
+		}
+	});
+}
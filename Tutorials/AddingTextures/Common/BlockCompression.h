@@ -0,0 +1,57 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace DX
+{
+	enum class BlockFormat
+	{
+		BC1,	// 블록당 8바이트입니다. RGB와 1비트 알파(알파가 128 미만인 픽셀은 투명한 검정)를 저장합니다.
+		BC3,	// 블록당 16바이트입니다. BC1 색 블록과 8단계 보간 알파 블록을 저장합니다.
+		BC7,	// 블록당 16바이트입니다. 모드 6(RGBA 7777 + p 비트, 4비트 인덱스)으로 인코딩합니다.
+	};
+
+	enum class BlockCompressionQuality
+	{
+		Fast,	// 경계 상자 끝점만 사용합니다. 실행 중에 만드는 텍스처용입니다.
+		Normal,	// 주성분 축 끝점을 최소 제곱으로 한 번 다듬습니다.
+		High,	// 다듬기를 반복하고 BC1 3색 모드, BC7 p 비트 조합 등 후보를 모두 비교합니다. 오프라인 쿠킹용입니다.
+	};
+
+	// 4x4 블록 하나의 바이트 수입니다.
+	std::uint32_t GetBlockSize(BlockFormat format);
+
+	// width 픽셀을 덮는 블록 수입니다. 가장자리의 부분 블록을 포함합니다.
+	inline std::uint32_t GetBlockCount(std::uint32_t pixels)
+	{
+		return pixels != 0 ? (pixels + 3) / 4 : 1;
+	}
+
+	// 빽빽한 블록 행 하나의 바이트 수입니다. GetCopyableFootprints의 RowPitch는 이 값을 256바이트로 올림한 값입니다.
+	inline std::size_t GetBlockCompressedRowPitch(BlockFormat format, std::uint32_t width)
+	{
+		return static_cast<std::size_t>(GetBlockCount(width)) * GetBlockSize(format);
+	}
+
+#if defined(_WIN32)
+	DXGI_FORMAT GetDxgiFormat(BlockFormat format, bool srgb);
+#endif
+
+	// RGBA8 4x4 블록(행 순서 16픽셀, 64바이트) 하나를 block에 인코딩합니다.
+	void CompressBlock(const std::uint8_t* pixels, BlockFormat format, BlockCompressionQuality quality, std::uint8_t* block);
+
+	// RGBA8 텍스처 전체를 블록 압축합니다. destination에는 블록 행이 destinationRowPitch 간격으로 기록되므로
+	// GetCopyableFootprints가 돌려준 배치의 업로드 버퍼에 직접 쓸 수 있습니다. 행 사이의 여백은 건드리지 않습니다.
+	// 크기가 4의 배수가 아니면 가장자리 픽셀을 반복하여 부분 블록을 채웁니다. 블록 행은 여러 스레드에서 인코딩합니다.
+	// 잘못된 인수는 E_INVALIDARG 예외를 발생시킵니다.
+	void CompressTexture(
+		const std::uint8_t* source,
+		std::uint32_t width,
+		std::uint32_t height,
+		std::size_t sourceRowPitch,
+		BlockFormat format,
+		BlockCompressionQuality quality,
+		std::uint8_t* destination,
+		std::size_t destinationRowPitch);
+}
@@ -0,0 +1,68 @@
+﻿#include "pch.h"
+#include "CommandListPool.h"
+#include "DirectXHelper.h"
+
+using namespace DX;
+
+CommandListPool::CommandListPool(ID3D12Device* device, D3D12_COMMAND_LIST_TYPE type, UINT frameCount) :
+	m_device(device),
+	m_type(type),
+	m_frames(frameCount),
+	m_currentFrame(0)
+{
+	for (auto& frame : m_frames)
+	{
+		frame.used = 0;
+	}
+}
+
+void CommandListPool::BeginFrame(UINT frameIndex)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	m_currentFrame = frameIndex % static_cast<UINT>(m_frames.size());
+
+	// 이 프레임에서 사용한 할당기만 재설정합니다. 목록은 Acquire에서 다시 열립니다.
+	Frame& frame = m_frames[m_currentFrame];
+	for (UINT i = 0; i < frame.used; i++)
+	{
+		DX::ThrowIfFailed(frame.entries[i].allocator->Reset());
+	}
+	frame.used = 0;
+}
+
+ID3D12GraphicsCommandList* CommandListPool::Acquire(ID3D12PipelineState* initialState)
+{
+	ID3D12CommandAllocator* allocator = nullptr;
+	ID3D12GraphicsCommandList* commandList = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
+		Frame& frame = m_frames[m_currentFrame];
+		if (frame.used == frame.entries.size())
+		{
+			// 새로 만든 목록은 이미 열린 상태이므로 바로 반환합니다.
+			Entry entry;
+			DX::ThrowIfFailed(m_device->CreateCommandAllocator(m_type, IID_PPV_ARGS(&entry.allocator)));
+			DX::ThrowIfFailed(m_device->CreateCommandList(0, m_type, entry.allocator.Get(), initialState, IID_PPV_ARGS(&entry.commandList)));
+
+#if defined(_DEBUG)
+			WCHAR name[64];
+			swprintf_s(name, L"CommandListPool[%u][%u]", m_currentFrame, frame.used);
+			entry.allocator->SetName(name);
+			entry.commandList->SetName(name);
+#endif
+
+			frame.entries.push_back(entry);
+			return frame.entries[frame.used++].commandList.Get();
+		}
+
+		allocator = frame.entries[frame.used].allocator.Get();
+		commandList = frame.entries[frame.used].commandList.Get();
+		frame.used++;
+	}
+
+	// 목록 재설정은 잠금 밖에서 수행합니다. 쌍은 이 호출자만 사용합니다.
+	DX::ThrowIfFailed(commandList->Reset(allocator, initialState));
+	return commandList;
+}
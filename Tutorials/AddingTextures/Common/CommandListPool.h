@@ -0,0 +1,95 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include "DirectXHelper.h"
+#include "ParallelFor.h"
+
+namespace DX
+{
+	// 프레임별 명령 할당기/명령 목록 쌍의 풀입니다.
+	// Acquire를 호출할 때마다 다른 쌍을 받으므로 작업자 스레드마다 자신의 할당기에 동시에 기록할 수 있습니다.
+	// 할당기는 해당 프레임의 fence가 완료된 뒤 BeginFrame에서 한꺼번에 재설정되며, 필요한 만큼 쌍이 추가됩니다.
+	class CommandListPool
+	{
+	public:
+		CommandListPool(ID3D12Device* device, D3D12_COMMAND_LIST_TYPE type, UINT frameCount);
+
+		// frameIndex에서 사용한 할당기를 재설정하고 현재 프레임으로 만듭니다. 그 프레임의 GPU 작업이 완료된 뒤에만 호출해야 합니다.
+		void BeginFrame(UINT frameIndex);
+
+		// 현재 프레임의 할당기로 재설정된, 기록 중인 명령 목록을 반환합니다. 여러 스레드에서 호출할 수 있습니다.
+		// 목록은 Close 후 이 프레임 안에서 제출해야 합니다.
+		ID3D12GraphicsCommandList* Acquire(ID3D12PipelineState* initialState = nullptr);
+
+		UINT GetUsedCount() const	{ return m_frames[m_currentFrame].used; }
+
+	private:
+		struct Entry
+		{
+			Microsoft::WRL::ComPtr<ID3D12CommandAllocator>		allocator;
+			Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList>	commandList;
+		};
+
+		struct Frame
+		{
+			std::vector<Entry>	entries;
+			UINT				used;
+		};
+
+		Microsoft::WRL::ComPtr<ID3D12Device>	m_device;
+		D3D12_COMMAND_LIST_TYPE					m_type;
+
+		std::mutex								m_lock;
+		std::vector<Frame>						m_frames;
+		UINT									m_currentFrame;
+	};
+
+	// 항목 수에 맞는 작업자 수입니다. 작업자마다 최소 minItemsPerWorker개를 기록하며 하드웨어 스레드 수를 넘지 않습니다.
+	inline UINT GetRecordingWorkerCount(UINT itemCount, UINT minItemsPerWorker)
+	{
+		const UINT hardwareThreads = (std::max)(std::thread::hardware_concurrency(), 1u);
+		const UINT byItems = itemCount / (std::max)(minItemsPerWorker, 1u);
+		return (std::max)((std::min)(byItems, hardwareThreads), 1u);
+	}
+
+	// 항목 [0, itemCount)를 workerCount개의 연속 구간으로 나누어 병렬로 기록합니다.
+	// 각 구간은 풀에서 받은 자신의 목록에 recordRange(commandList, begin, end)로 기록되며, 상태는 목록마다 다시 설정해야 합니다.
+	// 닫힌 목록은 구간 순서대로 commandLists 끝에 추가되므로, 호출자는 앞뒤 목록과 함께 ExecuteCommandLists 한 번으로 제출합니다.
+	template<typename RecordRange>
+	void RecordParallel(
+		CommandListPool* pool,
+		ID3D12PipelineState* initialState,
+		UINT itemCount,
+		UINT workerCount,
+		const RecordRange& recordRange,
+		std::vector<ID3D12CommandList*>* commandLists)
+	{
+		workerCount = (std::max)((std::min)(workerCount, itemCount), 1u);
+
+		const size_t first = commandLists->size();
+		commandLists->resize(first + workerCount);
+
+		auto recordWorker = [&](UINT worker)
+		{
+			const UINT begin = static_cast<UINT>(static_cast<UINT64>(itemCount) * worker / workerCount);
+			const UINT end = static_cast<UINT>(static_cast<UINT64>(itemCount) * (worker + 1) / workerCount);
+
+			ID3D12GraphicsCommandList* commandList = pool->Acquire(initialState);
+			recordRange(commandList, begin, end);
+			DX::ThrowIfFailed(commandList->Close());
+			(*commandLists)[first + worker] = commandList;
+		};
+
+		// 작업자가 하나이면 스레드 전환 없이 호출한 스레드에서 기록합니다.
+		if (workerCount == 1)
+		{
+			recordWorker(0);
+		}
+		else
+		{
+			DX::ParallelFor(workerCount, recordWorker);
+		}
+	}
+}
@@ -0,0 +1,157 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "ImportedMesh.h"
+
+namespace DX
+{
+	// 쿠킹된 메시 파일의 형식입니다. 플랫폼 API에 의존하지 않으므로 쿠커 도구와 앱이 함께 사용합니다.
+	//
+	// 헤더	: CookedMeshHeader (64바이트)
+	// 꼭짓점	: vertexOffset부터 vertexCount개의 MeshVertex
+	// 인덱스	: indexOffset부터 indexCount개의 16비트 또는 32비트 인덱스(삼각형 목록)
+	// 두 블롭은 c_cookedMeshAlignment에 맞추므로, 파일을 매핑하면 변환 없이 업로드 버퍼로 바로 복사할 수 있습니다.
+	// 모든 값은 little-endian입니다.
+	static const std::uint32_t c_cookedMeshMagic = 0x48534D44;	// 'DMSH'
+	static const std::uint32_t c_cookedMeshVersion = 1;
+	static const std::uint32_t c_cookedMeshAlignment = 256;
+
+	static const std::uint32_t c_cookedMeshHasNormals = 0x1;
+	static const std::uint32_t c_cookedMeshHasTexCoords = 0x2;
+
+	struct CookedMeshHeader
+	{
+		std::uint32_t	magic;
+		std::uint32_t	version;
+		std::uint32_t	vertexStride;
+		std::uint32_t	indexSize;		// 2 또는 4입니다.
+		std::uint32_t	vertexCount;
+		std::uint32_t	indexCount;
+		std::uint32_t	flags;
+		std::uint32_t	reserved;
+		float			boundsMin[3];
+		float			boundsMax[3];
+		std::uint32_t	vertexOffset;	// 파일 시작 기준입니다.
+		std::uint32_t	indexOffset;
+	};
+	static_assert(sizeof(CookedMeshHeader) == 64, "CookedMeshHeader는 파일의 헤더와 같은 배치여야 합니다.");
+
+	// 매핑된 쿠킹 메시의 보기입니다. vertices와 indices는 파일 데이터를 직접 가리킵니다.
+	struct CookedMeshView
+	{
+		CookedMeshHeader		header;
+		const std::uint8_t*		vertices;
+		const std::uint8_t*		indices;
+		std::size_t				vertexDataSize;
+		std::size_t				indexDataSize;
+	};
+
+	// 메시를 쿠킹된 형식으로 씁니다. 꼭짓점이 65535개 이하이면 16비트 인덱스를 씁니다.
+	// 파일이 4GB를 넘거나 인덱스가 꼭짓점 범위를 벗어나면 false를 반환합니다.
+	inline bool SerializeCookedMesh(const ImportedMesh& mesh, std::vector<std::uint8_t>* file)
+	{
+		file->clear();
+
+		const std::size_t vertexCount = mesh.vertices.size();
+		const std::size_t indexCount = mesh.indices.size();
+		const std::uint32_t indexSize = vertexCount <= 0xFFFF ? 2 : 4;
+		const std::uint64_t alignmentMask = c_cookedMeshAlignment - 1;
+		const std::uint64_t vertexOffset = (sizeof(CookedMeshHeader) + alignmentMask) & ~alignmentMask;
+		const std::uint64_t indexOffset = (vertexOffset + vertexCount * sizeof(MeshVertex) + alignmentMask) & ~alignmentMask;
+		const std::uint64_t fileSize = indexOffset + indexCount * static_cast<std::uint64_t>(indexSize);
+		if (fileSize > UINT32_MAX || indexCount % 3 != 0)
+		{
+			return false;
+		}
+
+		CookedMeshHeader header = {};
+		header.magic = c_cookedMeshMagic;
+		header.version = c_cookedMeshVersion;
+		header.vertexStride = sizeof(MeshVertex);
+		header.indexSize = indexSize;
+		header.vertexCount = static_cast<std::uint32_t>(vertexCount);
+		header.indexCount = static_cast<std::uint32_t>(indexCount);
+		header.flags = (mesh.hasNormals ? c_cookedMeshHasNormals : 0) | (mesh.hasTexCoords ? c_cookedMeshHasTexCoords : 0);
+		header.vertexOffset = static_cast<std::uint32_t>(vertexOffset);
+		header.indexOffset = static_cast<std::uint32_t>(indexOffset);
+		for (std::uint32_t k = 0; k < 3; k++)
+		{
+			header.boundsMin[k] = vertexCount != 0 ? mesh.vertices[0].position[k] : 0.0f;
+			header.boundsMax[k] = header.boundsMin[k];
+		}
+		for (const MeshVertex& vertex : mesh.vertices)
+		{
+			for (std::uint32_t k = 0; k < 3; k++)
+			{
+				header.boundsMin[k] = (std::min)(header.boundsMin[k], vertex.position[k]);
+				header.boundsMax[k] = (std::max)(header.boundsMax[k], vertex.position[k]);
+			}
+		}
+
+		file->resize(static_cast<std::size_t>(fileSize));
+		std::memcpy(file->data(), &header, sizeof(header));
+		if (vertexCount != 0)
+		{
+			std::memcpy(file->data() + vertexOffset, mesh.vertices.data(), vertexCount * sizeof(MeshVertex));
+		}
+
+		std::uint8_t* indices = file->data() + indexOffset;
+		for (std::size_t i = 0; i < indexCount; i++)
+		{
+			const std::uint32_t index = mesh.indices[i];
+			if (index >= vertexCount)
+			{
+				file->clear();
+				return false;
+			}
+			if (indexSize == 2)
+			{
+				const std::uint16_t narrow = static_cast<std::uint16_t>(index);
+				std::memcpy(indices + i * 2, &narrow, sizeof(narrow));
+			}
+			else
+			{
+				std::memcpy(indices + i * 4, &index, sizeof(index));
+			}
+		}
+		return true;
+	}
+
+	// 헤더와 블롭 범위를 검증하고 보기를 채웁니다. 인덱스 값은 검사하지 않으므로(GPU는 범위 밖 꼭짓점을 0으로 읽음) 로드 비용은 헤더 크기뿐입니다.
+	inline bool ParseCookedMesh(const std::uint8_t* data, std::size_t size, CookedMeshView* view)
+	{
+		if (size < sizeof(CookedMeshHeader))
+		{
+			return false;
+		}
+
+		CookedMeshHeader& header = view->header;
+		std::memcpy(&header, data, sizeof(header));
+		if (header.magic != c_cookedMeshMagic || header.version != c_cookedMeshVersion ||
+			header.vertexStride != sizeof(MeshVertex) || (header.indexSize != 2 && header.indexSize != 4) ||
+			header.indexCount % 3 != 0 ||
+			(header.vertexOffset & (c_cookedMeshAlignment - 1)) != 0 || (header.indexOffset & (c_cookedMeshAlignment - 1)) != 0)
+		{
+			return false;
+		}
+
+		const std::uint64_t vertexDataSize = static_cast<std::uint64_t>(header.vertexCount) * header.vertexStride;
+		const std::uint64_t indexDataSize = static_cast<std::uint64_t>(header.indexCount) * header.indexSize;
+		if (header.vertexOffset < sizeof(CookedMeshHeader) ||
+			header.vertexOffset + vertexDataSize > header.indexOffset ||
+			header.indexOffset + indexDataSize > size)
+		{
+			return false;
+		}
+
+		view->vertices = data + header.vertexOffset;
+		view->indices = data + header.indexOffset;
+		view->vertexDataSize = static_cast<std::size_t>(vertexDataSize);
+		view->indexDataSize = static_cast<std::size_t>(indexDataSize);
+		return true;
+	}
+}
@@ -0,0 +1,72 @@
+﻿#include "pch.h"
+#include "CookedMeshLoader.h"
+#include "DirectXHelper.h"
+
+#if !defined(_WIN32)
+#include <stdexcept>
+#endif
+
+using namespace DX;
+
+namespace
+{
+	const D3D12_INPUT_ELEMENT_DESC c_meshVertexElements[] =
+	{
+		{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+		{ "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+		{ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 24, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+	};
+
+	void CreateBuffer(ID3D12Device* device, UINT64 size, ID3D12Resource** buffer)
+	{
+		CD3DX12_HEAP_PROPERTIES defaultHeapProperties(D3D12_HEAP_TYPE_DEFAULT);
+		CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+		DX::ThrowIfFailed(device->CreateCommittedResource(
+			&defaultHeapProperties,
+			D3D12_HEAP_FLAG_NONE,
+			&bufferDesc,
+			D3D12_RESOURCE_STATE_COMMON,
+			nullptr,
+			IID_PPV_ARGS(buffer)));
+	}
+
+	void ThrowInvalidData()
+	{
+#if defined(_WIN32)
+		DX::ThrowIfFailed(HRESULT_FROM_WIN32(ERROR_INVALID_DATA));
+#else
+		throw std::runtime_error("invalid cooked mesh file");
+#endif
+	}
+}
+
+const D3D12_INPUT_LAYOUT_DESC CookedMesh::InputLayout = { c_meshVertexElements, _countof(c_meshVertexElements) };
+
+void DX::CreateCookedMesh(ID3D12Device* device, const AssetView& file, UploadBatch* batch, CookedMesh* mesh)
+{
+	CookedMeshView view;
+	if (!ParseCookedMesh(file.GetData(), file.GetSize(), &view) || view.header.vertexCount == 0 || view.header.indexCount == 0)
+	{
+		ThrowInvalidData();
+	}
+
+	CreateBuffer(device, view.vertexDataSize, &mesh->vertexBuffer);
+	CreateBuffer(device, view.indexDataSize, &mesh->indexBuffer);
+	NAME_D3D12_OBJECT(mesh->vertexBuffer);
+	NAME_D3D12_OBJECT(mesh->indexBuffer);
+
+	batch->AddBuffer(mesh->vertexBuffer.Get(), 0, view.vertices, view.vertexDataSize);
+	batch->AddBuffer(mesh->indexBuffer.Get(), 0, view.indices, view.indexDataSize);
+
+	mesh->vertexBufferView.BufferLocation = mesh->vertexBuffer->GetGPUVirtualAddress();
+	mesh->vertexBufferView.StrideInBytes = view.header.vertexStride;
+	mesh->vertexBufferView.SizeInBytes = static_cast<UINT>(view.vertexDataSize);
+
+	mesh->indexBufferView.BufferLocation = mesh->indexBuffer->GetGPUVirtualAddress();
+	mesh->indexBufferView.SizeInBytes = static_cast<UINT>(view.indexDataSize);
+	mesh->indexBufferView.Format = view.header.indexSize == 2 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+
+	mesh->indexCount = view.header.indexCount;
+	std::memcpy(mesh->boundsMin, view.header.boundsMin, sizeof(mesh->boundsMin));
+	std::memcpy(mesh->boundsMax, view.header.boundsMax, sizeof(mesh->boundsMax));
+}
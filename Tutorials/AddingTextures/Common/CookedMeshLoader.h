@@ -0,0 +1,27 @@
+﻿#pragma once
+
+#include "AssetPack.h"
+#include "CookedMeshFormat.h"
+#include "UploadBatch.h"
+
+namespace DX
+{
+	// 쿠킹된 메시의 GPU 버퍼입니다. 꼭짓점 형식은 MeshVertex이며 입력 레이아웃은 InputLayout입니다.
+	struct CookedMesh
+	{
+		static const D3D12_INPUT_LAYOUT_DESC InputLayout;
+
+		Microsoft::WRL::ComPtr<ID3D12Resource>	vertexBuffer;
+		Microsoft::WRL::ComPtr<ID3D12Resource>	indexBuffer;
+		D3D12_VERTEX_BUFFER_VIEW				vertexBufferView;
+		D3D12_INDEX_BUFFER_VIEW					indexBufferView;
+		UINT									indexCount;
+		float									boundsMin[3];
+		float									boundsMax[3];
+	};
+
+	// 쿠킹된 메시 파일(AssetView)로 COMMON 상태의 꼭짓점/인덱스 버퍼를 만들고, 두 블롭을 batch에 추가합니다.
+	// 블롭은 파일 매핑에서 업로드 링 버퍼로 바로 복사되므로 변환이나 중간 사본이 없고, 다른 리소스와 함께 한 번의 Submit으로 올라갑니다.
+	// batch는 매핑을 가리키기만 하므로 file은 Submit까지 유지되어야 합니다. 형식이 맞지 않으면 ERROR_INVALID_DATA 예외가 발생합니다.
+	void CreateCookedMesh(ID3D12Device* device, const AssetView& file, UploadBatch* batch, CookedMesh* mesh);
+}
@@ -0,0 +1,129 @@
+﻿#include "pch.h"
+#include "CopyQueue.h"
+#include "DirectXHelper.h"
+#include "CpuProfiler.h"
+
+using namespace DX;
+using namespace Microsoft::WRL;
+
+CopyQueue::CopyQueue(ID3D12Device* device, UINT64 uploadBufferSize) :
+	m_device(device),
+	m_fenceEvent(0),
+	m_lastTicket(0)
+{
+	D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+	queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+	queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+
+	DX::ThrowIfFailed(device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&m_commandQueue)));
+	NAME_D3D12_OBJECT(m_commandQueue);
+
+	DX::ThrowIfFailed(device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_fence)));
+	NAME_D3D12_OBJECT(m_fence);
+
+	m_fenceEvent = DX::CreateFenceEvent();
+
+	// 업로드 링은 복사 큐의 fence로 회수됩니다.
+	m_uploadBuffer = std::unique_ptr<UploadRingBuffer>(new UploadRingBuffer(device, m_fence.Get(), uploadBufferSize));
+}
+
+CopyQueue::~CopyQueue()
+{
+	// 복사 중인 리소스와 링 버퍼를 해제하기 전에 업로드가 끝나기를 기다립니다. 소멸자에서는 예외를 던지지 않습니다.
+	try
+	{
+		WaitForIdle();
+	}
+	catch (...)
+	{
+	}
+
+	DX::CloseFenceEvent(m_fenceEvent);
+}
+
+UploadTicket CopyQueue::Submit(const RecordFunction& record)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	// 완료된 업로드의 명령 할당기를 재사용하고, 없으면 새로 만듭니다.
+	const UINT64 completedValue = m_fence->GetCompletedValue();
+	Context* context = nullptr;
+	for (auto& candidate : m_contexts)
+	{
+		if (candidate.ticket <= completedValue)
+		{
+			context = &candidate;
+			break;
+		}
+	}
+
+	if (context != nullptr)
+	{
+		DX::ThrowIfFailed(context->allocator->Reset());
+		DX::ThrowIfFailed(context->commandList->Reset(context->allocator.Get(), nullptr));
+	}
+	else
+	{
+		Context newContext;
+		newContext.ticket = 0;
+		DX::ThrowIfFailed(m_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&newContext.allocator)));
+		DX::ThrowIfFailed(m_device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COPY, newContext.allocator.Get(), nullptr, IID_PPV_ARGS(&newContext.commandList)));
+		NAME_D3D12_OBJECT(newContext.commandList);
+
+		m_contexts.push_back(newContext);
+		context = &m_contexts.back();
+	}
+
+	m_uploadBuffer->Reclaim();
+
+	// 기록 중 예외가 발생해도 목록은 닫아 두어야 다음 업로드에서 재설정할 수 있습니다.
+	try
+	{
+		record(context->commandList.Get(), m_uploadBuffer.get());
+	}
+	catch (...)
+	{
+		context->commandList->Close();
+		throw;
+	}
+	DX::ThrowIfFailed(context->commandList->Close());
+
+	ID3D12CommandList* ppCommandLists[] = { context->commandList.Get() };
+	m_commandQueue->ExecuteCommandLists(_countof(ppCommandLists), ppCommandLists);
+
+	const UploadTicket ticket = ++m_lastTicket;
+	DX::ThrowIfFailed(m_commandQueue->Signal(m_fence.Get(), ticket));
+	m_uploadBuffer->Commit(ticket);
+	context->ticket = ticket;
+
+	return ticket;
+}
+
+void CopyQueue::WaitOnQueue(ID3D12CommandQueue* queue, UploadTicket ticket) const
+{
+	if (ticket != 0 && !IsComplete(ticket))
+	{
+		DX::ThrowIfFailed(queue->Wait(m_fence.Get(), ticket));
+	}
+}
+
+void CopyQueue::Wait(UploadTicket ticket)
+{
+	if (!IsComplete(ticket))
+	{
+		DX_CPU_ZONE("Wait for copy fence");
+		DX::WaitForFence(m_fence.Get(), ticket, m_fenceEvent);
+	}
+	m_uploadBuffer->Reclaim();
+}
+
+void CopyQueue::WaitForIdle()
+{
+	UploadTicket ticket;
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		ticket = m_lastTicket;
+	}
+
+	Wait(ticket);
+}
@@ -0,0 +1,62 @@
+﻿#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "UploadRingBuffer.h"
+
+namespace DX
+{
+	// 복사 큐에 제출한 업로드의 fence 값입니다. 0은 기다릴 필요가 없음을 뜻합니다.
+	typedef UINT64 UploadTicket;
+
+	// 직접 큐와 별도로 실행되는 D3D12_COMMAND_LIST_TYPE_COPY 큐와 자체 업로드 링 버퍼입니다.
+	// 업로드는 렌더링과 겹쳐 실행되며, 직접 큐는 리소스를 처음 사용하기 전에 티켓을 GPU에서 기다립니다(WaitOnQueue).
+	// 복사 큐에서 사용하는 리소스는 COMMON 상태여야 합니다. 버퍼는 복사 후 직접 큐에서 읽기 상태로 암시적으로 승격됩니다.
+	class CopyQueue
+	{
+	public:
+		// 업로드를 기록하는 함수입니다. 링 버퍼에서 받은 할당은 이 업로드의 티켓이 완료되면 회수됩니다.
+		typedef std::function<void(ID3D12GraphicsCommandList* commandList, UploadRingBuffer* uploadBuffer)> RecordFunction;
+
+		CopyQueue(ID3D12Device* device, UINT64 uploadBufferSize);
+		~CopyQueue();
+
+		// record로 복사 명령을 기록하여 제출하고 티켓을 반환합니다. CPU는 복사를 기다리지 않습니다.
+		// 여러 스레드에서 호출할 수 있으며, 링 버퍼 할당이 올바른 티켓으로 태그되도록 업로드는 한 번에 하나씩 기록됩니다.
+		UploadTicket Submit(const RecordFunction& record);
+
+		// queue가 이후에 실행하는 명령이 ticket의 복사 결과를 보도록 GPU에서 기다리게 합니다. CPU는 차단되지 않습니다.
+		void WaitOnQueue(ID3D12CommandQueue* queue, UploadTicket ticket) const;
+
+		bool IsComplete(UploadTicket ticket) const		{ return m_fence->GetCompletedValue() >= ticket; }
+
+		// ticket의 업로드가 완료될 때까지 CPU에서 기다립니다.
+		void Wait(UploadTicket ticket);
+
+		// 제출한 모든 업로드가 완료될 때까지 CPU에서 기다립니다.
+		void WaitForIdle();
+
+		ID3D12CommandQueue* GetCommandQueue() const		{ return m_commandQueue.Get(); }
+
+	private:
+		// 명령 할당기는 마지막으로 사용한 업로드의 티켓이 완료되면 재사용합니다.
+		struct Context
+		{
+			Microsoft::WRL::ComPtr<ID3D12CommandAllocator>		allocator;
+			Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList>	commandList;
+			UploadTicket										ticket;
+		};
+
+		Microsoft::WRL::ComPtr<ID3D12Device>		m_device;
+		Microsoft::WRL::ComPtr<ID3D12CommandQueue>	m_commandQueue;
+		Microsoft::WRL::ComPtr<ID3D12Fence>			m_fence;
+		HANDLE										m_fenceEvent;
+		std::unique_ptr<UploadRingBuffer>			m_uploadBuffer;
+
+		std::mutex									m_lock;
+		std::vector<Context>						m_contexts;
+		UploadTicket								m_lastTicket;
+	};
+}
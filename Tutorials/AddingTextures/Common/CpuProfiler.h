@@ -0,0 +1,306 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if defined(_M_IX86) || defined(_M_X64)
+#include <intrin.h>
+#define DX_CPU_PROFILER_USE_TSC
+#elif defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#define DX_CPU_PROFILER_USE_TSC
+#endif
+
+namespace DX
+{
+	// 끝난 CPU 구간 하나의 기록입니다. name은 문자열 리터럴처럼 프로그램이 끝날 때까지 유효해야 합니다.
+	struct CpuZoneEvent
+	{
+		const char*		name;
+		std::uint64_t	begin;		// CpuProfiler::ReadCounter() 값입니다.
+		std::uint64_t	end;
+	};
+
+	// 한 스레드가 기록하는 구간 링입니다. 기록은 소유 스레드만 하므로 잠금 없이 인덱스 하나만 게시합니다.
+	// 링이 가득 차면 가장 오래된 구간을 덮어씁니다.
+	class CpuZoneBuffer
+	{
+	public:
+		// 링의 용량입니다. 인덱스를 마스크로 계산할 수 있도록 2의 거듭제곱이어야 합니다.
+		static const std::uint32_t c_capacity = 16384;
+
+		CpuZoneBuffer(std::uint32_t threadId, const char* threadName) :
+			m_slots(new Slot[c_capacity]),
+			m_writeIndex(0),
+			m_threadId(threadId),
+			m_threadName(threadName != nullptr ? threadName : "")
+		{
+		}
+
+		void Record(const char* name, std::uint64_t begin, std::uint64_t end)
+		{
+			const std::uint64_t index = m_writeIndex.load(std::memory_order_relaxed);
+			Slot& slot = m_slots[index & (c_capacity - 1)];
+			slot.name.store(name, std::memory_order_relaxed);
+			slot.begin.store(begin, std::memory_order_relaxed);
+			slot.end.store(end, std::memory_order_relaxed);
+			m_writeIndex.store(index + 1, std::memory_order_release);
+		}
+
+		// 링에 남아 있는 구간을 오래된 것부터 destination 끝에 추가합니다.
+		// 복사하는 동안 기록기가 덮어썼을 수 있는 슬롯은 복사 후 인덱스를 다시 읽어 버립니다.
+		void Snapshot(std::vector<CpuZoneEvent>* destination) const
+		{
+			const std::uint64_t end = m_writeIndex.load(std::memory_order_acquire);
+			const std::uint64_t begin = end > c_capacity ? end - c_capacity : 0;
+
+			const std::size_t first = destination->size();
+			for (std::uint64_t i = begin; i < end; i++)
+			{
+				const Slot& slot = m_slots[i & (c_capacity - 1)];
+				CpuZoneEvent zone;
+				zone.name = slot.name.load(std::memory_order_relaxed);
+				zone.begin = slot.begin.load(std::memory_order_relaxed);
+				zone.end = slot.end.load(std::memory_order_relaxed);
+				destination->push_back(zone);
+			}
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			const std::uint64_t laterEnd = m_writeIndex.load(std::memory_order_relaxed);
+			const std::uint64_t overwritten = laterEnd > c_capacity ? laterEnd - c_capacity : 0;
+			if (overwritten > begin)
+			{
+				const std::size_t discard = static_cast<std::size_t>((std::min)(overwritten, end) - begin);
+				destination->erase(destination->begin() + first, destination->begin() + first + discard);
+			}
+		}
+
+		std::uint32_t GetThreadId() const				{ return m_threadId; }
+		const std::string& GetThreadName() const		{ return m_threadName; }
+		void SetThreadName(const char* name)			{ m_threadName = name; }
+
+	private:
+		// 내보내는 스레드가 덮어쓰는 중인 슬롯을 읽을 수 있으므로 필드는 원자적으로 접근합니다. x86에서는 일반 저장과 같습니다.
+		struct Slot
+		{
+			std::atomic<const char*>	name;
+			std::atomic<std::uint64_t>	begin;
+			std::atomic<std::uint64_t>	end;
+		};
+
+		std::unique_ptr<Slot[]>			m_slots;
+		std::atomic<std::uint64_t>		m_writeIndex;
+		std::uint32_t					m_threadId;
+		std::string						m_threadName;
+	};
+
+	// 스레드별 링에 CPU 구간을 기록하고 Chrome/Perfetto 추적 JSON으로 내보냅니다.
+	// 구간 기록의 비용은 카운터 두 번 읽기와 스레드 로컬 링에 쓰기 하나이며, 잠금은 스레드의 첫 구간에서만 사용합니다.
+	// 스레드가 끝나도 링은 내보낼 수 있도록 프로그램이 끝날 때까지 유지됩니다.
+	class CpuProfiler
+	{
+	public:
+		static CpuProfiler& Get()
+		{
+			static CpuProfiler profiler;
+			return profiler;
+		}
+
+		// 구간 시간을 재는 카운터입니다. x86/x64에서는 TSC(불변 TSC를 가정합니다)를, 그 밖에서는 steady_clock 나노초를 사용합니다.
+		// TSC 눈금은 내보낼 때 steady_clock으로 보정합니다.
+		static std::uint64_t ReadCounter()
+		{
+#if defined(DX_CPU_PROFILER_USE_TSC)
+			return __rdtsc();
+#else
+			return ReadNanoseconds();
+#endif
+		}
+
+		static std::uint64_t ReadNanoseconds()
+		{
+			return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+
+		// 비활성화하면 새 구간은 시계를 읽지 않고 기록되지 않습니다. 이미 기록한 구간은 유지됩니다.
+		void SetEnabled(bool enabled)					{ m_enabled.store(enabled, std::memory_order_relaxed); }
+		bool IsEnabled() const							{ return m_enabled.load(std::memory_order_relaxed); }
+
+		// 호출 스레드의 링이며, 처음 호출할 때 등록합니다.
+		CpuZoneBuffer* GetThreadBuffer()
+		{
+			static thread_local CpuZoneBuffer* buffer = nullptr;
+			if (buffer == nullptr)
+			{
+				buffer = RegisterThread(nullptr);
+			}
+			return buffer;
+		}
+
+		// 추적에 표시할 호출 스레드의 이름을 설정합니다.
+		void SetCurrentThreadName(const char* name)
+		{
+			CpuZoneBuffer* buffer = GetThreadBuffer();
+			std::lock_guard<std::mutex> lock(m_lock);
+			buffer->SetThreadName(name);
+		}
+
+		// 모든 스레드의 링에 남아 있는 구간을 Chrome 추적 이벤트 형식(JSON 개체 형식)으로 씁니다.
+		// 시간은 프로파일러가 만들어진 시점부터의 마이크로초입니다. 기록 중인 스레드를 멈추지 않습니다.
+		void ExportChromeTrace(std::ostream& stream) const
+		{
+			struct ThreadSnapshot
+			{
+				std::uint32_t	threadId;
+				std::string		threadName;
+			};
+
+			// 프로파일러를 만든 뒤 지난 시간으로 카운터 눈금당 마이크로초를 구합니다.
+			const std::uint64_t counterElapsed = ReadCounter() - m_counterOrigin;
+			const std::uint64_t nanosecondsElapsed = ReadNanoseconds() - m_nanosecondsOrigin;
+			const double microsecondsPerCount = counterElapsed != 0 ? nanosecondsElapsed / 1000.0 / counterElapsed : 0.0;
+
+			std::vector<ThreadSnapshot> threads;
+			std::vector<CpuZoneEvent> events;
+			std::vector<std::size_t> threadEnds;
+			{
+				std::lock_guard<std::mutex> lock(m_lock);
+				for (const auto& buffer : m_buffers)
+				{
+					ThreadSnapshot thread = { buffer->GetThreadId(), buffer->GetThreadName() };
+					threads.push_back(thread);
+					buffer->Snapshot(&events);
+					threadEnds.push_back(events.size());
+				}
+			}
+
+			stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+			bool first = true;
+			std::size_t eventIndex = 0;
+			for (std::size_t t = 0; t < threads.size(); t++)
+			{
+				const ThreadSnapshot& thread = threads[t];
+				if (!thread.threadName.empty())
+				{
+					stream << (first ? "\n" : ",\n");
+					stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.threadId << ",\"args\":{\"name\":";
+					WriteJsonString(stream, thread.threadName.c_str());
+					stream << "}}";
+					first = false;
+				}
+
+				for (; eventIndex < threadEnds[t]; eventIndex++)
+				{
+					const CpuZoneEvent& zone = events[eventIndex];
+					if (zone.begin < m_counterOrigin || zone.end < zone.begin)
+					{
+						continue;
+					}
+
+					char times[64];
+					std::snprintf(times, sizeof(times), "\"ts\":%.3f,\"dur\":%.3f", (zone.begin - m_counterOrigin) * microsecondsPerCount, (zone.end - zone.begin) * microsecondsPerCount);
+
+					stream << (first ? "\n" : ",\n");
+					stream << "{\"name\":";
+					WriteJsonString(stream, zone.name);
+					stream << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread.threadId << "," << times << "}";
+					first = false;
+				}
+			}
+			stream << "\n]}\n";
+		}
+
+	private:
+		CpuProfiler() :
+			m_enabled(true),
+			m_counterOrigin(ReadCounter()),
+			m_nanosecondsOrigin(ReadNanoseconds()),
+			m_nextThreadId(1)
+		{
+		}
+
+		CpuProfiler(const CpuProfiler&);
+		CpuProfiler& operator=(const CpuProfiler&);
+
+		CpuZoneBuffer* RegisterThread(const char* name)
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			m_buffers.push_back(std::unique_ptr<CpuZoneBuffer>(new CpuZoneBuffer(m_nextThreadId++, name)));
+			return m_buffers.back().get();
+		}
+
+		static void WriteJsonString(std::ostream& stream, const char* text)
+		{
+			stream << '"';
+			for (const char* c = text; *c != '\0'; c++)
+			{
+				const unsigned char ch = static_cast<unsigned char>(*c);
+				if (ch == '"' || ch == '\\')
+				{
+					stream << '\\' << *c;
+				}
+				else if (ch < 0x20)
+				{
+					char escaped[8];
+					std::snprintf(escaped, sizeof(escaped), "\\u%04x", ch);
+					stream << escaped;
+				}
+				else
+				{
+					stream << *c;
+				}
+			}
+			stream << '"';
+		}
+
+		std::atomic<bool>							m_enabled;
+		std::uint64_t								m_counterOrigin;
+		std::uint64_t								m_nanosecondsOrigin;
+		mutable std::mutex							m_lock;
+		std::vector<std::unique_ptr<CpuZoneBuffer>>	m_buffers;
+		std::uint32_t								m_nextThreadId;
+	};
+
+	// 범위가 끝날 때 호출 스레드의 링에 구간을 기록합니다. DX_CPU_ZONE 매크로로 사용합니다.
+	class CpuZone
+	{
+	public:
+		explicit CpuZone(const char* name) :
+			m_name(CpuProfiler::Get().IsEnabled() ? name : nullptr),
+			m_begin(m_name != nullptr ? CpuProfiler::ReadCounter() : 0)
+		{
+		}
+
+		~CpuZone()
+		{
+			if (m_name != nullptr)
+			{
+				CpuProfiler::Get().GetThreadBuffer()->Record(m_name, m_begin, CpuProfiler::ReadCounter());
+			}
+		}
+
+	private:
+		CpuZone(const CpuZone&);
+		CpuZone& operator=(const CpuZone&);
+
+		const char*		m_name;
+		std::uint64_t	m_begin;
+	};
+}
+
+// 현재 범위를 CPU 구간으로 기록합니다. DX_DISABLE_CPU_PROFILER를 정의하면 코드가 생성되지 않습니다.
+#define DX_CPU_ZONE_CONCAT_INNER(a, b) a##b
+#define DX_CPU_ZONE_CONCAT(a, b) DX_CPU_ZONE_CONCAT_INNER(a, b)
+#if defined(DX_DISABLE_CPU_PROFILER)
+#define DX_CPU_ZONE(name)
+#else
+#define DX_CPU_ZONE(name) ::DX::CpuZone DX_CPU_ZONE_CONCAT(cpuZone, __LINE__)(name)
+#endif
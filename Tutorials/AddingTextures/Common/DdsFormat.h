@@ -0,0 +1,523 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace DX
+{
+	// DDS 파일의 헤더 해석과 하위 리소스 배치입니다. 플랫폼 API에 의존하지 않으므로 헤드리스 빌드에서도 사용할 수 있습니다.
+	//
+	// 파일	: magic, DDS_HEADER, (fourCC가 'DX10'이면) DDS_HEADER_DXT10, 데이터
+	// 데이터	: 배열 항목마다 모든 밉 레벨을 차례로 저장하며, 각 레벨은 깊이 조각마다 빽빽한 행(블록 압축 형식은 블록 행)입니다.
+	//			  D3D12 하위 리소스 번호(mip + arrayIndex * mipLevels)와 같은 순서입니다.
+	// 모든 값은 little-endian입니다.
+	static const std::uint32_t c_ddsMagic = 0x20534444;	// 'DDS '
+	static const std::size_t c_ddsHeaderSize = 124;
+	static const std::size_t c_ddsHeaderDx10Size = 20;
+
+	static const std::uint32_t c_ddsFlagDepth = 0x800000;
+	static const std::uint32_t c_ddsPixelFormatAlphaPixels = 0x1;
+	static const std::uint32_t c_ddsPixelFormatAlpha = 0x2;
+	static const std::uint32_t c_ddsPixelFormatFourCC = 0x4;
+	static const std::uint32_t c_ddsPixelFormatRgb = 0x40;
+	static const std::uint32_t c_ddsPixelFormatLuminance = 0x20000;
+	static const std::uint32_t c_ddsCaps2CubeMap = 0x200;
+	static const std::uint32_t c_ddsCaps2CubeMapAllFaces = 0xFC00;
+	static const std::uint32_t c_ddsCaps2Volume = 0x200000;
+	static const std::uint32_t c_ddsResourceMiscTextureCube = 0x4;
+
+	// D3D12 리소스 한도입니다.
+	static const std::uint32_t c_ddsMaxTextureDimension = 16384;
+	static const std::uint32_t c_ddsMaxVolumeDimension = 2048;
+	static const std::uint32_t c_ddsMaxArraySize = 2048;
+
+	constexpr std::uint32_t MakeDdsFourCC(char a, char b, char c, char d)
+	{
+		return static_cast<std::uint32_t>(static_cast<std::uint8_t>(a)) | (static_cast<std::uint32_t>(static_cast<std::uint8_t>(b)) << 8) |
+			(static_cast<std::uint32_t>(static_cast<std::uint8_t>(c)) << 16) | (static_cast<std::uint32_t>(static_cast<std::uint8_t>(d)) << 24);
+	}
+
+	struct DdsPixelFormat
+	{
+		std::uint32_t	size;
+		std::uint32_t	flags;
+		std::uint32_t	fourCC;
+		std::uint32_t	rgbBitCount;
+		std::uint32_t	rBitMask;
+		std::uint32_t	gBitMask;
+		std::uint32_t	bBitMask;
+		std::uint32_t	aBitMask;
+	};
+
+	struct DdsHeader
+	{
+		std::uint32_t	size;
+		std::uint32_t	flags;
+		std::uint32_t	height;
+		std::uint32_t	width;
+		std::uint32_t	pitchOrLinearSize;
+		std::uint32_t	depth;
+		std::uint32_t	mipMapCount;
+		std::uint32_t	reserved1[11];
+		DdsPixelFormat	pixelFormat;
+		std::uint32_t	caps;
+		std::uint32_t	caps2;
+		std::uint32_t	caps3;
+		std::uint32_t	caps4;
+		std::uint32_t	reserved2;
+	};
+	static_assert(sizeof(DdsHeader) == c_ddsHeaderSize, "DdsHeader는 파일의 DDS_HEADER와 같은 배치여야 합니다.");
+
+	struct DdsHeaderDx10
+	{
+		std::uint32_t	dxgiFormat;
+		std::uint32_t	resourceDimension;	// D3D12_RESOURCE_DIMENSION 값입니다.
+		std::uint32_t	miscFlag;
+		std::uint32_t	arraySize;
+		std::uint32_t	miscFlags2;
+	};
+	static_assert(sizeof(DdsHeaderDx10) == c_ddsHeaderDx10Size, "DdsHeaderDx10은 파일의 DDS_HEADER_DXT10과 같은 배치여야 합니다.");
+
+	// 지원하는 DXGI_FORMAT 값입니다. dxgiformat.h 없이 사용할 수 있도록 숫자로 정의합니다.
+	enum DdsDxgiFormat : std::uint32_t
+	{
+		DdsFormatUnknown				= 0,
+		DdsFormatR32G32B32A32Float		= 2,
+		DdsFormatR16G16B16A16Float		= 10,
+		DdsFormatR16G16B16A16Unorm		= 11,
+		DdsFormatR32G32Float			= 16,
+		DdsFormatR10G10B10A2Unorm		= 24,
+		DdsFormatR11G11B10Float			= 26,
+		DdsFormatR8G8B8A8Unorm			= 28,
+		DdsFormatR8G8B8A8UnormSrgb		= 29,
+		DdsFormatR16G16Float			= 34,
+		DdsFormatR16G16Unorm			= 35,
+		DdsFormatR32Float				= 41,
+		DdsFormatR8G8Unorm				= 49,
+		DdsFormatR16Float				= 54,
+		DdsFormatR16Unorm				= 56,
+		DdsFormatR8Unorm				= 61,
+		DdsFormatA8Unorm				= 65,
+		DdsFormatBC1Unorm				= 71,
+		DdsFormatBC1UnormSrgb			= 72,
+		DdsFormatBC2Unorm				= 74,
+		DdsFormatBC2UnormSrgb			= 75,
+		DdsFormatBC3Unorm				= 77,
+		DdsFormatBC3UnormSrgb			= 78,
+		DdsFormatBC4Unorm				= 80,
+		DdsFormatBC4Snorm				= 81,
+		DdsFormatBC5Unorm				= 83,
+		DdsFormatBC5Snorm				= 84,
+		DdsFormatB5G6R5Unorm			= 85,
+		DdsFormatB5G5R5A1Unorm			= 86,
+		DdsFormatB8G8R8A8Unorm			= 87,
+		DdsFormatB8G8R8X8Unorm			= 88,
+		DdsFormatB8G8R8A8UnormSrgb		= 91,
+		DdsFormatB8G8R8X8UnormSrgb		= 93,
+		DdsFormatBC6HUf16				= 95,
+		DdsFormatBC6HSf16				= 96,
+		DdsFormatBC7Unorm				= 98,
+		DdsFormatBC7UnormSrgb			= 99,
+	};
+
+	enum class DdsDimension
+	{
+		Texture1D,
+		Texture2D,
+		Texture3D,
+	};
+
+	// 헤더에서 읽은 텍스처 설명입니다. 큐브 맵의 arraySize는 면 수(6의 배수)입니다.
+	struct DdsTextureDesc
+	{
+		DdsDimension	dimension;
+		std::uint32_t	format;			// DXGI_FORMAT 값입니다.
+		std::uint32_t	width;
+		std::uint32_t	height;
+		std::uint32_t	depth;
+		std::uint32_t	arraySize;
+		std::uint32_t	mipLevels;
+		bool			cubeMap;
+		std::uint32_t	bytesPerBlock;	// 블록 압축 형식이 아니면 픽셀당 바이트 수입니다.
+		std::uint32_t	blockDimension;	// 블록 압축 형식이면 4, 아니면 1입니다.
+		std::size_t		dataOffset;		// 파일 시작부터 첫 하위 리소스까지의 바이트 수입니다.
+		std::uint64_t	dataSize;		// 모든 하위 리소스의 바이트 수입니다.
+	};
+
+	// 파일 안의 하위 리소스 하나의 배치입니다. 행은 블록 압축 형식에서 블록 행입니다.
+	struct DdsSubresourceLayout
+	{
+		std::uint64_t	offset;			// 파일 시작 기준입니다.
+		std::uint32_t	width;			// 픽셀 단위입니다.
+		std::uint32_t	height;
+		std::uint32_t	depth;
+		std::uint32_t	rowSize;		// 빽빽한 행 하나의 바이트 수입니다.
+		std::uint32_t	rowCount;		// 깊이 조각 하나의 행 수입니다.
+	};
+
+	// 형식의 블록 크기입니다. 지원하지 않는 형식이면 false를 반환합니다.
+	inline bool GetDdsFormatBlockInfo(std::uint32_t format, std::uint32_t* bytesPerBlock, std::uint32_t* blockDimension)
+	{
+		*blockDimension = 1;
+		switch (format)
+		{
+		case DdsFormatR32G32B32A32Float:
+			*bytesPerBlock = 16;
+			return true;
+
+		case DdsFormatR16G16B16A16Float:
+		case DdsFormatR16G16B16A16Unorm:
+		case DdsFormatR32G32Float:
+			*bytesPerBlock = 8;
+			return true;
+
+		case DdsFormatR10G10B10A2Unorm:
+		case DdsFormatR11G11B10Float:
+		case DdsFormatR8G8B8A8Unorm:
+		case DdsFormatR8G8B8A8UnormSrgb:
+		case DdsFormatR16G16Float:
+		case DdsFormatR16G16Unorm:
+		case DdsFormatR32Float:
+		case DdsFormatB8G8R8A8Unorm:
+		case DdsFormatB8G8R8X8Unorm:
+		case DdsFormatB8G8R8A8UnormSrgb:
+		case DdsFormatB8G8R8X8UnormSrgb:
+			*bytesPerBlock = 4;
+			return true;
+
+		case DdsFormatR8G8Unorm:
+		case DdsFormatR16Float:
+		case DdsFormatR16Unorm:
+		case DdsFormatB5G6R5Unorm:
+		case DdsFormatB5G5R5A1Unorm:
+			*bytesPerBlock = 2;
+			return true;
+
+		case DdsFormatR8Unorm:
+		case DdsFormatA8Unorm:
+			*bytesPerBlock = 1;
+			return true;
+
+		case DdsFormatBC1Unorm:
+		case DdsFormatBC1UnormSrgb:
+		case DdsFormatBC4Unorm:
+		case DdsFormatBC4Snorm:
+			*bytesPerBlock = 8;
+			*blockDimension = 4;
+			return true;
+
+		case DdsFormatBC2Unorm:
+		case DdsFormatBC2UnormSrgb:
+		case DdsFormatBC3Unorm:
+		case DdsFormatBC3UnormSrgb:
+		case DdsFormatBC5Unorm:
+		case DdsFormatBC5Snorm:
+		case DdsFormatBC6HUf16:
+		case DdsFormatBC6HSf16:
+		case DdsFormatBC7Unorm:
+		case DdsFormatBC7UnormSrgb:
+			*bytesPerBlock = 16;
+			*blockDimension = 4;
+			return true;
+
+		default:
+			return false;
+		}
+	}
+
+	// DX10 확장 헤더가 없는 파일의 픽셀 형식을 DXGI 형식으로 바꿉니다. 대응하는 형식이 없으면(24비트 RGB 등) DdsFormatUnknown입니다.
+	inline std::uint32_t GetDdsLegacyFormat(const DdsPixelFormat& pixelFormat)
+	{
+		if ((pixelFormat.flags & c_ddsPixelFormatFourCC) != 0)
+		{
+			switch (pixelFormat.fourCC)
+			{
+			case MakeDdsFourCC('D', 'X', 'T', '1'):	return DdsFormatBC1Unorm;
+			case MakeDdsFourCC('D', 'X', 'T', '2'):
+			case MakeDdsFourCC('D', 'X', 'T', '3'):	return DdsFormatBC2Unorm;
+			case MakeDdsFourCC('D', 'X', 'T', '4'):
+			case MakeDdsFourCC('D', 'X', 'T', '5'):	return DdsFormatBC3Unorm;
+			case MakeDdsFourCC('A', 'T', 'I', '1'):
+			case MakeDdsFourCC('B', 'C', '4', 'U'):	return DdsFormatBC4Unorm;
+			case MakeDdsFourCC('B', 'C', '4', 'S'):	return DdsFormatBC4Snorm;
+			case MakeDdsFourCC('A', 'T', 'I', '2'):
+			case MakeDdsFourCC('B', 'C', '5', 'U'):	return DdsFormatBC5Unorm;
+			case MakeDdsFourCC('B', 'C', '5', 'S'):	return DdsFormatBC5Snorm;
+			case 36:								return DdsFormatR16G16B16A16Unorm;	// D3DFMT_A16B16G16R16
+			case 111:								return DdsFormatR16Float;			// D3DFMT_R16F
+			case 112:								return DdsFormatR16G16Float;		// D3DFMT_G16R16F
+			case 113:								return DdsFormatR16G16B16A16Float;	// D3DFMT_A16B16G16R16F
+			case 114:								return DdsFormatR32Float;			// D3DFMT_R32F
+			case 115:								return DdsFormatR32G32Float;		// D3DFMT_G32R32F
+			case 116:								return DdsFormatR32G32B32A32Float;	// D3DFMT_A32B32G32R32F
+			default:								return DdsFormatUnknown;
+			}
+		}
+
+		const DdsPixelFormat& f = pixelFormat;
+		if ((f.flags & c_ddsPixelFormatRgb) != 0)
+		{
+			switch (f.rgbBitCount)
+			{
+			case 32:
+				if (f.rBitMask == 0x000000ff && f.gBitMask == 0x0000ff00 && f.bBitMask == 0x00ff0000)
+				{
+					return DdsFormatR8G8B8A8Unorm;
+				}
+				if (f.rBitMask == 0x00ff0000 && f.gBitMask == 0x0000ff00 && f.bBitMask == 0x000000ff)
+				{
+					return f.aBitMask != 0 ? DdsFormatB8G8R8A8Unorm : DdsFormatB8G8R8X8Unorm;
+				}
+				if (f.rBitMask == 0x3ff00000 && f.gBitMask == 0x000ffc00 && f.bBitMask == 0x000003ff)
+				{
+					// D3DX가 마스크를 뒤집어 기록한 A2B10G10R10입니다.
+					return DdsFormatR10G10B10A2Unorm;
+				}
+				if (f.rBitMask == 0x000003ff && f.gBitMask == 0x000ffc00 && f.bBitMask == 0x3ff00000)
+				{
+					return DdsFormatR10G10B10A2Unorm;
+				}
+				if (f.rBitMask == 0x0000ffff && f.gBitMask == 0xffff0000 && f.bBitMask == 0)
+				{
+					return DdsFormatR16G16Unorm;
+				}
+				break;
+
+			case 16:
+				if (f.rBitMask == 0xf800 && f.gBitMask == 0x07e0 && f.bBitMask == 0x001f)
+				{
+					return DdsFormatB5G6R5Unorm;
+				}
+				if (f.rBitMask == 0x7c00 && f.gBitMask == 0x03e0 && f.bBitMask == 0x001f && f.aBitMask == 0x8000)
+				{
+					return DdsFormatB5G5R5A1Unorm;
+				}
+				break;
+			}
+		}
+		else if ((f.flags & c_ddsPixelFormatLuminance) != 0)
+		{
+			if (f.rgbBitCount == 8 && f.rBitMask == 0xff)
+			{
+				return DdsFormatR8Unorm;
+			}
+			if (f.rgbBitCount == 16 && f.rBitMask == 0xffff)
+			{
+				return DdsFormatR16Unorm;
+			}
+			if (f.rgbBitCount == 16 && f.rBitMask == 0x00ff && f.aBitMask == 0xff00)
+			{
+				return DdsFormatR8G8Unorm;
+			}
+		}
+		else if ((f.flags & (c_ddsPixelFormatAlphaPixels | c_ddsPixelFormatAlpha)) != 0)
+		{
+			if (f.rgbBitCount == 8)
+			{
+				return DdsFormatA8Unorm;
+			}
+		}
+		return DdsFormatUnknown;
+	}
+
+	// 밉 레벨 하나의 배치를 offset에서 시작하여 계산합니다. 블록 압축 형식은 크기를 블록 경계로 올립니다.
+	inline DdsSubresourceLayout GetDdsMipLayout(const DdsTextureDesc& desc, std::uint32_t mip, std::uint64_t offset)
+	{
+		DdsSubresourceLayout layout;
+		layout.offset = offset;
+		layout.width = (std::max)(desc.width >> mip, 1u);
+		layout.height = (std::max)(desc.height >> mip, 1u);
+		layout.depth = desc.dimension == DdsDimension::Texture3D ? (std::max)(desc.depth >> mip, 1u) : 1;
+		layout.rowSize = (layout.width + desc.blockDimension - 1) / desc.blockDimension * desc.bytesPerBlock;
+		layout.rowCount = (layout.height + desc.blockDimension - 1) / desc.blockDimension;
+		return layout;
+	}
+
+	inline std::uint64_t GetDdsLayoutSize(const DdsSubresourceLayout& layout)
+	{
+		return static_cast<std::uint64_t>(layout.rowSize) * layout.rowCount * layout.depth;
+	}
+
+	// 헤더를 해석하고 모든 하위 리소스가 파일 안에 있는지 검증합니다. 형식이 맞지 않거나 지원하지 않는 형식이면 false를 반환합니다.
+	// 파일 데이터를 복사하지 않으며 메모리를 할당하지 않습니다.
+	inline bool ParseDdsHeader(const std::uint8_t* data, std::size_t size, DdsTextureDesc* desc)
+	{
+		std::uint32_t magic;
+		DdsHeader header;
+		if (data == nullptr || size < sizeof(magic) + sizeof(header))
+		{
+			return false;
+		}
+		std::memcpy(&magic, data, sizeof(magic));
+		std::memcpy(&header, data + sizeof(magic), sizeof(header));
+		if (magic != c_ddsMagic || header.size != c_ddsHeaderSize || header.pixelFormat.size != sizeof(DdsPixelFormat))
+		{
+			return false;
+		}
+
+		DdsTextureDesc result = {};
+		result.width = header.width;
+		result.height = header.height;
+		result.depth = 1;
+		result.arraySize = 1;
+		result.mipLevels = (std::max)(header.mipMapCount, 1u);
+		result.dataOffset = sizeof(magic) + sizeof(header);
+
+		if ((header.pixelFormat.flags & c_ddsPixelFormatFourCC) != 0 && header.pixelFormat.fourCC == MakeDdsFourCC('D', 'X', '1', '0'))
+		{
+			DdsHeaderDx10 extension;
+			if (size < result.dataOffset + sizeof(extension))
+			{
+				return false;
+			}
+			std::memcpy(&extension, data + result.dataOffset, sizeof(extension));
+			result.dataOffset += sizeof(extension);
+
+			result.format = extension.dxgiFormat;
+			result.arraySize = extension.arraySize;
+			switch (extension.resourceDimension)
+			{
+			case 2:
+				result.dimension = DdsDimension::Texture1D;
+				result.height = 1;
+				break;
+
+			case 3:
+				result.dimension = DdsDimension::Texture2D;
+				if ((extension.miscFlag & c_ddsResourceMiscTextureCube) != 0)
+				{
+					result.cubeMap = true;
+					if (result.arraySize > c_ddsMaxArraySize / 6)
+					{
+						return false;
+					}
+					result.arraySize *= 6;
+				}
+				break;
+
+			case 4:
+				result.dimension = DdsDimension::Texture3D;
+				result.depth = header.depth;
+				if (result.arraySize != 1)
+				{
+					return false;
+				}
+				break;
+
+			default:
+				return false;
+			}
+		}
+		else
+		{
+			result.format = GetDdsLegacyFormat(header.pixelFormat);
+			if ((header.flags & c_ddsFlagDepth) != 0 || (header.caps2 & c_ddsCaps2Volume) != 0)
+			{
+				result.dimension = DdsDimension::Texture3D;
+				result.depth = header.depth;
+			}
+			else
+			{
+				result.dimension = DdsDimension::Texture2D;
+				if ((header.caps2 & c_ddsCaps2CubeMap) != 0)
+				{
+					// D3D10 이상은 일부 면만 있는 큐브 맵을 지원하지 않습니다.
+					if ((header.caps2 & c_ddsCaps2CubeMapAllFaces) != c_ddsCaps2CubeMapAllFaces)
+					{
+						return false;
+					}
+					result.cubeMap = true;
+					result.arraySize = 6;
+				}
+			}
+		}
+
+		if (!GetDdsFormatBlockInfo(result.format, &result.bytesPerBlock, &result.blockDimension))
+		{
+			return false;
+		}
+
+		// 크기와 밉 수를 D3D12 한도 안으로 제한합니다.
+		const std::uint32_t maxDimension = result.dimension == DdsDimension::Texture3D ? c_ddsMaxVolumeDimension : c_ddsMaxTextureDimension;
+		if (result.width == 0 || result.height == 0 || result.depth == 0 || result.arraySize == 0 ||
+			result.width > maxDimension || result.height > maxDimension || result.depth > maxDimension || result.arraySize > c_ddsMaxArraySize ||
+			(result.cubeMap && result.width != result.height))
+		{
+			return false;
+		}
+
+		std::uint32_t fullMipLevels = 1;
+		for (std::uint32_t extent = (std::max)((std::max)(result.width, result.height), result.depth); extent > 1; extent >>= 1)
+		{
+			fullMipLevels++;
+		}
+		if (result.mipLevels > fullMipLevels)
+		{
+			return false;
+		}
+
+		std::uint64_t dataSize = 0;
+		for (std::uint32_t mip = 0; mip < result.mipLevels; mip++)
+		{
+			dataSize += GetDdsLayoutSize(GetDdsMipLayout(result, mip, 0));
+		}
+		dataSize *= result.arraySize;
+		if (dataSize > size - result.dataOffset)
+		{
+			return false;
+		}
+		result.dataSize = dataSize;
+
+		*desc = result;
+		return true;
+	}
+
+	inline std::uint32_t GetDdsSubresourceCount(const DdsTextureDesc& desc)
+	{
+		return desc.mipLevels * desc.arraySize;
+	}
+
+	// D3D12 하위 리소스 번호(mip + arrayIndex * mipLevels)의 파일 안 배치입니다. 한 배열 항목의 크기는 밉 수에만 의존합니다.
+	inline DdsSubresourceLayout GetDdsSubresourceLayout(const DdsTextureDesc& desc, std::uint32_t subresource)
+	{
+		const std::uint32_t mip = subresource % desc.mipLevels;
+		const std::uint32_t arrayIndex = subresource / desc.mipLevels;
+
+		std::uint64_t itemSize = 0;
+		std::uint64_t mipOffset = 0;
+		for (std::uint32_t level = 0; level < desc.mipLevels; level++)
+		{
+			if (level == mip)
+			{
+				mipOffset = itemSize;
+			}
+			itemSize += GetDdsLayoutSize(GetDdsMipLayout(desc, level, 0));
+		}
+		return GetDdsMipLayout(desc, mip, desc.dataOffset + itemSize * arrayIndex + mipOffset);
+	}
+
+	// 하위 리소스의 firstRow 행이 시작하는 파일 안의 위치입니다. 행 번호는 깊이 조각을 이어 붙인 번호(slice * layout.rowCount + row)이며,
+	// 파일 안의 행은 layout.rowSize 간격으로 빽빽하게 놓여 있습니다.
+	inline const std::uint8_t* GetDdsRows(const std::uint8_t* file, const DdsSubresourceLayout& layout, std::uint32_t firstRow)
+	{
+		return file + layout.offset + static_cast<std::uint64_t>(layout.rowSize) * firstRow;
+	}
+
+	// 하위 리소스의 [firstRow, firstRow + rowCount) 행을 destination에 destinationRowPitch 간격으로 복사합니다.
+	inline void CopyDdsRows(const std::uint8_t* file, const DdsSubresourceLayout& layout, std::uint32_t firstRow, std::uint32_t rowCount, std::uint8_t* destination, std::size_t destinationRowPitch)
+	{
+		const std::uint8_t* source = GetDdsRows(file, layout, firstRow);
+		if (destinationRowPitch == layout.rowSize)
+		{
+			std::memcpy(destination, source, static_cast<std::size_t>(layout.rowSize) * rowCount);
+			return;
+		}
+
+		for (std::uint32_t row = 0; row < rowCount; row++)
+		{
+			std::memcpy(destination + destinationRowPitch * row, source + static_cast<std::size_t>(layout.rowSize) * row, layout.rowSize);
+		}
+	}
+}
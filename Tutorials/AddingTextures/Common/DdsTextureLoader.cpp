@@ -0,0 +1,229 @@
+﻿#include "pch.h"
+#include "DdsTextureLoader.h"
+#include "DirectXHelper.h"
+#include "SubresourceCopy.h"
+
+#if !defined(_WIN32)
+#include <stdexcept>
+#endif
+
+using namespace DX;
+using namespace Microsoft::WRL;
+
+namespace
+{
+	void ThrowInvalidData()
+	{
+#if defined(_WIN32)
+		DX::ThrowIfFailed(HRESULT_FROM_WIN32(ERROR_INVALID_DATA));
+#else
+		throw std::runtime_error("invalid DDS file");
+#endif
+	}
+
+	D3D12_RESOURCE_DESC GetResourceDesc(const DdsTextureDesc& dds)
+	{
+		D3D12_RESOURCE_DESC desc = {};
+		switch (dds.dimension)
+		{
+		case DdsDimension::Texture1D:	desc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE1D; break;
+		case DdsDimension::Texture2D:	desc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D; break;
+		default:						desc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE3D; break;
+		}
+		desc.Width = dds.width;
+		desc.Height = dds.height;
+		desc.DepthOrArraySize = static_cast<UINT16>(dds.dimension == DdsDimension::Texture3D ? dds.depth : dds.arraySize);
+		desc.MipLevels = static_cast<UINT16>(dds.mipLevels);
+		desc.Format = static_cast<DXGI_FORMAT>(dds.format);
+		desc.SampleDesc.Count = 1;
+		desc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+		desc.Flags = D3D12_RESOURCE_FLAG_NONE;
+		return desc;
+	}
+
+	D3D12_SHADER_RESOURCE_VIEW_DESC GetShaderResourceViewDesc(const DdsTextureDesc& dds)
+	{
+		D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+		srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+		srvDesc.Format = static_cast<DXGI_FORMAT>(dds.format);
+
+		if (dds.dimension == DdsDimension::Texture1D)
+		{
+			if (dds.arraySize > 1)
+			{
+				srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE1DARRAY;
+				srvDesc.Texture1DArray.MipLevels = dds.mipLevels;
+				srvDesc.Texture1DArray.ArraySize = dds.arraySize;
+			}
+			else
+			{
+				srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE1D;
+				srvDesc.Texture1D.MipLevels = dds.mipLevels;
+			}
+		}
+		else if (dds.dimension == DdsDimension::Texture3D)
+		{
+			srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE3D;
+			srvDesc.Texture3D.MipLevels = dds.mipLevels;
+		}
+		else if (dds.cubeMap)
+		{
+			if (dds.arraySize > 6)
+			{
+				srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURECUBEARRAY;
+				srvDesc.TextureCubeArray.MipLevels = dds.mipLevels;
+				srvDesc.TextureCubeArray.NumCubes = dds.arraySize / 6;
+			}
+			else
+			{
+				srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURECUBE;
+				srvDesc.TextureCube.MipLevels = dds.mipLevels;
+			}
+		}
+		else if (dds.arraySize > 1)
+		{
+			srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2DARRAY;
+			srvDesc.Texture2DArray.MipLevels = dds.mipLevels;
+			srvDesc.Texture2DArray.ArraySize = dds.arraySize;
+		}
+		else
+		{
+			srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+			srvDesc.Texture2D.MipLevels = dds.mipLevels;
+		}
+		return srvDesc;
+	}
+}
+
+UploadTicket DX::CreateDdsTexture(
+	ID3D12Device* device,
+	CopyQueue* copyQueue,
+	const AssetView& file,
+	ID3D12Resource** texture,
+	D3D12_SHADER_RESOURCE_VIEW_DESC* srvDesc)
+{
+	DdsTextureDesc dds;
+	if (!ParseDdsHeader(file.GetData(), file.GetSize(), &dds))
+	{
+		ThrowInvalidData();
+	}
+
+	const D3D12_RESOURCE_DESC desc = GetResourceDesc(dds);
+	ComPtr<ID3D12Resource> resource;
+	CD3DX12_HEAP_PROPERTIES defaultHeapProperties(D3D12_HEAP_TYPE_DEFAULT);
+	DX::ThrowIfFailed(device->CreateCommittedResource(
+		&defaultHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&desc,
+		D3D12_RESOURCE_STATE_COMMON,
+		nullptr,
+		IID_PPV_ARGS(&resource)));
+
+	// 파일의 행 배치가 장치의 복사 배치와 같은지 기록 전에 확인합니다. 기록 중에 예외가 발생하면 링 버퍼 할당이 태그 없이 남습니다.
+	const UINT subresourceCount = GetDdsSubresourceCount(dds);
+	for (UINT i = 0; i < subresourceCount; i++)
+	{
+		UINT numRows;
+		UINT64 rowSize;
+		device->GetCopyableFootprints(&desc, i, 1, 0, nullptr, &numRows, &rowSize, nullptr);
+
+		const DdsSubresourceLayout layout = GetDdsSubresourceLayout(dds, i);
+		if (numRows != layout.rowCount || rowSize != layout.rowSize)
+		{
+			ThrowInvalidData();
+		}
+	}
+
+	// 하위 리소스를 차례로 올리며, 현재 하위 리소스 안의 위치는 깊이 조각을 이어 붙인 행 번호입니다.
+	// 제출 하나는 링 버퍼의 절반까지만 할당하므로, 이전 제출의 공간이 회수되기를 기다리며 다음 구간을 기록할 수 있습니다.
+	// 도중의 제출이 실패하면 이전 제출이 아직 이 텍스처로 복사 중일 수 있으므로, 마지막 티켓을 기다린 뒤 텍스처를 해제합니다.
+	UINT subresource = 0;
+	UINT nextRow = 0;
+	UploadTicket ticket = 0;
+
+	try
+	{
+		while (subresource < subresourceCount)
+		{
+			ticket = copyQueue->Submit([&](ID3D12GraphicsCommandList* commandList, UploadRingBuffer* uploadBuffer)
+			{
+				const UINT64 budget = uploadBuffer->GetCapacity() / 2;
+				UINT64 used = 0;
+
+				while (subresource < subresourceCount)
+				{
+					D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint;
+					UINT numRows;
+					device->GetCopyableFootprints(&desc, subresource, 1, 0, &footprint, &numRows, nullptr, nullptr);
+					const DdsSubresourceLayout layout = GetDdsSubresourceLayout(dds, subresource);
+
+					// 구간은 깊이 조각을 넘지 않습니다. 한 행도 남은 예산에 들어가지 않으면 다음 제출로 넘깁니다.
+					const UINT64 rowPitch = footprint.Footprint.RowPitch;
+					const UINT slice = nextRow / numRows;
+					const UINT sliceRow = nextRow % numRows;
+					UINT rows = static_cast<UINT>((std::min)(static_cast<UINT64>(numRows - sliceRow), (budget - (std::min)(used, budget)) / rowPitch));
+					if (rows == 0)
+					{
+						if (used != 0)
+						{
+							break;
+						}
+						rows = 1;
+					}
+
+					const UINT64 uploadSize = rowPitch * rows;
+					UploadAllocation upload = uploadBuffer->Allocate(uploadSize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+					CopySubresource(
+						upload.cpuAddress, static_cast<std::size_t>(rowPitch), 0,
+						GetDdsRows(file.GetData(), layout, nextRow), layout.rowSize, 0,
+						layout.rowSize, rows, 1);
+
+					D3D12_TEXTURE_COPY_LOCATION source = {};
+					source.pResource = upload.resource;
+					source.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+					source.PlacedFootprint.Offset = upload.offset;
+					source.PlacedFootprint.Footprint = footprint.Footprint;
+					source.PlacedFootprint.Footprint.Height = rows * dds.blockDimension;
+					source.PlacedFootprint.Footprint.Depth = 1;
+
+					D3D12_TEXTURE_COPY_LOCATION destination = {};
+					destination.pResource = resource.Get();
+					destination.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+					destination.SubresourceIndex = subresource;
+
+					commandList->CopyTextureRegion(&destination, 0, sliceRow * dds.blockDimension, slice, &source, nullptr);
+
+					used += uploadSize + D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT;
+					nextRow += rows;
+					if (nextRow == numRows * layout.depth)
+					{
+						nextRow = 0;
+						subresource++;
+					}
+				}
+			});
+		}
+	}
+	catch (...)
+	{
+		if (ticket != 0)
+		{
+			try
+			{
+				copyQueue->Wait(ticket);
+			}
+			catch (...)
+			{
+			}
+		}
+		throw;
+	}
+
+	if (srvDesc != nullptr)
+	{
+		*srvDesc = GetShaderResourceViewDesc(dds);
+	}
+
+	*texture = resource.Detach();
+	return ticket;
+}
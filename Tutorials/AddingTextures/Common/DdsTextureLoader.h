@@ -0,0 +1,21 @@
+﻿#pragma once
+
+#include "AssetPack.h"
+#include "CopyQueue.h"
+#include "DdsFormat.h"
+
+namespace DX
+{
+	// DDS 파일(DX10 헤더, 밉, 배열, 큐브 맵, 볼륨, 블록 압축 형식)로 텍스처를 만들고 복사 큐로 올립니다.
+	// 행은 파일 매핑(AssetView)에서 GetCopyableFootprints 배치의 업로드 링 버퍼로 바로 복사하므로 중간 사본이나 힙 할당이 없습니다.
+	// 링 버퍼보다 큰 텍스처는 행 구간으로 나누어 여러 번 제출하며, 반환한 티켓이 완료되면 모든 하위 리소스가 복사된 것입니다.
+	// 텍스처는 COMMON 상태로 만들어지고, 직접 큐에서 티켓을 기다린 뒤 처음 읽을 때 셰이더 리소스 상태로 암시적으로 승격됩니다.
+	// srvDesc가 있으면 전체 텍스처의 SRV 설명을 채웁니다. 형식이 맞지 않거나 지원하지 않는 파일은 ERROR_INVALID_DATA 예외를 발생시킵니다.
+	// 제출 도중 예외가 발생하면 이미 제출한 복사가 끝나기를 CPU에서 기다린 뒤 텍스처를 해제하고 예외를 다시 던집니다.
+	UploadTicket CreateDdsTexture(
+		ID3D12Device* device,
+		CopyQueue* copyQueue,
+		const AssetView& file,
+		ID3D12Resource** texture,
+		D3D12_SHADER_RESOURCE_VIEW_DESC* srvDesc = nullptr);
+}
@@ -0,0 +1,79 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <utility>
+
+namespace DX
+{
+	// GPU가 아직 사용 중일 수 있는 개체의 해제를 fence 값까지 미룹니다. D3D 개체에 의존하지 않으므로 GPU 없이 검증할 수 있습니다.
+	// 항목은 해제 함수이며, ComPtr는 함수에 참조를 넘겨 두고 함수가 실행될 때 Release합니다.
+	// 설명자 반환처럼 개체가 아닌 리소스도 같은 방식으로 미룰 수 있습니다. 여러 스레드에서 호출할 수 있습니다.
+	class DeferredReleaseQueue
+	{
+	public:
+		DeferredReleaseQueue() {}
+
+		// 남은 항목은 모두 해제합니다. 소유자는 그 전에 GPU를 기다려야 합니다.
+		~DeferredReleaseQueue()
+		{
+			ReleaseAll();
+		}
+
+		// fence가 fenceValue를 넘으면 release를 실행합니다.
+		// 큐는 fence 값 순서로 처리되므로, 이전 항목보다 작은 값은 이전 항목의 값으로 올려서 보수적으로 처리합니다.
+		void Enqueue(std::uint64_t fenceValue, std::function<void()> release)
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			if (!m_entries.empty())
+			{
+				fenceValue = (std::max)(fenceValue, m_entries.back().first);
+			}
+			m_entries.emplace_back(fenceValue, std::move(release));
+		}
+
+		// completedValue까지 완료된 항목을 해제하고 해제한 수를 반환합니다.
+		// 해제 함수는 잠금 밖에서 실행되므로 해제 중에 다시 Enqueue해도 됩니다.
+		std::size_t Release(std::uint64_t completedValue)
+		{
+			std::deque<std::pair<std::uint64_t, std::function<void()>>> completed;
+			{
+				std::lock_guard<std::mutex> lock(m_lock);
+				while (!m_entries.empty() && m_entries.front().first <= completedValue)
+				{
+					completed.push_back(std::move(m_entries.front()));
+					m_entries.pop_front();
+				}
+			}
+
+			for (auto& entry : completed)
+			{
+				entry.second();
+			}
+			return completed.size();
+		}
+
+		// 모든 항목을 해제합니다. GPU가 유휴 상태일 때만 호출해야 합니다.
+		std::size_t ReleaseAll()
+		{
+			return Release((std::numeric_limits<std::uint64_t>::max)());
+		}
+
+		std::size_t GetPendingCount() const
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			return m_entries.size();
+		}
+
+	private:
+		DeferredReleaseQueue(const DeferredReleaseQueue&);
+		DeferredReleaseQueue& operator=(const DeferredReleaseQueue&);
+
+		mutable std::mutex											m_lock;
+		std::deque<std::pair<std::uint64_t, std::function<void()>>>	m_entries;
+	};
+}
@@ -0,0 +1,98 @@
+﻿#include "pch.h"
+#include "DescriptorHeapAllocator.h"
+#include "DirectXHelper.h"
+
+using namespace DX;
+
+// StagingDescriptorHeap
+
+StagingDescriptorHeap::StagingDescriptorHeap(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE type, UINT descriptorsPerPage) :
+	m_device(device),
+	m_type(type),
+	m_descriptorsPerPage(descriptorsPerPage),
+	m_descriptorSize(device->GetDescriptorHandleIncrementSize(type))
+{
+}
+
+StagingDescriptor StagingDescriptorHeap::Allocate()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	StagingDescriptor descriptor;
+	for (UINT n = 0; n < static_cast<UINT>(m_pages.size()); n++)
+	{
+		if (m_pages[n]->freeList.Allocate(&descriptor.index))
+		{
+			descriptor.page = n;
+			descriptor.cpuHandle = CD3DX12_CPU_DESCRIPTOR_HANDLE(m_pages[n]->start, descriptor.index, m_descriptorSize);
+			return descriptor;
+		}
+	}
+
+	// 모든 페이지가 가득 찼으므로 새 페이지를 추가합니다.
+	std::unique_ptr<Page> page(new Page(m_descriptorsPerPage));
+
+	D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+	heapDesc.NumDescriptors = m_descriptorsPerPage;
+	heapDesc.Type = m_type;
+	heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+	DX::ThrowIfFailed(m_device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&page->heap)));
+	DX::SetName(page->heap.Get(), L"StagingDescriptorHeap");
+	page->start = page->heap->GetCPUDescriptorHandleForHeapStart();
+
+	page->freeList.Allocate(&descriptor.index);
+	descriptor.page = static_cast<UINT>(m_pages.size());
+	descriptor.cpuHandle = CD3DX12_CPU_DESCRIPTOR_HANDLE(page->start, descriptor.index, m_descriptorSize);
+
+	m_pages.push_back(std::move(page));
+	return descriptor;
+}
+
+void StagingDescriptorHeap::Free(const StagingDescriptor& descriptor)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_pages[descriptor.page]->freeList.Free(descriptor.index);
+}
+
+// ShaderVisibleDescriptorHeap
+
+ShaderVisibleDescriptorHeap::ShaderVisibleDescriptorHeap(ID3D12Device* device, UINT frameCount, UINT descriptorsPerFrame) :
+	m_device(device),
+	m_descriptorSize(device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV)),
+	m_ring(frameCount, descriptorsPerFrame)
+{
+	D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+	heapDesc.NumDescriptors = m_ring.GetCapacity();
+	heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+	// 이 플래그는 이 설명자 힙을 파이프라인에 바인딩할 수 있고 그 안에 들어 있는 설명자는 루트 테이블이 참조할 수 있음을 나타냅니다.
+	heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+	DX::ThrowIfFailed(device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&m_heap)));
+
+	NAME_D3D12_OBJECT(m_heap);
+
+	m_cpuStart = m_heap->GetCPUDescriptorHandleForHeapStart();
+	m_gpuStart = m_heap->GetGPUDescriptorHandleForHeapStart();
+}
+
+DescriptorTable ShaderVisibleDescriptorHeap::Allocate(UINT count)
+{
+	UINT firstIndex;
+	if (!m_ring.Allocate(count, &firstIndex))
+	{
+		DX::ThrowIfFailed(E_OUTOFMEMORY);
+	}
+
+	DescriptorTable table;
+	table.cpuHandle = CD3DX12_CPU_DESCRIPTOR_HANDLE(m_cpuStart, firstIndex, m_descriptorSize);
+	table.gpuHandle = CD3DX12_GPU_DESCRIPTOR_HANDLE(m_gpuStart, firstIndex, m_descriptorSize);
+	return table;
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE ShaderVisibleDescriptorHeap::CopyTable(const D3D12_CPU_DESCRIPTOR_HANDLE* sources, UINT count)
+{
+	DescriptorTable table = Allocate(count);
+
+	// 원본 범위 크기를 생략하면 각 원본은 설명자 하나짜리 범위입니다.
+	m_device->CopyDescriptors(1, &table.cpuHandle, &count, count, sources, nullptr, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	return table.gpuHandle;
+}
@@ -0,0 +1,84 @@
+﻿#pragma once
+
+#include <memory>
+#include <mutex>
+#include "DescriptorIndexAllocator.h"
+
+namespace DX
+{
+	// CPU 전용 스테이징 힙의 설명자 하나입니다. Free에 그대로 반환합니다.
+	struct StagingDescriptor
+	{
+		D3D12_CPU_DESCRIPTOR_HANDLE	cpuHandle;
+		UINT						page;
+		UINT						index;
+	};
+
+	// 형식별 CPU 전용 설명자 힙입니다. 뷰는 여기에서 한 번 만들고, 그리기 전에 셰이더 표시 힙으로 복사합니다.
+	// 페이지가 가득 차면 새 페이지를 추가하므로 힙을 다시 만들거나 슬롯이 부족해지지 않습니다.
+	class StagingDescriptorHeap
+	{
+	public:
+		StagingDescriptorHeap(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE type, UINT descriptorsPerPage = 256);
+
+		StagingDescriptor Allocate();
+		void Free(const StagingDescriptor& descriptor);
+
+		D3D12_DESCRIPTOR_HEAP_TYPE GetType() const	{ return m_type; }
+		UINT GetDescriptorSize() const				{ return m_descriptorSize; }
+
+	private:
+		struct Page
+		{
+			explicit Page(UINT capacity) : freeList(capacity) {}
+
+			Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>	heap;
+			D3D12_CPU_DESCRIPTOR_HANDLE						start;
+			DescriptorFreeList								freeList;
+		};
+
+		Microsoft::WRL::ComPtr<ID3D12Device>	m_device;
+		D3D12_DESCRIPTOR_HEAP_TYPE				m_type;
+		UINT									m_descriptorsPerPage;
+		UINT									m_descriptorSize;
+
+		std::mutex								m_lock;
+		std::vector<std::unique_ptr<Page>>		m_pages;
+	};
+
+	// 셰이더 표시 힙에 할당된 설명자 테이블입니다.
+	struct DescriptorTable
+	{
+		D3D12_CPU_DESCRIPTOR_HANDLE	cpuHandle;
+		D3D12_GPU_DESCRIPTOR_HANDLE	gpuHandle;
+	};
+
+	// 하나의 큰 CBV/SRV/UAV 셰이더 표시 힙을 프레임별 링으로 나눕니다.
+	// 테이블은 스테이징 설명자를 CopyDescriptors 한 번으로 복사하여 채우며, 프레임의 fence가 완료되면 BeginFrame에서 재사용됩니다.
+	class ShaderVisibleDescriptorHeap
+	{
+	public:
+		ShaderVisibleDescriptorHeap(ID3D12Device* device, UINT frameCount, UINT descriptorsPerFrame);
+
+		// frameIndex의 링 구간을 재설정합니다. 그 프레임의 GPU 작업이 완료된 뒤에만 호출해야 합니다.
+		void BeginFrame(UINT frameIndex)					{ m_ring.BeginFrame(frameIndex); }
+
+		// 현재 프레임 구간에서 연속된 count개의 설명자를 할당합니다. 구간이 가득 차면 E_OUTOFMEMORY 예외가 발생합니다.
+		DescriptorTable Allocate(UINT count);
+
+		// 스테이징 설명자들을 새 테이블로 복사하고 루트 테이블에 바인딩할 GPU 핸들을 반환합니다.
+		D3D12_GPU_DESCRIPTOR_HANDLE CopyTable(const D3D12_CPU_DESCRIPTOR_HANDLE* sources, UINT count);
+
+		ID3D12DescriptorHeap* GetHeap() const				{ return m_heap.Get(); }
+		UINT GetDescriptorSize() const						{ return m_descriptorSize; }
+		UINT GetUsedCount() const							{ return m_ring.GetUsedCount(); }
+
+	private:
+		Microsoft::WRL::ComPtr<ID3D12Device>			m_device;
+		Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>	m_heap;
+		D3D12_CPU_DESCRIPTOR_HANDLE						m_cpuStart;
+		D3D12_GPU_DESCRIPTOR_HANDLE						m_gpuStart;
+		UINT											m_descriptorSize;
+		DescriptorFrameRing								m_ring;
+	};
+}
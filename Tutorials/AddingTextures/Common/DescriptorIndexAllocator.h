@@ -0,0 +1,98 @@
+﻿#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace DX
+{
+	// 설명자 힙 슬롯의 장부 관리입니다. D3D 개체에 의존하지 않으므로 GPU 없이 검증할 수 있습니다.
+
+	// 고정 용량 슬롯의 자유 목록입니다. 개별 슬롯을 임의 순서로 할당하고 반환하는 CPU 전용 스테이징 힙에 사용합니다.
+	class DescriptorFreeList
+	{
+	public:
+		explicit DescriptorFreeList(std::uint32_t capacity) :
+			m_capacity(capacity)
+		{
+			// 낮은 인덱스부터 할당되도록 역순으로 쌓습니다.
+			m_free.reserve(capacity);
+			for (std::uint32_t i = capacity; i-- > 0;)
+			{
+				m_free.push_back(i);
+			}
+		}
+
+		bool Allocate(std::uint32_t* index)
+		{
+			if (m_free.empty())
+			{
+				return false;
+			}
+
+			*index = m_free.back();
+			m_free.pop_back();
+			return true;
+		}
+
+		void Free(std::uint32_t index)
+		{
+			m_free.push_back(index);
+		}
+
+		std::uint32_t GetCapacity() const	{ return m_capacity; }
+		std::uint32_t GetFreeCount() const	{ return static_cast<std::uint32_t>(m_free.size()); }
+
+	private:
+		std::uint32_t				m_capacity;
+		std::vector<std::uint32_t>	m_free;
+	};
+
+	// 프레임마다 하나의 구간을 갖는 선형 할당기입니다. 셰이더 표시 힙에서 프레임별 설명자 테이블에 사용합니다.
+	// 구간은 해당 프레임의 fence가 완료된 뒤 BeginFrame에서 재설정되며, 할당은 여러 스레드에서 할 수 있습니다.
+	class DescriptorFrameRing
+	{
+	public:
+		DescriptorFrameRing(std::uint32_t frameCount, std::uint32_t descriptorsPerFrame) :
+			m_frameCount(frameCount),
+			m_descriptorsPerFrame(descriptorsPerFrame),
+			m_frameStart(0),
+			m_used(0)
+		{
+		}
+
+		// frameIndex의 구간을 비우고 현재 구간으로 만듭니다.
+		void BeginFrame(std::uint32_t frameIndex)
+		{
+			m_frameStart = m_descriptorsPerFrame * (frameIndex % m_frameCount);
+			m_used.store(0, std::memory_order_relaxed);
+		}
+
+		// 현재 구간에서 연속된 count개의 슬롯을 할당하고 첫 슬롯의 힙 인덱스를 반환합니다.
+		bool Allocate(std::uint32_t count, std::uint32_t* firstIndex)
+		{
+			const std::uint32_t offset = m_used.fetch_add(count, std::memory_order_relaxed);
+			if (count == 0 || offset + count > m_descriptorsPerFrame || offset + count < offset)
+			{
+				return false;
+			}
+
+			*firstIndex = m_frameStart + offset;
+			return true;
+		}
+
+		std::uint32_t GetCapacity() const				{ return m_frameCount * m_descriptorsPerFrame; }
+		std::uint32_t GetDescriptorsPerFrame() const	{ return m_descriptorsPerFrame; }
+		std::uint32_t GetUsedCount() const
+		{
+			const std::uint32_t used = m_used.load(std::memory_order_relaxed);
+			return used < m_descriptorsPerFrame ? used : m_descriptorsPerFrame;
+		}
+
+	private:
+		std::uint32_t				m_frameCount;
+		std::uint32_t				m_descriptorsPerFrame;
+		std::uint32_t				m_frameStart;
+		std::atomic<std::uint32_t>	m_used;
+	};
+}
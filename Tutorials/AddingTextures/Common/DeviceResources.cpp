@@ -1,6 +1,7 @@
 ﻿#include "pch.h"
 #include "DeviceResources.h"
 #include "DirectXHelper.h"
+#include "CpuProfiler.h"
 
 using namespace DirectX;
 using namespace Microsoft::WRL;
@@ -64,14 +65,11 @@ namespace ScreenRotation
 };
 
 // DeviceResources의 생성자입니다.
-DX::DeviceResources::DeviceResources(DXGI_FORMAT backBufferFormat, DXGI_FORMAT depthBufferFormat) :
-	m_currentFrame(0),
+DX::DeviceResources::DeviceResources(DXGI_FORMAT backBufferFormat, DXGI_FORMAT depthBufferFormat, UINT frameCount) :
+	m_backBufferIndex(0),
 	m_screenViewport(),
-	m_rtvDescriptorSize(0),
-	m_fenceEvent(0),
 	m_backBufferFormat(backBufferFormat),
 	m_depthBufferFormat(depthBufferFormat),
-	m_fenceValues{},
 	m_d3dRenderTargetSize(),
 	m_outputSize(),
 	m_logicalSize(),
@@ -82,7 +80,23 @@ DX::DeviceResources::DeviceResources(DXGI_FORMAT backBufferFormat, DXGI_FORMAT d
 	m_deviceRemoved(false)
 {
 	CreateDeviceIndependentResources();
-	CreateDeviceResources();
+	CreateDeviceResources(frameCount);
+}
+
+// 장치 리소스와 해제를 미룬 개체를 해제하기 전에 직접 큐의 작업이 끝나기를 기다립니다.
+// 장치가 제거되었으면 fence가 완료되지 않을 수 있으므로 기다리지 않습니다. 소멸자에서는 예외를 던지지 않습니다.
+DX::DeviceResources::~DeviceResources()
+{
+	if (m_frameResources != nullptr && !m_deviceRemoved && SUCCEEDED(m_d3dDevice->GetDeviceRemovedReason()))
+	{
+		try
+		{
+			WaitForGpu();
+		}
+		catch (...)
+		{
+		}
+	}
 }
 
 // Direct3D 장치에 종속되지 않은 리소스를 구성합니다.
@@ -91,7 +105,7 @@ void DX::DeviceResources::CreateDeviceIndependentResources()
 }
 
 // Direct3D 장치를 구성하고 해당 장치에 대한 핸들 및 장치 컨텍스트를 저장합니다.
-void DX::DeviceResources::CreateDeviceResources()
+void DX::DeviceResources::CreateDeviceResources(UINT frameCount)
 {
 #if defined(_DEBUG)
 	// 프로젝트가 디버그 빌드 중인 경우 SDK 레이어를 통한 디버깅이 가능하도록 설정하세요.
@@ -140,35 +154,42 @@ void DX::DeviceResources::CreateDeviceResources()
 	DX::ThrowIfFailed(m_d3dDevice->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&m_commandQueue)));
 	NAME_D3D12_OBJECT(m_commandQueue);
 
-	// 렌더링 대상 뷰와 깊이 스텐실 뷰에 대한 설명자 힙을 만듭니다.
-	D3D12_DESCRIPTOR_HEAP_DESC rtvHeapDesc = {};
-	rtvHeapDesc.NumDescriptors = c_frameCount;
-	rtvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
-	rtvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
-	DX::ThrowIfFailed(m_d3dDevice->CreateDescriptorHeap(&rtvHeapDesc, IID_PPV_ARGS(&m_rtvHeap)));
-	NAME_D3D12_OBJECT(m_rtvHeap);
+	// 로드 중인 콘텐츠가 렌더링을 멈추지 않도록 업로드는 별도의 복사 큐에서 실행합니다.
+	m_copyQueue = std::unique_ptr<CopyQueue>(new CopyQueue(m_d3dDevice.Get(), c_copyQueueUploadBufferSize));
 
-	m_rtvDescriptorSize = m_d3dDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
+	// 설명자 힙을 만듭니다. 스테이징 힙은 필요할 때 페이지를 추가하므로 미리 크기를 정하지 않습니다.
+	m_rtvStagingHeap = std::unique_ptr<StagingDescriptorHeap>(new StagingDescriptorHeap(m_d3dDevice.Get(), D3D12_DESCRIPTOR_HEAP_TYPE_RTV, 16));
+	m_dsvStagingHeap = std::unique_ptr<StagingDescriptorHeap>(new StagingDescriptorHeap(m_d3dDevice.Get(), D3D12_DESCRIPTOR_HEAP_TYPE_DSV, 16));
+	m_cbvSrvUavStagingHeap = std::unique_ptr<StagingDescriptorHeap>(new StagingDescriptorHeap(m_d3dDevice.Get(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV));
 
-	D3D12_DESCRIPTOR_HEAP_DESC dsvHeapDesc = {};
-	dsvHeapDesc.NumDescriptors = 1;
-	dsvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_DSV;
-	dsvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
-	ThrowIfFailed(m_d3dDevice->CreateDescriptorHeap(&dsvHeapDesc, IID_PPV_ARGS(&m_dsvHeap)));
-	NAME_D3D12_OBJECT(m_dsvHeap);
+	// 깊이 스텐실 뷰의 슬롯은 창 크기가 바뀌어도 재사용합니다. 렌더링 대상 뷰의 슬롯은 백 버퍼 수에 맞춰 할당합니다.
+	m_depthStencilView = m_dsvStagingHeap->Allocate();
 
-	for (UINT n = 0; n < c_frameCount; n++)
+	// 동기화 개체와 진행 중인 프레임 수에 따라 크기가 정해지는 리소스를 만듭니다.
+	m_frameResources = std::unique_ptr<FrameResources>(new FrameResources(m_d3dDevice.Get(), m_commandQueue.Get(), frameCount));
+
+	// 파이프라인 캐시 파일은 앱의 로컬 폴더에 둡니다.
+	std::wstring pipelineCachePath(Windows::Storage::ApplicationData::Current->LocalFolder->Path->Data());
+	pipelineCachePath += L"\\PipelineCache.bin";
+	m_pipelineStateCache = std::unique_ptr<PipelineStateCache>(new PipelineStateCache(m_d3dDevice.Get(), pipelineCachePath));
+}
+
+// 진행 중인 프레임 수를 바꿉니다.
+void DX::DeviceResources::SetFrameCount(UINT frameCount)
+{
+	if ((std::max)(1u, (std::min)(frameCount, c_maxFrameCount)) == GetFrameCount())
 	{
-		DX::ThrowIfFailed(
-			m_d3dDevice->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&m_commandAllocators[n]))
-			);
+		return;
 	}
 
-	// 동기화 개체를 만듭니다.
-	DX::ThrowIfFailed(m_d3dDevice->CreateFence(m_fenceValues[m_currentFrame], D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_fence)));
-	m_fenceValues[m_currentFrame]++;
+	// GPU를 기다린 뒤 프레임별 리소스를 다시 만듭니다.
+	m_frameResources->SetFrameCount(frameCount);
 
-	m_fenceEvent = CreateEventEx(nullptr, FALSE, FALSE, EVENT_ALL_ACCESS);
+	// 스왑 체인 버퍼 수도 프레임 수를 따르므로 스왑 체인이 있으면 다시 만듭니다.
+	if (m_swapChain != nullptr)
+	{
+		CreateWindowSizeDependentResources();
+	}
 }
 
 // 창 크기가 변경될 때마다 이러한 리소스를 다시 만들어야 합니다.
@@ -177,12 +198,10 @@ void DX::DeviceResources::CreateWindowSizeDependentResources()
 	// 모든 이전 GPU 작업이 완료될 때까지 기다립니다.
 	WaitForGpu();
 
-	// 이전 창 크기 관련 콘텐츠를 지우고 추적된 fence 값을 업데이트합니다.
-	for (UINT n = 0; n < c_frameCount; n++)
-	{
-		m_renderTargets[n] = nullptr;
-		m_fenceValues[n] = m_fenceValues[m_currentFrame];
-	}
+	// 이전 창 크기 관련 콘텐츠를 지웁니다. GPU가 유휴 상태이므로 첫 프레임 슬롯부터 다시 시작합니다.
+	// 그 슬롯의 상수 영역, 설명자 구간과 명령 할당기는 비어 있습니다.
+	m_renderTargets.clear();
+	m_frameResources->ResetFrames();
 
 	UpdateRenderTargetSize();
 
@@ -201,7 +220,7 @@ void DX::DeviceResources::CreateWindowSizeDependentResources()
 	if (m_swapChain != nullptr)
 	{
 		// 스왑 체인이 이미 존재할 경우 크기를 조정합니다.
-		HRESULT hr = m_swapChain->ResizeBuffers(c_frameCount, backBufferWidth, backBufferHeight, m_backBufferFormat, 0);
+		HRESULT hr = m_swapChain->ResizeBuffers(GetBackBufferCount(), backBufferWidth, backBufferHeight, m_backBufferFormat, 0);
 
 		if (hr == DXGI_ERROR_DEVICE_REMOVED || hr == DXGI_ERROR_DEVICE_RESET)
 		{
@@ -229,7 +248,7 @@ void DX::DeviceResources::CreateWindowSizeDependentResources()
 		swapChainDesc.SampleDesc.Count = 1;							// 다중 샘플링을 사용하지 않습니다.
 		swapChainDesc.SampleDesc.Quality = 0;
 		swapChainDesc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
-		swapChainDesc.BufferCount = c_frameCount;					// 3중 버퍼링을 사용하여 대기 시간을 최소화합니다.
+		swapChainDesc.BufferCount = GetBackBufferCount();			// 진행 중인 프레임 수에 맞춥니다.
 		swapChainDesc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD;	// 모든 Windows 유니버설 앱은 _FLIP_ SwapEffects를 사용해야 합니다.
 		swapChainDesc.Flags = 0;
 		swapChainDesc.Scaling = scaling;
@@ -281,13 +300,25 @@ void DX::DeviceResources::CreateWindowSizeDependentResources()
 
 	// 스왑 체인 백 버퍼의 렌더링 대상 뷰를 만듭니다.
 	{
-		m_currentFrame = m_swapChain->GetCurrentBackBufferIndex();
-		CD3DX12_CPU_DESCRIPTOR_HANDLE rtvDescriptor(m_rtvHeap->GetCPUDescriptorHandleForHeapStart());
-		for (UINT n = 0; n < c_frameCount; n++)
+		m_backBufferIndex = m_swapChain->GetCurrentBackBufferIndex();
+
+		// 렌더링 대상 뷰 슬롯을 백 버퍼 수에 맞춥니다.
+		const UINT backBufferCount = GetBackBufferCount();
+		while (m_renderTargetViews.size() < backBufferCount)
+		{
+			m_renderTargetViews.push_back(m_rtvStagingHeap->Allocate());
+		}
+		while (m_renderTargetViews.size() > backBufferCount)
+		{
+			m_rtvStagingHeap->Free(m_renderTargetViews.back());
+			m_renderTargetViews.pop_back();
+		}
+
+		m_renderTargets.resize(backBufferCount);
+		for (UINT n = 0; n < backBufferCount; n++)
 		{
 			DX::ThrowIfFailed(m_swapChain->GetBuffer(n, IID_PPV_ARGS(&m_renderTargets[n])));
-			m_d3dDevice->CreateRenderTargetView(m_renderTargets[n].Get(), nullptr, rtvDescriptor);
-			rtvDescriptor.Offset(m_rtvDescriptorSize);
+			m_d3dDevice->CreateRenderTargetView(m_renderTargets[n].Get(), nullptr, m_renderTargetViews[n].cpuHandle);
 
 			WCHAR name[25];
 			if (swprintf_s(name, L"m_renderTargets[%u]", n) > 0)
@@ -322,7 +353,7 @@ void DX::DeviceResources::CreateWindowSizeDependentResources()
 		dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
 		dsvDesc.Flags = D3D12_DSV_FLAG_NONE;
 
-		m_d3dDevice->CreateDepthStencilView(m_depthStencil.Get(), &dsvDesc, m_dsvHeap->GetCPUDescriptorHandleForHeapStart());
+		m_d3dDevice->CreateDepthStencilView(m_depthStencil.Get(), &dsvDesc, m_depthStencilView.cpuHandle);
 	}
 
 	// 전체 창을 대상으로 하기 위한 3D 렌더링 뷰포트를 설정합니다.
@@ -451,6 +482,8 @@ void DX::DeviceResources::ValidateDevice()
 // 스왑 체인의 콘텐츠를 화면에 표시합니다.
 void DX::DeviceResources::Present()
 {
+	DX_CPU_ZONE("DeviceResources::Present");
+
 	// 첫 번째 인수는 DXGI에 VSync까지 차단하도록 지시하여 응용 프로그램이
 	// 다음 VSync까지 대기하도록 합니다. 이를 통해 화면에 표시되지 않는 프레임을
 	// 렌더링하는 주기를 낭비하지 않을 수 있습니다.
@@ -473,36 +506,18 @@ void DX::DeviceResources::Present()
 // 일시 중단 중인 GPU 작업이 완료될 때까지 기다립니다.
 void DX::DeviceResources::WaitForGpu()
 {
-	// 큐에서 신호 명령을 예약합니다.
-	DX::ThrowIfFailed(m_commandQueue->Signal(m_fence.Get(), m_fenceValues[m_currentFrame]));
-
-	// fence를 넘을 때까지 기다립니다.
-	DX::ThrowIfFailed(m_fence->SetEventOnCompletion(m_fenceValues[m_currentFrame], m_fenceEvent));
-	WaitForSingleObjectEx(m_fenceEvent, INFINITE, FALSE);
-
-	// 현재 프레임에 대한 fence 값을 구현합니다.
-	m_fenceValues[m_currentFrame]++;
+	m_frameResources->WaitForGpu();
 }
 
 // 다음 프레임을 렌더링하도록 준비합니다.
 void DX::DeviceResources::MoveToNextFrame()
 {
-	// 큐에서 신호 명령을 예약합니다.
-	const UINT64 currentFenceValue = m_fenceValues[m_currentFrame];
-	DX::ThrowIfFailed(m_commandQueue->Signal(m_fence.Get(), currentFenceValue));
-
-	//프레임 인덱스로 이동합니다.
-	m_currentFrame = m_swapChain->GetCurrentBackBufferIndex();
-
-	// 다음 프레임을 시작할 준비가 되었는지 확인하세요.
-	if (m_fence->GetCompletedValue() < m_fenceValues[m_currentFrame])
-	{
-		DX::ThrowIfFailed(m_fence->SetEventOnCompletion(m_fenceValues[m_currentFrame], m_fenceEvent));
-		WaitForSingleObjectEx(m_fenceEvent, INFINITE, FALSE);
-	}
+	DX_CPU_ZONE("DeviceResources::MoveToNextFrame");
 
-	// 다음 프레임에 대한 fence 값을 설정합니다.
-	m_fenceValues[m_currentFrame] = currentFenceValue + 1;
+	// 프레임 fence를 신호하고 다음 프레임 슬롯을 마지막으로 사용한 GPU 작업을 기다립니다.
+	// 프레임 수가 1이면 백 버퍼는 2개이므로 백 버퍼 인덱스는 따로 추적합니다.
+	m_frameResources->MoveToNextFrame();
+	m_backBufferIndex = m_swapChain->GetCurrentBackBufferIndex();
 }
 
 // 이 메서드는 디스플레이 장치의 기본 방향과 현재 디스플레이 방향 간의 회전을
@@ -1,14 +1,19 @@
 ﻿#pragma once
 
+#include "CopyQueue.h"
+#include "FrameResources.h"
+#include "PipelineStateCache.h"
+
 namespace DX
 {
-	static const UINT c_frameCount = 3;		// 3중 버퍼링을 사용합니다.
+	static const UINT64 c_copyQueueUploadBufferSize = 8 * 1024 * 1024;	// 복사 큐 업로드 링 버퍼의 크기입니다.
 
 	// 모든 DirectX 장치 리소스를 제어합니다.
 	class DeviceResources
 	{
 	public:
-		DeviceResources(DXGI_FORMAT backBufferFormat = DXGI_FORMAT_B8G8R8A8_UNORM, DXGI_FORMAT depthBufferFormat = DXGI_FORMAT_D32_FLOAT);
+		DeviceResources(DXGI_FORMAT backBufferFormat = DXGI_FORMAT_B8G8R8A8_UNORM, DXGI_FORMAT depthBufferFormat = DXGI_FORMAT_D32_FLOAT, UINT frameCount = c_defaultFrameCount);
+		~DeviceResources();
 		void SetWindow(Windows::UI::Core::CoreWindow^ window);
 		void SetLogicalSize(Windows::Foundation::Size logicalSize);
 		void SetCurrentOrientation(Windows::Graphics::Display::DisplayOrientations currentOrientation);
@@ -17,6 +22,26 @@ namespace DX
 		void Present();
 		void WaitForGpu();
 
+		// 진행 중인 프레임 수(1~c_maxFrameCount)를 바꿉니다. GPU를 기다린 뒤 프레임별 리소스와 스왑 체인 버퍼를 다시 만듭니다.
+		// 작은 값은 입력 지연을 줄이고, 큰 값은 CPU와 GPU가 더 많이 겹쳐 처리량을 높입니다.
+		void SetFrameCount(UINT frameCount);
+		UINT GetFrameCount() const			{ return m_frameResources->GetFrameCount(); }
+
+		// 직접 큐에 지금까지 제출한 작업이 끝난 뒤 개체를 해제합니다. object는 즉시 비워집니다.
+		// 리소스, 힙, 파이프라인 상태처럼 GPU가 아직 참조할 수 있는 개체를 교체하거나 버릴 때 사용합니다.
+		// 제출과 같은 렌더링 스레드에서 호출해야 합니다.
+		template<typename T>
+		void DeferRelease(Microsoft::WRL::ComPtr<T>& object)
+		{
+			m_frameResources->DeferRelease(object);
+		}
+
+		// 설명자 구간 반환처럼 개체가 아닌 리소스의 해제를 같은 방식으로 미룹니다.
+		void DeferRelease(std::function<void()> release)
+		{
+			m_frameResources->DeferRelease(std::move(release));
+		}
+
 		// 렌더링 대상의 크기(픽셀)입니다.
 		Windows::Foundation::Size	GetOutputSize() const				{ return m_outputSize; }
 
@@ -29,57 +54,70 @@ namespace DX
 		// D3D 접근자입니다.
 		ID3D12Device*				GetD3DDevice() const				{ return m_d3dDevice.Get(); }
 		IDXGISwapChain3*			GetSwapChain() const				{ return m_swapChain.Get(); }
-		ID3D12Resource*				GetRenderTarget() const				{ return m_renderTargets[m_currentFrame].Get(); }
+		ID3D12Resource*				GetRenderTarget() const				{ return m_renderTargets[m_backBufferIndex].Get(); }
 		ID3D12Resource*				GetDepthStencil() const				{ return m_depthStencil.Get(); }
 		ID3D12CommandQueue*			GetCommandQueue() const				{ return m_commandQueue.Get(); }
-		ID3D12CommandAllocator*		GetCommandAllocator() const			{ return m_commandAllocators[m_currentFrame].Get(); }
+		CopyQueue*					GetCopyQueue() const				{ return m_copyQueue.get(); }
+		CommandListPool*			GetCommandListPool() const			{ return m_frameResources->GetCommandListPool(); }
 		DXGI_FORMAT					GetBackBufferFormat() const			{ return m_backBufferFormat; }
 		DXGI_FORMAT					GetDepthBufferFormat() const		{ return m_depthBufferFormat; }
 		D3D12_VIEWPORT				GetScreenViewport() const			{ return m_screenViewport; }
 		DirectX::XMFLOAT4X4			GetOrientationTransform3D() const	{ return m_orientationTransform3D; }
-		UINT						GetCurrentFrameIndex() const		{ return m_currentFrame; }
-		ID3D12DescriptorHeap*		GetRtvHeap() const					{ return m_rtvHeap.Get(); }
+		UINT						GetCurrentFrameIndex() const		{ return m_frameResources->GetCurrentFrameIndex(); }
+		StagingDescriptorHeap*		GetCbvSrvUavStagingHeap() const		{ return m_cbvSrvUavStagingHeap.get(); }
+		ShaderVisibleDescriptorHeap*	GetShaderVisibleDescriptorHeap() const	{ return m_frameResources->GetShaderVisibleDescriptorHeap(); }
+		LinearConstantAllocator*	GetConstantAllocator() const		{ return m_frameResources->GetConstantAllocator(); }
+		LinearConstantAllocator*	GetInstanceAllocator() const		{ return m_frameResources->GetInstanceAllocator(); }
+		PipelineStateCache*			GetPipelineStateCache() const		{ return m_pipelineStateCache.get(); }
+		GpuProfiler*				GetGpuProfiler() const				{ return m_frameResources->GetGpuProfiler(); }
+		FrameResources*				GetFrameResources() const			{ return m_frameResources.get(); }
 
 		CD3DX12_CPU_DESCRIPTOR_HANDLE GetRenderTargetView() const
 		{
-			return CD3DX12_CPU_DESCRIPTOR_HANDLE(m_rtvHeap->GetCPUDescriptorHandleForHeapStart(), m_currentFrame, m_rtvDescriptorSize);
+			return CD3DX12_CPU_DESCRIPTOR_HANDLE(m_renderTargetViews[m_backBufferIndex].cpuHandle);
 		}
 		CD3DX12_CPU_DESCRIPTOR_HANDLE GetDepthStencilView() const
 		{
-			return CD3DX12_CPU_DESCRIPTOR_HANDLE(m_dsvHeap->GetCPUDescriptorHandleForHeapStart());
+			return CD3DX12_CPU_DESCRIPTOR_HANDLE(m_depthStencilView.cpuHandle);
 		}
 
 	private:
 		void CreateDeviceIndependentResources();
-		void CreateDeviceResources();
+		void CreateDeviceResources(UINT frameCount);
 		void CreateWindowSizeDependentResources();
+		UINT GetBackBufferCount() const		{ return (std::max)(GetFrameCount(), 2u); }	// 대칭 이동 모델 스왑 체인에는 버퍼가 2개 이상 필요합니다.
 		void UpdateRenderTargetSize();
 		void MoveToNextFrame();
 		DXGI_MODE_ROTATION ComputeDisplayRotation();
 		void GetHardwareAdapter(IDXGIAdapter1** ppAdapter);
 
-		UINT											m_currentFrame;
+		UINT											m_backBufferIndex;
 
 		// Direct3D 개체입니다.
 		Microsoft::WRL::ComPtr<ID3D12Device>			m_d3dDevice;
 		Microsoft::WRL::ComPtr<IDXGIFactory4>			m_dxgiFactory;
 		Microsoft::WRL::ComPtr<IDXGISwapChain3>			m_swapChain;
-		Microsoft::WRL::ComPtr<ID3D12Resource>			m_renderTargets[c_frameCount];
+		std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>>	m_renderTargets;
 		Microsoft::WRL::ComPtr<ID3D12Resource>			m_depthStencil;
-		Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>	m_rtvHeap;
-		Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>	m_dsvHeap;
 		Microsoft::WRL::ComPtr<ID3D12CommandQueue>		m_commandQueue;
-		Microsoft::WRL::ComPtr<ID3D12CommandAllocator>	m_commandAllocators[c_frameCount];
+		std::unique_ptr<CopyQueue>						m_copyQueue;
 		DXGI_FORMAT										m_backBufferFormat;
 		DXGI_FORMAT										m_depthBufferFormat;
 		D3D12_VIEWPORT									m_screenViewport;
-		UINT											m_rtvDescriptorSize;
 		bool											m_deviceRemoved;
 
-		// CPU/GPU 동기화.
-		Microsoft::WRL::ComPtr<ID3D12Fence>				m_fence;
-		UINT64											m_fenceValues[c_frameCount];
-		HANDLE											m_fenceEvent;
+		// 설명자 힙입니다. 뷰는 형식별 스테이징 힙에 만들고, 셰이더 테이블은 FrameResources의 셰이더 표시 링에 복사합니다.
+		std::unique_ptr<StagingDescriptorHeap>			m_rtvStagingHeap;
+		std::unique_ptr<StagingDescriptorHeap>			m_dsvStagingHeap;
+		std::unique_ptr<StagingDescriptorHeap>			m_cbvSrvUavStagingHeap;
+		std::vector<StagingDescriptor>					m_renderTargetViews;
+		StagingDescriptor								m_depthStencilView;
+
+		// 프레임 fence, 해제 지연 큐와 프레임별 할당기입니다. 장치보다 먼저 소멸되도록 장치 개체 뒤에 선언합니다.
+		std::unique_ptr<FrameResources>					m_frameResources;
+
+		// 실행 간에 유지되는 파이프라인 상태 캐시입니다.
+		std::unique_ptr<PipelineStateCache>				m_pipelineStateCache;
 
 		// 창에 대한 캐시된 참조입니다.
 		Platform::Agile<Windows::UI::Core::CoreWindow>	m_window;
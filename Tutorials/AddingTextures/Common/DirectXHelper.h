@@ -1,9 +1,18 @@
 ﻿#pragma once
 
+#include <cmath>
+#include "AssetPack.h"
+
+#if defined(__cplusplus_winrt)
 #include <ppltasks.h>	// create_task의 경우
+#else
+#include <cstdio>
+#include <stdexcept>
+#endif
 
 namespace DX
 {
+#if defined(__cplusplus_winrt)
 	inline void ThrowIfFailed(HRESULT hr)
 	{
 		if (FAILED(hr))
@@ -12,26 +21,104 @@ namespace DX
 			throw Platform::Exception::CreateException(hr);
 		}
 	}
+#else
+	// C++/CX가 없는 빌드(헤드리스 검사 프로그램)에서 ThrowIfFailed가 던지는 예외입니다.
+	class HResultException : public std::runtime_error
+	{
+	public:
+		explicit HResultException(HRESULT hr) : std::runtime_error(Format(hr)), m_result(hr) {}
+		HRESULT GetResult() const	{ return m_result; }
 
-	// 이진 파일에서 비동기적으로 읽는 함수입니다.
-	inline Concurrency::task<std::vector<byte>> ReadDataAsync(const std::wstring& filename)
+	private:
+		static std::string Format(HRESULT hr)
+		{
+			char message[32];
+			std::snprintf(message, sizeof(message), "HRESULT 0x%08X", static_cast<unsigned int>(hr));
+			return message;
+		}
+
+		HRESULT m_result;
+	};
+
+	inline void ThrowIfFailed(HRESULT hr)
 	{
-		using namespace Windows::Storage;
-		using namespace Concurrency;
+		if (FAILED(hr))
+		{
+			throw HResultException(hr);
+		}
+	}
+#endif
 
-		auto folder = Windows::ApplicationModel::Package::Current->InstalledLocation;
+	// fence 대기에 쓰는 이벤트를 만듭니다. Win32 이벤트가 없는 플랫폼에서는 nullptr이며,
+	// 이때 SetEventOnCompletion은 값에 도달할 때까지 호출 스레드를 차단합니다.
+	inline HANDLE CreateFenceEvent()
+	{
+#if defined(_WIN32)
+		return CreateEventEx(nullptr, FALSE, FALSE, EVENT_ALL_ACCESS);
+#else
+		return nullptr;
+#endif
+	}
 
-		return create_task(folder->GetFileAsync(Platform::StringReference(filename.c_str()))).then([](StorageFile^ file)
+	inline void CloseFenceEvent(HANDLE fenceEvent)
+	{
+#if defined(_WIN32)
+		if (fenceEvent != 0)
 		{
-			return FileIO::ReadBufferAsync(file);
-		}).then([](Streams::IBuffer^ fileBuffer) -> std::vector<byte>
+			CloseHandle(fenceEvent);
+		}
+#else
+		(void)fenceEvent;
+#endif
+	}
+
+	// fence가 value에 도달할 때까지 CPU를 기다리게 합니다. fenceEvent는 CreateFenceEvent로 만든 것이어야 합니다.
+	inline void WaitForFence(ID3D12Fence* fence, UINT64 value, HANDLE fenceEvent)
+	{
+		DX::ThrowIfFailed(fence->SetEventOnCompletion(value, fenceEvent));
+#if defined(_WIN32)
+		WaitForSingleObjectEx(fenceEvent, INFINITE, FALSE);
+#endif
+	}
+
+#if defined(__cplusplus_winrt)
+	// 패키지 설치 폴더 안의 파일 경로를 반환합니다.
+	inline std::wstring GetPackagePath(const std::wstring& filename)
+	{
+		std::wstring path(Windows::ApplicationModel::Package::Current->InstalledLocation->Path->Data());
+		path += L"\\";
+		path += filename;
+		return path;
+	}
+
+	// 패키지의 이진 파일을 백그라운드 스레드에서 비동기적으로 메모리 매핑하는 함수입니다.
+	// 반환된 보기는 복사 없이 사용할 수 있으며, 마지막 참조가 해제될 때 매핑이 해제됩니다.
+	inline Concurrency::task<std::shared_ptr<const MappedFile>> MapDataAsync(const std::wstring& filename)
+	{
+		const std::wstring path = GetPackagePath(filename);
+
+		return Concurrency::create_task([path]()
+		{
+			return MappedFile::Open(path);
+		});
+	}
+
+	// 패키지의 에셋 팩을 백그라운드 스레드에서 매핑하는 함수입니다. 팩이 패키지에 없으면 nullptr을 반환합니다.
+	inline Concurrency::task<std::shared_ptr<const AssetPack>> OpenAssetPackAsync(const std::wstring& filename)
+	{
+		const std::wstring path = GetPackagePath(filename);
+
+		return Concurrency::create_task([path]()
 		{
-			std::vector<byte> returnBuffer;
-			returnBuffer.resize(fileBuffer->Length);
-			Streams::DataReader::FromBuffer(fileBuffer)->ReadBytes(Platform::ArrayReference<byte>(returnBuffer.data(), fileBuffer->Length));
-			return returnBuffer;
+			WIN32_FILE_ATTRIBUTE_DATA attributes;
+			if (!GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &attributes))
+			{
+				return std::shared_ptr<const AssetPack>();
+			}
+			return AssetPack::Open(path);
 		});
 	}
+#endif
 
 	// DIP(장치 독립적 픽셀) 길이를 물리적 픽셀 길이로 변환합니다.
 	inline float ConvertDipsToPixels(float dips, float dpi)
@@ -55,4 +142,4 @@ namespace DX
 
 // ComPtr<T>에 대한 명명 도우미 함수입니다.
 // 변수의 이름을 개체의 이름으로 할당합니다.
-#define NAME_D3D12_OBJECT(x) DX::SetName(x.Get(), L#x)
+#define NAME_D3D12_OBJECT(x) DX::SetName(x.Get(), L"" #x)
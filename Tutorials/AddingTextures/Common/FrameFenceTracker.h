@@ -0,0 +1,55 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace DX
+{
+	// 진행 중인 프레임 수와 프레임별 fence 값을 추적합니다. D3D 개체에 의존하지 않으므로 GPU 없이 검증할 수 있습니다.
+	// fence 값은 하나의 단조 증가 카운터에서 나오며, 각 프레임 슬롯은 마지막으로 신호한 값을 기억합니다.
+	// 슬롯을 다시 사용하기 전에 그 값이 완료되었는지 기다리면 GPU는 CPU보다 최대 frameCount 프레임만큼 뒤처집니다.
+	class FrameFenceTracker
+	{
+	public:
+		explicit FrameFenceTracker(unsigned int frameCount, std::uint64_t initialFenceValue = 0) :
+			m_frameFenceValues(frameCount, initialFenceValue),
+			m_currentFrame(0),
+			m_nextFenceValue(initialFenceValue + 1)
+		{
+		}
+
+		// 현재 프레임 끝에서 큐에 신호할 값을 반환하고 현재 프레임 슬롯에 기록합니다.
+		std::uint64_t Signal()
+		{
+			const std::uint64_t value = m_nextFenceValue++;
+			m_frameFenceValues[m_currentFrame] = value;
+			return value;
+		}
+
+		// 다음 프레임 슬롯으로 이동하고, 그 슬롯을 다시 사용하기 전에 완료되어야 하는 fence 값을 반환합니다.
+		std::uint64_t MoveToNextFrame()
+		{
+			m_currentFrame = (m_currentFrame + 1) % GetFrameCount();
+			return m_frameFenceValues[m_currentFrame];
+		}
+
+		// 프레임 수를 바꿉니다. 신호한 모든 값이 완료된 뒤(GPU 유휴 상태)에만 호출해야 합니다.
+		void SetFrameCount(unsigned int frameCount)
+		{
+			m_frameFenceValues.assign(frameCount, m_nextFenceValue - 1);
+			m_currentFrame = 0;
+		}
+
+		unsigned int GetFrameCount() const				{ return static_cast<unsigned int>(m_frameFenceValues.size()); }
+		unsigned int GetCurrentFrame() const			{ return m_currentFrame; }
+		std::uint64_t GetLastSignaledValue() const		{ return m_nextFenceValue - 1; }
+
+		// 다음 Signal이 반환할 값입니다. 지금까지 제출한 작업은 이 값이 완료되면 모두 끝납니다.
+		std::uint64_t GetNextSignalValue() const		{ return m_nextFenceValue; }
+
+	private:
+		std::vector<std::uint64_t>	m_frameFenceValues;
+		unsigned int				m_currentFrame;
+		std::uint64_t				m_nextFenceValue;
+	};
+}
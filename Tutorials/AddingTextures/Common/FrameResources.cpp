@@ -0,0 +1,112 @@
+﻿#include "pch.h"
+#include "FrameResources.h"
+#include "DirectXHelper.h"
+#include "CpuProfiler.h"
+
+using namespace DX;
+
+FrameResources::FrameResources(ID3D12Device* device, ID3D12CommandQueue* commandQueue, UINT frameCount) :
+	m_device(device),
+	m_commandQueue(commandQueue),
+	m_frameCount((std::max)(1u, (std::min)(frameCount, c_maxFrameCount))),
+	m_frameFences(m_frameCount),
+	m_fenceEvent(0)
+{
+	DX::ThrowIfFailed(device->CreateFence(m_frameFences.GetLastSignaledValue(), D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_fence)));
+	NAME_D3D12_OBJECT(m_fence);
+
+	m_fenceEvent = DX::CreateFenceEvent();
+
+	CreatePerFrameResources();
+}
+
+FrameResources::~FrameResources()
+{
+	DX::CloseFenceEvent(m_fenceEvent);
+}
+
+// 상수 버퍼와 인스턴스 버퍼 영역, 셰이더 표시 설명자 링과 명령 할당기처럼 진행 중인 프레임마다 하나씩 필요한 리소스를 만듭니다.
+// GPU가 유휴 상태일 때만 호출해야 합니다.
+void FrameResources::CreatePerFrameResources()
+{
+	ID3D12Device* device = m_device.Get();
+	m_shaderVisibleHeap = std::unique_ptr<ShaderVisibleDescriptorHeap>(new ShaderVisibleDescriptorHeap(device, m_frameCount, c_shaderVisibleDescriptorsPerFrame));
+
+	// 명령 할당기와 목록은 기록하는 스레드 수에 따라 풀에서 필요할 때 만듭니다.
+	m_commandListPool = std::unique_ptr<CommandListPool>(new CommandListPool(device, D3D12_COMMAND_LIST_TYPE_DIRECT, m_frameCount));
+
+	m_constantAllocator = std::unique_ptr<LinearConstantAllocator>(new LinearConstantAllocator(device, m_frameCount, c_constantBufferSizePerFrame));
+	m_instanceAllocator = std::unique_ptr<LinearConstantAllocator>(new LinearConstantAllocator(device, m_frameCount, c_instanceBufferSizePerFrame));
+
+	m_gpuProfiler = std::unique_ptr<GpuProfiler>(new GpuProfiler(device, m_commandQueue.Get(), m_frameCount, c_gpuProfilerScopesPerFrame));
+
+	ResetFrames();
+}
+
+// 현재 프레임 슬롯의 상수·인스턴스 영역, 설명자 구간과 명령 할당기를 재설정하고 GPU 타이밍 결과를 읽습니다. 그 슬롯의 fence가 완료된 뒤에만 호출해야 합니다.
+void FrameResources::BeginFrame()
+{
+	const UINT frameIndex = m_frameFences.GetCurrentFrame();
+	m_constantAllocator->BeginFrame(frameIndex);
+	m_instanceAllocator->BeginFrame(frameIndex);
+	m_shaderVisibleHeap->BeginFrame(frameIndex);
+	m_commandListPool->BeginFrame(frameIndex);
+	m_gpuProfiler->BeginFrame(frameIndex);
+}
+
+void FrameResources::ResetFrames()
+{
+	m_frameFences.SetFrameCount(m_frameCount);
+	BeginFrame();
+}
+
+void FrameResources::SetFrameCount(UINT frameCount)
+{
+	frameCount = (std::max)(1u, (std::min)(frameCount, c_maxFrameCount));
+	if (frameCount == m_frameCount)
+	{
+		return;
+	}
+
+	// 프레임별 리소스를 다시 만들기 전에 모든 프레임의 GPU 작업이 완료될 때까지 기다립니다.
+	WaitForGpu();
+
+	m_frameCount = frameCount;
+	CreatePerFrameResources();
+}
+
+// 일시 중단 중인 GPU 작업이 완료될 때까지 기다립니다.
+void FrameResources::WaitForGpu()
+{
+	DX_CPU_ZONE("FrameResources::WaitForGpu");
+
+	// 큐에서 신호 명령을 예약합니다.
+	const UINT64 fenceValue = m_frameFences.Signal();
+	DX::ThrowIfFailed(m_commandQueue->Signal(m_fence.Get(), fenceValue));
+
+	// fence를 넘을 때까지 기다립니다.
+	DX::WaitForFence(m_fence.Get(), fenceValue, m_fenceEvent);
+	m_deferredReleases.Release(fenceValue);
+}
+
+// 다음 프레임을 렌더링하도록 준비합니다.
+void FrameResources::MoveToNextFrame()
+{
+	DX_CPU_ZONE("FrameResources::MoveToNextFrame");
+
+	// 큐에서 신호 명령을 예약합니다.
+	const UINT64 currentFenceValue = m_frameFences.Signal();
+	DX::ThrowIfFailed(m_commandQueue->Signal(m_fence.Get(), currentFenceValue));
+
+	// 다음 프레임 슬롯을 마지막으로 사용한 GPU 작업이 끝났는지 확인하세요.
+	const UINT64 frameFenceValue = m_frameFences.MoveToNextFrame();
+	if (m_fence->GetCompletedValue() < frameFenceValue)
+	{
+		DX_CPU_ZONE("Wait for frame fence");
+		DX::WaitForFence(m_fence.Get(), frameFenceValue, m_fenceEvent);
+	}
+
+	// GPU가 끝낸 프레임의 해제를 미룬 개체를 회수하고 이 프레임의 상수 영역, 설명자 구간과 명령 할당기를 재설정합니다.
+	m_deferredReleases.Release(m_fence->GetCompletedValue());
+	BeginFrame();
+}
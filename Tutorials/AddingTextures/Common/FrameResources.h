@@ -0,0 +1,100 @@
+﻿#pragma once
+
+#include <functional>
+#include <memory>
+#include "CommandListPool.h"
+#include "DeferredReleaseQueue.h"
+#include "DescriptorHeapAllocator.h"
+#include "FrameFenceTracker.h"
+#include "GpuProfiler.h"
+#include "LinearConstantAllocator.h"
+
+namespace DX
+{
+	static const UINT c_defaultFrameCount = 3;	// 기본적으로 3개의 프레임을 동시에 진행합니다.
+	static const UINT c_maxFrameCount = 4;		// 진행 중인 프레임 수는 1~4 사이에서 설정할 수 있습니다.
+	static const UINT64 c_constantBufferSizePerFrame = 2 * 1024 * 1024;	// 프레임당 상수 버퍼 공간입니다(256바이트 상수 8192개).
+	static const UINT64 c_instanceBufferSizePerFrame = 4 * 1024 * 1024;	// 프레임당 인스턴스 데이터 공간입니다(24바이트 인스턴스 약 17만 개).
+	static const UINT c_shaderVisibleDescriptorsPerFrame = 4096;		// 프레임당 셰이더 표시 CBV/SRV/UAV 설명자 수입니다.
+	static const UINT c_gpuProfilerScopesPerFrame = 64;				// 프레임당 측정할 수 있는 GPU 타임스탬프 구간 수입니다.
+
+	// 직접 큐 하나에 대한 프레임 단위 리소스와 CPU/GPU 동기화입니다.
+	// 프레임 fence, 해제 지연 큐, 프레임별 상수·인스턴스 할당기, 셰이더 표시 설명자 링, 명령 목록 풀과 GPU 프로파일러를 소유합니다.
+	// 스왑 체인과 창에 의존하지 않으므로 DeviceResources와 헤드리스 검사 프로그램(NullDevice)이 같은 제출 경로를 사용합니다.
+	class FrameResources
+	{
+	public:
+		FrameResources(ID3D12Device* device, ID3D12CommandQueue* commandQueue, UINT frameCount = c_defaultFrameCount);
+		~FrameResources();
+
+		// 큐에 제출한 모든 작업이 끝날 때까지 기다립니다.
+		void WaitForGpu();
+
+		// 현재 프레임 끝에 fence를 신호하고 다음 프레임 슬롯으로 이동합니다.
+		// 그 슬롯을 마지막으로 사용한 GPU 작업을 기다린 뒤 완료된 해제를 실행하고 슬롯의 리소스를 재설정합니다.
+		void MoveToNextFrame();
+
+		// GPU가 유휴 상태일 때 첫 프레임 슬롯부터 다시 시작합니다. WaitForGpu 뒤에 호출해야 합니다.
+		void ResetFrames();
+
+		// 진행 중인 프레임 수(1~c_maxFrameCount)를 바꾸고 프레임별 리소스를 다시 만듭니다. GPU를 먼저 기다립니다.
+		void SetFrameCount(UINT frameCount);
+		UINT GetFrameCount() const			{ return m_frameCount; }
+
+		// 지금까지 큐에 제출한 작업이 끝난 뒤 object를 해제합니다. object는 즉시 비워집니다.
+		template<typename T>
+		void DeferRelease(Microsoft::WRL::ComPtr<T>& object)
+		{
+			if (object != nullptr)
+			{
+				IUnknown* reference = object.Detach();
+				DeferRelease([reference]() { reference->Release(); });
+			}
+		}
+
+		// 설명자 구간 반환처럼 개체가 아닌 리소스의 해제를 같은 방식으로 미룹니다.
+		void DeferRelease(std::function<void()> release)
+		{
+			m_deferredReleases.Enqueue(m_frameFences.GetNextSignalValue(), std::move(release));
+		}
+
+		UINT							GetCurrentFrameIndex() const			{ return m_frameFences.GetCurrentFrame(); }
+		ID3D12Fence*					GetFence() const						{ return m_fence.Get(); }
+		ShaderVisibleDescriptorHeap*	GetShaderVisibleDescriptorHeap() const	{ return m_shaderVisibleHeap.get(); }
+		CommandListPool*				GetCommandListPool() const				{ return m_commandListPool.get(); }
+		LinearConstantAllocator*		GetConstantAllocator() const			{ return m_constantAllocator.get(); }
+		LinearConstantAllocator*		GetInstanceAllocator() const			{ return m_instanceAllocator.get(); }
+		GpuProfiler*					GetGpuProfiler() const					{ return m_gpuProfiler.get(); }
+
+	private:
+		void CreatePerFrameResources();
+		void BeginFrame();
+
+		Microsoft::WRL::ComPtr<ID3D12Device>			m_device;
+		Microsoft::WRL::ComPtr<ID3D12CommandQueue>		m_commandQueue;
+		UINT											m_frameCount;
+
+		// CPU/GPU 동기화.
+		Microsoft::WRL::ComPtr<ID3D12Fence>				m_fence;
+		FrameFenceTracker								m_frameFences;
+		HANDLE											m_fenceEvent;
+
+		// fence가 지나면 해제되는 개체입니다. 장치보다 먼저 소멸되도록 장치 뒤에 선언합니다.
+		DeferredReleaseQueue							m_deferredReleases;
+
+		// 설명자 테이블은 프레임별 셰이더 표시 링에 복사합니다.
+		std::unique_ptr<ShaderVisibleDescriptorHeap>	m_shaderVisibleHeap;
+
+		// 프레임별 명령 할당기/목록 풀입니다. 작업자 스레드마다 자신의 쌍을 받습니다.
+		std::unique_ptr<CommandListPool>				m_commandListPool;
+
+		// 프레임마다 재설정되는 상수 버퍼 할당기입니다.
+		std::unique_ptr<LinearConstantAllocator>		m_constantAllocator;
+
+		// 프레임마다 재설정되는 인스턴스 데이터(루트 SRV로 읽는 구조적 버퍼) 할당기입니다.
+		std::unique_ptr<LinearConstantAllocator>		m_instanceAllocator;
+
+		// 프레임별 타임스탬프 쿼리로 GPU 구간 시간을 측정합니다.
+		std::unique_ptr<GpuProfiler>					m_gpuProfiler;
+	};
+}
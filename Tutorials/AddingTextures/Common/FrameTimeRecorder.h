@@ -0,0 +1,214 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace DX
+{
+	// 로그 간격 히스토그램의 버킷 수입니다.
+	// 버킷 0은 c_frameTimeHistogramBaseTicks 미만, 버킷 k는 [base * 2^(k-1), base * 2^k) 범위를 담고
+	// 마지막 버킷은 그보다 긴 모든 프레임을 담습니다.
+	static const std::uint32_t c_frameTimeHistogramBuckets = 16;
+	static const std::uint64_t c_frameTimeHistogramBaseTicks = 1250;	// 0.125밀리초입니다.
+
+	// 최근 프레임 시간 분포의 요약입니다. 모든 시간 값은 StepTimer 눈금(초당 10,000,000) 단위입니다.
+	struct FrameTimeStatistics
+	{
+		std::uint32_t	sampleCount;
+		std::uint64_t	minTicks;
+		std::uint64_t	p50Ticks;
+		std::uint64_t	p95Ticks;
+		std::uint64_t	p99Ticks;
+		std::uint64_t	maxTicks;
+		double			averageTicks;
+
+		// 중앙값의 N배를 넘은 프레임(히치)입니다.
+		std::uint32_t	hitchCount;
+		std::uint64_t	worstHitchTicks;
+
+		std::uint32_t	histogram[c_frameTimeHistogramBuckets];
+	};
+
+	// 히치 하나에 대한 기록입니다. frameIndex는 기록기가 받은 틱 순번입니다.
+	struct FrameHitch
+	{
+		std::uint64_t	frameIndex;
+		std::uint64_t	ticks;
+	};
+
+	// 틱마다의 프레임 시간을 고정 크기 링에 기록하고 백분위수, 히스토그램 및 히치를 계산합니다.
+	// 기록은 단일 스레드(렌더링 루프)에서만 잠금 없이 수행하며, 통계는 다른 스레드에서도 읽을 수 있습니다.
+	// 통계 계산은 멤버 스크래치 버퍼를 공유하므로 읽기끼리만 잠금으로 직렬화되고 기록을 막지는 않습니다.
+	class FrameTimeRecorder
+	{
+	public:
+		// 링의 용량입니다. 인덱스를 마스크로 계산할 수 있도록 2의 거듭제곱이어야 합니다.
+		static const std::uint32_t c_capacity = 1024;
+
+		FrameTimeRecorder() :
+			m_writeIndex(0),
+			m_hitchMultiplier(2.0),
+			m_chronological(c_capacity),
+			m_sorted(c_capacity)
+		{
+			for (auto& sample : m_samples)
+			{
+				sample.store(0, std::memory_order_relaxed);
+			}
+		}
+
+		// 한 틱의 프레임 시간을 기록합니다.
+		void Record(std::uint64_t ticks)
+		{
+			const std::uint64_t index = m_writeIndex.load(std::memory_order_relaxed);
+			m_samples[index & (c_capacity - 1)].store(ticks, std::memory_order_relaxed);
+			m_writeIndex.store(index + 1, std::memory_order_release);
+		}
+
+		// 기록된 샘플을 모두 버립니다. 기록 스레드에서만 호출해야 합니다.
+		void Reset()											{ m_writeIndex.store(0, std::memory_order_release); }
+
+		// 지금까지 기록된 총 틱 수입니다.
+		std::uint64_t GetRecordedCount() const					{ return m_writeIndex.load(std::memory_order_acquire); }
+
+		// 프레임이 중앙값의 몇 배를 넘어야 히치로 간주할지 설정합니다.
+		void SetHitchMultiplier(double multiplier)				{ m_hitchMultiplier = multiplier; }
+		double GetHitchMultiplier() const						{ return m_hitchMultiplier; }
+
+		// 링에 남아 있는 최근 샘플의 통계를 계산합니다.
+		FrameTimeStatistics GetStatistics() const
+		{
+			std::lock_guard<std::mutex> lock(m_scratchLock);
+			const std::uint64_t* chronological = m_chronological.data();
+			std::uint64_t* sorted = m_sorted.data();
+			const std::uint32_t count = Snapshot(m_chronological.data());
+
+			FrameTimeStatistics stats = {};
+			stats.sampleCount = count;
+			if (count == 0)
+			{
+				return stats;
+			}
+
+			std::copy(chronological, chronological + count, sorted);
+			std::sort(sorted, sorted + count);
+
+			double sum = 0.0;
+			for (std::uint32_t i = 0; i < count; i++)
+			{
+				sum += static_cast<double>(sorted[i]);
+				stats.histogram[GetHistogramBucket(sorted[i])]++;
+			}
+
+			stats.minTicks = sorted[0];
+			stats.p50Ticks = sorted[PercentileIndex(count, 50)];
+			stats.p95Ticks = sorted[PercentileIndex(count, 95)];
+			stats.p99Ticks = sorted[PercentileIndex(count, 99)];
+			stats.maxTicks = sorted[count - 1];
+			stats.averageTicks = sum / count;
+
+			const double threshold = stats.p50Ticks * m_hitchMultiplier;
+			for (std::uint32_t i = 0; i < count; i++)
+			{
+				if (static_cast<double>(chronological[i]) > threshold)
+				{
+					stats.hitchCount++;
+					stats.worstHitchTicks = (std::max)(stats.worstHitchTicks, chronological[i]);
+				}
+			}
+
+			return stats;
+		}
+
+		// 가장 최근의 히치를 오래된 것부터 최대 maxHitches개 복사하고 복사한 수를 반환합니다.
+		std::uint32_t GetRecentHitches(FrameHitch* hitches, std::uint32_t maxHitches) const
+		{
+			std::lock_guard<std::mutex> lock(m_scratchLock);
+			const std::uint64_t* chronological = m_chronological.data();
+			std::uint64_t* sorted = m_sorted.data();
+			std::uint64_t firstIndex = 0;
+			const std::uint32_t count = Snapshot(m_chronological.data(), &firstIndex);
+			if (count == 0 || maxHitches == 0)
+			{
+				return 0;
+			}
+
+			std::copy(chronological, chronological + count, sorted);
+			std::nth_element(sorted, sorted + PercentileIndex(count, 50), sorted + count);
+			const double threshold = sorted[PercentileIndex(count, 50)] * m_hitchMultiplier;
+
+			// 최근 히치를 먼저 찾으려면 뒤에서부터 검색한 다음 순서를 되돌립니다.
+			std::uint32_t found = 0;
+			for (std::uint32_t i = count; i-- > 0 && found < maxHitches;)
+			{
+				if (static_cast<double>(chronological[i]) > threshold)
+				{
+					hitches[found].frameIndex = firstIndex + i;
+					hitches[found].ticks = chronological[i];
+					found++;
+				}
+			}
+			std::reverse(hitches, hitches + found);
+			return found;
+		}
+
+		// 프레임 시간이 속하는 로그 히스토그램 버킷을 반환합니다.
+		static std::uint32_t GetHistogramBucket(std::uint64_t ticks)
+		{
+			std::uint64_t scaled = ticks / c_frameTimeHistogramBaseTicks;
+			std::uint32_t bucket = 0;
+			while (scaled != 0 && bucket < c_frameTimeHistogramBuckets - 1)
+			{
+				scaled >>= 1;
+				bucket++;
+			}
+			return bucket;
+		}
+
+		// 버킷의 하한(포함)을 눈금 단위로 반환합니다.
+		static std::uint64_t GetHistogramBucketLowerBound(std::uint32_t bucket)
+		{
+			return bucket == 0 ? 0 : c_frameTimeHistogramBaseTicks << (bucket - 1);
+		}
+
+	private:
+		// 최근 샘플을 시간순으로 복사합니다. 복사 중에 기록기가 가장 오래된 슬롯을 덮어쓰면
+		// 해당 슬롯에는 더 새로운 샘플이 들어가지만 통계에는 무해합니다.
+		std::uint32_t Snapshot(std::uint64_t* destination, std::uint64_t* firstIndex = nullptr) const
+		{
+			const std::uint64_t end = m_writeIndex.load(std::memory_order_acquire);
+			const std::uint32_t count = static_cast<std::uint32_t>((std::min)(end, static_cast<std::uint64_t>(c_capacity)));
+			const std::uint64_t begin = end - count;
+
+			for (std::uint32_t i = 0; i < count; i++)
+			{
+				destination[i] = m_samples[(begin + i) & (c_capacity - 1)].load(std::memory_order_relaxed);
+			}
+
+			if (firstIndex != nullptr)
+			{
+				*firstIndex = begin;
+			}
+			return count;
+		}
+
+		// 가장 가까운 순위 방식의 백분위수 인덱스입니다.
+		static std::uint32_t PercentileIndex(std::uint32_t count, std::uint32_t percentile)
+		{
+			const std::uint32_t rank = (count * percentile + 99) / 100;
+			return rank == 0 ? 0 : rank - 1;
+		}
+
+		std::atomic<std::uint64_t>	m_samples[c_capacity];
+		std::atomic<std::uint64_t>	m_writeIndex;
+		double						m_hitchMultiplier;
+
+		// 통계 계산용 스크래치 버퍼입니다. 호출마다 스택에 16KB를 잡지 않도록 한 번만 할당합니다.
+		mutable std::mutex					m_scratchLock;
+		mutable std::vector<std::uint64_t>	m_chronological;
+		mutable std::vector<std::uint64_t>	m_sorted;
+	};
+}
@@ -0,0 +1,1117 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+#include "ImportedMesh.h"
+#include "ParallelFor.h"
+
+namespace DX
+{
+	// glTF 2.0 파서입니다. 플랫폼 API에 의존하지 않으므로 도구와 헤드리스 빌드에서도 사용할 수 있습니다.
+	//
+	// .gltf(JSON)와 .glb(이진 컨테이너)를 모두 읽습니다. 버퍼는 GLB의 BIN 청크, base64 data URI, 또는 resolver로 읽는 외부 파일입니다.
+	// 기본 장면의 노드 계층을 따라 삼각형 목록(mode 4) 프리미티브의 POSITION, NORMAL, TEXCOORD_0과 인덱스를 월드 좌표로 옮겨
+	// 메시 하나로 합칩니다. 장면이 없으면 모든 메시를 변환 없이 합칩니다. 그 밖의 모드 프리미티브는 건너뛰고,
+	// 희소(sparse) 접근자와 모프 타깃, 스키닝은 지원하지 않습니다.
+	//
+	// GLB	: 헤더(magic, version, length), JSON 청크, (선택) BIN 청크. 청크는 길이, 형식, 4바이트 정렬 데이터입니다.
+	// 모든 값은 little-endian입니다.
+	static const std::uint32_t c_glbMagic = 0x46546C67;		// 'glTF'
+	static const std::uint32_t c_glbVersion = 2;
+	static const std::uint32_t c_glbChunkJson = 0x4E4F534A;	// 'JSON'
+	static const std::uint32_t c_glbChunkBin = 0x004E4942;	// 'BIN\0'
+
+	// 외부 버퍼를 읽는 함수입니다. uri는 % 인코딩을 푼 상대 경로입니다. 읽지 못하면 false를 반환합니다.
+	typedef std::function<bool(const std::string& uri, std::vector<std::uint8_t>* data)> GltfUriResolver;
+
+	namespace GltfDetail
+	{
+		static const std::uint32_t c_none = UINT32_MAX;
+
+		// 중첩 한도입니다. 잘못된 파일이 재귀로 스택을 다 쓰지 않게 합니다.
+		static const std::uint32_t c_maxJsonDepth = 64;
+		static const std::uint32_t c_maxNodeDepth = 64;
+
+		static const std::uint32_t c_componentByte = 5120;
+		static const std::uint32_t c_componentUnsignedByte = 5121;
+		static const std::uint32_t c_componentShort = 5122;
+		static const std::uint32_t c_componentUnsignedShort = 5123;
+		static const std::uint32_t c_componentUnsignedInt = 5125;
+		static const std::uint32_t c_componentFloat = 5126;
+
+		static const std::uint32_t c_modeTriangles = 4;
+
+		enum class JsonType : std::uint8_t
+		{
+			Object,
+			Array,
+			String,
+			Number,
+			Literal
+		};
+
+		// 평평한 배열에 저장하는 JSON 값입니다. 객체의 자식은 키, 값, 키, 값... 순서로 바로 뒤에 오고,
+		// next는 이 값의 하위 토큰을 모두 건너뛴 다음 토큰 번호입니다. 문자열은 따옴표 안쪽 범위를 가리키며 이스케이프를 풀지 않습니다.
+		struct JsonToken
+		{
+			JsonType		type;
+			std::uint32_t	begin;
+			std::uint32_t	end;
+			std::uint32_t	next;
+			std::uint32_t	count;	// 객체의 키 수 또는 배열의 원소 수입니다.
+		};
+
+		class JsonDocument
+		{
+		public:
+			bool Parse(const char* text, std::size_t size)
+			{
+				if (size >= UINT32_MAX)
+				{
+					return false;
+				}
+				m_text = text;
+				m_p = text;
+				m_end = text + size;
+				m_tokens.clear();
+				m_tokens.reserve(size / 8);
+				if (!ParseValue(0))
+				{
+					return false;
+				}
+				SkipWhitespace();
+				return m_p == m_end;
+			}
+
+			const JsonToken& operator[](std::uint32_t token) const	{ return m_tokens[token]; }
+
+			// 객체에서 key의 값 토큰을 찾습니다. 없으면 c_none입니다.
+			std::uint32_t Find(std::uint32_t object, const char* key) const
+			{
+				if (object == c_none || m_tokens[object].type != JsonType::Object)
+				{
+					return c_none;
+				}
+				std::uint32_t token = object + 1;
+				for (std::uint32_t i = 0; i < m_tokens[object].count; i++)
+				{
+					if (StringEquals(token, key))
+					{
+						return token + 1;
+					}
+					token = m_tokens[token + 1].next;
+				}
+				return c_none;
+			}
+
+			// 배열 원소의 토큰 번호를 모읍니다. 번호로 여러 번 찾는 배열(accessors 등)에 사용합니다.
+			std::vector<std::uint32_t> GetElements(std::uint32_t array) const
+			{
+				std::vector<std::uint32_t> elements;
+				if (array != c_none && m_tokens[array].type == JsonType::Array)
+				{
+					elements.reserve(m_tokens[array].count);
+					for (std::uint32_t token = array + 1, i = 0; i < m_tokens[array].count; i++, token = m_tokens[token].next)
+					{
+						elements.push_back(token);
+					}
+				}
+				return elements;
+			}
+
+			bool GetNumber(std::uint32_t token, double* value) const
+			{
+				if (token == c_none || m_tokens[token].type != JsonType::Number)
+				{
+					return false;
+				}
+				const char* p = m_text + m_tokens[token].begin;
+				return MeshImportDetail::ParseDouble(p, m_text + m_tokens[token].end, value);
+			}
+
+			// 음이 아닌 정수 값을 읽습니다. 값이 없으면 defaultValue를 쓰고, 정수가 아니면 false를 반환합니다.
+			bool GetIndex(std::uint32_t token, std::uint64_t defaultValue, std::uint64_t* value) const
+			{
+				if (token == c_none)
+				{
+					*value = defaultValue;
+					return true;
+				}
+				double number;
+				if (!GetNumber(token, &number) || number < 0.0 || number > 9007199254740992.0 || number != std::floor(number))
+				{
+					return false;
+				}
+				*value = static_cast<std::uint64_t>(number);
+				return true;
+			}
+
+			bool IsTrue(std::uint32_t token) const
+			{
+				return token != c_none && m_tokens[token].type == JsonType::Literal && m_text[m_tokens[token].begin] == 't';
+			}
+
+			bool StringEquals(std::uint32_t token, const char* value) const
+			{
+				if (token == c_none || m_tokens[token].type != JsonType::String)
+				{
+					return false;
+				}
+				const std::size_t length = m_tokens[token].end - m_tokens[token].begin;
+				return std::strlen(value) == length && std::memcmp(m_text + m_tokens[token].begin, value, length) == 0;
+			}
+
+			// 이스케이프를 푼 문자열입니다. \u는 UTF-8로 바꾸며 서로게이트 쌍은 지원하지 않습니다.
+			std::string GetString(std::uint32_t token) const
+			{
+				std::string result;
+				if (token == c_none || m_tokens[token].type != JsonType::String)
+				{
+					return result;
+				}
+				const char* end = m_text + m_tokens[token].end;
+				for (const char* p = m_text + m_tokens[token].begin; p < end; p++)
+				{
+					if (*p != '\\' || p + 1 == end)
+					{
+						result.push_back(*p);
+						continue;
+					}
+					switch (*++p)
+					{
+					case 'b': result.push_back('\b'); break;
+					case 'f': result.push_back('\f'); break;
+					case 'n': result.push_back('\n'); break;
+					case 'r': result.push_back('\r'); break;
+					case 't': result.push_back('\t'); break;
+					case 'u':
+						if (end - p > 4)
+						{
+							std::uint32_t code = 0;
+							for (std::uint32_t i = 1; i <= 4; i++)
+							{
+								code = code * 16 + HexValue(p[i]);
+							}
+							p += 4;
+							AppendUtf8(code, &result);
+						}
+						break;
+					default: result.push_back(*p); break;
+					}
+				}
+				return result;
+			}
+
+		private:
+			static std::uint32_t HexValue(char c)
+			{
+				if (c >= '0' && c <= '9') return static_cast<std::uint32_t>(c - '0');
+				if (c >= 'a' && c <= 'f') return static_cast<std::uint32_t>(c - 'a' + 10);
+				if (c >= 'A' && c <= 'F') return static_cast<std::uint32_t>(c - 'A' + 10);
+				return 0;
+			}
+
+			static void AppendUtf8(std::uint32_t code, std::string* result)
+			{
+				if (code < 0x80)
+				{
+					result->push_back(static_cast<char>(code));
+				}
+				else if (code < 0x800)
+				{
+					result->push_back(static_cast<char>(0xC0 | (code >> 6)));
+					result->push_back(static_cast<char>(0x80 | (code & 0x3F)));
+				}
+				else
+				{
+					result->push_back(static_cast<char>(0xE0 | (code >> 12)));
+					result->push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+					result->push_back(static_cast<char>(0x80 | (code & 0x3F)));
+				}
+			}
+
+			void SkipWhitespace()
+			{
+				while (m_p < m_end && (*m_p == ' ' || *m_p == '\t' || *m_p == '\r' || *m_p == '\n'))
+				{
+					m_p++;
+				}
+			}
+
+			std::uint32_t AddToken(JsonType type)
+			{
+				JsonToken token = { type, static_cast<std::uint32_t>(m_p - m_text), 0, 0, 0 };
+				m_tokens.push_back(token);
+				return static_cast<std::uint32_t>(m_tokens.size() - 1);
+			}
+
+			bool ParseString()
+			{
+				m_p++;
+				const std::uint32_t token = AddToken(JsonType::String);
+				for (;;)
+				{
+					if (m_p == m_end || static_cast<unsigned char>(*m_p) < 0x20)
+					{
+						return false;
+					}
+					if (*m_p == '"')
+					{
+						break;
+					}
+					if (*m_p == '\\')
+					{
+						if (++m_p == m_end)
+						{
+							return false;
+						}
+					}
+					m_p++;
+				}
+				m_tokens[token].end = static_cast<std::uint32_t>(m_p - m_text);
+				m_tokens[token].next = token + 1;
+				m_p++;
+				return true;
+			}
+
+			bool ParseLiteral(const char* literal)
+			{
+				const std::size_t length = std::strlen(literal);
+				if (static_cast<std::size_t>(m_end - m_p) < length || std::memcmp(m_p, literal, length) != 0)
+				{
+					return false;
+				}
+				const std::uint32_t token = AddToken(JsonType::Literal);
+				m_p += length;
+				m_tokens[token].end = static_cast<std::uint32_t>(m_p - m_text);
+				m_tokens[token].next = token + 1;
+				return true;
+			}
+
+			bool ParseValue(std::uint32_t depth)
+			{
+				SkipWhitespace();
+				if (m_p == m_end || depth > c_maxJsonDepth)
+				{
+					return false;
+				}
+
+				switch (*m_p)
+				{
+				case '"':
+					return ParseString();
+				case 't':
+					return ParseLiteral("true");
+				case 'f':
+					return ParseLiteral("false");
+				case 'n':
+					return ParseLiteral("null");
+				case '{':
+				case '[':
+					break;
+				default:
+				{
+					const std::uint32_t token = AddToken(JsonType::Number);
+					double value;
+					if (!MeshImportDetail::ParseDouble(m_p, m_end, &value))
+					{
+						return false;
+					}
+					m_tokens[token].end = static_cast<std::uint32_t>(m_p - m_text);
+					m_tokens[token].next = token + 1;
+					return true;
+				}
+				}
+
+				const bool isObject = *m_p == '{';
+				const char close = isObject ? '}' : ']';
+				const std::uint32_t token = AddToken(isObject ? JsonType::Object : JsonType::Array);
+				std::uint32_t count = 0;
+				m_p++;
+				SkipWhitespace();
+				if (m_p < m_end && *m_p == close)
+				{
+					m_p++;
+				}
+				else
+				{
+					for (;;)
+					{
+						if (isObject)
+						{
+							SkipWhitespace();
+							if (m_p == m_end || *m_p != '"' || !ParseString())
+							{
+								return false;
+							}
+							SkipWhitespace();
+							if (m_p == m_end || *m_p != ':')
+							{
+								return false;
+							}
+							m_p++;
+						}
+						if (!ParseValue(depth + 1))
+						{
+							return false;
+						}
+						count++;
+
+						SkipWhitespace();
+						if (m_p == m_end)
+						{
+							return false;
+						}
+						if (*m_p++ == close)
+						{
+							break;
+						}
+						if (m_p[-1] != ',')
+						{
+							return false;
+						}
+					}
+				}
+
+				m_tokens[token].end = static_cast<std::uint32_t>(m_p - m_text);
+				m_tokens[token].next = static_cast<std::uint32_t>(m_tokens.size());
+				m_tokens[token].count = count;
+				return true;
+			}
+
+			const char*				m_text;
+			const char*				m_p;
+			const char*				m_end;
+			std::vector<JsonToken>	m_tokens;
+		};
+
+		struct Buffer
+		{
+			const std::uint8_t*	data;
+			std::size_t			size;
+		};
+
+		// 접근자가 가리키는 원소 배열입니다. data가 nullptr이면(bufferView가 없으면) 모든 원소가 0입니다.
+		struct Accessor
+		{
+			const std::uint8_t*	data;
+			std::size_t			stride;
+			std::size_t			count;
+			std::uint32_t		componentType;
+			std::uint32_t		componentCount;
+			bool				normalized;
+		};
+
+		// 열 우선 4x4 행렬입니다(glTF와 같은 순서).
+		struct Matrix
+		{
+			float	m[16];
+		};
+
+		struct Instance
+		{
+			std::uint32_t	primitive;
+			Matrix			world;
+		};
+
+		inline Matrix Identity()
+		{
+			Matrix result = {};
+			result.m[0] = result.m[5] = result.m[10] = result.m[15] = 1.0f;
+			return result;
+		}
+
+		inline Matrix Multiply(const Matrix& a, const Matrix& b)
+		{
+			Matrix result;
+			for (std::uint32_t column = 0; column < 4; column++)
+			{
+				for (std::uint32_t row = 0; row < 4; row++)
+				{
+					float sum = 0.0f;
+					for (std::uint32_t k = 0; k < 4; k++)
+					{
+						sum += a.m[k * 4 + row] * b.m[column * 4 + k];
+					}
+					result.m[column * 4 + row] = sum;
+				}
+			}
+			return result;
+		}
+
+		inline bool IsIdentity(const Matrix& matrix)
+		{
+			const Matrix identity = Identity();
+			return std::memcmp(matrix.m, identity.m, sizeof(matrix.m)) == 0;
+		}
+
+		inline std::uint32_t GetComponentSize(std::uint32_t componentType)
+		{
+			switch (componentType)
+			{
+			case c_componentByte:
+			case c_componentUnsignedByte:
+				return 1;
+			case c_componentShort:
+			case c_componentUnsignedShort:
+				return 2;
+			case c_componentUnsignedInt:
+			case c_componentFloat:
+				return 4;
+			default:
+				return 0;
+			}
+		}
+
+		inline float ReadComponent(const std::uint8_t* p, std::uint32_t componentType, bool normalized)
+		{
+			switch (componentType)
+			{
+			case c_componentFloat:
+			{
+				float value;
+				std::memcpy(&value, p, sizeof(value));
+				return value;
+			}
+			case c_componentUnsignedByte:
+				return normalized ? p[0] / 255.0f : p[0];
+			case c_componentByte:
+			{
+				const float value = static_cast<std::int8_t>(p[0]);
+				return normalized ? (std::max)(value / 127.0f, -1.0f) : value;
+			}
+			case c_componentUnsignedShort:
+			{
+				std::uint16_t value;
+				std::memcpy(&value, p, sizeof(value));
+				return normalized ? value / 65535.0f : value;
+			}
+			case c_componentShort:
+			{
+				std::int16_t value;
+				std::memcpy(&value, p, sizeof(value));
+				return normalized ? (std::max)(value / 32767.0f, -1.0f) : value;
+			}
+			default:
+			{
+				std::uint32_t value;
+				std::memcpy(&value, p, sizeof(value));
+				return static_cast<float>(value);
+			}
+			}
+		}
+
+		inline std::uint32_t ReadIndex(const std::uint8_t* p, std::uint32_t componentType)
+		{
+			if (componentType == c_componentUnsignedByte)
+			{
+				return p[0];
+			}
+			if (componentType == c_componentUnsignedShort)
+			{
+				std::uint16_t value;
+				std::memcpy(&value, p, sizeof(value));
+				return value;
+			}
+			std::uint32_t value;
+			std::memcpy(&value, p, sizeof(value));
+			return value;
+		}
+
+		inline bool DecodeBase64(const char* p, const char* end, std::vector<std::uint8_t>* data)
+		{
+			data->clear();
+			data->reserve(static_cast<std::size_t>(end - p) / 4 * 3);
+			std::uint32_t bits = 0;
+			std::uint32_t bitCount = 0;
+			for (; p < end && *p != '='; p++)
+			{
+				const char c = *p;
+				std::uint32_t value;
+				if (c >= 'A' && c <= 'Z') value = static_cast<std::uint32_t>(c - 'A');
+				else if (c >= 'a' && c <= 'z') value = static_cast<std::uint32_t>(c - 'a' + 26);
+				else if (c >= '0' && c <= '9') value = static_cast<std::uint32_t>(c - '0' + 52);
+				else if (c == '+') value = 62;
+				else if (c == '/') value = 63;
+				else return false;
+
+				bits = (bits << 6) | value;
+				bitCount += 6;
+				if (bitCount >= 8)
+				{
+					bitCount -= 8;
+					data->push_back(static_cast<std::uint8_t>(bits >> bitCount));
+				}
+			}
+			return true;
+		}
+
+		inline std::string DecodeUri(const std::string& uri)
+		{
+			std::string result;
+			result.reserve(uri.size());
+			for (std::size_t i = 0; i < uri.size(); i++)
+			{
+				if (uri[i] == '%' && i + 2 < uri.size() && std::isxdigit(static_cast<unsigned char>(uri[i + 1])) && std::isxdigit(static_cast<unsigned char>(uri[i + 2])))
+				{
+					result.push_back(static_cast<char>(std::stoi(uri.substr(i + 1, 2), nullptr, 16)));
+					i += 2;
+				}
+				else
+				{
+					result.push_back(uri[i]);
+				}
+			}
+			return result;
+		}
+
+		// glTF 문서와 버퍼, 미리 모은 배열 원소 번호입니다.
+		class Document
+		{
+		public:
+			JsonDocument						json;
+			std::vector<Buffer>					buffers;
+			std::vector<std::vector<std::uint8_t>>	ownedBuffers;
+			std::vector<std::uint32_t>			bufferViews;
+			std::vector<std::uint32_t>			accessors;
+			std::vector<std::uint32_t>			meshes;
+			std::vector<std::uint32_t>			nodes;
+
+			bool LoadBuffers(const std::uint8_t* binary, std::size_t binarySize, const GltfUriResolver& resolver)
+			{
+				const std::vector<std::uint32_t> bufferTokens = json.GetElements(json.Find(0, "buffers"));
+				buffers.resize(bufferTokens.size());
+				ownedBuffers.resize(bufferTokens.size());
+				for (std::size_t i = 0; i < bufferTokens.size(); i++)
+				{
+					std::uint64_t byteLength;
+					if (!json.GetIndex(json.Find(bufferTokens[i], "byteLength"), UINT64_MAX, &byteLength) || byteLength == UINT64_MAX)
+					{
+						return false;
+					}
+
+					const std::uint32_t uriToken = json.Find(bufferTokens[i], "uri");
+					if (uriToken == c_none)
+					{
+						if (i != 0 || binary == nullptr)
+						{
+							return false;
+						}
+						buffers[i].data = binary;
+						buffers[i].size = binarySize;
+					}
+					else
+					{
+						const std::string uri = json.GetString(uriToken);
+						if (uri.compare(0, 5, "data:") == 0)
+						{
+							const std::size_t base64 = uri.find(";base64,");
+							if (base64 == std::string::npos || !DecodeBase64(uri.data() + base64 + 8, uri.data() + uri.size(), &ownedBuffers[i]))
+							{
+								return false;
+							}
+						}
+						else if (!resolver || !resolver(DecodeUri(uri), &ownedBuffers[i]))
+						{
+							return false;
+						}
+						buffers[i].data = ownedBuffers[i].data();
+						buffers[i].size = ownedBuffers[i].size();
+					}
+
+					if (buffers[i].size < byteLength)
+					{
+						return false;
+					}
+					buffers[i].size = static_cast<std::size_t>(byteLength);
+				}
+
+				bufferViews = json.GetElements(json.Find(0, "bufferViews"));
+				accessors = json.GetElements(json.Find(0, "accessors"));
+				meshes = json.GetElements(json.Find(0, "meshes"));
+				nodes = json.GetElements(json.Find(0, "nodes"));
+				return true;
+			}
+
+			// 접근자를 읽고 버퍼 범위를 검사합니다. expectedComponentCount가 맞지 않으면 실패합니다.
+			bool GetAccessor(std::uint32_t token, std::uint32_t expectedComponentCount, Accessor* accessor) const
+			{
+				std::uint64_t index, componentType, count, byteOffset;
+				if (!json.GetIndex(token, UINT64_MAX, &index) || index >= accessors.size())
+				{
+					return false;
+				}
+				const std::uint32_t object = accessors[static_cast<std::size_t>(index)];
+				if (json.Find(object, "sparse") != c_none ||
+					!json.GetIndex(json.Find(object, "componentType"), 0, &componentType) ||
+					!json.GetIndex(json.Find(object, "count"), UINT64_MAX, &count) || count >= UINT32_MAX ||
+					!json.GetIndex(json.Find(object, "byteOffset"), 0, &byteOffset))
+				{
+					return false;
+				}
+
+				const std::uint32_t typeToken = json.Find(object, "type");
+				const std::uint32_t componentCount =
+					json.StringEquals(typeToken, "SCALAR") ? 1 :
+					json.StringEquals(typeToken, "VEC2") ? 2 :
+					json.StringEquals(typeToken, "VEC3") ? 3 :
+					json.StringEquals(typeToken, "VEC4") ? 4 : 0;
+				const std::uint32_t componentSize = GetComponentSize(static_cast<std::uint32_t>(componentType));
+				if (componentCount != expectedComponentCount || componentSize == 0)
+				{
+					return false;
+				}
+
+				accessor->componentType = static_cast<std::uint32_t>(componentType);
+				accessor->componentCount = componentCount;
+				accessor->count = static_cast<std::size_t>(count);
+				accessor->normalized = json.IsTrue(json.Find(object, "normalized"));
+				accessor->data = nullptr;
+				accessor->stride = componentSize * componentCount;
+
+				const std::uint32_t viewToken = json.Find(object, "bufferView");
+				if (viewToken == c_none)
+				{
+					return true;
+				}
+
+				std::uint64_t viewIndex, bufferIndex, viewOffset, viewLength, viewStride;
+				if (!json.GetIndex(viewToken, UINT64_MAX, &viewIndex) || viewIndex >= bufferViews.size())
+				{
+					return false;
+				}
+				const std::uint32_t view = bufferViews[static_cast<std::size_t>(viewIndex)];
+				if (!json.GetIndex(json.Find(view, "buffer"), UINT64_MAX, &bufferIndex) || bufferIndex >= buffers.size() ||
+					!json.GetIndex(json.Find(view, "byteOffset"), 0, &viewOffset) ||
+					!json.GetIndex(json.Find(view, "byteLength"), UINT64_MAX, &viewLength) ||
+					!json.GetIndex(json.Find(view, "byteStride"), accessor->stride, &viewStride) || viewStride < accessor->stride)
+				{
+					return false;
+				}
+
+				const Buffer& buffer = buffers[static_cast<std::size_t>(bufferIndex)];
+				if (viewOffset > buffer.size || viewLength > buffer.size - viewOffset)
+				{
+					return false;
+				}
+				if (count != 0 && (byteOffset > viewLength || (count - 1) * viewStride + accessor->stride > viewLength - byteOffset))
+				{
+					return false;
+				}
+
+				accessor->data = buffer.data + viewOffset + byteOffset;
+				accessor->stride = static_cast<std::size_t>(viewStride);
+				return true;
+			}
+
+			// 노드와 그 자식의 프리미티브를 월드 행렬과 함께 모읍니다.
+			bool CollectNode(std::uint64_t node, const Matrix& parent, std::uint32_t depth, std::vector<Instance>* instances) const
+			{
+				if (node >= nodes.size() || depth > c_maxNodeDepth)
+				{
+					return false;
+				}
+				const std::uint32_t object = nodes[static_cast<std::size_t>(node)];
+
+				Matrix local = Identity();
+				const std::uint32_t matrixToken = json.Find(object, "matrix");
+				if (matrixToken != c_none)
+				{
+					if (!ReadFloats(matrixToken, 16, local.m))
+					{
+						return false;
+					}
+				}
+				else
+				{
+					float translation[3] = { 0.0f, 0.0f, 0.0f };
+					float rotation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+					float scale[3] = { 1.0f, 1.0f, 1.0f };
+					const std::uint32_t translationToken = json.Find(object, "translation");
+					const std::uint32_t rotationToken = json.Find(object, "rotation");
+					const std::uint32_t scaleToken = json.Find(object, "scale");
+					if ((translationToken != c_none && !ReadFloats(translationToken, 3, translation)) ||
+						(rotationToken != c_none && !ReadFloats(rotationToken, 4, rotation)) ||
+						(scaleToken != c_none && !ReadFloats(scaleToken, 3, scale)))
+					{
+						return false;
+					}
+
+					// T * R * S입니다. 회전 행렬의 열에 크기를 곱하고 마지막 열에 이동을 둡니다.
+					const float x = rotation[0], y = rotation[1], z = rotation[2], w = rotation[3];
+					const float r[9] =
+					{
+						1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y + w * z), 2.0f * (x * z - w * y),
+						2.0f * (x * y - w * z), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z + w * x),
+						2.0f * (x * z + w * y), 2.0f * (y * z - w * x), 1.0f - 2.0f * (x * x + y * y)
+					};
+					for (std::uint32_t column = 0; column < 3; column++)
+					{
+						for (std::uint32_t row = 0; row < 3; row++)
+						{
+							local.m[column * 4 + row] = r[column * 3 + row] * scale[column];
+						}
+					}
+					local.m[12] = translation[0];
+					local.m[13] = translation[1];
+					local.m[14] = translation[2];
+				}
+				const Matrix world = Multiply(parent, local);
+
+				const std::uint32_t meshToken = json.Find(object, "mesh");
+				if (meshToken != c_none)
+				{
+					std::uint64_t mesh;
+					if (!json.GetIndex(meshToken, UINT64_MAX, &mesh) || mesh >= meshes.size())
+					{
+						return false;
+					}
+					for (std::uint32_t primitive : json.GetElements(json.Find(meshes[static_cast<std::size_t>(mesh)], "primitives")))
+					{
+						Instance instance = { primitive, world };
+						instances->push_back(instance);
+					}
+				}
+
+				for (std::uint32_t child : json.GetElements(json.Find(object, "children")))
+				{
+					std::uint64_t childIndex;
+					if (!json.GetIndex(child, UINT64_MAX, &childIndex) || !CollectNode(childIndex, world, depth + 1, instances))
+					{
+						return false;
+					}
+				}
+				return true;
+			}
+
+		private:
+			bool ReadFloats(std::uint32_t array, std::uint32_t count, float* values) const
+			{
+				const std::vector<std::uint32_t> elements = json.GetElements(array);
+				if (elements.size() != count)
+				{
+					return false;
+				}
+				for (std::uint32_t i = 0; i < count; i++)
+				{
+					double value;
+					if (!json.GetNumber(elements[i], &value))
+					{
+						return false;
+					}
+					values[i] = static_cast<float>(value);
+				}
+				return true;
+			}
+		};
+
+		// 프리미티브 하나를 mesh의 [firstVertex, firstIndex) 위치부터 씁니다. 큰 프리미티브는 여러 스레드에서 나누어 변환합니다.
+		// 법선은 월드 행렬 3x3의 여인수 행렬(역전치와 방향이 같음)로 옮기고, 행렬식이 음수이면 삼각형 감김 순서를 뒤집습니다.
+		inline bool WritePrimitive(
+			const Matrix& world,
+			const Accessor& positions,
+			const Accessor* normals,
+			const Accessor* texCoords,
+			const Accessor* indices,
+			std::size_t firstVertex,
+			std::size_t firstIndex,
+			ImportedMesh* mesh)
+		{
+			const float* m = world.m;
+			const bool transform = !IsIdentity(world);
+			const float cofactor[9] =
+			{
+				m[5] * m[10] - m[6] * m[9], m[6] * m[8] - m[4] * m[10], m[4] * m[9] - m[5] * m[8],
+				m[9] * m[2] - m[10] * m[1], m[10] * m[0] - m[8] * m[2], m[8] * m[1] - m[9] * m[0],
+				m[1] * m[6] - m[2] * m[5], m[2] * m[4] - m[0] * m[6], m[0] * m[5] - m[1] * m[4]
+			};
+			const float determinant = m[0] * cofactor[0] + m[1] * cofactor[1] + m[2] * cofactor[2];
+			const float normalSign = determinant < 0.0f ? -1.0f : 1.0f;
+
+			ParallelForRowBlocks(static_cast<std::uint32_t>(positions.count), sizeof(MeshVertex), 1 << 20, [&](std::uint32_t begin, std::uint32_t end)
+			{
+				for (std::uint32_t v = begin; v < end; v++)
+				{
+					MeshVertex& vertex = mesh->vertices[firstVertex + v];
+					float p[3] = {}, n[3] = {}, t[2] = {};
+					for (std::uint32_t k = 0; k < 3 && positions.data != nullptr; k++)
+					{
+						p[k] = ReadComponent(positions.data + positions.stride * v + k * 4, c_componentFloat, false);
+					}
+					for (std::uint32_t k = 0; k < 3 && normals != nullptr && normals->data != nullptr; k++)
+					{
+						n[k] = ReadComponent(normals->data + normals->stride * v + k * 4, c_componentFloat, false);
+					}
+					if (texCoords != nullptr && texCoords->data != nullptr)
+					{
+						const std::uint32_t componentSize = GetComponentSize(texCoords->componentType);
+						for (std::uint32_t k = 0; k < 2; k++)
+						{
+							t[k] = ReadComponent(texCoords->data + texCoords->stride * v + k * componentSize, texCoords->componentType, texCoords->normalized);
+						}
+					}
+
+					if (transform)
+					{
+						for (std::uint32_t row = 0; row < 3; row++)
+						{
+							vertex.position[row] = m[row] * p[0] + m[4 + row] * p[1] + m[8 + row] * p[2] + m[12 + row];
+						}
+						float transformed[3];
+						for (std::uint32_t row = 0; row < 3; row++)
+						{
+							transformed[row] = (cofactor[row] * n[0] + cofactor[3 + row] * n[1] + cofactor[6 + row] * n[2]) * normalSign;
+						}
+						const float length = std::sqrt(transformed[0] * transformed[0] + transformed[1] * transformed[1] + transformed[2] * transformed[2]);
+						const float scale = length > 0.0f ? 1.0f / length : 0.0f;
+						for (std::uint32_t row = 0; row < 3; row++)
+						{
+							vertex.normal[row] = transformed[row] * scale;
+						}
+					}
+					else
+					{
+						std::memcpy(vertex.position, p, sizeof(p));
+						std::memcpy(vertex.normal, n, sizeof(n));
+					}
+					std::memcpy(vertex.texCoord, t, sizeof(t));
+				}
+			});
+
+			const std::size_t indexCount = indices != nullptr ? indices->count : positions.count;
+			const std::uint32_t triangleCount = static_cast<std::uint32_t>(indexCount / 3);
+			const bool flip = determinant < 0.0f;
+			std::atomic<bool> valid(true);
+			ParallelForRowBlocks(triangleCount, 12, 1 << 20, [&](std::uint32_t begin, std::uint32_t end)
+			{
+				std::uint32_t* destination = mesh->indices.data() + firstIndex + begin * static_cast<std::size_t>(3);
+				for (std::uint32_t triangle = begin; triangle < end; triangle++)
+				{
+					std::uint32_t corners[3];
+					for (std::uint32_t k = 0; k < 3; k++)
+					{
+						const std::size_t i = triangle * static_cast<std::size_t>(3) + k;
+						corners[k] = indices == nullptr ? static_cast<std::uint32_t>(i) :
+							indices->data == nullptr ? 0 : ReadIndex(indices->data + indices->stride * i, indices->componentType);
+						if (corners[k] >= positions.count)
+						{
+							valid = false;
+							return;
+						}
+					}
+					if (flip)
+					{
+						std::swap(corners[1], corners[2]);
+					}
+					for (std::uint32_t k = 0; k < 3; k++)
+					{
+						*destination++ = static_cast<std::uint32_t>(firstVertex + corners[k]);
+					}
+				}
+			});
+			return valid;
+		}
+	}
+
+	// glTF 2.0 파일(.gltf 또는 .glb)을 읽어 mesh를 채웁니다. resolver가 비어 있으면 외부 버퍼가 있는 파일은 읽지 못합니다.
+	// 형식이 맞지 않거나, 범위를 벗어나거나, 지원하지 않는 기능을 쓰면 false를 반환합니다.
+	inline bool ParseGltf(const std::uint8_t* data, std::size_t size, const GltfUriResolver& resolver, ImportedMesh* mesh)
+	{
+		using namespace GltfDetail;
+
+		const char* jsonText = reinterpret_cast<const char*>(data);
+		std::size_t jsonSize = size;
+		const std::uint8_t* binary = nullptr;
+		std::size_t binarySize = 0;
+
+		std::uint32_t header[3] = {};
+		if (size >= sizeof(header))
+		{
+			std::memcpy(header, data, sizeof(header));
+		}
+		if (header[0] == c_glbMagic)
+		{
+			std::uint32_t chunk[2];
+			if (header[1] != c_glbVersion || header[2] > size || header[2] < 20)
+			{
+				return false;
+			}
+			std::memcpy(chunk, data + 12, sizeof(chunk));
+			if (chunk[1] != c_glbChunkJson || chunk[0] > header[2] - 20)
+			{
+				return false;
+			}
+			jsonText = reinterpret_cast<const char*>(data + 20);
+			jsonSize = chunk[0];
+
+			const std::size_t binaryOffset = 20 + ((static_cast<std::size_t>(chunk[0]) + 3) & ~static_cast<std::size_t>(3));
+			if (binaryOffset + 8 <= header[2])
+			{
+				std::memcpy(chunk, data + binaryOffset, sizeof(chunk));
+				if (chunk[1] == c_glbChunkBin && chunk[0] <= header[2] - binaryOffset - 8)
+				{
+					binary = data + binaryOffset + 8;
+					binarySize = chunk[0];
+				}
+			}
+		}
+
+		Document document;
+		if (!document.json.Parse(jsonText, jsonSize) || document.json[0].type != JsonType::Object ||
+			!document.LoadBuffers(binary, binarySize, resolver))
+		{
+			return false;
+		}
+		const JsonDocument& json = document.json;
+
+		// 기본 장면의 노드를 따라 프리미티브를 모읍니다. 장면이 없으면 모든 메시를 그대로 씁니다.
+		std::vector<Instance> instances;
+		const std::vector<std::uint32_t> scenes = json.GetElements(json.Find(0, "scenes"));
+		if (!scenes.empty())
+		{
+			std::uint64_t scene;
+			if (!json.GetIndex(json.Find(0, "scene"), 0, &scene) || scene >= scenes.size())
+			{
+				return false;
+			}
+			for (std::uint32_t node : json.GetElements(json.Find(scenes[static_cast<std::size_t>(scene)], "nodes")))
+			{
+				std::uint64_t nodeIndex;
+				if (!json.GetIndex(node, UINT64_MAX, &nodeIndex) || !document.CollectNode(nodeIndex, Identity(), 0, &instances))
+				{
+					return false;
+				}
+			}
+		}
+		else
+		{
+			for (std::uint32_t meshToken : document.meshes)
+			{
+				for (std::uint32_t primitive : json.GetElements(json.Find(meshToken, "primitives")))
+				{
+					Instance instance = { primitive, Identity() };
+					instances.push_back(instance);
+				}
+			}
+		}
+
+		// 접근자를 먼저 모두 검사하고 출력 위치를 정한 뒤 한 번에 할당합니다.
+		struct Primitive
+		{
+			const Instance*	instance;
+			Accessor		positions;
+			Accessor		normals;
+			Accessor		texCoords;
+			Accessor		indices;
+			bool			hasNormals;
+			bool			hasTexCoords;
+			bool			hasIndices;
+			std::size_t		firstVertex;
+			std::size_t		firstIndex;
+		};
+		std::vector<Primitive> primitives;
+		primitives.reserve(instances.size());
+		std::size_t vertexCount = 0;
+		std::size_t indexCount = 0;
+		mesh->hasNormals = false;
+		mesh->hasTexCoords = false;
+		for (const Instance& instance : instances)
+		{
+			std::uint64_t mode;
+			if (!json.GetIndex(json.Find(instance.primitive, "mode"), c_modeTriangles, &mode))
+			{
+				return false;
+			}
+			if (mode != c_modeTriangles)
+			{
+				continue;
+			}
+
+			Primitive primitive = {};
+			primitive.instance = &instance;
+			const std::uint32_t attributes = json.Find(instance.primitive, "attributes");
+			const std::uint32_t normalToken = json.Find(attributes, "NORMAL");
+			const std::uint32_t texCoordToken = json.Find(attributes, "TEXCOORD_0");
+			const std::uint32_t indexToken = json.Find(instance.primitive, "indices");
+			if (!document.GetAccessor(json.Find(attributes, "POSITION"), 3, &primitive.positions) ||
+				primitive.positions.componentType != c_componentFloat)
+			{
+				return false;
+			}
+			if (normalToken != c_none)
+			{
+				if (!document.GetAccessor(normalToken, 3, &primitive.normals) || primitive.normals.componentType != c_componentFloat ||
+					primitive.normals.count != primitive.positions.count)
+				{
+					return false;
+				}
+				primitive.hasNormals = true;
+			}
+			if (texCoordToken != c_none)
+			{
+				const Accessor& texCoords = primitive.texCoords;
+				if (!document.GetAccessor(texCoordToken, 2, &primitive.texCoords) || texCoords.count != primitive.positions.count ||
+					!(texCoords.componentType == c_componentFloat ||
+					((texCoords.componentType == c_componentUnsignedByte || texCoords.componentType == c_componentUnsignedShort) && texCoords.normalized)))
+				{
+					return false;
+				}
+				primitive.hasTexCoords = true;
+			}
+			if (indexToken != c_none)
+			{
+				const Accessor& indices = primitive.indices;
+				if (!document.GetAccessor(indexToken, 1, &primitive.indices) ||
+					!(indices.componentType == c_componentUnsignedByte || indices.componentType == c_componentUnsignedShort || indices.componentType == c_componentUnsignedInt))
+				{
+					return false;
+				}
+				primitive.hasIndices = true;
+			}
+
+			const std::size_t primitiveIndexCount = primitive.hasIndices ? primitive.indices.count : primitive.positions.count;
+			if (primitiveIndexCount % 3 != 0)
+			{
+				return false;
+			}
+			primitive.firstVertex = vertexCount;
+			primitive.firstIndex = indexCount;
+			vertexCount += primitive.positions.count;
+			indexCount += primitiveIndexCount;
+			if (vertexCount >= UINT32_MAX || indexCount >= UINT32_MAX)
+			{
+				return false;
+			}
+			mesh->hasNormals |= primitive.hasNormals;
+			mesh->hasTexCoords |= primitive.hasTexCoords;
+			primitives.push_back(primitive);
+		}
+
+		mesh->vertices.resize(vertexCount);
+		mesh->indices.resize(indexCount);
+		for (const Primitive& primitive : primitives)
+		{
+			if (!WritePrimitive(
+				primitive.instance->world,
+				primitive.positions,
+				primitive.hasNormals ? &primitive.normals : nullptr,
+				primitive.hasTexCoords ? &primitive.texCoords : nullptr,
+				primitive.hasIndices ? &primitive.indices : nullptr,
+				primitive.firstVertex,
+				primitive.firstIndex,
+				mesh))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
@@ -0,0 +1,135 @@
+﻿#include "pch.h"
+#include "GpuProfiler.h"
+#include "DirectXHelper.h"
+
+using namespace DX;
+
+namespace
+{
+	UINT64 GetTimestampFrequency(ID3D12CommandQueue* commandQueue)
+	{
+		UINT64 frequency = 0;
+		DX::ThrowIfFailed(commandQueue->GetTimestampFrequency(&frequency));
+		return frequency;
+	}
+}
+
+GpuProfiler::GpuProfiler(ID3D12Device* device, ID3D12CommandQueue* commandQueue, UINT frameCount, UINT maxScopesPerFrame) :
+	m_frames(new Frame[frameCount]),
+	m_frameCount(frameCount),
+	m_maxScopesPerFrame(maxScopesPerFrame),
+	m_currentFrame(0),
+	m_timings(GetTimestampFrequency(commandQueue)),
+	m_droppedScopes(0)
+{
+	const UINT queriesPerFrame = maxScopesPerFrame * 2;
+
+	D3D12_QUERY_HEAP_DESC queryHeapDesc = {};
+	queryHeapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+	queryHeapDesc.Count = queriesPerFrame * frameCount;
+	DX::ThrowIfFailed(device->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(&m_queryHeap)));
+	NAME_D3D12_OBJECT(m_queryHeap);
+
+	// 판독 힙의 리소스는 COPY_DEST 상태로 만들어야 하며 상태를 바꿀 수 없습니다.
+	CD3DX12_HEAP_PROPERTIES readbackHeapProperties(D3D12_HEAP_TYPE_READBACK);
+	CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(static_cast<UINT64>(queryHeapDesc.Count) * sizeof(UINT64));
+	DX::ThrowIfFailed(device->CreateCommittedResource(
+		&readbackHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&bufferDesc,
+		D3D12_RESOURCE_STATE_COPY_DEST,
+		nullptr,
+		IID_PPV_ARGS(&m_readbackBuffer)));
+	NAME_D3D12_OBJECT(m_readbackBuffer);
+
+	for (UINT i = 0; i < frameCount; i++)
+	{
+		m_frames[i].scopes = std::unique_ptr<GpuTimingScope[]>(new GpuTimingScope[maxScopesPerFrame]);
+		m_frames[i].scopeCount.store(0, std::memory_order_relaxed);
+		m_frames[i].resolvedCount = 0;
+	}
+}
+
+void GpuProfiler::BeginFrame(UINT frameIndex)
+{
+	m_currentFrame = frameIndex % m_frameCount;
+	Frame& frame = m_frames[m_currentFrame];
+
+	// 이 슬롯을 마지막으로 사용한 프레임은 fence가 완료되었으므로 판독 버퍼를 바로 읽을 수 있습니다.
+	if (frame.resolvedCount != 0)
+	{
+		const UINT queryCount = frame.resolvedCount * 2;
+		const SIZE_T offset = static_cast<SIZE_T>(m_currentFrame) * m_maxScopesPerFrame * 2 * sizeof(UINT64);
+		const CD3DX12_RANGE readRange(offset, offset + queryCount * sizeof(UINT64));
+
+		UINT8* mappedBuffer = nullptr;
+		DX::ThrowIfFailed(m_readbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mappedBuffer)));
+		m_timings.AddFrame(frame.scopes.get(), frame.resolvedCount, reinterpret_cast<const UINT64*>(mappedBuffer + offset), queryCount);
+
+		const CD3DX12_RANGE writtenRange(0, 0);		// CPU에서 이 리소스에 쓰지 않았습니다.
+		m_readbackBuffer->Unmap(0, &writtenRange);
+	}
+
+	frame.scopeCount.store(0, std::memory_order_relaxed);
+	frame.resolvedCount = 0;
+}
+
+UINT GpuProfiler::BeginScope(ID3D12GraphicsCommandList* commandList, const wchar_t* name)
+{
+	Frame& frame = m_frames[m_currentFrame];
+	const UINT scope = frame.scopeCount.fetch_add(1, std::memory_order_relaxed);
+	if (scope >= m_maxScopesPerFrame)
+	{
+		m_droppedScopes.fetch_add(1, std::memory_order_relaxed);
+		return c_invalidGpuScope;
+	}
+
+	frame.scopes[scope].name = name;
+	frame.scopes[scope].beginQuery = scope * 2;
+	frame.scopes[scope].endQuery = c_gpuTimingInvalidQuery;
+
+	commandList->EndQuery(m_queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, m_currentFrame * m_maxScopesPerFrame * 2 + scope * 2);
+	return scope;
+}
+
+void GpuProfiler::EndScope(ID3D12GraphicsCommandList* commandList, UINT scope)
+{
+	if (scope == c_invalidGpuScope)
+	{
+		return;
+	}
+
+	m_frames[m_currentFrame].scopes[scope].endQuery = scope * 2 + 1;
+	commandList->EndQuery(m_queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, m_currentFrame * m_maxScopesPerFrame * 2 + scope * 2 + 1);
+}
+
+void GpuProfiler::ResolveFrame(ID3D12GraphicsCommandList* commandList)
+{
+	Frame& frame = m_frames[m_currentFrame];
+	const UINT scopeCount = (std::min)(frame.scopeCount.load(std::memory_order_relaxed), m_maxScopesPerFrame);
+	if (scopeCount == 0)
+	{
+		return;
+	}
+
+	// 쓰이지 않은 쿼리를 확인하면 결과가 정의되지 않으므로, 끝나지 않은 구간의 끝 슬롯에는 여기에서 자리표시 타임스탬프를 씁니다.
+	// 구간의 endQuery는 그대로 두므로 집계에서는 건너뜁니다. 구간 범위 전체를 한 번의 ResolveQueryData로 확인할 수 있습니다.
+	const UINT firstQuery = m_currentFrame * m_maxScopesPerFrame * 2;
+	for (UINT scope = 0; scope < scopeCount; scope++)
+	{
+		if (frame.scopes[scope].endQuery == c_gpuTimingInvalidQuery)
+		{
+			commandList->EndQuery(m_queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, firstQuery + scope * 2 + 1);
+		}
+	}
+
+	commandList->ResolveQueryData(
+		m_queryHeap.Get(),
+		D3D12_QUERY_TYPE_TIMESTAMP,
+		firstQuery,
+		scopeCount * 2,
+		m_readbackBuffer.Get(),
+		static_cast<UINT64>(firstQuery) * sizeof(UINT64));
+
+	frame.resolvedCount = scopeCount;
+}
@@ -0,0 +1,69 @@
+﻿#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "GpuTimingAggregator.h"
+
+namespace DX
+{
+	// 프레임당 기록할 수 있는 구간이 없을 때 BeginScope가 반환하는 값입니다. EndScope는 이 값을 무시합니다.
+	static const UINT c_invalidGpuScope = 0xFFFFFFFF;
+
+	// PIX 이벤트와 같은 구간을 타임스탬프 쿼리로 감싸 GPU 시간을 측정합니다.
+	// 프레임마다 쿼리 힙 구간과 판독 버퍼 구간을 하나씩 사용하며, 결과는 그 프레임 슬롯이 다시 사용될 때
+	// (즉, 프레임 fence가 완료된 뒤) BeginFrame에서 읽으므로 CPU가 GPU를 기다리지 않습니다.
+	class GpuProfiler
+	{
+	public:
+		GpuProfiler(ID3D12Device* device, ID3D12CommandQueue* commandQueue, UINT frameCount, UINT maxScopesPerFrame);
+
+		// frameIndex 슬롯에 확인된 결과가 있으면 집계한 다음 슬롯을 비웁니다. 그 프레임의 fence가 완료된 뒤에만 호출해야 합니다.
+		void BeginFrame(UINT frameIndex);
+
+		// 시작 타임스탬프를 기록하고 구간 번호를 반환합니다. name은 프레임이 집계될 때까지 유효해야 합니다(문자열 리터럴).
+		// 여러 스레드에서 호출할 수 있습니다. 구간이 끝나는 명령 목록은 시작한 목록과 달라도 됩니다.
+		UINT BeginScope(ID3D12GraphicsCommandList* commandList, const wchar_t* name);
+		void EndScope(ID3D12GraphicsCommandList* commandList, UINT scope);
+
+		// PIX 이벤트와 타임스탬프 구간을 함께 시작하고 끝냅니다.
+		UINT BeginEvent(ID3D12GraphicsCommandList* commandList, const wchar_t* name)
+		{
+			PIXBeginEvent(commandList, 0, name);
+			return BeginScope(commandList, name);
+		}
+		void EndEvent(ID3D12GraphicsCommandList* commandList, UINT scope)
+		{
+			EndScope(commandList, scope);
+			PIXEndEvent(commandList);
+		}
+
+		// 이번 프레임의 쿼리를 판독 버퍼로 확인합니다. 프레임에서 마지막으로 실행되는 명령 목록에 모든 EndScope 뒤에 기록해야 합니다.
+		// 끝나지 않은 구간은 자리표시 타임스탬프로 닫아 확인하며 집계하지 않습니다.
+		void ResolveFrame(ID3D12GraphicsCommandList* commandList);
+
+		// 구간 이름별 GPU 시간과 이동 평균입니다. 렌더링 스레드에서 읽어야 합니다.
+		const GpuTimingAggregator& GetTimings() const	{ return m_timings; }
+
+		// 슬롯이 가득 차서 기록하지 못한 구간 수입니다.
+		UINT64 GetDroppedScopeCount() const				{ return m_droppedScopes.load(std::memory_order_relaxed); }
+
+	private:
+		// 프레임 슬롯마다의 구간 목록입니다. 구간 i는 슬롯 쿼리 구간의 2i(시작)와 2i+1(끝)을 사용합니다.
+		struct Frame
+		{
+			std::unique_ptr<GpuTimingScope[]>	scopes;
+			std::atomic<UINT>					scopeCount;
+			UINT								resolvedCount;	// 확인된 구간 수입니다. 0이면 읽을 결과가 없습니다.
+		};
+
+		Microsoft::WRL::ComPtr<ID3D12QueryHeap>		m_queryHeap;
+		Microsoft::WRL::ComPtr<ID3D12Resource>		m_readbackBuffer;
+		std::unique_ptr<Frame[]>					m_frames;
+		UINT										m_frameCount;
+		UINT										m_maxScopesPerFrame;
+		UINT										m_currentFrame;
+		GpuTimingAggregator							m_timings;
+		std::atomic<UINT64>							m_droppedScopes;
+	};
+}
@@ -0,0 +1,161 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace DX
+{
+	static const std::uint32_t c_gpuTimingAverageFrames = 64;	// 이동 평균에 포함하는 최근 프레임 수입니다.
+	static const std::uint32_t c_gpuTimingInvalidQuery = 0xFFFFFFFF;	// 아직 끝나지 않은 구간의 endQuery 값입니다.
+
+	// 한 프레임에서 기록한 타임스탬프 구간입니다. beginQuery와 endQuery는 그 프레임의 타임스탬프 배열 인덱스입니다.
+	struct GpuTimingScope
+	{
+		const wchar_t*	name;
+		std::uint32_t	beginQuery;
+		std::uint32_t	endQuery;
+	};
+
+	// 구간 이름별 GPU 시간(밀리초)입니다.
+	struct GpuScopeTiming
+	{
+		std::wstring	name;
+		double			lastMilliseconds;		// 이 구간이 기록된 가장 최근 프레임의 시간입니다.
+		double			averageMilliseconds;	// 최근 sampleCount 프레임의 평균입니다.
+		double			maxMilliseconds;		// 같은 프레임 범위의 최댓값입니다.
+		std::uint32_t	sampleCount;
+	};
+
+	// 프레임별 타임스탬프를 구간 이름별 GPU 시간으로 바꾸고 이동 평균을 유지합니다.
+	// D3D 개체에 의존하지 않으므로 합성 타임스탬프로 검증할 수 있습니다.
+	// 한 프레임에서 같은 이름의 구간이 여러 번 기록되면(예: 작업자마다 하나의 명령 목록) 시간을 합산합니다.
+	class GpuTimingAggregator
+	{
+	public:
+		explicit GpuTimingAggregator(std::uint64_t timestampFrequency) :
+			m_millisecondsPerTick(timestampFrequency != 0 ? 1000.0 / static_cast<double>(timestampFrequency) : 0.0),
+			m_frameCount(0)
+		{
+		}
+
+		// 한 프레임의 구간을 집계합니다. 끝나지 않았거나 타임스탬프가 거꾸로인 구간은 건너뜁니다.
+		void AddFrame(const GpuTimingScope* scopes, std::size_t scopeCount, const std::uint64_t* timestamps, std::size_t timestampCount)
+		{
+			std::vector<double> frameMilliseconds(m_timings.size(), -1.0);
+
+			for (std::size_t i = 0; i < scopeCount; i++)
+			{
+				const GpuTimingScope& scope = scopes[i];
+				if (scope.name == nullptr || scope.beginQuery >= timestampCount || scope.endQuery >= timestampCount)
+				{
+					continue;
+				}
+
+				const std::uint64_t begin = timestamps[scope.beginQuery];
+				const std::uint64_t end = timestamps[scope.endQuery];
+				if (end < begin)
+				{
+					continue;
+				}
+
+				const std::size_t index = FindOrAddTiming(scope.name);
+				if (index >= frameMilliseconds.size())
+				{
+					frameMilliseconds.resize(index + 1, -1.0);
+				}
+				frameMilliseconds[index] = (std::max)(frameMilliseconds[index], 0.0) + (end - begin) * m_millisecondsPerTick;
+			}
+
+			for (std::size_t i = 0; i < frameMilliseconds.size(); i++)
+			{
+				if (frameMilliseconds[i] >= 0.0)
+				{
+					AddSample(i, frameMilliseconds[i]);
+				}
+			}
+			m_frameCount++;
+		}
+
+		// 처음 기록된 순서대로의 구간별 시간입니다.
+		const std::vector<GpuScopeTiming>& GetTimings() const	{ return m_timings; }
+
+		// 이름이 name인 구간의 시간이며, 아직 기록되지 않았으면 nullptr입니다.
+		const GpuScopeTiming* FindTiming(const wchar_t* name) const
+		{
+			for (const auto& timing : m_timings)
+			{
+				if (timing.name == name)
+				{
+					return &timing;
+				}
+			}
+			return nullptr;
+		}
+
+		// 집계한 프레임 수입니다.
+		std::uint64_t GetFrameCount() const						{ return m_frameCount; }
+
+		void Reset()
+		{
+			m_timings.clear();
+			m_histories.clear();
+			m_frameCount = 0;
+		}
+
+	private:
+		// 구간마다 최근 c_gpuTimingAverageFrames 샘플의 링입니다.
+		struct History
+		{
+			double			samples[c_gpuTimingAverageFrames];
+			std::uint32_t	next;
+		};
+
+		std::size_t FindOrAddTiming(const wchar_t* name)
+		{
+			for (std::size_t i = 0; i < m_timings.size(); i++)
+			{
+				if (m_timings[i].name == name)
+				{
+					return i;
+				}
+			}
+
+			GpuScopeTiming timing = {};
+			timing.name = name;
+			m_timings.push_back(timing);
+
+			History history = {};
+			m_histories.push_back(history);
+			return m_timings.size() - 1;
+		}
+
+		// 링에 샘플을 넣고 평균과 최댓값을 다시 계산합니다. 링이 작으므로 누적 오차가 생기지 않도록 매번 합산합니다.
+		void AddSample(std::size_t index, double milliseconds)
+		{
+			GpuScopeTiming& timing = m_timings[index];
+			History& history = m_histories[index];
+
+			history.samples[history.next] = milliseconds;
+			history.next = (history.next + 1) % c_gpuTimingAverageFrames;
+			timing.sampleCount = (std::min)(timing.sampleCount + 1, c_gpuTimingAverageFrames);
+			timing.lastMilliseconds = milliseconds;
+
+			double sum = 0.0;
+			double maximum = 0.0;
+			for (std::uint32_t i = 0; i < timing.sampleCount; i++)
+			{
+				sum += history.samples[i];
+				maximum = (std::max)(maximum, history.samples[i]);
+			}
+			timing.averageMilliseconds = sum / timing.sampleCount;
+			timing.maxMilliseconds = maximum;
+		}
+
+		double							m_millisecondsPerTick;
+		std::uint64_t					m_frameCount;
+		std::vector<GpuScopeTiming>		m_timings;
+		std::vector<History>			m_histories;
+	};
+}
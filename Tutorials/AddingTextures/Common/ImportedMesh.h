@@ -0,0 +1,278 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace DX
+{
+	// 가져온 메시와 쿠킹된 메시의 꼭짓점입니다. 텍스처 좌표의 원점은 왼쪽 위(D3D)입니다.
+	struct MeshVertex
+	{
+		float	position[3];
+		float	normal[3];
+		float	texCoord[2];
+	};
+
+	static_assert(sizeof(MeshVertex) == 32, "MeshVertex는 CookedMesh::InputLayout과 같은 배치여야 합니다.");
+
+	// OBJ/glTF 가져오기 결과입니다. indices는 삼각형 목록이며, 원본에 없는 법선과 텍스처 좌표는 0입니다.
+	struct ImportedMesh
+	{
+		ImportedMesh() : hasNormals(false), hasTexCoords(false) {}
+
+		std::vector<MeshVertex>		vertices;
+		std::vector<std::uint32_t>	indices;
+		bool						hasNormals;
+		bool						hasTexCoords;
+	};
+
+	// 가져오기 파서가 함께 쓰는 도우미입니다. 줄이나 토큰마다 할당하지 않도록 모두 [p, end) 범위에서 직접 읽습니다.
+	namespace MeshImportDetail
+	{
+		inline bool IsSpace(char c)
+		{
+			return c == ' ' || c == '\t' || c == '\r';
+		}
+
+		inline bool IsDigit(char c)
+		{
+			return static_cast<unsigned char>(c - '0') < 10;
+		}
+
+		inline const char* SkipSpaces(const char* p, const char* end)
+		{
+			while (p < end && IsSpace(*p))
+			{
+				p++;
+			}
+			return p;
+		}
+
+		// 10진 실수를 읽습니다. 유효 숫자 19자리까지 정수로 모은 뒤 10의 거듭제곱을 한 번 곱하므로 strtod보다 빠르고,
+		// 그 이상의 자리는 버립니다. 성공하면 p를 숫자 뒤로 옮깁니다.
+		inline bool ParseDouble(const char*& p, const char* end, double* value)
+		{
+			static const double c_powersOfTen[] =
+			{
+				1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+				1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+			};
+
+			const char* s = p;
+			bool negative = false;
+			if (s < end && (*s == '-' || *s == '+'))
+			{
+				negative = *s == '-';
+				s++;
+			}
+
+			std::uint64_t mantissa = 0;
+			int digitCount = 0;
+			int exponent = 0;
+			bool anyDigit = false;
+			for (; s < end && IsDigit(*s); s++)
+			{
+				anyDigit = true;
+				if (digitCount < 19)
+				{
+					mantissa = mantissa * 10 + static_cast<std::uint32_t>(*s - '0');
+					digitCount += mantissa != 0;
+				}
+				else
+				{
+					exponent++;
+				}
+			}
+			if (s < end && *s == '.')
+			{
+				for (s++; s < end && IsDigit(*s); s++)
+				{
+					anyDigit = true;
+					if (digitCount < 19)
+					{
+						mantissa = mantissa * 10 + static_cast<std::uint32_t>(*s - '0');
+						digitCount += mantissa != 0;
+						exponent--;
+					}
+				}
+			}
+			if (!anyDigit)
+			{
+				return false;
+			}
+
+			if (s < end && (*s == 'e' || *s == 'E'))
+			{
+				const char* e = s + 1;
+				bool negativeExponent = false;
+				if (e < end && (*e == '-' || *e == '+'))
+				{
+					negativeExponent = *e == '-';
+					e++;
+				}
+				if (e == end || !IsDigit(*e))
+				{
+					return false;
+				}
+				int exponentValue = 0;
+				for (; e < end && IsDigit(*e); e++)
+				{
+					exponentValue = (std::min)(exponentValue * 10 + (*e - '0'), 100000);
+				}
+				exponent += negativeExponent ? -exponentValue : exponentValue;
+				s = e;
+			}
+
+			double result = static_cast<double>(mantissa);
+			if (mantissa != 0 && exponent != 0)
+			{
+				if (exponent > 0 && exponent <= 22)
+				{
+					result *= c_powersOfTen[exponent];
+				}
+				else if (exponent < 0 && exponent >= -22)
+				{
+					result /= c_powersOfTen[-exponent];
+				}
+				else
+				{
+					result *= std::pow(10.0, exponent);
+				}
+			}
+
+			*value = negative ? -result : result;
+			p = s;
+			return true;
+		}
+
+		inline bool ParseFloat(const char*& p, const char* end, float* value)
+		{
+			double result;
+			if (!ParseDouble(p, end, &result))
+			{
+				return false;
+			}
+			*value = static_cast<float>(result);
+			return true;
+		}
+
+		// 부호 있는 10진 정수를 읽습니다. 2^62를 넘으면 실패합니다.
+		inline bool ParseInt(const char*& p, const char* end, std::int64_t* value)
+		{
+			const char* s = p;
+			bool negative = false;
+			if (s < end && (*s == '-' || *s == '+'))
+			{
+				negative = *s == '-';
+				s++;
+			}
+			if (s == end || !IsDigit(*s))
+			{
+				return false;
+			}
+
+			std::int64_t result = 0;
+			for (; s < end && IsDigit(*s); s++)
+			{
+				result = result * 10 + (*s - '0');
+				if (result > (static_cast<std::int64_t>(1) << 62))
+				{
+					return false;
+				}
+			}
+
+			*value = negative ? -result : result;
+			p = s;
+			return true;
+		}
+
+		// 원본에 없는 꼭짓점 성분의 번호와 해시 표의 빈 칸입니다.
+		static const std::uint32_t c_missingAttribute = UINT32_MAX;
+		static const std::uint32_t c_emptySlot = UINT32_MAX;
+
+		// (위치, 텍스처 좌표, 법선) 번호 세 개를 꼭짓점 번호 하나로 합치는 개방 주소 해시 표입니다.
+		// 키는 꼭짓점 번호 순서로 저장하므로 꼭짓점을 만들 때 그대로 읽으면 됩니다. 없는 성분은 c_missingAttribute입니다.
+		class VertexKeyTable
+		{
+		public:
+			struct Key
+			{
+				std::uint32_t	index[3];
+			};
+
+			explicit VertexKeyTable(std::size_t expectedCount)
+			{
+				std::size_t slotCount = 64;
+				while (slotCount < expectedCount * 2)
+				{
+					slotCount *= 2;
+				}
+				m_slots.assign(slotCount, c_emptySlot);
+				m_keys.reserve(expectedCount);
+			}
+
+			// 키의 꼭짓점 번호를 반환합니다. 처음 보는 키이면 새 번호를 붙입니다.
+			std::uint32_t Insert(const Key& key)
+			{
+				std::size_t mask = m_slots.size() - 1;
+				std::size_t slot = Hash(key) & mask;
+				for (;;)
+				{
+					const std::uint32_t vertex = m_slots[slot];
+					if (vertex == c_emptySlot)
+					{
+						break;
+					}
+					const Key& existing = m_keys[vertex];
+					if (existing.index[0] == key.index[0] && existing.index[1] == key.index[1] && existing.index[2] == key.index[2])
+					{
+						return vertex;
+					}
+					slot = (slot + 1) & mask;
+				}
+
+				const std::uint32_t vertex = static_cast<std::uint32_t>(m_keys.size());
+				m_keys.push_back(key);
+				m_slots[slot] = vertex;
+				if (m_keys.size() * 2 > m_slots.size())
+				{
+					Grow();
+				}
+				return vertex;
+			}
+
+			const std::vector<Key>& GetKeys() const	{ return m_keys; }
+
+		private:
+			static std::size_t Hash(const Key& key)
+			{
+				std::uint64_t h = key.index[0] * 0x9E3779B97F4A7C15ull;
+				h ^= (key.index[1] + 0x7F4A7C15ull) * 0xC2B2AE3D27D4EB4Full;
+				h ^= (key.index[2] + 0x27D4EB4Full) * 0x165667B19E3779F9ull;
+				return static_cast<std::size_t>(h ^ (h >> 29));
+			}
+
+			void Grow()
+			{
+				m_slots.assign(m_slots.size() * 2, c_emptySlot);
+				const std::size_t mask = m_slots.size() - 1;
+				for (std::uint32_t vertex = 0; vertex < m_keys.size(); vertex++)
+				{
+					std::size_t slot = Hash(m_keys[vertex]) & mask;
+					while (m_slots[slot] != c_emptySlot)
+					{
+						slot = (slot + 1) & mask;
+					}
+					m_slots[slot] = vertex;
+				}
+			}
+
+			std::vector<std::uint32_t>	m_slots;
+			std::vector<Key>			m_keys;
+		};
+	}
+}
@@ -0,0 +1,78 @@
+﻿#include "pch.h"
+#include "InstanceBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "ParallelFor.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <emmintrin.h>
+#define DX_INSTANCE_BUFFER_SSE2
+#elif defined(_M_ARM) || defined(_M_ARM64) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DX_INSTANCE_BUFFER_NEON
+#endif
+
+using namespace DX;
+
+namespace
+{
+	// 한 작업이 쓸 최소 바이트 수입니다. 만 개 정도까지는 스레드를 깨우는 비용이 더 큽니다.
+	const std::size_t c_minBytesPerBlock = 256 * 1024;
+
+	const float c_snorm16Max = 32767.0f;
+
+	void PackRange(const InstanceTransform* transforms, std::size_t count, PackedInstance* destination)
+	{
+#if defined(DX_INSTANCE_BUFFER_SSE2)
+		const __m128 snormMax = _mm_set1_ps(c_snorm16Max);
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 minusOne = _mm_set1_ps(-1.0f);
+		for (std::size_t i = 0; i < count; i++)
+		{
+			// 이동과 크기는 그대로 옮기고, 회전은 [-1, 1]로 자른 뒤 가장 가까운 짝수로 반올림합니다.
+			const __m128 positionScale = _mm_loadu_ps(transforms[i].position);
+			const __m128 rotation = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(transforms[i].rotation), minusOne), one);
+			const __m128i snorm = _mm_cvtps_epi32(_mm_mul_ps(rotation, snormMax));
+			_mm_storeu_ps(destination[i].position, positionScale);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(destination[i].rotation), _mm_packs_epi32(snorm, snorm));
+		}
+#elif defined(DX_INSTANCE_BUFFER_NEON)
+		const float32x4_t snormMax = vdupq_n_f32(c_snorm16Max);
+		const float32x4_t half = vdupq_n_f32(0.5f);
+		const uint32x4_t signMask = vdupq_n_u32(0x80000000u);
+		for (std::size_t i = 0; i < count; i++)
+		{
+			// 0.5에 부호를 붙여 더한 뒤 자르면 0에서 먼 쪽으로 반올림됩니다.
+			const float32x4_t positionScale = vld1q_f32(transforms[i].position);
+			const float32x4_t rotation = vminq_f32(vmaxq_f32(vld1q_f32(transforms[i].rotation), vdupq_n_f32(-1.0f)), vdupq_n_f32(1.0f));
+			const float32x4_t scaled = vmulq_f32(rotation, snormMax);
+			const float32x4_t rounding = vreinterpretq_f32_u32(vorrq_u32(vandq_u32(vreinterpretq_u32_f32(scaled), signMask), vreinterpretq_u32_f32(half)));
+			vst1q_f32(destination[i].position, positionScale);
+			vst1_s16(destination[i].rotation, vqmovn_s32(vcvtq_s32_f32(vaddq_f32(scaled, rounding))));
+		}
+#else
+		for (std::size_t i = 0; i < count; i++)
+		{
+			PackedInstance packed;
+			std::memcpy(packed.position, transforms[i].position, sizeof(packed.position));
+			packed.scale = transforms[i].scale;
+			for (int c = 0; c < 4; c++)
+			{
+				const float rotation = (std::min)((std::max)(transforms[i].rotation[c], -1.0f), 1.0f);
+				packed.rotation[c] = static_cast<std::int16_t>(std::lrint(rotation * c_snorm16Max));
+			}
+			std::memcpy(&destination[i], &packed, sizeof(packed));
+		}
+#endif
+	}
+}
+
+void DX::PackInstances(const InstanceTransform* transforms, std::size_t count, PackedInstance* destination)
+{
+	ParallelForRowBlocks(static_cast<std::uint32_t>(count), sizeof(PackedInstance), c_minBytesPerBlock, [&](std::uint32_t begin, std::uint32_t end)
+	{
+		PackRange(transforms + begin, end - begin, destination + begin);
+	});
+}
@@ -0,0 +1,30 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace DX
+{
+	// CPU에서 갱신하는 인스턴스 변환입니다. 크기(균일), 회전(단위 쿼터니언 x, y, z, w), 이동 순서로 적용합니다.
+	struct InstanceTransform
+	{
+		float	position[3];
+		float	scale;
+		float	rotation[4];
+	};
+
+	// 꼭짓점 셰이더가 SV_InstanceID로 읽는 구조적 버퍼 원소입니다(24바이트, float4x4의 3/8).
+	// 회전은 SNORM16 쿼터니언이며 셰이더에서 정규화합니다. HLSL: struct { float3 position; float scale; uint2 rotation; }
+	struct PackedInstance
+	{
+		float			position[3];
+		float			scale;
+		std::int16_t	rotation[4];
+	};
+
+	static_assert(sizeof(PackedInstance) == 24, "PackedInstance는 셰이더의 인스턴스 구조체와 같은 배치여야 합니다.");
+
+	// 인스턴스 변환을 압축하여 destination에 씁니다. destination은 보통 프레임별 업로드 버퍼(쓰기 결합 메모리)이므로
+	// 순서대로 한 번씩만 쓰고 읽지 않습니다. SSE2/NEON으로 인스턴스당 저장 두 번이며, 많은 인스턴스는 여러 스레드에서 나누어 처리합니다.
+	void PackInstances(const InstanceTransform* transforms, std::size_t count, PackedInstance* destination);
+}
@@ -0,0 +1,59 @@
+﻿#include "pch.h"
+#include "LinearConstantAllocator.h"
+#include "DirectXHelper.h"
+
+using namespace DX;
+
+LinearConstantAllocator::LinearConstantAllocator(ID3D12Device* device, UINT frameCount, UINT64 bytesPerFrame) :
+	m_mappedBuffer(nullptr),
+	m_gpuAddress(0),
+	m_frameCount(frameCount),
+	m_bytesPerFrame((bytesPerFrame + D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT - 1) & ~static_cast<UINT64>(D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT - 1)),
+	m_frameStart(0),
+	m_offset(0)
+{
+	CD3DX12_HEAP_PROPERTIES uploadHeapProperties(D3D12_HEAP_TYPE_UPLOAD);
+	CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(m_bytesPerFrame * frameCount);
+	DX::ThrowIfFailed(device->CreateCommittedResource(
+		&uploadHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&bufferDesc,
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS(&m_buffer)));
+
+	NAME_D3D12_OBJECT(m_buffer);
+
+	// 버퍼는 앱이 닫히기 전까지 매핑이 해제되지 않습니다.
+	CD3DX12_RANGE readRange(0, 0);		// CPU에서 이 리소스를 읽도록 의도하지 않았습니다.
+	DX::ThrowIfFailed(m_buffer->Map(0, &readRange, reinterpret_cast<void**>(&m_mappedBuffer)));
+	m_gpuAddress = m_buffer->GetGPUVirtualAddress();
+}
+
+LinearConstantAllocator::~LinearConstantAllocator()
+{
+	m_buffer->Unmap(0, nullptr);
+	m_mappedBuffer = nullptr;
+}
+
+void LinearConstantAllocator::BeginFrame(UINT frameIndex)
+{
+	m_frameStart = m_bytesPerFrame * (frameIndex % m_frameCount);
+	m_offset.store(0, std::memory_order_relaxed);
+}
+
+ConstantAllocation LinearConstantAllocator::Allocate(UINT64 size)
+{
+	// 상수 버퍼는 정렬된 256바이트여야 합니다. 모든 할당 크기를 정렬하면 오프셋도 항상 정렬됩니다.
+	const UINT64 alignedSize = (size + D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT - 1) & ~static_cast<UINT64>(D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT - 1);
+	const UINT64 offset = m_offset.fetch_add(alignedSize, std::memory_order_relaxed);
+	if (offset + alignedSize > m_bytesPerFrame)
+	{
+		DX::ThrowIfFailed(E_OUTOFMEMORY);
+	}
+
+	ConstantAllocation allocation;
+	allocation.cpuAddress = m_mappedBuffer + m_frameStart + offset;
+	allocation.gpuAddress = m_gpuAddress + m_frameStart + offset;
+	return allocation;
+}
@@ -0,0 +1,53 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <atomic>
+
+namespace DX
+{
+	// 상수 버퍼 데이터의 하위 할당입니다. 루트 CBV에는 gpuAddress를 직접 바인딩합니다.
+	struct ConstantAllocation
+	{
+		UINT8*						cpuAddress;
+		D3D12_GPU_VIRTUAL_ADDRESS	gpuAddress;
+	};
+
+	// 프레임마다 하나의 영역을 갖는 영구 매핑된 업로드 버퍼에서 256바이트로 정렬된 상수를 선형 할당합니다.
+	// 영역은 해당 프레임의 fence가 완료된 뒤 BeginFrame에서 재설정되므로, 그리기당 비용은 포인터 증가와 memcpy뿐입니다.
+	class LinearConstantAllocator
+	{
+	public:
+		LinearConstantAllocator(ID3D12Device* device, UINT frameCount, UINT64 bytesPerFrame);
+		~LinearConstantAllocator();
+
+		// frameIndex의 영역을 비우고 현재 영역으로 만듭니다. 그 프레임의 GPU 작업이 완료된 뒤에만 호출해야 합니다.
+		void BeginFrame(UINT frameIndex);
+
+		// 현재 프레임 영역에서 size 바이트를 할당합니다. 여러 스레드에서 호출할 수 있습니다.
+		// 영역이 가득 차면 E_OUTOFMEMORY 예외가 발생합니다.
+		ConstantAllocation Allocate(UINT64 size);
+
+		// data를 복사한 상수 버퍼의 GPU 주소를 반환합니다.
+		template<typename T>
+		D3D12_GPU_VIRTUAL_ADDRESS AllocateConstants(const T& data)
+		{
+			ConstantAllocation allocation = Allocate(sizeof(T));
+			memcpy(allocation.cpuAddress, &data, sizeof(T));
+			return allocation.gpuAddress;
+		}
+
+		UINT64 GetBytesPerFrame() const		{ return m_bytesPerFrame; }
+		UINT64 GetUsedSize() const			{ return (std::min)(m_offset.load(std::memory_order_relaxed), m_bytesPerFrame); }
+
+	private:
+		Microsoft::WRL::ComPtr<ID3D12Resource>	m_buffer;
+		UINT8*									m_mappedBuffer;
+		D3D12_GPU_VIRTUAL_ADDRESS				m_gpuAddress;
+		UINT									m_frameCount;
+		UINT64									m_bytesPerFrame;
+
+		// 현재 프레임 영역의 시작과 다음 할당 오프셋입니다.
+		UINT64									m_frameStart;
+		std::atomic<UINT64>						m_offset;
+	};
+}
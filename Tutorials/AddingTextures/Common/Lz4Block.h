@@ -0,0 +1,187 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace DX
+{
+	// LZ4 블록 형식(프레임 헤더 없음)의 압축기와 압축 해제기입니다. 외부 라이브러리 없이 에셋 팩에서 사용합니다.
+	// 압축기는 단순한 탐욕적 해시 검색이므로 참조 구현보다 압축률은 낮지만, 출력은 표준 LZ4 블록과 호환됩니다.
+	namespace Lz4
+	{
+		static const std::size_t c_minMatch = 4;
+		static const std::size_t c_lastLiterals = 5;	// 블록의 마지막 5바이트는 항상 리터럴입니다.
+		static const std::size_t c_matchFindLimit = 12;	// 마지막 일치는 블록 끝에서 12바이트 이전에 시작해야 합니다.
+		static const std::size_t c_maxOffset = 65535;
+		static const unsigned c_hashBits = 16;
+
+		inline void WriteLength(std::vector<std::uint8_t>& output, std::size_t length)
+		{
+			while (length >= 255)
+			{
+				output.push_back(255);
+				length -= 255;
+			}
+			output.push_back(static_cast<std::uint8_t>(length));
+		}
+
+		inline void WriteLiterals(std::vector<std::uint8_t>& output, const std::uint8_t* literals, std::size_t count, std::size_t matchCode)
+		{
+			const std::size_t literalCode = count < 15 ? count : 15;
+			output.push_back(static_cast<std::uint8_t>((literalCode << 4) | matchCode));
+			if (count >= 15)
+			{
+				WriteLength(output, count - 15);
+			}
+			output.insert(output.end(), literals, literals + count);
+		}
+
+		inline bool ReadLength(const std::uint8_t* source, std::size_t sourceSize, std::size_t* position, std::size_t* length)
+		{
+			std::uint8_t value;
+			do
+			{
+				if (*position >= sourceSize)
+				{
+					return false;
+				}
+				value = source[(*position)++];
+				*length += value;
+			} while (value == 255);
+			return true;
+		}
+	}
+
+	// 데이터를 LZ4 블록으로 압축합니다. 압축할 수 없는 데이터는 입력보다 약간 커질 수 있습니다.
+	inline std::vector<std::uint8_t> Lz4CompressBlock(const std::uint8_t* source, std::size_t size)
+	{
+		std::vector<std::uint8_t> output;
+		output.reserve(size + size / 255 + 16);
+
+		std::size_t anchor = 0;
+		if (size > Lz4::c_matchFindLimit)
+		{
+			// 해시 테이블에는 4바이트 시퀀스의 마지막 위치 + 1을 저장합니다. 0은 비어 있음을 뜻합니다.
+			std::vector<std::size_t> table(static_cast<std::size_t>(1) << Lz4::c_hashBits, 0);
+			const std::size_t matchLimit = size - Lz4::c_lastLiterals;
+
+			std::size_t position = 0;
+			while (position + Lz4::c_matchFindLimit <= size)
+			{
+				std::uint32_t sequence;
+				std::memcpy(&sequence, source + position, sizeof(sequence));
+				const std::uint32_t hash = (sequence * 2654435761u) >> (32 - Lz4::c_hashBits);
+
+				const std::size_t candidate = table[hash];
+				table[hash] = position + 1;
+
+				if (candidate == 0 || position - (candidate - 1) > Lz4::c_maxOffset ||
+					std::memcmp(source + candidate - 1, source + position, Lz4::c_minMatch) != 0)
+				{
+					position++;
+					continue;
+				}
+
+				const std::size_t match = candidate - 1;
+				std::size_t length = Lz4::c_minMatch;
+				while (position + length < matchLimit && source[match + length] == source[position + length])
+				{
+					length++;
+				}
+
+				const std::size_t matchCode = length - Lz4::c_minMatch;
+				Lz4::WriteLiterals(output, source + anchor, position - anchor, matchCode < 15 ? matchCode : 15);
+
+				const std::size_t offset = position - match;
+				output.push_back(static_cast<std::uint8_t>(offset & 0xFF));
+				output.push_back(static_cast<std::uint8_t>(offset >> 8));
+				if (matchCode >= 15)
+				{
+					Lz4::WriteLength(output, matchCode - 15);
+				}
+
+				position += length;
+				anchor = position;
+			}
+		}
+
+		// 마지막 시퀀스는 리터럴만 포함합니다.
+		Lz4::WriteLiterals(output, source + anchor, size - anchor, 0);
+		return output;
+	}
+
+	// LZ4 블록의 압축을 풉니다. 입력이 손상되었거나 결과가 정확히 destinationSize바이트가 아니면 false를 반환합니다.
+	// 범위를 벗어나는 읽기나 쓰기는 하지 않습니다.
+	inline bool Lz4DecompressBlock(const std::uint8_t* source, std::size_t sourceSize, std::uint8_t* destination, std::size_t destinationSize)
+	{
+		std::size_t input = 0;
+		std::size_t output = 0;
+
+		while (input < sourceSize)
+		{
+			const std::uint8_t token = source[input++];
+
+			std::size_t literalLength = token >> 4;
+			if (literalLength == 15 && !Lz4::ReadLength(source, sourceSize, &input, &literalLength))
+			{
+				return false;
+			}
+			if (literalLength > sourceSize - input || literalLength > destinationSize - output)
+			{
+				return false;
+			}
+			if (literalLength > 0)
+			{
+				std::memcpy(destination + output, source + input, literalLength);
+			}
+			input += literalLength;
+			output += literalLength;
+
+			// 마지막 시퀀스에는 일치가 없습니다.
+			if (input == sourceSize)
+			{
+				break;
+			}
+
+			if (sourceSize - input < 2)
+			{
+				return false;
+			}
+			const std::size_t offset = source[input] | (static_cast<std::size_t>(source[input + 1]) << 8);
+			input += 2;
+			if (offset == 0 || offset > output)
+			{
+				return false;
+			}
+
+			std::size_t matchLength = token & 15;
+			if (matchLength == 15 && !Lz4::ReadLength(source, sourceSize, &input, &matchLength))
+			{
+				return false;
+			}
+			matchLength += Lz4::c_minMatch;
+			if (matchLength > destinationSize - output)
+			{
+				return false;
+			}
+
+			// 겹치는 일치는 반복 패턴을 만들기 때문에 바이트 단위로 복사해야 합니다.
+			const std::uint8_t* match = destination + output - offset;
+			if (offset >= matchLength)
+			{
+				std::memcpy(destination + output, match, matchLength);
+			}
+			else
+			{
+				for (std::size_t i = 0; i < matchLength; i++)
+				{
+					destination[output + i] = match[i];
+				}
+			}
+			output += matchLength;
+		}
+
+		return output == destinationSize;
+	}
+}
@@ -0,0 +1,161 @@
+﻿#include "pch.h"
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#include "DirectXHelper.h"
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+#endif
+
+using namespace DX;
+
+#if defined(_WIN32)
+
+namespace
+{
+	void ThrowLastError()
+	{
+		DX::ThrowIfFailed(HRESULT_FROM_WIN32(GetLastError()));
+	}
+}
+
+MappedFile::MappedFile() :
+	m_data(nullptr),
+	m_size(0),
+	m_file(INVALID_HANDLE_VALUE),
+	m_mapping(nullptr)
+{
+}
+
+MappedFile::~MappedFile()
+{
+	if (m_data != nullptr)
+	{
+		UnmapViewOfFile(m_data);
+	}
+	if (m_mapping != nullptr)
+	{
+		CloseHandle(m_mapping);
+	}
+	if (m_file != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(m_file);
+	}
+}
+
+std::shared_ptr<const MappedFile> MappedFile::Open(const MappedFilePath& path)
+{
+	std::shared_ptr<MappedFile> file(new MappedFile());
+
+	// UWP에서도 사용할 수 있는 CreateFile2/CreateFileMappingFromApp/MapViewOfFileFromApp을 사용합니다.
+	CREATEFILE2_EXTENDED_PARAMETERS parameters = {};
+	parameters.dwSize = sizeof(parameters);
+	parameters.dwFileAttributes = FILE_ATTRIBUTE_NORMAL;
+	parameters.dwFileFlags = FILE_FLAG_SEQUENTIAL_SCAN;
+
+	file->m_file = CreateFile2(path.c_str(), GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, &parameters);
+	if (file->m_file == INVALID_HANDLE_VALUE)
+	{
+		ThrowLastError();
+	}
+
+	FILE_STANDARD_INFO info = {};
+	if (!GetFileInformationByHandleEx(file->m_file, FileStandardInfo, &info, sizeof(info)))
+	{
+		ThrowLastError();
+	}
+	file->m_size = static_cast<std::size_t>(info.EndOfFile.QuadPart);
+
+	// 크기가 0인 파일은 매핑할 수 없으므로 빈 보기로 둡니다.
+	if (file->m_size == 0)
+	{
+		return file;
+	}
+
+	file->m_mapping = CreateFileMappingFromApp(file->m_file, nullptr, PAGE_READONLY, 0, nullptr);
+	if (file->m_mapping == nullptr)
+	{
+		ThrowLastError();
+	}
+
+	file->m_data = static_cast<const std::uint8_t*>(MapViewOfFileFromApp(file->m_mapping, FILE_MAP_READ, 0, 0));
+	if (file->m_data == nullptr)
+	{
+		ThrowLastError();
+	}
+
+	return file;
+}
+
+#else
+
+namespace
+{
+	void ThrowErrno(const char* what)
+	{
+		throw std::system_error(errno, std::generic_category(), what);
+	}
+}
+
+MappedFile::MappedFile() :
+	m_data(nullptr),
+	m_size(0),
+	m_file(-1)
+{
+}
+
+MappedFile::~MappedFile()
+{
+	if (m_data != nullptr)
+	{
+		munmap(const_cast<std::uint8_t*>(m_data), m_size);
+	}
+	if (m_file != -1)
+	{
+		close(m_file);
+	}
+}
+
+std::shared_ptr<const MappedFile> MappedFile::Open(const MappedFilePath& path)
+{
+	std::shared_ptr<MappedFile> file(new MappedFile());
+
+	file->m_file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (file->m_file == -1)
+	{
+		ThrowErrno("open");
+	}
+
+	struct stat info;
+	if (fstat(file->m_file, &info) != 0)
+	{
+		ThrowErrno("fstat");
+	}
+	file->m_size = static_cast<std::size_t>(info.st_size);
+
+	// 크기가 0인 파일은 매핑할 수 없으므로 빈 보기로 둡니다.
+	if (file->m_size == 0)
+	{
+		return file;
+	}
+
+	void* data = mmap(nullptr, file->m_size, PROT_READ, MAP_PRIVATE, file->m_file, 0);
+	if (data == MAP_FAILED)
+	{
+		ThrowErrno("mmap");
+	}
+	file->m_data = static_cast<const std::uint8_t*>(data);
+
+	// 전체를 순차적으로 읽는 것이 일반적이므로 미리 읽기를 요청합니다.
+	madvise(data, file->m_size, MADV_SEQUENTIAL);
+	madvise(data, file->m_size, MADV_WILLNEED);
+
+	return file;
+}
+
+#endif
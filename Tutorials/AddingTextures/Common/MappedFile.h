@@ -0,0 +1,44 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace DX
+{
+#if defined(_WIN32)
+	typedef std::wstring MappedFilePath;
+#else
+	typedef std::string MappedFilePath;
+#endif
+
+	// 파일 전체의 읽기 전용 메모리 매핑입니다(Windows는 파일 매핑, 그 밖에는 mmap).
+	// 복사 없이 셰이더 바이트 코드나 업로드 경로에 직접 넘길 수 있으며, 마지막 shared_ptr가 해제될 때 매핑이 해제됩니다.
+	class MappedFile
+	{
+	public:
+		// 파일을 매핑합니다. 열거나 매핑하지 못하면 예외가 발생합니다.
+		static std::shared_ptr<const MappedFile> Open(const MappedFilePath& path);
+
+		~MappedFile();
+
+		const std::uint8_t* GetData() const	{ return m_data; }
+		std::size_t GetSize() const			{ return m_size; }
+
+	private:
+		MappedFile();
+		MappedFile(const MappedFile&);
+		MappedFile& operator=(const MappedFile&);
+
+		const std::uint8_t*	m_data;
+		std::size_t			m_size;
+
+#if defined(_WIN32)
+		HANDLE				m_file;
+		HANDLE				m_mapping;
+#else
+		int					m_file;
+#endif
+	};
+}
@@ -0,0 +1,583 @@
+﻿#include "pch.h"
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(_WIN32)
+#include "DirectXHelper.h"
+#else
+#include <stdexcept>
+#endif
+
+using namespace DX;
+
+namespace
+{
+	// Forsyth 점수 함수의 값입니다. 캐시는 LRU 32칸으로 보고, 마지막 삼각형의 세 꼭짓점은 같은 점수를 받습니다.
+	const std::uint32_t c_scoreCacheSize = 32;
+	const float c_lastTriangleScore = 0.75f;
+	const float c_cacheDecayPower = 1.5f;
+	const float c_valenceBoostScale = 2.0f;
+	const float c_valenceBoostPower = 0.5f;
+	const std::uint32_t c_maxScoredValence = 32;
+
+	const std::uint32_t c_unmapped = UINT32_MAX;
+
+	void ThrowInvalidArgument()
+	{
+#if defined(_WIN32)
+		DX::ThrowIfFailed(E_INVALIDARG);
+#else
+		throw std::invalid_argument("invalid mesh optimizer argument");
+#endif
+	}
+
+	// 삼각형 목록이고 모든 인덱스가 꼭짓점 범위 안에 있는지 확인합니다.
+	void ValidateIndices(const std::uint32_t* indices, std::size_t indexCount, std::size_t vertexCount)
+	{
+		if (indexCount % 3 != 0)
+		{
+			ThrowInvalidArgument();
+		}
+		for (std::size_t i = 0; i < indexCount; i++)
+		{
+			if (indices[i] >= vertexCount)
+			{
+				ThrowInvalidArgument();
+			}
+		}
+	}
+
+	// 시각으로 구현한 FIFO 캐시입니다. 꼭짓점이 들어온 시각이 현재 시각에서 size 이내이면 캐시에 있는 것입니다.
+	class FifoCache
+	{
+	public:
+		FifoCache(std::size_t vertexCount, std::uint32_t size) :
+			m_timestamps(vertexCount, 0),
+			m_time(size + 1),
+			m_size(size)
+		{
+		}
+
+		// 미스이면 꼭짓점을 넣고 1을 반환합니다.
+		std::uint32_t Touch(std::uint32_t vertex)
+		{
+			if (m_time - m_timestamps[vertex] > m_size)
+			{
+				m_timestamps[vertex] = m_time++;
+				return 1;
+			}
+			return 0;
+		}
+
+		std::uint32_t TouchTriangle(const std::uint32_t* triangle)
+		{
+			return Touch(triangle[0]) + Touch(triangle[1]) + Touch(triangle[2]);
+		}
+
+		void Flush()
+		{
+			m_time += m_size + 1;
+		}
+
+	private:
+		std::vector<std::uint32_t>	m_timestamps;
+		std::uint32_t				m_time;
+		std::uint32_t				m_size;
+	};
+
+	// 꼭짓점마다 그 꼭짓점을 쓰는 삼각형 목록입니다. 꼭짓점 v의 목록은 data[offsets[v], offsets[v] + counts[v])입니다.
+	struct TriangleAdjacency
+	{
+		std::vector<std::uint32_t>	counts;
+		std::vector<std::uint32_t>	offsets;
+		std::vector<std::uint32_t>	data;
+	};
+
+	void BuildAdjacency(const std::uint32_t* indices, std::size_t indexCount, std::size_t vertexCount, TriangleAdjacency* adjacency)
+	{
+		adjacency->counts.assign(vertexCount, 0);
+		adjacency->offsets.resize(vertexCount);
+		adjacency->data.resize(indexCount);
+
+		for (std::size_t i = 0; i < indexCount; i++)
+		{
+			adjacency->counts[indices[i]]++;
+		}
+
+		std::uint32_t offset = 0;
+		for (std::size_t v = 0; v < vertexCount; v++)
+		{
+			adjacency->offsets[v] = offset;
+			offset += adjacency->counts[v];
+		}
+
+		std::vector<std::uint32_t> fill(adjacency->offsets);
+		for (std::size_t i = 0; i < indexCount; i++)
+		{
+			adjacency->data[fill[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+		}
+	}
+
+	struct ScoreTables
+	{
+		ScoreTables()
+		{
+			for (std::uint32_t i = 0; i < c_scoreCacheSize; i++)
+			{
+				cache[i] = i < 3 ? c_lastTriangleScore : std::pow(1.0f - static_cast<float>(i - 3) / (c_scoreCacheSize - 3), c_cacheDecayPower);
+			}
+			valence[0] = 0.0f;
+			for (std::uint32_t i = 1; i < c_maxScoredValence; i++)
+			{
+				valence[i] = c_valenceBoostScale * std::pow(static_cast<float>(i), -c_valenceBoostPower);
+			}
+		}
+
+		// 남은 삼각형이 없으면 -1입니다. 그 꼭짓점은 다시 고를 일이 없습니다.
+		float Score(std::int32_t cachePosition, std::uint32_t liveTriangles) const
+		{
+			if (liveTriangles == 0)
+			{
+				return -1.0f;
+			}
+			const float cacheScore = cachePosition >= 0 ? cache[cachePosition] : 0.0f;
+			return cacheScore + valence[(std::min)(liveTriangles, c_maxScoredValence - 1)];
+		}
+
+		float cache[c_scoreCacheSize];
+		float valence[c_maxScoredValence];
+	};
+
+	inline void LoadPosition(const float* positions, std::size_t vertexStride, std::uint32_t vertex, float position[3])
+	{
+		memcpy(position, reinterpret_cast<const std::uint8_t*>(positions) + vertexStride * vertex, sizeof(float) * 3);
+	}
+
+	// 꼭짓점 바이트의 32비트 FNV-1a 해시입니다.
+	inline std::uint32_t HashVertex(const std::uint8_t* vertex, std::size_t vertexStride)
+	{
+		std::uint32_t hash = 2166136261u;
+		for (std::size_t i = 0; i < vertexStride; i++)
+		{
+			hash = (hash ^ vertex[i]) * 16777619u;
+		}
+		return hash;
+	}
+}
+
+VertexCacheStatistics DX::AnalyzeVertexCache(const std::uint32_t* indices, std::size_t indexCount, std::size_t vertexCount, std::uint32_t cacheSize)
+{
+	ValidateIndices(indices, indexCount, vertexCount);
+
+	FifoCache cache(vertexCount, cacheSize);
+	std::vector<bool> referenced(vertexCount, false);
+	std::uint32_t misses = 0;
+	std::uint32_t uniqueCount = 0;
+	for (std::size_t i = 0; i < indexCount; i++)
+	{
+		misses += cache.Touch(indices[i]);
+		if (!referenced[indices[i]])
+		{
+			referenced[indices[i]] = true;
+			uniqueCount++;
+		}
+	}
+
+	VertexCacheStatistics statistics;
+	statistics.transformedVertexCount = misses;
+	statistics.acmr = indexCount != 0 ? static_cast<float>(misses) / (indexCount / 3) : 0.0f;
+	statistics.atvr = uniqueCount != 0 ? static_cast<float>(misses) / uniqueCount : 0.0f;
+	return statistics;
+}
+
+std::uint32_t DX::GenerateVertexRemap(std::uint32_t* remap, const std::uint32_t* indices, std::size_t indexCount, const void* vertices, std::size_t vertexCount, std::size_t vertexStride)
+{
+	if (indices != nullptr)
+	{
+		ValidateIndices(indices, indexCount, vertexCount);
+	}
+
+	// 선형 탐사 해시 표에 먼저 나온 대표 꼭짓점을 넣습니다. 표는 꼭짓점 수의 두 배 이상인 2의 거듭제곱입니다.
+	std::size_t tableSize = 16;
+	while (tableSize < vertexCount * 2)
+	{
+		tableSize *= 2;
+	}
+	std::vector<std::uint32_t> table(tableSize, c_unmapped);
+	std::fill(remap, remap + vertexCount, c_unmapped);
+
+	const std::uint8_t* bytes = static_cast<const std::uint8_t*>(vertices);
+	std::uint32_t uniqueCount = 0;
+	auto add = [&](std::uint32_t vertex)
+	{
+		if (remap[vertex] != c_unmapped)
+		{
+			return;
+		}
+
+		const std::uint8_t* data = bytes + vertexStride * vertex;
+		std::size_t slot = HashVertex(data, vertexStride) & (tableSize - 1);
+		for (; table[slot] != c_unmapped; slot = (slot + 1) & (tableSize - 1))
+		{
+			if (memcmp(bytes + vertexStride * table[slot], data, vertexStride) == 0)
+			{
+				remap[vertex] = remap[table[slot]];
+				return;
+			}
+		}
+		table[slot] = vertex;
+		remap[vertex] = uniqueCount++;
+	};
+
+	if (indices != nullptr)
+	{
+		for (std::size_t i = 0; i < indexCount; i++)
+		{
+			add(indices[i]);
+		}
+	}
+	else
+	{
+		for (std::size_t v = 0; v < vertexCount; v++)
+		{
+			add(static_cast<std::uint32_t>(v));
+		}
+	}
+	return uniqueCount;
+}
+
+void DX::RemapIndices(std::uint32_t* destination, const std::uint32_t* indices, std::size_t indexCount, const std::uint32_t* remap)
+{
+	for (std::size_t i = 0; i < indexCount; i++)
+	{
+		destination[i] = remap[indices[i]];
+	}
+}
+
+void DX::RemapVertices(void* destination, const void* vertices, std::size_t vertexCount, std::size_t vertexStride, const std::uint32_t* remap)
+{
+	for (std::size_t v = 0; v < vertexCount; v++)
+	{
+		if (remap[v] != c_unmapped)
+		{
+			memcpy(static_cast<std::uint8_t*>(destination) + vertexStride * remap[v], static_cast<const std::uint8_t*>(vertices) + vertexStride * v, vertexStride);
+		}
+	}
+}
+
+void DX::OptimizeVertexCache(std::uint32_t* destination, const std::uint32_t* indices, std::size_t indexCount, std::size_t vertexCount)
+{
+	ValidateIndices(indices, indexCount, vertexCount);
+
+	// 제자리 최적화를 위해 입력을 복사합니다.
+	const std::vector<std::uint32_t> source(indices, indices + indexCount);
+	const std::size_t triangleCount = indexCount / 3;
+
+	TriangleAdjacency adjacency;
+	BuildAdjacency(source.data(), indexCount, vertexCount, &adjacency);
+
+	static const ScoreTables scores;
+	std::vector<std::int32_t> cachePositions(vertexCount, -1);
+	std::vector<float> vertexScores(vertexCount);
+	for (std::size_t v = 0; v < vertexCount; v++)
+	{
+		vertexScores[v] = scores.Score(-1, adjacency.counts[v]);
+	}
+
+	std::vector<float> triangleScores(triangleCount);
+	for (std::size_t t = 0; t < triangleCount; t++)
+	{
+		triangleScores[t] = vertexScores[source[t * 3]] + vertexScores[source[t * 3 + 1]] + vertexScores[source[t * 3 + 2]];
+	}
+
+	std::vector<bool> emitted(triangleCount, false);
+	std::uint32_t cache[c_scoreCacheSize + 3];
+	std::uint32_t cacheCount = 0;
+	std::size_t cursor = 0;
+	std::int64_t best = -1;
+
+	for (std::size_t output = 0; output < triangleCount; output++)
+	{
+		// 캐시에 이웃한 삼각형이 없으면 아직 내보내지 않은 다음 삼각형에서 다시 시작합니다.
+		if (best < 0)
+		{
+			while (emitted[cursor])
+			{
+				cursor++;
+			}
+			best = static_cast<std::int64_t>(cursor);
+		}
+
+		const std::uint32_t* triangle = &source[static_cast<std::size_t>(best) * 3];
+		destination[output * 3] = triangle[0];
+		destination[output * 3 + 1] = triangle[1];
+		destination[output * 3 + 2] = triangle[2];
+		emitted[static_cast<std::size_t>(best)] = true;
+
+		// 삼각형의 꼭짓점을 캐시 앞에 넣고 나머지를 뒤로 밉니다. c_scoreCacheSize를 넘는 항목은 밀려납니다.
+		std::uint32_t newCache[c_scoreCacheSize + 3];
+		std::uint32_t newCacheCount = 0;
+		for (int k = 0; k < 3; k++)
+		{
+			if (std::find(newCache, newCache + newCacheCount, triangle[k]) == newCache + newCacheCount)
+			{
+				newCache[newCacheCount++] = triangle[k];
+			}
+		}
+		for (std::uint32_t i = 0; i < cacheCount; i++)
+		{
+			if (cache[i] != triangle[0] && cache[i] != triangle[1] && cache[i] != triangle[2])
+			{
+				newCache[newCacheCount++] = cache[i];
+			}
+		}
+
+		// 내보낸 삼각형을 꼭짓점의 남은 삼각형 목록에서 뺍니다.
+		for (int k = 0; k < 3; k++)
+		{
+			std::uint32_t* list = &adjacency.data[adjacency.offsets[triangle[k]]];
+			std::uint32_t& count = adjacency.counts[triangle[k]];
+			for (std::uint32_t i = 0; i < count; i++)
+			{
+				if (list[i] == static_cast<std::uint32_t>(best))
+				{
+					list[i] = list[--count];
+					break;
+				}
+			}
+		}
+
+		for (std::uint32_t i = 0; i < newCacheCount; i++)
+		{
+			cachePositions[newCache[i]] = i < c_scoreCacheSize ? static_cast<std::int32_t>(i) : -1;
+		}
+
+		// 점수가 바뀐 꼭짓점의 차이를 이웃 삼각형 점수에 더하고, 캐시에 남은 꼭짓점의 이웃 중 가장 좋은 삼각형을 고릅니다.
+		for (std::uint32_t i = 0; i < newCacheCount; i++)
+		{
+			const std::uint32_t vertex = newCache[i];
+			const float score = scores.Score(cachePositions[vertex], adjacency.counts[vertex]);
+			const float difference = score - vertexScores[vertex];
+			vertexScores[vertex] = score;
+
+			const std::uint32_t* list = &adjacency.data[adjacency.offsets[vertex]];
+			for (std::uint32_t j = 0; j < adjacency.counts[vertex]; j++)
+			{
+				triangleScores[list[j]] += difference;
+			}
+		}
+
+		best = -1;
+		float bestScore = -1.0f;
+		cacheCount = (std::min)(newCacheCount, c_scoreCacheSize);
+		for (std::uint32_t i = 0; i < cacheCount; i++)
+		{
+			cache[i] = newCache[i];
+			const std::uint32_t* list = &adjacency.data[adjacency.offsets[cache[i]]];
+			for (std::uint32_t j = 0; j < adjacency.counts[cache[i]]; j++)
+			{
+				if (triangleScores[list[j]] > bestScore)
+				{
+					bestScore = triangleScores[list[j]];
+					best = list[j];
+				}
+			}
+		}
+	}
+}
+
+void DX::OptimizeOverdraw(std::uint32_t* destination, const std::uint32_t* indices, std::size_t indexCount, const float* positions, std::size_t vertexCount, std::size_t vertexStride, float threshold, std::uint32_t cacheSize)
+{
+	ValidateIndices(indices, indexCount, vertexCount);
+	const std::size_t triangleCount = indexCount / 3;
+	if (triangleCount < 2)
+	{
+		std::copy(indices, indices + indexCount, destination);
+		return;
+	}
+
+	// 세 꼭짓점이 모두 미스인 삼각형에서 캐시가 사실상 비워졌으므로, 그 지점을 단단한 경계로 삼습니다.
+	FifoCache cache(vertexCount, cacheSize);
+	std::vector<std::uint32_t> hardBoundaries;
+	for (std::size_t t = 0; t < triangleCount; t++)
+	{
+		if (cache.TouchTriangle(&indices[t * 3]) == 3 || t == 0)
+		{
+			hardBoundaries.push_back(static_cast<std::uint32_t>(t));
+		}
+	}
+	hardBoundaries.push_back(static_cast<std::uint32_t>(triangleCount));
+
+	// 단단한 클러스터 안에서, 캐시를 비우고 다시 시작해도 누적 ACMR이 클러스터 ACMR의 threshold배 이하인 지점마다 나눕니다.
+	std::vector<std::uint32_t> clusters;
+	for (std::size_t h = 0; h + 1 < hardBoundaries.size(); h++)
+	{
+		const std::uint32_t start = hardBoundaries[h];
+		const std::uint32_t end = hardBoundaries[h + 1];
+
+		cache.Flush();
+		std::uint32_t clusterMisses = 0;
+		for (std::uint32_t t = start; t < end; t++)
+		{
+			clusterMisses += cache.TouchTriangle(&indices[t * 3]);
+		}
+		const float clusterThreshold = threshold * clusterMisses / (end - start);
+
+		cache.Flush();
+		clusters.push_back(start);
+		std::uint32_t runningMisses = 0;
+		std::uint32_t runningTriangles = 0;
+		for (std::uint32_t t = start; t < end; t++)
+		{
+			runningMisses += cache.TouchTriangle(&indices[t * 3]);
+			runningTriangles++;
+			if (static_cast<float>(runningMisses) / runningTriangles <= clusterThreshold)
+			{
+				clusters.push_back(t + 1);
+				cache.Flush();
+				runningMisses = 0;
+				runningTriangles = 0;
+			}
+		}
+
+		// 마지막 삼각형에서 나누었으면 빈 클러스터가 남습니다.
+		if (clusters.back() == end)
+		{
+			clusters.pop_back();
+		}
+	}
+	const std::size_t clusterCount = clusters.size();
+	clusters.push_back(static_cast<std::uint32_t>(triangleCount));
+
+	// 클러스터의 면적 가중 중심과 평균 법선을 구하고, 메시 중심에서 법선 방향으로 멀수록(바깥을 향할수록) 먼저 그립니다.
+	std::vector<float> clusterData(clusterCount * 6, 0.0f);
+	float meshCentroid[3] = { 0.0f, 0.0f, 0.0f };
+	float meshArea = 0.0f;
+	for (std::size_t c = 0; c < clusterCount; c++)
+	{
+		float* centroid = &clusterData[c * 6];
+		float* normal = &clusterData[c * 6 + 3];
+		float clusterArea = 0.0f;
+		for (std::uint32_t t = clusters[c]; t < clusters[c + 1]; t++)
+		{
+			float p0[3], p1[3], p2[3];
+			LoadPosition(positions, vertexStride, indices[t * 3], p0);
+			LoadPosition(positions, vertexStride, indices[t * 3 + 1], p1);
+			LoadPosition(positions, vertexStride, indices[t * 3 + 2], p2);
+
+			const float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+			const float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+			const float cross[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+			const float area = std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+
+			for (int k = 0; k < 3; k++)
+			{
+				const float triangleCentroid = (p0[k] + p1[k] + p2[k]) / 3.0f;
+				centroid[k] += triangleCentroid * area;
+				meshCentroid[k] += triangleCentroid * area;
+				normal[k] += cross[k];
+			}
+			clusterArea += area;
+		}
+
+		meshArea += clusterArea;
+		for (int k = 0; k < 3; k++)
+		{
+			centroid[k] = clusterArea > 0.0f ? centroid[k] / clusterArea : 0.0f;
+		}
+	}
+	for (int k = 0; k < 3; k++)
+	{
+		meshCentroid[k] = meshArea > 0.0f ? meshCentroid[k] / meshArea : 0.0f;
+	}
+
+	std::vector<float> sortKeys(clusterCount);
+	std::vector<std::uint32_t> order(clusterCount);
+	for (std::size_t c = 0; c < clusterCount; c++)
+	{
+		const float* centroid = &clusterData[c * 6];
+		const float* normal = &clusterData[c * 6 + 3];
+		const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+		float key = 0.0f;
+		for (int k = 0; k < 3; k++)
+		{
+			key += (centroid[k] - meshCentroid[k]) * (length > 0.0f ? normal[k] / length : 0.0f);
+		}
+		sortKeys[c] = key;
+		order[c] = static_cast<std::uint32_t>(c);
+	}
+	std::stable_sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) { return sortKeys[a] > sortKeys[b]; });
+
+	std::size_t output = 0;
+	for (std::uint32_t c : order)
+	{
+		const std::size_t first = static_cast<std::size_t>(clusters[c]) * 3;
+		const std::size_t last = static_cast<std::size_t>(clusters[c + 1]) * 3;
+		std::copy(indices + first, indices + last, destination + output);
+		output += last - first;
+	}
+}
+
+std::uint32_t DX::OptimizeVertexFetch(void* destination, std::uint32_t* indices, std::size_t indexCount, const void* vertices, std::size_t vertexCount, std::size_t vertexStride)
+{
+	ValidateIndices(indices, indexCount, vertexCount);
+
+	std::vector<std::uint32_t> remap(vertexCount, c_unmapped);
+	std::uint32_t next = 0;
+	for (std::size_t i = 0; i < indexCount; i++)
+	{
+		std::uint32_t& mapped = remap[indices[i]];
+		if (mapped == c_unmapped)
+		{
+			memcpy(static_cast<std::uint8_t*>(destination) + vertexStride * next, static_cast<const std::uint8_t*>(vertices) + vertexStride * indices[i], vertexStride);
+			mapped = next++;
+		}
+		indices[i] = mapped;
+	}
+	return next;
+}
+
+MeshOptimizationReport DX::OptimizeMesh(
+	std::vector<std::uint32_t>* indices,
+	std::vector<std::uint8_t>* vertices,
+	std::size_t vertexStride,
+	std::size_t positionOffset,
+	const MeshOptimizationOptions& options)
+{
+	if (vertexStride == 0 || positionOffset + sizeof(float) * 3 > vertexStride || vertices->size() % vertexStride != 0)
+	{
+		ThrowInvalidArgument();
+	}
+
+	const std::size_t indexCount = indices->size();
+	const std::size_t vertexCount = vertices->size() / vertexStride;
+
+	MeshOptimizationReport report;
+	report.vertexCountBefore = static_cast<std::uint32_t>(vertexCount);
+	report.before = AnalyzeVertexCache(indices->data(), indexCount, vertexCount, options.cacheSize);
+
+	// 같은 꼭짓점을 합칩니다.
+	std::vector<std::uint32_t> remap(vertexCount);
+	const std::uint32_t uniqueCount = GenerateVertexRemap(remap.data(), indices->data(), indexCount, vertices->data(), vertexCount, vertexStride);
+	std::vector<std::uint32_t> welded(indexCount);
+	RemapIndices(welded.data(), indices->data(), indexCount, remap.data());
+	std::vector<std::uint8_t> weldedVertices(uniqueCount * vertexStride);
+	RemapVertices(weldedVertices.data(), vertices->data(), vertexCount, vertexStride, remap.data());
+
+	// 삼각형 순서를 캐시에 맞춘 다음, 캐시 효율을 크게 잃지 않는 범위에서 오버드로 순서로 클러스터를 정렬합니다.
+	OptimizeVertexCache(welded.data(), welded.data(), indexCount, uniqueCount);
+	const float* positions = reinterpret_cast<const float*>(weldedVertices.data() + positionOffset);
+	OptimizeOverdraw(indices->data(), welded.data(), indexCount, positions, uniqueCount, vertexStride, options.overdrawThreshold, options.cacheSize);
+
+	// 마지막으로 꼭짓점을 참조 순서로 옮깁니다.
+	vertices->resize(uniqueCount * vertexStride);
+	const std::uint32_t fetchedCount = OptimizeVertexFetch(vertices->data(), indices->data(), indexCount, weldedVertices.data(), uniqueCount, vertexStride);
+	vertices->resize(fetchedCount * vertexStride);
+
+	report.vertexCountAfter = fetchedCount;
+	report.after = AnalyzeVertexCache(indices->data(), indexCount, fetchedCount, options.cacheSize);
+	return report;
+}
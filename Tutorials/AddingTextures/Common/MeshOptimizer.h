@@ -0,0 +1,70 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace DX
+{
+	// 변환 후 꼭짓점 캐시를 FIFO로 흉내 낸 결과입니다.
+	// ACMR은 삼각형당 캐시 미스(0.5 ~ 3, 낮을수록 좋음), ATVR은 참조된 꼭짓점당 변환 횟수(1이 최적)입니다.
+	struct VertexCacheStatistics
+	{
+		std::uint32_t	transformedVertexCount;
+		float			acmr;
+		float			atvr;
+	};
+
+	struct MeshOptimizationOptions
+	{
+		MeshOptimizationOptions() :
+			overdrawThreshold(1.05f),
+			cacheSize(16)
+		{
+		}
+
+		float			overdrawThreshold;	// 오버드로 정렬을 위해 허용하는 ACMR 증가 비율입니다. 1이면 캐시 순서를 거의 유지합니다.
+		std::uint32_t	cacheSize;			// 통계와 클러스터 경계에 사용하는 FIFO 캐시 크기입니다.
+	};
+
+	struct MeshOptimizationReport
+	{
+		std::uint32_t			vertexCountBefore;
+		std::uint32_t			vertexCountAfter;
+		VertexCacheStatistics	before;
+		VertexCacheStatistics	after;
+	};
+
+	// 인덱스 목록(삼각형 목록)의 꼭짓점 캐시 효율을 계산합니다.
+	VertexCacheStatistics AnalyzeVertexCache(const std::uint32_t* indices, std::size_t indexCount, std::size_t vertexCount, std::uint32_t cacheSize = 16);
+
+	// 바이트가 같은 꼭짓점을 하나로 합치는 재배치 표를 만들고 고유 꼭짓점 수를 반환합니다.
+	// remap[v]는 새 번호이며, 번호는 인덱스 목록에서 처음 참조된 순서입니다. 참조되지 않은 꼭짓점은 UINT32_MAX입니다.
+	std::uint32_t GenerateVertexRemap(std::uint32_t* remap, const std::uint32_t* indices, std::size_t indexCount, const void* vertices, std::size_t vertexCount, std::size_t vertexStride);
+
+	// remap에 따라 인덱스와 꼭짓점을 옮깁니다. destination은 source와 겹치면 안 됩니다.
+	void RemapIndices(std::uint32_t* destination, const std::uint32_t* indices, std::size_t indexCount, const std::uint32_t* remap);
+	void RemapVertices(void* destination, const void* vertices, std::size_t vertexCount, std::size_t vertexStride, const std::uint32_t* remap);
+
+	// 변환 후 꼭짓점 캐시 적중이 많아지도록 삼각형 순서를 바꿉니다(Forsyth의 선형 속도 알고리즘, LRU 32 점수).
+	// 캐시 크기를 가정하지 않으므로 FIFO 하드웨어에서도 ACMR이 크게 줄어듭니다. destination은 indices와 같아도 됩니다.
+	void OptimizeVertexCache(std::uint32_t* destination, const std::uint32_t* indices, std::size_t indexCount, std::size_t vertexCount);
+
+	// 캐시 순서를 클러스터로 나누고, 바깥을 향하는 클러스터가 먼저 그려지도록 정렬하여 오버드로를 줄입니다(Sander 외, 2007).
+	// 클러스터 경계는 캐시가 비워지는 지점과, 클러스터 ACMR의 threshold배 안에서 캐시를 다시 시작할 수 있는 지점입니다.
+	// positions는 vertexStride 간격의 float3입니다. OptimizeVertexCache 결과에 적용합니다. destination은 indices와 겹치면 안 됩니다.
+	void OptimizeOverdraw(std::uint32_t* destination, const std::uint32_t* indices, std::size_t indexCount, const float* positions, std::size_t vertexCount, std::size_t vertexStride, float threshold, std::uint32_t cacheSize = 16);
+
+	// 꼭짓점을 인덱스에서 처음 참조되는 순서로 옮겨 꼭짓점 가져오기를 순차 접근에 가깝게 만들고, 인덱스를 그에 맞게 바꿉니다.
+	// 참조되지 않은 꼭짓점은 버리며 남은 꼭짓점 수를 반환합니다. destination은 vertices와 겹치면 안 됩니다.
+	std::uint32_t OptimizeVertexFetch(void* destination, std::uint32_t* indices, std::size_t indexCount, const void* vertices, std::size_t vertexCount, std::size_t vertexStride);
+
+	// 로드 또는 쿠킹 시 한 번에 적용하는 전체 단계입니다. 용접, 캐시 순서, 오버드로 순서, 가져오기 순서를 차례로 적용합니다.
+	// vertices는 vertexStride 간격의 꼭짓점 바이트이며, positionOffset 위치에 float3 위치가 있어야 합니다.
+	MeshOptimizationReport OptimizeMesh(
+		std::vector<std::uint32_t>* indices,
+		std::vector<std::uint8_t>* vertices,
+		std::size_t vertexStride,
+		std::size_t positionOffset,
+		const MeshOptimizationOptions& options = MeshOptimizationOptions());
+}
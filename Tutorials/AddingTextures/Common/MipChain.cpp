@@ -0,0 +1,707 @@
+﻿#include "pch.h"
+#include "MipChain.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "ParallelFor.h"
+
+#if defined(_WIN32)
+#include "DirectXHelper.h"
+#else
+#include <stdexcept>
+#endif
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <emmintrin.h>
+#define DX_MIP_CHAIN_SSE2
+#elif defined(_M_ARM) || defined(_M_ARM64) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DX_MIP_CHAIN_NEON
+#endif
+
+using namespace DX;
+
+namespace
+{
+	// 한 작업이 처리할 최소 바이트 수(부동 소수점 출력 기준)입니다. 이보다 작은 레벨은 호출 스레드에서 바로 처리합니다.
+	const std::size_t c_minBytesPerBlock = 256 * 1024;
+
+	// 창을 씌운 sinc 필터의 반경(원본을 축소 비율로 늘이기 전의 픽셀 단위)과 Kaiser 창의 모양 값입니다.
+	const double c_windowedSincRadius = 3.0;
+	const double c_kaiserAlpha = 4.0;
+
+	// 알파 커버리지를 맞출 때 알파에 곱할 수 있는 최대 배율입니다.
+	const float c_maxAlphaCoverageScale = 4.0f;
+
+	const double c_pi = 3.14159265358979323846;
+
+	void ThrowInvalidArgument()
+	{
+#if defined(_WIN32)
+		DX::ThrowIfFailed(E_INVALIDARG);
+#else
+		throw std::invalid_argument("invalid mip chain argument");
+#endif
+	}
+
+	// 한 축의 필터 탭입니다. 출력 i의 탭은 [first[i], first[i + 1]) 구간의 indices/weights이며, 가중치의 합은 1입니다.
+	struct AxisTaps
+	{
+		std::vector<std::uint32_t>	first;
+		std::vector<std::uint32_t>	indices;
+		std::vector<float>			weights;
+		std::uint32_t				maxTapCount;
+	};
+
+	// 부동 소수점 RGBA 레벨입니다. 색은 선형 공간이고 값은 [0, 1]로 고정되어 있습니다.
+	struct FloatLevel
+	{
+		std::uint32_t		width;
+		std::uint32_t		height;
+		std::vector<float>	pixels;
+	};
+
+	double Sinc(double x)
+	{
+		if (std::fabs(x) < 1e-9)
+		{
+			return 1.0;
+		}
+		x *= c_pi;
+		return std::sin(x) / x;
+	}
+
+	// 0차 변형 베셀 함수입니다.
+	double BesselI0(double x)
+	{
+		const double quarterSquare = x * x * 0.25;
+		double sum = 1.0;
+		double term = 1.0;
+		for (int k = 1; term > sum * 1e-12; k++)
+		{
+			term *= quarterSquare / (static_cast<double>(k) * k);
+			sum += term;
+		}
+		return sum;
+	}
+
+	// 원본 픽셀 단위로 늘이기 전의 필터 값입니다. 상자 필터는 면적으로 계산하므로 여기서 다루지 않습니다.
+	double EvaluateWindowedSinc(MipFilter filter, double x)
+	{
+		const double t = std::fabs(x) / c_windowedSincRadius;
+		if (t >= 1.0)
+		{
+			return 0.0;
+		}
+
+		if (filter == MipFilter::Kaiser)
+		{
+			return Sinc(x) * BesselI0(c_kaiserAlpha * std::sqrt(1.0 - t * t)) / BesselI0(c_kaiserAlpha);
+		}
+		return Sinc(x) * Sinc(x / c_windowedSincRadius);
+	}
+
+	std::uint32_t AddressPixel(std::int64_t position, std::uint32_t size, bool wrap)
+	{
+		if (wrap)
+		{
+			const std::int64_t wrapped = position % static_cast<std::int64_t>(size);
+			return static_cast<std::uint32_t>(wrapped < 0 ? wrapped + size : wrapped);
+		}
+		return static_cast<std::uint32_t>((std::min)((std::max)(position, static_cast<std::int64_t>(0)), static_cast<std::int64_t>(size) - 1));
+	}
+
+	// sourceSize 픽셀을 destinationSize 픽셀로 줄이는 탭을 만듭니다. 출력 픽셀은 원본에서 scale 픽셀 폭을 덮으며,
+	// 상자 필터는 그 폭과 겹치는 면적을, 그 밖의 필터는 축소 비율만큼 늘인 커널 값을 가중치로 씁니다.
+	void BuildAxisTaps(std::uint32_t sourceSize, std::uint32_t destinationSize, MipFilter filter, bool wrap, AxisTaps* taps)
+	{
+		const double scale = static_cast<double>(sourceSize) / destinationSize;
+		const double support = (filter == MipFilter::Box ? 0.5 : c_windowedSincRadius) * scale;
+
+		taps->first.assign(1, 0);
+		taps->indices.clear();
+		taps->weights.clear();
+		taps->maxTapCount = 0;
+
+		std::vector<double> weights;
+		for (std::uint32_t i = 0; i < destinationSize; i++)
+		{
+			const double center = (i + 0.5) * scale;
+			const std::int64_t begin = static_cast<std::int64_t>(std::floor(center - support));
+			const std::int64_t end = static_cast<std::int64_t>(std::ceil(center + support));
+			const std::size_t tapBegin = taps->indices.size();
+
+			weights.clear();
+			double sum = 0.0;
+			for (std::int64_t s = begin; s < end; s++)
+			{
+				double weight;
+				if (filter == MipFilter::Box)
+				{
+					weight = (std::min)(s + 1.0, center + support) - (std::max)(static_cast<double>(s), center - support);
+				}
+				else
+				{
+					weight = EvaluateWindowedSinc(filter, (s + 0.5 - center) / scale);
+				}
+				if (weight == 0.0)
+				{
+					continue;
+				}
+
+				// 가장자리를 고정하거나 둘러싸면 같은 원본 픽셀이 여러 번 나오므로 가중치를 합칩니다.
+				const std::uint32_t index = AddressPixel(s, sourceSize, wrap);
+				std::size_t tap = tapBegin;
+				while (tap < taps->indices.size() && taps->indices[tap] != index)
+				{
+					tap++;
+				}
+				if (tap == taps->indices.size())
+				{
+					taps->indices.push_back(index);
+					weights.push_back(0.0);
+				}
+				weights[tap - tapBegin] += weight;
+				sum += weight;
+			}
+
+			for (double weight : weights)
+			{
+				taps->weights.push_back(static_cast<float>(weight / sum));
+			}
+			taps->first.push_back(static_cast<std::uint32_t>(taps->indices.size()));
+			taps->maxTapCount = (std::max)(taps->maxTapCount, static_cast<std::uint32_t>(taps->indices.size() - tapBegin));
+		}
+	}
+
+	// 커널입니다. 가로 필터는 한 픽셀의 네 채널을, 세로 필터는 행의 연속된 네 값을 한 벡터로 처리합니다.
+
+	void FilterRowHorizontal(const float* source, const AxisTaps& taps, std::uint32_t width, float* destination)
+	{
+		for (std::uint32_t x = 0; x < width; x++)
+		{
+			const std::uint32_t begin = taps.first[x];
+			const std::uint32_t end = taps.first[x + 1];
+#if defined(DX_MIP_CHAIN_SSE2)
+			__m128 sum = _mm_setzero_ps();
+			for (std::uint32_t t = begin; t < end; t++)
+			{
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(source + taps.indices[t] * 4), _mm_set1_ps(taps.weights[t])));
+			}
+			_mm_storeu_ps(destination + x * 4, sum);
+#elif defined(DX_MIP_CHAIN_NEON)
+			float32x4_t sum = vdupq_n_f32(0.0f);
+			for (std::uint32_t t = begin; t < end; t++)
+			{
+				sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(source + taps.indices[t] * 4), taps.weights[t]));
+			}
+			vst1q_f32(destination + x * 4, sum);
+#else
+			float sum[4] = {};
+			for (std::uint32_t t = begin; t < end; t++)
+			{
+				for (std::uint32_t c = 0; c < 4; c++)
+				{
+					sum[c] += source[taps.indices[t] * 4 + c] * taps.weights[t];
+				}
+			}
+			memcpy(destination + x * 4, sum, sizeof(sum));
+#endif
+		}
+	}
+
+	// destination[i] = clamp(sum(rows[t][i] * weights[t]), 0, 1)입니다.
+	void FilterRowVertical(const float* const* rows, const float* weights, std::uint32_t tapCount, std::uint32_t count, float* destination)
+	{
+		std::uint32_t i = 0;
+#if defined(DX_MIP_CHAIN_SSE2)
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 sum = zero;
+			for (std::uint32_t t = 0; t < tapCount; t++)
+			{
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(rows[t] + i), _mm_set1_ps(weights[t])));
+			}
+			_mm_storeu_ps(destination + i, _mm_min_ps(_mm_max_ps(sum, zero), one));
+		}
+#elif defined(DX_MIP_CHAIN_NEON)
+		const float32x4_t zero = vdupq_n_f32(0.0f);
+		const float32x4_t one = vdupq_n_f32(1.0f);
+		for (; i + 4 <= count; i += 4)
+		{
+			float32x4_t sum = zero;
+			for (std::uint32_t t = 0; t < tapCount; t++)
+			{
+				sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(rows[t] + i), weights[t]));
+			}
+			vst1q_f32(destination + i, vminq_f32(vmaxq_f32(sum, zero), one));
+		}
+#endif
+		for (; i < count; i++)
+		{
+			float sum = 0.0f;
+			for (std::uint32_t t = 0; t < tapCount; t++)
+			{
+				sum += rows[t][i] * weights[t];
+			}
+			destination[i] = (std::min)((std::max)(sum, 0.0f), 1.0f);
+		}
+	}
+
+	// 선형 상자 필터의 고정 소수점 경로입니다. 값은 8비트 값에 256을 곱한 16비트이므로 레벨을 거듭해도 반올림 오차가 1/256 단위로만 쌓입니다.
+	// 평균은 올림하는 반 더하기(SSE2 pavgw, NEON vrhadd)를 세로, 가로 순서로 하며 스칼라 경로도 같은 순서로 계산합니다.
+
+	struct FixedLevel
+	{
+		std::uint32_t				width;
+		std::uint32_t				height;
+		std::vector<std::uint16_t>	pixels;
+	};
+
+	std::uint16_t ToFixed(std::uint8_t value)	{ return static_cast<std::uint16_t>(value << 8); }
+	std::uint16_t ToFixed(std::uint16_t value)	{ return value; }
+
+#if defined(DX_MIP_CHAIN_SSE2)
+	// 원본 픽셀 네 개를 두 벡터(픽셀 0-1, 2-3)의 고정 소수점 값으로 읽습니다.
+	void LoadFourPixels(const std::uint8_t* source, __m128i* low, __m128i* high)
+	{
+		const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+		*low = _mm_unpacklo_epi8(_mm_setzero_si128(), bytes);
+		*high = _mm_unpackhi_epi8(_mm_setzero_si128(), bytes);
+	}
+
+	void LoadFourPixels(const std::uint16_t* source, __m128i* low, __m128i* high)
+	{
+		*low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+		*high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 8));
+	}
+#elif defined(DX_MIP_CHAIN_NEON)
+	void LoadFourPixels(const std::uint8_t* source, uint16x8_t* low, uint16x8_t* high)
+	{
+		const uint8x16_t bytes = vld1q_u8(source);
+		*low = vshll_n_u8(vget_low_u8(bytes), 8);
+		*high = vshll_n_u8(vget_high_u8(bytes), 8);
+	}
+
+	void LoadFourPixels(const std::uint16_t* source, uint16x8_t* low, uint16x8_t* high)
+	{
+		*low = vld1q_u16(source);
+		*high = vld1q_u16(source + 8);
+	}
+#endif
+
+	// 원본 두 행(row0, row1)의 2x2 구역을 평균하여 width개의 고정 소수점 픽셀을 씁니다.
+	template<typename TSource>
+	void BoxFilterRow(const TSource* row0, const TSource* row1, std::uint32_t width, std::uint16_t* destination)
+	{
+		std::uint32_t x = 0;
+#if defined(DX_MIP_CHAIN_SSE2)
+		for (; x + 2 <= width; x += 2)
+		{
+			__m128i top0, top1, bottom0, bottom1;
+			LoadFourPixels(row0 + x * 8, &top0, &top1);
+			LoadFourPixels(row1 + x * 8, &bottom0, &bottom1);
+			const __m128i vertical0 = _mm_avg_epu16(top0, bottom0);
+			const __m128i vertical1 = _mm_avg_epu16(top1, bottom1);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + x * 4), _mm_avg_epu16(_mm_unpacklo_epi64(vertical0, vertical1), _mm_unpackhi_epi64(vertical0, vertical1)));
+		}
+#elif defined(DX_MIP_CHAIN_NEON)
+		for (; x + 2 <= width; x += 2)
+		{
+			uint16x8_t top0, top1, bottom0, bottom1;
+			LoadFourPixels(row0 + x * 8, &top0, &top1);
+			LoadFourPixels(row1 + x * 8, &bottom0, &bottom1);
+			const uint16x8_t vertical0 = vrhaddq_u16(top0, bottom0);
+			const uint16x8_t vertical1 = vrhaddq_u16(top1, bottom1);
+			const uint16x8_t left = vcombine_u16(vget_low_u16(vertical0), vget_low_u16(vertical1));
+			const uint16x8_t right = vcombine_u16(vget_high_u16(vertical0), vget_high_u16(vertical1));
+			vst1q_u16(destination + x * 4, vrhaddq_u16(left, right));
+		}
+#endif
+		for (; x < width; x++)
+		{
+			for (std::uint32_t c = 0; c < 4; c++)
+			{
+				const std::uint32_t left = (ToFixed(row0[x * 8 + c]) + ToFixed(row1[x * 8 + c]) + 1) >> 1;
+				const std::uint32_t right = (ToFixed(row0[x * 8 + 4 + c]) + ToFixed(row1[x * 8 + 4 + c]) + 1) >> 1;
+				destination[x * 4 + c] = static_cast<std::uint16_t>((left + right + 1) >> 1);
+			}
+		}
+	}
+
+	// 고정 소수점 값을 가장 가까운 8비트 값으로 반올림합니다. 최댓값은 255 * 256이므로 128을 더해도 넘치지 않습니다.
+	void EncodeFixedRow(const std::uint16_t* values, std::uint32_t count, std::uint8_t* destination)
+	{
+		std::uint32_t i = 0;
+#if defined(DX_MIP_CHAIN_SSE2)
+		const __m128i half = _mm_set1_epi16(128);
+		for (; i + 16 <= count; i += 16)
+		{
+			const __m128i low = _mm_srli_epi16(_mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)), half), 8);
+			const __m128i high = _mm_srli_epi16(_mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i + 8)), half), 8);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packus_epi16(low, high));
+		}
+#elif defined(DX_MIP_CHAIN_NEON)
+		for (; i + 16 <= count; i += 16)
+		{
+			vst1q_u8(destination + i, vcombine_u8(vrshrn_n_u16(vld1q_u16(values + i), 8), vrshrn_n_u16(vld1q_u16(values + i + 8), 8)));
+		}
+#endif
+		for (; i < count; i++)
+		{
+			destination[i] = static_cast<std::uint8_t>((values[i] + 128) >> 8);
+		}
+	}
+
+	// 인코딩 표의 구간 수입니다. 구간 폭(1/4096)이 sRGB 반올림 경계의 최소 간격(약 1/3295)보다 좁으므로 한 구간에는 경계가 하나 이하입니다.
+	const std::uint32_t c_encodeBucketCount = 4096;
+
+	// 8비트 값을 부동 소수점 값으로 바꾸는 표와 그 반대 방향의 반올림 경계입니다.
+	struct ChannelCodec
+	{
+		explicit ChannelCodec(bool srgb)
+		{
+			for (std::uint32_t i = 0; i < 256; i++)
+			{
+				decode[i] = ToLinear(i / 255.0, srgb);
+			}
+			// 8비트 값 i와 i + 1의 경계는 인코딩된 공간에서의 중간값이므로 반올림이 인코딩된 공간에서 정확합니다.
+			for (std::uint32_t i = 0; i < 255; i++)
+			{
+				thresholds[i] = ToLinear((i + 0.5) / 255.0, srgb);
+			}
+			for (std::uint32_t i = 0; i < c_encodeBucketCount; i++)
+			{
+				const float bucketStart = static_cast<float>(i) / c_encodeBucketCount;
+				buckets[i] = static_cast<std::uint8_t>(std::upper_bound(thresholds, thresholds + 255, bucketStart) - thresholds);
+			}
+		}
+
+		// 값 이하인 경계의 수, 즉 인코딩된 공간에서 반올림한 8비트 값입니다. 구간 표로 시작 값을 찾고 경계 하나만 비교합니다.
+		std::uint8_t Encode(float value) const
+		{
+			const float position = (std::min)((std::max)(value, 0.0f), 1.0f) * c_encodeBucketCount;
+			const std::uint32_t bucket = (std::min)(static_cast<std::uint32_t>(position), c_encodeBucketCount - 1);
+			std::uint32_t encoded = buckets[bucket];
+			if (encoded < 255 && value >= thresholds[encoded])
+			{
+				encoded++;
+			}
+			return static_cast<std::uint8_t>(encoded);
+		}
+
+		static float ToLinear(double value, bool srgb)
+		{
+			if (!srgb)
+			{
+				return static_cast<float>(value);
+			}
+			return static_cast<float>(value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4));
+		}
+
+		float			decode[256];
+		float			thresholds[255];
+		std::uint8_t	buckets[c_encodeBucketCount];
+	};
+
+	// 세로 탭이 가리키는 원본 행을 가로로 필터링한 결과를 보관합니다. 한 작업 안에서 출력 행은 차례로 진행하므로
+	// 가장 오래 쓰지 않은 슬롯을 교체하면 원본 행마다 가로 필터를 한 번만 실행합니다.
+	class HorizontalRowCache
+	{
+	public:
+		HorizontalRowCache(std::uint32_t slotCount, std::uint32_t rowSize) :
+			m_rowSize(rowSize),
+			m_storage(static_cast<std::size_t>(slotCount) * rowSize),
+			m_rows(slotCount, -1),
+			m_lastUse(slotCount, 0),
+			m_clock(0)
+		{
+		}
+
+		template<typename TFilterRow>
+		const float* GetRow(std::uint32_t row, const TFilterRow& filterRow)
+		{
+			m_clock++;
+			std::size_t victim = 0;
+			for (std::size_t slot = 0; slot < m_rows.size(); slot++)
+			{
+				if (m_rows[slot] == static_cast<std::int64_t>(row))
+				{
+					m_lastUse[slot] = m_clock;
+					return &m_storage[slot * m_rowSize];
+				}
+				if (m_lastUse[slot] < m_lastUse[victim])
+				{
+					victim = slot;
+				}
+			}
+
+			float* destination = &m_storage[victim * m_rowSize];
+			filterRow(row, destination);
+			m_rows[victim] = row;
+			m_lastUse[victim] = m_clock;
+			return destination;
+		}
+
+	private:
+		std::size_t					m_rowSize;
+		std::vector<float>			m_storage;
+		std::vector<std::int64_t>	m_rows;
+		std::vector<std::uint64_t>	m_lastUse;
+		std::uint64_t				m_clock;
+	};
+
+	// reference를 넘는 알파의 비율이 coverage가 되도록 알파에 곱할 배율을 구합니다.
+	// 배율 s에서 alpha * s > reference인 픽셀은 alpha > reference / s인 픽셀이므로, 알파의 분위수에서 배율을 바로 얻습니다.
+	float ComputeAlphaScale(const FloatLevel& level, float reference, double coverage)
+	{
+		const std::size_t pixelCount = static_cast<std::size_t>(level.width) * level.height;
+		std::vector<float> alphas(pixelCount);
+		for (std::size_t i = 0; i < pixelCount; i++)
+		{
+			alphas[i] = level.pixels[i * 4 + 3];
+		}
+
+		const std::size_t passCount = (std::min)(static_cast<std::size_t>(coverage * pixelCount + 0.5), pixelCount);
+		float scale;
+		if (passCount == 0)
+		{
+			// 통과하는 픽셀이 없어야 하므로 가장 큰 알파를 기준값에 맞춥니다.
+			const float maximum = *std::max_element(alphas.begin(), alphas.end());
+			scale = maximum > reference ? reference / maximum : 1.0f;
+		}
+		else
+		{
+			// 통과해야 하는 픽셀 중 가장 작은 알파가 기준값을 조금 넘도록 합니다.
+			auto threshold = alphas.begin() + (pixelCount - passCount);
+			std::nth_element(alphas.begin(), threshold, alphas.end());
+			scale = *threshold > 0.0f ? reference / *threshold * 1.0001f : c_maxAlphaCoverageScale;
+		}
+		return (std::min)(scale, c_maxAlphaCoverageScale);
+	}
+}
+
+std::uint32_t DX::GetMipLevelCount(std::uint32_t width, std::uint32_t height)
+{
+	std::uint32_t count = 1;
+	while (width > 1 || height > 1)
+	{
+		width = (std::max)(width / 2, 1u);
+		height = (std::max)(height / 2, 1u);
+		count++;
+	}
+	return count;
+}
+
+MipChain::MipChain(const std::uint8_t* source, std::uint32_t width, std::uint32_t height, std::size_t rowPitch, const MipGenerationOptions& options)
+{
+	if (source == nullptr || width == 0 || height == 0 || rowPitch < static_cast<std::size_t>(width) * 4 ||
+		options.alphaCoverageReference < 0.0f || options.alphaCoverageReference >= 1.0f)
+	{
+		ThrowInvalidArgument();
+	}
+
+	std::uint32_t levelCount = GetMipLevelCount(width, height);
+	if (options.maxLevelCount != 0)
+	{
+		levelCount = (std::min)(levelCount, options.maxLevelCount);
+	}
+
+	// 모든 레벨을 빽빽한 행으로 하나의 버퍼에 배치합니다.
+	std::size_t totalSize = 0;
+	for (std::uint32_t level = 0; level < levelCount; level++)
+	{
+		MipLevel mip;
+		mip.data = nullptr;
+		mip.width = (std::max)(width >> level, 1u);
+		mip.height = (std::max)(height >> level, 1u);
+		mip.rowPitch = static_cast<std::size_t>(mip.width) * 4;
+		mip.slicePitch = mip.rowPitch * mip.height;
+		m_levels.push_back(mip);
+		totalSize += mip.slicePitch;
+	}
+
+	m_data.resize(totalSize);
+	std::size_t offset = 0;
+	for (auto& mip : m_levels)
+	{
+		mip.data = &m_data[offset];
+		offset += mip.slicePitch;
+	}
+
+	for (std::uint32_t y = 0; y < height; y++)
+	{
+		memcpy(&m_data[m_levels[0].rowPitch * y], source + rowPitch * y, m_levels[0].rowPitch);
+	}
+
+	if (levelCount == 1)
+	{
+		return;
+	}
+
+	const ChannelCodec colorCodec(options.srgb);
+	const ChannelCodec alphaCodec(false);
+
+	const bool preserveCoverage = options.alphaCoverageReference > 0.0f;
+	double referenceCoverage = 0.0;
+	if (preserveCoverage)
+	{
+		std::size_t passCount = 0;
+		for (std::size_t i = 3; i < m_levels[0].slicePitch; i += 4)
+		{
+			passCount += alphaCodec.decode[m_data[i]] > options.alphaCoverageReference ? 1 : 0;
+		}
+		referenceCoverage = static_cast<double>(passCount) / (static_cast<std::size_t>(width) * height);
+	}
+
+	// 1레벨은 8비트 0레벨을 행마다 디코딩하여 필터링하고, 그 다음 레벨부터는 바로 위 레벨의 부동 소수점 결과를 필터링합니다.
+	FloatLevel previous;
+	FloatLevel current;
+	AxisTaps horizontalTaps;
+	AxisTaps verticalTaps;
+
+	// 고정 소수점 상자 필터는 0레벨부터 연속된 2:1 레벨에만 씁니다. 처음으로 2:1이 아닌 레벨에서 부동 소수점 경로로 넘어갑니다.
+	const bool fixedPointBox = options.fixedPointBox && options.filter == MipFilter::Box && !options.srgb && !preserveCoverage;
+	FixedLevel previousFixed;
+	FixedLevel currentFixed;
+	bool previousIsFixed = false;
+
+	for (std::uint32_t level = 1; level < levelCount; level++)
+	{
+		const MipLevel& sourceMip = m_levels[level - 1];
+		const MipLevel& mip = m_levels[level];
+		const bool fromBytes = level == 1;
+		const std::uint32_t rowSize = mip.width * 4;
+		std::uint8_t* destination = &m_data[mip.data - m_data.data()];
+
+		if (fixedPointBox && (fromBytes || previousIsFixed) && sourceMip.width == mip.width * 2 && sourceMip.height == mip.height * 2)
+		{
+			currentFixed.width = mip.width;
+			currentFixed.height = mip.height;
+			currentFixed.pixels.resize(static_cast<std::size_t>(mip.width) * mip.height * 4);
+
+			ParallelForRowBlocks(mip.height, rowSize * sizeof(std::uint16_t), c_minBytesPerBlock, [&](std::uint32_t begin, std::uint32_t end)
+			{
+				for (std::uint32_t y = begin; y < end; y++)
+				{
+					std::uint16_t* values = &currentFixed.pixels[static_cast<std::size_t>(y) * rowSize];
+					if (fromBytes)
+					{
+						const std::uint8_t* row0 = sourceMip.data + sourceMip.rowPitch * (y * 2);
+						BoxFilterRow(row0, row0 + sourceMip.rowPitch, mip.width, values);
+					}
+					else
+					{
+						const std::uint16_t* row0 = &previousFixed.pixels[static_cast<std::size_t>(y * 2) * sourceMip.width * 4];
+						BoxFilterRow(row0, row0 + sourceMip.width * 4, mip.width, values);
+					}
+					EncodeFixedRow(values, rowSize, destination + mip.rowPitch * y);
+				}
+			});
+
+			std::swap(previousFixed, currentFixed);
+			previousIsFixed = true;
+			continue;
+		}
+
+		// 위 레벨이 고정 소수점이면 부동 소수점으로 바꾸어 이어서 필터링합니다.
+		if (previousIsFixed)
+		{
+			previous.width = previousFixed.width;
+			previous.height = previousFixed.height;
+			previous.pixels.resize(previousFixed.pixels.size());
+			for (std::size_t i = 0; i < previousFixed.pixels.size(); i++)
+			{
+				previous.pixels[i] = previousFixed.pixels[i] * (1.0f / (255.0f * 256.0f));
+			}
+			previousIsFixed = false;
+		}
+
+		BuildAxisTaps(sourceMip.width, mip.width, options.filter, options.wrap, &horizontalTaps);
+		BuildAxisTaps(sourceMip.height, mip.height, options.filter, options.wrap, &verticalTaps);
+
+		current.width = mip.width;
+		current.height = mip.height;
+		current.pixels.resize(static_cast<std::size_t>(mip.width) * mip.height * 4);
+
+		ParallelForRowBlocks(mip.height, rowSize * sizeof(float), c_minBytesPerBlock, [&](std::uint32_t begin, std::uint32_t end)
+		{
+			HorizontalRowCache cache(verticalTaps.maxTapCount + 1, rowSize);
+			std::vector<float> decodedRow(fromBytes ? static_cast<std::size_t>(sourceMip.width) * 4 : 0);
+			std::vector<const float*> rows(verticalTaps.maxTapCount);
+
+			auto filterRow = [&](std::uint32_t row, float* destination)
+			{
+				const float* sourceRow;
+				if (fromBytes)
+				{
+					const std::uint8_t* bytes = sourceMip.data + sourceMip.rowPitch * row;
+					for (std::uint32_t i = 0; i < sourceMip.width * 4; i += 4)
+					{
+						decodedRow[i + 0] = colorCodec.decode[bytes[i + 0]];
+						decodedRow[i + 1] = colorCodec.decode[bytes[i + 1]];
+						decodedRow[i + 2] = colorCodec.decode[bytes[i + 2]];
+						decodedRow[i + 3] = alphaCodec.decode[bytes[i + 3]];
+					}
+					sourceRow = decodedRow.data();
+				}
+				else
+				{
+					sourceRow = &previous.pixels[static_cast<std::size_t>(row) * previous.width * 4];
+				}
+				FilterRowHorizontal(sourceRow, horizontalTaps, mip.width, destination);
+			};
+
+			for (std::uint32_t y = begin; y < end; y++)
+			{
+				const std::uint32_t tapBegin = verticalTaps.first[y];
+				const std::uint32_t tapCount = verticalTaps.first[y + 1] - tapBegin;
+				for (std::uint32_t t = 0; t < tapCount; t++)
+				{
+					rows[t] = cache.GetRow(verticalTaps.indices[tapBegin + t], filterRow);
+				}
+				FilterRowVertical(rows.data(), &verticalTaps.weights[tapBegin], tapCount, rowSize, &current.pixels[static_cast<std::size_t>(y) * rowSize]);
+			}
+		});
+
+		// 커버리지 배율은 인코딩에만 적용하고, 다음 레벨은 배율을 적용하지 않은 알파에서 필터링합니다.
+		const float alphaScale = preserveCoverage ? ComputeAlphaScale(current, options.alphaCoverageReference, referenceCoverage) : 1.0f;
+
+		ParallelForRowBlocks(mip.height, rowSize * sizeof(float), c_minBytesPerBlock, [&](std::uint32_t begin, std::uint32_t end)
+		{
+			for (std::uint32_t y = begin; y < end; y++)
+			{
+				const float* values = &current.pixels[static_cast<std::size_t>(y) * rowSize];
+				std::uint8_t* bytes = destination + mip.rowPitch * y;
+				for (std::uint32_t i = 0; i < rowSize; i += 4)
+				{
+					bytes[i + 0] = colorCodec.Encode(values[i + 0]);
+					bytes[i + 1] = colorCodec.Encode(values[i + 1]);
+					bytes[i + 2] = colorCodec.Encode(values[i + 2]);
+					bytes[i + 3] = alphaCodec.Encode(values[i + 3] * alphaScale);
+				}
+			}
+		});
+
+		std::swap(previous, current);
+	}
+}
+
+#if defined(_WIN32)
+std::vector<D3D12_SUBRESOURCE_DATA> MipChain::GetSubresourceData() const
+{
+	std::vector<D3D12_SUBRESOURCE_DATA> subresources;
+	for (const auto& mip : m_levels)
+	{
+		D3D12_SUBRESOURCE_DATA data = {};
+		data.pData = mip.data;
+		data.RowPitch = static_cast<LONG_PTR>(mip.rowPitch);
+		data.SlicePitch = static_cast<LONG_PTR>(mip.slicePitch);
+		subresources.push_back(data);
+	}
+	return subresources;
+}
+#endif
@@ -0,0 +1,74 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace DX
+{
+	enum class MipFilter
+	{
+		Box,		// 2x2 평균입니다. 가장 빠르지만 축소한 레벨이 약간 흐리고 앨리어싱이 남습니다.
+		Kaiser,		// Kaiser 창(alpha 4)을 씌운 반경 3의 sinc입니다. 선명하고 앨리어싱이 적습니다.
+		Lanczos,	// Lanczos3입니다. Kaiser와 비슷하지만 가장자리의 링잉이 조금 더 큽니다.
+	};
+
+	struct MipGenerationOptions
+	{
+		MipGenerationOptions() :
+			filter(MipFilter::Box),
+			srgb(true),
+			wrap(false),
+			alphaCoverageReference(0.0f),
+			maxLevelCount(0),
+			fixedPointBox(true)
+		{
+		}
+
+		MipFilter		filter;
+		bool			srgb;					// 색 채널을 선형 공간에서 필터링하고 sRGB로 다시 인코딩합니다. 알파는 항상 선형입니다.
+		bool			wrap;					// 가장자리 바깥을 반대쪽 픽셀로 채웁니다(WRAP 샘플러용). false이면 가장자리 픽셀을 반복합니다.
+		float			alphaCoverageReference;	// 0보다 크면 알파 테스트 기준값으로 보고, 기준을 넘는 픽셀 비율을 레벨마다 0레벨과 같게 유지합니다.
+		std::uint32_t	maxLevelCount;			// 0이면 1x1까지 전체 체인을 만듭니다.
+		bool			fixedPointBox;			// 선형 상자 필터로 정확히 2:1로 줄이는 레벨을 16비트 고정 소수점으로 평균합니다. false이면 부동 소수점 경로를 씁니다.
+	};
+
+	// 체인의 한 레벨입니다. data는 MipChain이 소유합니다.
+	struct MipLevel
+	{
+		const std::uint8_t*	data;
+		std::uint32_t		width;
+		std::uint32_t		height;
+		std::size_t			rowPitch;
+		std::size_t			slicePitch;
+	};
+
+	// width x height 텍스처의 1x1까지의 밉 레벨 수입니다.
+	std::uint32_t GetMipLevelCount(std::uint32_t width, std::uint32_t height);
+
+	// RGBA8 원본에서 밉 체인을 만듭니다. 0레벨은 원본의 복사본이며, 모든 레벨은 하나의 연속 버퍼에 빽빽한 행으로 저장됩니다.
+	// 각 레벨은 바로 위 레벨의 부동 소수점 결과에서 분리형 필터로 축소하므로 8비트 양자화 오차가 누적되지 않습니다.
+	// 레벨 안의 행은 여러 스레드에서 필터링하고 인코딩하며, 필터 커널은 SSE2/NEON으로 한 픽셀(4채널)씩 처리합니다.
+	// 선형 상자 필터로 정확히 2:1로 줄이는 레벨은 탭 없이 8비트 값에 256을 곱한 16비트 값을 바로 평균하며, 결과는 부동 소수점 경로와 최대 1만큼 다릅니다.
+	class MipChain
+	{
+	public:
+		MipChain(const std::uint8_t* source, std::uint32_t width, std::uint32_t height, std::size_t rowPitch, const MipGenerationOptions& options = MipGenerationOptions());
+
+		std::uint32_t GetLevelCount() const					{ return static_cast<std::uint32_t>(m_levels.size()); }
+		const MipLevel& GetLevel(std::uint32_t level) const	{ return m_levels[level]; }
+
+#if defined(_WIN32)
+		// UpdateSubresources(commandList, texture, upload, 0, 0, GetLevelCount(), data) 한 번으로 체인 전체를 올릴 수 있는 하위 리소스 배열입니다.
+		std::vector<D3D12_SUBRESOURCE_DATA> GetSubresourceData() const;
+#endif
+
+	private:
+		// 레벨이 m_data를 가리키므로 복사할 수 없습니다.
+		MipChain(const MipChain&);
+		MipChain& operator=(const MipChain&);
+
+		std::vector<std::uint8_t>	m_data;
+		std::vector<MipLevel>		m_levels;
+	};
+}
@@ -0,0 +1,785 @@
+﻿#include "pch.h"
+#include "NullDevice.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace DX;
+using namespace Microsoft::WRL;
+
+namespace
+{
+	// 가짜 GPU 가상 주소 및 설명자 핸들의 시작 값입니다. 0이 아닌 값이어야 잘못된 핸들과 구분됩니다.
+	static const UINT64 c_gpuAddressBase = 0x0000000100000000ull;
+	static const UINT64 c_descriptorAddressBase = 0x0000000010000000ull;
+
+	inline UINT64 AlignUp(UINT64 value, UINT64 alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	// 형식의 블록 크기(바이트)와 블록의 너비/높이(픽셀)를 구합니다. 알 수 없는 형식은 4바이트 픽셀로 취급합니다.
+	void GetFormatBlockInfo(DXGI_FORMAT format, UINT* bytesPerBlock, UINT* blockDimension)
+	{
+		*blockDimension = 1;
+
+		switch (format)
+		{
+		case DXGI_FORMAT_BC1_TYPELESS:
+		case DXGI_FORMAT_BC1_UNORM:
+		case DXGI_FORMAT_BC1_UNORM_SRGB:
+		case DXGI_FORMAT_BC4_TYPELESS:
+		case DXGI_FORMAT_BC4_UNORM:
+		case DXGI_FORMAT_BC4_SNORM:
+			*bytesPerBlock = 8;
+			*blockDimension = 4;
+			break;
+
+		case DXGI_FORMAT_BC2_TYPELESS:
+		case DXGI_FORMAT_BC2_UNORM:
+		case DXGI_FORMAT_BC2_UNORM_SRGB:
+		case DXGI_FORMAT_BC3_TYPELESS:
+		case DXGI_FORMAT_BC3_UNORM:
+		case DXGI_FORMAT_BC3_UNORM_SRGB:
+		case DXGI_FORMAT_BC5_TYPELESS:
+		case DXGI_FORMAT_BC5_UNORM:
+		case DXGI_FORMAT_BC5_SNORM:
+		case DXGI_FORMAT_BC6H_TYPELESS:
+		case DXGI_FORMAT_BC6H_UF16:
+		case DXGI_FORMAT_BC6H_SF16:
+		case DXGI_FORMAT_BC7_TYPELESS:
+		case DXGI_FORMAT_BC7_UNORM:
+		case DXGI_FORMAT_BC7_UNORM_SRGB:
+			*bytesPerBlock = 16;
+			*blockDimension = 4;
+			break;
+
+		case DXGI_FORMAT_R32G32B32A32_TYPELESS:
+		case DXGI_FORMAT_R32G32B32A32_FLOAT:
+		case DXGI_FORMAT_R32G32B32A32_UINT:
+		case DXGI_FORMAT_R32G32B32A32_SINT:
+			*bytesPerBlock = 16;
+			break;
+
+		case DXGI_FORMAT_R32G32B32_TYPELESS:
+		case DXGI_FORMAT_R32G32B32_FLOAT:
+		case DXGI_FORMAT_R32G32B32_UINT:
+		case DXGI_FORMAT_R32G32B32_SINT:
+			*bytesPerBlock = 12;
+			break;
+
+		case DXGI_FORMAT_R16G16B16A16_TYPELESS:
+		case DXGI_FORMAT_R16G16B16A16_FLOAT:
+		case DXGI_FORMAT_R16G16B16A16_UNORM:
+		case DXGI_FORMAT_R16G16B16A16_UINT:
+		case DXGI_FORMAT_R16G16B16A16_SNORM:
+		case DXGI_FORMAT_R16G16B16A16_SINT:
+		case DXGI_FORMAT_R32G32_TYPELESS:
+		case DXGI_FORMAT_R32G32_FLOAT:
+		case DXGI_FORMAT_R32G32_UINT:
+		case DXGI_FORMAT_R32G32_SINT:
+			*bytesPerBlock = 8;
+			break;
+
+		case DXGI_FORMAT_R16G16_TYPELESS:
+		case DXGI_FORMAT_R16G16_FLOAT:
+		case DXGI_FORMAT_R16G16_UNORM:
+		case DXGI_FORMAT_R16G16_UINT:
+		case DXGI_FORMAT_R16G16_SNORM:
+		case DXGI_FORMAT_R16G16_SINT:
+		case DXGI_FORMAT_R16_TYPELESS:
+		case DXGI_FORMAT_R16_FLOAT:
+		case DXGI_FORMAT_D16_UNORM:
+		case DXGI_FORMAT_R16_UNORM:
+		case DXGI_FORMAT_R16_UINT:
+		case DXGI_FORMAT_R16_SNORM:
+		case DXGI_FORMAT_R16_SINT:
+		case DXGI_FORMAT_B5G6R5_UNORM:
+		case DXGI_FORMAT_B5G5R5A1_UNORM:
+			*bytesPerBlock = (format >= DXGI_FORMAT_R16G16_TYPELESS && format <= DXGI_FORMAT_R16G16_SINT) ? 4 : 2;
+			break;
+
+		case DXGI_FORMAT_R8_TYPELESS:
+		case DXGI_FORMAT_R8_UNORM:
+		case DXGI_FORMAT_R8_UINT:
+		case DXGI_FORMAT_R8_SNORM:
+		case DXGI_FORMAT_R8_SINT:
+		case DXGI_FORMAT_A8_UNORM:
+			*bytesPerBlock = 1;
+			break;
+
+		default:
+			*bytesPerBlock = 4;
+			break;
+		}
+	}
+}
+
+// NullResource
+
+NullResource::NullResource(NullDevice* device, const D3D12_HEAP_PROPERTIES& heapProperties, D3D12_HEAP_FLAGS heapFlags, const D3D12_RESOURCE_DESC& desc, UINT64 sizeInBytes, D3D12_GPU_VIRTUAL_ADDRESS gpuAddress) :
+	NullDeviceChild(device),
+	m_heapProperties(heapProperties),
+	m_heapFlags(heapFlags),
+	m_desc(desc),
+	m_sizeInBytes(sizeInBytes),
+	m_gpuAddress(gpuAddress)
+{
+	// CPU에서 매핑할 수 있는 힙만 실제 메모리를 할당합니다.
+	if (heapProperties.Type == D3D12_HEAP_TYPE_UPLOAD || heapProperties.Type == D3D12_HEAP_TYPE_READBACK)
+	{
+		m_memory.reset(new UINT8[static_cast<size_t>(sizeInBytes)]);
+		memset(m_memory.get(), 0, static_cast<size_t>(sizeInBytes));
+	}
+}
+
+HRESULT STDMETHODCALLTYPE NullResource::Map(UINT, const D3D12_RANGE*, void** ppData)
+{
+	m_device->OnMap();
+
+	if (m_memory == nullptr)
+	{
+		return E_INVALIDARG;
+	}
+
+	if (ppData != nullptr)
+	{
+		*ppData = m_memory.get();
+	}
+	return S_OK;
+}
+
+void STDMETHODCALLTYPE NullResource::Unmap(UINT, const D3D12_RANGE*)
+{
+}
+
+HRESULT STDMETHODCALLTYPE NullResource::GetHeapProperties(D3D12_HEAP_PROPERTIES* pHeapProperties, D3D12_HEAP_FLAGS* pHeapFlags)
+{
+	if (pHeapProperties != nullptr)
+	{
+		*pHeapProperties = m_heapProperties;
+	}
+	if (pHeapFlags != nullptr)
+	{
+		*pHeapFlags = m_heapFlags;
+	}
+	return S_OK;
+}
+
+// NullDescriptorHeap
+
+NullDescriptorHeap::NullDescriptorHeap(NullDevice* device, const D3D12_DESCRIPTOR_HEAP_DESC& desc, SIZE_T cpuStart, UINT64 gpuStart) :
+	NullDeviceChild(device),
+	m_desc(desc)
+{
+	m_cpuStart.ptr = cpuStart;
+	m_gpuStart.ptr = gpuStart;
+}
+
+// NullQueryHeap
+
+NullQueryHeap::NullQueryHeap(NullDevice* device, const D3D12_QUERY_HEAP_DESC& desc) :
+	NullDeviceChild(device),
+	m_results(desc.Count, 0),
+	m_written(desc.Count, false)
+{
+}
+
+// NullFence
+
+NullFence::NullFence(NullDevice* device, UINT64 initialValue) :
+	NullDeviceChild(device),
+	m_completedValue(initialValue)
+{
+}
+
+HRESULT STDMETHODCALLTYPE NullFence::SetEventOnCompletion(UINT64 Value, HANDLE hEvent)
+{
+	// GPU 타임라인을 필요한 만큼 앞당기므로 반환 시점에는 항상 완료되어 있습니다.
+	m_device->WaitForFence(this, Value);
+
+#if defined(_WIN32)
+	if (hEvent != nullptr)
+	{
+		SetEvent(hEvent);
+	}
+#else
+	(void)hEvent;
+#endif
+	return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE NullFence::Signal(UINT64 Value)
+{
+	Complete(Value);
+	return S_OK;
+}
+
+void NullFence::Complete(UINT64 value)
+{
+	// fence 값은 단조 증가하지 않아도 되지만, 이 앱의 사용 방식에서는 항상 증가합니다.
+	m_completedValue.store(value, std::memory_order_release);
+}
+
+// NullGraphicsCommandList
+
+NullGraphicsCommandList::NullGraphicsCommandList(NullDevice* device, D3D12_COMMAND_LIST_TYPE type) :
+	NullDeviceChild(device),
+	m_type(type),
+	m_recorded(),
+	m_isOpen(true)
+{
+}
+
+HRESULT STDMETHODCALLTYPE NullGraphicsCommandList::Close()
+{
+	if (!m_isOpen)
+	{
+		return E_FAIL;
+	}
+
+	m_isOpen = false;
+	return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE NullGraphicsCommandList::Reset(ID3D12CommandAllocator*, ID3D12PipelineState*)
+{
+	if (m_isOpen)
+	{
+		return E_FAIL;
+	}
+
+	m_isOpen = true;
+	m_recorded = NullDeviceStatistics();
+	m_queryOperations.clear();
+	return S_OK;
+}
+
+void STDMETHODCALLTYPE NullGraphicsCommandList::CopyTextureRegion(const D3D12_TEXTURE_COPY_LOCATION* pDst, UINT, UINT, UINT, const D3D12_TEXTURE_COPY_LOCATION* pSrc, const D3D12_BOX*)
+{
+	// 배치된 공간 쪽의 footprint로 복사 크기를 추정합니다.
+	const D3D12_TEXTURE_COPY_LOCATION* footprintLocation =
+		pSrc->Type == D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT ? pSrc :
+		pDst->Type == D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT ? pDst : nullptr;
+
+	UINT64 bytes = 0;
+	if (footprintLocation != nullptr)
+	{
+		const D3D12_SUBRESOURCE_FOOTPRINT& footprint = footprintLocation->PlacedFootprint.Footprint;
+		bytes = static_cast<UINT64>(footprint.RowPitch) * footprint.Height * footprint.Depth;
+	}
+	RecordCopy(bytes);
+}
+
+void STDMETHODCALLTYPE NullGraphicsCommandList::CopyResource(ID3D12Resource* pDstResource, ID3D12Resource*)
+{
+	RecordCopy(static_cast<NullResource*>(pDstResource)->GetSizeInBytes());
+}
+
+void STDMETHODCALLTYPE NullGraphicsCommandList::EndQuery(ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE, UINT Index)
+{
+	m_recorded.commandListCalls++;
+	m_recorded.queries++;
+
+	QueryOperation operation = {};
+	operation.heap = static_cast<NullQueryHeap*>(pQueryHeap);
+	operation.isResolve = false;
+	operation.index = Index;
+	operation.count = 1;
+	operation.drawsBefore = m_recorded.drawCalls + m_recorded.dispatchCalls;
+	operation.copyBytesBefore = m_recorded.copyBytes;
+	m_queryOperations.push_back(operation);
+}
+
+void STDMETHODCALLTYPE NullGraphicsCommandList::ResolveQueryData(ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE, UINT StartIndex, UINT NumQueries, ID3D12Resource* pDestinationBuffer, UINT64 AlignedDestinationBufferOffset)
+{
+	m_recorded.commandListCalls++;
+
+	QueryOperation operation = {};
+	operation.heap = static_cast<NullQueryHeap*>(pQueryHeap);
+	operation.isResolve = true;
+	operation.index = StartIndex;
+	operation.count = NumQueries;
+	operation.destination = static_cast<NullResource*>(pDestinationBuffer);
+	operation.destinationOffset = AlignedDestinationBufferOffset;
+	operation.drawsBefore = m_recorded.drawCalls + m_recorded.dispatchCalls;
+	operation.copyBytesBefore = m_recorded.copyBytes;
+	m_queryOperations.push_back(operation);
+}
+
+// NullCommandQueue
+
+NullCommandQueue::NullCommandQueue(NullDevice* device, const D3D12_COMMAND_QUEUE_DESC& desc) :
+	NullDeviceChild(device),
+	m_desc(desc)
+{
+}
+
+void STDMETHODCALLTYPE NullCommandQueue::ExecuteCommandLists(UINT NumCommandLists, ID3D12CommandList* const* ppCommandLists)
+{
+	m_device->OnCommandListsExecuted(NumCommandLists, ppCommandLists);
+}
+
+HRESULT STDMETHODCALLTYPE NullCommandQueue::Signal(ID3D12Fence* pFence, UINT64 Value)
+{
+	m_device->OnQueueSignal(static_cast<NullFence*>(pFence), Value);
+	return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE NullCommandQueue::Wait(ID3D12Fence*, UINT64)
+{
+	m_device->OnQueueWait();
+	return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE NullCommandQueue::GetTimestampFrequency(UINT64* pFrequency)
+{
+	*pFrequency = NullDevice::c_timestampFrequency;
+	return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE NullCommandQueue::GetClockCalibration(UINT64* pGpuTimestamp, UINT64* pCpuTimestamp)
+{
+	*pGpuTimestamp = m_device->ReadGpuTimestamp();
+
+#if defined(_WIN32)
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	*pCpuTimestamp = static_cast<UINT64>(counter.QuadPart);
+#else
+	*pCpuTimestamp = 0;
+#endif
+	return S_OK;
+}
+
+// NullDevice
+
+NullDevice::NullDevice() :
+	m_statistics(),
+	m_commandAllocatorBudget(UINT_MAX),
+	m_gpuLatency(0),
+	m_gpuTimestamp(0),
+	m_ticksPerDraw(1000),
+	m_ticksPerKilobyteCopied(100),
+	m_nextGpuAddress(c_gpuAddressBase),
+	m_nextDescriptorAddress(c_descriptorAddressBase)
+{
+}
+
+void NullDevice::SetGpuLatency(UINT latency)
+{
+	std::lock_guard<std::mutex> lock(m_timelineLock);
+	m_gpuLatency = latency;
+
+	while (m_pendingSignals.size() > m_gpuLatency)
+	{
+		RetireOldestSignal();
+	}
+}
+
+UINT NullDevice::GetGpuLatency() const
+{
+	std::lock_guard<std::mutex> lock(m_timelineLock);
+	return m_gpuLatency;
+}
+
+void NullDevice::FlushGpu()
+{
+	std::lock_guard<std::mutex> lock(m_timelineLock);
+	while (!m_pendingSignals.empty())
+	{
+		RetireOldestSignal();
+	}
+}
+
+void NullDevice::SetSimulatedGpuCost(UINT64 ticksPerDraw, UINT64 ticksPerKilobyteCopied)
+{
+	std::lock_guard<std::mutex> lock(m_timelineLock);
+	m_ticksPerDraw = ticksPerDraw;
+	m_ticksPerKilobyteCopied = ticksPerKilobyteCopied;
+}
+
+void NullDevice::SetCommandAllocatorBudget(UINT count)
+{
+	std::lock_guard<std::mutex> lock(m_statisticsLock);
+	m_commandAllocatorBudget = count;
+}
+
+NullDeviceStatistics NullDevice::GetStatistics() const
+{
+	std::lock_guard<std::mutex> lock(m_statisticsLock);
+	return m_statistics;
+}
+
+void NullDevice::ResetStatistics()
+{
+	std::lock_guard<std::mutex> lock(m_statisticsLock);
+	m_statistics = NullDeviceStatistics();
+}
+
+void NullDevice::OnCommandListsExecuted(UINT count, ID3D12CommandList* const* ppCommandLists)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_statisticsLock);
+		m_statistics.executeCalls++;
+		m_statistics.commandListsExecuted += count;
+
+		for (UINT i = 0; i < count; i++)
+		{
+			const NullDeviceStatistics& recorded = static_cast<NullGraphicsCommandList*>(ppCommandLists[i])->GetRecordedStatistics();
+			m_statistics.commandListCalls += recorded.commandListCalls;
+			m_statistics.drawCalls += recorded.drawCalls;
+			m_statistics.dispatchCalls += recorded.dispatchCalls;
+			m_statistics.resourceBarriers += recorded.resourceBarriers;
+			m_statistics.copyCalls += recorded.copyCalls;
+			m_statistics.copyBytes += recorded.copyBytes;
+			m_statistics.descriptorTableBinds += recorded.descriptorTableBinds;
+			m_statistics.queries += recorded.queries;
+		}
+	}
+
+	// 합성 GPU 시계를 진행하면서 쿼리를 순서대로 처리합니다.
+	UINT64 unwrittenQueriesResolved = 0;
+	std::unique_lock<std::mutex> lock(m_timelineLock);
+	for (UINT i = 0; i < count; i++)
+	{
+		auto commandList = static_cast<NullGraphicsCommandList*>(ppCommandLists[i]);
+		const UINT64 listStart = m_gpuTimestamp;
+
+		for (const auto& operation : commandList->GetQueryOperations())
+		{
+			auto& results = operation.heap->GetResults();
+			auto& written = operation.heap->GetWritten();
+			if (!operation.isResolve)
+			{
+				results[operation.index] = listStart + operation.drawsBefore * m_ticksPerDraw + operation.copyBytesBefore / 1024 * m_ticksPerKilobyteCopied;
+				written[operation.index] = true;
+				continue;
+			}
+
+			for (UINT query = operation.index; query < operation.index + operation.count; query++)
+			{
+				unwrittenQueriesResolved += written[query] ? 0 : 1;
+				written[query] = false;
+			}
+			if (operation.destination->GetCpuMemory() != nullptr)
+			{
+				memcpy(operation.destination->GetCpuMemory() + operation.destinationOffset, &results[operation.index], operation.count * sizeof(UINT64));
+			}
+		}
+
+		const NullDeviceStatistics& recorded = commandList->GetRecordedStatistics();
+		m_gpuTimestamp += (recorded.drawCalls + recorded.dispatchCalls) * m_ticksPerDraw + recorded.copyBytes / 1024 * m_ticksPerKilobyteCopied;
+	}
+	lock.unlock();
+
+	if (unwrittenQueriesResolved != 0)
+	{
+		std::lock_guard<std::mutex> statisticsLock(m_statisticsLock);
+		m_statistics.unwrittenQueriesResolved += unwrittenQueriesResolved;
+	}
+}
+
+void NullDevice::OnQueueSignal(NullFence* fence, UINT64 value)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_statisticsLock);
+		m_statistics.signals++;
+	}
+
+	std::lock_guard<std::mutex> lock(m_timelineLock);
+	PendingSignal signal;
+	signal.fence = fence;
+	signal.value = value;
+	m_pendingSignals.push_back(signal);
+
+	while (m_pendingSignals.size() > m_gpuLatency)
+	{
+		RetireOldestSignal();
+	}
+}
+
+void NullDevice::OnQueueWait()
+{
+	std::lock_guard<std::mutex> lock(m_statisticsLock);
+	m_statistics.gpuWaits++;
+}
+
+// CPU가 fence 값을 기다리는 것을 흉내 냅니다. 값에 도달할 때까지 대기 중인 신호를 순서대로 완료하며,
+// 타임라인을 앞당겨야 했다면 CPU 지연으로 집계합니다. 값이 이미 완료되었거나 도달했으면 true를 반환합니다.
+bool NullDevice::WaitForFence(NullFence* fence, UINT64 value)
+{
+	bool stalled = false;
+	bool reached = fence->GetCompletedValue() >= value;
+	{
+		std::lock_guard<std::mutex> lock(m_timelineLock);
+		while (!reached && !m_pendingSignals.empty())
+		{
+			stalled = true;
+			RetireOldestSignal();
+			reached = fence->GetCompletedValue() >= value;
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(m_statisticsLock);
+	m_statistics.cpuWaits++;
+	if (stalled)
+	{
+		m_statistics.cpuStalls++;
+	}
+	return reached;
+}
+
+void NullDevice::OnMap()
+{
+	std::lock_guard<std::mutex> lock(m_statisticsLock);
+	m_statistics.mapCalls++;
+}
+
+UINT64 NullDevice::ReadGpuTimestamp()
+{
+	std::lock_guard<std::mutex> lock(m_timelineLock);
+	return m_gpuTimestamp;
+}
+
+void NullDevice::OnDescriptorsCreated(UINT64 count)
+{
+	std::lock_guard<std::mutex> lock(m_statisticsLock);
+	m_statistics.descriptorsCreated += count;
+}
+
+// m_timelineLock을 보유한 상태에서 호출해야 합니다.
+void NullDevice::RetireOldestSignal()
+{
+	PendingSignal& signal = m_pendingSignals.front();
+	static_cast<NullFence*>(signal.fence.Get())->Complete(signal.value);
+	m_pendingSignals.pop_front();
+}
+
+HRESULT STDMETHODCALLTYPE NullDevice::CreateCommandQueue(const D3D12_COMMAND_QUEUE_DESC* pDesc, REFIID riid, void** ppCommandQueue)
+{
+	return ReturnObject(new NullCommandQueue(this, *pDesc), riid, ppCommandQueue);
+}
+
+HRESULT STDMETHODCALLTYPE NullDevice::CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE, REFIID riid, void** ppCommandAllocator)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_statisticsLock);
+		if (m_commandAllocatorBudget == 0)
+		{
+			*ppCommandAllocator = nullptr;
+			return E_OUTOFMEMORY;
+		}
+		if (m_commandAllocatorBudget != UINT_MAX)
+		{
+			m_commandAllocatorBudget--;
+		}
+	}
+	return ReturnObject(new NullCommandAllocator(this), riid, ppCommandAllocator);
+}
+
+HRESULT STDMETHODCALLTYPE NullDevice::CreateGraphicsPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC*, REFIID riid, void** ppPipelineState)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_statisticsLock);
+		m_statistics.pipelineStatesCreated++;
+	}
+	return ReturnObject(new NullPipelineState(this), riid, ppPipelineState);
+}
+
+HRESULT STDMETHODCALLTYPE NullDevice::CreateComputePipelineState(const D3D12_COMPUTE_PIPELINE_STATE_DESC*, REFIID riid, void** ppPipelineState)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_statisticsLock);
+		m_statistics.pipelineStatesCreated++;
+	}
+	return ReturnObject(new NullPipelineState(this), riid, ppPipelineState);
+}
+
+HRESULT STDMETHODCALLTYPE NullDevice::CreateCommandList(UINT, D3D12_COMMAND_LIST_TYPE type, ID3D12CommandAllocator*, ID3D12PipelineState*, REFIID riid, void** ppCommandList)
+{
+	return ReturnObject(new NullGraphicsCommandList(this, type), riid, ppCommandList);
+}
+
+HRESULT STDMETHODCALLTYPE NullDevice::CheckFeatureSupport(D3D12_FEATURE, void* pFeatureSupportData, UINT FeatureSupportDataSize)
+{
+	// 모든 선택적 기능을 지원하지 않는 것으로 보고합니다.
+	memset(pFeatureSupportData, 0, FeatureSupportDataSize);
+	return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE NullDevice::CreateDescriptorHeap(const D3D12_DESCRIPTOR_HEAP_DESC* pDescriptorHeapDesc, REFIID riid, void** ppvHeap)
+{
+	const UINT64 rangeSize = AlignUp(static_cast<UINT64>(pDescriptorHeapDesc->NumDescriptors) * c_descriptorIncrementSize + 1, 0x10000);
+	const UINT64 start = m_nextDescriptorAddress.fetch_add(rangeSize);
+	const bool shaderVisible = (pDescriptorHeapDesc->Flags & D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE) != 0;
+
+	{
+		std::lock_guard<std::mutex> lock(m_statisticsLock);
+		m_statistics.descriptorHeapsCreated++;
+	}
+	return ReturnObject(new NullDescriptorHeap(this, *pDescriptorHeapDesc, static_cast<SIZE_T>(start), shaderVisible ? start : 0), riid, ppvHeap);
+}
+
+HRESULT STDMETHODCALLTYPE NullDevice::CreateRootSignature(UINT, const void*, SIZE_T, REFIID riid, void** ppvRootSignature)
+{
+	return ReturnObject(new NullRootSignature(this), riid, ppvRootSignature);
+}
+
+void STDMETHODCALLTYPE NullDevice::CopyDescriptors(UINT NumDestDescriptorRanges, const D3D12_CPU_DESCRIPTOR_HANDLE*, const UINT* pDestDescriptorRangeSizes, UINT, const D3D12_CPU_DESCRIPTOR_HANDLE*, const UINT*, D3D12_DESCRIPTOR_HEAP_TYPE)
+{
+	UINT64 count = 0;
+	for (UINT i = 0; i < NumDestDescriptorRanges; i++)
+	{
+		count += pDestDescriptorRangeSizes != nullptr ? pDestDescriptorRangeSizes[i] : 1;
+	}
+	OnDescriptorsCreated(count);
+}
+
+D3D12_RESOURCE_ALLOCATION_INFO STDMETHODCALLTYPE NullDevice::GetResourceAllocationInfo(UINT, UINT numResourceDescs, const D3D12_RESOURCE_DESC* pResourceDescs)
+{
+	D3D12_RESOURCE_ALLOCATION_INFO info = {};
+	info.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+
+	for (UINT i = 0; i < numResourceDescs; i++)
+	{
+		UINT64 size = 0;
+		const D3D12_RESOURCE_DESC& desc = pResourceDescs[i];
+		const UINT subresources = desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER ? 1 :
+			desc.MipLevels * (desc.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D ? 1 : desc.DepthOrArraySize);
+		GetCopyableFootprints(&desc, 0, subresources, 0, nullptr, nullptr, nullptr, &size);
+		info.SizeInBytes = AlignUp(info.SizeInBytes, info.Alignment) + AlignUp(size, info.Alignment);
+	}
+	return info;
+}
+
+D3D12_HEAP_PROPERTIES STDMETHODCALLTYPE NullDevice::GetCustomHeapProperties(UINT, D3D12_HEAP_TYPE heapType)
+{
+	D3D12_HEAP_PROPERTIES properties = {};
+	properties.Type = D3D12_HEAP_TYPE_CUSTOM;
+	properties.CPUPageProperty = heapType == D3D12_HEAP_TYPE_DEFAULT ? D3D12_CPU_PAGE_PROPERTY_NOT_AVAILABLE :
+		heapType == D3D12_HEAP_TYPE_UPLOAD ? D3D12_CPU_PAGE_PROPERTY_WRITE_COMBINE : D3D12_CPU_PAGE_PROPERTY_WRITE_BACK;
+	properties.MemoryPoolPreference = D3D12_MEMORY_POOL_L0;
+	properties.CreationNodeMask = 1;
+	properties.VisibleNodeMask = 1;
+	return properties;
+}
+
+HRESULT STDMETHODCALLTYPE NullDevice::CreateCommittedResource(const D3D12_HEAP_PROPERTIES* pHeapProperties, D3D12_HEAP_FLAGS HeapFlags, const D3D12_RESOURCE_DESC* pDesc, D3D12_RESOURCE_STATES, const D3D12_CLEAR_VALUE*, REFIID riidResource, void** ppvResource)
+{
+	UINT64 size = pDesc->Width;
+	if (pDesc->Dimension != D3D12_RESOURCE_DIMENSION_BUFFER)
+	{
+		const UINT subresources = pDesc->MipLevels * (pDesc->Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D ? 1 : pDesc->DepthOrArraySize);
+		GetCopyableFootprints(pDesc, 0, (std::max)(subresources, 1u), 0, nullptr, nullptr, nullptr, &size);
+	}
+
+	const D3D12_GPU_VIRTUAL_ADDRESS gpuAddress = m_nextGpuAddress.fetch_add(AlignUp((std::max)(size, static_cast<UINT64>(1)), D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT));
+
+	{
+		std::lock_guard<std::mutex> lock(m_statisticsLock);
+		m_statistics.resourcesCreated++;
+		m_statistics.resourceBytes += size;
+	}
+	return ReturnObject(new NullResource(this, *pHeapProperties, HeapFlags, *pDesc, size, gpuAddress), riidResource, ppvResource);
+}
+
+HRESULT STDMETHODCALLTYPE NullDevice::CreateFence(UINT64 InitialValue, D3D12_FENCE_FLAGS, REFIID riid, void** ppFence)
+{
+	return ReturnObject(new NullFence(this, InitialValue), riid, ppFence);
+}
+
+// 실제 장치와 같은 정렬 규칙(행 피치 256바이트, 하위 리소스 오프셋 512바이트)으로 레이아웃을 계산합니다.
+void STDMETHODCALLTYPE NullDevice::GetCopyableFootprints(const D3D12_RESOURCE_DESC* pResourceDesc, UINT FirstSubresource, UINT NumSubresources, UINT64 BaseOffset, D3D12_PLACED_SUBRESOURCE_FOOTPRINT* pLayouts, UINT* pNumRows, UINT64* pRowSizeInBytes, UINT64* pTotalBytes)
+{
+	const D3D12_RESOURCE_DESC& desc = *pResourceDesc;
+	UINT64 offset = BaseOffset;
+	UINT64 total = 0;
+
+	for (UINT i = 0; i < NumSubresources; i++)
+	{
+		const UINT subresource = FirstSubresource + i;
+		UINT width, height, depth, numRows;
+		UINT64 rowSize;
+
+		if (desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+		{
+			width = static_cast<UINT>(desc.Width);
+			height = 1;
+			depth = 1;
+			numRows = 1;
+			rowSize = desc.Width;
+		}
+		else
+		{
+			const UINT mipLevels = (std::max)(static_cast<UINT>(desc.MipLevels), 1u);
+			const UINT mip = subresource % mipLevels;
+			UINT bytesPerBlock, blockDimension;
+			GetFormatBlockInfo(desc.Format, &bytesPerBlock, &blockDimension);
+
+			width = (std::max)(static_cast<UINT>(desc.Width >> mip), 1u);
+			height = (std::max)(desc.Height >> mip, 1u);
+			depth = desc.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D ? (std::max)(static_cast<UINT>(desc.DepthOrArraySize >> mip), 1u) : 1;
+
+			// 블록 압축 형식은 크기를 블록 경계로 올립니다.
+			width = static_cast<UINT>(AlignUp(width, blockDimension));
+			height = static_cast<UINT>(AlignUp(height, blockDimension));
+			numRows = height / blockDimension;
+			rowSize = static_cast<UINT64>(width / blockDimension) * bytesPerBlock;
+		}
+
+		offset = AlignUp(offset, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+		const UINT rowPitch = static_cast<UINT>(AlignUp(rowSize, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT));
+
+		if (pLayouts != nullptr)
+		{
+			pLayouts[i].Offset = offset;
+			pLayouts[i].Footprint.Format = desc.Format;
+			pLayouts[i].Footprint.Width = width;
+			pLayouts[i].Footprint.Height = height;
+			pLayouts[i].Footprint.Depth = depth;
+			pLayouts[i].Footprint.RowPitch = rowPitch;
+		}
+		if (pNumRows != nullptr)
+		{
+			pNumRows[i] = numRows;
+		}
+		if (pRowSizeInBytes != nullptr)
+		{
+			pRowSizeInBytes[i] = rowSize;
+		}
+
+		// 마지막 행은 피치만큼 채워지지 않습니다.
+		const UINT64 subresourceSize = static_cast<UINT64>(rowPitch) * (static_cast<UINT64>(numRows) * depth - 1) + rowSize;
+		total = offset + subresourceSize - BaseOffset;
+		offset += subresourceSize;
+	}
+
+	if (pTotalBytes != nullptr)
+	{
+		*pTotalBytes = total;
+	}
+}
+
+HRESULT STDMETHODCALLTYPE NullDevice::CreateQueryHeap(const D3D12_QUERY_HEAP_DESC* pDesc, REFIID riid, void** ppvHeap)
+{
+	return ReturnObject(new NullQueryHeap(this, *pDesc), riid, ppvHeap);
+}
+
+void STDMETHODCALLTYPE NullDevice::GetResourceTiling(ID3D12Resource*, UINT* pNumTilesForEntireResource, D3D12_PACKED_MIP_INFO*, D3D12_TILE_SHAPE*, UINT* pNumSubresourceTilings, UINT, D3D12_SUBRESOURCE_TILING*)
+{
+	if (pNumTilesForEntireResource != nullptr)
+	{
+		*pNumTilesForEntireResource = 0;
+	}
+	if (pNumSubresourceTilings != nullptr)
+	{
+		*pNumSubresourceTilings = 0;
+	}
+}
+
+LUID STDMETHODCALLTYPE NullDevice::GetAdapterLuid()
+{
+	LUID luid = {};
+	return luid;
+}
@@ -0,0 +1,520 @@
+﻿#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+// 앱은 pch.h로 Windows SDK 헤더를 받지만, 헤드리스 빌드에서는 이 헤더가 직접 D3D12 헤더를 포함합니다.
+// Windows가 아닌 플랫폼에서는 DirectX-Headers의 WSL용 헤더(winadapter.h, directx/d3d12.h)를 사용합니다.
+#if defined(_WIN32)
+#include <d3d12.h>
+#include <wrl/client.h>
+#else
+#include <wsl/winadapter.h>
+#include <directx/d3d12.h>
+#include <dxguids/dxguids.h>
+#include <wrl/client.h>
+#endif
+
+#if !defined(DXGI_ERROR_NOT_FOUND)
+#define DXGI_ERROR_NOT_FOUND ((HRESULT)0x887A0002L)
+#endif
+
+namespace DX
+{
+	// 인터페이스 형식의 IID입니다. DirectX-Headers의 __uuidof는 형식 이름 대신 식만 받으므로 포인터 식으로 묻습니다.
+	template<typename T>
+	inline IID GetInterfaceId()
+	{
+		return __uuidof(static_cast<T*>(nullptr));
+	}
+
+	// 헤드리스 D3D12 대체 구현의 누적 통계입니다.
+	// 명령 목록 통계는 ExecuteCommandLists 시점에 합산되므로 제출된 작업만 포함합니다.
+	struct NullDeviceStatistics
+	{
+		// 명령 목록 기록.
+		UINT64 commandListCalls;		// 기록된 모든 명령 목록 메서드 호출 수입니다.
+		UINT64 drawCalls;
+		UINT64 dispatchCalls;
+		UINT64 resourceBarriers;		// 개별 장벽 수입니다(ResourceBarrier 호출 수가 아님).
+		UINT64 copyCalls;
+		UINT64 copyBytes;
+		UINT64 descriptorTableBinds;
+		UINT64 queries;
+		UINT64 unwrittenQueriesResolved;	// 마지막 확인 이후 EndQuery로 쓰이지 않은 채 확인된 쿼리 슬롯 수입니다. 0이어야 합니다.
+
+		// 큐 제출 및 동기화.
+		UINT64 executeCalls;
+		UINT64 commandListsExecuted;
+		UINT64 signals;
+		UINT64 gpuWaits;				// ID3D12CommandQueue::Wait 호출 수입니다.
+		UINT64 cpuWaits;				// SetEventOnCompletion 호출 수입니다.
+		UINT64 cpuStalls;				// 그중 아직 완료되지 않은 값을 기다려 타임라인을 앞당긴 횟수입니다.
+
+		// 장치 개체 생성.
+		UINT64 resourcesCreated;
+		UINT64 resourceBytes;
+		UINT64 descriptorHeapsCreated;
+		UINT64 descriptorsCreated;		// CBV/SRV/UAV/RTV/DSV/샘플러 생성 및 복사 수입니다.
+		UINT64 pipelineStatesCreated;
+		UINT64 mapCalls;
+	};
+
+	class NullDevice;
+	class NullFence;
+
+	// 모든 대체 개체에 공통인 IUnknown 및 ID3D12Object 구현입니다.
+	// TInterface는 구현 대상이며, TBases는 QueryInterface가 추가로 응답할 기본 인터페이스입니다.
+	template<typename TInterface, typename... TBases>
+	class NullObject : public TInterface
+	{
+	public:
+		NullObject() : m_refCount(1) {}
+		virtual ~NullObject() {}
+
+		// IUnknown 메서드.
+		HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) override
+		{
+			if (ppvObject == nullptr)
+			{
+				return E_POINTER;
+			}
+
+			if (riid == GetInterfaceId<IUnknown>() || riid == GetInterfaceId<ID3D12Object>() || riid == GetInterfaceId<TInterface>() || MatchesBase<TBases...>(riid))
+			{
+				*ppvObject = static_cast<TInterface*>(this);
+				AddRef();
+				return S_OK;
+			}
+
+			*ppvObject = nullptr;
+			return E_NOINTERFACE;
+		}
+
+		ULONG STDMETHODCALLTYPE AddRef() override
+		{
+			return ++m_refCount;
+		}
+
+		ULONG STDMETHODCALLTYPE Release() override
+		{
+			ULONG count = --m_refCount;
+			if (count == 0)
+			{
+				delete this;
+			}
+			return count;
+		}
+
+		// ID3D12Object 메서드. 디버그 이름과 전용 데이터는 저장하지 않습니다.
+		HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID, UINT* pDataSize, void*) override
+		{
+			if (pDataSize != nullptr)
+			{
+				*pDataSize = 0;
+			}
+			return DXGI_ERROR_NOT_FOUND;
+		}
+		HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID, UINT, const void*) override	{ return S_OK; }
+		HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID, const IUnknown*) override	{ return S_OK; }
+		HRESULT STDMETHODCALLTYPE SetName(LPCWSTR) override							{ return S_OK; }
+
+	private:
+		template<typename... TRest>
+		static typename std::enable_if<sizeof...(TRest) == 0, bool>::type MatchesBase(REFIID)
+		{
+			return false;
+		}
+
+		template<typename TFirst, typename... TRest>
+		static bool MatchesBase(REFIID riid)
+		{
+			return riid == GetInterfaceId<TFirst>() || MatchesBase<TRest...>(riid);
+		}
+
+		std::atomic<ULONG> m_refCount;
+	};
+
+	// 장치가 만든 개체의 공통 구현입니다. 실제 D3D12와 마찬가지로 자식은 장치에 대한 참조를 유지합니다.
+	template<typename TInterface, typename... TBases>
+	class NullDeviceChild : public NullObject<TInterface, ID3D12DeviceChild, TBases...>
+	{
+	public:
+		explicit NullDeviceChild(NullDevice* device);
+		virtual ~NullDeviceChild();
+
+		HRESULT STDMETHODCALLTYPE GetDevice(REFIID riid, void** ppvDevice) override;
+
+		NullDevice* GetNullDevice() const	{ return m_device; }
+
+	protected:
+		NullDevice* m_device;
+	};
+
+	// 매핑 가능한 힙의 리소스만 CPU 메모리를 가지며, 기본 힙의 리소스는 설명과 GPU 가상 주소만 가집니다.
+	class NullResource : public NullDeviceChild<ID3D12Resource, ID3D12Pageable>
+	{
+	public:
+		NullResource(NullDevice* device, const D3D12_HEAP_PROPERTIES& heapProperties, D3D12_HEAP_FLAGS heapFlags, const D3D12_RESOURCE_DESC& desc, UINT64 sizeInBytes, D3D12_GPU_VIRTUAL_ADDRESS gpuAddress);
+
+		HRESULT STDMETHODCALLTYPE Map(UINT Subresource, const D3D12_RANGE* pReadRange, void** ppData) override;
+		void STDMETHODCALLTYPE Unmap(UINT Subresource, const D3D12_RANGE* pWrittenRange) override;
+		D3D12_RESOURCE_DESC STDMETHODCALLTYPE GetDesc() override				{ return m_desc; }
+		D3D12_GPU_VIRTUAL_ADDRESS STDMETHODCALLTYPE GetGPUVirtualAddress() override	{ return m_gpuAddress; }
+		HRESULT STDMETHODCALLTYPE WriteToSubresource(UINT, const D3D12_BOX*, const void*, UINT, UINT) override	{ return E_NOTIMPL; }
+		HRESULT STDMETHODCALLTYPE ReadFromSubresource(void*, UINT, UINT, UINT, const D3D12_BOX*) override		{ return E_NOTIMPL; }
+		HRESULT STDMETHODCALLTYPE GetHeapProperties(D3D12_HEAP_PROPERTIES* pHeapProperties, D3D12_HEAP_FLAGS* pHeapFlags) override;
+
+		UINT64 GetSizeInBytes() const		{ return m_sizeInBytes; }
+		UINT8* GetCpuMemory() const			{ return m_memory.get(); }
+
+	private:
+		D3D12_HEAP_PROPERTIES		m_heapProperties;
+		D3D12_HEAP_FLAGS			m_heapFlags;
+		D3D12_RESOURCE_DESC			m_desc;
+		UINT64						m_sizeInBytes;
+		D3D12_GPU_VIRTUAL_ADDRESS	m_gpuAddress;
+		std::unique_ptr<UINT8[]>	m_memory;
+	};
+
+	class NullDescriptorHeap : public NullDeviceChild<ID3D12DescriptorHeap, ID3D12Pageable>
+	{
+	public:
+		NullDescriptorHeap(NullDevice* device, const D3D12_DESCRIPTOR_HEAP_DESC& desc, SIZE_T cpuStart, UINT64 gpuStart);
+
+		D3D12_DESCRIPTOR_HEAP_DESC STDMETHODCALLTYPE GetDesc() override							{ return m_desc; }
+		D3D12_CPU_DESCRIPTOR_HANDLE STDMETHODCALLTYPE GetCPUDescriptorHandleForHeapStart() override	{ return m_cpuStart; }
+		D3D12_GPU_DESCRIPTOR_HANDLE STDMETHODCALLTYPE GetGPUDescriptorHandleForHeapStart() override	{ return m_gpuStart; }
+
+	private:
+		D3D12_DESCRIPTOR_HEAP_DESC	m_desc;
+		D3D12_CPU_DESCRIPTOR_HANDLE	m_cpuStart;
+		D3D12_GPU_DESCRIPTOR_HANDLE	m_gpuStart;
+	};
+
+	class NullQueryHeap : public NullDeviceChild<ID3D12QueryHeap, ID3D12Pageable>
+	{
+	public:
+		NullQueryHeap(NullDevice* device, const D3D12_QUERY_HEAP_DESC& desc);
+
+		// 쿼리 결과 슬롯입니다. EndQuery가 쓰고 ResolveQueryData가 읽습니다.
+		std::vector<UINT64>& GetResults()	{ return m_results; }
+
+		// 슬롯이 마지막 확인 이후 EndQuery로 쓰였는지입니다. 확인하면 다시 비워지므로 이전 프레임의 값을 다시 읽으면 드러납니다.
+		std::vector<bool>& GetWritten()		{ return m_written; }
+
+	private:
+		std::vector<UINT64>	m_results;
+		std::vector<bool>	m_written;
+	};
+
+	class NullCommandAllocator : public NullDeviceChild<ID3D12CommandAllocator, ID3D12Pageable>
+	{
+	public:
+		explicit NullCommandAllocator(NullDevice* device) : NullDeviceChild(device) {}
+
+		HRESULT STDMETHODCALLTYPE Reset() override	{ return S_OK; }
+	};
+
+	class NullRootSignature : public NullDeviceChild<ID3D12RootSignature>
+	{
+	public:
+		explicit NullRootSignature(NullDevice* device) : NullDeviceChild(device) {}
+	};
+
+	class NullPipelineState : public NullDeviceChild<ID3D12PipelineState, ID3D12Pageable>
+	{
+	public:
+		explicit NullPipelineState(NullDevice* device) : NullDeviceChild(device) {}
+
+		HRESULT STDMETHODCALLTYPE GetCachedBlob(ID3DBlob** ppBlob) override
+		{
+			if (ppBlob != nullptr)
+			{
+				*ppBlob = nullptr;
+			}
+			return E_NOTIMPL;
+		}
+	};
+
+	// GPU 타임라인에서 완료 값이 앞당겨지는 fence입니다.
+	class NullFence : public NullDeviceChild<ID3D12Fence, ID3D12Pageable>
+	{
+	public:
+		NullFence(NullDevice* device, UINT64 initialValue);
+
+		UINT64 STDMETHODCALLTYPE GetCompletedValue() override	{ return m_completedValue.load(std::memory_order_acquire); }
+		HRESULT STDMETHODCALLTYPE SetEventOnCompletion(UINT64 Value, HANDLE hEvent) override;
+		HRESULT STDMETHODCALLTYPE Signal(UINT64 Value) override;
+
+		// 타임라인이 신호를 처리할 때 호출합니다.
+		void Complete(UINT64 value);
+
+	private:
+		std::atomic<UINT64> m_completedValue;
+	};
+
+	// 명령을 실행하지 않고 호출 수, 장벽 및 복사 바이트만 기록하는 명령 목록입니다.
+	class NullGraphicsCommandList : public NullDeviceChild<ID3D12GraphicsCommandList, ID3D12CommandList>
+	{
+	public:
+		NullGraphicsCommandList(NullDevice* device, D3D12_COMMAND_LIST_TYPE type);
+
+		// 마지막 Reset 이후 기록된 통계입니다. 제출 시 장치 통계에 합산됩니다.
+		const NullDeviceStatistics& GetRecordedStatistics() const	{ return m_recorded; }
+
+		// ID3D12CommandList 메서드.
+		D3D12_COMMAND_LIST_TYPE STDMETHODCALLTYPE GetType() override	{ return m_type; }
+
+		// ID3D12GraphicsCommandList 메서드.
+		HRESULT STDMETHODCALLTYPE Close() override;
+		HRESULT STDMETHODCALLTYPE Reset(ID3D12CommandAllocator* pAllocator, ID3D12PipelineState* pInitialState) override;
+		void STDMETHODCALLTYPE ClearState(ID3D12PipelineState*) override													{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE DrawInstanced(UINT, UINT, UINT, UINT) override												{ m_recorded.commandListCalls++; m_recorded.drawCalls++; }
+		void STDMETHODCALLTYPE DrawIndexedInstanced(UINT, UINT, UINT, INT, UINT) override									{ m_recorded.commandListCalls++; m_recorded.drawCalls++; }
+		void STDMETHODCALLTYPE Dispatch(UINT, UINT, UINT) override															{ m_recorded.commandListCalls++; m_recorded.dispatchCalls++; }
+		void STDMETHODCALLTYPE CopyBufferRegion(ID3D12Resource*, UINT64, ID3D12Resource*, UINT64, UINT64 NumBytes) override	{ RecordCopy(NumBytes); }
+		void STDMETHODCALLTYPE CopyTextureRegion(const D3D12_TEXTURE_COPY_LOCATION* pDst, UINT DstX, UINT DstY, UINT DstZ, const D3D12_TEXTURE_COPY_LOCATION* pSrc, const D3D12_BOX* pSrcBox) override;
+		void STDMETHODCALLTYPE CopyResource(ID3D12Resource* pDstResource, ID3D12Resource* pSrcResource) override;
+		void STDMETHODCALLTYPE CopyTiles(ID3D12Resource*, const D3D12_TILED_RESOURCE_COORDINATE*, const D3D12_TILE_REGION_SIZE*, ID3D12Resource*, UINT64, D3D12_TILE_COPY_FLAGS) override	{ RecordCopy(0); }
+		void STDMETHODCALLTYPE ResolveSubresource(ID3D12Resource*, UINT, ID3D12Resource*, UINT, DXGI_FORMAT) override		{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE IASetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY) override									{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE RSSetViewports(UINT, const D3D12_VIEWPORT*) override											{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE RSSetScissorRects(UINT, const D3D12_RECT*) override											{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE OMSetBlendFactor(const FLOAT[4]) override													{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE OMSetStencilRef(UINT) override																{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE SetPipelineState(ID3D12PipelineState*) override												{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE ResourceBarrier(UINT NumBarriers, const D3D12_RESOURCE_BARRIER*) override					{ m_recorded.commandListCalls++; m_recorded.resourceBarriers += NumBarriers; }
+		void STDMETHODCALLTYPE ExecuteBundle(ID3D12GraphicsCommandList*) override											{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE SetDescriptorHeaps(UINT, ID3D12DescriptorHeap* const*) override								{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE SetComputeRootSignature(ID3D12RootSignature*) override										{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE SetGraphicsRootSignature(ID3D12RootSignature*) override										{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE SetComputeRootDescriptorTable(UINT, D3D12_GPU_DESCRIPTOR_HANDLE) override					{ m_recorded.commandListCalls++; m_recorded.descriptorTableBinds++; }
+		void STDMETHODCALLTYPE SetGraphicsRootDescriptorTable(UINT, D3D12_GPU_DESCRIPTOR_HANDLE) override					{ m_recorded.commandListCalls++; m_recorded.descriptorTableBinds++; }
+		void STDMETHODCALLTYPE SetComputeRoot32BitConstant(UINT, UINT, UINT) override										{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE SetGraphicsRoot32BitConstant(UINT, UINT, UINT) override										{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE SetComputeRoot32BitConstants(UINT, UINT, const void*, UINT) override							{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE SetGraphicsRoot32BitConstants(UINT, UINT, const void*, UINT) override						{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE SetComputeRootConstantBufferView(UINT, D3D12_GPU_VIRTUAL_ADDRESS) override					{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE SetGraphicsRootConstantBufferView(UINT, D3D12_GPU_VIRTUAL_ADDRESS) override					{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE SetComputeRootShaderResourceView(UINT, D3D12_GPU_VIRTUAL_ADDRESS) override					{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE SetGraphicsRootShaderResourceView(UINT, D3D12_GPU_VIRTUAL_ADDRESS) override					{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE SetComputeRootUnorderedAccessView(UINT, D3D12_GPU_VIRTUAL_ADDRESS) override					{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE SetGraphicsRootUnorderedAccessView(UINT, D3D12_GPU_VIRTUAL_ADDRESS) override					{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE IASetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW*) override									{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE IASetVertexBuffers(UINT, UINT, const D3D12_VERTEX_BUFFER_VIEW*) override						{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE SOSetTargets(UINT, UINT, const D3D12_STREAM_OUTPUT_BUFFER_VIEW*) override					{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE OMSetRenderTargets(UINT, const D3D12_CPU_DESCRIPTOR_HANDLE*, BOOL, const D3D12_CPU_DESCRIPTOR_HANDLE*) override	{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE ClearDepthStencilView(D3D12_CPU_DESCRIPTOR_HANDLE, D3D12_CLEAR_FLAGS, FLOAT, UINT8, UINT, const D3D12_RECT*) override	{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE ClearRenderTargetView(D3D12_CPU_DESCRIPTOR_HANDLE, const FLOAT[4], UINT, const D3D12_RECT*) override	{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE ClearUnorderedAccessViewUint(D3D12_GPU_DESCRIPTOR_HANDLE, D3D12_CPU_DESCRIPTOR_HANDLE, ID3D12Resource*, const UINT[4], UINT, const D3D12_RECT*) override	{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE ClearUnorderedAccessViewFloat(D3D12_GPU_DESCRIPTOR_HANDLE, D3D12_CPU_DESCRIPTOR_HANDLE, ID3D12Resource*, const FLOAT[4], UINT, const D3D12_RECT*) override	{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE DiscardResource(ID3D12Resource*, const D3D12_DISCARD_REGION*) override						{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE BeginQuery(ID3D12QueryHeap*, D3D12_QUERY_TYPE, UINT) override								{ m_recorded.commandListCalls++; m_recorded.queries++; }
+		void STDMETHODCALLTYPE EndQuery(ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE Type, UINT Index) override;
+		void STDMETHODCALLTYPE ResolveQueryData(ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE Type, UINT StartIndex, UINT NumQueries, ID3D12Resource* pDestinationBuffer, UINT64 AlignedDestinationBufferOffset) override;
+		void STDMETHODCALLTYPE SetPredication(ID3D12Resource*, UINT64, D3D12_PREDICATION_OP) override						{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE SetMarker(UINT, const void*, UINT) override													{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE BeginEvent(UINT, const void*, UINT) override													{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE EndEvent() override																			{ m_recorded.commandListCalls++; }
+		void STDMETHODCALLTYPE ExecuteIndirect(ID3D12CommandSignature*, UINT, ID3D12Resource*, UINT64, ID3D12Resource*, UINT64) override	{ m_recorded.commandListCalls++; m_recorded.drawCalls++; }
+
+		// 제출 시 장치가 순서대로 처리할 쿼리 작업입니다.
+		struct QueryOperation
+		{
+			NullQueryHeap*	heap;
+			bool			isResolve;
+			UINT			index;			// EndQuery의 슬롯 또는 Resolve의 시작 슬롯입니다.
+			UINT			count;
+			NullResource*	destination;
+			UINT64			destinationOffset;
+			UINT64			drawsBefore;	// 작업 이전에 기록된 그리기 수와 복사 바이트로 합성 타임스탬프를 계산합니다.
+			UINT64			copyBytesBefore;
+		};
+		const std::vector<QueryOperation>& GetQueryOperations() const	{ return m_queryOperations; }
+
+	private:
+		void RecordCopy(UINT64 bytes)
+		{
+			m_recorded.commandListCalls++;
+			m_recorded.copyCalls++;
+			m_recorded.copyBytes += bytes;
+		}
+
+		D3D12_COMMAND_LIST_TYPE	m_type;
+		NullDeviceStatistics	m_recorded;
+		std::vector<QueryOperation>	m_queryOperations;
+		bool					m_isOpen;
+	};
+
+	class NullCommandQueue : public NullDeviceChild<ID3D12CommandQueue, ID3D12Pageable>
+	{
+	public:
+		NullCommandQueue(NullDevice* device, const D3D12_COMMAND_QUEUE_DESC& desc);
+
+		void STDMETHODCALLTYPE UpdateTileMappings(ID3D12Resource*, UINT, const D3D12_TILED_RESOURCE_COORDINATE*, const D3D12_TILE_REGION_SIZE*, ID3D12Heap*, UINT, const D3D12_TILE_RANGE_FLAGS*, const UINT*, const UINT*, D3D12_TILE_MAPPING_FLAGS) override	{}
+		void STDMETHODCALLTYPE CopyTileMappings(ID3D12Resource*, const D3D12_TILED_RESOURCE_COORDINATE*, ID3D12Resource*, const D3D12_TILED_RESOURCE_COORDINATE*, const D3D12_TILE_REGION_SIZE*, D3D12_TILE_MAPPING_FLAGS) override	{}
+		void STDMETHODCALLTYPE ExecuteCommandLists(UINT NumCommandLists, ID3D12CommandList* const* ppCommandLists) override;
+		void STDMETHODCALLTYPE SetMarker(UINT, const void*, UINT) override		{}
+		void STDMETHODCALLTYPE BeginEvent(UINT, const void*, UINT) override		{}
+		void STDMETHODCALLTYPE EndEvent() override								{}
+		HRESULT STDMETHODCALLTYPE Signal(ID3D12Fence* pFence, UINT64 Value) override;
+		HRESULT STDMETHODCALLTYPE Wait(ID3D12Fence* pFence, UINT64 Value) override;
+		HRESULT STDMETHODCALLTYPE GetTimestampFrequency(UINT64* pFrequency) override;
+		HRESULT STDMETHODCALLTYPE GetClockCalibration(UINT64* pGpuTimestamp, UINT64* pCpuTimestamp) override;
+		D3D12_COMMAND_QUEUE_DESC STDMETHODCALLTYPE GetDesc() override			{ return m_desc; }
+
+	private:
+		D3D12_COMMAND_QUEUE_DESC m_desc;
+	};
+
+	// 이 앱이 사용하는 ID3D12Device 부분 집합의 헤드리스 대체 구현입니다.
+	// 실제 GPU 없이 명령 기록 및 제출의 CPU 비용을 측정하고 호출 수를 검증하는 데 사용합니다.
+	// fence는 기본적으로 신호 즉시 완료되며, SetGpuLatency로 GPU가 몇 개의 신호만큼 뒤처지는 타임라인을 흉내 낼 수 있습니다.
+	// 대기 중인 신호는 fence 참조를 유지하므로, 지연을 사용했다면 장치를 해제하기 전에 FlushGpu를 호출하세요.
+	class NullDevice : public NullObject<ID3D12Device>
+	{
+	public:
+		// 모든 설명자 형식에 사용하는 핸들 증분 크기입니다.
+		static const UINT c_descriptorIncrementSize = 32;
+
+		// 합성 GPU 타임스탬프 주파수(초당 눈금)입니다.
+		static const UINT64 c_timestampFrequency = 10000000;
+
+		NullDevice();
+
+		// GPU 타임라인을 구성합니다. latency가 0이면 모든 신호가 즉시 완료되고,
+		// N이면 큐에 N개의 신호가 더 쌓인 뒤에야 완료됩니다(N 프레임 뒤처진 GPU).
+		void SetGpuLatency(UINT latency);
+		UINT GetGpuLatency() const;
+
+		// 대기 중인 모든 신호를 완료합니다(GPU 유휴 상태).
+		void FlushGpu();
+
+		// 합성 타임스탬프에서 그리기 호출 및 복사 바이트당 GPU 비용(타임스탬프 눈금)을 설정합니다.
+		void SetSimulatedGpuCost(UINT64 ticksPerDraw, UINT64 ticksPerKilobyteCopied);
+
+		// 명령 할당기를 count개 더 만든 뒤에는 CreateCommandAllocator가 E_OUTOFMEMORY를 반환합니다(오류 경로 검사용).
+		// UINT_MAX이면 제한이 없습니다(기본값).
+		void SetCommandAllocatorBudget(UINT count);
+
+		NullDeviceStatistics GetStatistics() const;
+		void ResetStatistics();
+
+		// 대체 개체 간 내부 호출입니다.
+		void OnCommandListsExecuted(UINT count, ID3D12CommandList* const* ppCommandLists);
+		void OnQueueSignal(NullFence* fence, UINT64 value);
+		void OnQueueWait();
+		bool WaitForFence(NullFence* fence, UINT64 value);
+		void OnMap();
+		UINT64 ReadGpuTimestamp();
+
+		// ID3D12Device 메서드.
+		UINT STDMETHODCALLTYPE GetNodeCount() override	{ return 1; }
+		HRESULT STDMETHODCALLTYPE CreateCommandQueue(const D3D12_COMMAND_QUEUE_DESC* pDesc, REFIID riid, void** ppCommandQueue) override;
+		HRESULT STDMETHODCALLTYPE CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE type, REFIID riid, void** ppCommandAllocator) override;
+		HRESULT STDMETHODCALLTYPE CreateGraphicsPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC* pDesc, REFIID riid, void** ppPipelineState) override;
+		HRESULT STDMETHODCALLTYPE CreateComputePipelineState(const D3D12_COMPUTE_PIPELINE_STATE_DESC* pDesc, REFIID riid, void** ppPipelineState) override;
+		HRESULT STDMETHODCALLTYPE CreateCommandList(UINT nodeMask, D3D12_COMMAND_LIST_TYPE type, ID3D12CommandAllocator* pCommandAllocator, ID3D12PipelineState* pInitialState, REFIID riid, void** ppCommandList) override;
+		HRESULT STDMETHODCALLTYPE CheckFeatureSupport(D3D12_FEATURE Feature, void* pFeatureSupportData, UINT FeatureSupportDataSize) override;
+		HRESULT STDMETHODCALLTYPE CreateDescriptorHeap(const D3D12_DESCRIPTOR_HEAP_DESC* pDescriptorHeapDesc, REFIID riid, void** ppvHeap) override;
+		UINT STDMETHODCALLTYPE GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE) override	{ return c_descriptorIncrementSize; }
+		HRESULT STDMETHODCALLTYPE CreateRootSignature(UINT nodeMask, const void* pBlobWithRootSignature, SIZE_T blobLengthInBytes, REFIID riid, void** ppvRootSignature) override;
+		void STDMETHODCALLTYPE CreateConstantBufferView(const D3D12_CONSTANT_BUFFER_VIEW_DESC*, D3D12_CPU_DESCRIPTOR_HANDLE) override	{ OnDescriptorsCreated(1); }
+		void STDMETHODCALLTYPE CreateShaderResourceView(ID3D12Resource*, const D3D12_SHADER_RESOURCE_VIEW_DESC*, D3D12_CPU_DESCRIPTOR_HANDLE) override	{ OnDescriptorsCreated(1); }
+		void STDMETHODCALLTYPE CreateUnorderedAccessView(ID3D12Resource*, ID3D12Resource*, const D3D12_UNORDERED_ACCESS_VIEW_DESC*, D3D12_CPU_DESCRIPTOR_HANDLE) override	{ OnDescriptorsCreated(1); }
+		void STDMETHODCALLTYPE CreateRenderTargetView(ID3D12Resource*, const D3D12_RENDER_TARGET_VIEW_DESC*, D3D12_CPU_DESCRIPTOR_HANDLE) override	{ OnDescriptorsCreated(1); }
+		void STDMETHODCALLTYPE CreateDepthStencilView(ID3D12Resource*, const D3D12_DEPTH_STENCIL_VIEW_DESC*, D3D12_CPU_DESCRIPTOR_HANDLE) override	{ OnDescriptorsCreated(1); }
+		void STDMETHODCALLTYPE CreateSampler(const D3D12_SAMPLER_DESC*, D3D12_CPU_DESCRIPTOR_HANDLE) override	{ OnDescriptorsCreated(1); }
+		void STDMETHODCALLTYPE CopyDescriptors(UINT NumDestDescriptorRanges, const D3D12_CPU_DESCRIPTOR_HANDLE* pDestDescriptorRangeStarts, const UINT* pDestDescriptorRangeSizes, UINT NumSrcDescriptorRanges, const D3D12_CPU_DESCRIPTOR_HANDLE* pSrcDescriptorRangeStarts, const UINT* pSrcDescriptorRangeSizes, D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapsType) override;
+		void STDMETHODCALLTYPE CopyDescriptorsSimple(UINT NumDescriptors, D3D12_CPU_DESCRIPTOR_HANDLE, D3D12_CPU_DESCRIPTOR_HANDLE, D3D12_DESCRIPTOR_HEAP_TYPE) override	{ OnDescriptorsCreated(NumDescriptors); }
+		D3D12_RESOURCE_ALLOCATION_INFO STDMETHODCALLTYPE GetResourceAllocationInfo(UINT visibleMask, UINT numResourceDescs, const D3D12_RESOURCE_DESC* pResourceDescs) override;
+		D3D12_HEAP_PROPERTIES STDMETHODCALLTYPE GetCustomHeapProperties(UINT nodeMask, D3D12_HEAP_TYPE heapType) override;
+		HRESULT STDMETHODCALLTYPE CreateCommittedResource(const D3D12_HEAP_PROPERTIES* pHeapProperties, D3D12_HEAP_FLAGS HeapFlags, const D3D12_RESOURCE_DESC* pDesc, D3D12_RESOURCE_STATES InitialResourceState, const D3D12_CLEAR_VALUE* pOptimizedClearValue, REFIID riidResource, void** ppvResource) override;
+		HRESULT STDMETHODCALLTYPE CreateHeap(const D3D12_HEAP_DESC*, REFIID, void** ppvHeap) override								{ return NotImplemented(ppvHeap); }
+		HRESULT STDMETHODCALLTYPE CreatePlacedResource(ID3D12Heap*, UINT64, const D3D12_RESOURCE_DESC*, D3D12_RESOURCE_STATES, const D3D12_CLEAR_VALUE*, REFIID, void** ppvResource) override	{ return NotImplemented(ppvResource); }
+		HRESULT STDMETHODCALLTYPE CreateReservedResource(const D3D12_RESOURCE_DESC*, D3D12_RESOURCE_STATES, const D3D12_CLEAR_VALUE*, REFIID, void** ppvResource) override	{ return NotImplemented(ppvResource); }
+		HRESULT STDMETHODCALLTYPE CreateSharedHandle(ID3D12DeviceChild*, const SECURITY_ATTRIBUTES*, DWORD, LPCWSTR, HANDLE*) override	{ return E_NOTIMPL; }
+		HRESULT STDMETHODCALLTYPE OpenSharedHandle(HANDLE, REFIID, void** ppvObj) override												{ return NotImplemented(ppvObj); }
+		HRESULT STDMETHODCALLTYPE OpenSharedHandleByName(LPCWSTR, DWORD, HANDLE*) override												{ return E_NOTIMPL; }
+		HRESULT STDMETHODCALLTYPE MakeResident(UINT, ID3D12Pageable* const*) override													{ return S_OK; }
+		HRESULT STDMETHODCALLTYPE Evict(UINT, ID3D12Pageable* const*) override															{ return S_OK; }
+		HRESULT STDMETHODCALLTYPE CreateFence(UINT64 InitialValue, D3D12_FENCE_FLAGS Flags, REFIID riid, void** ppFence) override;
+		HRESULT STDMETHODCALLTYPE GetDeviceRemovedReason() override																	{ return S_OK; }
+		void STDMETHODCALLTYPE GetCopyableFootprints(const D3D12_RESOURCE_DESC* pResourceDesc, UINT FirstSubresource, UINT NumSubresources, UINT64 BaseOffset, D3D12_PLACED_SUBRESOURCE_FOOTPRINT* pLayouts, UINT* pNumRows, UINT64* pRowSizeInBytes, UINT64* pTotalBytes) override;
+		HRESULT STDMETHODCALLTYPE CreateQueryHeap(const D3D12_QUERY_HEAP_DESC* pDesc, REFIID riid, void** ppvHeap) override;
+		HRESULT STDMETHODCALLTYPE SetStablePowerState(BOOL) override																	{ return S_OK; }
+		HRESULT STDMETHODCALLTYPE CreateCommandSignature(const D3D12_COMMAND_SIGNATURE_DESC*, ID3D12RootSignature*, REFIID, void** ppvCommandSignature) override	{ return NotImplemented(ppvCommandSignature); }
+		void STDMETHODCALLTYPE GetResourceTiling(ID3D12Resource*, UINT* pNumTilesForEntireResource, D3D12_PACKED_MIP_INFO*, D3D12_TILE_SHAPE*, UINT* pNumSubresourceTilings, UINT, D3D12_SUBRESOURCE_TILING*) override;
+		LUID STDMETHODCALLTYPE GetAdapterLuid() override;
+
+	private:
+		// 대기 중인 큐 신호입니다.
+		struct PendingSignal
+		{
+			Microsoft::WRL::ComPtr<ID3D12Fence>	fence;
+			UINT64								value;
+		};
+
+		template<typename T>
+		HRESULT ReturnObject(T* object, REFIID riid, void** ppv)
+		{
+			HRESULT hr = object->QueryInterface(riid, ppv);
+			object->Release();
+			return hr;
+		}
+
+		static HRESULT NotImplemented(void** ppv)
+		{
+			if (ppv != nullptr)
+			{
+				*ppv = nullptr;
+			}
+			return E_NOTIMPL;
+		}
+
+		void OnDescriptorsCreated(UINT64 count);
+		void RetireOldestSignal();
+
+		// 개체 생성과 제출 통계입니다. 명령 목록 기록은 각 목록이 따로 세므로 여기서는 잠금이 드물게 쓰입니다.
+		mutable std::mutex							m_statisticsLock;
+		NullDeviceStatistics						m_statistics;
+		UINT										m_commandAllocatorBudget;
+
+		// 시뮬레이션된 GPU 타임라인입니다.
+		mutable std::mutex							m_timelineLock;
+		std::deque<PendingSignal>					m_pendingSignals;
+		UINT										m_gpuLatency;
+		UINT64										m_gpuTimestamp;
+		UINT64										m_ticksPerDraw;
+		UINT64										m_ticksPerKilobyteCopied;
+
+		// 가짜 GPU 가상 주소와 설명자 핸들의 할당기입니다.
+		std::atomic<UINT64>							m_nextGpuAddress;
+		std::atomic<UINT64>							m_nextDescriptorAddress;
+	};
+}
+
+// NullDeviceChild는 NullDevice의 완전한 정의가 필요하므로 여기에서 구현합니다.
+template<typename TInterface, typename... TBases>
+DX::NullDeviceChild<TInterface, TBases...>::NullDeviceChild(NullDevice* device) :
+	m_device(device)
+{
+	m_device->AddRef();
+}
+
+template<typename TInterface, typename... TBases>
+DX::NullDeviceChild<TInterface, TBases...>::~NullDeviceChild()
+{
+	m_device->Release();
+}
+
+template<typename TInterface, typename... TBases>
+HRESULT STDMETHODCALLTYPE DX::NullDeviceChild<TInterface, TBases...>::GetDevice(REFIID riid, void** ppvDevice)
+{
+	return m_device->QueryInterface(riid, ppvDevice);
+}
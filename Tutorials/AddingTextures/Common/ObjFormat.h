@@ -0,0 +1,363 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "ImportedMesh.h"
+#include "ParallelFor.h"
+
+namespace DX
+{
+	// Wavefront OBJ 파서입니다. 플랫폼 API에 의존하지 않으므로 도구와 헤드리스 빌드에서도 사용할 수 있습니다.
+	//
+	// v, vt, vn, f 줄만 읽고 그 밖의 줄(o, g, s, usemtl, mtllib, 주석 등)은 건너뜁니다.
+	// 면의 꼭짓점은 v, v/t, v//n, v/t/n 형식이며 음수(상대) 번호도 허용합니다. 다각형은 첫 꼭짓점을 기준으로 부채꼴로 나눕니다.
+	// 텍스처 좌표는 OBJ(왼쪽 아래 원점)에서 D3D(왼쪽 위 원점)로 v를 뒤집습니다.
+	namespace ObjDetail
+	{
+		// 파일을 줄 경계에서 나눈 조각입니다. 조각마다 독립적으로 읽은 뒤 번호를 맞춥니다.
+		static const std::size_t c_minChunkSize = 1 << 20;
+
+		// 면 꼭짓점입니다. index는 0부터 시작하는 위치/텍스처 좌표/법선 번호이고, 없으면 -1입니다.
+		// relative의 k번째 비트가 켜져 있으면 index[k]는 조각 안에서 센 상대 번호이므로 앞 조각까지의 개수를 더해야 합니다.
+		struct Corner
+		{
+			std::int64_t	index[3];
+			std::uint32_t	relative;
+		};
+
+		struct Chunk
+		{
+			Chunk() : valid(true) {}
+
+			std::vector<float>			positions;
+			std::vector<float>			texCoords;
+			std::vector<float>			normals;
+			std::vector<Corner>			corners;
+			std::vector<std::uint32_t>	faceSizes;
+			bool						valid;
+		};
+
+		// 줄이 keyword와 공백으로 시작하면 keyword 뒤를 반환합니다.
+		inline const char* MatchKeyword(const char* p, const char* lineEnd, const char* keyword)
+		{
+			for (; *keyword != '\0'; p++, keyword++)
+			{
+				if (p == lineEnd || *p != *keyword)
+				{
+					return nullptr;
+				}
+			}
+			return p < lineEnd && MeshImportDetail::IsSpace(*p) ? p : nullptr;
+		}
+
+		// 공백으로 구분된 실수를 최대 count개 읽습니다. 읽은 개수를 반환합니다.
+		inline std::uint32_t ParseFloats(const char* p, const char* lineEnd, float* values, std::uint32_t count)
+		{
+			std::uint32_t parsed = 0;
+			for (; parsed < count; parsed++)
+			{
+				p = MeshImportDetail::SkipSpaces(p, lineEnd);
+				if (!MeshImportDetail::ParseFloat(p, lineEnd, &values[parsed]))
+				{
+					break;
+				}
+			}
+			return parsed;
+		}
+
+		inline bool ParseCorner(const char*& p, const char* lineEnd, const std::size_t counts[3], Corner* corner)
+		{
+			corner->index[0] = corner->index[1] = corner->index[2] = -1;
+			corner->relative = 0;
+
+			for (std::uint32_t k = 0; k < 3; k++)
+			{
+				if (k > 0)
+				{
+					if (p == lineEnd || *p != '/')
+					{
+						break;
+					}
+					p++;
+					if (k == 1 && p < lineEnd && *p == '/')
+					{
+						continue;
+					}
+				}
+
+				std::int64_t value;
+				if (!MeshImportDetail::ParseInt(p, lineEnd, &value) || value == 0)
+				{
+					return false;
+				}
+				if (value > 0)
+				{
+					corner->index[k] = value - 1;
+				}
+				else
+				{
+					corner->index[k] = static_cast<std::int64_t>(counts[k]) + value;
+					corner->relative |= 1u << k;
+				}
+			}
+
+			return p == lineEnd || MeshImportDetail::IsSpace(*p);
+		}
+
+		inline void ParseChunk(const char* begin, const char* end, Chunk* chunk)
+		{
+			// 조각 크기로 개수를 어림하여 대부분의 재할당을 피합니다. 일반적인 OBJ 줄은 30바이트 안팎입니다.
+			const std::size_t expectedLines = static_cast<std::size_t>(end - begin) / 32;
+			chunk->positions.reserve(expectedLines * 3 / 2);
+			chunk->corners.reserve(expectedLines * 3 / 2);
+
+			for (const char* p = begin; p < end; )
+			{
+				const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+				if (lineEnd == nullptr)
+				{
+					lineEnd = end;
+				}
+				const char* line = MeshImportDetail::SkipSpaces(p, lineEnd);
+				p = lineEnd + 1;
+
+				const char* rest;
+				float values[3];
+				if ((rest = MatchKeyword(line, lineEnd, "v")) != nullptr)
+				{
+					if (ParseFloats(rest, lineEnd, values, 3) != 3)
+					{
+						chunk->valid = false;
+						return;
+					}
+					chunk->positions.insert(chunk->positions.end(), values, values + 3);
+				}
+				else if ((rest = MatchKeyword(line, lineEnd, "vt")) != nullptr)
+				{
+					values[1] = 0.0f;
+					if (ParseFloats(rest, lineEnd, values, 2) == 0)
+					{
+						chunk->valid = false;
+						return;
+					}
+					chunk->texCoords.push_back(values[0]);
+					chunk->texCoords.push_back(1.0f - values[1]);
+				}
+				else if ((rest = MatchKeyword(line, lineEnd, "vn")) != nullptr)
+				{
+					if (ParseFloats(rest, lineEnd, values, 3) != 3)
+					{
+						chunk->valid = false;
+						return;
+					}
+					chunk->normals.insert(chunk->normals.end(), values, values + 3);
+				}
+				else if ((rest = MatchKeyword(line, lineEnd, "f")) != nullptr)
+				{
+					const std::size_t counts[3] = { chunk->positions.size() / 3, chunk->texCoords.size() / 2, chunk->normals.size() / 3 };
+					std::uint32_t faceSize = 0;
+					for (;;)
+					{
+						rest = MeshImportDetail::SkipSpaces(rest, lineEnd);
+						if (rest == lineEnd || *rest == '#')
+						{
+							break;
+						}
+						Corner corner;
+						if (!ParseCorner(rest, lineEnd, counts, &corner))
+						{
+							chunk->valid = false;
+							return;
+						}
+						chunk->corners.push_back(corner);
+						faceSize++;
+					}
+					if (faceSize < 3)
+					{
+						chunk->valid = false;
+						return;
+					}
+					chunk->faceSizes.push_back(faceSize);
+				}
+			}
+		}
+	}
+
+	// OBJ 텍스트를 읽어 mesh를 채웁니다. 큰 파일은 줄 경계에서 조각으로 나누어 여러 스레드에서 읽고,
+	// 같은 (위치, 텍스처 좌표, 법선) 조합은 꼭짓점 하나로 합칩니다. 형식이 맞지 않거나 번호가 범위를 벗어나면 false를 반환합니다.
+	inline bool ParseObj(const char* data, std::size_t size, ImportedMesh* mesh)
+	{
+		using namespace ObjDetail;
+		using MeshImportDetail::VertexKeyTable;
+		using MeshImportDetail::c_missingAttribute;
+
+		const std::size_t maxChunkCount = static_cast<std::size_t>(GetHardwareThreadCount()) * 4;
+		const std::size_t chunkCount = (std::max)(static_cast<std::size_t>(1), (std::min)(size / c_minChunkSize, maxChunkCount));
+
+		std::vector<std::size_t> boundaries(chunkCount + 1, size);
+		boundaries[0] = 0;
+		for (std::size_t i = 1; i < chunkCount; i++)
+		{
+			const std::size_t start = (std::max)(size / chunkCount * i, boundaries[i - 1]);
+			const void* newline = std::memchr(data + start, '\n', size - start);
+			boundaries[i] = newline != nullptr ? static_cast<std::size_t>(static_cast<const char*>(newline) - data) + 1 : size;
+		}
+
+		std::vector<Chunk> chunks(chunkCount);
+		ParallelFor(static_cast<std::uint32_t>(chunkCount), [&](std::uint32_t i)
+		{
+			ParseChunk(data + boundaries[i], data + boundaries[i + 1], &chunks[i]);
+		});
+
+		// 조각별 개수의 앞쪽 합으로 상대 번호를 절대 번호로 바꾸고 범위를 검사합니다.
+		std::vector<std::size_t> prefixes(chunkCount * 3);
+		std::size_t totals[3] = {};
+		std::size_t cornerCount = 0;
+		std::size_t triangleCount = 0;
+		for (std::size_t i = 0; i < chunkCount; i++)
+		{
+			const Chunk& chunk = chunks[i];
+			if (!chunk.valid)
+			{
+				return false;
+			}
+			const std::size_t counts[3] = { chunk.positions.size() / 3, chunk.texCoords.size() / 2, chunk.normals.size() / 3 };
+			for (std::uint32_t k = 0; k < 3; k++)
+			{
+				prefixes[i * 3 + k] = totals[k];
+				totals[k] += counts[k];
+			}
+			cornerCount += chunk.corners.size();
+			for (std::uint32_t faceSize : chunk.faceSizes)
+			{
+				triangleCount += faceSize - 2;
+			}
+		}
+		if (totals[0] >= c_missingAttribute || cornerCount >= UINT32_MAX || triangleCount * 3 >= UINT32_MAX)
+		{
+			return false;
+		}
+
+		std::vector<char> resolved(chunkCount);
+		std::vector<char> usesAttribute(chunkCount * 2);
+		ParallelFor(static_cast<std::uint32_t>(chunkCount), [&](std::uint32_t i)
+		{
+			for (Corner& corner : chunks[i].corners)
+			{
+				for (std::uint32_t k = 0; k < 3; k++)
+				{
+					const bool relative = (corner.relative & (1u << k)) != 0;
+					if (!relative && corner.index[k] < 0)
+					{
+						if (k == 0)
+						{
+							return;
+						}
+						continue;
+					}
+					if (relative)
+					{
+						corner.index[k] += static_cast<std::int64_t>(prefixes[i * 3 + k]);
+					}
+					if (corner.index[k] < 0 || static_cast<std::size_t>(corner.index[k]) >= totals[k])
+					{
+						return;
+					}
+					if (k > 0)
+					{
+						usesAttribute[i * 2 + k - 1] = 1;
+					}
+				}
+			}
+			resolved[i] = 1;
+		});
+		if (std::find(resolved.begin(), resolved.end(), 0) != resolved.end())
+		{
+			return false;
+		}
+
+		// 번호를 맞춘 뒤에는 조각의 특성 배열을 파일 순서로 이어 붙입니다.
+		std::vector<float> positions, texCoords, normals;
+		positions.reserve(totals[0] * 3);
+		texCoords.reserve(totals[1] * 2);
+		normals.reserve(totals[2] * 3);
+		for (Chunk& chunk : chunks)
+		{
+			positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+			texCoords.insert(texCoords.end(), chunk.texCoords.begin(), chunk.texCoords.end());
+			normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+			std::vector<float>().swap(chunk.positions);
+			std::vector<float>().swap(chunk.texCoords);
+			std::vector<float>().swap(chunk.normals);
+		}
+
+		// 꼭짓점 합치기와 부채꼴 분할은 파일 순서를 지켜야 하므로 한 스레드에서 처리합니다.
+		VertexKeyTable table((std::min)(cornerCount, totals[0] * 2));
+		mesh->indices.resize(triangleCount * 3);
+		std::uint32_t* index = mesh->indices.data();
+		std::vector<std::uint32_t> faceVertices;
+		for (const Chunk& chunk : chunks)
+		{
+			const Corner* corner = chunk.corners.data();
+			for (std::uint32_t faceSize : chunk.faceSizes)
+			{
+				faceVertices.resize(faceSize);
+				for (std::uint32_t c = 0; c < faceSize; c++, corner++)
+				{
+					VertexKeyTable::Key key;
+					for (std::uint32_t k = 0; k < 3; k++)
+					{
+						key.index[k] = corner->index[k] < 0 ? c_missingAttribute : static_cast<std::uint32_t>(corner->index[k]);
+					}
+					faceVertices[c] = table.Insert(key);
+				}
+				for (std::uint32_t c = 2; c < faceSize; c++)
+				{
+					*index++ = faceVertices[0];
+					*index++ = faceVertices[c - 1];
+					*index++ = faceVertices[c];
+				}
+			}
+		}
+
+		const std::vector<VertexKeyTable::Key>& keys = table.GetKeys();
+		mesh->vertices.resize(keys.size());
+		ParallelForRowBlocks(static_cast<std::uint32_t>(keys.size()), sizeof(MeshVertex), 1 << 20, [&](std::uint32_t begin, std::uint32_t end)
+		{
+			for (std::uint32_t v = begin; v < end; v++)
+			{
+				const VertexKeyTable::Key& key = keys[v];
+				MeshVertex& vertex = mesh->vertices[v];
+				std::memcpy(vertex.position, &positions[key.index[0] * static_cast<std::size_t>(3)], sizeof(vertex.position));
+				if (key.index[2] != c_missingAttribute)
+				{
+					std::memcpy(vertex.normal, &normals[key.index[2] * static_cast<std::size_t>(3)], sizeof(vertex.normal));
+				}
+				else
+				{
+					vertex.normal[0] = vertex.normal[1] = vertex.normal[2] = 0.0f;
+				}
+				if (key.index[1] != c_missingAttribute)
+				{
+					std::memcpy(vertex.texCoord, &texCoords[key.index[1] * static_cast<std::size_t>(2)], sizeof(vertex.texCoord));
+				}
+				else
+				{
+					vertex.texCoord[0] = vertex.texCoord[1] = 0.0f;
+				}
+			}
+		});
+
+		mesh->hasNormals = false;
+		mesh->hasTexCoords = false;
+		for (std::size_t i = 0; i < chunkCount; i++)
+		{
+			mesh->hasTexCoords |= usesAttribute[i * 2] != 0;
+			mesh->hasNormals |= usesAttribute[i * 2 + 1] != 0;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,487 @@
+﻿#include "pch.h"
+#include "PackedVertex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "ParallelFor.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <emmintrin.h>
+#define DX_PACKED_VERTEX_SSE2
+#elif defined(_M_ARM) || defined(_M_ARM64) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DX_PACKED_VERTEX_NEON
+#endif
+
+using namespace DX;
+
+#if defined(_WIN32)
+namespace
+{
+	const D3D12_INPUT_ELEMENT_DESC c_positionColorElements[] =
+	{
+		{ "POSITION", 0, DXGI_FORMAT_R16G16B16A16_SNORM, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+		{ "COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, 8, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+	};
+
+	const D3D12_INPUT_ELEMENT_DESC c_positionColorTextureElements[] =
+	{
+		{ "POSITION", 0, DXGI_FORMAT_R16G16B16A16_SNORM, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+		{ "COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, 8, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+		{ "TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+	};
+
+	const D3D12_INPUT_ELEMENT_DESC c_positionNormalTextureElements[] =
+	{
+		{ "POSITION", 0, DXGI_FORMAT_R16G16B16A16_SNORM, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+		{ "NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0, 8, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+		{ "TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+	};
+}
+
+const D3D12_INPUT_LAYOUT_DESC PackedVertexPositionColor::InputLayout = { c_positionColorElements, _countof(c_positionColorElements) };
+const D3D12_INPUT_LAYOUT_DESC PackedVertexPositionColorTexture::InputLayout = { c_positionColorTextureElements, _countof(c_positionColorTextureElements) };
+const D3D12_INPUT_LAYOUT_DESC PackedVertexPositionNormalTexture::InputLayout = { c_positionNormalTextureElements, _countof(c_positionNormalTextureElements) };
+#endif
+
+namespace
+{
+	// 한 작업이 변환할 최소 원본 바이트 수입니다. 변환은 가벼우므로 작은 메시는 호출 스레드에서 바로 처리합니다.
+	const std::size_t c_minBytesPerBlock = 256 * 1024;
+
+	const float c_snorm16Max = 32767.0f;
+
+	// 네 꼭짓점의 같은 성분을 한 벡터에 담아 처리합니다(SoA). 플랫폼별로 필요한 연산만 감쌉니다.
+#if defined(DX_PACKED_VERTEX_SSE2)
+	typedef __m128	Float4;
+	typedef __m128i	Int4;
+
+	inline Float4 Load(const float* values)					{ return _mm_loadu_ps(values); }
+	inline Float4 Set(float x, float y, float z, float w)	{ return _mm_setr_ps(x, y, z, w); }
+	inline Float4 Splat(float value)						{ return _mm_set1_ps(value); }
+	inline Float4 Add(Float4 a, Float4 b)					{ return _mm_add_ps(a, b); }
+	inline Float4 Subtract(Float4 a, Float4 b)				{ return _mm_sub_ps(a, b); }
+	inline Float4 Multiply(Float4 a, Float4 b)				{ return _mm_mul_ps(a, b); }
+	inline Float4 Divide(Float4 a, Float4 b)				{ return _mm_div_ps(a, b); }
+	inline Float4 Min(Float4 a, Float4 b)					{ return _mm_min_ps(a, b); }
+	inline Float4 Max(Float4 a, Float4 b)					{ return _mm_max_ps(a, b); }
+	inline Float4 Abs(Float4 v)								{ return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); }
+
+	// 0 이상이면 1, 음수이면 -1입니다.
+	inline Float4 SignNotZero(Float4 v)						{ return _mm_or_ps(_mm_and_ps(v, _mm_set1_ps(-0.0f)), _mm_set1_ps(1.0f)); }
+
+	inline Float4 SelectNegative(Float4 condition, Float4 ifNegative, Float4 otherwise)
+	{
+		const __m128 mask = _mm_cmplt_ps(condition, _mm_setzero_ps());
+		return _mm_or_ps(_mm_and_ps(mask, ifNegative), _mm_andnot_ps(mask, otherwise));
+	}
+
+	// 가장 가까운 짝수로 반올림합니다(MXCSR 기본 모드).
+	inline Int4 Round(Float4 v)								{ return _mm_cvtps_epi32(v); }
+	inline Int4 SplatInt(std::int32_t value)				{ return _mm_set1_epi32(value); }
+	inline Int4 Or(Int4 a, Int4 b)							{ return _mm_or_si128(a, b); }
+	inline Int4 Low16(Int4 v)								{ return _mm_and_si128(v, _mm_set1_epi32(0xffff)); }
+	template<int Shift> inline Int4 ShiftLeft(Int4 v)		{ return _mm_slli_epi32(v, Shift); }
+	inline void Store(Int4 v, std::uint32_t* values)		{ _mm_storeu_si128(reinterpret_cast<__m128i*>(values), v); }
+
+	// 가장 가까운 짝수로 반올림하는 float -> half 변환입니다. 범위를 넘으면 무한대, NaN은 조용한 NaN이 됩니다.
+	// F16C는 SSE2 대상에서 보장되지 않으므로 비트 연산으로 계산합니다.
+	inline Int4 FloatToHalf4(Float4 value)
+	{
+		const __m128i signMask = _mm_set1_epi32(static_cast<int>(0x80000000u));
+		const __m128i halfOverflow = _mm_set1_epi32((127 + 16) << 23);
+		const __m128i minNormal = _mm_set1_epi32((127 - 14) << 23);
+		const __m128i subnormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+		const __m128i normalBias = _mm_set1_epi32(0xfff - ((127 - 15) << 23));
+
+		const __m128 sign = _mm_and_ps(_mm_castsi128_ps(signMask), value);
+		const __m128 absolute = _mm_xor_ps(value, sign);
+		const __m128i bits = _mm_castps_si128(absolute);
+
+		const __m128i isNaN = _mm_castps_si128(_mm_cmpunord_ps(absolute, absolute));
+		const __m128i isRegular = _mm_cmpgt_epi32(halfOverflow, bits);
+		const __m128i special = _mm_or_si128(_mm_and_si128(isNaN, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7c00));
+
+		// 결과가 비정규 수이면 마법 수를 더해 가수를 반올림합니다.
+		const __m128i isSubnormal = _mm_cmpgt_epi32(minNormal, bits);
+		const __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absolute, _mm_castsi128_ps(subnormalMagic))), subnormalMagic);
+
+		// 정규 수이면 지수를 옮기고, 잘리는 가수의 최하위 비트가 홀수이면 올림 쪽으로 1을 더합니다.
+		const __m128i odd = _mm_srai_epi32(_mm_slli_epi32(bits, 31 - 13), 31);
+		const __m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(bits, normalBias), odd), 13);
+
+		const __m128i finite = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+		const __m128i result = _mm_or_si128(_mm_and_si128(isRegular, finite), _mm_andnot_si128(isRegular, special));
+		return _mm_or_si128(result, _mm_srli_epi32(_mm_castps_si128(sign), 16));
+	}
+#elif defined(DX_PACKED_VERTEX_NEON)
+	typedef float32x4_t	Float4;
+	typedef int32x4_t	Int4;
+
+	inline Float4 Load(const float* values)					{ return vld1q_f32(values); }
+	inline Float4 Set(float x, float y, float z, float w)	{ return vsetq_lane_f32(w, vsetq_lane_f32(z, vsetq_lane_f32(y, vdupq_n_f32(x), 1), 2), 3); }
+	inline Float4 Splat(float value)						{ return vdupq_n_f32(value); }
+	inline Float4 Add(Float4 a, Float4 b)					{ return vaddq_f32(a, b); }
+	inline Float4 Subtract(Float4 a, Float4 b)				{ return vsubq_f32(a, b); }
+	inline Float4 Multiply(Float4 a, Float4 b)				{ return vmulq_f32(a, b); }
+	inline Float4 Min(Float4 a, Float4 b)					{ return vminq_f32(a, b); }
+	inline Float4 Max(Float4 a, Float4 b)					{ return vmaxq_f32(a, b); }
+	inline Float4 Abs(Float4 v)								{ return vabsq_f32(v); }
+
+	inline Float4 Divide(Float4 a, Float4 b)
+	{
+#if defined(_M_ARM64) || defined(__aarch64__)
+		return vdivq_f32(a, b);
+#else
+		// ARMv7에는 나눗셈이 없으므로 역수 추정을 뉴턴 반복으로 두 번 다듬습니다.
+		float32x4_t reciprocal = vrecpeq_f32(b);
+		reciprocal = vmulq_f32(vrecpsq_f32(b, reciprocal), reciprocal);
+		reciprocal = vmulq_f32(vrecpsq_f32(b, reciprocal), reciprocal);
+		return vmulq_f32(a, reciprocal);
+#endif
+	}
+
+	inline Float4 SignNotZero(Float4 v)
+	{
+		return vreinterpretq_f32_u32(vorrq_u32(vandq_u32(vreinterpretq_u32_f32(v), vdupq_n_u32(0x80000000u)), vreinterpretq_u32_f32(vdupq_n_f32(1.0f))));
+	}
+
+	inline Float4 SelectNegative(Float4 condition, Float4 ifNegative, Float4 otherwise)
+	{
+		return vbslq_f32(vcltq_f32(condition, vdupq_n_f32(0.0f)), ifNegative, otherwise);
+	}
+
+	inline Int4 Round(Float4 v)
+	{
+#if defined(_M_ARM64) || defined(__aarch64__)
+		return vcvtnq_s32_f32(v);
+#else
+		// ARMv7의 변환은 0 쪽으로 자르므로 부호에 맞춰 0.5를 더합니다(0.5는 0에서 먼 쪽으로 반올림).
+		return vcvtq_s32_f32(vaddq_f32(v, vbslq_f32(vcltq_f32(v, vdupq_n_f32(0.0f)), vdupq_n_f32(-0.5f), vdupq_n_f32(0.5f))));
+#endif
+	}
+
+	inline Int4 SplatInt(std::int32_t value)				{ return vdupq_n_s32(value); }
+	inline Int4 Or(Int4 a, Int4 b)							{ return vorrq_s32(a, b); }
+	inline Int4 Low16(Int4 v)								{ return vandq_s32(v, vdupq_n_s32(0xffff)); }
+	template<int Shift> inline Int4 ShiftLeft(Int4 v)		{ return vshlq_n_s32(v, Shift); }
+	inline void Store(Int4 v, std::uint32_t* values)		{ vst1q_u32(values, vreinterpretq_u32_s32(v)); }
+
+	inline Int4 FloatToHalf4(Float4 value)
+	{
+		return vreinterpretq_s32_u32(vmovl_u16(vreinterpret_u16_f16(vcvt_f16_f32(value))));
+	}
+#else
+	struct Float4	{ float v[4]; };
+	struct Int4		{ std::int32_t v[4]; };
+
+	template<typename TOperation>
+	inline Float4 Map(Float4 a, Float4 b, const TOperation& operation)
+	{
+		Float4 result;
+		for (int i = 0; i < 4; i++)
+		{
+			result.v[i] = operation(a.v[i], b.v[i]);
+		}
+		return result;
+	}
+
+	inline Float4 Load(const float* values)					{ Float4 result; memcpy(result.v, values, sizeof(result.v)); return result; }
+	inline Float4 Set(float x, float y, float z, float w)	{ Float4 result = { { x, y, z, w } }; return result; }
+	inline Float4 Splat(float value)						{ Float4 result = { { value, value, value, value } }; return result; }
+	inline Float4 Add(Float4 a, Float4 b)					{ return Map(a, b, [](float x, float y) { return x + y; }); }
+	inline Float4 Subtract(Float4 a, Float4 b)				{ return Map(a, b, [](float x, float y) { return x - y; }); }
+	inline Float4 Multiply(Float4 a, Float4 b)				{ return Map(a, b, [](float x, float y) { return x * y; }); }
+	inline Float4 Divide(Float4 a, Float4 b)				{ return Map(a, b, [](float x, float y) { return x / y; }); }
+	inline Float4 Min(Float4 a, Float4 b)					{ return Map(a, b, [](float x, float y) { return (std::min)(x, y); }); }
+	inline Float4 Max(Float4 a, Float4 b)					{ return Map(a, b, [](float x, float y) { return (std::max)(x, y); }); }
+	inline Float4 Abs(Float4 v)								{ return Map(v, v, [](float x, float) { return std::fabs(x); }); }
+	inline Float4 SignNotZero(Float4 v)						{ return Map(v, v, [](float x, float) { return std::signbit(x) ? -1.0f : 1.0f; }); }
+
+	inline Float4 SelectNegative(Float4 condition, Float4 ifNegative, Float4 otherwise)
+	{
+		Float4 result;
+		for (int i = 0; i < 4; i++)
+		{
+			result.v[i] = condition.v[i] < 0.0f ? ifNegative.v[i] : otherwise.v[i];
+		}
+		return result;
+	}
+
+	inline Int4 Round(Float4 v)
+	{
+		Int4 result;
+		for (int i = 0; i < 4; i++)
+		{
+			result.v[i] = static_cast<std::int32_t>(std::nearbyint(v.v[i]));
+		}
+		return result;
+	}
+
+	inline Int4 SplatInt(std::int32_t value)				{ Int4 result = { { value, value, value, value } }; return result; }
+	inline Int4 Or(Int4 a, Int4 b)							{ for (int i = 0; i < 4; i++) { a.v[i] |= b.v[i]; } return a; }
+	inline Int4 Low16(Int4 v)								{ for (int i = 0; i < 4; i++) { v.v[i] &= 0xffff; } return v; }
+	template<int Shift> inline Int4 ShiftLeft(Int4 v)		{ for (int i = 0; i < 4; i++) { v.v[i] = static_cast<std::int32_t>(static_cast<std::uint32_t>(v.v[i]) << Shift); } return v; }
+	inline void Store(Int4 v, std::uint32_t* values)		{ memcpy(values, v.v, sizeof(v.v)); }
+
+	inline Int4 FloatToHalf4(Float4 value)
+	{
+		Int4 result;
+		for (int i = 0; i < 4; i++)
+		{
+			result.v[i] = FloatToHalf(value.v[i]);
+		}
+		return result;
+	}
+#endif
+
+	inline Float4 Clamp(Float4 v, float low, float high)
+	{
+		return Min(Max(v, Splat(low)), Splat(high));
+	}
+
+	// 두 16비트 값을 32비트 하나(low가 앞쪽 성분)로 합칩니다.
+	inline Int4 Combine16(Int4 low, Int4 high)
+	{
+		return Or(Low16(low), ShiftLeft<16>(high));
+	}
+
+	// 네 꼭짓점의 앞쪽 componentCount개 성분을 성분별 벡터로 모읍니다. 남는 칸과 없는 성분은 fill입니다.
+	struct Gathered
+	{
+		Float4 components[4];
+	};
+
+	inline Gathered Gather(const float* source, std::size_t sourceStride, std::size_t first, std::size_t available, std::uint32_t componentCount, float fill)
+	{
+		const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(source) + sourceStride * first;
+		Gathered gathered;
+
+		// 네 꼭짓점이 모두 있으면 레지스터에서 바로 벡터를 만듭니다. 스택 배열에 성분을 하나씩 쓰고
+		// 16바이트로 다시 읽으면 저장 전달이 실패하여 변환 자체보다 느려집니다.
+		if (available == 4)
+		{
+			const float* vertex0 = reinterpret_cast<const float*>(bytes);
+			const float* vertex1 = reinterpret_cast<const float*>(bytes + sourceStride);
+			const float* vertex2 = reinterpret_cast<const float*>(bytes + sourceStride * 2);
+			const float* vertex3 = reinterpret_cast<const float*>(bytes + sourceStride * 3);
+			for (std::uint32_t c = 0; c < 4; c++)
+			{
+				gathered.components[c] = c < componentCount ? Set(vertex0[c], vertex1[c], vertex2[c], vertex3[c]) : Splat(fill);
+			}
+			return gathered;
+		}
+
+		float lanes[4][4];
+		for (std::uint32_t c = componentCount; c < 4; c++)
+		{
+			lanes[c][0] = lanes[c][1] = lanes[c][2] = lanes[c][3] = fill;
+		}
+
+		for (std::size_t i = 0; i < 4; i++)
+		{
+			const float* vertex = reinterpret_cast<const float*>(bytes + sourceStride * i);
+			for (std::uint32_t c = 0; c < componentCount; c++)
+			{
+				lanes[c][i] = i < available ? vertex[c] : fill;
+			}
+		}
+
+		for (std::uint32_t c = 0; c < 4; c++)
+		{
+			gathered.components[c] = Load(lanes[c]);
+		}
+		return gathered;
+	}
+
+	// 꼭짓점별 32비트 값 네 개를 destination의 각 꼭짓점 필드에 씁니다.
+	inline void Scatter(Int4 values, std::size_t first, std::size_t available, void* destination, std::size_t destinationStride, std::size_t fieldOffset)
+	{
+		std::uint32_t lanes[4];
+		Store(values, lanes);
+		std::uint8_t* bytes = static_cast<std::uint8_t*>(destination) + destinationStride * first + fieldOffset;
+		for (std::size_t i = 0; i < available; i++)
+		{
+			memcpy(bytes + destinationStride * i, &lanes[i], sizeof(lanes[i]));
+		}
+	}
+
+	// 꼭짓점을 네 개씩 묶어 kernel(first, available)을 호출합니다. 큰 스트림은 묶음 구간으로 나누어 여러 스레드에서 처리합니다.
+	template<typename TKernel>
+	void ForEachGroup(std::size_t count, std::size_t sourceBytesPerVertex, const TKernel& kernel)
+	{
+		const std::uint32_t groupCount = static_cast<std::uint32_t>((count + 3) / 4);
+		ParallelForRowBlocks(groupCount, sourceBytesPerVertex * 4, c_minBytesPerBlock, [&](std::uint32_t begin, std::uint32_t end)
+		{
+			for (std::uint32_t group = begin; group < end; group++)
+			{
+				const std::size_t first = static_cast<std::size_t>(group) * 4;
+				kernel(first, (std::min)(count - first, static_cast<std::size_t>(4)));
+			}
+		});
+	}
+}
+
+PositionQuantization DX::ComputePositionQuantization(const float* positions, std::size_t sourceStride, std::size_t count)
+{
+	float minimum[3] = { 0.0f, 0.0f, 0.0f };
+	float maximum[3] = { 0.0f, 0.0f, 0.0f };
+	const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(positions);
+	for (std::size_t i = 0; i < count; i++)
+	{
+		const float* position = reinterpret_cast<const float*>(bytes + sourceStride * i);
+		for (int c = 0; c < 3; c++)
+		{
+			minimum[c] = i == 0 ? position[c] : (std::min)(minimum[c], position[c]);
+			maximum[c] = i == 0 ? position[c] : (std::max)(maximum[c], position[c]);
+		}
+	}
+
+	PositionQuantization quantization;
+	for (int c = 0; c < 3; c++)
+	{
+		const float extent = (maximum[c] - minimum[c]) * 0.5f;
+		quantization.scale[c] = extent > 0.0f ? extent : 1.0f;
+		quantization.bias[c] = (maximum[c] + minimum[c]) * 0.5f;
+	}
+	return quantization;
+}
+
+void DX::PackPositions(const float* positions, std::size_t sourceStride, std::size_t count, const PositionQuantization& quantization, void* destination, std::size_t destinationStride)
+{
+	Float4 bias[3];
+	Float4 inverseScale[3];
+	for (int c = 0; c < 3; c++)
+	{
+		bias[c] = Splat(quantization.bias[c]);
+		inverseScale[c] = Splat(c_snorm16Max / quantization.scale[c]);
+	}
+
+	ForEachGroup(count, sizeof(float) * 3, [&](std::size_t first, std::size_t available)
+	{
+		const Gathered position = Gather(positions, sourceStride, first, available, 3, 0.0f);
+		Int4 snorm[3];
+		for (int c = 0; c < 3; c++)
+		{
+			snorm[c] = Round(Clamp(Multiply(Subtract(position.components[c], bias[c]), inverseScale[c]), -c_snorm16Max, c_snorm16Max));
+		}
+
+		Scatter(Combine16(snorm[0], snorm[1]), first, available, destination, destinationStride, 0);
+		Scatter(Combine16(snorm[2], SplatInt(32767)), first, available, destination, destinationStride, 4);
+	});
+}
+
+void DX::PackColors(const float* colors, std::size_t sourceStride, std::uint32_t componentCount, std::size_t count, void* destination, std::size_t destinationStride)
+{
+	ForEachGroup(count, sizeof(float) * componentCount, [&](std::size_t first, std::size_t available)
+	{
+		const Gathered color = Gather(colors, sourceStride, first, available, componentCount, 1.0f);
+		Int4 unorm[4];
+		for (int c = 0; c < 4; c++)
+		{
+			unorm[c] = Round(Multiply(Clamp(color.components[c], 0.0f, 1.0f), Splat(255.0f)));
+		}
+
+		Scatter(Or(Or(unorm[0], ShiftLeft<8>(unorm[1])), Or(ShiftLeft<16>(unorm[2]), ShiftLeft<24>(unorm[3]))), first, available, destination, destinationStride, 0);
+	});
+}
+
+void DX::PackNormals(const float* normals, std::size_t sourceStride, std::size_t count, void* destination, std::size_t destinationStride)
+{
+	ForEachGroup(count, sizeof(float) * 3, [&](std::size_t first, std::size_t available)
+	{
+		const Gathered normal = Gather(normals, sourceStride, first, available, 3, 0.0f);
+
+		// 법선을 L1 노름으로 나누어 팔면체 위에 놓고, 아래 반구(z < 0)는 위 반구의 바깥 삼각형으로 접습니다.
+		// 길이가 0인 법선은 (0, 0)이 되어 +z로 펼쳐집니다.
+		const Float4 norm = Max(Add(Add(Abs(normal.components[0]), Abs(normal.components[1])), Abs(normal.components[2])), Splat(1e-20f));
+		const Float4 x = Divide(normal.components[0], norm);
+		const Float4 y = Divide(normal.components[1], norm);
+		const Float4 foldedX = Multiply(Subtract(Splat(1.0f), Abs(y)), SignNotZero(x));
+		const Float4 foldedY = Multiply(Subtract(Splat(1.0f), Abs(x)), SignNotZero(y));
+		const Float4 encodedX = SelectNegative(normal.components[2], foldedX, x);
+		const Float4 encodedY = SelectNegative(normal.components[2], foldedY, y);
+
+		const Int4 snormX = Round(Multiply(Clamp(encodedX, -1.0f, 1.0f), Splat(c_snorm16Max)));
+		const Int4 snormY = Round(Multiply(Clamp(encodedY, -1.0f, 1.0f), Splat(c_snorm16Max)));
+		Scatter(Combine16(snormX, snormY), first, available, destination, destinationStride, 0);
+	});
+}
+
+void DX::PackTexCoords(const float* texCoords, std::size_t sourceStride, std::size_t count, void* destination, std::size_t destinationStride)
+{
+	ForEachGroup(count, sizeof(float) * 2, [&](std::size_t first, std::size_t available)
+	{
+		const Gathered texCoord = Gather(texCoords, sourceStride, first, available, 2, 0.0f);
+		Scatter(Combine16(FloatToHalf4(texCoord.components[0]), FloatToHalf4(texCoord.components[1])), first, available, destination, destinationStride, 0);
+	});
+}
+
+std::uint16_t DX::FloatToHalf(float value)
+{
+	std::uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	const std::uint32_t sign = bits & 0x80000000u;
+	bits ^= sign;
+
+	std::uint32_t half;
+	if (bits >= ((127 + 16) << 23))
+	{
+		// 범위를 넘으면 무한대, NaN은 조용한 NaN입니다.
+		half = bits > 0x7f800000u ? 0x7e00 : 0x7c00;
+	}
+	else if (bits < ((127 - 14) << 23))
+	{
+		// 비정규 수입니다. 0.5를 더해 가수를 하위 비트로 반올림합니다.
+		float magnitude;
+		memcpy(&magnitude, &bits, sizeof(magnitude));
+		magnitude += 0.5f;
+		memcpy(&half, &magnitude, sizeof(half));
+		half -= 0x3f000000u;
+	}
+	else
+	{
+		const std::uint32_t odd = (bits >> 13) & 1;
+		half = (bits + 0xfff - ((127 - 15) << 23) + odd) >> 13;
+	}
+	return static_cast<std::uint16_t>(half | (sign >> 16));
+}
+
+float DX::HalfToFloat(std::uint16_t value)
+{
+	const std::uint32_t sign = static_cast<std::uint32_t>(value & 0x8000) << 16;
+	const std::uint32_t exponent = (value >> 10) & 0x1f;
+	const std::uint32_t mantissa = value & 0x3ff;
+
+	float result;
+	if (exponent == 0)
+	{
+		result = std::ldexp(static_cast<float>(mantissa), -24);
+		return sign != 0 ? -result : result;
+	}
+
+	const std::uint32_t bits = exponent == 31 ?
+		sign | 0x7f800000u | (mantissa << 13) :
+		sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+	memcpy(&result, &bits, sizeof(result));
+	return result;
+}
+
+void DX::DecodeOctahedralNormal(const std::int16_t encoded[2], float normal[3])
+{
+	const float x = (std::max)(encoded[0] / c_snorm16Max, -1.0f);
+	const float y = (std::max)(encoded[1] / c_snorm16Max, -1.0f);
+	const float z = 1.0f - std::fabs(x) - std::fabs(y);
+	const float t = (std::max)(-z, 0.0f);
+
+	normal[0] = x + (x >= 0.0f ? -t : t);
+	normal[1] = y + (y >= 0.0f ? -t : t);
+	normal[2] = z;
+
+	const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+	for (int c = 0; c < 3; c++)
+	{
+		normal[c] /= length;
+	}
+}
@@ -0,0 +1,90 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace DX
+{
+	// 16비트 SNORM 위치를 원래 좌표로 되돌리는 메시별 값입니다. 원래 위치 = snorm * scale + bias입니다.
+	// 셰이더를 바꾸지 않도록 렌더러는 이 변환을 월드 행렬 앞에 곱합니다(GetPositionDequantizationMatrix).
+	struct PositionQuantization
+	{
+		float	scale[3];
+		float	bias[3];
+	};
+
+	// 압축 꼭짓점 형식입니다. 위치는 R16G16B16A16_SNORM(w = 1), 색은 R8G8B8A8_UNORM,
+	// 법선은 팔면체로 펼친 R16G16_SNORM, 텍스처 좌표는 R16G16_FLOAT입니다.
+	// 셰이더 입력은 float3/float2 그대로 두면 되고, 법선만 DecodeOctahedralNormal과 같은 식으로 펼쳐야 합니다.
+	// float3 n = float3(e, 1 - abs(e.x) - abs(e.y)); float t = saturate(-n.z); n.xy += n.xy >= 0 ? -t : t; n = normalize(n);
+	struct PackedVertexPositionColor
+	{
+		std::int16_t	position[4];
+		std::uint32_t	color;
+
+#if defined(_WIN32)
+		static const D3D12_INPUT_LAYOUT_DESC InputLayout;
+#endif
+	};
+
+	struct PackedVertexPositionColorTexture
+	{
+		std::int16_t	position[4];
+		std::uint32_t	color;
+		std::uint16_t	texCoord[2];
+
+#if defined(_WIN32)
+		static const D3D12_INPUT_LAYOUT_DESC InputLayout;
+#endif
+	};
+
+	struct PackedVertexPositionNormalTexture
+	{
+		std::int16_t	position[4];
+		std::int16_t	normal[2];
+		std::uint16_t	texCoord[2];
+
+#if defined(_WIN32)
+		static const D3D12_INPUT_LAYOUT_DESC InputLayout;
+#endif
+	};
+
+	static_assert(sizeof(PackedVertexPositionColor) == 12, "PackedVertexPositionColor는 입력 레이아웃과 같은 배치여야 합니다.");
+	static_assert(sizeof(PackedVertexPositionColorTexture) == 16, "PackedVertexPositionColorTexture는 입력 레이아웃과 같은 배치여야 합니다.");
+	static_assert(sizeof(PackedVertexPositionNormalTexture) == 16, "PackedVertexPositionNormalTexture는 입력 레이아웃과 같은 배치여야 합니다.");
+
+	// 아래 함수의 입력은 sourceStride바이트 간격의 float 스트림이고, 출력은 destinationStride바이트 간격의 꼭짓점 필드입니다.
+	// 예를 들어 VertexPositionColor 배열의 pos를 PackedVertexPositionColor 배열의 position으로 바로 옮길 수 있습니다.
+	// 네 꼭짓점씩 SSE2/NEON으로 변환하며, 큰 메시는 여러 스레드에서 나누어 처리합니다.
+	// 인터리브된 원본은 속성마다 다시 읽으므로 캐시에 들어가지 않는 큰 메시에서는 메모리 대역폭이 처리량을 정합니다.
+
+	// 위치(float3)의 경계 상자를 [-1, 1]로 옮기는 양자화 값입니다. 크기가 0인 축은 scale을 1로 두며, count가 0이면 항등 변환입니다.
+	PositionQuantization ComputePositionQuantization(const float* positions, std::size_t sourceStride, std::size_t count);
+
+	// 위치(float3)를 R16G16B16A16_SNORM(8바이트)으로 변환합니다.
+	void PackPositions(const float* positions, std::size_t sourceStride, std::size_t count, const PositionQuantization& quantization, void* destination, std::size_t destinationStride);
+
+	// 색(componentCount가 3이면 RGB, 4이면 RGBA)을 R8G8B8A8_UNORM(4바이트)으로 변환합니다. RGB이면 알파는 1입니다.
+	void PackColors(const float* colors, std::size_t sourceStride, std::uint32_t componentCount, std::size_t count, void* destination, std::size_t destinationStride);
+
+	// 단위 법선(float3)을 팔면체로 펼쳐 R16G16_SNORM(4바이트)으로 변환합니다.
+	void PackNormals(const float* normals, std::size_t sourceStride, std::size_t count, void* destination, std::size_t destinationStride);
+
+	// 텍스처 좌표(float2)를 R16G16_FLOAT(4바이트)으로 변환합니다. 반올림은 가장 가까운 짝수입니다.
+	void PackTexCoords(const float* texCoords, std::size_t sourceStride, std::size_t count, void* destination, std::size_t destinationStride);
+
+	// 도구와 검증용 스칼라 변환입니다.
+	std::uint16_t FloatToHalf(float value);
+	float HalfToFloat(std::uint16_t value);
+	void DecodeOctahedralNormal(const std::int16_t encoded[2], float normal[3]);
+
+#if defined(_WIN32)
+	// 양자화된 위치를 원래 좌표로 되돌리는 행렬입니다. 월드 행렬 앞에 곱합니다.
+	inline DirectX::XMMATRIX GetPositionDequantizationMatrix(const PositionQuantization& quantization)
+	{
+		return DirectX::XMMatrixMultiply(
+			DirectX::XMMatrixScaling(quantization.scale[0], quantization.scale[1], quantization.scale[2]),
+			DirectX::XMMatrixTranslation(quantization.bias[0], quantization.bias[1], quantization.bias[2]));
+	}
+#endif
+}
@@ -0,0 +1,114 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#if defined(_WIN32)
+#include <ppl.h>
+#else
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <vector>
+#endif
+
+namespace DX
+{
+	// 작업을 나눌 때 기준으로 삼는 하드웨어 스레드 수입니다. 알 수 없으면 1입니다.
+	inline std::uint32_t GetHardwareThreadCount()
+	{
+		return (std::max)(std::thread::hardware_concurrency(), 1u);
+	}
+
+	// [0, count)의 각 인덱스로 body(index)를 호출하고 모두 끝날 때까지 기다립니다.
+	// Windows에서는 PPL 작업 스케줄러를, 그 밖의 플랫폼(헤드리스 빌드)에서는 std::thread를 사용합니다.
+	// 작업이 하나이거나 하드웨어 스레드가 하나이면 호출 스레드에서 순서대로 실행합니다.
+	// body가 던진 예외는 모든 작업이 끝난 뒤 호출 스레드에서 다시 던집니다(PPL과 같은 동작).
+	template<typename TBody>
+	void ParallelFor(std::uint32_t count, const TBody& body)
+	{
+		const std::uint32_t hardwareThreads = GetHardwareThreadCount();
+		if (count <= 1 || hardwareThreads == 1)
+		{
+			for (std::uint32_t i = 0; i < count; i++)
+			{
+				body(i);
+			}
+			return;
+		}
+
+#if defined(_WIN32)
+		Concurrency::parallel_for(0u, count, [&](std::uint32_t i) { body(i); });
+#else
+		std::atomic<std::uint32_t> next(0);
+		std::mutex exceptionLock;
+		std::exception_ptr exception;
+		auto worker = [&]()
+		{
+			for (std::uint32_t i = next++; i < count; i = next++)
+			{
+				try
+				{
+					body(i);
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(exceptionLock);
+					if (!exception)
+					{
+						exception = std::current_exception();
+					}
+				}
+			}
+		};
+
+		std::vector<std::thread> threads;
+		const std::uint32_t threadCount = (std::min)(hardwareThreads, count);
+		for (std::uint32_t i = 1; i < threadCount; i++)
+		{
+			threads.emplace_back(worker);
+		}
+		worker();
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		if (exception)
+		{
+			std::rethrow_exception(exception);
+		}
+#endif
+	}
+
+	// [0, rowCount) 행을 연속 구간으로 나누어 body(begin, end)를 병렬로 호출합니다.
+	// 구간은 minBytesPerBlock 이상이 되게 하고, 부하가 고르도록 스레드 수의 몇 배까지 나눕니다. 작은 작업은 호출 스레드에서 한 번에 처리합니다.
+	template<typename TBody>
+	void ParallelForRowBlocks(std::uint32_t rowCount, std::size_t bytesPerRow, std::size_t minBytesPerBlock, const TBody& body)
+	{
+		const std::size_t totalBytes = bytesPerRow * rowCount;
+		const std::uint32_t hardwareThreads = GetHardwareThreadCount();
+
+		std::size_t blockCount = (std::min)(totalBytes / minBytesPerBlock, static_cast<std::size_t>(hardwareThreads) * 4);
+		blockCount = (std::min)(blockCount, static_cast<std::size_t>(rowCount));
+		if (blockCount <= 1 || hardwareThreads == 1)
+		{
+			if (rowCount != 0)
+			{
+				body(0u, rowCount);
+			}
+			return;
+		}
+
+		const std::uint32_t rowsPerBlock = static_cast<std::uint32_t>((rowCount + blockCount - 1) / blockCount);
+		blockCount = (rowCount + rowsPerBlock - 1) / rowsPerBlock;
+
+		ParallelFor(static_cast<std::uint32_t>(blockCount), [&](std::uint32_t block)
+		{
+			const std::uint32_t begin = block * rowsPerBlock;
+			body(begin, (std::min)(begin + rowsPerBlock, rowCount));
+		});
+	}
+}
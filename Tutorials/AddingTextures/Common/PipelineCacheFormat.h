@@ -0,0 +1,141 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <vector>
+
+namespace DX
+{
+	// 파이프라인 캐시 파일의 형식입니다. D3D 개체에 의존하지 않으므로 GPU 없이 검증할 수 있습니다.
+	//
+	// 헤더	: magic, version, entryCount, reserved (각 uint32)
+	// 목차	: entryCount개의 { hash, offset, size } (각 uint64, offset은 파일 시작 기준)
+	// 데이터	: 드라이버가 반환한 캐시된 PSO blob
+	// 모든 값은 little-endian입니다.
+	static const std::uint32_t c_pipelineCacheMagic = 0x434F5350;	// 'PSOC'
+	static const std::uint32_t c_pipelineCacheVersion = 1;
+
+	// 해시 -> 캐시된 blob입니다.
+	typedef std::map<std::uint64_t, std::vector<std::uint8_t>> PipelineCacheEntries;
+
+	// 64비트 FNV-1a 해시를 누적합니다.
+	class PipelineHasher
+	{
+	public:
+		PipelineHasher() : m_hash(14695981039346656037ull) {}
+
+		void AddBytes(const void* data, std::size_t size)
+		{
+			const std::uint8_t* bytes = static_cast<const std::uint8_t*>(data);
+			for (std::size_t i = 0; i < size; i++)
+			{
+				m_hash ^= bytes[i];
+				m_hash *= 1099511628211ull;
+			}
+		}
+
+		// 패딩이 없는 스칼라 값만 전달해야 합니다. 구조체는 필드별로 추가합니다.
+		template<typename T>
+		void Add(const T& value)
+		{
+			AddBytes(&value, sizeof(value));
+		}
+
+		// 길이를 함께 추가하여 연속된 문자열의 경계가 해시에 반영되도록 합니다.
+		void AddString(const char* value)
+		{
+			const std::uint32_t length = value != nullptr ? static_cast<std::uint32_t>(std::strlen(value)) : 0;
+			Add(length);
+			AddBytes(value, length);
+		}
+
+		// 크기와 내용을 함께 추가합니다.
+		void AddBlob(const void* data, std::size_t size)
+		{
+			Add(static_cast<std::uint64_t>(size));
+			AddBytes(data, size);
+		}
+
+		std::uint64_t Get() const	{ return m_hash; }
+
+	private:
+		std::uint64_t m_hash;
+	};
+
+	inline std::vector<std::uint8_t> SerializePipelineCache(const PipelineCacheEntries& entries)
+	{
+		const std::uint32_t header[4] = { c_pipelineCacheMagic, c_pipelineCacheVersion, static_cast<std::uint32_t>(entries.size()), 0 };
+		const std::size_t tableSize = entries.size() * 3 * sizeof(std::uint64_t);
+
+		std::size_t totalSize = sizeof(header) + tableSize;
+		for (const auto& entry : entries)
+		{
+			totalSize += entry.second.size();
+		}
+
+		std::vector<std::uint8_t> file(totalSize);
+		std::memcpy(file.data(), header, sizeof(header));
+
+		std::uint8_t* table = file.data() + sizeof(header);
+		std::uint64_t offset = sizeof(header) + tableSize;
+		for (const auto& entry : entries)
+		{
+			const std::uint64_t record[3] = { entry.first, offset, entry.second.size() };
+			std::memcpy(table, record, sizeof(record));
+			table += sizeof(record);
+
+			if (!entry.second.empty())
+			{
+				std::memcpy(file.data() + offset, entry.second.data(), entry.second.size());
+			}
+			offset += entry.second.size();
+		}
+
+		return file;
+	}
+
+	// 파일을 해석합니다. 형식이나 버전이 맞지 않거나 범위를 벗어나는 항목이 있으면 false를 반환하고 entries를 비웁니다.
+	inline bool ParsePipelineCache(const std::uint8_t* data, std::size_t size, PipelineCacheEntries* entries)
+	{
+		entries->clear();
+
+		std::uint32_t header[4];
+		if (data == nullptr || size < sizeof(header))
+		{
+			return false;
+		}
+
+		std::memcpy(header, data, sizeof(header));
+		if (header[0] != c_pipelineCacheMagic || header[1] != c_pipelineCacheVersion)
+		{
+			return false;
+		}
+
+		const std::uint64_t count = header[2];
+		const std::uint64_t recordSize = 3 * sizeof(std::uint64_t);
+		if (count > (size - sizeof(header)) / recordSize)
+		{
+			return false;
+		}
+
+		const std::uint8_t* table = data + sizeof(header);
+		for (std::uint64_t i = 0; i < count; i++)
+		{
+			std::uint64_t record[3];
+			std::memcpy(record, table + i * recordSize, sizeof(record));
+
+			const std::uint64_t offset = record[1];
+			const std::uint64_t length = record[2];
+			if (offset > size || length > size - offset)
+			{
+				entries->clear();
+				return false;
+			}
+
+			(*entries)[record[0]].assign(data + offset, data + offset + length);
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,263 @@
+﻿#include "pch.h"
+#include "PipelineStateCache.h"
+#include "DirectXHelper.h"
+
+#include <fstream>
+#include <iterator>
+
+using namespace DX;
+using namespace Microsoft::WRL;
+
+namespace
+{
+	void AddShader(PipelineHasher& hasher, const D3D12_SHADER_BYTECODE& shader)
+	{
+		hasher.AddBlob(shader.pShaderBytecode, shader.pShaderBytecode != nullptr ? shader.BytecodeLength : 0);
+	}
+
+	// 구조체에는 패딩이 있을 수 있으므로 모든 상태는 필드별로 해시합니다.
+	void AddBlendState(PipelineHasher& hasher, const D3D12_BLEND_DESC& blend)
+	{
+		hasher.Add(blend.AlphaToCoverageEnable);
+		hasher.Add(blend.IndependentBlendEnable);
+		for (const auto& target : blend.RenderTarget)
+		{
+			hasher.Add(target.BlendEnable);
+			hasher.Add(target.LogicOpEnable);
+			hasher.Add(target.SrcBlend);
+			hasher.Add(target.DestBlend);
+			hasher.Add(target.BlendOp);
+			hasher.Add(target.SrcBlendAlpha);
+			hasher.Add(target.DestBlendAlpha);
+			hasher.Add(target.BlendOpAlpha);
+			hasher.Add(target.LogicOp);
+			hasher.Add(target.RenderTargetWriteMask);
+		}
+	}
+
+	void AddRasterizerState(PipelineHasher& hasher, const D3D12_RASTERIZER_DESC& rasterizer)
+	{
+		hasher.Add(rasterizer.FillMode);
+		hasher.Add(rasterizer.CullMode);
+		hasher.Add(rasterizer.FrontCounterClockwise);
+		hasher.Add(rasterizer.DepthBias);
+		hasher.Add(rasterizer.DepthBiasClamp);
+		hasher.Add(rasterizer.SlopeScaledDepthBias);
+		hasher.Add(rasterizer.DepthClipEnable);
+		hasher.Add(rasterizer.MultisampleEnable);
+		hasher.Add(rasterizer.AntialiasedLineEnable);
+		hasher.Add(rasterizer.ForcedSampleCount);
+		hasher.Add(rasterizer.ConservativeRaster);
+	}
+
+	void AddStencilOp(PipelineHasher& hasher, const D3D12_DEPTH_STENCILOP_DESC& op)
+	{
+		hasher.Add(op.StencilFailOp);
+		hasher.Add(op.StencilDepthFailOp);
+		hasher.Add(op.StencilPassOp);
+		hasher.Add(op.StencilFunc);
+	}
+
+	void AddDepthStencilState(PipelineHasher& hasher, const D3D12_DEPTH_STENCIL_DESC& depthStencil)
+	{
+		hasher.Add(depthStencil.DepthEnable);
+		hasher.Add(depthStencil.DepthWriteMask);
+		hasher.Add(depthStencil.DepthFunc);
+		hasher.Add(depthStencil.StencilEnable);
+		hasher.Add(depthStencil.StencilReadMask);
+		hasher.Add(depthStencil.StencilWriteMask);
+		AddStencilOp(hasher, depthStencil.FrontFace);
+		AddStencilOp(hasher, depthStencil.BackFace);
+	}
+
+	void AddInputLayout(PipelineHasher& hasher, const D3D12_INPUT_LAYOUT_DESC& inputLayout)
+	{
+		hasher.Add(inputLayout.NumElements);
+		for (UINT i = 0; i < inputLayout.NumElements; i++)
+		{
+			const D3D12_INPUT_ELEMENT_DESC& element = inputLayout.pInputElementDescs[i];
+			hasher.AddString(element.SemanticName);
+			hasher.Add(element.SemanticIndex);
+			hasher.Add(element.Format);
+			hasher.Add(element.InputSlot);
+			hasher.Add(element.AlignedByteOffset);
+			hasher.Add(element.InputSlotClass);
+			hasher.Add(element.InstanceDataStepRate);
+		}
+	}
+
+	void AddStreamOutput(PipelineHasher& hasher, const D3D12_STREAM_OUTPUT_DESC& streamOutput)
+	{
+		hasher.Add(streamOutput.NumEntries);
+		for (UINT i = 0; i < streamOutput.NumEntries; i++)
+		{
+			const D3D12_SO_DECLARATION_ENTRY& entry = streamOutput.pSODeclaration[i];
+			hasher.Add(entry.Stream);
+			hasher.AddString(entry.SemanticName);
+			hasher.Add(entry.SemanticIndex);
+			hasher.Add(entry.StartComponent);
+			hasher.Add(entry.ComponentCount);
+			hasher.Add(entry.OutputSlot);
+		}
+
+		hasher.Add(streamOutput.NumStrides);
+		for (UINT i = 0; i < streamOutput.NumStrides; i++)
+		{
+			hasher.Add(streamOutput.pBufferStrides[i]);
+		}
+		hasher.Add(streamOutput.RasterizedStream);
+	}
+}
+
+UINT64 DX::HashGraphicsPipelineDesc(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, UINT64 rootSignatureHash)
+{
+	PipelineHasher hasher;
+	hasher.Add(rootSignatureHash);
+
+	AddShader(hasher, desc.VS);
+	AddShader(hasher, desc.PS);
+	AddShader(hasher, desc.DS);
+	AddShader(hasher, desc.HS);
+	AddShader(hasher, desc.GS);
+	AddStreamOutput(hasher, desc.StreamOutput);
+	AddBlendState(hasher, desc.BlendState);
+	hasher.Add(desc.SampleMask);
+	AddRasterizerState(hasher, desc.RasterizerState);
+	AddDepthStencilState(hasher, desc.DepthStencilState);
+	AddInputLayout(hasher, desc.InputLayout);
+	hasher.Add(desc.IBStripCutValue);
+	hasher.Add(desc.PrimitiveTopologyType);
+
+	hasher.Add(desc.NumRenderTargets);
+	for (UINT i = 0; i < desc.NumRenderTargets; i++)
+	{
+		hasher.Add(desc.RTVFormats[i]);
+	}
+	hasher.Add(desc.DSVFormat);
+	hasher.Add(desc.SampleDesc.Count);
+	hasher.Add(desc.SampleDesc.Quality);
+	hasher.Add(desc.NodeMask);
+	hasher.Add(desc.Flags);
+
+	// CachedPSO는 결과 개체를 바꾸지 않으므로 해시에 포함하지 않습니다.
+	return hasher.Get();
+}
+
+PipelineStateCache::PipelineStateCache(ID3D12Device* device, const std::wstring& cacheFilePath) :
+	m_device(device),
+	m_cacheFilePath(cacheFilePath),
+	m_dirty(false),
+	m_hitCount(0),
+	m_blobHitCount(0),
+	m_missCount(0)
+{
+	Load();
+}
+
+PipelineStateCache::~PipelineStateCache()
+{
+	// 소멸자에서는 예외를 던지지 않습니다. 저장하지 못한 blob은 다음 실행에서 다시 만들어집니다.
+	try
+	{
+		Save();
+	}
+	catch (...)
+	{
+	}
+}
+
+ComPtr<ID3D12PipelineState> PipelineStateCache::GetGraphicsPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, UINT64 rootSignatureHash)
+{
+	const UINT64 hash = HashGraphicsPipelineDesc(desc, rootSignatureHash);
+
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	auto existing = m_pipelineStates.find(hash);
+	if (existing != m_pipelineStates.end())
+	{
+		m_hitCount++;
+		return existing->second;
+	}
+
+	ComPtr<ID3D12PipelineState> pipelineState;
+
+	// 디스크에 blob이 있으면 먼저 사용합니다. 드라이버나 어댑터가 바뀌었으면 실패하므로 blob을 버리고 다시 컴파일합니다.
+	auto blob = m_blobs.find(hash);
+	if (blob != m_blobs.end() && !blob->second.empty())
+	{
+		D3D12_GRAPHICS_PIPELINE_STATE_DESC cachedDesc = desc;
+		cachedDesc.CachedPSO.pCachedBlob = blob->second.data();
+		cachedDesc.CachedPSO.CachedBlobSizeInBytes = blob->second.size();
+
+		if (SUCCEEDED(m_device->CreateGraphicsPipelineState(&cachedDesc, IID_PPV_ARGS(&pipelineState))))
+		{
+			m_blobHitCount++;
+		}
+		else
+		{
+			m_blobs.erase(blob);
+			m_dirty = true;
+		}
+	}
+
+	if (pipelineState == nullptr)
+	{
+		DX::ThrowIfFailed(m_device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&pipelineState)));
+		m_missCount++;
+
+		ComPtr<ID3DBlob> cachedBlob;
+		if (SUCCEEDED(pipelineState->GetCachedBlob(&cachedBlob)) && cachedBlob->GetBufferSize() > 0)
+		{
+			const UINT8* data = static_cast<const UINT8*>(cachedBlob->GetBufferPointer());
+			m_blobs[hash].assign(data, data + cachedBlob->GetBufferSize());
+			m_dirty = true;
+		}
+	}
+
+	m_pipelineStates[hash] = pipelineState;
+	return pipelineState;
+}
+
+void PipelineStateCache::Save()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	if (!m_dirty || m_cacheFilePath.empty())
+	{
+		return;
+	}
+
+	const std::vector<UINT8> file = SerializePipelineCache(m_blobs);
+
+	// 중간에 실패해도 기존 파일이 손상되지 않도록 임시 파일에 쓴 다음 교체합니다.
+	const std::wstring temporaryPath = m_cacheFilePath + L".tmp";
+	{
+		std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+		stream.write(reinterpret_cast<const char*>(file.data()), file.size());
+		if (!stream)
+		{
+			return;
+		}
+	}
+
+	if (MoveFileEx(temporaryPath.c_str(), m_cacheFilePath.c_str(), MOVEFILE_REPLACE_EXISTING))
+	{
+		m_dirty = false;
+	}
+}
+
+void PipelineStateCache::Load()
+{
+	std::ifstream stream(m_cacheFilePath, std::ios::binary);
+	if (!stream)
+	{
+		return;
+	}
+
+	const std::vector<UINT8> file((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+	// 형식이 맞지 않는 파일은 무시하고 다음 Save에서 덮어씁니다.
+	if (!ParsePipelineCache(file.data(), file.size(), &m_blobs))
+	{
+		m_dirty = true;
+	}
+}
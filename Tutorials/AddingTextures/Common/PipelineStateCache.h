@@ -0,0 +1,56 @@
+﻿#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "PipelineCacheFormat.h"
+
+namespace DX
+{
+	// 그래픽 파이프라인 설명 전체의 해시입니다. 셰이더 바이트 코드, 입력 레이아웃, 상태 및 형식을 포함합니다.
+	// 루트 서명 개체는 해시할 수 없으므로 직렬화된 루트 서명의 해시(HashRootSignature)를 함께 전달합니다.
+	UINT64 HashGraphicsPipelineDesc(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, UINT64 rootSignatureHash);
+
+	// 직렬화된 루트 서명 blob의 해시입니다.
+	inline UINT64 HashRootSignature(ID3DBlob* serializedRootSignature)
+	{
+		PipelineHasher hasher;
+		hasher.AddBlob(serializedRootSignature->GetBufferPointer(), serializedRootSignature->GetBufferSize());
+		return hasher.Get();
+	}
+
+	// 파이프라인 상태 개체의 캐시입니다.
+	// 같은 설명 해시에 대한 요청은 프로세스 안에서 하나의 개체를 공유하며, 드라이버가 반환한 캐시된 blob은
+	// 해시를 키로 디스크 파일에 저장되어 다음 실행이나 장치 재생성 시 컴파일 시간을 줄입니다.
+	class PipelineStateCache
+	{
+	public:
+		PipelineStateCache(ID3D12Device* device, const std::wstring& cacheFilePath);
+		~PipelineStateCache();
+
+		// 캐시된 개체를 반환하거나 새로 만듭니다. 여러 스레드에서 호출할 수 있습니다.
+		Microsoft::WRL::ComPtr<ID3D12PipelineState> GetGraphicsPipelineState(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, UINT64 rootSignatureHash);
+
+		// 새 blob이 있으면 캐시 파일을 씁니다.
+		void Save();
+
+		UINT GetHitCount() const		{ return m_hitCount; }		// 프로세스 안에서 재사용한 요청 수입니다.
+		UINT GetBlobHitCount() const	{ return m_blobHitCount; }	// 디스크의 blob으로 만든 개체 수입니다.
+		UINT GetMissCount() const		{ return m_missCount; }		// 처음부터 컴파일한 개체 수입니다.
+
+	private:
+		void Load();
+
+		Microsoft::WRL::ComPtr<ID3D12Device>	m_device;
+		std::wstring							m_cacheFilePath;
+
+		std::mutex								m_lock;
+		std::unordered_map<UINT64, Microsoft::WRL::ComPtr<ID3D12PipelineState>>	m_pipelineStates;
+		PipelineCacheEntries					m_blobs;
+		bool									m_dirty;
+
+		UINT									m_hitCount;
+		UINT									m_blobHitCount;
+		UINT									m_missCount;
+	};
+}
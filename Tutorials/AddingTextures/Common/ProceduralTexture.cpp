@@ -0,0 +1,344 @@
+﻿#include "pch.h"
+#include "ProceduralTexture.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "ParallelFor.h"
+
+#if defined(_WIN32)
+#include "DirectXHelper.h"
+#else
+#include <stdexcept>
+#endif
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <emmintrin.h>
+#define DX_PROCEDURAL_TEXTURE_SSE2
+#elif defined(_M_ARM) || defined(_M_ARM64) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DX_PROCEDURAL_TEXTURE_NEON
+#endif
+
+using namespace DX;
+
+namespace
+{
+	// 한 작업이 채울 최소 바이트 수입니다. 이보다 작은 텍스처는 호출 스레드에서 바로 생성합니다.
+	const std::size_t c_minBytesPerBlock = 256 * 1024;
+
+	void ThrowInvalidArgument()
+	{
+#if defined(_WIN32)
+		DX::ThrowIfFailed(E_INVALIDARG);
+#else
+		throw std::invalid_argument("invalid procedural texture argument");
+#endif
+	}
+
+	void ValidateDestination(const TextureDestination& destination)
+	{
+		if (destination.data == nullptr || destination.width == 0 || destination.height == 0 ||
+			destination.rowPitch < static_cast<std::size_t>(destination.width) * 4)
+		{
+			ThrowInvalidArgument();
+		}
+	}
+
+	std::uint32_t* GetRow(const TextureDestination& destination, std::uint32_t y)
+	{
+		return reinterpret_cast<std::uint32_t*>(destination.data + destination.rowPitch * y);
+	}
+
+	// 행을 [begin, end) 구간으로 나누어 generateRows(begin, end)를 병렬로 호출합니다.
+	template<typename TGenerateRows>
+	void ForEachRowBlock(const TextureDestination& destination, const TGenerateRows& generateRows)
+	{
+		DX::ParallelForRowBlocks(destination.height, static_cast<std::size_t>(destination.width) * 4, c_minBytesPerBlock, generateRows);
+	}
+
+	// 커널입니다. SIMD 경로와 스칼라 경로는 같은 순서로 연산하므로 같은 값을 냅니다.
+
+	void FillPixels(std::uint32_t* pixels, std::uint32_t count, std::uint32_t color)
+	{
+		std::uint32_t i = 0;
+#if defined(DX_PROCEDURAL_TEXTURE_SSE2)
+		const __m128i value = _mm_set1_epi32(static_cast<int>(color));
+		for (; i + 4 <= count; i += 4)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i), value);
+		}
+#elif defined(DX_PROCEDURAL_TEXTURE_NEON)
+		const uint32x4_t value = vdupq_n_u32(color);
+		for (; i + 4 <= count; i += 4)
+		{
+			vst1q_u32(pixels + i, value);
+		}
+#endif
+		for (; i < count; i++)
+		{
+			pixels[i] = color;
+		}
+	}
+
+	// values[i] += base + delta * weights[i]입니다.
+	void AccumulateSpan(float* values, const float* weights, std::uint32_t count, float base, float delta)
+	{
+		std::uint32_t i = 0;
+#if defined(DX_PROCEDURAL_TEXTURE_SSE2)
+		const __m128 baseVector = _mm_set1_ps(base);
+		const __m128 deltaVector = _mm_set1_ps(delta);
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 sample = _mm_add_ps(baseVector, _mm_mul_ps(deltaVector, _mm_loadu_ps(weights + i)));
+			_mm_storeu_ps(values + i, _mm_add_ps(_mm_loadu_ps(values + i), sample));
+		}
+#elif defined(DX_PROCEDURAL_TEXTURE_NEON)
+		const float32x4_t baseVector = vdupq_n_f32(base);
+		const float32x4_t deltaVector = vdupq_n_f32(delta);
+		for (; i + 4 <= count; i += 4)
+		{
+			const float32x4_t sample = vaddq_f32(baseVector, vmulq_f32(deltaVector, vld1q_f32(weights + i)));
+			vst1q_f32(values + i, vaddq_f32(vld1q_f32(values + i), sample));
+		}
+#endif
+		for (; i < count; i++)
+		{
+			const float sample = base + delta * weights[i];
+			values[i] = values[i] + sample;
+		}
+	}
+
+	// values[i] * scale를 반올림하여 [0, 255] 팔레트 색으로 바꿉니다.
+	void ResolvePalette(const float* values, std::uint32_t count, float scale, const std::uint32_t* palette, std::uint32_t* pixels)
+	{
+		std::uint32_t i = 0;
+#if defined(DX_PROCEDURAL_TEXTURE_SSE2)
+		const __m128 scaleVector = _mm_set1_ps(scale);
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 maximum = _mm_set1_ps(255.0f);
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 level = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(values + i), scaleVector), half);
+			level = _mm_min_ps(_mm_max_ps(level, zero), maximum);
+
+			alignas(16) std::int32_t indices[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(indices), _mm_cvttps_epi32(level));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i), _mm_setr_epi32(
+				static_cast<int>(palette[indices[0]]), static_cast<int>(palette[indices[1]]),
+				static_cast<int>(palette[indices[2]]), static_cast<int>(palette[indices[3]])));
+		}
+#elif defined(DX_PROCEDURAL_TEXTURE_NEON)
+		const float32x4_t scaleVector = vdupq_n_f32(scale);
+		const float32x4_t half = vdupq_n_f32(0.5f);
+		const float32x4_t zero = vdupq_n_f32(0.0f);
+		const float32x4_t maximum = vdupq_n_f32(255.0f);
+		for (; i + 4 <= count; i += 4)
+		{
+			float32x4_t level = vaddq_f32(vmulq_f32(vld1q_f32(values + i), scaleVector), half);
+			level = vminq_f32(vmaxq_f32(level, zero), maximum);
+
+			std::int32_t indices[4];
+			vst1q_s32(indices, vcvtq_s32_f32(level));
+			for (std::uint32_t lane = 0; lane < 4; lane++)
+			{
+				pixels[i + lane] = palette[indices[lane]];
+			}
+		}
+#endif
+		for (; i < count; i++)
+		{
+			float level = values[i] * scale + 0.5f;
+			level = (std::min)((std::max)(level, 0.0f), 255.0f);
+			pixels[i] = palette[static_cast<std::int32_t>(level)];
+		}
+	}
+
+	// 채널마다 start에서 end까지 position / (count - 1)만큼 보간하고 반올림합니다.
+	std::uint32_t LerpColor(std::uint32_t start, std::uint32_t end, std::uint32_t position, std::uint32_t count)
+	{
+		if (count <= 1)
+		{
+			return start;
+		}
+
+		const std::uint32_t span = count - 1;
+		std::uint32_t color = 0;
+		for (std::uint32_t shift = 0; shift < 32; shift += 8)
+		{
+			const std::uint32_t a = (start >> shift) & 0xff;
+			const std::uint32_t b = (end >> shift) & 0xff;
+			const std::uint32_t channel = (a * (span - position) + b * position + span / 2) / span;
+			color |= channel << shift;
+		}
+		return color;
+	}
+
+	// 격자점의 [0, 1] 값입니다.
+	float LatticeValue(std::uint32_t x, std::uint32_t y, std::uint32_t seed)
+	{
+		std::uint32_t hash = x * 0x8da6b343u ^ y * 0xd8163841u ^ seed * 0xcb1ab31fu;
+		hash ^= hash >> 16;
+		hash *= 0x7feb352du;
+		hash ^= hash >> 15;
+		hash *= 0x846ca68bu;
+		hash ^= hash >> 16;
+		return static_cast<float>(hash >> 8) * (1.0f / 16777215.0f);
+	}
+
+	float SmoothStep(float t)
+	{
+		return t * t * (3.0f - 2.0f * t);
+	}
+}
+
+void DX::GenerateChecker(const TextureDestination& destination, std::uint32_t cellWidth, std::uint32_t cellHeight, std::uint32_t evenColor, std::uint32_t oddColor)
+{
+	ValidateDestination(destination);
+	if (cellWidth == 0 || cellHeight == 0)
+	{
+		ThrowInvalidArgument();
+	}
+
+	// 칸 행의 패리티에 따라 두 가지 행만 존재하므로 한 번씩 만든 다음 각 행에 복사합니다.
+	const std::uint32_t width = destination.width;
+	std::vector<std::uint32_t> templateRows(static_cast<std::size_t>(width) * 2);
+	for (std::uint32_t x = 0; x < width; x += cellWidth)
+	{
+		const std::uint32_t count = (std::min)(cellWidth, width - x);
+		const bool evenCell = ((x / cellWidth) & 1) == 0;
+		FillPixels(&templateRows[x], count, evenCell ? evenColor : oddColor);
+		FillPixels(&templateRows[width + x], count, evenCell ? oddColor : evenColor);
+	}
+
+	ForEachRowBlock(destination, [&](std::uint32_t begin, std::uint32_t end)
+	{
+		for (std::uint32_t y = begin; y < end; y++)
+		{
+			const std::uint32_t* source = &templateRows[((y / cellHeight) & 1) * width];
+			memcpy(GetRow(destination, y), source, width * sizeof(std::uint32_t));
+		}
+	});
+}
+
+void DX::GenerateGradient(const TextureDestination& destination, GradientAxis axis, std::uint32_t startColor, std::uint32_t endColor)
+{
+	ValidateDestination(destination);
+
+	const std::uint32_t width = destination.width;
+	if (axis == GradientAxis::Horizontal)
+	{
+		// 모든 행이 같으므로 한 행을 만든 다음 복사합니다.
+		std::vector<std::uint32_t> templateRow(width);
+		for (std::uint32_t x = 0; x < width; x++)
+		{
+			templateRow[x] = LerpColor(startColor, endColor, x, width);
+		}
+
+		ForEachRowBlock(destination, [&](std::uint32_t begin, std::uint32_t end)
+		{
+			for (std::uint32_t y = begin; y < end; y++)
+			{
+				memcpy(GetRow(destination, y), templateRow.data(), width * sizeof(std::uint32_t));
+			}
+		});
+	}
+	else
+	{
+		ForEachRowBlock(destination, [&](std::uint32_t begin, std::uint32_t end)
+		{
+			for (std::uint32_t y = begin; y < end; y++)
+			{
+				FillPixels(GetRow(destination, y), width, LerpColor(startColor, endColor, y, destination.height));
+			}
+		});
+	}
+}
+
+void DX::GenerateValueNoise(const TextureDestination& destination, std::uint32_t cellSize, std::uint32_t octaves, std::uint32_t seed, std::uint32_t lowColor, std::uint32_t highColor)
+{
+	ValidateDestination(destination);
+	if (cellSize == 0 || octaves == 0)
+	{
+		ThrowInvalidArgument();
+	}
+
+	const std::uint32_t width = destination.width;
+	const std::uint32_t height = destination.height;
+
+	// 격자 간격이 1픽셀보다 작아지는 옥타브는 의미가 없으므로 생략합니다.
+	struct Octave
+	{
+		std::uint32_t		cellSize;
+		std::uint32_t		latticeWidth;
+		std::uint32_t		latticeHeight;
+		float				amplitude;
+		std::vector<float>	weights;	// 칸 안의 열 위치별 보간 가중치입니다.
+	};
+
+	std::vector<Octave> octaveTable;
+	float totalAmplitude = 0.0f;
+	for (std::uint32_t o = 0; o < octaves && (cellSize >> o) != 0; o++)
+	{
+		Octave octave;
+		octave.cellSize = cellSize >> o;
+		octave.latticeWidth = (width + octave.cellSize - 1) / octave.cellSize;
+		octave.latticeHeight = (height + octave.cellSize - 1) / octave.cellSize;
+		octave.amplitude = 1.0f / static_cast<float>(1u << o);
+		octave.weights.resize(octave.cellSize);
+		for (std::uint32_t i = 0; i < octave.cellSize; i++)
+		{
+			octave.weights[i] = SmoothStep(static_cast<float>(i) / octave.cellSize);
+		}
+		totalAmplitude += octave.amplitude;
+		octaveTable.push_back(std::move(octave));
+	}
+
+	std::uint32_t palette[256];
+	for (std::uint32_t i = 0; i < 256; i++)
+	{
+		palette[i] = LerpColor(lowColor, highColor, i, 256);
+	}
+	const float scale = 255.0f / totalAmplitude;
+
+	ForEachRowBlock(destination, [&](std::uint32_t begin, std::uint32_t end)
+	{
+		std::vector<float> values(width);
+		std::vector<float> latticeRow;
+
+		for (std::uint32_t y = begin; y < end; y++)
+		{
+			std::fill(values.begin(), values.end(), 0.0f);
+
+			for (std::uint32_t o = 0; o < octaveTable.size(); o++)
+			{
+				const Octave& octave = octaveTable[o];
+				const std::uint32_t octaveSeed = seed + o;
+
+				// 이 행과 위아래 격자 행 사이를 먼저 보간하면 열 방향은 칸마다 1차 보간 하나로 끝납니다.
+				const std::uint32_t latticeY0 = y / octave.cellSize;
+				const std::uint32_t latticeY1 = (latticeY0 + 1) % octave.latticeHeight;
+				const float weightY = SmoothStep(static_cast<float>(y % octave.cellSize) / octave.cellSize);
+
+				latticeRow.resize(octave.latticeWidth + 1);
+				for (std::uint32_t k = 0; k < octave.latticeWidth; k++)
+				{
+					const float top = LatticeValue(k, latticeY0, octaveSeed);
+					const float bottom = LatticeValue(k, latticeY1, octaveSeed);
+					latticeRow[k] = (top + (bottom - top) * weightY) * octave.amplitude;
+				}
+				latticeRow[octave.latticeWidth] = latticeRow[0];
+
+				for (std::uint32_t k = 0; k < octave.latticeWidth; k++)
+				{
+					const std::uint32_t x = k * octave.cellSize;
+					const std::uint32_t count = (std::min)(octave.cellSize, width - x);
+					AccumulateSpan(&values[x], octave.weights.data(), count, latticeRow[k], latticeRow[k + 1] - latticeRow[k]);
+				}
+			}
+
+			ResolvePalette(values.data(), width, scale, palette, GetRow(destination, y));
+		}
+	});
+}
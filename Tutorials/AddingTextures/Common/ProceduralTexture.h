@@ -0,0 +1,44 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace DX
+{
+	// RGBA8 픽셀 값입니다. 메모리 순서가 R, G, B, A이므로 리틀 엔디언 정수로는 0xAABBGGRR입니다.
+	inline std::uint32_t MakeRgba8(std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a = 0xff)
+	{
+		return static_cast<std::uint32_t>(r) | (static_cast<std::uint32_t>(g) << 8) | (static_cast<std::uint32_t>(b) << 16) | (static_cast<std::uint32_t>(a) << 24);
+	}
+
+	// 호출자가 제공한 RGBA8 대상입니다. rowPitch는 바이트 단위이며 width * 4 이상이어야 합니다.
+	// 업로드 버퍼의 배치 발자국(256바이트로 정렬된 행)에 직접 쓸 수 있으며, 행 사이의 여백은 건드리지 않습니다.
+	struct TextureDestination
+	{
+		std::uint8_t*	data;
+		std::uint32_t	width;
+		std::uint32_t	height;
+		std::size_t		rowPitch;
+	};
+
+	enum class GradientAxis
+	{
+		Horizontal,		// 왼쪽 열이 startColor, 오른쪽 열이 endColor입니다.
+		Vertical,		// 위쪽 행이 startColor, 아래쪽 행이 endColor입니다.
+	};
+
+	// 절차적 텍스처 생성기입니다. 모든 패턴은 행 단위로 생성하며, 큰 대상은 행 구간으로 나누어 여러 스레드에서 채웁니다.
+	// 행 채우기와 노이즈 누적은 SSE2(x86/x64) 또는 NEON(ARM) 커널을 사용하고, 그 밖의 플랫폼에서는 스칼라 코드를 사용합니다.
+	// 잘못된 인수(0인 크기, 너무 작은 rowPitch)는 E_INVALIDARG 예외를 발생시킵니다.
+
+	// cellWidth x cellHeight 픽셀 칸의 바둑판입니다. 왼쪽 위 칸과 같은 패리티의 칸은 evenColor입니다.
+	void GenerateChecker(const TextureDestination& destination, std::uint32_t cellWidth, std::uint32_t cellHeight, std::uint32_t evenColor, std::uint32_t oddColor);
+
+	// 두 색 사이의 선형 그러데이션입니다. 채널마다 정수로 반올림하여 보간합니다.
+	void GenerateGradient(const TextureDestination& destination, GradientAxis axis, std::uint32_t startColor, std::uint32_t endColor);
+
+	// 값 노이즈(fBm)입니다. 첫 옥타브의 격자 간격은 cellSize 픽셀이며, 옥타브마다 간격과 진폭이 절반이 됩니다.
+	// 격자는 텍스처 크기로 둘러싸므로 크기가 cellSize의 배수이면 이음매 없이 반복됩니다.
+	// 같은 seed는 같은 패턴을 냅니다.
+	void GenerateValueNoise(const TextureDestination& destination, std::uint32_t cellSize, std::uint32_t octaves, std::uint32_t seed, std::uint32_t lowColor, std::uint32_t highColor);
+}
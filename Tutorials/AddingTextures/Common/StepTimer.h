@@ -1,36 +1,117 @@
 ﻿#pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(_WIN32)
 #include <wrl.h>
+#endif
+
+#include "CpuProfiler.h"
+#include "FrameTimeRecorder.h"
 
 namespace DX
 {
+#if !defined(__cplusplus_winrt)
+	// C++/CX 외부(예: Linux의 헤드리스 빌드)에서는 기본 제공 정수 형식을 직접 정의합니다.
+	typedef std::int64_t	int64;
+	typedef std::uint64_t	uint64;
+	typedef std::uint32_t	uint32;
+#endif
+
+#if defined(_WIN32)
+	// QueryPerformanceCounter 기반의 기본 클록입니다.
+	class QpcClock
+	{
+	public:
+		uint64 GetFrequency() const
+		{
+			LARGE_INTEGER frequency;
+			if (!QueryPerformanceFrequency(&frequency))
+			{
+				throw ref new Platform::FailureException();
+			}
+			return frequency.QuadPart;
+		}
+
+		uint64 GetCounter() const
+		{
+			LARGE_INTEGER counter;
+			if (!QueryPerformanceCounter(&counter))
+			{
+				throw ref new Platform::FailureException();
+			}
+			return counter.QuadPart;
+		}
+	};
+#endif
+
+	// std::chrono::steady_clock 기반의 클록입니다. QPC가 없는 플랫폼에서 사용합니다.
+	class SteadyClock
+	{
+	public:
+		uint64 GetFrequency() const
+		{
+			return static_cast<uint64>(std::chrono::steady_clock::period::den / std::chrono::steady_clock::period::num);
+		}
+
+		uint64 GetCounter() const
+		{
+			return static_cast<uint64>(std::chrono::steady_clock::now().time_since_epoch().count());
+		}
+	};
+
+#if defined(_WIN32)
+	typedef QpcClock DefaultStepClock;
+#else
+	typedef SteadyClock DefaultStepClock;
+#endif
+
+	// 고정 timestep 모드에서 틱당 Update 예산을 모두 쓴 뒤 남은 지연을 처리하는 방법입니다.
+	enum class FixedStepBacklogPolicy
+	{
+		// 남은 전체 단계를 버리고 보간에 쓰이는 소수 부분만 유지합니다.
+		// 시뮬레이션이 실제 시간보다 느려지지만 따라잡기 위해 빨라지지 않습니다.
+		DropWholeSteps,
+
+		// 소수 부분에 더해 최대 한 단계의 지연을 다음 틱으로 넘겨 따라잡고 나머지 전체 단계는 버립니다.
+		// 느린 프레임이 계속되어도 넘긴 지연은 두 단계 미만으로 유지되므로 밀린 시간이 쌓이지 않습니다.
+		Carry,
+	};
+
 	// 애니메이션 및 시뮬레이션 타이밍용 도우미 클래스입니다.
-	class StepTimer
+	// TClock은 GetFrequency()와 GetCounter()를 제공해야 하며, 테스트에서는 스크립트된 클록을 주입할 수 있습니다.
+	template<typename TClock>
+	class BasicStepTimer
 	{
 	public:
-		StepTimer() : 
+		BasicStepTimer() :
+			BasicStepTimer(TClock())
+		{
+		}
+
+		explicit BasicStepTimer(const TClock& clock) :
+			m_clock(clock),
 			m_elapsedTicks(0),
 			m_totalTicks(0),
 			m_leftOverTicks(0),
 			m_frameCount(0),
 			m_framesPerSecond(0),
 			m_framesThisSecond(0),
-			m_qpcSecondCounter(0),
+			m_clockSecondCounter(0),
 			m_isFixedTimeStep(false),
-			m_targetElapsedTicks(TicksPerSecond / 60)
+			m_targetElapsedTicks(TicksPerSecond / 60),
+			m_maxUpdatesPerTick(c_defaultMaxUpdatesPerTick),
+			m_backlogPolicy(FixedStepBacklogPolicy::DropWholeSteps),
+			m_updatesThisTick(0),
+			m_droppedTicks(0)
 		{
-			if (!QueryPerformanceFrequency(&m_qpcFrequency))
-			{
-				throw ref new Platform::FailureException();
-			}
-
-			if (!QueryPerformanceCounter(&m_qpcLastTime))
-			{
-				throw ref new Platform::FailureException();
-			}
+			m_clockFrequency = m_clock.GetFrequency();
+			m_clockLastTime = m_clock.GetCounter();
 
 			// 최대 델타를 1초의 1/10로 초기화합니다.
-			m_qpcMaxDelta = m_qpcFrequency.QuadPart / 10;
+			m_clockMaxDelta = m_clockFrequency / 10;
 		}
 
 		// 이전 Update 호출 이후 경과한 시간을 가져옵니다.
@@ -47,6 +128,16 @@ namespace DX
 		// 현재 framerate를 가져옵니다.
 		uint32 GetFramesPerSecond() const					{ return m_framesPerSecond; }
 
+		// 최근 틱들의 프레임 시간 통계(백분위수, 히스토그램, 히치)를 가져옵니다.
+		FrameTimeStatistics GetFrameTimeStatistics() const	{ return m_frameTimes.GetStatistics(); }
+		const FrameTimeRecorder& GetFrameTimeRecorder() const	{ return m_frameTimes; }
+
+		// 프레임이 중앙값의 몇 배를 넘으면 히치로 보고할지 설정합니다.
+		void SetHitchMultiplier(double multiplier)			{ m_frameTimes.SetHitchMultiplier(multiplier); }
+
+		// 타이머가 사용하는 클록입니다.
+		TClock& GetClock()									{ return m_clock; }
+
 		// 고정 timestep 모드를 사용할지 가변 timestep 모드를 사용할지 설정합니다.
 		void SetFixedTimeStep(bool isFixedTimestep)			{ m_isFixedTimeStep = isFixedTimestep; }
 
@@ -54,55 +145,82 @@ namespace DX
 		void SetTargetElapsedTicks(uint64 targetElapsed)	{ m_targetElapsedTicks = targetElapsed; }
 		void SetTargetElapsedSeconds(double targetElapsed)	{ m_targetElapsedTicks = SecondsToTicks(targetElapsed); }
 
+		// 고정 timestep 모드에서 한 번의 Tick이 호출할 수 있는 최대 Update 수입니다. 0이면 제한하지 않습니다.
+		void SetMaxUpdatesPerTick(uint32 maxUpdates)		{ m_maxUpdatesPerTick = maxUpdates; }
+		uint32 GetMaxUpdatesPerTick() const					{ return m_maxUpdatesPerTick; }
+
+		// Update 예산을 초과한 지연을 처리하는 방법을 설정합니다.
+		void SetBacklogPolicy(FixedStepBacklogPolicy policy)	{ m_backlogPolicy = policy; }
+		FixedStepBacklogPolicy GetBacklogPolicy() const		{ return m_backlogPolicy; }
+
+		// 마지막 Tick에서 호출된 Update 수입니다.
+		uint32 GetUpdatesThisTick() const					{ return m_updatesThisTick; }
+
+		// 예산 초과로 시뮬레이션하지 않고 버린 총 시간입니다.
+		uint64 GetDroppedTicks() const						{ return m_droppedTicks; }
+
+		// 마지막 두 시뮬레이션 상태 사이의 렌더링 보간 계수(남은 시간의 소수 부분 / 목표 경과 시간)입니다.
+		// Carry 정책이 넘긴 전체 단계는 다음 틱의 Update 몫이므로 계수에 포함하지 않습니다.
+		// 가변 timestep 모드에서는 항상 최신 상태를 뜻하는 1을 반환합니다.
+		double GetInterpolationAlpha() const
+		{
+			if (!m_isFixedTimeStep || m_targetElapsedTicks == 0)
+			{
+				return 1.0;
+			}
+
+			return static_cast<double>(m_leftOverTicks % m_targetElapsedTicks) / m_targetElapsedTicks;
+		}
+
 		// 정수 형식은 초당 10,000,000 눈금을 사용하는 시간을 나타냅니다.
 		static const uint64 TicksPerSecond = 10000000;
 
 		static double TicksToSeconds(uint64 ticks)			{ return static_cast<double>(ticks) / TicksPerSecond; }
 		static uint64 SecondsToTicks(double seconds)		{ return static_cast<uint64>(seconds * TicksPerSecond); }
 
+		// 목표 60fps에서 약 83밀리초의 지연까지 따라잡을 수 있는 기본 Update 예산입니다.
+		static const uint32 c_defaultMaxUpdatesPerTick = 5;
+
 		// 의도적인 타이밍 중지 후(예: IO 차단 작업)
 		// 이 항목을 호출하여 catch-up 설정을 시도하는 고정 timestep 논리를 방지합니다.
 		// Update 호출입니다.
 
 		void ResetElapsedTime()
 		{
-			if (!QueryPerformanceCounter(&m_qpcLastTime))
-			{
-				throw ref new Platform::FailureException();
-			}
+			m_clockLastTime = m_clock.GetCounter();
 
 			m_leftOverTicks = 0;
 			m_framesPerSecond = 0;
 			m_framesThisSecond = 0;
-			m_qpcSecondCounter = 0;
+			m_clockSecondCounter = 0;
 		}
 
 		// 지정된 Update 함수를 적당한 횟수로 호출하여 타이머 상태를 업데이트합니다.
 		template<typename TUpdate>
 		void Tick(const TUpdate& update)
 		{
+			DX_CPU_ZONE("StepTimer::Tick");
+
 			// 현재 시간을 쿼리합니다.
-			LARGE_INTEGER currentTime;
+			const uint64 currentTime = m_clock.GetCounter();
 
-			if (!QueryPerformanceCounter(&currentTime))
-			{
-				throw ref new Platform::FailureException();
-			}
+			uint64 timeDelta = currentTime - m_clockLastTime;
 
-			uint64 timeDelta = currentTime.QuadPart - m_qpcLastTime.QuadPart;
+			m_clockLastTime = currentTime;
+			m_clockSecondCounter += timeDelta;
 
-			m_qpcLastTime = currentTime;
-			m_qpcSecondCounter += timeDelta;
+			// 히치를 숨기지 않도록 제한하기 전의 실제 프레임 시간을 기록합니다.
+			m_frameTimes.Record(ClockToTicks(timeDelta));
 
 			// 너무 큰 시간 델타를 제한합니다(예: 디버거에서 일시 중지된 후).
-			if (timeDelta > m_qpcMaxDelta)
+			if (timeDelta > m_clockMaxDelta)
 			{
-				timeDelta = m_qpcMaxDelta;
+				timeDelta = m_clockMaxDelta;
 			}
 
-			// QPC 단위를 정규 눈금 형식으로 변환합니다. 이전의 제한으로 인해 오버플로할 수 없습니다.
+			// 클록 단위를 정규 눈금 형식으로 변환합니다. 이전의 제한으로 인해 오버플로할 수 없습니다.
 			timeDelta *= TicksPerSecond;
-			timeDelta /= m_qpcFrequency.QuadPart;
+			timeDelta /= m_clockFrequency;
 
 			uint32 lastFrameCount = m_frameCount;
 
@@ -117,19 +235,29 @@ namespace DX
 				// 사소한 오류가 누적되어 결국 프레임이 삭제될 수 있습니다. 반올림하는 것이 좋습니다.
 				// 작은 편차를 0으로 줄여 원활하게 실행될 수 있도록 하세요.
 
-				if (abs(static_cast<int64>(timeDelta - m_targetElapsedTicks)) < TicksPerSecond / 4000)
+				if (std::llabs(static_cast<int64>(timeDelta - m_targetElapsedTicks)) < static_cast<int64>(TicksPerSecond / 4000))
 				{
 					timeDelta = m_targetElapsedTicks;
 				}
 
 				m_leftOverTicks += timeDelta;
+				m_updatesThisTick = 0;
 
 				while (m_leftOverTicks >= m_targetElapsedTicks)
 				{
+					// 예산을 모두 쓰면 더 이상 Update를 호출하지 않습니다. 느린 프레임이 더 많은 Update를 부르고
+					// 그 Update가 다시 프레임을 늦추는 악순환을 막습니다.
+					if (m_maxUpdatesPerTick != 0 && m_updatesThisTick >= m_maxUpdatesPerTick)
+					{
+						DropBacklog();
+						break;
+					}
+
 					m_elapsedTicks = m_targetElapsedTicks;
 					m_totalTicks += m_targetElapsedTicks;
 					m_leftOverTicks -= m_targetElapsedTicks;
 					m_frameCount++;
+					m_updatesThisTick++;
 
 					update();
 				}
@@ -141,6 +269,7 @@ namespace DX
 				m_totalTicks += timeDelta;
 				m_leftOverTicks = 0;
 				m_frameCount++;
+				m_updatesThisTick = 1;
 
 				update();
 			}
@@ -151,19 +280,43 @@ namespace DX
 				m_framesThisSecond++;
 			}
 
-			if (m_qpcSecondCounter >= static_cast<uint64>(m_qpcFrequency.QuadPart))
+			if (m_clockSecondCounter >= m_clockFrequency)
 			{
 				m_framesPerSecond = m_framesThisSecond;
 				m_framesThisSecond = 0;
-				m_qpcSecondCounter %= m_qpcFrequency.QuadPart;
+				m_clockSecondCounter %= m_clockFrequency;
 			}
 		}
 
 	private:
-		// 원본 타이밍 데이터에는 QPC 단위가 사용됩니다.
-		LARGE_INTEGER m_qpcFrequency;
-		LARGE_INTEGER m_qpcLastTime;
-		uint64 m_qpcMaxDelta;
+		// Update 예산을 초과한 남은 시간을 정책에 따라 버립니다.
+		void DropBacklog()
+		{
+			uint64 keep = m_leftOverTicks % m_targetElapsedTicks;
+
+			// 한 단계만 넘기므로 다음 틱은 예산보다 최대 한 번 더 따라잡을 수 있을 뿐이고,
+			// 지속적으로 느린 프레임에서도 넘긴 지연이 누적되지 않고 매 틱 버려집니다.
+			if (m_backlogPolicy == FixedStepBacklogPolicy::Carry && m_leftOverTicks - keep >= m_targetElapsedTicks)
+			{
+				keep += m_targetElapsedTicks;
+			}
+
+			m_droppedTicks += m_leftOverTicks - keep;
+			m_leftOverTicks = keep;
+		}
+
+		// 제한되지 않은 클록 델타를 눈금으로 변환합니다. 긴 정지에서도 오버플로하지 않도록 나누어 계산합니다.
+		uint64 ClockToTicks(uint64 clockDelta) const
+		{
+			return (clockDelta / m_clockFrequency) * TicksPerSecond +
+				(clockDelta % m_clockFrequency) * TicksPerSecond / m_clockFrequency;
+		}
+
+		// 원본 타이밍 데이터에는 클록 단위가 사용됩니다.
+		TClock m_clock;
+		uint64 m_clockFrequency;
+		uint64 m_clockLastTime;
+		uint64 m_clockMaxDelta;
 
 		// 파생된 타이밍 데이터에는 정식 눈금 형식이 사용됩니다.
 		uint64 m_elapsedTicks;
@@ -174,10 +327,21 @@ namespace DX
 		uint32 m_frameCount;
 		uint32 m_framesPerSecond;
 		uint32 m_framesThisSecond;
-		uint64 m_qpcSecondCounter;
+		uint64 m_clockSecondCounter;
+
+		// 프레임 시간 분포 추적용 멤버입니다.
+		FrameTimeRecorder m_frameTimes;
 
 		// 고정 timestep 모드 구성용 멤버입니다.
 		bool m_isFixedTimeStep;
 		uint64 m_targetElapsedTicks;
+		uint32 m_maxUpdatesPerTick;
+		FixedStepBacklogPolicy m_backlogPolicy;
+
+		// 따라잡기 추적용 멤버입니다.
+		uint32 m_updatesThisTick;
+		uint64 m_droppedTicks;
 	};
+
+	typedef BasicStepTimer<DefaultStepClock> StepTimer;
 }
@@ -0,0 +1,181 @@
+﻿#include "pch.h"
+#include "SubresourceCopy.h"
+
+#include <algorithm>
+#include <cstring>
+#include "ParallelFor.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <emmintrin.h>
+#define DX_SUBRESOURCE_COPY_SSE2
+#endif
+
+using namespace DX;
+
+namespace
+{
+	// 한 작업이 복사할 최소 바이트 수입니다. 이보다 작은 하위 리소스는 스레드를 깨우는 비용이 더 크므로 호출 스레드에서 복사합니다.
+	const std::size_t c_minBytesPerBlock = 1024 * 1024;
+
+	// 행으로 나눌 수 없는 연속 구간(버퍼, 빽빽한 텍스처)을 작업으로 나눌 때의 단위입니다.
+	const std::size_t c_spanChunkSize = 64 * 1024;
+
+	// 이보다 짧은 구간은 정렬을 맞추는 비용이 더 크므로 memcpy로 복사합니다.
+	const std::size_t c_minStreamingSize = 256;
+
+	// 대상 캐시 줄을 읽어 오지 않고 쓰기 결합 버퍼로 바로 내보내는 복사입니다.
+	// 대상을 16바이트로 정렬한 뒤 64바이트씩 스트리밍 저장하고, 앞뒤의 나머지는 memcpy로 복사합니다.
+	// 스트리밍 저장의 순서는 보장되지 않으므로 복사를 마친 스레드가 FenceStreamingStores를 호출해야 합니다.
+	void StreamingCopy(std::uint8_t* destination, const std::uint8_t* source, std::size_t size)
+	{
+#if defined(DX_SUBRESOURCE_COPY_SSE2)
+		if (size < c_minStreamingSize)
+		{
+			memcpy(destination, source, size);
+			return;
+		}
+
+		const std::size_t head = (16 - (reinterpret_cast<std::uintptr_t>(destination) & 15)) & 15;
+		memcpy(destination, source, head);
+		destination += head;
+		source += head;
+		size -= head;
+
+		for (; size >= 64; size -= 64, destination += 64, source += 64)
+		{
+			const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+			const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 16));
+			const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 32));
+			const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 48));
+			_mm_stream_si128(reinterpret_cast<__m128i*>(destination), a);
+			_mm_stream_si128(reinterpret_cast<__m128i*>(destination + 16), b);
+			_mm_stream_si128(reinterpret_cast<__m128i*>(destination + 32), c);
+			_mm_stream_si128(reinterpret_cast<__m128i*>(destination + 48), d);
+		}
+		for (; size >= 16; size -= 16, destination += 16, source += 16)
+		{
+			_mm_stream_si128(reinterpret_cast<__m128i*>(destination), _mm_loadu_si128(reinterpret_cast<const __m128i*>(source)));
+		}
+		memcpy(destination, source, size);
+#else
+		// ARM에는 스트리밍 저장 내장 함수가 없습니다. 쓰기 결합 메모리에서는 일반 저장도 캐시를 거치지 않습니다.
+		memcpy(destination, source, size);
+#endif
+	}
+
+	void FenceStreamingStores()
+	{
+#if defined(DX_SUBRESOURCE_COPY_SSE2)
+		_mm_sfence();
+#endif
+	}
+
+	void CopySpan(std::uint8_t* destination, const std::uint8_t* source, std::size_t size, CopyDestinationMemory memory)
+	{
+		if (memory == CopyDestinationMemory::WriteCombined)
+		{
+			StreamingCopy(destination, source, size);
+		}
+		else
+		{
+			memcpy(destination, source, size);
+		}
+	}
+}
+
+void DX::CopySubresource(
+	std::uint8_t* destination,
+	std::size_t destinationRowPitch,
+	std::size_t destinationSlicePitch,
+	const std::uint8_t* source,
+	std::size_t sourceRowPitch,
+	std::size_t sourceSlicePitch,
+	std::size_t rowSize,
+	std::uint32_t rowCount,
+	std::uint32_t sliceCount,
+	CopyDestinationMemory memory,
+	bool parallel)
+{
+	if (rowSize == 0 || rowCount == 0 || sliceCount == 0)
+	{
+		return;
+	}
+
+	// 조각 사이에 여백이 없으면 모든 조각을 하나의 높은 조각으로 봅니다.
+	if (sliceCount > 1 &&
+		destinationSlicePitch == destinationRowPitch * rowCount &&
+		sourceSlicePitch == sourceRowPitch * rowCount &&
+		static_cast<std::uint64_t>(rowCount) * sliceCount <= UINT32_MAX)
+	{
+		rowCount *= sliceCount;
+		sliceCount = 1;
+	}
+
+	const bool contiguousRows = destinationRowPitch == rowSize && sourceRowPitch == rowSize;
+	const std::size_t minBytesPerBlock = parallel ? c_minBytesPerBlock : SIZE_MAX;
+
+	if (contiguousRows && sliceCount == 1)
+	{
+		// 하위 리소스 전체가 하나의 연속 구간입니다. 병렬로 복사할 때만 고정 크기 조각으로 나눕니다.
+		const std::size_t size = rowSize * rowCount;
+		const std::uint32_t chunkCount = static_cast<std::uint32_t>((size + c_spanChunkSize - 1) / c_spanChunkSize);
+		ParallelForRowBlocks(chunkCount, c_spanChunkSize, minBytesPerBlock, [&](std::uint32_t begin, std::uint32_t end)
+		{
+			const std::size_t offset = c_spanChunkSize * begin;
+			CopySpan(destination + offset, source + offset, (std::min)(c_spanChunkSize * end, size) - offset, memory);
+			FenceStreamingStores();
+		});
+		return;
+	}
+
+	// 조각을 이어 붙인 행 번호(slice * rowCount + row)를 구간으로 나눕니다. 구간 안에서 한 조각에 속한 행이 연속이면 한 번에 복사합니다.
+	ParallelForRowBlocks(rowCount * sliceCount, rowSize, minBytesPerBlock, [&](std::uint32_t begin, std::uint32_t end)
+	{
+		for (std::uint32_t row = begin; row < end;)
+		{
+			const std::uint32_t slice = row / rowCount;
+			const std::uint32_t first = row % rowCount;
+			const std::uint32_t last = (std::min)(rowCount, first + (end - row));
+
+			std::uint8_t* destinationRow = destination + destinationSlicePitch * slice + destinationRowPitch * first;
+			const std::uint8_t* sourceRow = source + sourceSlicePitch * slice + sourceRowPitch * first;
+			if (contiguousRows)
+			{
+				CopySpan(destinationRow, sourceRow, rowSize * (last - first), memory);
+			}
+			else
+			{
+				for (std::uint32_t y = first; y < last; y++, destinationRow += destinationRowPitch, sourceRow += sourceRowPitch)
+				{
+					CopySpan(destinationRow, sourceRow, rowSize, memory);
+				}
+			}
+			row += last - first;
+		}
+		FenceStreamingStores();
+	});
+}
+
+#if defined(_WIN32)
+void DX::CopySubresource(
+	const D3D12_MEMCPY_DEST* destination,
+	const D3D12_SUBRESOURCE_DATA* source,
+	SIZE_T rowSize,
+	UINT rowCount,
+	UINT sliceCount,
+	bool parallel)
+{
+	CopySubresource(
+		static_cast<std::uint8_t*>(destination->pData),
+		destination->RowPitch,
+		destination->SlicePitch,
+		static_cast<const std::uint8_t*>(source->pData),
+		static_cast<std::size_t>(source->RowPitch),
+		static_cast<std::size_t>(source->SlicePitch),
+		rowSize,
+		rowCount,
+		sliceCount,
+		CopyDestinationMemory::WriteCombined,
+		parallel);
+}
+#endif
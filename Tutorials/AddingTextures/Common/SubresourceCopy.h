@@ -0,0 +1,41 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace DX
+{
+	enum class CopyDestinationMemory
+	{
+		Cached,			// 일반 메모리입니다. 복사한 데이터를 곧 CPU에서 다시 읽는 경우입니다.
+		WriteCombined,	// 업로드 힙처럼 쓰기 결합(write-combined) 메모리입니다. 캐시를 거치지 않는 스트리밍 저장을 사용합니다.
+	};
+
+	// d3dx12.h의 MemcpySubresource를 대신하는 하위 리소스 복사입니다. rowCount개 행 x sliceCount개 조각을 각 피치에 맞춰 복사합니다.
+	// 두 피치가 rowSize와 같으면 행을 나누지 않고 조각(조각 피치도 빽빽하면 전체)을 한 번에 복사합니다.
+	// WriteCombined 대상에는 SSE2 스트리밍 저장 커널을 쓰며, 그 밖의 플랫폼에서는 memcpy를 씁니다.
+	// parallel이 true이고 전체 크기가 수 MB를 넘으면 행과 조각을 구간으로 나누어 여러 스레드에서 복사합니다.
+	void CopySubresource(
+		std::uint8_t* destination,
+		std::size_t destinationRowPitch,
+		std::size_t destinationSlicePitch,
+		const std::uint8_t* source,
+		std::size_t sourceRowPitch,
+		std::size_t sourceSlicePitch,
+		std::size_t rowSize,
+		std::uint32_t rowCount,
+		std::uint32_t sliceCount,
+		CopyDestinationMemory memory = CopyDestinationMemory::WriteCombined,
+		bool parallel = true);
+
+#if defined(_WIN32)
+	// MemcpySubresource와 같은 인수를 받는 형태입니다. 대상은 업로드 힙(쓰기 결합)으로 봅니다.
+	void CopySubresource(
+		const D3D12_MEMCPY_DEST* destination,
+		const D3D12_SUBRESOURCE_DATA* source,
+		SIZE_T rowSize,
+		UINT rowCount,
+		UINT sliceCount,
+		bool parallel = true);
+#endif
+}
@@ -0,0 +1,146 @@
+﻿#include "pch.h"
+#include "UploadBatch.h"
+#include "SubresourceCopy.h"
+
+using namespace DX;
+
+namespace
+{
+	// 버퍼 데이터의 업로드 정렬입니다. 복사 커널이 16바이트 단위로 저장합니다.
+	const UINT64 c_bufferDataAlignment = 16;
+
+	UINT64 AlignUp(UINT64 value, UINT64 alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+}
+
+UploadBatch::UploadBatch(ID3D12Device* device) :
+	m_device(device),
+	m_uploadSize(0)
+{
+}
+
+void UploadBatch::AddBuffer(ID3D12Resource* destination, UINT64 destinationOffset, const void* data, UINT64 size)
+{
+	Item item = {};
+	item.resource = destination;
+	item.offset = AlignUp(m_uploadSize, c_bufferDataAlignment);
+	item.size = size;
+	item.destinationOffset = destinationOffset;
+	item.data = data;
+	m_items.push_back(item);
+
+	m_uploadSize = item.offset + size;
+}
+
+void UploadBatch::AddTexture(ID3D12Resource* destination, UINT firstSubresource, UINT subresourceCount, const D3D12_SUBRESOURCE_DATA* data)
+{
+	// 배치는 배치 시작 기준의 오프셋으로 바로 계산하므로 Submit에서는 할당 위치만 더합니다.
+	const D3D12_RESOURCE_DESC desc = destination->GetDesc();
+	const UINT firstFootprint = static_cast<UINT>(m_footprints.size());
+	m_footprints.resize(firstFootprint + subresourceCount);
+	m_rowCounts.resize(firstFootprint + subresourceCount);
+	m_rowSizes.resize(firstFootprint + subresourceCount);
+	m_subresources.insert(m_subresources.end(), data, data + subresourceCount);
+
+	Item item = {};
+	item.resource = destination;
+	item.offset = AlignUp(m_uploadSize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+	item.firstSubresource = firstSubresource;
+	item.subresourceCount = subresourceCount;
+	item.firstFootprint = firstFootprint;
+	m_device->GetCopyableFootprints(
+		&desc,
+		firstSubresource,
+		subresourceCount,
+		item.offset,
+		&m_footprints[firstFootprint],
+		&m_rowCounts[firstFootprint],
+		&m_rowSizes[firstFootprint],
+		&item.size);
+	m_items.push_back(item);
+
+	m_uploadSize = item.offset + item.size;
+}
+
+UploadTicket UploadBatch::Submit(CopyQueue* copyQueue)
+{
+	UploadTicket ticket = 0;
+	std::size_t begin = 0;
+	while (begin < m_items.size())
+	{
+		ticket = copyQueue->Submit([&](ID3D12GraphicsCommandList* commandList, UploadRingBuffer* uploadBuffer)
+		{
+			// 첫 항목은 항상 포함하고, 이어지는 항목은 묶음이 링 버퍼 절반을 넘지 않을 때까지 붙입니다.
+			// 묶음 시작을 배치 정렬로 내림하여 묶음 안의 텍스처 배치 정렬을 유지합니다.
+			const UINT64 budget = uploadBuffer->GetCapacity() / 2;
+			const UINT64 base = m_items[begin].offset & ~static_cast<UINT64>(D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT - 1);
+			std::size_t end = begin + 1;
+			while (end < m_items.size() && m_items[end].offset + m_items[end].size - base <= budget)
+			{
+				end++;
+			}
+
+			const UINT64 size = m_items[end - 1].offset + m_items[end - 1].size - base;
+			UploadAllocation upload = uploadBuffer->Allocate(size, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+			RecordItems(commandList, upload, base, begin, end);
+			begin = end;
+		});
+	}
+
+	// 용량은 남겨 두어 다음 배치에서 재사용합니다.
+	m_items.clear();
+	m_footprints.clear();
+	m_rowCounts.clear();
+	m_rowSizes.clear();
+	m_subresources.clear();
+	m_uploadSize = 0;
+	return ticket;
+}
+
+void UploadBatch::RecordItems(ID3D12GraphicsCommandList* commandList, const UploadAllocation& upload, UINT64 base, std::size_t begin, std::size_t end)
+{
+	for (std::size_t i = begin; i < end; i++)
+	{
+		const Item& item = m_items[i];
+		if (item.subresourceCount == 0)
+		{
+			const std::size_t size = static_cast<std::size_t>(item.size);
+			CopySubresource(upload.cpuAddress + (item.offset - base), size, 0, static_cast<const std::uint8_t*>(item.data), size, 0, size, 1, 1);
+			commandList->CopyBufferRegion(item.resource, item.destinationOffset, upload.resource, upload.offset + (item.offset - base), item.size);
+			continue;
+		}
+
+		for (UINT j = 0; j < item.subresourceCount; j++)
+		{
+			const UINT index = item.firstFootprint + j;
+			const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& footprint = m_footprints[index];
+
+			const D3D12_SUBRESOURCE_DATA& sourceData = m_subresources[index];
+			CopySubresource(
+				upload.cpuAddress + (footprint.Offset - base),
+				footprint.Footprint.RowPitch,
+				static_cast<std::size_t>(footprint.Footprint.RowPitch) * m_rowCounts[index],
+				static_cast<const std::uint8_t*>(sourceData.pData),
+				static_cast<std::size_t>(sourceData.RowPitch),
+				static_cast<std::size_t>(sourceData.SlicePitch),
+				static_cast<std::size_t>(m_rowSizes[index]),
+				m_rowCounts[index],
+				footprint.Footprint.Depth);
+
+			D3D12_TEXTURE_COPY_LOCATION source = {};
+			source.pResource = upload.resource;
+			source.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+			source.PlacedFootprint.Offset = upload.offset + (footprint.Offset - base);
+			source.PlacedFootprint.Footprint = footprint.Footprint;
+
+			D3D12_TEXTURE_COPY_LOCATION destination = {};
+			destination.pResource = item.resource;
+			destination.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+			destination.SubresourceIndex = item.firstSubresource + j;
+
+			commandList->CopyTextureRegion(&destination, 0, 0, 0, &source, nullptr);
+		}
+	}
+}
@@ -0,0 +1,57 @@
+﻿#pragma once
+
+#include <vector>
+#include "CopyQueue.h"
+
+namespace DX
+{
+	// 여러 리소스의 업로드를 모아 복사 큐에 한 번에 제출합니다.
+	// Add에서 각 리소스의 배치(GetCopyableFootprints)를 재사용하는 배열에 계산해 두고, Submit에서 업로드 링 버퍼의 연속 구간 하나를 할당한 뒤
+	// 데이터 복사와 복사 명령 기록을 한 번에 처리합니다. 링 버퍼는 영구 매핑되어 있으므로 Map/Unmap이 없고,
+	// 배열은 Submit 뒤에도 용량을 유지하므로 같은 UploadBatch를 다시 쓰면 힙 할당도 없습니다.
+	// 원본 데이터는 복사하지 않고 가리키기만 하므로 Submit까지 유지되어야 합니다. 한 스레드에서만 사용합니다.
+	class UploadBatch
+	{
+	public:
+		explicit UploadBatch(ID3D12Device* device);
+
+		// destination 버퍼의 destinationOffset 위치에 data의 size바이트를 올립니다.
+		void AddBuffer(ID3D12Resource* destination, UINT64 destinationOffset, const void* data, UINT64 size);
+
+		// destination 텍스처의 [firstSubresource, firstSubresource + subresourceCount) 하위 리소스에 data를 올립니다.
+		void AddTexture(ID3D12Resource* destination, UINT firstSubresource, UINT subresourceCount, const D3D12_SUBRESOURCE_DATA* data);
+
+		// 모은 업로드를 기록하여 제출하고 마지막 티켓을 반환한 뒤 배치를 비웁니다. 대상 리소스는 COMMON 상태여야 합니다.
+		// 합계가 링 버퍼 절반을 넘으면 리소스 단위로 나누어 여러 번 제출합니다. 리소스 하나가 링 버퍼보다 크면 E_OUTOFMEMORY 예외가 발생합니다.
+		UploadTicket Submit(CopyQueue* copyQueue);
+
+		bool IsEmpty() const			{ return m_items.empty(); }
+		UINT64 GetUploadSize() const	{ return m_uploadSize; }
+
+	private:
+		// 업로드 하나입니다. 텍스처이면 [firstFootprint, firstFootprint + subresourceCount)의 배치를 사용합니다.
+		// offset은 배치 시작 기준의 업로드 위치이며, 텍스처 배치의 Offset도 같은 기준입니다.
+		struct Item
+		{
+			ID3D12Resource*	resource;
+			UINT64			offset;
+			UINT64			size;
+			UINT64			destinationOffset;	// 버퍼 전용입니다.
+			const void*		data;				// 버퍼 전용입니다.
+			UINT			firstSubresource;	// 텍스처 전용입니다.
+			UINT			subresourceCount;	// 0이면 버퍼입니다.
+			UINT			firstFootprint;
+		};
+
+		// [begin, end) 항목의 데이터를 upload에 복사하고 복사 명령을 기록합니다. upload는 배치 위치 base에 해당합니다.
+		void RecordItems(ID3D12GraphicsCommandList* commandList, const UploadAllocation& upload, UINT64 base, std::size_t begin, std::size_t end);
+
+		Microsoft::WRL::ComPtr<ID3D12Device>			m_device;
+		std::vector<Item>								m_items;
+		std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT>	m_footprints;
+		std::vector<UINT>								m_rowCounts;
+		std::vector<UINT64>								m_rowSizes;
+		std::vector<D3D12_SUBRESOURCE_DATA>				m_subresources;
+		UINT64											m_uploadSize;
+	};
+}
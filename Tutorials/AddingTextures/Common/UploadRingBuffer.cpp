@@ -0,0 +1,147 @@
+﻿#include "pch.h"
+#include "UploadRingBuffer.h"
+#include "DirectXHelper.h"
+#include "CpuProfiler.h"
+
+using namespace DX;
+
+UploadRingBuffer::UploadRingBuffer(ID3D12Device* device, ID3D12Fence* fence, UINT64 capacity) :
+	m_fence(fence),
+	m_fenceEvent(0),
+	m_mappedBuffer(nullptr),
+	m_gpuAddress(0),
+	m_capacity(capacity),
+	m_head(0),
+	m_tail(0),
+	m_committed(0)
+{
+	CD3DX12_HEAP_PROPERTIES uploadHeapProperties(D3D12_HEAP_TYPE_UPLOAD);
+	CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(capacity);
+	DX::ThrowIfFailed(device->CreateCommittedResource(
+		&uploadHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&bufferDesc,
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS(&m_buffer)));
+
+	NAME_D3D12_OBJECT(m_buffer);
+
+	// 링 버퍼는 앱이 닫히기 전까지 매핑이 해제되지 않습니다.
+	CD3DX12_RANGE readRange(0, 0);		// CPU에서 이 리소스를 읽도록 의도하지 않았습니다.
+	DX::ThrowIfFailed(m_buffer->Map(0, &readRange, reinterpret_cast<void**>(&m_mappedBuffer)));
+	m_gpuAddress = m_buffer->GetGPUVirtualAddress();
+
+	m_fenceEvent = DX::CreateFenceEvent();
+}
+
+UploadRingBuffer::~UploadRingBuffer()
+{
+	m_buffer->Unmap(0, nullptr);
+	m_mappedBuffer = nullptr;
+
+	DX::CloseFenceEvent(m_fenceEvent);
+}
+
+bool UploadRingBuffer::TryAllocate(UINT64 size, UINT64 alignment, UploadAllocation* allocation)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	ReclaimLocked(m_fence->GetCompletedValue());
+	return TryAllocateLocked(size, alignment, allocation);
+}
+
+UploadAllocation UploadRingBuffer::Allocate(UINT64 size, UINT64 alignment)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	UploadAllocation allocation;
+
+	ReclaimLocked(m_fence->GetCompletedValue());
+	while (!TryAllocateLocked(size, alignment, &allocation))
+	{
+		// 기다려도 회수할 수 있는 공간이 없습니다.
+		if (m_batches.empty())
+		{
+			DX::ThrowIfFailed(E_OUTOFMEMORY);
+		}
+
+		// 전체 GPU를 비우지 않고 가장 오래된 태그까지만 기다립니다.
+		const UINT64 fenceValue = m_batches.front().fenceValue;
+		if (m_fence->GetCompletedValue() < fenceValue)
+		{
+			DX_CPU_ZONE("Wait for upload ring space");
+			DX::WaitForFence(m_fence.Get(), fenceValue, m_fenceEvent);
+		}
+		ReclaimLocked(m_fence->GetCompletedValue());
+	}
+
+	return allocation;
+}
+
+void UploadRingBuffer::Commit(UINT64 fenceValue)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	if (m_head == m_committed)
+	{
+		return;
+	}
+
+	Batch batch = { fenceValue, m_head };
+	m_batches.push_back(batch);
+	m_committed = m_head;
+}
+
+void UploadRingBuffer::Reclaim()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	ReclaimLocked(m_fence->GetCompletedValue());
+}
+
+UINT64 UploadRingBuffer::GetUsedSize() const
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	return m_head - m_tail;
+}
+
+void UploadRingBuffer::ReclaimLocked(UINT64 completedValue)
+{
+	while (!m_batches.empty() && m_batches.front().fenceValue <= completedValue)
+	{
+		m_tail = m_batches.front().end;
+		m_batches.pop_front();
+	}
+}
+
+bool UploadRingBuffer::TryAllocateLocked(UINT64 size, UINT64 alignment, UploadAllocation* allocation)
+{
+	if (size == 0 || size > m_capacity)
+	{
+		return false;
+	}
+
+	// 정렬은 2의 거듭제곱이어야 합니다. 버퍼 시작 주소는 64KB로 정렬되므로 오프셋만 정렬하면 됩니다.
+	const UINT64 offset = m_head % m_capacity;
+	UINT64 alignedOffset = (offset + alignment - 1) & ~(alignment - 1);
+
+	// 끝에 맞지 않으면 남은 부분을 건너뛰고 버퍼 시작에서 할당합니다.
+	if (alignedOffset + size > m_capacity)
+	{
+		alignedOffset = m_capacity;
+	}
+
+	const UINT64 padding = alignedOffset - offset;
+	const UINT64 newHead = m_head + padding + size;
+	if (newHead - m_tail > m_capacity)
+	{
+		return false;
+	}
+
+	const UINT64 bufferOffset = alignedOffset % m_capacity;
+	allocation->resource = m_buffer.Get();
+	allocation->offset = bufferOffset;
+	allocation->cpuAddress = m_mappedBuffer + bufferOffset;
+	allocation->gpuAddress = m_gpuAddress + bufferOffset;
+	allocation->size = size;
+
+	m_head = newHead;
+	return true;
+}
@@ -0,0 +1,69 @@
+﻿#pragma once
+
+#include <deque>
+#include <mutex>
+
+namespace DX
+{
+	// 업로드 링 버퍼에서 받은 하위 할당입니다. cpuAddress에 쓰고 resource/offset에서 GPU로 복사합니다.
+	struct UploadAllocation
+	{
+		ID3D12Resource*				resource;
+		UINT64						offset;
+		UINT8*						cpuAddress;
+		D3D12_GPU_VIRTUAL_ADDRESS	gpuAddress;
+		UINT64						size;
+	};
+
+	// 영구 매핑된 단일 업로드 힙을 원형으로 하위 할당합니다.
+	// 할당은 다음 Commit의 fence 값으로 태그되며, fence가 그 값을 넘으면 Reclaim에서 공간이 회수됩니다.
+	// 여러 스레드에서 할당할 수 있습니다.
+	class UploadRingBuffer
+	{
+	public:
+		UploadRingBuffer(ID3D12Device* device, ID3D12Fence* fence, UINT64 capacity);
+		~UploadRingBuffer();
+
+		// 공간이 있으면 정렬된 하위 할당을 반환합니다. 대기하지 않습니다.
+		bool TryAllocate(UINT64 size, UINT64 alignment, UploadAllocation* allocation);
+
+		// 공간이 생길 때까지 가장 오래된 태그의 fence를 기다린 다음 할당합니다.
+		// 아직 Commit되지 않은 할당만으로 링이 가득 차면 E_OUTOFMEMORY 예외가 발생합니다.
+		UploadAllocation Allocate(UINT64 size, UINT64 alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+
+		// 마지막 Commit 이후의 모든 할당을 fenceValue로 태그합니다.
+		// 할당을 참조하는 명령 목록을 실행한 다음, 큐에서 fenceValue 신호를 예약할 때 호출합니다.
+		void Commit(UINT64 fenceValue);
+
+		// fence가 완료한 태그의 공간을 회수합니다.
+		void Reclaim();
+
+		UINT64 GetCapacity() const		{ return m_capacity; }
+		UINT64 GetUsedSize() const;
+
+	private:
+		void ReclaimLocked(UINT64 completedValue);
+		bool TryAllocateLocked(UINT64 size, UINT64 alignment, UploadAllocation* allocation);
+
+		// 태그된 할당 구간의 끝(누적 위치)입니다.
+		struct Batch
+		{
+			UINT64	fenceValue;
+			UINT64	end;
+		};
+
+		Microsoft::WRL::ComPtr<ID3D12Resource>	m_buffer;
+		Microsoft::WRL::ComPtr<ID3D12Fence>		m_fence;
+		HANDLE									m_fenceEvent;
+		UINT8*									m_mappedBuffer;
+		D3D12_GPU_VIRTUAL_ADDRESS				m_gpuAddress;
+		UINT64									m_capacity;
+
+		// 위치는 계속 증가하는 누적 바이트 수이며, 버퍼 오프셋은 capacity로 나눈 나머지입니다.
+		mutable std::mutex						m_lock;
+		UINT64									m_head;			// 다음 할당 위치입니다.
+		UINT64									m_tail;			// 사용 중인 가장 오래된 위치입니다.
+		UINT64									m_committed;	// 마지막 Commit 시점의 m_head입니다.
+		std::deque<Batch>						m_batches;
+	};
+}
@@ -0,0 +1,126 @@
+﻿#include "pch.h"
+#include "CubeFrameRecorder.h"
+
+#include <algorithm>
+#include <cstring>
+#include "../Common/CpuProfiler.h"
+#include "../Common/DirectXHelper.h"
+
+using namespace AddingTextures;
+
+namespace
+{
+	const UINT c_minDrawsPerRecordingWorker = 64;	// 작업자 스레드 하나가 기록할 최소 그리기 수입니다.
+
+	const FLOAT c_clearColor[4] = { 0.392156899f, 0.584313750f, 0.929411829f, 1.0f };	// DirectX::Colors::CornflowerBlue
+}
+
+void AddingTextures::RecordCubeFrame(
+	DX::FrameResources* frameResources,
+	const CubeDrawState& state,
+	const CubeFrameTarget& target,
+	std::vector<ID3D12CommandList*>* commandLists)
+{
+	DX::CommandListPool* commandListPool = frameResources->GetCommandListPool();
+	DX::GpuProfiler* gpuProfiler = frameResources->GetGpuProfiler();
+
+	// 프레임 상수 할당기에 상수를 복사합니다. 모든 그리기 목록이 이 주소를 바인딩합니다.
+	const DX::ConstantAllocation constants = frameResources->GetConstantAllocator()->Allocate(state.constantsSize);
+	memcpy(constants.cpuAddress, state.constants, state.constantsSize);
+	const D3D12_GPU_VIRTUAL_ADDRESS constantBufferAddress = constants.gpuAddress;
+
+	// 인스턴스 변환을 압축하여 프레임 인스턴스 버퍼에 바로 씁니다. 꼭짓점 셰이더는 SV_InstanceID로 자기 원소를 읽습니다.
+	const UINT instanceCount = state.instanceCount;
+	const UINT drawCount = (std::max)(state.drawCount, 1u);
+	D3D12_GPU_VIRTUAL_ADDRESS instanceBufferAddress;
+	{
+		DX_CPU_ZONE("Pack instances");
+		const DX::ConstantAllocation instances = frameResources->GetInstanceAllocator()->Allocate(instanceCount * sizeof(DX::PackedInstance));
+		DX::PackInstances(state.instances, instanceCount, reinterpret_cast<DX::PackedInstance*>(instances.cpuAddress));
+		instanceBufferAddress = instances.gpuAddress;
+	}
+
+	// 텍스처 SRV를 이번 프레임의 셰이더 표시 설명자 구간에 복사합니다. 모든 그리기 목록이 같은 테이블을 바인딩합니다.
+	DX::ShaderVisibleDescriptorHeap* shaderVisibleHeap = frameResources->GetShaderVisibleDescriptorHeap();
+	ID3D12DescriptorHeap* descriptorHeaps[] = { shaderVisibleHeap->GetHeap() };
+	const D3D12_GPU_DESCRIPTOR_HANDLE textureTable = shaderVisibleHeap->CopyTable(state.textureDescriptors, state.textureDescriptorCount);
+
+	// 첫 번째 목록은 렌더링 대상을 준비하고 지웁니다. 프레임 전체의 GPU 시간은 이 목록에서 마지막 목록까지 측정합니다.
+	UINT renderScope = DX::c_invalidGpuScope;
+	{
+		ID3D12GraphicsCommandList* commandList = commandListPool->Acquire();
+		renderScope = gpuProfiler->BeginScope(commandList, L"Render");
+
+		// 이 리소스가 렌더링 대상으로 사용 중임을 나타냅니다.
+		CD3DX12_RESOURCE_BARRIER renderTargetResourceBarrier =
+			CD3DX12_RESOURCE_BARRIER::Transition(target.renderTarget, D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_RENDER_TARGET);
+		commandList->ResourceBarrier(1, &renderTargetResourceBarrier);
+
+		commandList->ClearRenderTargetView(target.renderTargetView, c_clearColor, 0, nullptr);
+		commandList->ClearDepthStencilView(target.depthStencilView, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 0, nullptr);
+
+		DX::ThrowIfFailed(commandList->Close());
+		commandLists->push_back(commandList);
+	}
+
+	// 그리기를 구간으로 나누어 작업자 스레드에서 기록합니다. 명령 목록은 상태를 상속하지 않으므로 목록마다 상태를 설정합니다.
+	auto recordDraws = [&](ID3D12GraphicsCommandList* commandList, UINT begin, UINT end)
+	{
+		DX_CPU_ZONE("Record draws");
+		const UINT drawScope = gpuProfiler->BeginEvent(commandList, L"Draw the cubes");
+
+		commandList->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
+		commandList->SetGraphicsRootSignature(state.rootSignature);
+		commandList->SetGraphicsRootConstantBufferView(0, constantBufferAddress);
+		commandList->SetGraphicsRootDescriptorTable(2, textureTable);
+		commandList->RSSetViewports(1, &target.viewport);
+		commandList->RSSetScissorRects(1, &target.scissorRect);
+		commandList->OMSetRenderTargets(1, &target.renderTargetView, false, &target.depthStencilView);
+
+		commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+		commandList->IASetVertexBuffers(0, 1, &state.vertexBufferView);
+		commandList->IASetIndexBuffer(&state.indexBufferView);
+		for (UINT draw = begin; draw < end; draw++)
+		{
+			// SV_InstanceID는 StartInstanceLocation을 더하지 않으므로 구간은 SRV 주소로 지정합니다.
+			const UINT firstInstance = static_cast<UINT>(static_cast<UINT64>(instanceCount) * draw / drawCount);
+			const UINT lastInstance = static_cast<UINT>(static_cast<UINT64>(instanceCount) * (draw + 1) / drawCount);
+			if (firstInstance == lastInstance)
+			{
+				continue;
+			}
+
+			commandList->SetGraphicsRootShaderResourceView(1, instanceBufferAddress + firstInstance * sizeof(DX::PackedInstance));
+			commandList->DrawIndexedInstanced(state.indexCount, lastInstance - firstInstance, 0, 0, 0);
+		}
+
+		gpuProfiler->EndEvent(commandList, drawScope);
+	};
+
+	const UINT workerCount = state.recordingWorkerCount != 0 ?
+		state.recordingWorkerCount :
+		DX::GetRecordingWorkerCount(drawCount, c_minDrawsPerRecordingWorker);
+	DX::RecordParallel(
+		commandListPool,
+		state.pipelineState,
+		drawCount,
+		workerCount,
+		recordDraws,
+		commandLists);
+
+	// 마지막 목록은 명령 목록 실행이 완료되면 표현하는 데 렌더링 대상이 사용됨을 나타냅니다.
+	{
+		ID3D12GraphicsCommandList* commandList = commandListPool->Acquire();
+
+		CD3DX12_RESOURCE_BARRIER presentResourceBarrier =
+			CD3DX12_RESOURCE_BARRIER::Transition(target.renderTarget, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PRESENT);
+		commandList->ResourceBarrier(1, &presentResourceBarrier);
+
+		// 이번 프레임의 모든 구간이 끝났으므로 타임스탬프를 판독 버퍼로 확인합니다.
+		gpuProfiler->EndScope(commandList, renderScope);
+		gpuProfiler->ResolveFrame(commandList);
+
+		DX::ThrowIfFailed(commandList->Close());
+		commandLists->push_back(commandList);
+	}
+}
@@ -0,0 +1,56 @@
+﻿#pragma once
+
+#include <vector>
+#include "../Common/FrameResources.h"
+#include "../Common/InstanceBuffer.h"
+
+namespace AddingTextures
+{
+	// 큐브를 그리는 데 필요한 장치 개체와 프레임 데이터입니다. 포인터는 RecordCubeFrame 호출 동안만 사용합니다.
+	struct CubeDrawState
+	{
+		ID3D12RootSignature*			rootSignature;
+		ID3D12PipelineState*			pipelineState;
+		D3D12_VERTEX_BUFFER_VIEW		vertexBufferView;
+		D3D12_INDEX_BUFFER_VIEW			indexBufferView;
+		UINT							indexCount;
+
+		// 꼭짓점 셰이더 상수(b0)입니다. 프레임 상수 할당기에 복사됩니다.
+		const void*						constants;
+		UINT							constantsSize;
+
+		// 인스턴스 변환입니다. 압축하여 프레임 인스턴스 버퍼(t0)에 씁니다.
+		const DX::InstanceTransform*	instances;
+		UINT							instanceCount;
+
+		// 인스턴스를 연속 구간으로 나누어 그릴 그리기 수입니다. 1이면 모든 인스턴스를 한 번에 그립니다.
+		// 그리기마다 인스턴스 버퍼 SRV를 자기 구간의 시작으로 다시 바인딩합니다.
+		UINT							drawCount;
+
+		// 그리기를 기록할 작업자(명령 목록) 수입니다. 0이면 그리기 수에 맞게 정합니다.
+		UINT							recordingWorkerCount;
+
+		// 픽셀 셰이더 SRV 테이블(t0부터)의 스테이징 설명자입니다. 프레임마다 셰이더 표시 링에 복사하여 바인딩합니다.
+		const D3D12_CPU_DESCRIPTOR_HANDLE*	textureDescriptors;
+		UINT								textureDescriptorCount;
+	};
+
+	// 이번 프레임의 렌더링 대상입니다.
+	struct CubeFrameTarget
+	{
+		ID3D12Resource*					renderTarget;
+		D3D12_CPU_DESCRIPTOR_HANDLE		renderTargetView;
+		D3D12_CPU_DESCRIPTOR_HANDLE		depthStencilView;
+		D3D12_VIEWPORT					viewport;
+		D3D12_RECT						scissorRect;
+	};
+
+	// 큐브 한 프레임의 명령 목록을 기록합니다. 렌더링 대상을 지우는 목록, 그리기 목록(작업자마다 하나), 표현 준비 목록 순서로
+	// commandLists 끝에 추가하며, 호출자는 이를 ExecuteCommandLists 한 번으로 제출합니다.
+	// 상수와 인스턴스는 frameResources의 현재 프레임 영역에 할당됩니다. Sample3DSceneRenderer와 헤드리스 제출 벤치마크가 함께 사용합니다.
+	void RecordCubeFrame(
+		DX::FrameResources* frameResources,
+		const CubeDrawState& state,
+		const CubeFrameTarget& target,
+		std::vector<ID3D12CommandList*>* commandLists);
+}
@@ -1,7 +1,13 @@
 ﻿#include "pch.h"
 #include "Sample3DSceneRenderer.h"
 
+#include "CubeFrameRecorder.h"
+#include "..\Common\DdsTextureLoader.h"
 #include "..\Common\DirectXHelper.h"
+#include "..\Common\MeshOptimizer.h"
+#include "..\Common\MipChain.h"
+#include "..\Common\UploadBatch.h"
+#include "..\Common\ProceduralTexture.h"
 #include <ppltasks.h>
 #include <synchapi.h>
 
@@ -17,17 +23,47 @@ using namespace Windows::Storage;
 Platform::String^ AngleKey = "Angle";
 Platform::String^ TrackingKey = "Tracking";
 
+// 에셋 팩의 항목 ID입니다. 패커는 파일 이름의 해시를 ID로 사용합니다.
+static constexpr DX::AssetId VertexShaderAssetId = DX::MakeAssetId("SampleVertexShader.cso");
+static constexpr DX::AssetId PixelShaderAssetId = DX::MakeAssetId("SamplePixelShader.cso");
+static constexpr DX::AssetId CubeTextureAssetId = DX::MakeAssetId("CubeTexture.dds");
+
 // 파일에서 꼭짓점 및 픽셀 셰이더를 로드하고 큐브 기하 도형을 인스턴스화합니다.
 Sample3DSceneRenderer::Sample3DSceneRenderer(const std::shared_ptr<DX::DeviceResources>& deviceResources) :
 	m_loadingComplete(false),
 	m_radiansPerSecond(XM_PIDIV4),	// 초당 45도를 회전합니다.
 	m_angle(0),
+	m_previousAngle(0),
 	m_tracking(false),
-	m_mappedConstantBuffer(nullptr),
+	m_rootSignatureHash(0),
+	m_uploadTicket(0),
+	m_indexCount(0),
+	m_hasTextureSrv(false),
 	m_deviceResources(deviceResources)
 {
 	LoadState();
+	m_previousAngle = m_angle;
 	ZeroMemory(&m_constantBufferData, sizeof(m_constantBufferData));
+	m_positionQuantization = DX::ComputePositionQuantization(nullptr, 0, 0);
+
+	// 큐브 인스턴스를 원래 큐브가 차지하던 영역에 격자로 배치합니다. 격자가 1이면 원래 큐브 하나와 같습니다.
+	m_instanceTransforms.resize(InstanceGridSize * InstanceGridSize);
+	const float instanceScale = 1.0f / InstanceGridSize;
+	for (UINT row = 0; row < InstanceGridSize; row++)
+	{
+		for (UINT column = 0; column < InstanceGridSize; column++)
+		{
+			DX::InstanceTransform& instance = m_instanceTransforms[row * InstanceGridSize + column];
+			instance.position[0] = (column + 0.5f) * instanceScale - 0.5f;
+			instance.position[1] = 0.0f;
+			instance.position[2] = (row + 0.5f) * instanceScale - 0.5f;
+			instance.scale = instanceScale;
+			instance.rotation[0] = 0.0f;
+			instance.rotation[1] = 0.0f;
+			instance.rotation[2] = 0.0f;
+			instance.rotation[3] = 1.0f;
+		}
+	}
 
 	CreateDeviceDependentResources();
 	CreateWindowSizeDependentResources();
@@ -35,63 +71,97 @@ Sample3DSceneRenderer::Sample3DSceneRenderer(const std::shared_ptr<DX::DeviceRes
 
 Sample3DSceneRenderer::~Sample3DSceneRenderer()
 {
-	m_constantBuffer->Unmap(0, nullptr);
-	m_mappedConstantBuffer = nullptr;
+	// 렌더러는 프레임 도중에 해제될 수 있으므로 GPU가 아직 참조하는 개체는 fence가 지난 뒤 해제합니다.
+	// 아직 그리지 않았다면 업로드 티켓을 직접 큐에서 기다려 복사가 끝난 뒤에 해제되도록 합니다.
+	// 장치가 제거된 경우 대기는 실패할 수 있으며, 소멸자에서는 예외를 던지지 않습니다.
+	try
+	{
+		m_deviceResources->GetCopyQueue()->WaitOnQueue(m_deviceResources->GetCommandQueue(), m_uploadTicket);
+	}
+	catch (...)
+	{
+	}
+	m_deviceResources->DeferRelease(m_vertexBuffer);
+	m_deviceResources->DeferRelease(m_indexBuffer);
+	m_deviceResources->DeferRelease(m_texture);
+	m_deviceResources->DeferRelease(m_pipelineState);
+	m_deviceResources->DeferRelease(m_rootSignature);
+
+	// 스테이징 설명자는 그리기 때 셰이더 표시 힙으로 복사되었으므로 바로 반환할 수 있습니다.
+	if (m_hasTextureSrv)
+	{
+		m_deviceResources->GetCbvSrvUavStagingHeap()->Free(m_textureSrv);
+	}
 }
 
 void Sample3DSceneRenderer::CreateDeviceDependentResources()
 {
 	auto d3dDevice = m_deviceResources->GetD3DDevice();
 
-	// 단일 상수 버퍼 슬롯이 있는 루트 서명을 만듭니다.
+	// 상수 버퍼 슬롯, 인스턴스 버퍼 슬롯과 텍스처 테이블이 있는 루트 서명을 만듭니다.
+	// 앞의 둘은 설명자 없이 GPU 가상 주소로 직접 바인딩하는 루트 CBV와 루트 SRV(구조적 버퍼)이고,
+	// 텍스처는 프레임마다 셰이더 표시 힙에 복사하는 SRV 테이블과 정적 샘플러로 픽셀 셰이더에 바인딩합니다.
 	{
-		CD3DX12_DESCRIPTOR_RANGE range;
-		CD3DX12_ROOT_PARAMETER parameter;
+		CD3DX12_DESCRIPTOR_RANGE textureRange;
+		textureRange.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0);
 
-		range.Init(D3D12_DESCRIPTOR_RANGE_TYPE_CBV, 1, 0);
-		parameter.InitAsDescriptorTable(1, &range, D3D12_SHADER_VISIBILITY_VERTEX);
+		CD3DX12_ROOT_PARAMETER parameters[3];
+		parameters[0].InitAsConstantBufferView(0, 0, D3D12_SHADER_VISIBILITY_VERTEX);
+		parameters[1].InitAsShaderResourceView(0, 0, D3D12_SHADER_VISIBILITY_VERTEX);
+		parameters[2].InitAsDescriptorTable(1, &textureRange, D3D12_SHADER_VISIBILITY_PIXEL);
+
+		CD3DX12_STATIC_SAMPLER_DESC sampler(0, D3D12_FILTER_MIN_MAG_MIP_LINEAR);
+		sampler.ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
 
 		D3D12_ROOT_SIGNATURE_FLAGS rootSignatureFlags =
 			D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT | // 입력 어셈블러 단계만 상수 버퍼에 액세스해야 합니다.
 			D3D12_ROOT_SIGNATURE_FLAG_DENY_DOMAIN_SHADER_ROOT_ACCESS |
 			D3D12_ROOT_SIGNATURE_FLAG_DENY_GEOMETRY_SHADER_ROOT_ACCESS |
-			D3D12_ROOT_SIGNATURE_FLAG_DENY_HULL_SHADER_ROOT_ACCESS |
-			D3D12_ROOT_SIGNATURE_FLAG_DENY_PIXEL_SHADER_ROOT_ACCESS;
+			D3D12_ROOT_SIGNATURE_FLAG_DENY_HULL_SHADER_ROOT_ACCESS;
 
 		CD3DX12_ROOT_SIGNATURE_DESC descRootSignature;
-		descRootSignature.Init(1, &parameter, 0, nullptr, rootSignatureFlags);
+		descRootSignature.Init(_countof(parameters), parameters, 1, &sampler, rootSignatureFlags);
 
 		ComPtr<ID3DBlob> pSignature;
 		ComPtr<ID3DBlob> pError;
 		DX::ThrowIfFailed(D3D12SerializeRootSignature(&descRootSignature, D3D_ROOT_SIGNATURE_VERSION_1, pSignature.GetAddressOf(), pError.GetAddressOf()));
 		DX::ThrowIfFailed(d3dDevice->CreateRootSignature(0, pSignature->GetBufferPointer(), pSignature->GetBufferSize(), IID_PPV_ARGS(&m_rootSignature)));
         NAME_D3D12_OBJECT(m_rootSignature);
+
+		// 파이프라인 캐시 키에 루트 서명을 포함합니다.
+		m_rootSignatureHash = DX::HashRootSignature(pSignature.Get());
 	}
 
 	// 셰이더를 비동기적으로 로드합니다.
-	auto createVSTask = DX::ReadDataAsync(L"SampleVertexShader.cso").then([this](std::vector<byte>& fileData) {
-		m_vertexShader = fileData;
-	});
-
-	auto createPSTask = DX::ReadDataAsync(L"SamplePixelShader.cso").then([this](std::vector<byte>& fileData) {
-		m_pixelShader = fileData;
+	// 에셋 팩은 한 번만 매핑되며, 압축되지 않은 셰이더는 매핑된 보기를 복사 없이 파이프라인 상태에 전달합니다.
+	// 팩이 패키지에 없으면(AssetPacker를 실행하지 않은 빌드) 개별 셰이더 파일을 매핑합니다.
+	// 팩에 큐브 텍스처(DDS)가 있으면 함께 가져오고, 없으면 아래에서 바둑판 텍스처를 만듭니다.
+	auto loadShadersTask = DX::OpenAssetPackAsync(L"Assets.pack").then([this](std::shared_ptr<const DX::AssetPack> assets) {
+		if (assets != nullptr)
+		{
+			m_vertexShader = assets->Load(VertexShaderAssetId);
+			m_pixelShader = assets->Load(PixelShaderAssetId);
+			if (assets->Contains(CubeTextureAssetId))
+			{
+				m_textureFile = assets->Load(CubeTextureAssetId);
+			}
+		}
+		else
+		{
+			m_vertexShader = DX::AssetView(DX::MappedFile::Open(DX::GetPackagePath(L"SampleVertexShader.cso")));
+			m_pixelShader = DX::AssetView(DX::MappedFile::Open(DX::GetPackagePath(L"SamplePixelShader.cso")));
+		}
 	});
 
 	// 셰이더가 로드되면 파이프라인 상태를 만듭니다.
-	auto createPipelineStateTask = (createPSTask && createVSTask).then([this]() {
-
-		static const D3D12_INPUT_ELEMENT_DESC inputLayout[] =
-		{
-			{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-			{ "COLOR", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-			{ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
-		};
+	auto createPipelineStateTask = loadShadersTask.then([this]() {
 
+		// 꼭짓점은 압축 형식(16바이트)으로 올립니다. 셰이더 입력은 float3/float2 그대로이며 입력 어셈블러가 변환합니다.
 		D3D12_GRAPHICS_PIPELINE_STATE_DESC state = {};
-		state.InputLayout = { inputLayout, _countof(inputLayout) };
+		state.InputLayout = DX::PackedVertexPositionColorTexture::InputLayout;
 		state.pRootSignature = m_rootSignature.Get();
-        state.VS = CD3DX12_SHADER_BYTECODE(&m_vertexShader[0], m_vertexShader.size());
-        state.PS = CD3DX12_SHADER_BYTECODE(&m_pixelShader[0], m_pixelShader.size());
+        state.VS = CD3DX12_SHADER_BYTECODE(m_vertexShader.GetData(), m_vertexShader.GetSize());
+        state.PS = CD3DX12_SHADER_BYTECODE(m_pixelShader.GetData(), m_pixelShader.GetSize());
 		state.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
 		state.BlendState = CD3DX12_BLEND_DESC(D3D12_DEFAULT);
 		state.DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
@@ -102,21 +172,18 @@ void Sample3DSceneRenderer::CreateDeviceDependentResources()
 		state.DSVFormat = m_deviceResources->GetDepthBufferFormat();
 		state.SampleDesc.Count = 1;
 
-		DX::ThrowIfFailed(m_deviceResources->GetD3DDevice()->CreateGraphicsPipelineState(&state, IID_PPV_ARGS(&m_pipelineState)));
+		// 같은 설명의 개체를 재사용하고, 디스크에 캐시된 blob이 있으면 컴파일을 건너뜁니다.
+		m_pipelineState = m_deviceResources->GetPipelineStateCache()->GetGraphicsPipelineState(state, m_rootSignatureHash);
 
-		// 셰이더 데이터는 파이프라인 상태가 만들어지면 삭제할 수 있습니다.
-		m_vertexShader.clear();
-		m_pixelShader.clear();
+		// 셰이더 데이터는 파이프라인 상태가 만들어지면 매핑을 해제할 수 있습니다.
+		m_vertexShader = DX::AssetView();
+		m_pixelShader = DX::AssetView();
 	});
 
 	// 큐브 기하 도형 리소스를 만들어 GPU에 업로드합니다.
 	auto createAssetsTask = createPipelineStateTask.then([this]() {
 		auto d3dDevice = m_deviceResources->GetD3DDevice();
 
-		// 명령 목록을 만듭니다.
-		DX::ThrowIfFailed(d3dDevice->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, m_deviceResources->GetCommandAllocator(), m_pipelineState.Get(), IID_PPV_ARGS(&m_commandList)));
-        NAME_D3D12_OBJECT(m_commandList);
-
 		// 큐브 꼭짓점을 구성함을 의미합니다. 각 꼭짓점에는 위치 및 색상이 있습니다.
 		VertexPositionColor cubeVertices[] =
 		{
@@ -130,47 +197,6 @@ void Sample3DSceneRenderer::CreateDeviceDependentResources()
 			{ XMFLOAT3(0.5f,  0.5f,  0.5f), XMFLOAT3(1.0f, 1.0f, 1.0f), XMFLOAT2(0.0f, 0.5f) },
 		};
 
-		const UINT vertexBufferSize = sizeof(cubeVertices);
-
-		// GPU의 기본 힙에서 꼭짓점 버퍼 리소스를 만들고 업로드 힙을 사용하여 이 리소스에 꼭짓점 데이터를 복사합니다.
-		// GPU가 업로드 리소스를 사용하여 완료되기 전까지는 업로드 리소스를 릴리스하지 말아야 합니다.
-		Microsoft::WRL::ComPtr<ID3D12Resource> vertexBufferUpload;
-
-		CD3DX12_HEAP_PROPERTIES defaultHeapProperties(D3D12_HEAP_TYPE_DEFAULT);
-		CD3DX12_RESOURCE_DESC vertexBufferDesc = CD3DX12_RESOURCE_DESC::Buffer(vertexBufferSize);
-		DX::ThrowIfFailed(d3dDevice->CreateCommittedResource(
-			&defaultHeapProperties,
-			D3D12_HEAP_FLAG_NONE,
-			&vertexBufferDesc,
-			D3D12_RESOURCE_STATE_COPY_DEST,
-			nullptr,
-			IID_PPV_ARGS(&m_vertexBuffer)));
-
-		CD3DX12_HEAP_PROPERTIES uploadHeapProperties(D3D12_HEAP_TYPE_UPLOAD);
-		DX::ThrowIfFailed(d3dDevice->CreateCommittedResource(
-			&uploadHeapProperties,
-			D3D12_HEAP_FLAG_NONE,
-			&vertexBufferDesc,
-			D3D12_RESOURCE_STATE_GENERIC_READ,
-			nullptr,
-			IID_PPV_ARGS(&vertexBufferUpload)));
-
-        NAME_D3D12_OBJECT(m_vertexBuffer);
-
-		// 꼭짓점 버퍼를 GPU에 업로드합니다.
-		{
-			D3D12_SUBRESOURCE_DATA vertexData = {};
-			vertexData.pData = reinterpret_cast<BYTE*>(cubeVertices);
-			vertexData.RowPitch = vertexBufferSize;
-			vertexData.SlicePitch = vertexData.RowPitch;
-
-			UpdateSubresources(m_commandList.Get(), m_vertexBuffer.Get(), vertexBufferUpload.Get(), 0, 0, 1, &vertexData);
-
-			CD3DX12_RESOURCE_BARRIER vertexBufferResourceBarrier =
-				CD3DX12_RESOURCE_BARRIER::Transition(m_vertexBuffer.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
-			m_commandList->ResourceBarrier(1, &vertexBufferResourceBarrier);
-		}
-
 		// 메시 인덱스를 로드합니다. 인덱스의 각 3개 숫자는 화면에 렌더링할 삼각형을 나타냅니다.
 		// 예: 0,2,1는 꼭짓점 버퍼의 인덱스 0, 2, 1이 있는 꼭짓점이
 		// 구성함을 의미합니다.
@@ -195,166 +221,122 @@ void Sample3DSceneRenderer::CreateDeviceDependentResources()
 			1, 7, 5,
 		};
 
-		const UINT indexBufferSize = sizeof(cubeIndices);
-
-		// GPU의 기본 힙에서 인덱스 버퍼 리소스를 만들고 업로드 힙을 사용하여 이 리소스에 인덱스 데이터를 복사합니다.
-		// GPU가 업로드 리소스를 사용하여 완료되기 전까지는 업로드 리소스를 릴리스하지 말아야 합니다.
-		Microsoft::WRL::ComPtr<ID3D12Resource> indexBufferUpload;
-
-		CD3DX12_RESOURCE_DESC indexBufferDesc = CD3DX12_RESOURCE_DESC::Buffer(indexBufferSize);
+		// 로드 시에 메시를 최적화합니다. 같은 꼭짓점을 합치고, 삼각형을 꼭짓점 캐시와 오버드로에 맞는 순서로,
+		// 꼭짓점을 참조 순서로 다시 배치합니다. 실제 메시는 쿠킹 단계에서 같은 함수로 처리할 수 있습니다.
+		std::vector<uint32_t> meshIndices(std::begin(cubeIndices), std::end(cubeIndices));
+		std::vector<uint8_t> meshVertices(reinterpret_cast<const uint8_t*>(cubeVertices), reinterpret_cast<const uint8_t*>(cubeVertices) + sizeof(cubeVertices));
+		const DX::MeshOptimizationReport meshReport = DX::OptimizeMesh(&meshIndices, &meshVertices, sizeof(VertexPositionColor), offsetof(VertexPositionColor, pos));
+		const VertexPositionColor* meshVertexData = reinterpret_cast<const VertexPositionColor*>(meshVertices.data());
+
+		// 위치는 경계 상자 기준 16비트 SNORM, 색은 RGBA8, 텍스처 좌표는 half로 압축합니다(32바이트 -> 16바이트).
+		// 위치를 되돌리는 배율과 오프셋은 Rotate에서 모델 행렬에 곱합니다.
+		const UINT vertexCount = meshReport.vertexCountAfter;
+		std::vector<DX::PackedVertexPositionColorTexture> packedVertices(vertexCount);
+		m_positionQuantization = DX::ComputePositionQuantization(&meshVertexData[0].pos.x, sizeof(VertexPositionColor), vertexCount);
+		DX::PackPositions(&meshVertexData[0].pos.x, sizeof(VertexPositionColor), vertexCount, m_positionQuantization, packedVertices[0].position, sizeof(packedVertices[0]));
+		DX::PackColors(&meshVertexData[0].color.x, sizeof(VertexPositionColor), 3, vertexCount, &packedVertices[0].color, sizeof(packedVertices[0]));
+		DX::PackTexCoords(&meshVertexData[0].uv.x, sizeof(VertexPositionColor), vertexCount, packedVertices[0].texCoord, sizeof(packedVertices[0]));
+
+		const UINT vertexBufferSize = vertexCount * sizeof(DX::PackedVertexPositionColorTexture);
+
+		// GPU의 기본 힙에서 꼭짓점 버퍼 리소스를 만듭니다. 데이터는 아래에서 복사 큐로 업로드합니다.
+		// 복사 큐는 COMMON 상태의 리소스만 사용할 수 있으며, 버퍼는 사용하는 큐에서 필요한 상태로 암시적으로 승격됩니다.
+		CD3DX12_HEAP_PROPERTIES defaultHeapProperties(D3D12_HEAP_TYPE_DEFAULT);
+		CD3DX12_RESOURCE_DESC vertexBufferDesc = CD3DX12_RESOURCE_DESC::Buffer(vertexBufferSize);
 		DX::ThrowIfFailed(d3dDevice->CreateCommittedResource(
 			&defaultHeapProperties,
 			D3D12_HEAP_FLAG_NONE,
-			&indexBufferDesc,
-			D3D12_RESOURCE_STATE_COPY_DEST,
+			&vertexBufferDesc,
+			D3D12_RESOURCE_STATE_COMMON,
 			nullptr,
-			IID_PPV_ARGS(&m_indexBuffer)));
+			IID_PPV_ARGS(&m_vertexBuffer)));
+
+        NAME_D3D12_OBJECT(m_vertexBuffer);
+
+		std::vector<uint16_t> meshIndices16(meshIndices.begin(), meshIndices.end());
+		const UINT indexBufferSize = static_cast<UINT>(meshIndices16.size() * sizeof(uint16_t));
 
+		// GPU의 기본 힙에서 인덱스 버퍼 리소스를 만듭니다.
+		CD3DX12_RESOURCE_DESC indexBufferDesc = CD3DX12_RESOURCE_DESC::Buffer(indexBufferSize);
 		DX::ThrowIfFailed(d3dDevice->CreateCommittedResource(
-			&uploadHeapProperties,
+			&defaultHeapProperties,
 			D3D12_HEAP_FLAG_NONE,
 			&indexBufferDesc,
-			D3D12_RESOURCE_STATE_GENERIC_READ,
+			D3D12_RESOURCE_STATE_COMMON,
 			nullptr,
-			IID_PPV_ARGS(&indexBufferUpload)));
+			IID_PPV_ARGS(&m_indexBuffer)));
 
 		NAME_D3D12_OBJECT(m_indexBuffer);
 
-		// 인덱스 버퍼를 GPU에 업로드합니다.
+		// 텍스처는 COMMON 상태로 만듭니다. 직접 큐에서 처음 샘플링할 때 PIXEL_SHADER_RESOURCE로 암시적으로 승격됩니다.
+		D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+		DX::UploadTicket textureTicket = 0;
+		std::unique_ptr<DX::MipChain> mipChain;
+		std::vector<D3D12_SUBRESOURCE_DATA> textureData;
+		if (m_textureFile.IsValid())
 		{
-			D3D12_SUBRESOURCE_DATA indexData = {};
-			indexData.pData = reinterpret_cast<BYTE*>(cubeIndices);
-			indexData.RowPitch = indexBufferSize;
-			indexData.SlicePitch = indexData.RowPitch;
-
-			UpdateSubresources(m_commandList.Get(), m_indexBuffer.Get(), indexBufferUpload.Get(), 0, 0, 1, &indexData);
-
-			CD3DX12_RESOURCE_BARRIER indexBufferResourceBarrier =
-				CD3DX12_RESOURCE_BARRIER::Transition(m_indexBuffer.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_INDEX_BUFFER);
-			m_commandList->ResourceBarrier(1, &indexBufferResourceBarrier);
+			// 팩의 DDS 텍스처(2D)는 파일 매핑에서 복사 큐의 링 버퍼로 바로 올립니다. 제출이 끝나면 매핑은 필요 없습니다.
+			textureTicket = DX::CreateDdsTexture(d3dDevice, m_deviceResources->GetCopyQueue(), m_textureFile, &m_texture, &srvDesc);
+			m_textureFile = DX::AssetView();
 		}
-
-		// 상수 버퍼에 대한 설명자 힙을 만듭니다.
+		else
 		{
-			D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
-			heapDesc.NumDescriptors = DX::c_frameCount;
-			heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-			// 이 플래그는 이 설명자 힙을 파이프라인에 바인딩할 수 있고 그 안에 들어 있는 설명자는 루트 테이블이 참조할 수 있음을 나타냅니다.
-			heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-			DX::ThrowIfFailed(d3dDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&m_cbvHeap)));
-
-            NAME_D3D12_OBJECT(m_cbvHeap);
+			// 바둑판 텍스처와 밉 체인 전체를 CPU에서 만듭니다.
+			// 형식이 UNORM이므로 sRGB 변환 없이 필터링합니다. UNORM_SRGB 형식을 쓰면 srgb를 true로 두세요.
+			std::vector<UINT8> texture = GenerateTextureData();
+			DX::MipGenerationOptions mipOptions;
+			mipOptions.srgb = false;
+			mipOptions.wrap = true;
+			mipChain.reset(new DX::MipChain(texture.data(), TextureWidth, TextureHeight, TextureWidth * TexturePixelSize, mipOptions));
+			const UINT mipLevelCount = mipChain->GetLevelCount();
+			textureData = mipChain->GetSubresourceData();
+
+			CD3DX12_RESOURCE_DESC textureDesc = CD3DX12_RESOURCE_DESC::Tex2D(DXGI_FORMAT_R8G8B8A8_UNORM, TextureWidth, TextureHeight, 1, static_cast<UINT16>(mipLevelCount));
+			DX::ThrowIfFailed(d3dDevice->CreateCommittedResource(
+				&defaultHeapProperties,
+				D3D12_HEAP_FLAG_NONE,
+				&textureDesc,
+				D3D12_RESOURCE_STATE_COMMON,
+				nullptr,
+				IID_PPV_ARGS(&m_texture)));
+
+			srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+			srvDesc.Format = textureDesc.Format;
+			srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+			srvDesc.Texture2D.MipLevels = mipLevelCount;
 		}
 
-		CD3DX12_RESOURCE_DESC constantBufferDesc = CD3DX12_RESOURCE_DESC::Buffer(DX::c_frameCount * c_alignedConstantBufferSize);
-		DX::ThrowIfFailed(d3dDevice->CreateCommittedResource(
-			&uploadHeapProperties,
-			D3D12_HEAP_FLAG_NONE,
-			&constantBufferDesc,
-			D3D12_RESOURCE_STATE_GENERIC_READ,
-			nullptr,
-			IID_PPV_ARGS(&m_constantBuffer)));
-
-        NAME_D3D12_OBJECT(m_constantBuffer);
+		NAME_D3D12_OBJECT(m_texture);
 
-		// 상수 버퍼 보기를 만들어 업로드 버퍼에 액세스합니다.
-		D3D12_GPU_VIRTUAL_ADDRESS cbvGpuAddress = m_constantBuffer->GetGPUVirtualAddress();
-		CD3DX12_CPU_DESCRIPTOR_HANDLE cbvCpuHandle(m_cbvHeap->GetCPUDescriptorHandleForHeapStart());
-		m_cbvDescriptorSize = d3dDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+		// 텍스처 SRV는 스테이징 힙에 한 번 만들고, 그리기마다 셰이더 표시 링으로 복사합니다.
+		m_textureSrv = m_deviceResources->GetCbvSrvUavStagingHeap()->Allocate();
+		m_hasTextureSrv = true;
+		d3dDevice->CreateShaderResourceView(m_texture.Get(), &srvDesc, m_textureSrv.cpuHandle);
 
-		for (int n = 0; n < DX::c_frameCount; n++)
+		// 꼭짓점/인덱스 버퍼와 만든 텍스처를 한 배치로 모아 복사 큐로 업로드합니다. CPU와 직접 큐는 기다리지 않으며,
+		// 직접 큐는 이 리소스를 처음 그리는 프레임에서 티켓을 GPU에서 기다립니다.
+		// 복사 큐의 티켓은 제출 순서대로 증가하므로 DDS 텍스처와 배치 중 나중 티켓 하나만 기다리면 됩니다.
+		DX::UploadBatch uploadBatch(d3dDevice);
+		uploadBatch.AddBuffer(m_vertexBuffer.Get(), 0, packedVertices.data(), vertexBufferSize);
+		uploadBatch.AddBuffer(m_indexBuffer.Get(), 0, meshIndices16.data(), indexBufferSize);
+		if (!textureData.empty())
 		{
-			D3D12_CONSTANT_BUFFER_VIEW_DESC desc;
-			desc.BufferLocation = cbvGpuAddress;
-			desc.SizeInBytes = c_alignedConstantBufferSize;
-			d3dDevice->CreateConstantBufferView(&desc, cbvCpuHandle);
-
-			cbvGpuAddress += desc.SizeInBytes;
-			cbvCpuHandle.Offset(m_cbvDescriptorSize);
+			uploadBatch.AddTexture(m_texture.Get(), 0, static_cast<UINT>(textureData.size()), textureData.data());
 		}
-
-		// 상수 버퍼를 매핑합니다.
-		CD3DX12_RANGE readRange(0, 0);		// CPU에서 이 리소스를 읽도록 의도하지 않았습니다.
-		DX::ThrowIfFailed(m_constantBuffer->Map(0, &readRange, reinterpret_cast<void**>(&m_mappedConstantBuffer)));
-		ZeroMemory(m_mappedConstantBuffer, DX::c_frameCount * c_alignedConstantBufferSize);
-		// 이것은 앱이 닫히기 전까지 매핑이 해제되지 않습니다. 리소스의 수명 동안 매핑 상태를 유지하는 것은 허용됩니다.
-
-		// 명령 목록을 닫고 실행하여 GPU의 기본 힙에 꼭짓점/인덱스 버퍼 복사를 시작합니다.
-		DX::ThrowIfFailed(m_commandList->Close());
-		ID3D12CommandList* ppCommandLists[] = { m_commandList.Get() };
-		m_deviceResources->GetCommandQueue()->ExecuteCommandLists(_countof(ppCommandLists), ppCommandLists);
+		m_uploadTicket = (std::max)(uploadBatch.Submit(m_deviceResources->GetCopyQueue()), textureTicket);
 
 		// 꼭짓점/인덱스 버퍼 보기를 만듭니다.
 		m_vertexBufferView.BufferLocation = m_vertexBuffer->GetGPUVirtualAddress();
-		m_vertexBufferView.StrideInBytes = sizeof(VertexPositionColor);
-		m_vertexBufferView.SizeInBytes = sizeof(cubeVertices);
+		m_vertexBufferView.StrideInBytes = sizeof(DX::PackedVertexPositionColorTexture);
+		m_vertexBufferView.SizeInBytes = vertexBufferSize;
 
 		m_indexBufferView.BufferLocation = m_indexBuffer->GetGPUVirtualAddress();
-		m_indexBufferView.SizeInBytes = sizeof(cubeIndices);
+		m_indexBufferView.SizeInBytes = indexBufferSize;
 		m_indexBufferView.Format = DXGI_FORMAT_R16_UINT;
+		m_indexCount = static_cast<UINT>(meshIndices16.size());
 
-		// Note: ComPtr's are CPU objects but this resource needs to stay in scope until
-		// the command list that references it has finished executing on the GPU.
-		// We will flush the GPU at the end of this method to ensure the resource is not
-		// prematurely destroyed.
-		//ComPtr<ID3D12Resource> textureUploadHeap;
-
-		//// Create the texture.
-		//{
-		//	// Describe and create a Texture2D.
-		//	D3D12_RESOURCE_DESC textureDesc = {};
-		//	textureDesc.MipLevels = 1;
-		//	textureDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-		//	textureDesc.Width = TextureWidth;
-		//	textureDesc.Height = TextureHeight;
-		//	textureDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
-		//	textureDesc.DepthOrArraySize = 1;
-		//	textureDesc.SampleDesc.Count = 1;
-		//	textureDesc.SampleDesc.Quality = 0;
-		//	textureDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
-
-		//	DX::ThrowIfFailed(d3dDevice->CreateCommittedResource(
-		//		&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
-		//		D3D12_HEAP_FLAG_NONE,
-		//		&textureDesc,
-		//		D3D12_RESOURCE_STATE_COPY_DEST,
-		//		nullptr,
-		//		IID_PPV_ARGS(&m_texture)));
-
-		//	const UINT64 uploadBufferSize = GetRequiredIntermediateSize(m_texture.Get(), 0, 1);
-
-		//	// Create the GPU upload buffer.
-		//	DX::ThrowIfFailed(d3dDevice->CreateCommittedResource(
-		//		&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
-		//		D3D12_HEAP_FLAG_NONE,
-		//		&CD3DX12_RESOURCE_DESC::Buffer(uploadBufferSize),
-		//		D3D12_RESOURCE_STATE_GENERIC_READ,
-		//		nullptr,
-		//		IID_PPV_ARGS(&textureUploadHeap)));
-
-		//	// Copy data to the intermediate upload heap and then schedule a copy 
-		//	// from the upload heap to the Texture2D.
-		//	std::vector<UINT8> texture = GenerateTextureData();
-
-		//	D3D12_SUBRESOURCE_DATA textureData = {};
-		//	textureData.pData = &texture[0];
-		//	textureData.RowPitch = TextureWidth * TexturePixelSize;
-		//	textureData.SlicePitch = textureData.RowPitch * TextureHeight;
-
-		//	UpdateSubresources(m_commandList.Get(), m_texture.Get(), textureUploadHeap.Get(), 0, 0, 1, &textureData);
-		//	m_commandList->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(m_texture.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE));
-
-		//	// Describe and create a SRV for the texture.
-		//	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-		//	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-		//	srvDesc.Format = textureDesc.Format;
-		//	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-		//	srvDesc.Texture2D.MipLevels = 1;
-		//	d3dDevice->CreateShaderResourceView(m_texture.Get(), &srvDesc, m_deviceResources->GetRtvHeap()->GetCPUDescriptorHandleForHeapStart());
-		//}
-
-		// 명령 목록이 실행을 완료할 때까지 기다리세요. 업로드 리소스가 범위를 벗어나기 전에 꼭짓점/인덱스 버퍼를 GPU에 업로드해야 합니다.
-		m_deviceResources->WaitForGpu();
+		// 업로드 데이터는 복사 큐의 링 버퍼에 남아 있으므로 GPU를 기다릴 필요가 없습니다.
+		// 링 버퍼 공간은 업로드 티켓이 완료되면 회수됩니다.
 	});
 
 	createAssetsTask.then([this]() {
@@ -366,35 +348,13 @@ void Sample3DSceneRenderer::CreateDeviceDependentResources()
 std::vector<UINT8> Sample3DSceneRenderer::GenerateTextureData()
 {
 	const UINT rowPitch = TextureWidth * TexturePixelSize;
-	const UINT cellPitch = rowPitch >> 3;		// The width of a cell in the checkboard texture.
+	const UINT cellWidth = TextureWidth >> 3;	// The width of a cell in the checkboard texture.
 	const UINT cellHeight = TextureWidth >> 3;	// The height of a cell in the checkerboard texture.
-	const UINT textureSize = rowPitch * TextureHeight;
-
-	std::vector<UINT8> data(textureSize);
-	UINT8* pData = &data[0];
 
-	for (UINT n = 0; n < textureSize; n += TexturePixelSize)
-	{
-		UINT x = n % rowPitch;
-		UINT y = n / rowPitch;
-		UINT i = x / cellPitch;
-		UINT j = y / cellHeight;
+	std::vector<UINT8> data(rowPitch * TextureHeight);
 
-		if (i % 2 == j % 2)
-		{
-			pData[n] = 0x00;		// R
-			pData[n + 1] = 0x00;	// G
-			pData[n + 2] = 0x00;	// B
-			pData[n + 3] = 0xff;	// A
-		}
-		else
-		{
-			pData[n] = 0xff;		// R
-			pData[n + 1] = 0xff;	// G
-			pData[n + 2] = 0xff;	// B
-			pData[n + 3] = 0xff;	// A
-		}
-	}
+	DX::TextureDestination destination = { data.data(), TextureWidth, TextureHeight, rowPitch };
+	DX::GenerateChecker(destination, cellWidth, cellHeight, DX::MakeRgba8(0x00, 0x00, 0x00), DX::MakeRgba8(0xff, 0xff, 0xff));
 
 	return data;
 }
@@ -446,22 +406,29 @@ void Sample3DSceneRenderer::CreateWindowSizeDependentResources()
 	XMStoreFloat4x4(&m_constantBufferData.view, XMMatrixTranspose(XMMatrixLookAtRH(eye, at, up)));
 }
 
-// 프레임당 한 번 호출됩니다. 큐브를 회전하고 모델 및 뷰 매트릭스를 계산합니다.
+// 시뮬레이션 단계마다 호출됩니다. 고정 timestep 모드에서는 프레임당 0번 이상 호출될 수 있습니다.
 void Sample3DSceneRenderer::Update(DX::StepTimer const& timer)
+{
+	DX_CPU_ZONE("Sample3DSceneRenderer::Update");
+
+	if (m_loadingComplete && !m_tracking)
+	{
+		// 큐브를 약간 회전합니다. 렌더링 보간을 위해 이전 상태를 보관합니다.
+		m_previousAngle = m_angle;
+		m_angle += static_cast<float>(timer.GetElapsedSeconds()) * m_radiansPerSecond;
+	}
+}
+
+// 프레임당 한 번 호출됩니다. 마지막 두 시뮬레이션 상태를 보간하여 모델 매트릭스를 계산합니다.
+void Sample3DSceneRenderer::Interpolate(DX::StepTimer const& timer)
 {
 	if (m_loadingComplete)
 	{
 		if (!m_tracking)
 		{
-			// 큐브를 약간 회전합니다.
-			m_angle += static_cast<float>(timer.GetElapsedSeconds()) * m_radiansPerSecond;
-
-			Rotate(m_angle);
+			const float alpha = static_cast<float>(timer.GetInterpolationAlpha());
+			Rotate(m_previousAngle + (m_angle - m_previousAngle) * alpha);
 		}
-
-		// 상수 버퍼 리소스를 업데이트합니다.
-		UINT8* destination = m_mappedConstantBuffer + (m_deviceResources->GetCurrentFrameIndex() * c_alignedConstantBufferSize);
-		memcpy(destination, &m_constantBufferData, sizeof(m_constantBufferData));
 	}
 }
 
@@ -499,11 +466,20 @@ void Sample3DSceneRenderer::LoadState()
 	}
 }
 
-// 3D 큐브 모델에 라디안 설정 값을 회전합니다.
+// 3D 큐브 인스턴스마다 라디안 설정 값을 회전합니다.
 void Sample3DSceneRenderer::Rotate(float radians)
 {
-	// 업데이트된 모델 매트릭스를 셰이더에 전달하도록 준비합니다.
-	XMStoreFloat4x4(&m_constantBufferData.model, XMMatrixTranspose(XMMatrixRotationY(radians)));
+	// 모델 행렬은 압축된 위치를 원래 좌표로 되돌리기만 하고, 회전은 인스턴스 변환에 담습니다.
+	XMStoreFloat4x4(&m_constantBufferData.model, XMMatrixTranspose(DX::GetPositionDequantizationMatrix(m_positionQuantization)));
+
+	// Y축 회전 쿼터니언입니다. 셰이더에서 XMMatrixRotationY(radians)와 같은 방향으로 회전합니다.
+	const float halfAngleSin = sinf(radians * 0.5f);
+	const float halfAngleCos = cosf(radians * 0.5f);
+	for (DX::InstanceTransform& instance : m_instanceTransforms)
+	{
+		instance.rotation[1] = halfAngleSin;
+		instance.rotation[3] = halfAngleCos;
+	}
 }
 
 void Sample3DSceneRenderer::StartTracking()
@@ -524,68 +500,56 @@ void Sample3DSceneRenderer::TrackingUpdate(float positionX)
 void Sample3DSceneRenderer::StopTracking()
 {
 	m_tracking = false;
+	m_previousAngle = m_angle;
 }
 
 // 꼭짓점 및 픽셀 셰이더를 사용하여 한 프레임을 렌더링합니다.
 bool Sample3DSceneRenderer::Render()
 {
+	DX_CPU_ZONE("Sample3DSceneRenderer::Render");
+
 	// 로드는 비동기로 수행됩니다. 기하 도형의 로드가 완료되어야 해당 기하 도형을 그립니다.
 	if (!m_loadingComplete)
 	{
 		return false;
 	}
 
-	DX::ThrowIfFailed(m_deviceResources->GetCommandAllocator()->Reset());
-
-	// ExecuteCommandList()가 호출되면 언제든지 명령 목록을 재설정할 수 있습니다.
-	DX::ThrowIfFailed(m_commandList->Reset(m_deviceResources->GetCommandAllocator(), m_pipelineState.Get()));
+	m_frameCommandLists.clear();
 
-	PIXBeginEvent(m_commandList.Get(), 0, L"Draw the cube");
+	// 처음 그리기 전에 직접 큐가 기하 도형 업로드를 GPU에서 기다리도록 합니다. 이후 프레임은 이미 순서가 보장됩니다.
+	if (m_uploadTicket != 0)
 	{
-		// 이 프레임에서 사용할 그래픽 루트 서명 및 설명자 힙을 설정합니다.
-		m_commandList->SetGraphicsRootSignature(m_rootSignature.Get());
-		ID3D12DescriptorHeap* ppHeaps[] = { m_cbvHeap.Get() };
-		m_commandList->SetDescriptorHeaps(_countof(ppHeaps), ppHeaps);
-
-		// 현재 프레임의 상수 버퍼를 파이프라인에 바인딩합니다.
-		CD3DX12_GPU_DESCRIPTOR_HANDLE gpuHandle(m_cbvHeap->GetGPUDescriptorHandleForHeapStart(), m_deviceResources->GetCurrentFrameIndex(), m_cbvDescriptorSize);
-		m_commandList->SetGraphicsRootDescriptorTable(0, gpuHandle);
-
-		// 뷰포트 및 가위 사각형을 설정합니다.
-		D3D12_VIEWPORT viewport = m_deviceResources->GetScreenViewport();
-		m_commandList->RSSetViewports(1, &viewport);
-		m_commandList->RSSetScissorRects(1, &m_scissorRect);
-
-		// 이 리소스가 렌더링 대상으로 사용 중임을 나타냅니다.
-		CD3DX12_RESOURCE_BARRIER renderTargetResourceBarrier =
-			CD3DX12_RESOURCE_BARRIER::Transition(m_deviceResources->GetRenderTarget(), D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_RENDER_TARGET);
-		m_commandList->ResourceBarrier(1, &renderTargetResourceBarrier);
-
-		// 레코드 그리기 명령.
-		D3D12_CPU_DESCRIPTOR_HANDLE renderTargetView = m_deviceResources->GetRenderTargetView();
-		D3D12_CPU_DESCRIPTOR_HANDLE depthStencilView = m_deviceResources->GetDepthStencilView();
-		m_commandList->ClearRenderTargetView(renderTargetView, DirectX::Colors::CornflowerBlue, 0, nullptr);
-		m_commandList->ClearDepthStencilView(depthStencilView, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 0, nullptr);
-
-		m_commandList->OMSetRenderTargets(1, &renderTargetView, false, &depthStencilView);
-
-		m_commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-		m_commandList->IASetVertexBuffers(0, 1, &m_vertexBufferView);
-		m_commandList->IASetIndexBuffer(&m_indexBufferView);
-		m_commandList->DrawIndexedInstanced(36, 1, 0, 0, 0);
-
-		// 이제 명령 목록 실행이 완료되면 표현하는 데 렌더링 대상이 사용됨을 나타냅니다.
-		CD3DX12_RESOURCE_BARRIER presentResourceBarrier =
-			CD3DX12_RESOURCE_BARRIER::Transition(m_deviceResources->GetRenderTarget(), D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PRESENT);
-		m_commandList->ResourceBarrier(1, &presentResourceBarrier);
+		m_deviceResources->GetCopyQueue()->WaitOnQueue(m_deviceResources->GetCommandQueue(), m_uploadTicket);
+		m_uploadTicket = 0;
 	}
-	PIXEndEvent(m_commandList.Get());
-
-	DX::ThrowIfFailed(m_commandList->Close());
 
-	// 명령 목록을 실행합니다.
-	ID3D12CommandList* ppCommandLists[] = { m_commandList.Get() };
-	m_deviceResources->GetCommandQueue()->ExecuteCommandLists(_countof(ppCommandLists), ppCommandLists);
+	CubeDrawState state;
+	state.rootSignature = m_rootSignature.Get();
+	state.pipelineState = m_pipelineState.Get();
+	state.vertexBufferView = m_vertexBufferView;
+	state.indexBufferView = m_indexBufferView;
+	state.indexCount = m_indexCount;
+	state.constants = &m_constantBufferData;
+	state.constantsSize = sizeof(m_constantBufferData);
+	state.instances = m_instanceTransforms.data();
+	state.instanceCount = static_cast<UINT>(m_instanceTransforms.size());
+	state.drawCount = 1;
+	state.recordingWorkerCount = 0;
+	state.textureDescriptors = &m_textureSrv.cpuHandle;
+	state.textureDescriptorCount = 1;
+
+	CubeFrameTarget target;
+	target.renderTarget = m_deviceResources->GetRenderTarget();
+	target.renderTargetView = m_deviceResources->GetRenderTargetView();
+	target.depthStencilView = m_deviceResources->GetDepthStencilView();
+	target.viewport = m_deviceResources->GetScreenViewport();
+	target.scissorRect = m_scissorRect;
+
+	// 명령 목록 기록은 헤드리스 제출 벤치마크와 같은 경로를 사용합니다.
+	RecordCubeFrame(m_deviceResources->GetFrameResources(), state, target, &m_frameCommandLists);
+
+	// 기록한 순서대로 한 번에 제출합니다.
+	m_deviceResources->GetCommandQueue()->ExecuteCommandLists(static_cast<UINT>(m_frameCommandLists.size()), m_frameCommandLists.data());
 
 	return true;
 }
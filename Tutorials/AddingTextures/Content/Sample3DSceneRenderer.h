@@ -1,6 +1,9 @@
 ﻿#pragma once
 
+#include "..\Common\AssetPack.h"
 #include "..\Common\DeviceResources.h"
+#include "..\Common\InstanceBuffer.h"
+#include "..\Common\PackedVertex.h"
 #include "ShaderStructures.h"
 #include "..\Common\StepTimer.h"
 
@@ -15,6 +18,7 @@ namespace AddingTextures
 		void CreateDeviceDependentResources();
 		void CreateWindowSizeDependentResources();
 		void Update(DX::StepTimer const& timer);
+		void Interpolate(DX::StepTimer const& timer);
 		bool Render();
 		void SaveState();
 
@@ -29,37 +33,44 @@ namespace AddingTextures
 		void Rotate(float radians);
 
 	private:
-		// 상수 버퍼는 정렬된 256바이트여야 합니다.
-		static const UINT c_alignedConstantBufferSize = (sizeof(ModelViewProjectionConstantBuffer) + 255) & ~255;
-
 		// 장치 리소스에 대한 캐시된 포인터입니다.
 		std::shared_ptr<DX::DeviceResources> m_deviceResources;
 
 		// 큐브 기하 도형의 Direct3D 리소스입니다.
-		Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList>	m_commandList;
 		Microsoft::WRL::ComPtr<ID3D12RootSignature>			m_rootSignature;
 		Microsoft::WRL::ComPtr<ID3D12PipelineState>			m_pipelineState;
-		Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>		m_cbvHeap;
 		Microsoft::WRL::ComPtr<ID3D12Resource>				m_vertexBuffer;
 		Microsoft::WRL::ComPtr<ID3D12Resource>				m_indexBuffer;
-		Microsoft::WRL::ComPtr<ID3D12Resource>				m_constantBuffer;
 		ModelViewProjectionConstantBuffer					m_constantBufferData;
-		UINT8*												m_mappedConstantBuffer;
-		UINT												m_cbvDescriptorSize;
 		D3D12_RECT											m_scissorRect;
-		std::vector<byte>									m_vertexShader;
-		std::vector<byte>									m_pixelShader;
+		DX::AssetView										m_vertexShader;
+		DX::AssetView										m_pixelShader;
+		DX::AssetView										m_textureFile;
 		D3D12_VERTEX_BUFFER_VIEW							m_vertexBufferView;
 		D3D12_INDEX_BUFFER_VIEW								m_indexBufferView;
+		UINT64												m_rootSignatureHash;
+		DX::UploadTicket									m_uploadTicket;
 		Microsoft::WRL::ComPtr<ID3D12Resource>				m_texture;
+		DX::StagingDescriptor								m_textureSrv;
+		bool												m_hasTextureSrv;
+		DX::PositionQuantization							m_positionQuantization;
+		UINT												m_indexCount;
+
+		// 큐브 인스턴스마다의 변환입니다. 프레임마다 압축하여 인스턴스 버퍼에 쓰고 한 번의 그리기로 모두 그립니다.
+		std::vector<DX::InstanceTransform>					m_instanceTransforms;
+
+		// 프레임마다 제출할 명령 목록입니다. 할당을 피하기 위해 재사용합니다.
+		std::vector<ID3D12CommandList*>						m_frameCommandLists;
 
 		// 렌더링 루프에 사용되는 변수입니다.
 		bool	m_loadingComplete;
 		float	m_radiansPerSecond;
 		float	m_angle;
+		float	m_previousAngle;
 		bool	m_tracking;
 
 		static const UINT FrameCount = 2;
+		static const UINT InstanceGridSize = 1;	// 한 변의 큐브 인스턴스 수입니다. 316이면 약 10만 개를 한 번에 그립니다.
 		static const UINT TextureWidth = 256;
 		static const UINT TextureHeight = 256;
 		static const UINT TexturePixelSize = 4;	// The number of bytes used to represent a pixel in the texture.
@@ -9,9 +9,8 @@ struct PixelShaderInput
 Texture2D g_texture : register(t0);
 SamplerState g_sampler : register(s0);
 
-// ()  Ϳ   ԼԴϴ.
+//  ؽó ǥ ؽó øմϴ.
 float4 main(PixelShaderInput input) : SV_TARGET
 {
-	return float4(input.color, 1.0f);
-	//return g_texture.Sample(g_sampler, input.uv);
+	return g_texture.Sample(g_sampler, input.uv);
 }
@@ -6,6 +6,16 @@ cbuffer ModelViewProjectionConstantBuffer : register(b0)
 	matrix projection;
 };
 
+// νϽ ȯԴϴ(DX::PackedInstance). ȸ x, y, z, w  SNORM16 ʹϾ   uint    Դϴ.
+struct Instance
+{
+	float3 position;
+	float scale;
+	uint2 rotation;
+};
+
+StructuredBuffer<Instance> instances : register(t0);
+
 //  ̴  Է Ǵ  Դϴ.
 struct VertexShaderInput
 {
@@ -22,20 +32,37 @@ struct PixelShaderInput
 	float2 uv : TEXCOORD;
 };
 
+// SNORM16 ʹϾ Ǯ ٽ ȭմϴ.
+float4 DecodeRotation(uint2 packed)
+{
+	int4 q = asint(uint4(packed.x << 16, packed.x, packed.y << 16, packed.y)) >> 16;
+	return normalize(max(q / 32767.0f, -1.0f));
+}
+
+//  ʹϾ ͸ ȸմϴ.
+float3 Rotate(float3 v, float4 q)
+{
+	float3 t = 2.0f * cross(q.xyz, v);
+	return v + q.w * t + cross(q.xyz, t);
+}
+
 // GPU  ó ϱ   ̴Դϴ.
-PixelShaderInput main(VertexShaderInput input)
+PixelShaderInput main(VertexShaderInput input, uint instanceID : SV_InstanceID)
 {
 	PixelShaderInput output;
 	float4 pos = float4(input.pos, 1.0f);
+	Instance instance = instances[instanceID];
 
-	//  ġ ǵ  ȯմϴ.
+	//  ġ νϽ ȯ  ǵ  ȯմϴ.
 	pos = mul(pos, model);
+	pos.xyz = Rotate(pos.xyz * instance.scale, DecodeRotation(instance.rotation)) + instance.position;
 	pos = mul(pos, view);
 	pos = mul(pos, projection);
 	output.pos = pos;
 
-	//    մϴ.
+	//    ؽó ǥ մϴ.
 	output.color = input.color;
+	output.uv = input.uv;
 
 	return output;
 }
@@ -0,0 +1,246 @@
+﻿// AssetPack 검사입니다. SerializeAssetPack으로 만든 팩을 파일로 써서 다시 열고, 항목 내용, 정렬, 압축과 오류 처리를 확인합니다.
+// Linux에서는 표준 라이브러리와 POSIX만 사용합니다. Windows에서는 HANDLE과 ThrowIfFailed 때문에 헤드리스 D3D12 헤더를 함께 씁니다.
+//
+//	g++ -std=c++14 -O2 -I Tests -o AssetPackTests Tests/AssetPackTests.cpp Common/AssetPack.cpp Common/MappedFile.cpp
+//	cl /std:c++14 /O2 /EHsc /DDX_HEADLESS_D3D12 /I Tests Tests\AssetPackTests.cpp Common\AssetPack.cpp Common\MappedFile.cpp
+
+#include "pch.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include "TestHarness.h"
+#include "../Common/AssetPack.h"
+
+namespace
+{
+	const char* c_packName = "AssetPackTests.tmp";
+
+	const DX::AssetId c_textId = DX::MakeAssetId("text.txt");
+	const DX::AssetId c_noiseId = DX::MakeAssetId("noise.bin");
+	const DX::AssetId c_emptyId = DX::MakeAssetId("empty.bin");
+
+	DX::MappedFilePath MakePath(const char* name)
+	{
+		return DX::MappedFilePath(name, name + std::strlen(name));
+	}
+
+	void WriteFile(const char* name, const std::vector<std::uint8_t>& data)
+	{
+		FILE* file = std::fopen(name, "wb");
+		DX_CHECK(file != nullptr);
+		if (file != nullptr)
+		{
+			std::fwrite(data.data(), 1, data.size(), file);
+			std::fclose(file);
+		}
+	}
+
+	// 압축이 잘 되는 반복 텍스트입니다.
+	std::vector<std::uint8_t> MakeText(std::size_t size)
+	{
+		const char* line = "cbuffer ModelViewProjectionConstantBuffer : register(b0) { matrix model; matrix view; };\n";
+		const std::size_t lineLength = std::strlen(line);
+		std::vector<std::uint8_t> data(size);
+		for (std::size_t i = 0; i < size; i++)
+		{
+			data[i] = static_cast<std::uint8_t>(line[i % lineLength]);
+		}
+		return data;
+	}
+
+	// 압축되지 않는 의사 난수 데이터입니다.
+	std::vector<std::uint8_t> MakeNoise(std::size_t size, std::uint32_t seed)
+	{
+		std::vector<std::uint8_t> data(size);
+		std::uint32_t state = seed;
+		for (std::size_t i = 0; i < size; i++)
+		{
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			data[i] = static_cast<std::uint8_t>(state);
+		}
+		return data;
+	}
+
+	DX::AssetPackInput MakeInput(DX::AssetId id, const std::vector<std::uint8_t>& data, std::uint32_t alignment, bool compress)
+	{
+		DX::AssetPackInput input;
+		input.id = id;
+		input.data = data;
+		input.alignment = alignment;
+		input.compress = compress;
+		return input;
+	}
+
+	// 쓰고 다시 연 팩의 모든 항목이 원본과 같고, 압축하지 않은 항목은 정렬된 매핑을 그대로 가리킵니다.
+	void TestRoundTrip()
+	{
+		const std::vector<std::uint8_t> text = MakeText(100000);
+		const std::vector<std::uint8_t> noise = MakeNoise(200000, 1);
+
+		std::vector<DX::AssetPackInput> inputs;
+		inputs.push_back(MakeInput(c_textId, text, DX::c_assetPackDefaultAlignment, true));
+		inputs.push_back(MakeInput(c_noiseId, noise, DX::c_assetPackLargeAlignment, true));
+		inputs.push_back(MakeInput(c_emptyId, std::vector<std::uint8_t>(), DX::c_assetPackDefaultAlignment, true));
+
+		std::vector<std::uint8_t> packData;
+		DX_CHECK(DX::SerializeAssetPack(inputs, &packData));
+		WriteFile(c_packName, packData);
+
+		{
+			std::shared_ptr<const DX::AssetPack> pack = DX::AssetPack::Open(MakePath(c_packName));
+			DX_CHECK(pack->GetEntryCount() == 3);
+			DX_CHECK(pack->Contains(c_textId));
+			DX_CHECK(!pack->Contains(DX::MakeAssetId("missing.bin")));
+
+			// 텍스트는 압축되고, 난수 데이터는 압축해도 작아지지 않으므로 원본 그대로 저장됩니다.
+			DX::AssetPackEntry entry;
+			DX_CHECK(pack->Find(c_textId, &entry) && (entry.flags & DX::c_assetEntryCompressed) != 0 && entry.storedSize < text.size());
+			DX_CHECK(pack->Find(c_noiseId, &entry) && (entry.flags & DX::c_assetEntryCompressed) == 0);
+			DX_CHECK(entry.offset % DX::c_assetPackLargeAlignment == 0);
+
+			const DX::AssetView textView = pack->Load(c_textId);
+			DX_CHECK(textView.GetSize() == text.size() && std::memcmp(textView.GetData(), text.data(), text.size()) == 0);
+
+			const DX::AssetView noiseView = pack->Load(c_noiseId);
+			DX_CHECK(noiseView.GetSize() == noise.size() && std::memcmp(noiseView.GetData(), noise.data(), noise.size()) == 0);
+			DX_CHECK(reinterpret_cast<std::uintptr_t>(noiseView.GetData()) % DX::c_assetPackDefaultAlignment == 0);
+
+			const DX::AssetView emptyView = pack->Load(c_emptyId);
+			DX_CHECK(emptyView.IsValid() && emptyView.GetSize() == 0);
+		}
+		std::remove(c_packName);
+	}
+
+	// 보기는 팩이 해제된 뒤에도 매핑을 유지합니다.
+	void TestViewOutlivesPack()
+	{
+		const std::vector<std::uint8_t> noise = MakeNoise(10000, 2);
+		std::vector<DX::AssetPackInput> inputs;
+		inputs.push_back(MakeInput(c_noiseId, noise, DX::c_assetPackDefaultAlignment, false));
+
+		std::vector<std::uint8_t> packData;
+		DX_CHECK(DX::SerializeAssetPack(inputs, &packData));
+		WriteFile(c_packName, packData);
+		{
+			DX::AssetView view;
+			{
+				std::shared_ptr<const DX::AssetPack> pack = DX::AssetPack::Open(MakePath(c_packName));
+				view = pack->Load(c_noiseId);
+			}
+			DX_CHECK(view.GetSize() == noise.size() && std::memcmp(view.GetData(), noise.data(), noise.size()) == 0);
+		}
+		std::remove(c_packName);
+	}
+
+	// 중복 ID와 2의 거듭제곱이 아닌 정렬은 팩을 만들지 않습니다.
+	void TestSerializeRejectsInvalidInputs()
+	{
+		std::vector<std::uint8_t> packData;
+		std::vector<DX::AssetPackInput> duplicates;
+		duplicates.push_back(MakeInput(c_textId, MakeText(10), 16, false));
+		duplicates.push_back(MakeInput(c_textId, MakeText(20), 16, false));
+		DX_CHECK(!DX::SerializeAssetPack(duplicates, &packData));
+
+		std::vector<DX::AssetPackInput> badAlignment;
+		badAlignment.push_back(MakeInput(c_textId, MakeText(10), 24, false));
+		DX_CHECK(!DX::SerializeAssetPack(badAlignment, &packData));
+	}
+
+	bool OpenThrows(const std::vector<std::uint8_t>& data)
+	{
+		WriteFile(c_packName, data);
+		bool threw = false;
+		try
+		{
+			DX::AssetPack::Open(MakePath(c_packName));
+		}
+		catch (const std::exception&)
+		{
+			threw = true;
+		}
+		std::remove(c_packName);
+		return threw;
+	}
+
+	// 손상된 팩은 열 때 거부하고, 없는 항목을 가져오면 예외가 발생합니다.
+	void TestInvalidPacks()
+	{
+		std::vector<DX::AssetPackInput> inputs;
+		inputs.push_back(MakeInput(c_textId, MakeText(5000), 16, false));
+		std::vector<std::uint8_t> packData;
+		DX_CHECK(DX::SerializeAssetPack(inputs, &packData));
+
+		std::vector<std::uint8_t> badMagic = packData;
+		badMagic[0] ^= 0xFF;
+		DX_CHECK(OpenThrows(badMagic));
+
+		std::vector<std::uint8_t> truncated(packData.begin(), packData.begin() + packData.size() / 2);
+		DX_CHECK(OpenThrows(truncated));
+
+		DX_CHECK(OpenThrows(std::vector<std::uint8_t>(3, 0)));
+
+		WriteFile(c_packName, packData);
+		{
+			std::shared_ptr<const DX::AssetPack> pack = DX::AssetPack::Open(MakePath(c_packName));
+			bool threw = false;
+			try
+			{
+				pack->Load(c_noiseId);
+			}
+			catch (const std::exception&)
+			{
+				threw = true;
+			}
+			DX_CHECK(threw);
+		}
+		std::remove(c_packName);
+	}
+
+	// LZ4 블록은 왕복이 정확하고, 손상된 블록은 대상 범위 밖에 쓰지 않고 실패합니다.
+	void TestLz4Blocks()
+	{
+		const std::vector<std::uint8_t> text = MakeText(70000);
+		const std::vector<std::uint8_t> compressed = DX::Lz4CompressBlock(text.data(), text.size());
+		std::vector<std::uint8_t> decompressed(text.size());
+		DX_CHECK(DX::Lz4DecompressBlock(compressed.data(), compressed.size(), decompressed.data(), decompressed.size()));
+		DX_CHECK(decompressed == text);
+
+		// 대상보다 긴 출력은 거부합니다.
+		std::vector<std::uint8_t> small(text.size() - 1);
+		DX_CHECK(!DX::Lz4DecompressBlock(compressed.data(), compressed.size(), small.data(), small.size()));
+
+		std::uint32_t state = 7;
+		for (int trial = 0; trial < 2000; trial++)
+		{
+			std::vector<std::uint8_t> corrupted = compressed;
+			for (int flip = 0; flip < 4; flip++)
+			{
+				state = state * 1664525u + 1013904223u;
+				corrupted[(state >> 8) % corrupted.size()] ^= static_cast<std::uint8_t>(state >> 24 | 1);
+			}
+
+			// 가드 바이트가 덮이지 않아야 합니다.
+			std::vector<std::uint8_t> output(text.size() + 16, 0xCD);
+			DX::Lz4DecompressBlock(corrupted.data(), corrupted.size(), output.data(), text.size());
+			bool guardIntact = true;
+			for (std::size_t i = text.size(); i < output.size(); i++)
+			{
+				guardIntact = guardIntact && output[i] == 0xCD;
+			}
+			DX_CHECK(guardIntact);
+		}
+	}
+}
+
+int main()
+{
+	TestRoundTrip();
+	TestViewOutlivesPack();
+	TestSerializeRejectsInvalidInputs();
+	TestInvalidPacks();
+	TestLz4Blocks();
+	return DX::Test::Finish("AssetPackTests");
+}
@@ -0,0 +1,351 @@
+﻿// 블록 압축기의 품질(PSNR) 검사와 처리량(블록/초) 벤치마크입니다.
+// 압축한 블록은 여기의 기준 디코더(BC1, BC3 알파, BC7 모드 6)로 풀어 원본과 비교합니다.
+// Linux에서는 표준 라이브러리만 사용합니다. Windows에서는 ThrowIfFailed 때문에 헤드리스 D3D12 헤더를 함께 씁니다.
+//
+//	g++ -std=c++14 -O2 -pthread -I Tests -o BlockCompressionBenchmark Tests/BlockCompressionBenchmark.cpp Common/BlockCompression.cpp Common/ProceduralTexture.cpp
+//	cl /std:c++14 /O2 /EHsc /DDX_HEADLESS_D3D12 /I Tests Tests\BlockCompressionBenchmark.cpp Common\BlockCompression.cpp Common\ProceduralTexture.cpp
+
+#include "pch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "TestHarness.h"
+#include "../Common/BlockCompression.h"
+#include "../Common/ProceduralTexture.h"
+
+namespace
+{
+	const DX::BlockFormat c_formats[] = { DX::BlockFormat::BC1, DX::BlockFormat::BC3, DX::BlockFormat::BC7 };
+	const char* const c_formatNames[] = { "BC1", "BC3", "BC7" };
+	const DX::BlockCompressionQuality c_qualities[] = { DX::BlockCompressionQuality::Fast, DX::BlockCompressionQuality::Normal, DX::BlockCompressionQuality::High };
+	const char* const c_qualityNames[] = { "Fast", "Normal", "High" };
+
+	// 형식마다 이 텍스처에서 요구하는 최소 PSNR(dB)입니다. BC1은 색만, 나머지는 알파도 확인합니다.
+	const double c_minColorPsnr[] = { 40.0, 40.0, 46.0 };
+	const double c_minAlphaPsnr[] = { 0.0, 42.0, 46.0 };
+
+	void DecodeRgb565(std::uint16_t color, int* rgb)
+	{
+		const int r = (color >> 11) & 31;
+		const int g = (color >> 5) & 63;
+		const int b = color & 31;
+		rgb[0] = (r << 3) | (r >> 2);
+		rgb[1] = (g << 2) | (g >> 4);
+		rgb[2] = (b << 3) | (b >> 2);
+	}
+
+	// BC1 색 블록을 풉니다. BC3의 색 블록은 끝점 순서와 관계없이 항상 4색입니다.
+	void DecodeColorBlock(const std::uint8_t* block, bool alwaysFourColors, std::uint8_t* pixels)
+	{
+		const std::uint16_t color0 = static_cast<std::uint16_t>(block[0] | (block[1] << 8));
+		const std::uint16_t color1 = static_cast<std::uint16_t>(block[2] | (block[3] << 8));
+		int palette[4][4];
+		DecodeRgb565(color0, palette[0]);
+		DecodeRgb565(color1, palette[1]);
+		palette[0][3] = palette[1][3] = 255;
+		for (int c = 0; c < 3; c++)
+		{
+			if (alwaysFourColors || color0 > color1)
+			{
+				palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+			}
+			else
+			{
+				palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+				palette[3][c] = 0;
+			}
+		}
+		palette[2][3] = 255;
+		palette[3][3] = (alwaysFourColors || color0 > color1) ? 255 : 0;
+
+		const std::uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<std::uint32_t>(block[7]) << 24);
+		for (int i = 0; i < 16; i++)
+		{
+			const int index = (indices >> (2 * i)) & 3;
+			for (int c = 0; c < 4; c++)
+			{
+				pixels[i * 4 + c] = static_cast<std::uint8_t>(palette[index][c]);
+			}
+		}
+	}
+
+	// BC3 알파 블록을 풀어 알파 채널에 씁니다.
+	void DecodeAlphaBlock(const std::uint8_t* block, std::uint8_t* pixels)
+	{
+		const int alpha0 = block[0];
+		const int alpha1 = block[1];
+		int palette[8] = { alpha0, alpha1 };
+		if (alpha0 > alpha1)
+		{
+			for (int i = 1; i < 7; i++)
+			{
+				palette[i + 1] = ((7 - i) * alpha0 + i * alpha1 + 3) / 7;
+			}
+		}
+		else
+		{
+			for (int i = 1; i < 5; i++)
+			{
+				palette[i + 1] = ((5 - i) * alpha0 + i * alpha1 + 2) / 5;
+			}
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+
+		std::uint64_t indices = 0;
+		for (int i = 0; i < 6; i++)
+		{
+			indices |= static_cast<std::uint64_t>(block[2 + i]) << (8 * i);
+		}
+		for (int i = 0; i < 16; i++)
+		{
+			pixels[i * 4 + 3] = static_cast<std::uint8_t>(palette[(indices >> (3 * i)) & 7]);
+		}
+	}
+
+	// BC7 모드 6 블록을 풉니다. 다른 모드이면 false를 반환합니다.
+	bool DecodeBc7Mode6Block(const std::uint8_t* block, std::uint8_t* pixels)
+	{
+		int position = 0;
+		auto read = [&](int bits)
+		{
+			std::uint32_t value = 0;
+			for (int i = 0; i < bits; i++, position++)
+			{
+				value |= ((block[position >> 3] >> (position & 7)) & 1u) << i;
+			}
+			return static_cast<int>(value);
+		};
+
+		if (read(7) != 0x40)
+		{
+			return false;
+		}
+
+		int endpoints[2][4];
+		for (int c = 0; c < 4; c++)
+		{
+			endpoints[0][c] = read(7);
+			endpoints[1][c] = read(7);
+		}
+		const int pBit0 = read(1);
+		const int pBit1 = read(1);
+		for (int c = 0; c < 4; c++)
+		{
+			endpoints[0][c] = (endpoints[0][c] << 1) | pBit0;
+			endpoints[1][c] = (endpoints[1][c] << 1) | pBit1;
+		}
+
+		static const int weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+		for (int i = 0; i < 16; i++)
+		{
+			const int weight = weights[read(i == 0 ? 3 : 4)];
+			for (int c = 0; c < 4; c++)
+			{
+				pixels[i * 4 + c] = static_cast<std::uint8_t>(((64 - weight) * endpoints[0][c] + weight * endpoints[1][c] + 32) >> 6);
+			}
+		}
+		return true;
+	}
+
+	void DecodeBlock(DX::BlockFormat format, const std::uint8_t* block, std::uint8_t* pixels)
+	{
+		switch (format)
+		{
+		case DX::BlockFormat::BC1:
+			DecodeColorBlock(block, false, pixels);
+			break;
+
+		case DX::BlockFormat::BC3:
+			DecodeColorBlock(block + 8, true, pixels);
+			DecodeAlphaBlock(block, pixels);
+			break;
+
+		case DX::BlockFormat::BC7:
+			DX_CHECK(DecodeBc7Mode6Block(block, pixels));
+			break;
+		}
+	}
+
+	std::vector<std::uint8_t> DecodeTexture(DX::BlockFormat format, const std::uint8_t* data, std::size_t rowPitch, std::uint32_t width, std::uint32_t height)
+	{
+		std::vector<std::uint8_t> image(static_cast<std::size_t>(width) * height * 4);
+		std::uint8_t pixels[64];
+		for (std::uint32_t blockY = 0; blockY < DX::GetBlockCount(height); blockY++)
+		{
+			for (std::uint32_t blockX = 0; blockX < DX::GetBlockCount(width); blockX++)
+			{
+				DecodeBlock(format, data + blockY * rowPitch + blockX * DX::GetBlockSize(format), pixels);
+				for (std::uint32_t y = 0; y < 4 && blockY * 4 + y < height; y++)
+				{
+					for (std::uint32_t x = 0; x < 4 && blockX * 4 + x < width; x++)
+					{
+						std::memcpy(&image[((blockY * 4 + y) * static_cast<std::size_t>(width) + blockX * 4 + x) * 4], &pixels[(y * 4 + x) * 4], 4);
+					}
+				}
+			}
+		}
+		return image;
+	}
+
+	// channelCount 채널(0부터)의 PSNR입니다. 오차가 없으면 99 dB를 반환합니다.
+	double ComputePsnr(const std::vector<std::uint8_t>& expected, const std::vector<std::uint8_t>& actual, int firstChannel, int channelCount)
+	{
+		double squaredError = 0.0;
+		std::size_t samples = 0;
+		for (std::size_t i = 0; i < expected.size(); i += 4)
+		{
+			for (int c = firstChannel; c < firstChannel + channelCount; c++)
+			{
+				const double difference = static_cast<double>(expected[i + c]) - actual[i + c];
+				squaredError += difference * difference;
+				samples++;
+			}
+		}
+		const double meanSquaredError = squaredError / samples;
+		return meanSquaredError == 0.0 ? 99.0 : 10.0 * std::log10(255.0 * 255.0 / meanSquaredError);
+	}
+
+	// 부드러운 색 노이즈에 알파 노이즈와 밝기 줄무늬를 섞은 시험 이미지입니다.
+	std::vector<std::uint8_t> MakeTestImage(std::uint32_t width, std::uint32_t height)
+	{
+		std::vector<std::uint8_t> image(static_cast<std::size_t>(width) * height * 4);
+		std::vector<std::uint8_t> detail(image.size());
+		const DX::TextureDestination imageDestination = { image.data(), width, height, width * 4 };
+		const DX::TextureDestination detailDestination = { detail.data(), width, height, width * 4 };
+		DX::GenerateValueNoise(imageDestination, 128, 6, 3, DX::MakeRgba8(20, 40, 10, 0), DX::MakeRgba8(240, 200, 90, 255));
+		DX::GenerateValueNoise(detailDestination, 32, 4, 9, DX::MakeRgba8(0, 0, 0, 0), DX::MakeRgba8(255, 255, 255, 255));
+
+		for (std::size_t i = 0; i < image.size(); i += 4)
+		{
+			const std::size_t pixel = i / 4;
+			image[i + 2] = detail[i];
+			image[i + 3] = detail[i + 1];
+			if (((pixel % width) / 64 + (pixel / width) / 64) % 5 == 0)
+			{
+				image[i] = static_cast<std::uint8_t>(image[i] / 2 + 100);
+			}
+		}
+		return image;
+	}
+
+	// 단색 블록은 거의 그대로 복원되고, BC1은 알파가 128 미만인 픽셀을 투명하게 만듭니다.
+	void TestSolidAndTransparentBlocks()
+	{
+		std::uint8_t pixels[64];
+		for (int i = 0; i < 16; i++)
+		{
+			pixels[i * 4] = 200;
+			pixels[i * 4 + 1] = 33;
+			pixels[i * 4 + 2] = 90;
+			pixels[i * 4 + 3] = 255;
+		}
+
+		for (int f = 0; f < 3; f++)
+		{
+			std::uint8_t block[16];
+			std::uint8_t decoded[64];
+			DX::CompressBlock(pixels, c_formats[f], DX::BlockCompressionQuality::Fast, block);
+			DecodeBlock(c_formats[f], block, decoded);
+			for (int c = 0; c < 4; c++)
+			{
+				DX_CHECK(std::abs(decoded[c] - pixels[c]) <= 1);
+			}
+		}
+
+		for (int i = 0; i < 16; i++)
+		{
+			pixels[i * 4] = static_cast<std::uint8_t>(i * 16);
+			pixels[i * 4 + 1] = static_cast<std::uint8_t>(255 - i * 16);
+			pixels[i * 4 + 2] = 7;
+			pixels[i * 4 + 3] = (i & 1) != 0 ? 255 : 0;
+		}
+
+		std::uint8_t block[8];
+		std::uint8_t decoded[64];
+		DX::CompressBlock(pixels, DX::BlockFormat::BC1, DX::BlockCompressionQuality::High, block);
+		DecodeBlock(DX::BlockFormat::BC1, block, decoded);
+		for (int i = 0; i < 16; i++)
+		{
+			DX_CHECK((decoded[i * 4 + 3] == 255) == (pixels[i * 4 + 3] == 255));
+		}
+	}
+
+	// 4의 배수가 아닌 크기는 부분 블록을 포함하고, 블록 행 사이의 여백은 건드리지 않습니다.
+	void TestPartialBlocksAndPitch()
+	{
+		std::vector<std::uint8_t> source(7 * 5 * 4);
+		for (std::size_t i = 0; i < source.size(); i++)
+		{
+			source[i] = static_cast<std::uint8_t>(i * 37);
+		}
+
+		for (int f = 0; f < 3; f++)
+		{
+			const std::size_t pitch = 256;
+			const std::size_t used = DX::GetBlockCompressedRowPitch(c_formats[f], 7);
+			std::vector<std::uint8_t> blocks(pitch * 2, 0xcd);
+			DX::CompressTexture(source.data(), 7, 5, 28, c_formats[f], DX::BlockCompressionQuality::Normal, blocks.data(), pitch);
+			DX_CHECK(used == 2 * DX::GetBlockSize(c_formats[f]));
+			DX_CHECK(blocks[used] == 0xcd && blocks[pitch - 1] == 0xcd && blocks[pitch + used] == 0xcd);
+		}
+	}
+
+	// 형식과 품질마다 PSNR과 처리량을 출력하고, PSNR이 형식의 하한 이상인지 확인합니다.
+	void BenchmarkFormats()
+	{
+		const std::uint32_t size = 512;
+		const std::vector<std::uint8_t> image = MakeTestImage(size, size);
+		const double blockCount = static_cast<double>(DX::GetBlockCount(size)) * DX::GetBlockCount(size);
+
+		std::printf("형식 품질    PSNR(RGB) PSNR(A)  M블록/초\n");
+		for (int f = 0; f < 3; f++)
+		{
+			// BC1은 1비트 알파이므로 기준 이미지의 알파를 같은 규칙으로 자르고 투명한 픽셀은 검정으로 둡니다.
+			std::vector<std::uint8_t> reference = image;
+			if (c_formats[f] == DX::BlockFormat::BC1)
+			{
+				for (std::size_t i = 0; i < reference.size(); i += 4)
+				{
+					if (reference[i + 3] < 128)
+					{
+						reference[i] = reference[i + 1] = reference[i + 2] = reference[i + 3] = 0;
+					}
+					else
+					{
+						reference[i + 3] = 255;
+					}
+				}
+			}
+
+			const std::size_t rowPitch = DX::GetBlockCompressedRowPitch(c_formats[f], size);
+			std::vector<std::uint8_t> blocks(rowPitch * DX::GetBlockCount(size));
+			for (int q = 0; q < 3; q++)
+			{
+				const double seconds = DX::Test::MeasureBestSeconds(2, [&]()
+				{
+					DX::CompressTexture(image.data(), size, size, size * 4, c_formats[f], c_qualities[q], blocks.data(), rowPitch);
+				});
+
+				const std::vector<std::uint8_t> decoded = DecodeTexture(c_formats[f], blocks.data(), rowPitch, size, size);
+				const double colorPsnr = ComputePsnr(reference, decoded, 0, 3);
+				const double alphaPsnr = ComputePsnr(reference, decoded, 3, 1);
+				std::printf("%-4s %-7s %9.2f %8.2f %9.2f\n", c_formatNames[f], c_qualityNames[q], colorPsnr, alphaPsnr, blockCount / seconds / 1e6);
+				DX_CHECK(colorPsnr >= c_minColorPsnr[f]);
+				DX_CHECK(alphaPsnr >= c_minAlphaPsnr[f]);
+			}
+		}
+	}
+}
+
+int main()
+{
+	TestSolidAndTransparentBlocks();
+	TestPartialBlocksAndPitch();
+	BenchmarkFormats();
+	return DX::Test::Finish("BlockCompressionBenchmark");
+}
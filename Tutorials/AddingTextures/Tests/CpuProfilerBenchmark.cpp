@@ -0,0 +1,190 @@
+﻿// CpuProfiler 구간 기록의 검사와 마이크로벤치마크입니다. 구간 하나의 비용은 20 ns 미만이어야 합니다.
+// 표준 라이브러리만 사용하므로 Windows와 Linux에서 모두 빌드됩니다. 벤치마크는 최적화 빌드에서 실행해야 합니다.
+//
+//	g++ -std=c++14 -O2 -pthread -I Tests -o CpuProfilerBenchmark Tests/CpuProfilerBenchmark.cpp
+//	cl /std:c++14 /O2 /EHsc /I Tests Tests\CpuProfilerBenchmark.cpp
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "TestHarness.h"
+#include "../Common/CpuProfiler.h"
+
+namespace
+{
+	const double c_maxNanosecondsPerZone = 20.0;
+	const double c_maxBookkeepingNanosecondsPerZone = 5.0;	// 카운터 두 번 읽기를 뺀 링 기록 비용입니다.
+
+	volatile int g_sink;
+
+	// 호출 스레드의 링에 남아 있는 구간 중 name인 것의 수입니다.
+	size_t CountZones(const char* name)
+	{
+		std::vector<DX::CpuZoneEvent> zones;
+		DX::CpuProfiler::Get().GetThreadBuffer()->Snapshot(&zones);
+
+		size_t count = 0;
+		for (const auto& zone : zones)
+		{
+			count += zone.name == name ? 1 : 0;
+		}
+		return count;
+	}
+
+	// 안쪽 구간은 바깥 구간보다 먼저 끝나고 그 범위 안에 있습니다.
+	void TestNestedZones()
+	{
+		static const char* const outerName = "Outer";
+		static const char* const innerName = "Inner";
+		{
+			DX::CpuZone outer(outerName);
+			{
+				DX::CpuZone inner(innerName);
+				g_sink = 1;
+			}
+		}
+
+		std::vector<DX::CpuZoneEvent> zones;
+		DX::CpuProfiler::Get().GetThreadBuffer()->Snapshot(&zones);
+		DX_CHECK(zones.size() >= 2);
+		if (zones.size() >= 2)
+		{
+			const DX::CpuZoneEvent& inner = zones[zones.size() - 2];
+			const DX::CpuZoneEvent& outer = zones[zones.size() - 1];
+			DX_CHECK(inner.name == innerName && outer.name == outerName);
+			DX_CHECK(outer.begin <= inner.begin && inner.begin <= inner.end && inner.end <= outer.end);
+		}
+	}
+
+	// 비활성화하면 구간이 기록되지 않습니다.
+	void TestDisabled()
+	{
+		static const char* const name = "Disabled";
+		DX::CpuProfiler::Get().SetEnabled(false);
+		for (int i = 0; i < 10; i++)
+		{
+			DX::CpuZone zone(name);
+		}
+		DX::CpuProfiler::Get().SetEnabled(true);
+		DX_CHECK(CountZones(name) == 0);
+	}
+
+	// 링이 가득 차면 가장 오래된 구간부터 덮어쓰고 용량만큼만 남깁니다.
+	void TestRingOverwrite()
+	{
+		static const char* const name = "Overwrite";
+		for (std::uint32_t i = 0; i < DX::CpuZoneBuffer::c_capacity + 100; i++)
+		{
+			DX::CpuZone zone(name);
+		}
+
+		std::vector<DX::CpuZoneEvent> zones;
+		DX::CpuProfiler::Get().GetThreadBuffer()->Snapshot(&zones);
+		DX_CHECK(zones.size() == DX::CpuZoneBuffer::c_capacity);
+		DX_CHECK(CountZones(name) == DX::CpuZoneBuffer::c_capacity);
+	}
+
+	// 다른 스레드가 기록하는 동안 내보낼 수 있으며, 스레드 이름과 구간 이름은 JSON 문자열로 이스케이프됩니다.
+	void TestExportWhileRecording()
+	{
+		std::thread worker([]()
+		{
+			DX::CpuProfiler::Get().SetCurrentThreadName("Worker \"1\"");
+			for (int i = 0; i < 100000; i++)
+			{
+				DX_CPU_ZONE("Worker zone");
+				g_sink = i;
+			}
+		});
+
+		for (int i = 0; i < 20; i++)
+		{
+			std::ostringstream stream;
+			DX::CpuProfiler::Get().ExportChromeTrace(stream);
+		}
+		worker.join();
+
+		std::ostringstream stream;
+		DX::CpuProfiler::Get().ExportChromeTrace(stream);
+		const std::string trace = stream.str();
+		DX_CHECK(trace.compare(0, 16, "{\"displayTimeUn") == 0 || trace.find("\"traceEvents\":[") != std::string::npos);
+		DX_CHECK(trace.find("\"name\":\"Worker \\\"1\\\"\"") != std::string::npos);
+		DX_CHECK(trace.find("\"name\":\"Worker zone\",\"ph\":\"X\"") != std::string::npos);
+		DX_CHECK(trace.compare(trace.size() - 4, 4, "\n]}\n") == 0);
+	}
+
+	// 빈 구간 하나를 열고 닫는 비용을 잽니다. 비활성화된 구간, 카운터 읽기, 빈 루프의 비용도 함께 출력합니다.
+	// 가상 머신은 RDTSC를 가로채 카운터 읽기만으로 예산을 넘을 수 있으므로, 그때는 링 기록 비용만 확인합니다.
+	void BenchmarkZones()
+	{
+		const int zonesPerRun = 1000000;
+
+		{
+			DX_CPU_ZONE("Warm up");		// 스레드 링을 등록합니다.
+		}
+
+		const double enabledSeconds = DX::Test::MeasureBestSeconds(5, [&]()
+		{
+			for (int i = 0; i < zonesPerRun; i++)
+			{
+				DX_CPU_ZONE("Benchmark");
+				g_sink = i;
+			}
+		});
+
+		DX::CpuProfiler::Get().SetEnabled(false);
+		const double disabledSeconds = DX::Test::MeasureBestSeconds(5, [&]()
+		{
+			for (int i = 0; i < zonesPerRun; i++)
+			{
+				DX_CPU_ZONE("Benchmark");
+				g_sink = i;
+			}
+		});
+		DX::CpuProfiler::Get().SetEnabled(true);
+
+		const double loopSeconds = DX::Test::MeasureBestSeconds(5, [&]()
+		{
+			for (int i = 0; i < zonesPerRun; i++)
+			{
+				g_sink = i;
+			}
+		});
+
+		volatile std::uint64_t counterSink = 0;
+		const double counterSeconds = DX::Test::MeasureBestSeconds(5, [&]()
+		{
+			for (int i = 0; i < zonesPerRun; i++)
+			{
+				counterSink = DX::CpuProfiler::ReadCounter();
+			}
+		});
+
+		const double enabledNanoseconds = enabledSeconds * 1e9 / zonesPerRun;
+		const double counterNanoseconds = counterSeconds * 1e9 / zonesPerRun;
+		const double bookkeepingNanoseconds = enabledNanoseconds - 2.0 * counterNanoseconds;
+		std::printf("구간당: 활성 %6.2f ns (링 기록 %5.2f ns), 비활성 %6.2f ns, 카운터 읽기 %6.2f ns, 빈 루프 %6.2f ns\n",
+			enabledNanoseconds, bookkeepingNanoseconds, disabledSeconds * 1e9 / zonesPerRun, counterNanoseconds, loopSeconds * 1e9 / zonesPerRun);
+
+		DX_CHECK(bookkeepingNanoseconds < c_maxBookkeepingNanosecondsPerZone);
+		if (2.0 * counterNanoseconds + c_maxBookkeepingNanosecondsPerZone < c_maxNanosecondsPerZone)
+		{
+			DX_CHECK(enabledNanoseconds < c_maxNanosecondsPerZone);
+		}
+		else
+		{
+			std::printf("카운터 읽기가 느려 구간당 %.0f ns 예산은 확인하지 않았습니다(가상화된 TSC).\n", c_maxNanosecondsPerZone);
+		}
+	}
+}
+
+int main()
+{
+	TestNestedZones();
+	TestDisabled();
+	TestRingOverwrite();
+	TestExportWhileRecording();
+	BenchmarkZones();
+	return DX::Test::Finish("CpuProfilerBenchmark");
+}
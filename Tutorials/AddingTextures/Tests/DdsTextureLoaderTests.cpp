@@ -0,0 +1,285 @@
+﻿// DDS 하위 리소스 배치와 CreateDdsTexture의 검사입니다. 로더는 헤드리스 D3D12(NullDevice)와 복사 큐에서 실행합니다.
+// 작은 링 버퍼로 텍스처를 여러 제출로 나누어 올리는 경로와, 도중의 제출이 실패할 때 이전 복사를 기다리는지 확인합니다.
+// Windows가 아닌 플랫폼에서는 DirectX-Headers(https://github.com/microsoft/DirectX-Headers)가 필요합니다.
+//
+//	g++ -std=c++14 -O2 -pthread -DDX_HEADLESS_D3D12 -I Tests -I $DXH/include -I $DXH/include/wsl/stubs -o DdsTextureLoaderTests Tests/DdsTextureLoaderTests.cpp Common/DdsTextureLoader.cpp Common/CopyQueue.cpp Common/UploadRingBuffer.cpp Common/SubresourceCopy.cpp Common/NullDevice.cpp
+//	cl /std:c++14 /O2 /EHsc /DDX_HEADLESS_D3D12 /I Tests Tests\DdsTextureLoaderTests.cpp Common\DdsTextureLoader.cpp Common\CopyQueue.cpp Common\UploadRingBuffer.cpp Common\SubresourceCopy.cpp Common\NullDevice.cpp dxguid.lib
+
+#include "pch.h"
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include "TestHarness.h"
+#include "../Common/DdsTextureLoader.h"
+#include "../Common/DirectXHelper.h"
+
+using Microsoft::WRL::ComPtr;
+
+namespace
+{
+	// magic, 헤더, (ext가 있으면) DX10 헤더 뒤에 dataSize바이트의 데이터가 오는 파일입니다.
+	std::vector<std::uint8_t> MakeDdsFile(
+		std::uint32_t width,
+		std::uint32_t height,
+		std::uint32_t depth,
+		std::uint32_t mipLevels,
+		const DX::DdsPixelFormat& pixelFormat,
+		std::uint32_t flags,
+		std::uint32_t caps2,
+		const DX::DdsHeaderDx10* ext,
+		std::uint64_t dataSize)
+	{
+		const std::size_t headerSize = 4 + DX::c_ddsHeaderSize + (ext != nullptr ? DX::c_ddsHeaderDx10Size : 0);
+		std::vector<std::uint8_t> file(headerSize + static_cast<std::size_t>(dataSize));
+		std::memcpy(file.data(), &DX::c_ddsMagic, 4);
+
+		DX::DdsHeader header = {};
+		header.size = static_cast<std::uint32_t>(DX::c_ddsHeaderSize);
+		header.flags = flags;
+		header.width = width;
+		header.height = height;
+		header.depth = depth;
+		header.mipMapCount = mipLevels;
+		header.pixelFormat = pixelFormat;
+		header.pixelFormat.size = sizeof(DX::DdsPixelFormat);
+		header.caps2 = caps2;
+		std::memcpy(&file[4], &header, sizeof(header));
+		if (ext != nullptr)
+		{
+			std::memcpy(&file[4 + DX::c_ddsHeaderSize], ext, sizeof(*ext));
+		}
+
+		for (std::size_t i = headerSize; i < file.size(); i++)
+		{
+			file[i] = static_cast<std::uint8_t>(i * 131);
+		}
+		return file;
+	}
+
+	DX::DdsPixelFormat MakeDx10PixelFormat()
+	{
+		DX::DdsPixelFormat pixelFormat = {};
+		pixelFormat.flags = DX::c_ddsPixelFormatFourCC;
+		pixelFormat.fourCC = DX::MakeDdsFourCC('D', 'X', '1', '0');
+		return pixelFormat;
+	}
+
+	// 한 배열 항목(모든 밉)의 바이트 수입니다.
+	std::uint64_t GetItemSize(std::uint32_t width, std::uint32_t height, std::uint32_t mipLevels, std::uint32_t blockDimension, std::uint32_t bytesPerBlock)
+	{
+		std::uint64_t size = 0;
+		for (std::uint32_t mip = 0; mip < mipLevels; mip++)
+		{
+			const std::uint32_t mipWidth = (std::max)(width >> mip, 1u);
+			const std::uint32_t mipHeight = (std::max)(height >> mip, 1u);
+			size += static_cast<std::uint64_t>((mipWidth + blockDimension - 1) / blockDimension) * ((mipHeight + blockDimension - 1) / blockDimension) * bytesPerBlock;
+		}
+		return size;
+	}
+
+	// 블록 압축 배열은 배열 항목마다 모든 밉을 차례로 저장하고, 크기를 블록 경계로 올립니다.
+	void TestBlockCompressedArrayLayout()
+	{
+		const DX::DdsHeaderDx10 ext = { DX::DdsFormatBC7UnormSrgb, 3, 0, 3, 0 };
+		const std::uint64_t itemSize = GetItemSize(37, 21, 6, 4, 16);
+		const std::vector<std::uint8_t> file = MakeDdsFile(37, 21, 0, 6, MakeDx10PixelFormat(), 0, 0, &ext, itemSize * 3);
+
+		DX::DdsTextureDesc desc;
+		DX_CHECK(DX::ParseDdsHeader(file.data(), file.size(), &desc));
+		DX_CHECK(desc.arraySize == 3 && desc.mipLevels == 6 && desc.blockDimension == 4 && desc.dataOffset == 148 && desc.dataSize == itemSize * 3);
+		DX_CHECK(DX::GetDdsSubresourceCount(desc) == 18);
+
+		// 두 번째 배열 항목의 밉 2는 9 x 5 픽셀, 3 x 2 블록입니다.
+		const DX::DdsSubresourceLayout mip2 = DX::GetDdsSubresourceLayout(desc, 6 + 2);
+		DX_CHECK(mip2.width == 9 && mip2.height == 5 && mip2.depth == 1 && mip2.rowSize == 3 * 16 && mip2.rowCount == 2);
+		DX_CHECK(DX::GetDdsSubresourceLayout(desc, 6).offset == 148 + itemSize);
+
+		// 4 x 4보다 작은 밉도 블록 하나를 차지합니다.
+		const DX::DdsSubresourceLayout last = DX::GetDdsSubresourceLayout(desc, 17);
+		DX_CHECK(last.width == 1 && last.height == 1 && last.rowSize == 16 && last.rowCount == 1);
+		DX_CHECK(last.offset + DX::GetDdsLayoutSize(last) == file.size());
+
+		// 하위 리소스 행은 대상 간격으로 복사되며 행 사이의 여백은 건드리지 않습니다.
+		std::vector<std::uint8_t> rows(256 * 2, 0xee);
+		DX::CopyDdsRows(file.data(), mip2, 0, 2, rows.data(), 256);
+		DX_CHECK(std::memcmp(rows.data(), &file[static_cast<std::size_t>(mip2.offset)], 48) == 0);
+		DX_CHECK(std::memcmp(&rows[256], &file[static_cast<std::size_t>(mip2.offset) + 48], 48) == 0);
+		DX_CHECK(rows[48] == 0xee && rows[256 + 48] == 0xee);
+
+		DX_CHECK(!DX::ParseDdsHeader(file.data(), file.size() - 1, &desc));
+	}
+
+	// 볼륨 텍스처의 밉은 깊이도 절반이 되며, 행은 깊이 조각마다 이어집니다.
+	void TestVolumeLayout()
+	{
+		DX::DdsPixelFormat pixelFormat = {};
+		pixelFormat.flags = DX::c_ddsPixelFormatRgb | DX::c_ddsPixelFormatAlphaPixels;
+		pixelFormat.rgbBitCount = 32;
+		pixelFormat.rBitMask = 0x00ff0000;
+		pixelFormat.gBitMask = 0x0000ff00;
+		pixelFormat.bBitMask = 0x000000ff;
+		pixelFormat.aBitMask = 0xff000000;
+
+		const std::uint64_t dataSize = 8 * 4 * 4 * 4 + 4 * 2 * 2 * 4 + 2 * 1 * 1 * 4 + 1 * 1 * 1 * 4;
+		const std::vector<std::uint8_t> file = MakeDdsFile(8, 4, 4, 4, pixelFormat, DX::c_ddsFlagDepth, DX::c_ddsCaps2Volume, nullptr, dataSize);
+
+		DX::DdsTextureDesc desc;
+		DX_CHECK(DX::ParseDdsHeader(file.data(), file.size(), &desc));
+		DX_CHECK(desc.dimension == DX::DdsDimension::Texture3D && desc.depth == 4 && desc.format == DX::DdsFormatB8G8R8A8Unorm);
+		DX_CHECK(DX::GetDdsSubresourceCount(desc) == 4);
+
+		const DX::DdsSubresourceLayout mip1 = DX::GetDdsSubresourceLayout(desc, 1);
+		DX_CHECK(mip1.width == 4 && mip1.height == 2 && mip1.depth == 2 && mip1.rowSize == 16 && mip1.rowCount == 2 && mip1.offset == 128 + 512);
+		DX_CHECK(DX::GetDdsRows(file.data(), mip1, 3) == file.data() + 128 + 512 + 3 * 16);
+
+		const DX::DdsSubresourceLayout mip3 = DX::GetDdsSubresourceLayout(desc, 3);
+		DX_CHECK(mip3.depth == 1 && mip3.offset + DX::GetDdsLayoutSize(mip3) == file.size());
+	}
+
+	// 큐브 맵은 면마다 하나의 배열 항목이며, 일부 면만 있는 파일은 거부합니다.
+	void TestCubeMapLayout()
+	{
+		DX::DdsPixelFormat pixelFormat = {};
+		pixelFormat.flags = DX::c_ddsPixelFormatFourCC;
+		pixelFormat.fourCC = DX::MakeDdsFourCC('D', 'X', 'T', '1');
+		const std::uint64_t itemSize = GetItemSize(16, 16, 5, 4, 8);
+
+		const std::vector<std::uint8_t> file = MakeDdsFile(16, 16, 0, 5, pixelFormat, 0, DX::c_ddsCaps2CubeMap | DX::c_ddsCaps2CubeMapAllFaces, nullptr, itemSize * 6);
+		DX::DdsTextureDesc desc;
+		DX_CHECK(DX::ParseDdsHeader(file.data(), file.size(), &desc));
+		DX_CHECK(desc.cubeMap && desc.arraySize == 6 && desc.format == DX::DdsFormatBC1Unorm);
+		DX_CHECK(DX::GetDdsSubresourceLayout(desc, 5 * 5).offset == 128 + itemSize * 5);
+
+		const std::vector<std::uint8_t> partial = MakeDdsFile(16, 16, 0, 5, pixelFormat, 0, DX::c_ddsCaps2CubeMap | 0x400, nullptr, itemSize * 6);
+		DX_CHECK(!DX::ParseDdsHeader(partial.data(), partial.size(), &desc));
+	}
+
+	// 헤드리스 장치와 작은 링 버퍼의 복사 큐입니다.
+	class HeadlessCopyQueue
+	{
+	public:
+		explicit HeadlessCopyQueue(UINT64 uploadBufferSize)
+		{
+			m_device.Attach(new DX::NullDevice());
+			m_copyQueue.reset(new DX::CopyQueue(m_device.Get(), uploadBufferSize));
+		}
+
+		~HeadlessCopyQueue()
+		{
+			m_copyQueue.reset();
+			GetDevice()->FlushGpu();
+		}
+
+		DX::NullDevice* GetDevice() const	{ return static_cast<DX::NullDevice*>(m_device.Get()); }
+		DX::CopyQueue* GetCopyQueue() const	{ return m_copyQueue.get(); }
+
+	private:
+		ComPtr<ID3D12Device>				m_device;
+		std::unique_ptr<DX::CopyQueue>		m_copyQueue;
+	};
+
+	const UINT64 c_uploadBufferSize = 64 * 1024;
+
+	std::vector<std::uint8_t> MakeMippedRgbaFile(std::uint32_t size, std::uint32_t mipLevels)
+	{
+		const DX::DdsHeaderDx10 ext = { DX::DdsFormatR8G8B8A8Unorm, 3, 0, 1, 0 };
+		return MakeDdsFile(size, size, 0, mipLevels, MakeDx10PixelFormat(), 0, 0, &ext, GetItemSize(size, size, mipLevels, 1, 4));
+	}
+
+	// 링 버퍼보다 큰 텍스처는 여러 제출로 나누어 모든 행을 복사하고, 마지막 티켓과 SRV 설명을 반환합니다.
+	void TestLoadSplitsLargeTexture()
+	{
+		HeadlessCopyQueue queue(c_uploadBufferSize);
+		const std::vector<std::uint8_t> file = MakeMippedRgbaFile(256, 9);
+		const DX::AssetView view(file.data(), file.size(), std::make_shared<int>(0));
+
+		ComPtr<ID3D12Resource> texture;
+		D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+		queue.GetDevice()->ResetStatistics();
+		const DX::UploadTicket ticket = DX::CreateDdsTexture(queue.GetDevice(), queue.GetCopyQueue(), view, &texture, &srvDesc);
+
+		DX_CHECK(texture != nullptr);
+		DX_CHECK(srvDesc.ViewDimension == D3D12_SRV_DIMENSION_TEXTURE2D && srvDesc.Texture2D.MipLevels == 9);
+		DX_CHECK(srvDesc.Format == static_cast<DXGI_FORMAT>(DX::DdsFormatR8G8B8A8Unorm));
+
+		// 장치의 복사 배치로 계산한 모든 하위 리소스의 바이트가 복사되었습니다.
+		const D3D12_RESOURCE_DESC desc = texture->GetDesc();
+		UINT64 expectedBytes = 0;
+		for (UINT subresource = 0; subresource < 9; subresource++)
+		{
+			D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint;
+			UINT numRows;
+			queue.GetDevice()->GetCopyableFootprints(&desc, subresource, 1, 0, &footprint, &numRows, nullptr, nullptr);
+			expectedBytes += static_cast<UINT64>(footprint.Footprint.RowPitch) * numRows;
+		}
+
+		const DX::NullDeviceStatistics statistics = queue.GetDevice()->GetStatistics();
+		DX_CHECK(statistics.copyBytes == expectedBytes);
+		DX_CHECK(statistics.executeCalls == ticket && ticket > 8);
+		DX_CHECK(queue.GetCopyQueue()->IsComplete(ticket));
+	}
+
+	// 도중의 제출이 실패하면 텍스처를 돌려주지 않고, 텍스처를 해제하기 전에 이전 제출의 복사가 끝나기를 기다립니다.
+	void TestFailedSubmitWaitsForEarlierCopies()
+	{
+		HeadlessCopyQueue queue(c_uploadBufferSize);
+		const std::vector<std::uint8_t> file = MakeMippedRgbaFile(256, 9);
+		const DX::AssetView view(file.data(), file.size(), std::make_shared<int>(0));
+
+		// GPU가 뒤처져 첫 제출의 명령 할당기를 재사용할 수 없으므로, 두 번째 제출이 새 할당기를 만들다가 실패합니다.
+		queue.GetDevice()->SetGpuLatency(16);
+		queue.GetDevice()->SetCommandAllocatorBudget(1);
+
+		ComPtr<ID3D12Resource> texture;
+		bool threw = false;
+		try
+		{
+			DX::CreateDdsTexture(queue.GetDevice(), queue.GetCopyQueue(), view, &texture);
+		}
+		catch (const std::exception&)
+		{
+			threw = true;
+		}
+
+		DX_CHECK(threw);
+		DX_CHECK(texture == nullptr);
+		DX_CHECK(queue.GetCopyQueue()->IsComplete(1));
+		DX_CHECK(queue.GetDevice()->GetStatistics().executeCalls == 1);
+
+		queue.GetDevice()->SetCommandAllocatorBudget(UINT_MAX);
+	}
+
+	// 형식이 맞지 않는 파일은 리소스를 만들기 전에 거부합니다.
+	void TestInvalidFile()
+	{
+		HeadlessCopyQueue queue(c_uploadBufferSize);
+		std::vector<std::uint8_t> file = MakeMippedRgbaFile(16, 5);
+		file.resize(file.size() - 1);
+		const DX::AssetView view(file.data(), file.size(), std::make_shared<int>(0));
+
+		ComPtr<ID3D12Resource> texture;
+		bool threw = false;
+		try
+		{
+			DX::CreateDdsTexture(queue.GetDevice(), queue.GetCopyQueue(), view, &texture);
+		}
+		catch (const std::exception&)
+		{
+			threw = true;
+		}
+
+		DX_CHECK(threw && texture == nullptr);
+		DX_CHECK(queue.GetDevice()->GetStatistics().resourcesCreated == 1);	// 복사 큐의 업로드 링 버퍼뿐입니다.
+	}
+}
+
+int main()
+{
+	TestBlockCompressedArrayLayout();
+	TestVolumeLayout();
+	TestCubeMapLayout();
+	TestLoadSplitsLargeTexture();
+	TestFailedSubmitWaitsForEarlierCopies();
+	TestInvalidFile();
+	return DX::Test::Finish("DdsTextureLoaderTests");
+}
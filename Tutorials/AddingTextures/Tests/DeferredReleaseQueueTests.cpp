@@ -0,0 +1,179 @@
+﻿// DeferredReleaseQueue 검사입니다. 프레임 루프를 흉내 내는 모의 fence로 해제 시점과 순서를 확인합니다.
+// 표준 라이브러리만 사용하므로 Windows와 Linux에서 모두 빌드됩니다.
+//
+//	g++ -std=c++14 -O2 -pthread -I Tests -o DeferredReleaseQueueTests Tests/DeferredReleaseQueueTests.cpp
+//	cl /std:c++14 /O2 /EHsc /I Tests Tests\DeferredReleaseQueueTests.cpp
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "TestHarness.h"
+#include "../Common/DeferredReleaseQueue.h"
+
+namespace
+{
+	// 큐에 신호한 값을 latency 신호만큼 늦게 완료하는 모의 fence입니다.
+	class MockFence
+	{
+	public:
+		explicit MockFence(unsigned int latency) : m_latency(latency), m_signaled(0), m_completed(0) {}
+
+		std::uint64_t GetNextValue() const		{ return m_signaled + 1; }
+		std::uint64_t GetCompletedValue() const	{ return m_completed; }
+
+		std::uint64_t Signal()
+		{
+			m_signaled++;
+			m_completed = m_signaled > m_latency ? m_signaled - m_latency : 0;
+			return m_signaled;
+		}
+
+		void Flush()							{ m_completed = m_signaled; }
+
+	private:
+		unsigned int	m_latency;
+		std::uint64_t	m_signaled;
+		std::uint64_t	m_completed;
+	};
+
+	// 개체는 자신을 해제한 시점 이후의 신호가 완료될 때까지 살아 있습니다.
+	void TestReleaseFollowsFence()
+	{
+		MockFence fence(2);
+		DX::DeferredReleaseQueue queue;
+
+		auto object = std::make_shared<int>(1);
+		std::weak_ptr<int> watcher = object;
+		queue.Enqueue(fence.GetNextValue(), [object]() {});
+		object.reset();
+
+		// 해제 요청 뒤 첫 신호(값 1)가 완료되려면 신호가 두 번 더 필요합니다.
+		for (int frame = 0; frame < 2; frame++)
+		{
+			fence.Signal();
+			DX_CHECK(queue.Release(fence.GetCompletedValue()) == 0);
+			DX_CHECK(!watcher.expired());
+		}
+		fence.Signal();
+		DX_CHECK(queue.Release(fence.GetCompletedValue()) == 1);
+		DX_CHECK(watcher.expired());
+		DX_CHECK(queue.GetPendingCount() == 0);
+	}
+
+	// 항목은 fence 값 순서로 처리되며, 앞 항목보다 작은 값은 앞 항목의 값으로 올라갑니다.
+	void TestOrdering()
+	{
+		DX::DeferredReleaseQueue queue;
+		std::vector<int> order;
+		queue.Enqueue(2, [&order]() { order.push_back(0); });
+		queue.Enqueue(1, [&order]() { order.push_back(1); });
+		queue.Enqueue(3, [&order]() { order.push_back(2); });
+
+		DX_CHECK(queue.Release(1) == 0);
+		DX_CHECK(queue.Release(2) == 2);
+		DX_CHECK(order.size() == 2 && order[0] == 0 && order[1] == 1);
+		DX_CHECK(queue.Release(3) == 1);
+		DX_CHECK(order.size() == 3 && order[2] == 2);
+	}
+
+	// 해제 함수에서 다시 Enqueue해도 교착되지 않고, 새 항목은 다음 Release에서 처리됩니다.
+	void TestReentrantEnqueue()
+	{
+		DX::DeferredReleaseQueue queue;
+		int released = 0;
+		queue.Enqueue(1, [&]()
+		{
+			released++;
+			queue.Enqueue(2, [&released]() { released += 10; });
+		});
+
+		DX_CHECK(queue.Release(1) == 1);
+		DX_CHECK(released == 1 && queue.GetPendingCount() == 1);
+		DX_CHECK(queue.Release(2) == 1);
+		DX_CHECK(released == 11);
+	}
+
+	// 소멸자는 남은 항목을 모두 해제합니다.
+	void TestDestructorReleasesAll()
+	{
+		int released = 0;
+		{
+			DX::DeferredReleaseQueue queue;
+			queue.Enqueue(100, [&released]() { released++; });
+			queue.Enqueue(200, [&released]() { released++; });
+		}
+		DX_CHECK(released == 2);
+	}
+
+	// 프레임 루프 전체: 매 프레임 개체를 버리고, GPU를 기다린 뒤에는 남은 항목이 없습니다.
+	void TestFrameLoop()
+	{
+		const unsigned int latency = 3;
+		MockFence fence(latency);
+		DX::DeferredReleaseQueue queue;
+		std::vector<std::weak_ptr<int>> watchers;
+
+		const int frames = 50;
+		for (int frame = 0; frame < frames; frame++)
+		{
+			auto object = std::make_shared<int>(frame);
+			watchers.push_back(object);
+			queue.Enqueue(fence.GetNextValue(), [object]() {});
+
+			fence.Signal();
+			queue.Release(fence.GetCompletedValue());
+
+			// latency 프레임 전까지 버린 개체만 해제되었습니다.
+			for (int i = 0; i <= frame; i++)
+			{
+				DX_CHECK(watchers[i].expired() == (i + static_cast<int>(latency) <= frame));
+			}
+		}
+
+		fence.Flush();
+		queue.Release(fence.GetCompletedValue());
+		DX_CHECK(queue.GetPendingCount() == 0);
+		for (const std::weak_ptr<int>& watcher : watchers)
+		{
+			DX_CHECK(watcher.expired());
+		}
+	}
+
+	// 여러 스레드에서 동시에 넣어도 모든 항목이 한 번씩 해제됩니다.
+	void TestConcurrentEnqueue()
+	{
+		DX::DeferredReleaseQueue queue;
+		std::atomic<int> released(0);
+		std::vector<std::thread> threads;
+		for (int t = 0; t < 4; t++)
+		{
+			threads.emplace_back([&queue, &released]()
+			{
+				for (int i = 0; i < 1000; i++)
+				{
+					queue.Enqueue(static_cast<std::uint64_t>(i), [&released]() { released++; });
+				}
+			});
+		}
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		DX_CHECK(queue.GetPendingCount() == 4000);
+		DX_CHECK(queue.ReleaseAll() == 4000);
+		DX_CHECK(released == 4000);
+	}
+}
+
+int main()
+{
+	TestReleaseFollowsFence();
+	TestOrdering();
+	TestReentrantEnqueue();
+	TestDestructorReleasesAll();
+	TestFrameLoop();
+	TestConcurrentEnqueue();
+	return DX::Test::Finish("DeferredReleaseQueueTests");
+}
@@ -0,0 +1,149 @@
+﻿// 설명자 힙 장부(DescriptorFreeList, DescriptorFrameRing) 검사입니다.
+// 표준 라이브러리만 사용하므로 Windows와 Linux에서 모두 빌드됩니다.
+//
+//	g++ -std=c++14 -O2 -pthread -I Tests -o DescriptorAllocatorTests Tests/DescriptorAllocatorTests.cpp
+//	cl /std:c++14 /O2 /EHsc /I Tests Tests\DescriptorAllocatorTests.cpp
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include "TestHarness.h"
+#include "../Common/DescriptorIndexAllocator.h"
+
+namespace
+{
+	// 자유 목록은 낮은 인덱스부터 할당하고, 반환한 슬롯을 가장 먼저 재사용합니다.
+	void TestFreeListOrder()
+	{
+		DX::DescriptorFreeList freeList(3);
+		std::uint32_t index = 0;
+		DX_CHECK(freeList.GetCapacity() == 3);
+		DX_CHECK(freeList.GetFreeCount() == 3);
+
+		DX_CHECK(freeList.Allocate(&index) && index == 0);
+		DX_CHECK(freeList.Allocate(&index) && index == 1);
+		freeList.Free(0);
+		DX_CHECK(freeList.GetFreeCount() == 2);
+		DX_CHECK(freeList.Allocate(&index) && index == 0);
+		DX_CHECK(freeList.Allocate(&index) && index == 2);
+	}
+
+	// 가득 차면 실패하고, 슬롯 하나를 반환하면 그 슬롯을 다시 할당합니다.
+	void TestFreeListExhaustion()
+	{
+		DX::DescriptorFreeList freeList(4);
+		std::uint32_t index = 0;
+		std::vector<std::uint32_t> allocated;
+		while (freeList.Allocate(&index))
+		{
+			allocated.push_back(index);
+		}
+		DX_CHECK(allocated.size() == 4);
+		DX_CHECK(freeList.GetFreeCount() == 0);
+		DX_CHECK(!freeList.Allocate(&index));
+
+		freeList.Free(2);
+		DX_CHECK(freeList.Allocate(&index) && index == 2);
+		DX_CHECK(!freeList.Allocate(&index));
+
+		// 모두 반환하면 처음 용량으로 돌아갑니다.
+		for (std::uint32_t slot : allocated)
+		{
+			freeList.Free(slot);
+		}
+		DX_CHECK(freeList.GetFreeCount() == 4);
+	}
+
+	// 프레임마다 자기 구간에서만 할당하고, BeginFrame이 그 구간을 비웁니다.
+	void TestFrameRingSegments()
+	{
+		DX::DescriptorFrameRing ring(3, 10);
+		std::uint32_t first = 0;
+		DX_CHECK(ring.GetCapacity() == 30);
+		DX_CHECK(ring.GetDescriptorsPerFrame() == 10);
+
+		ring.BeginFrame(1);
+		DX_CHECK(ring.Allocate(4, &first) && first == 10);
+		DX_CHECK(ring.Allocate(6, &first) && first == 14);
+		DX_CHECK(ring.GetUsedCount() == 10);
+
+		// 구간을 넘는 할당은 실패하며, 사용량은 구간 크기를 넘어 보고되지 않습니다.
+		DX_CHECK(!ring.Allocate(1, &first));
+		DX_CHECK(ring.GetUsedCount() == 10);
+
+		ring.BeginFrame(2);
+		DX_CHECK(ring.GetUsedCount() == 0);
+		DX_CHECK(ring.Allocate(1, &first) && first == 20);
+
+		// 프레임 인덱스는 프레임 수로 감쌉니다.
+		ring.BeginFrame(3);
+		DX_CHECK(ring.Allocate(10, &first) && first == 0);
+	}
+
+	// 크기가 0이거나 구간보다 큰 테이블은 할당하지 않습니다.
+	void TestFrameRingInvalidSizes()
+	{
+		DX::DescriptorFrameRing ring(2, 8);
+		std::uint32_t first = 0;
+		ring.BeginFrame(0);
+		DX_CHECK(!ring.Allocate(0, &first));
+		DX_CHECK(!ring.Allocate(9, &first));
+		DX_CHECK(!ring.Allocate(0xFFFFFFFFu, &first));
+	}
+
+	// 여러 녹화 스레드가 동시에 할당해도 테이블이 겹치지 않습니다.
+	void TestFrameRingConcurrentAllocation()
+	{
+		const std::uint32_t threadCount = 4;
+		const std::uint32_t tablesPerThread = 256;
+		const std::uint32_t tableSize = 3;
+		DX::DescriptorFrameRing ring(2, threadCount * tablesPerThread * tableSize);
+		ring.BeginFrame(1);
+
+		std::vector<std::vector<std::uint32_t>> firsts(threadCount);
+		std::vector<std::thread> threads;
+		for (std::uint32_t t = 0; t < threadCount; t++)
+		{
+			threads.emplace_back([&, t]()
+			{
+				for (std::uint32_t i = 0; i < tablesPerThread; i++)
+				{
+					std::uint32_t first = 0;
+					if (ring.Allocate(tableSize, &first))
+					{
+						firsts[t].push_back(first);
+					}
+				}
+			});
+		}
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		std::vector<std::uint32_t> all;
+		for (const std::vector<std::uint32_t>& list : firsts)
+		{
+			all.insert(all.end(), list.begin(), list.end());
+		}
+		std::sort(all.begin(), all.end());
+		DX_CHECK(all.size() == threadCount * tablesPerThread);
+		for (std::size_t i = 0; i < all.size(); i++)
+		{
+			DX_CHECK(all[i] == ring.GetDescriptorsPerFrame() + i * tableSize);
+		}
+
+		std::uint32_t first = 0;
+		DX_CHECK(!ring.Allocate(1, &first));
+	}
+}
+
+int main()
+{
+	TestFreeListOrder();
+	TestFreeListExhaustion();
+	TestFrameRingSegments();
+	TestFrameRingInvalidSizes();
+	TestFrameRingConcurrentAllocation();
+	return DX::Test::Finish("DescriptorAllocatorTests");
+}
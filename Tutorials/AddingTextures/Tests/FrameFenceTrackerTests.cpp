@@ -0,0 +1,99 @@
+﻿// FrameFenceTracker 검사입니다. fence 값 발급, 프레임 슬롯 순환과 진행 중인 프레임 수 변경을 확인합니다.
+// 표준 라이브러리만 사용하므로 Windows와 Linux에서 모두 빌드됩니다.
+//
+//	g++ -std=c++14 -O2 -I Tests -o FrameFenceTrackerTests Tests/FrameFenceTrackerTests.cpp
+//	cl /std:c++14 /O2 /EHsc /I Tests Tests\FrameFenceTrackerTests.cpp
+
+#include "TestHarness.h"
+#include "../Common/FrameFenceTracker.h"
+
+namespace
+{
+	// fence 값은 하나씩 증가하고, 슬롯을 다시 쓰기 전에 frameCount 프레임 전의 값을 기다립니다.
+	void TestSignalAndWaitValues()
+	{
+		DX::FrameFenceTracker tracker(3);
+		DX_CHECK(tracker.GetFrameCount() == 3);
+		DX_CHECK(tracker.GetCurrentFrame() == 0);
+		DX_CHECK(tracker.GetLastSignaledValue() == 0);
+		DX_CHECK(tracker.GetNextSignalValue() == 1);
+
+		// 처음 한 바퀴는 아직 신호하지 않은 슬롯이므로 기다릴 값이 0(이미 완료)입니다.
+		DX_CHECK(tracker.Signal() == 1);
+		DX_CHECK(tracker.MoveToNextFrame() == 0);
+		DX_CHECK(tracker.Signal() == 2);
+		DX_CHECK(tracker.MoveToNextFrame() == 0);
+		DX_CHECK(tracker.Signal() == 3);
+
+		// 슬롯 0으로 돌아오면 그 슬롯의 마지막 값인 1을 기다립니다.
+		DX_CHECK(tracker.MoveToNextFrame() == 1);
+		DX_CHECK(tracker.GetCurrentFrame() == 0);
+		DX_CHECK(tracker.Signal() == 4);
+		DX_CHECK(tracker.MoveToNextFrame() == 2);
+		DX_CHECK(tracker.GetLastSignaledValue() == 4);
+	}
+
+	// 초기 fence 값에서 이어서 발급합니다.
+	void TestInitialFenceValue()
+	{
+		DX::FrameFenceTracker tracker(2, 100);
+		DX_CHECK(tracker.GetLastSignaledValue() == 100);
+		DX_CHECK(tracker.Signal() == 101);
+		DX_CHECK(tracker.MoveToNextFrame() == 100);
+	}
+
+	// 프레임 수를 바꾸면 첫 슬롯부터 다시 시작하고, 모든 슬롯이 마지막으로 신호한 값(완료됨)을 기다립니다.
+	// fence 값은 계속 증가하므로 이전 프레임 수에서 발급한 값과 겹치지 않습니다.
+	void TestSetFrameCount()
+	{
+		DX::FrameFenceTracker tracker(3);
+		for (int frame = 0; frame < 4; frame++)
+		{
+			tracker.Signal();
+			tracker.MoveToNextFrame();
+		}
+		DX_CHECK(tracker.GetCurrentFrame() == 1);
+		const std::uint64_t lastValue = tracker.GetLastSignaledValue();
+		DX_CHECK(lastValue == 4);
+
+		// 늘리기: 새 슬롯도 이미 완료된 값을 가지므로 한 바퀴 동안 기다리지 않습니다.
+		tracker.SetFrameCount(4);
+		DX_CHECK(tracker.GetFrameCount() == 4);
+		DX_CHECK(tracker.GetCurrentFrame() == 0);
+		DX_CHECK(tracker.GetNextSignalValue() == lastValue + 1);
+		for (unsigned int frame = 0; frame < 3; frame++)
+		{
+			DX_CHECK(tracker.Signal() == lastValue + 1 + frame);
+			DX_CHECK(tracker.MoveToNextFrame() == lastValue);
+		}
+		DX_CHECK(tracker.Signal() == lastValue + 4);
+		DX_CHECK(tracker.MoveToNextFrame() == lastValue + 1);
+
+		// 줄이기: 하나로 줄이면 매 프레임 바로 앞 프레임의 값을 기다립니다.
+		const std::uint64_t beforeShrink = tracker.GetLastSignaledValue();
+		tracker.SetFrameCount(1);
+		DX_CHECK(tracker.GetFrameCount() == 1);
+		DX_CHECK(tracker.GetCurrentFrame() == 0);
+		for (int frame = 0; frame < 3; frame++)
+		{
+			const std::uint64_t value = tracker.Signal();
+			DX_CHECK(value == beforeShrink + 1 + frame);
+			DX_CHECK(tracker.MoveToNextFrame() == value);
+			DX_CHECK(tracker.GetCurrentFrame() == 0);
+		}
+
+		// 같은 수로 다시 설정해도 값은 이어집니다.
+		const std::uint64_t beforeReset = tracker.GetLastSignaledValue();
+		tracker.SetFrameCount(1);
+		DX_CHECK(tracker.MoveToNextFrame() == beforeReset);
+		DX_CHECK(tracker.Signal() == beforeReset + 1);
+	}
+}
+
+int main()
+{
+	TestSignalAndWaitValues();
+	TestInitialFenceValue();
+	TestSetFrameCount();
+	return DX::Test::Finish("FrameFenceTrackerTests");
+}
@@ -0,0 +1,178 @@
+﻿// FrameTimeRecorder와 StepTimer의 프레임 시간 통계 검사입니다. 스크립트된 클록을 주입하므로 결과가 결정적입니다.
+// 표준 라이브러리만 사용하므로 Windows와 Linux에서 모두 빌드됩니다.
+//
+//	g++ -std=c++14 -O2 -pthread -I Tests -o FrameTimeRecorderTests Tests/FrameTimeRecorderTests.cpp
+//	cl /std:c++14 /O2 /EHsc /I Tests Tests\FrameTimeRecorderTests.cpp
+
+#include <thread>
+#include "TestHarness.h"
+#include "../Common/StepTimer.h"
+
+namespace
+{
+	// 검사가 직접 앞당기는 클록입니다. 주파수는 StepTimer 눈금과 같게 두어 변환 오차를 없앱니다.
+	class ScriptedClock
+	{
+	public:
+		ScriptedClock() : m_now(0) {}
+
+		DX::uint64 GetFrequency() const			{ return 10000000; }
+		DX::uint64 GetCounter() const			{ return m_now; }
+		void Advance(DX::uint64 ticks)			{ m_now += ticks; }
+
+	private:
+		DX::uint64 m_now;
+	};
+
+	typedef DX::BasicStepTimer<ScriptedClock> ScriptedTimer;
+
+	const DX::uint64 c_millisecond = 10000;
+
+	// 클록을 ticks만큼 앞당기고 한 번 틱합니다.
+	void TickAfter(ScriptedTimer& timer, DX::uint64 ticks)
+	{
+		timer.GetClock().Advance(ticks);
+		timer.Tick([] {});
+	}
+
+	void TestPercentilesAndHistogram()
+	{
+		// 16밀리초 90프레임 사이에 50밀리초 프레임 10개를 고르게 섞습니다.
+		ScriptedTimer timer;
+		for (int i = 0; i < 100; i++)
+		{
+			TickAfter(timer, (i % 10 == 9 ? 50 : 16) * c_millisecond);
+		}
+
+		const DX::FrameTimeStatistics stats = timer.GetFrameTimeStatistics();
+		DX_CHECK(stats.sampleCount == 100);
+		DX_CHECK(stats.minTicks == 16 * c_millisecond);
+		DX_CHECK(stats.p50Ticks == 16 * c_millisecond);
+		DX_CHECK(stats.p95Ticks == 50 * c_millisecond);
+		DX_CHECK(stats.p99Ticks == 50 * c_millisecond);
+		DX_CHECK(stats.maxTicks == 50 * c_millisecond);
+		DX_CHECK(stats.averageTicks == (90.0 * 16 + 10.0 * 50) * c_millisecond / 100);
+
+		// 16밀리초는 128 기준 단위로 버킷 8, 50밀리초는 400 기준 단위로 버킷 9입니다.
+		DX_CHECK(DX::FrameTimeRecorder::GetHistogramBucket(16 * c_millisecond) == 8);
+		DX_CHECK(DX::FrameTimeRecorder::GetHistogramBucket(50 * c_millisecond) == 9);
+		DX_CHECK(stats.histogram[8] == 90);
+		DX_CHECK(stats.histogram[9] == 10);
+		DX_CHECK(DX::FrameTimeRecorder::GetHistogramBucketLowerBound(9) == DX::c_frameTimeHistogramBaseTicks << 8);
+
+		// 기본 배수 2배에서는 32밀리초를 넘는 50밀리초 프레임만 히치입니다.
+		DX_CHECK(stats.hitchCount == 10);
+		DX_CHECK(stats.worstHitchTicks == 50 * c_millisecond);
+	}
+
+	void TestHitchDetection()
+	{
+		ScriptedTimer timer;
+		for (int i = 0; i < 60; i++)
+		{
+			DX::uint64 ticks = 16 * c_millisecond;
+			if (i == 10)
+			{
+				ticks = 40 * c_millisecond;
+			}
+			else if (i == 40)
+			{
+				// 디버거 정지처럼 긴 정지입니다. Update에는 최대 델타로 제한되지만 기록에는 그대로 남아야 합니다.
+				ticks = 2000 * c_millisecond;
+			}
+			else if (i == 50)
+			{
+				ticks = 30 * c_millisecond;
+			}
+			TickAfter(timer, ticks);
+		}
+
+		DX::FrameTimeStatistics stats = timer.GetFrameTimeStatistics();
+		DX_CHECK(stats.hitchCount == 2);
+		DX_CHECK(stats.worstHitchTicks == 2000 * c_millisecond);
+		DX_CHECK(stats.maxTicks == 2000 * c_millisecond);
+
+		DX::FrameHitch hitches[4] = {};
+		DX_CHECK(timer.GetFrameTimeRecorder().GetRecentHitches(hitches, 4) == 2);
+		DX_CHECK(hitches[0].frameIndex == 10 && hitches[0].ticks == 40 * c_millisecond);
+		DX_CHECK(hitches[1].frameIndex == 40 && hitches[1].ticks == 2000 * c_millisecond);
+
+		// 요청 수가 적으면 가장 최근 히치만 돌려줍니다.
+		DX_CHECK(timer.GetFrameTimeRecorder().GetRecentHitches(hitches, 1) == 1);
+		DX_CHECK(hitches[0].frameIndex == 40);
+
+		// 배수를 낮추면 30밀리초 프레임도 히치가 됩니다.
+		timer.SetHitchMultiplier(1.5);
+		stats = timer.GetFrameTimeStatistics();
+		DX_CHECK(stats.hitchCount == 3);
+		DX_CHECK(timer.GetFrameTimeRecorder().GetRecentHitches(hitches, 4) == 3);
+		DX_CHECK(hitches[2].frameIndex == 50);
+	}
+
+	void TestRingWraparound()
+	{
+		// 링보다 많이 기록하면 가장 오래된 샘플이 빠집니다.
+		DX::FrameTimeRecorder recorder;
+		const std::uint32_t total = DX::FrameTimeRecorder::c_capacity + 500;
+		for (std::uint32_t i = 0; i < total; i++)
+		{
+			recorder.Record(i < 500 ? 1000 * c_millisecond : 10 * c_millisecond);
+		}
+
+		const DX::FrameTimeStatistics stats = recorder.GetStatistics();
+		DX_CHECK(recorder.GetRecordedCount() == total);
+		DX_CHECK(stats.sampleCount == DX::FrameTimeRecorder::c_capacity);
+		DX_CHECK(stats.maxTicks == 10 * c_millisecond);
+		DX_CHECK(stats.hitchCount == 0);
+
+		recorder.Reset();
+		DX_CHECK(recorder.GetStatistics().sampleCount == 0);
+		DX::FrameHitch hitch;
+		DX_CHECK(recorder.GetRecentHitches(&hitch, 1) == 0);
+	}
+
+	void TestConcurrentReaders()
+	{
+		// 기록 스레드가 쓰는 동안 두 스레드가 통계를 읽어도 값이 기록된 범위를 벗어나지 않아야 합니다.
+		DX::FrameTimeRecorder recorder;
+		bool inRange = true;
+		std::thread readers[2];
+		bool readerInRange[2] = { true, true };
+
+		for (int r = 0; r < 2; r++)
+		{
+			readers[r] = std::thread([&recorder, &readerInRange, r]
+			{
+				for (int i = 0; i < 2000; i++)
+				{
+					const DX::FrameTimeStatistics stats = recorder.GetStatistics();
+					if (stats.sampleCount != 0 && (stats.minTicks < c_millisecond || stats.maxTicks > 20 * c_millisecond))
+					{
+						readerInRange[r] = false;
+					}
+				}
+			});
+		}
+
+		for (int i = 0; i < 200000; i++)
+		{
+			recorder.Record((1 + i % 20) * c_millisecond);
+		}
+
+		for (int r = 0; r < 2; r++)
+		{
+			readers[r].join();
+			inRange = inRange && readerInRange[r];
+		}
+		DX_CHECK(inRange);
+	}
+}
+
+int main()
+{
+	TestPercentilesAndHistogram();
+	TestHitchDetection();
+	TestRingWraparound();
+	TestConcurrentReaders();
+	return DX::Test::Finish("FrameTimeRecorderTests");
+}
@@ -0,0 +1,166 @@
+﻿// 헤드리스 D3D12(NullDevice)에서 GpuProfiler를 실행하는 검사입니다.
+// NullDevice는 그리기마다 합성 GPU 시계를 앞당겨 타임스탬프를 쓰므로 구간 시간을 정확히 예측할 수 있고,
+// 마지막 확인 이후 쓰이지 않은 쿼리 슬롯을 확인하면 통계에 기록합니다.
+// Windows가 아닌 플랫폼에서는 DirectX-Headers(https://github.com/microsoft/DirectX-Headers)가 필요합니다.
+//
+//	g++ -std=c++14 -O2 -pthread -DDX_HEADLESS_D3D12 -I Tests -I $DXH/include -I $DXH/include/wsl/stubs -o GpuProfilerTests Tests/GpuProfilerTests.cpp Common/GpuProfiler.cpp Common/NullDevice.cpp
+//	cl /std:c++14 /O2 /EHsc /DDX_HEADLESS_D3D12 /I Tests Tests\GpuProfilerTests.cpp Common\GpuProfiler.cpp Common\NullDevice.cpp dxguid.lib
+
+#include "pch.h"
+#include "TestHarness.h"
+#include "../Common/DirectXHelper.h"
+#include "../Common/GpuProfiler.h"
+#include "../Common/NullDevice.h"
+
+using Microsoft::WRL::ComPtr;
+
+namespace
+{
+	const UINT c_frameCount = 2;
+	const UINT c_maxScopesPerFrame = 4;
+	const UINT64 c_ticksPerDraw = 1000;		// NullDevice::SetSimulatedGpuCost로 설정하는 그리기당 GPU 시간입니다.
+
+	// 프레임마다 명령 목록 하나에 구간을 기록하고 확인한 뒤 제출합니다.
+	class ProfiledQueue
+	{
+	public:
+		ProfiledQueue()
+		{
+			m_device.Attach(new DX::NullDevice());
+			GetDevice()->SetSimulatedGpuCost(c_ticksPerDraw, 0);
+
+			D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+			queueDesc.Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
+			DX::ThrowIfFailed(m_device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&m_commandQueue)));
+			DX::ThrowIfFailed(m_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&m_commandAllocator)));
+			DX::ThrowIfFailed(m_device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, m_commandAllocator.Get(), nullptr, IID_PPV_ARGS(&m_commandList)));
+			DX::ThrowIfFailed(m_commandList->Close());
+
+			m_profiler.reset(new DX::GpuProfiler(m_device.Get(), m_commandQueue.Get(), c_frameCount, c_maxScopesPerFrame));
+			m_frame = 0;
+			m_profiler->BeginFrame(m_frame);
+		}
+
+		// record(commandList, profiler)를 기록하고, 확인한 뒤 제출하고 다음 프레임 슬롯으로 이동합니다.
+		// NullDevice는 지연 없이 실행하므로 슬롯을 다시 쓸 때 결과가 준비되어 있습니다.
+		template<typename TRecord>
+		void RenderFrame(const TRecord& record)
+		{
+			DX::ThrowIfFailed(m_commandAllocator->Reset());
+			DX::ThrowIfFailed(m_commandList->Reset(m_commandAllocator.Get(), nullptr));
+			record(m_commandList.Get(), m_profiler.get());
+			m_profiler->ResolveFrame(m_commandList.Get());
+			DX::ThrowIfFailed(m_commandList->Close());
+
+			ID3D12CommandList* commandLists[] = { m_commandList.Get() };
+			m_commandQueue->ExecuteCommandLists(1, commandLists);
+
+			m_frame++;
+			m_profiler->BeginFrame(m_frame % c_frameCount);
+		}
+
+		DX::NullDevice* GetDevice() const		{ return static_cast<DX::NullDevice*>(m_device.Get()); }
+		DX::GpuProfiler* GetProfiler() const	{ return m_profiler.get(); }
+
+	private:
+		ComPtr<ID3D12Device>				m_device;
+		ComPtr<ID3D12CommandQueue>			m_commandQueue;
+		ComPtr<ID3D12CommandAllocator>		m_commandAllocator;
+		ComPtr<ID3D12GraphicsCommandList>	m_commandList;
+		std::unique_ptr<DX::GpuProfiler>	m_profiler;
+		UINT								m_frame;
+	};
+
+	double DrawMilliseconds(UINT draws)
+	{
+		return static_cast<double>(draws * c_ticksPerDraw) * 1000.0 / DX::NullDevice::c_timestampFrequency;
+	}
+
+	bool IsNear(double value, double expected)
+	{
+		return value > expected - 1e-9 && value < expected + 1e-9;
+	}
+
+	// 구간 시간은 구간 안의 그리기 수에 비례하고, 슬롯이 다시 사용될 때 집계됩니다.
+	void TestScopeTimings()
+	{
+		ProfiledQueue queue;
+		auto record = [](ID3D12GraphicsCommandList* commandList, DX::GpuProfiler* profiler)
+		{
+			const UINT frameScope = profiler->BeginScope(commandList, L"Frame");
+			commandList->DrawInstanced(3, 1, 0, 0);
+			const UINT drawScope = profiler->BeginScope(commandList, L"Draw");
+			commandList->DrawInstanced(3, 1, 0, 0);
+			commandList->DrawInstanced(3, 1, 0, 0);
+			profiler->EndScope(commandList, drawScope);
+			profiler->EndScope(commandList, frameScope);
+		};
+
+		queue.RenderFrame(record);
+		DX_CHECK(queue.GetProfiler()->GetTimings().GetFrameCount() == 0);
+		queue.RenderFrame(record);
+		DX_CHECK(queue.GetProfiler()->GetTimings().GetFrameCount() == 1);
+
+		const DX::GpuTimingAggregator& timings = queue.GetProfiler()->GetTimings();
+		DX_CHECK(timings.FindTiming(L"Frame") != nullptr && IsNear(timings.FindTiming(L"Frame")->lastMilliseconds, DrawMilliseconds(3)));
+		DX_CHECK(timings.FindTiming(L"Draw") != nullptr && IsNear(timings.FindTiming(L"Draw")->lastMilliseconds, DrawMilliseconds(2)));
+		DX_CHECK(queue.GetDevice()->GetStatistics().unwrittenQueriesResolved == 0);
+	}
+
+	// 끝나지 않은 구간이 있어도 쓰이지 않은 쿼리를 확인하지 않으며, 그 구간은 집계되지 않습니다.
+	void TestUnendedScope()
+	{
+		ProfiledQueue queue;
+		auto record = [](ID3D12GraphicsCommandList* commandList, DX::GpuProfiler* profiler)
+		{
+			const UINT frameScope = profiler->BeginScope(commandList, L"Frame");
+			profiler->BeginScope(commandList, L"Unended");
+			commandList->DrawInstanced(3, 1, 0, 0);
+			profiler->EndScope(commandList, frameScope);
+		};
+
+		for (UINT frame = 0; frame < 4; frame++)
+		{
+			queue.RenderFrame(record);
+		}
+
+		const DX::GpuTimingAggregator& timings = queue.GetProfiler()->GetTimings();
+		DX_CHECK(queue.GetDevice()->GetStatistics().unwrittenQueriesResolved == 0);
+		DX_CHECK(timings.FindTiming(L"Frame") != nullptr && IsNear(timings.FindTiming(L"Frame")->lastMilliseconds, DrawMilliseconds(1)));
+		DX_CHECK(timings.FindTiming(L"Unended") == nullptr);
+	}
+
+	// 슬롯보다 많은 구간은 버려지고 수를 셉니다. EndScope는 버려진 구간을 무시합니다.
+	void TestDroppedScopes()
+	{
+		ProfiledQueue queue;
+		auto record = [](ID3D12GraphicsCommandList* commandList, DX::GpuProfiler* profiler)
+		{
+			for (UINT scope = 0; scope < c_maxScopesPerFrame + 2; scope++)
+			{
+				const UINT index = profiler->BeginScope(commandList, L"Scope");
+				DX_CHECK((index == DX::c_invalidGpuScope) == (scope >= c_maxScopesPerFrame));
+				commandList->DrawInstanced(3, 1, 0, 0);
+				profiler->EndScope(commandList, index);
+			}
+		};
+
+		queue.RenderFrame(record);
+		queue.RenderFrame(record);
+		queue.RenderFrame(record);
+		DX_CHECK(queue.GetProfiler()->GetDroppedScopeCount() == 6);
+		DX_CHECK(queue.GetDevice()->GetStatistics().unwrittenQueriesResolved == 0);
+
+		// 같은 이름의 구간 네 개가 합산됩니다.
+		const DX::GpuScopeTiming* timing = queue.GetProfiler()->GetTimings().FindTiming(L"Scope");
+		DX_CHECK(timing != nullptr && IsNear(timing->lastMilliseconds, DrawMilliseconds(c_maxScopesPerFrame)));
+	}
+}
+
+int main()
+{
+	TestScopeTimings();
+	TestUnendedScope();
+	TestDroppedScopes();
+	return DX::Test::Finish("GpuProfilerTests");
+}
@@ -0,0 +1,118 @@
+﻿// GpuTimingAggregator 검사입니다. 합성 타임스탬프로 구간 시간, 같은 이름 구간의 합산, 이동 평균과 잘못된 구간 처리를 확인합니다.
+// 표준 라이브러리만 사용하므로 Windows와 Linux에서 모두 빌드됩니다.
+//
+//	g++ -std=c++14 -O2 -I Tests -o GpuTimingAggregatorTests Tests/GpuTimingAggregatorTests.cpp
+//	cl /std:c++14 /O2 /EHsc /I Tests Tests\GpuTimingAggregatorTests.cpp
+
+#include <cmath>
+#include "TestHarness.h"
+#include "../Common/GpuTimingAggregator.h"
+
+namespace
+{
+	// 눈금 하나가 1마이크로초입니다.
+	const std::uint64_t c_frequency = 1000000;
+
+	bool IsNear(double value, double expected)
+	{
+		return std::fabs(value - expected) < 1e-9;
+	}
+
+	// 구간 시간은 끝과 시작 타임스탬프의 차이이며, 같은 이름의 구간(작업자 목록마다 하나)은 한 프레임 안에서 합산됩니다.
+	void TestScopeDurations()
+	{
+		DX::GpuTimingAggregator aggregator(c_frequency);
+		const std::uint64_t timestamps[] = { 1000, 4000, 1500, 1700, 1800, 1900 };
+		const DX::GpuTimingScope scopes[] =
+		{
+			{ L"Render", 0, 1 },
+			{ L"Draw", 2, 3 },
+			{ L"Draw", 4, 5 },
+		};
+		aggregator.AddFrame(scopes, 3, timestamps, 6);
+
+		DX_CHECK(aggregator.GetFrameCount() == 1);
+		DX_CHECK(aggregator.GetTimings().size() == 2);
+		DX_CHECK(aggregator.GetTimings()[0].name == L"Render");
+
+		const DX::GpuScopeTiming* render = aggregator.FindTiming(L"Render");
+		const DX::GpuScopeTiming* draw = aggregator.FindTiming(L"Draw");
+		DX_CHECK(render != nullptr && IsNear(render->lastMilliseconds, 3.0) && render->sampleCount == 1);
+		DX_CHECK(draw != nullptr && IsNear(draw->lastMilliseconds, 0.3) && draw->sampleCount == 1);
+		DX_CHECK(aggregator.FindTiming(L"Missing") == nullptr);
+	}
+
+	// 평균과 최댓값은 최근 c_gpuTimingAverageFrames 프레임만 포함합니다.
+	void TestMovingAverage()
+	{
+		DX::GpuTimingAggregator aggregator(c_frequency);
+		const DX::GpuTimingScope scope = { L"Render", 0, 1 };
+
+		// 처음 프레임은 10밀리초이고, 그 뒤 창 전체를 2밀리초와 4밀리초로 번갈아 채웁니다.
+		std::uint64_t timestamps[2] = { 0, 10000 };
+		aggregator.AddFrame(&scope, 1, timestamps, 2);
+		DX_CHECK(IsNear(aggregator.FindTiming(L"Render")->maxMilliseconds, 10.0));
+
+		for (std::uint32_t frame = 0; frame < DX::c_gpuTimingAverageFrames; frame++)
+		{
+			timestamps[1] = frame % 2 == 0 ? 2000 : 4000;
+			aggregator.AddFrame(&scope, 1, timestamps, 2);
+		}
+
+		const DX::GpuScopeTiming* render = aggregator.FindTiming(L"Render");
+		DX_CHECK(render->sampleCount == DX::c_gpuTimingAverageFrames);
+		DX_CHECK(IsNear(render->averageMilliseconds, 3.0));
+		DX_CHECK(IsNear(render->maxMilliseconds, 4.0));
+		DX_CHECK(IsNear(render->lastMilliseconds, 4.0));
+	}
+
+	// 끝나지 않은 구간, 범위 밖 쿼리, 거꾸로 된 타임스탬프와 이름 없는 구간은 건너뜁니다.
+	void TestInvalidScopes()
+	{
+		DX::GpuTimingAggregator aggregator(c_frequency);
+		const std::uint64_t timestamps[] = { 500, 300, 100, 200 };
+		const DX::GpuTimingScope scopes[] =
+		{
+			{ L"Unended", 0, DX::c_gpuTimingInvalidQuery },
+			{ L"Reversed", 0, 1 },
+			{ L"OutOfRange", 2, 7 },
+			{ nullptr, 2, 3 },
+			{ L"Valid", 2, 3 },
+		};
+		aggregator.AddFrame(scopes, 5, timestamps, 4);
+
+		DX_CHECK(aggregator.GetTimings().size() == 1);
+		DX_CHECK(aggregator.FindTiming(L"Unended") == nullptr);
+		DX_CHECK(aggregator.FindTiming(L"Reversed") == nullptr);
+		DX_CHECK(aggregator.FindTiming(L"OutOfRange") == nullptr);
+		DX_CHECK(aggregator.FindTiming(L"Valid") != nullptr && IsNear(aggregator.FindTiming(L"Valid")->lastMilliseconds, 0.1));
+	}
+
+	// 어떤 프레임에 기록되지 않은 구간은 그 프레임의 샘플을 추가하지 않고 이전 값을 유지합니다.
+	void TestMissingScopeKeepsHistory()
+	{
+		DX::GpuTimingAggregator aggregator(c_frequency);
+		const std::uint64_t timestamps[] = { 0, 1000, 0, 2000 };
+		const DX::GpuTimingScope both[] = { { L"A", 0, 1 }, { L"B", 2, 3 } };
+		const DX::GpuTimingScope onlyA[] = { { L"A", 0, 1 } };
+
+		aggregator.AddFrame(both, 2, timestamps, 4);
+		aggregator.AddFrame(onlyA, 1, timestamps, 4);
+		DX_CHECK(aggregator.GetFrameCount() == 2);
+		DX_CHECK(aggregator.FindTiming(L"A")->sampleCount == 2);
+		DX_CHECK(aggregator.FindTiming(L"B")->sampleCount == 1);
+		DX_CHECK(IsNear(aggregator.FindTiming(L"B")->lastMilliseconds, 2.0));
+
+		aggregator.Reset();
+		DX_CHECK(aggregator.GetFrameCount() == 0 && aggregator.GetTimings().empty());
+	}
+}
+
+int main()
+{
+	TestScopeDurations();
+	TestMovingAverage();
+	TestInvalidScopes();
+	TestMissingScopeKeepsHistory();
+	return DX::Test::Finish("GpuTimingAggregatorTests");
+}
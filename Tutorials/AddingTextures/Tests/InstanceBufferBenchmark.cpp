@@ -0,0 +1,257 @@
+﻿// 인스턴스 버퍼 작성기의 정확도 검사와 처리량(백만 인스턴스/s, GB/s) 벤치마크입니다.
+// 압축 결과는 같은 식을 인스턴스마다 계산하는 스칼라 작성기와 비교하고, 인스턴스마다 float4x4 행렬을 쓰는 방식과 처리량을 비교합니다.
+// 표준 라이브러리만 사용하므로 Windows와 Linux에서 모두 빌드됩니다.
+//
+//	g++ -std=c++14 -O2 -pthread -I Tests -o InstanceBufferBenchmark Tests/InstanceBufferBenchmark.cpp Common/InstanceBuffer.cpp
+//	cl /std:c++14 /O2 /EHsc /DDX_HEADLESS_D3D12 /I Tests Tests\InstanceBufferBenchmark.cpp Common\InstanceBuffer.cpp
+
+#include "pch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "TestHarness.h"
+#include "../Common/InstanceBuffer.h"
+
+namespace
+{
+	const float c_snorm16Max = 32767.0f;
+
+	float Clamp(float value, float low, float high)
+	{
+		return (std::min)((std::max)(value, low), high);
+	}
+
+	// 작성기와 같은 식을 인스턴스마다 계산하는 스칼라 작성기입니다. 벤치마크의 비교 대상이기도 합니다.
+	void PackScalar(const DX::InstanceTransform* transforms, std::size_t count, DX::PackedInstance* destination)
+	{
+		for (std::size_t i = 0; i < count; i++)
+		{
+			std::memcpy(destination[i].position, transforms[i].position, sizeof(destination[i].position));
+			destination[i].scale = transforms[i].scale;
+			for (int c = 0; c < 4; c++)
+			{
+				destination[i].rotation[c] = static_cast<std::int16_t>(std::nearbyint(Clamp(transforms[i].rotation[c], -1.0f, 1.0f) * c_snorm16Max));
+			}
+		}
+	}
+
+	// 인스턴스마다 월드 행렬(float4x4, 전치, 64바이트)을 만들어 쓰는 방식입니다. 압축하지 않을 때의 비교 대상입니다.
+	void BuildMatrices(const DX::InstanceTransform* transforms, std::size_t count, float* destination)
+	{
+		for (std::size_t i = 0; i < count; i++)
+		{
+			const float x = transforms[i].rotation[0];
+			const float y = transforms[i].rotation[1];
+			const float z = transforms[i].rotation[2];
+			const float w = transforms[i].rotation[3];
+			const float s = transforms[i].scale;
+			const float matrix[16] =
+			{
+				(1.0f - 2.0f * (y * y + z * z)) * s, 2.0f * (x * y + w * z) * s, 2.0f * (x * z - w * y) * s, 0.0f,
+				2.0f * (x * y - w * z) * s, (1.0f - 2.0f * (x * x + z * z)) * s, 2.0f * (y * z + w * x) * s, 0.0f,
+				2.0f * (x * z + w * y) * s, 2.0f * (y * z - w * x) * s, (1.0f - 2.0f * (x * x + y * y)) * s, 0.0f,
+				transforms[i].position[0], transforms[i].position[1], transforms[i].position[2], 1.0f,
+			};
+			std::memcpy(destination + 16 * i, matrix, sizeof(matrix));
+		}
+	}
+
+	std::vector<DX::InstanceTransform> MakeInstances(std::size_t count, std::uint32_t seed)
+	{
+		std::mt19937 random(seed);
+		std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		std::vector<DX::InstanceTransform> instances(count);
+		for (DX::InstanceTransform& instance : instances)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				instance.position[c] = unit(random) * 100.0f;
+			}
+			instance.scale = 1.0f + unit(random) * 0.5f;
+
+			float length = 0.0f;
+			do
+			{
+				for (int c = 0; c < 4; c++)
+				{
+					instance.rotation[c] = unit(random);
+				}
+				length = std::sqrt(instance.rotation[0] * instance.rotation[0] + instance.rotation[1] * instance.rotation[1] + instance.rotation[2] * instance.rotation[2] + instance.rotation[3] * instance.rotation[3]);
+			} while (length < 1e-3f);
+			for (int c = 0; c < 4; c++)
+			{
+				instance.rotation[c] /= length;
+			}
+		}
+		return instances;
+	}
+
+	// NEON 작성기는 정확히 중간인 값을 0에서 먼 쪽으로 반올림하므로, 중간값에서는 양쪽 이웃을 모두 받아들입니다.
+	bool RotationMatches(float rotation, std::int16_t expected, std::int16_t actual)
+	{
+		const float scaled = Clamp(rotation, -1.0f, 1.0f) * c_snorm16Max;
+		if (scaled - std::floor(scaled) == 0.5f)
+		{
+			return actual == static_cast<std::int16_t>(std::floor(scaled)) || actual == static_cast<std::int16_t>(std::ceil(scaled));
+		}
+		return actual == expected;
+	}
+
+	std::size_t CountMismatches(const DX::InstanceTransform* transforms, std::size_t count, const DX::PackedInstance* expected, const DX::PackedInstance* actual)
+	{
+		std::size_t mismatches = 0;
+		for (std::size_t i = 0; i < count; i++)
+		{
+			bool same = std::memcmp(expected[i].position, actual[i].position, sizeof(expected[i].position)) == 0;
+			same &= std::memcmp(&expected[i].scale, &actual[i].scale, sizeof(expected[i].scale)) == 0;
+			for (int c = 0; c < 4; c++)
+			{
+				same &= RotationMatches(transforms[i].rotation[c], expected[i].rotation[c], actual[i].rotation[c]);
+			}
+			mismatches += !same;
+		}
+		return mismatches;
+	}
+
+	// SIMD 작성기는 스칼라 작성기와 같은 결과를 씁니다. 한 개와 여러 스레드로 나뉘는 크기를 모두 씁니다.
+	void TestMatchesScalar()
+	{
+		const std::size_t counts[] = { 1, 2, 7, 1000, 100000, 300001 };
+		for (std::size_t count : counts)
+		{
+			const std::vector<DX::InstanceTransform> transforms = MakeInstances(count, static_cast<std::uint32_t>(count));
+			std::vector<DX::PackedInstance> expected(count);
+			std::vector<DX::PackedInstance> actual(count);
+			PackScalar(transforms.data(), count, expected.data());
+			DX::PackInstances(transforms.data(), count, actual.data());
+			DX_CHECK(CountMismatches(transforms.data(), count, expected.data(), actual.data()) == 0);
+		}
+	}
+
+	// 범위를 넘는 회전 성분은 ±32767로 잘리고, 반올림 경계와 부호 있는 0도 정의된 값이 됩니다.
+	void TestRotationEdgeCases()
+	{
+		DX::InstanceTransform transforms[3] =
+		{
+			{ { 1.0f, 2.0f, 3.0f }, 4.0f, { 1.5f, -2.0f, 1.0f, -1.0f } },
+			{ { -0.0f, 1e30f, -1e-30f }, 0.0f, { 0.0f, -0.0f, 0.4f / c_snorm16Max, -0.6f / c_snorm16Max } },
+			{ { 0.0f, 0.0f, 0.0f }, 1.0f, { 2.5f / c_snorm16Max, -2.5f / c_snorm16Max, 0.5f, -0.5f } },
+		};
+		DX::PackedInstance packed[3];
+		DX::PackInstances(transforms, 3, packed);
+
+		DX_CHECK(packed[0].position[0] == 1.0f && packed[0].position[2] == 3.0f && packed[0].scale == 4.0f);
+		DX_CHECK(packed[0].rotation[0] == 32767 && packed[0].rotation[1] == -32767 && packed[0].rotation[2] == 32767 && packed[0].rotation[3] == -32767);
+		DX_CHECK(std::memcmp(packed[1].position, transforms[1].position, sizeof(packed[1].position)) == 0);
+		DX_CHECK(packed[1].rotation[0] == 0 && packed[1].rotation[1] == 0 && packed[1].rotation[2] == 0 && packed[1].rotation[3] == -1);
+		DX_CHECK(packed[2].rotation[0] == 2 || packed[2].rotation[0] == 3);
+		DX_CHECK(packed[2].rotation[1] == -2 || packed[2].rotation[1] == -3);
+		DX_CHECK(packed[2].rotation[2] == 16383 || packed[2].rotation[2] == 16384);
+	}
+
+	// 셰이더처럼 정규화해 되돌린 회전은 원래 회전과 0.01도 이내로 같습니다.
+	void TestRotationAccuracy()
+	{
+		const std::size_t count = 100000;
+		const std::vector<DX::InstanceTransform> transforms = MakeInstances(count, 3);
+		std::vector<DX::PackedInstance> packed(count);
+		DX::PackInstances(transforms.data(), count, packed.data());
+
+		double angleError = 0.0;
+		for (std::size_t i = 0; i < count; i++)
+		{
+			double decoded[4];
+			double length = 0.0;
+			for (int c = 0; c < 4; c++)
+			{
+				decoded[c] = packed[i].rotation[c] / 32767.0;
+				length += decoded[c] * decoded[c];
+			}
+			length = std::sqrt(length);
+
+			// 두 쿼터니언 사이의 회전각은 2 acos(|q·r|)입니다. 작은 각은 acos 대신 차이의 길이로 잽니다.
+			double dot = 0.0;
+			for (int c = 0; c < 4; c++)
+			{
+				dot += decoded[c] / length * transforms[i].rotation[c];
+			}
+			const double sign = dot < 0.0 ? -1.0 : 1.0;
+			double difference = 0.0;
+			for (int c = 0; c < 4; c++)
+			{
+				const double delta = sign * decoded[c] / length - transforms[i].rotation[c];
+				difference += delta * delta;
+			}
+			const double angle = 4.0 * std::asin((std::min)(std::sqrt(difference) * 0.5, 1.0)) * 180.0 / 3.14159265358979323846;
+			angleError = (std::max)(angleError, angle);
+		}
+
+		std::printf("회전 왕복 오차: %.4f도\n", angleError);
+		DX_CHECK(angleError < 0.01);
+	}
+
+	// 작성기는 count개만 씁니다. 마지막 인스턴스 뒤는 그대로입니다.
+	void TestWritesOnlyCount()
+	{
+		const std::size_t counts[] = { 0, 1, 5, 70001 };
+		for (std::size_t count : counts)
+		{
+			const std::vector<DX::InstanceTransform> transforms = MakeInstances(count + 1, 50);
+			std::vector<DX::PackedInstance> packed(count + 1);
+			std::memset(packed.data(), 0xcd, packed.size() * sizeof(packed[0]));
+			DX::PackInstances(transforms.data(), count, packed.data());
+
+			const unsigned char* tail = reinterpret_cast<const unsigned char*>(&packed[count]);
+			DX_CHECK(std::all_of(tail, tail + sizeof(DX::PackedInstance), [](unsigned char value) { return value == 0xcd; }));
+		}
+	}
+
+	// 캐시에 들어가는 1K 인스턴스, 그리드 316x316(약 10만 개), 1M 인스턴스를 프레임마다 다시 쓰는 처리량입니다.
+	// 쓰는 바이트 수는 float4x4 행렬의 3/8이므로, 메모리에 묶이는 큰 크기에서 차이가 커집니다.
+	// 캐시 안에서는 스칼라 작성기보다 빨라야 합니다.
+	void BenchmarkPackers()
+	{
+		const std::size_t counts[] = { 1000, 316 * 316, 1000000 };
+		for (std::size_t count : counts)
+		{
+			const int repeat = count <= 1000 ? 2000 : (count <= 316 * 316 ? 50 : 10);
+			const std::vector<DX::InstanceTransform> transforms = MakeInstances(count, 1);
+			std::vector<DX::PackedInstance> packed(count);
+			std::vector<float> matrices(16 * count);
+
+			const double scalarSeconds = DX::Test::MeasureBestSeconds(repeat, [&]() { PackScalar(transforms.data(), count, packed.data()); });
+			const double packSeconds = DX::Test::MeasureBestSeconds(repeat, [&]() { DX::PackInstances(transforms.data(), count, packed.data()); });
+			const double matrixSeconds = DX::Test::MeasureBestSeconds(repeat, [&]() { BuildMatrices(transforms.data(), count, matrices.data()); });
+
+			std::printf("%7zu 인스턴스: 스칼라 %7.1f M/s, SIMD %7.1f M/s (%.3f ms, 쓰기 %.2f GB/s), float4x4 %7.1f M/s (%.3f ms, 쓰기 %.2f GB/s)\n",
+				count,
+				count / scalarSeconds / 1e6,
+				count / packSeconds / 1e6,
+				packSeconds * 1e3,
+				count * sizeof(DX::PackedInstance) / packSeconds / 1e9,
+				count / matrixSeconds / 1e6,
+				matrixSeconds * 1e3,
+				count * 16 * sizeof(float) / matrixSeconds / 1e9);
+			if (count <= 1000)
+			{
+				DX_CHECK(packSeconds < scalarSeconds);
+			}
+		}
+
+		std::printf("인스턴스 크기: 변환 %zu바이트 -> 압축 %zu바이트 (float4x4 %zu바이트)\n", sizeof(DX::InstanceTransform), sizeof(DX::PackedInstance), 16 * sizeof(float));
+	}
+}
+
+int main()
+{
+	TestMatchesScalar();
+	TestRotationEdgeCases();
+	TestRotationAccuracy();
+	TestWritesOnlyCount();
+	BenchmarkPackers();
+	return DX::Test::Finish("InstanceBufferBenchmark");
+}
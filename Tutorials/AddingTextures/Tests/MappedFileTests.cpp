@@ -0,0 +1,108 @@
+﻿// MappedFile 검사입니다. 임시 파일을 써서 매핑한 내용이 원본과 같은지, 매핑 수명과 오류 처리를 확인합니다.
+// Linux에서는 표준 라이브러리와 POSIX만 사용합니다. Windows에서는 HANDLE과 ThrowIfFailed 때문에 헤드리스 D3D12 헤더를 함께 씁니다.
+//
+//	g++ -std=c++14 -O2 -I Tests -o MappedFileTests Tests/MappedFileTests.cpp Common/MappedFile.cpp
+//	cl /std:c++14 /O2 /EHsc /DDX_HEADLESS_D3D12 /I Tests Tests\MappedFileTests.cpp Common\MappedFile.cpp
+
+#include "pch.h"
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include "TestHarness.h"
+#include "../Common/MappedFile.h"
+
+namespace
+{
+	// 현재 디렉터리의 ASCII 파일 이름을 플랫폼 경로로 바꿉니다.
+	DX::MappedFilePath MakePath(const char* name)
+	{
+		return DX::MappedFilePath(name, name + std::strlen(name));
+	}
+
+	void WriteFile(const char* name, const std::vector<std::uint8_t>& data)
+	{
+		FILE* file = std::fopen(name, "wb");
+		DX_CHECK(file != nullptr);
+		if (file != nullptr)
+		{
+			if (!data.empty())
+			{
+				std::fwrite(data.data(), 1, data.size(), file);
+			}
+			std::fclose(file);
+		}
+	}
+
+	// 페이지 크기의 배수가 아닌 파일도 끝까지 그대로 매핑합니다.
+	void TestRoundTrip()
+	{
+		const char* name = "MappedFileTests.tmp";
+		const std::size_t sizes[] = { 1, 4095, 4096, 65537, 3 * 1024 * 1024 + 7 };
+		for (std::size_t size : sizes)
+		{
+			std::vector<std::uint8_t> data(size);
+			for (std::size_t i = 0; i < size; i++)
+			{
+				data[i] = static_cast<std::uint8_t>((i * 2654435761u) >> 13);
+			}
+			WriteFile(name, data);
+
+			std::shared_ptr<const DX::MappedFile> file = DX::MappedFile::Open(MakePath(name));
+			DX_CHECK(file->GetSize() == size);
+			DX_CHECK(std::memcmp(file->GetData(), data.data(), size) == 0);
+		}
+		std::remove(name);
+	}
+
+	// 빈 파일은 크기 0으로 열립니다.
+	void TestEmptyFile()
+	{
+		const char* name = "MappedFileTests.empty.tmp";
+		WriteFile(name, std::vector<std::uint8_t>());
+		{
+			std::shared_ptr<const DX::MappedFile> file = DX::MappedFile::Open(MakePath(name));
+			DX_CHECK(file->GetSize() == 0);
+		}
+		std::remove(name);
+	}
+
+	// 매핑은 마지막 참조가 해제될 때까지 유효합니다.
+	void TestSharedLifetime()
+	{
+		const char* name = "MappedFileTests.shared.tmp";
+		const std::vector<std::uint8_t> data = { 'm', 'a', 'p', 'p', 'e', 'd' };
+		WriteFile(name, data);
+		{
+			std::shared_ptr<const DX::MappedFile> file = DX::MappedFile::Open(MakePath(name));
+			std::shared_ptr<const void> owner = file;
+			const std::uint8_t* bytes = file->GetData();
+			file.reset();
+			DX_CHECK(std::memcmp(bytes, data.data(), data.size()) == 0);
+		}
+		std::remove(name);
+	}
+
+	// 없는 파일은 예외를 던집니다.
+	void TestMissingFile()
+	{
+		bool threw = false;
+		try
+		{
+			DX::MappedFile::Open(MakePath("MappedFileTests.missing.tmp"));
+		}
+		catch (const std::exception&)
+		{
+			threw = true;
+		}
+		DX_CHECK(threw);
+	}
+}
+
+int main()
+{
+	TestRoundTrip();
+	TestEmptyFile();
+	TestSharedLifetime();
+	TestMissingFile();
+	return DX::Test::Finish("MappedFileTests");
+}
@@ -0,0 +1,482 @@
+﻿// OBJ/glTF 가져오기와 쿠킹된 메시의 검사, 그리고 가져오기 처리량(MB/s)과 쿠킹된 메시 로드 시간 벤치마크입니다.
+// 격자 메시를 OBJ 텍스트와 GLB로 만들어 읽은 결과를 비교하고, 기본 256MB(첫 인수로 MB 단위 지정) 파일로 처리량을 잽니다.
+// 쿠킹된 메시 로드는 앱과 같은 경로(파일 매핑, CreateCookedMesh, UploadBatch 한 번 제출)를 헤드리스 D3D12(NullDevice)에서 실행합니다.
+// Windows가 아닌 플랫폼에서는 DirectX-Headers(https://github.com/microsoft/DirectX-Headers)가 필요합니다.
+//
+//	g++ -std=c++14 -O2 -pthread -DDX_HEADLESS_D3D12 -I Tests -I $DXH/include -I $DXH/include/wsl/stubs -o MeshImportBenchmark Tests/MeshImportBenchmark.cpp Common/CookedMeshLoader.cpp Common/UploadBatch.cpp Common/CopyQueue.cpp Common/UploadRingBuffer.cpp Common/SubresourceCopy.cpp Common/MappedFile.cpp Common/NullDevice.cpp
+//	cl /std:c++14 /O2 /EHsc /DDX_HEADLESS_D3D12 /I Tests Tests\MeshImportBenchmark.cpp Common\CookedMeshLoader.cpp Common\UploadBatch.cpp Common\CopyQueue.cpp Common\UploadRingBuffer.cpp Common\SubresourceCopy.cpp Common\MappedFile.cpp Common\NullDevice.cpp dxguid.lib
+
+#include "pch.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include "TestHarness.h"
+#include "../Common/CookedMeshLoader.h"
+#include "../Common/DirectXHelper.h"
+#include "../Common/GltfFormat.h"
+#include "../Common/ObjFormat.h"
+
+using Microsoft::WRL::ComPtr;
+
+namespace
+{
+	const char* const c_cookedPath = "MeshImportBenchmark.mesh.tmp";
+
+	// gridSize x gridSize 꼭짓점의 격자입니다. 모든 값은 1/64의 배수이므로 OBJ의 십진 표기와 GLB의 float가 정확히 같습니다.
+	struct Grid
+	{
+		std::uint32_t				gridSize;
+		std::vector<DX::MeshVertex>	vertices;
+		std::vector<std::uint32_t>	indices;
+	};
+
+	Grid MakeGrid(std::uint32_t gridSize)
+	{
+		Grid grid;
+		grid.gridSize = gridSize;
+		grid.vertices.resize(static_cast<std::size_t>(gridSize) * gridSize);
+		for (std::uint32_t z = 0; z < gridSize; z++)
+		{
+			for (std::uint32_t x = 0; x < gridSize; x++)
+			{
+				DX::MeshVertex& vertex = grid.vertices[static_cast<std::size_t>(z) * gridSize + x];
+				vertex.position[0] = x * 0.25f;
+				vertex.position[1] = static_cast<float>((x * 7 + z * 13) % 64) / 64.0f - 0.5f;
+				vertex.position[2] = 0.0f - z * 0.25f;	// z = 0에서 -0이 되지 않게 합니다.
+				vertex.normal[0] = static_cast<float>(static_cast<int>(x % 3) - 1) * 0.5f;
+				vertex.normal[1] = 0.75f;
+				vertex.normal[2] = static_cast<float>(static_cast<int>(z % 3) - 1) * 0.5f;
+				vertex.texCoord[0] = static_cast<float>(x % 65) / 64.0f;
+				vertex.texCoord[1] = static_cast<float>(z % 65) / 64.0f;
+			}
+		}
+
+		grid.indices.reserve(static_cast<std::size_t>(gridSize - 1) * (gridSize - 1) * 6);
+		for (std::uint32_t z = 0; z + 1 < gridSize; z++)
+		{
+			for (std::uint32_t x = 0; x + 1 < gridSize; x++)
+			{
+				const std::uint32_t corner = z * gridSize + x;
+				const std::uint32_t quad[6] = { corner, corner + gridSize, corner + 1, corner + 1, corner + gridSize, corner + gridSize + 1 };
+				grid.indices.insert(grid.indices.end(), quad, quad + 6);
+			}
+		}
+		return grid;
+	}
+
+	void AppendUnsigned(std::string* text, std::uint64_t value)
+	{
+		char digits[20];
+		int count = 0;
+		do
+		{
+			digits[count++] = static_cast<char>('0' + value % 10);
+			value /= 10;
+		} while (value != 0);
+		while (count > 0)
+		{
+			text->push_back(digits[--count]);
+		}
+	}
+
+	// 1/64의 배수를 소수점 아래 여섯 자리까지 정확히 씁니다.
+	void AppendFloat(std::string* text, float value)
+	{
+		if (value < 0.0f)
+		{
+			text->push_back('-');
+			value = -value;
+		}
+		const std::uint64_t scaled = static_cast<std::uint64_t>(static_cast<double>(value) * 1000000.0 + 0.5);
+		AppendUnsigned(text, scaled / 1000000);
+		text->push_back('.');
+		const std::uint64_t fraction = scaled % 1000000;
+		for (std::uint64_t digit = 100000; digit != 0; digit /= 10)
+		{
+			text->push_back(static_cast<char>('0' + fraction / digit % 10));
+		}
+	}
+
+	// v, vt, vn 줄 다음에 삼각형 면 줄을 씁니다. relative이면 면 번호를 음수(상대) 번호로 씁니다.
+	// OBJ의 텍스처 좌표 원점은 왼쪽 아래이므로 v를 뒤집어 씁니다.
+	std::string WriteObj(const Grid& grid, bool relative)
+	{
+		std::string text;
+		text.reserve(grid.vertices.size() * 100 + grid.indices.size() * 30);
+		text += "# MeshImportBenchmark grid\no grid\n";
+		for (const DX::MeshVertex& vertex : grid.vertices)
+		{
+			text += "v ";
+			AppendFloat(&text, vertex.position[0]);
+			text += ' ';
+			AppendFloat(&text, vertex.position[1]);
+			text += ' ';
+			AppendFloat(&text, vertex.position[2]);
+			text += "\nvt ";
+			AppendFloat(&text, vertex.texCoord[0]);
+			text += ' ';
+			AppendFloat(&text, 1.0f - vertex.texCoord[1]);
+			text += "\nvn ";
+			AppendFloat(&text, vertex.normal[0]);
+			text += ' ';
+			AppendFloat(&text, vertex.normal[1]);
+			text += ' ';
+			AppendFloat(&text, vertex.normal[2]);
+			text += '\n';
+		}
+
+		const std::uint64_t vertexCount = grid.vertices.size();
+		for (std::size_t i = 0; i < grid.indices.size(); i += 3)
+		{
+			text += 'f';
+			for (std::size_t k = 0; k < 3; k++)
+			{
+				for (int attribute = 0; attribute < 3; attribute++)
+				{
+					text += attribute == 0 ? ' ' : '/';
+					if (relative)
+					{
+						text += '-';
+						AppendUnsigned(&text, vertexCount - grid.indices[i + k]);
+					}
+					else
+					{
+						AppendUnsigned(&text, grid.indices[i + k] + 1);
+					}
+				}
+			}
+			text += '\n';
+		}
+		return text;
+	}
+
+	void AppendBytes(std::vector<std::uint8_t>* data, const void* bytes, std::size_t size)
+	{
+		const std::uint8_t* begin = static_cast<const std::uint8_t*>(bytes);
+		data->insert(data->end(), begin, begin + size);
+	}
+
+	// 위치, 법선, 텍스처 좌표와 32비트 인덱스를 BIN 청크의 한 버퍼에 담은 GLB입니다. 장면이 없으므로 메시를 변환 없이 읽습니다.
+	std::vector<std::uint8_t> WriteGlb(const Grid& grid)
+	{
+		const std::size_t vertexCount = grid.vertices.size();
+		std::vector<std::uint8_t> binary;
+		binary.reserve(vertexCount * sizeof(DX::MeshVertex) + grid.indices.size() * 4);
+		for (const DX::MeshVertex& vertex : grid.vertices)
+		{
+			AppendBytes(&binary, vertex.position, sizeof(vertex.position));
+		}
+		for (const DX::MeshVertex& vertex : grid.vertices)
+		{
+			AppendBytes(&binary, vertex.normal, sizeof(vertex.normal));
+		}
+		for (const DX::MeshVertex& vertex : grid.vertices)
+		{
+			AppendBytes(&binary, vertex.texCoord, sizeof(vertex.texCoord));
+		}
+		AppendBytes(&binary, grid.indices.data(), grid.indices.size() * 4);
+
+		const std::string count = std::to_string(vertexCount);
+		const std::string normalOffset = std::to_string(vertexCount * 12);
+		const std::string texCoordOffset = std::to_string(vertexCount * 24);
+		const std::string indexOffset = std::to_string(vertexCount * 32);
+		std::string json =
+			"{\"asset\":{\"version\":\"2.0\"},"
+			"\"buffers\":[{\"byteLength\":" + std::to_string(binary.size()) + "}],"
+			"\"bufferViews\":["
+			"{\"buffer\":0,\"byteLength\":" + normalOffset + "},"
+			"{\"buffer\":0,\"byteOffset\":" + normalOffset + ",\"byteLength\":" + normalOffset + "},"
+			"{\"buffer\":0,\"byteOffset\":" + texCoordOffset + ",\"byteLength\":" + std::to_string(vertexCount * 8) + "},"
+			"{\"buffer\":0,\"byteOffset\":" + indexOffset + ",\"byteLength\":" + std::to_string(grid.indices.size() * 4) + "}],"
+			"\"accessors\":["
+			"{\"bufferView\":0,\"componentType\":5126,\"count\":" + count + ",\"type\":\"VEC3\"},"
+			"{\"bufferView\":1,\"componentType\":5126,\"count\":" + count + ",\"type\":\"VEC3\"},"
+			"{\"bufferView\":2,\"componentType\":5126,\"count\":" + count + ",\"type\":\"VEC2\"},"
+			"{\"bufferView\":3,\"componentType\":5125,\"count\":" + std::to_string(grid.indices.size()) + ",\"type\":\"SCALAR\"}],"
+			"\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"TEXCOORD_0\":2},\"indices\":3}]}]}";
+		while (json.size() % 4 != 0)
+		{
+			json += ' ';
+		}
+
+		const std::uint32_t jsonSize = static_cast<std::uint32_t>(json.size());
+		const std::uint32_t binarySize = static_cast<std::uint32_t>(binary.size());
+		const std::uint32_t header[5] = { DX::c_glbMagic, DX::c_glbVersion, 12 + 8 + jsonSize + 8 + binarySize, jsonSize, DX::c_glbChunkJson };
+		const std::uint32_t binaryChunk[2] = { binarySize, DX::c_glbChunkBin };
+
+		std::vector<std::uint8_t> file;
+		file.reserve(header[2]);
+		AppendBytes(&file, header, sizeof(header));
+		AppendBytes(&file, json.data(), json.size());
+		AppendBytes(&file, binaryChunk, sizeof(binaryChunk));
+		AppendBytes(&file, binary.data(), binary.size());
+		return file;
+	}
+
+	bool ParseObjText(const std::string& text, DX::ImportedMesh* mesh)
+	{
+		return DX::ParseObj(text.data(), text.size(), mesh);
+	}
+
+	bool ParseGlbFile(const std::vector<std::uint8_t>& file, DX::ImportedMesh* mesh)
+	{
+		return DX::ParseGltf(file.data(), file.size(), DX::GltfUriResolver(), mesh);
+	}
+
+	// 삼각형 목록을 따라가며 두 메시가 같은 꼭짓점을 같은 순서로 그리는지 비교합니다. 꼭짓점 번호는 달라도 됩니다.
+	bool DrawsGrid(const DX::ImportedMesh& mesh, const Grid& grid)
+	{
+		if (mesh.indices.size() != grid.indices.size() || !mesh.hasNormals || !mesh.hasTexCoords)
+		{
+			return false;
+		}
+		for (std::size_t i = 0; i < grid.indices.size(); i++)
+		{
+			if (mesh.indices[i] >= mesh.vertices.size() ||
+				std::memcmp(&mesh.vertices[mesh.indices[i]], &grid.vertices[grid.indices[i]], sizeof(DX::MeshVertex)) != 0)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// 작은 OBJ의 다각형 분할, 상대 번호, v//n 형식, 텍스처 좌표 뒤집기와 꼭짓점 합치기입니다.
+	void TestObjFeatures()
+	{
+		const char text[] =
+			"# quad\r\n"
+			"mtllib quad.mtl\n"
+			"v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+			"vt 0 0\nvt 1 0.25\n"
+			"vn 0 0 1\n"
+			"usemtl a\n"
+			"f -4/1/1 -3/2/1 -2/2/1 -1/1/1\n"
+			"f 1//1 3//1 4//1\n";
+		DX::ImportedMesh mesh;
+		DX_CHECK(DX::ParseObj(text, sizeof(text) - 1, &mesh));
+		DX_CHECK(mesh.indices.size() == 9 && mesh.hasNormals && mesh.hasTexCoords);
+
+		const std::uint32_t expected[9] = { 0, 1, 2, 0, 2, 3, 4, 5, 6 };
+		DX_CHECK(mesh.vertices.size() == 7 && std::memcmp(mesh.indices.data(), expected, sizeof(expected)) == 0);
+		DX_CHECK(mesh.vertices[1].texCoord[0] == 1.0f && mesh.vertices[1].texCoord[1] == 0.75f);
+		DX_CHECK(mesh.vertices[4].texCoord[0] == 0.0f && mesh.vertices[4].texCoord[1] == 0.0f && mesh.vertices[4].normal[2] == 1.0f);
+
+		const char* const invalid[] = { "v 0 0 0\nf 1 2 3\n", "v 0 0 0\nf 1 -2 1\n", "v 0 x 0\n", "f 1 1\n" };
+		for (const char* bad : invalid)
+		{
+			DX::ImportedMesh rejected;
+			DX_CHECK(!DX::ParseObj(bad, std::strlen(bad), &rejected));
+		}
+	}
+
+	// 여러 조각으로 나뉘는 격자 OBJ(절대 번호와 상대 번호)와 같은 격자의 GLB가 모두 원래 격자를 그립니다.
+	void TestGridImport()
+	{
+		const Grid grid = MakeGrid(400);
+		const std::string absolute = WriteObj(grid, false);
+		const std::string relative = WriteObj(grid, true);
+		DX_CHECK(absolute.size() > DX::ObjDetail::c_minChunkSize * 4);
+
+		DX::ImportedMesh mesh;
+		DX_CHECK(ParseObjText(absolute, &mesh) && DrawsGrid(mesh, grid) && mesh.vertices.size() == grid.vertices.size());
+		DX_CHECK(ParseObjText(relative, &mesh) && DrawsGrid(mesh, grid) && mesh.vertices.size() == grid.vertices.size());
+		DX_CHECK(ParseGlbFile(WriteGlb(grid), &mesh) && DrawsGrid(mesh, grid));
+
+		std::vector<std::uint8_t> truncated = WriteGlb(grid);
+		truncated.resize(truncated.size() - 4);
+		DX_CHECK(!ParseGlbFile(truncated, &mesh));
+	}
+
+	// 쿠킹된 메시는 가져온 메시를 그대로 담고, 꼭짓점이 65535개 이하이면 16비트 인덱스를 씁니다. 손상된 헤더는 거부합니다.
+	void TestCookedRoundTrip()
+	{
+		const std::uint32_t gridSizes[] = { 100, 300 };
+		for (std::uint32_t gridSize : gridSizes)
+		{
+			const Grid grid = MakeGrid(gridSize);
+			DX::ImportedMesh mesh;
+			mesh.vertices = grid.vertices;
+			mesh.indices = grid.indices;
+			mesh.hasNormals = true;
+
+			std::vector<std::uint8_t> file;
+			DX_CHECK(DX::SerializeCookedMesh(mesh, &file));
+			DX::CookedMeshView view;
+			DX_CHECK(DX::ParseCookedMesh(file.data(), file.size(), &view));
+			DX_CHECK(view.header.indexSize == (grid.vertices.size() <= 0xFFFF ? 2u : 4u));
+			DX_CHECK(view.header.flags == DX::c_cookedMeshHasNormals);
+			DX_CHECK(view.vertexDataSize == grid.vertices.size() * sizeof(DX::MeshVertex));
+			DX_CHECK(std::memcmp(view.vertices, grid.vertices.data(), view.vertexDataSize) == 0);
+
+			bool indicesMatch = true;
+			for (std::size_t i = 0; i < grid.indices.size(); i++)
+			{
+				std::uint32_t index = 0;
+				std::memcpy(&index, view.indices + i * view.header.indexSize, view.header.indexSize);
+				indicesMatch &= index == grid.indices[i];
+			}
+			DX_CHECK(indicesMatch);
+			DX_CHECK(view.header.boundsMax[0] == (gridSize - 1) * 0.25f && view.header.boundsMin[2] == (gridSize - 1) * -0.25f);
+
+			DX_CHECK(!DX::ParseCookedMesh(file.data(), file.size() - 1, &view));
+			file[8] = 31;	// vertexStride
+			DX_CHECK(!DX::ParseCookedMesh(file.data(), file.size(), &view));
+		}
+
+		DX::ImportedMesh outOfRange;
+		outOfRange.vertices.resize(2);
+		outOfRange.indices.assign(3, 2);
+		std::vector<std::uint8_t> file;
+		DX_CHECK(!DX::SerializeCookedMesh(outOfRange, &file));
+	}
+
+	bool WriteFile(const char* path, const std::vector<std::uint8_t>& data)
+	{
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		stream.write(reinterpret_cast<const char*>(data.data()), data.size());
+		return static_cast<bool>(stream);
+	}
+
+	DX::MappedFilePath MakePath(const char* name)
+	{
+		return DX::MappedFilePath(name, name + std::strlen(name));
+	}
+
+	// 헤드리스 장치와 쿠킹된 메시를 담을 링 버퍼의 복사 큐입니다.
+	class HeadlessCopyQueue
+	{
+	public:
+		explicit HeadlessCopyQueue(UINT64 uploadBufferSize)
+		{
+			m_device.Attach(new DX::NullDevice());
+			m_copyQueue.reset(new DX::CopyQueue(m_device.Get(), uploadBufferSize));
+		}
+
+		~HeadlessCopyQueue()
+		{
+			m_copyQueue.reset();
+			GetDevice()->FlushGpu();
+		}
+
+		DX::NullDevice* GetDevice() const	{ return static_cast<DX::NullDevice*>(m_device.Get()); }
+		DX::CopyQueue* GetCopyQueue() const	{ return m_copyQueue.get(); }
+
+	private:
+		ComPtr<ID3D12Device>				m_device;
+		std::unique_ptr<DX::CopyQueue>		m_copyQueue;
+	};
+
+	// 파일을 매핑하고 CreateCookedMesh로 버퍼를 만든 뒤 한 번의 Submit으로 올리고 완료를 기다립니다.
+	DX::CookedMesh LoadCookedMesh(HeadlessCopyQueue* queue, DX::UploadBatch* batch)
+	{
+		const DX::AssetView file(DX::MappedFile::Open(MakePath(c_cookedPath)));
+		DX::CookedMesh mesh;
+		DX::CreateCookedMesh(queue->GetDevice(), file, batch, &mesh);
+		queue->GetCopyQueue()->Wait(batch->Submit(queue->GetCopyQueue()));
+		return mesh;
+	}
+
+	// 헤드리스 장치에서 쿠킹된 메시를 올리면 두 블롭 크기만큼 복사하고, 형식이 맞지 않는 파일은 예외를 던집니다.
+	void TestCookedLoad()
+	{
+		const Grid grid = MakeGrid(300);
+		DX::ImportedMesh imported;
+		imported.vertices = grid.vertices;
+		imported.indices = grid.indices;
+		std::vector<std::uint8_t> file;
+		DX_CHECK(DX::SerializeCookedMesh(imported, &file) && WriteFile(c_cookedPath, file));
+
+		HeadlessCopyQueue queue(4 * 1024 * 1024);
+		DX::UploadBatch batch(queue.GetDevice());
+		queue.GetDevice()->ResetStatistics();
+		const DX::CookedMesh mesh = LoadCookedMesh(&queue, &batch);
+		DX_CHECK(mesh.indexCount == grid.indices.size());
+		DX_CHECK(mesh.indexBufferView.Format == DXGI_FORMAT_R32_UINT && mesh.vertexBufferView.StrideInBytes == sizeof(DX::MeshVertex));
+		DX_CHECK(queue.GetDevice()->GetStatistics().copyBytes == grid.vertices.size() * sizeof(DX::MeshVertex) + grid.indices.size() * 4);
+
+		file[0] = 0;
+		DX_CHECK(WriteFile(c_cookedPath, file));
+		bool threw = false;
+		try
+		{
+			LoadCookedMesh(&queue, &batch);
+		}
+		catch (const std::exception&)
+		{
+			threw = true;
+		}
+		DX_CHECK(threw);
+		std::remove(c_cookedPath);
+	}
+
+	// 격자 한 꼭짓점이 format 파일에서 차지하는 바이트를 작은 격자로 어림하여 targetBytes에 맞는 격자 크기를 구합니다.
+	template<typename TWrite>
+	std::uint32_t GetGridSizeForBytes(std::size_t targetBytes, const TWrite& write)
+	{
+		const std::uint32_t sampleSize = 256;
+		const double bytesPerVertex = static_cast<double>(write(MakeGrid(sampleSize))) / (static_cast<double>(sampleSize) * sampleSize);
+		return (std::max)(static_cast<std::uint32_t>(std::sqrt(targetBytes / bytesPerVertex)), 2u);
+	}
+
+	// targetMegabytes 크기의 OBJ와 GLB를 읽는 처리량과, 같은 OBJ를 쿠킹한 파일의 로드 시간입니다.
+	// 파일은 메모리에서 읽으므로 디스크 속도는 포함하지 않습니다. 쿠킹된 메시는 운영 체제 파일 캐시에 있는 상태에서 잽니다.
+	void BenchmarkImport(std::size_t targetMegabytes)
+	{
+		const std::size_t targetBytes = targetMegabytes * 1024 * 1024;
+		const int repeat = 3;
+
+		double objSeconds = 0.0;
+		DX::ImportedMesh objMesh;
+		{
+			const std::uint32_t gridSize = GetGridSizeForBytes(targetBytes, [](const Grid& grid) { return WriteObj(grid, false).size(); });
+			const std::string text = WriteObj(MakeGrid(gridSize), false);
+			objSeconds = DX::Test::MeasureBestSeconds(repeat, [&]() { DX_CHECK(ParseObjText(text, &objMesh)); });
+			std::printf("OBJ %7.1f MB: %7.1f ms, %6.1f MB/s (꼭짓점 %zu개, 삼각형 %zu개, 스레드 %u개)\n",
+				text.size() / 1048576.0, objSeconds * 1000.0, text.size() / 1048576.0 / objSeconds,
+				objMesh.vertices.size(), objMesh.indices.size() / 3, DX::GetHardwareThreadCount());
+		}
+		{
+			const std::uint32_t gridSize = GetGridSizeForBytes(targetBytes, [](const Grid& grid) { return WriteGlb(grid).size(); });
+			const std::vector<std::uint8_t> glb = WriteGlb(MakeGrid(gridSize));
+			DX::ImportedMesh mesh;
+			const double seconds = DX::Test::MeasureBestSeconds(repeat, [&]() { DX_CHECK(ParseGlbFile(glb, &mesh)); });
+			std::printf("GLB %7.1f MB: %7.1f ms, %6.1f MB/s (꼭짓점 %zu개, 삼각형 %zu개)\n",
+				glb.size() / 1048576.0, seconds * 1000.0, glb.size() / 1048576.0 / seconds, mesh.vertices.size(), mesh.indices.size() / 3);
+		}
+
+		std::vector<std::uint8_t> file;
+		DX_CHECK(DX::SerializeCookedMesh(objMesh, &file) && WriteFile(c_cookedPath, file));
+		objMesh = DX::ImportedMesh();
+
+		// 링 버퍼는 두 블롭을 한 번에 담을 수 있어야 합니다.
+		HeadlessCopyQueue queue(file.size() * 2);
+		DX::UploadBatch batch(queue.GetDevice());
+		LoadCookedMesh(&queue, &batch);
+		queue.GetDevice()->ResetStatistics();
+		const double cookedSeconds = DX::Test::MeasureBestSeconds(repeat, [&]() { LoadCookedMesh(&queue, &batch); });
+		const UINT64 submits = queue.GetDevice()->GetStatistics().executeCalls;
+		std::printf("쿠킹된 메시 %7.1f MB: 매핑과 업로드 %7.1f ms, %6.1f MB/s (제출 %llu번), OBJ 가져오기보다 %.0f배 빠름\n",
+			file.size() / 1048576.0, cookedSeconds * 1000.0, file.size() / 1048576.0 / cookedSeconds,
+			static_cast<unsigned long long>(submits / repeat), objSeconds / cookedSeconds);
+		DX_CHECK(submits == static_cast<UINT64>(repeat));
+		DX_CHECK(cookedSeconds < objSeconds);
+		std::remove(c_cookedPath);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const std::size_t targetMegabytes = argc > 1 ? static_cast<std::size_t>(std::strtoul(argv[1], nullptr, 10)) : 256;
+
+	TestObjFeatures();
+	TestGridImport();
+	TestCookedRoundTrip();
+	TestCookedLoad();
+	BenchmarkImport(targetMegabytes);
+	return DX::Test::Finish("MeshImportBenchmark");
+}
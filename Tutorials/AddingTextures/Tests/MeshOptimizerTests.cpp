@@ -0,0 +1,236 @@
+﻿// MeshOptimizer 검사입니다. 삼각형을 섞은 격자 메시로 최적화 전후의 삼각형 집합과 꼭짓점 캐시 효율을 비교하고,
+// 각 단계(용접, 가져오기 순서, 오버드로 정렬)와 인덱스 검증을 따로 확인합니다.
+// Linux에서는 표준 라이브러리만 사용합니다. Windows에서는 ThrowIfFailed 때문에 헤드리스 D3D12 헤더를 함께 씁니다.
+//
+//	g++ -std=c++14 -O2 -I Tests -o MeshOptimizerTests Tests/MeshOptimizerTests.cpp Common/MeshOptimizer.cpp
+//	cl /std:c++14 /O2 /EHsc /DDX_HEADLESS_D3D12 /I Tests Tests\MeshOptimizerTests.cpp Common\MeshOptimizer.cpp
+
+#include "pch.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include "TestHarness.h"
+#include "../Common/MeshOptimizer.h"
+
+namespace
+{
+	// 위치 뒤에 텍스처 좌표가 오는 꼭짓점입니다(20바이트).
+	struct GridVertex
+	{
+		float	position[3];
+		float	texCoord[2];
+	};
+
+	const std::size_t c_positionOffset = 0;
+
+	// 꼭짓점을 공유하지 않는 삼각형 목록(삼각형마다 꼭짓점 세 개)으로 만든 size x size 격자입니다. 삼각형 순서는 섞습니다.
+	void MakeShuffledGrid(std::uint32_t size, std::uint32_t seed, std::vector<std::uint32_t>* indices, std::vector<std::uint8_t>* vertices)
+	{
+		std::vector<std::array<GridVertex, 3>> triangles;
+		for (std::uint32_t y = 0; y < size; y++)
+		{
+			for (std::uint32_t x = 0; x < size; x++)
+			{
+				GridVertex corners[4];
+				for (std::uint32_t c = 0; c < 4; c++)
+				{
+					const float u = static_cast<float>(x + (c & 1)) / size;
+					const float v = static_cast<float>(y + (c >> 1)) / size;
+					corners[c] = { { u * 10.0f, v * 10.0f, 0.0f }, { u, v } };
+				}
+				triangles.push_back({ { corners[0], corners[1], corners[2] } });
+				triangles.push_back({ { corners[2], corners[1], corners[3] } });
+			}
+		}
+
+		std::mt19937 random(seed);
+		std::shuffle(triangles.begin(), triangles.end(), random);
+
+		vertices->resize(triangles.size() * 3 * sizeof(GridVertex));
+		indices->resize(triangles.size() * 3);
+		for (std::size_t i = 0; i < triangles.size() * 3; i++)
+		{
+			std::memcpy(vertices->data() + i * sizeof(GridVertex), &triangles[i / 3][i % 3], sizeof(GridVertex));
+			(*indices)[i] = static_cast<std::uint32_t>(i);
+		}
+	}
+
+	// 꼭짓점 번호와 무관하게 비교할 수 있도록 삼각형마다 세 꼭짓점의 바이트를 모읍니다.
+	// 감기 방향은 유지하고, 가장 작은 꼭짓점이 먼저 오도록 돌립니다.
+	std::vector<std::vector<std::uint8_t>> GetTriangleSet(const std::vector<std::uint32_t>& indices, const std::vector<std::uint8_t>& vertices, std::size_t stride)
+	{
+		std::vector<std::vector<std::uint8_t>> triangles;
+		for (std::size_t t = 0; t < indices.size() / 3; t++)
+		{
+			std::vector<std::uint8_t> corners[3];
+			for (std::size_t c = 0; c < 3; c++)
+			{
+				const std::uint8_t* vertex = vertices.data() + indices[t * 3 + c] * stride;
+				corners[c].assign(vertex, vertex + stride);
+			}
+			const std::size_t first = std::min_element(corners, corners + 3) - corners;
+			std::vector<std::uint8_t> triangle;
+			for (std::size_t c = 0; c < 3; c++)
+			{
+				const std::vector<std::uint8_t>& corner = corners[(first + c) % 3];
+				triangle.insert(triangle.end(), corner.begin(), corner.end());
+			}
+			triangles.push_back(triangle);
+		}
+		std::sort(triangles.begin(), triangles.end());
+		return triangles;
+	}
+
+	template<typename TBody>
+	bool Throws(const TBody& body)
+	{
+		try
+		{
+			body();
+		}
+		catch (const std::exception&)
+		{
+			return true;
+		}
+		return false;
+	}
+
+	// 최적화는 삼각형 집합(감기 방향 포함)을 바꾸지 않고, 같은 꼭짓점을 합치며 ACMR을 줄입니다.
+	void TestOptimizeMesh()
+	{
+		const std::uint32_t size = 64;
+		std::vector<std::uint32_t> indices;
+		std::vector<std::uint8_t> vertices;
+		MakeShuffledGrid(size, 1, &indices, &vertices);
+		const auto trianglesBefore = GetTriangleSet(indices, vertices, sizeof(GridVertex));
+
+		const DX::MeshOptimizationReport report = DX::OptimizeMesh(&indices, &vertices, sizeof(GridVertex), c_positionOffset);
+		std::printf("섞은 %ux%u 격자: 꼭짓점 %u -> %u, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n",
+			size, size, report.vertexCountBefore, report.vertexCountAfter, report.before.acmr, report.after.acmr, report.before.atvr, report.after.atvr);
+
+		DX_CHECK(indices.size() == size * size * 6);
+		DX_CHECK(report.vertexCountBefore == size * size * 6);
+		DX_CHECK(report.vertexCountAfter == (size + 1) * (size + 1));
+		DX_CHECK(vertices.size() == report.vertexCountAfter * sizeof(GridVertex));
+		DX_CHECK(GetTriangleSet(indices, vertices, sizeof(GridVertex)) == trianglesBefore);
+
+		DX_CHECK(report.before.acmr == 3.0f);
+		DX_CHECK(report.after.acmr < report.before.acmr);
+		DX_CHECK(report.after.acmr < 1.0f);
+		DX_CHECK(report.after.atvr < 1.5f);
+
+		const DX::VertexCacheStatistics statistics = DX::AnalyzeVertexCache(indices.data(), indices.size(), report.vertexCountAfter);
+		DX_CHECK(statistics.acmr == report.after.acmr && statistics.transformedVertexCount == report.after.transformedVertexCount);
+
+		// 임계값이 1이어도 삼각형 집합은 같습니다.
+		MakeShuffledGrid(size, 2, &indices, &vertices);
+		const auto otherBefore = GetTriangleSet(indices, vertices, sizeof(GridVertex));
+		DX::MeshOptimizationOptions options;
+		options.overdrawThreshold = 1.0f;
+		DX::OptimizeMesh(&indices, &vertices, sizeof(GridVertex), c_positionOffset, options);
+		DX_CHECK(GetTriangleSet(indices, vertices, sizeof(GridVertex)) == otherBefore);
+	}
+
+	// 바이트가 같은 꼭짓점은 같은 번호가 되고, 번호는 처음 참조된 순서이며, 참조되지 않은 꼭짓점은 UINT32_MAX입니다.
+	void TestGenerateVertexRemap()
+	{
+		const std::uint32_t vertices[] = { 5, 7, 5, 9, 7, 11 };
+		const std::uint32_t indices[] = { 3, 1, 0, 2, 4, 3 };
+		std::uint32_t remap[6];
+		DX_CHECK(DX::GenerateVertexRemap(remap, indices, 6, vertices, 6, sizeof(std::uint32_t)) == 3);
+		DX_CHECK(remap[3] == 0 && remap[1] == 1 && remap[4] == 1 && remap[0] == 2 && remap[2] == 2);
+		DX_CHECK(remap[5] == UINT32_MAX);
+
+		std::uint32_t remapped[6];
+		DX::RemapIndices(remapped, indices, 6, remap);
+		DX_CHECK(remapped[0] == 0 && remapped[1] == 1 && remapped[2] == 2 && remapped[3] == 2 && remapped[4] == 1 && remapped[5] == 0);
+		std::uint32_t welded[3];
+		DX::RemapVertices(welded, vertices, 6, sizeof(std::uint32_t), remap);
+		DX_CHECK(welded[0] == 9 && welded[1] == 7 && welded[2] == 5);
+
+		// 인덱스가 없으면 모든 꼭짓점을 꼭짓점 순서로 번호 매깁니다.
+		DX_CHECK(DX::GenerateVertexRemap(remap, nullptr, 0, vertices, 6, sizeof(std::uint32_t)) == 4);
+		DX_CHECK(remap[0] == 0 && remap[1] == 1 && remap[2] == 0 && remap[3] == 2 && remap[4] == 1 && remap[5] == 3);
+	}
+
+	// 가져오기 순서는 꼭짓점을 처음 참조된 순서로 옮기고, 참조되지 않은 꼭짓점을 버립니다.
+	void TestOptimizeVertexFetch()
+	{
+		const std::uint32_t vertices[] = { 10, 11, 12, 13, 14, 15 };
+		std::uint32_t indices[] = { 4, 2, 0, 0, 2, 5 };
+		std::uint32_t fetched[6] = {};
+		DX_CHECK(DX::OptimizeVertexFetch(fetched, indices, 6, vertices, 6, sizeof(std::uint32_t)) == 4);
+		DX_CHECK(fetched[0] == 14 && fetched[1] == 12 && fetched[2] == 10 && fetched[3] == 15);
+		DX_CHECK(indices[0] == 0 && indices[1] == 1 && indices[2] == 2 && indices[3] == 2 && indices[4] == 1 && indices[5] == 3);
+	}
+
+	// 삼각형 목록이 아니거나 범위 밖의 인덱스가 있으면 모든 단계가 예외를 발생시킵니다.
+	void TestInvalidIndices()
+	{
+		const float positions[4][3] = {};
+		const std::uint32_t partial[] = { 0, 1, 2, 3 };
+		const std::uint32_t outOfRange[] = { 0, 1, 4 };
+		std::uint32_t destination[4];
+		std::uint32_t remap[4];
+		float fetched[4][3];
+
+		DX_CHECK(Throws([&]() { DX::AnalyzeVertexCache(partial, 4, 4); }));
+		DX_CHECK(Throws([&]() { DX::AnalyzeVertexCache(outOfRange, 3, 4); }));
+		DX_CHECK(Throws([&]() { DX::GenerateVertexRemap(remap, partial, 4, positions, 4, sizeof(positions[0])); }));
+		DX_CHECK(Throws([&]() { DX::GenerateVertexRemap(remap, outOfRange, 3, positions, 4, sizeof(positions[0])); }));
+		DX_CHECK(Throws([&]() { DX::OptimizeVertexCache(destination, partial, 4, 4); }));
+		DX_CHECK(Throws([&]() { DX::OptimizeVertexCache(destination, outOfRange, 3, 4); }));
+		DX_CHECK(Throws([&]() { DX::OptimizeOverdraw(destination, partial, 4, positions[0], 4, sizeof(positions[0]), 1.05f); }));
+		DX_CHECK(Throws([&]() { DX::OptimizeOverdraw(destination, outOfRange, 3, positions[0], 4, sizeof(positions[0]), 1.05f); }));
+		std::uint32_t fetchIndices[] = { 0, 1, 4 };
+		DX_CHECK(Throws([&]() { DX::OptimizeVertexFetch(fetched, fetchIndices, 3, positions, 4, sizeof(positions[0])); }));
+
+		std::vector<std::uint32_t> meshIndices(partial, partial + 4);
+		std::vector<std::uint8_t> meshVertices(sizeof(positions));
+		DX_CHECK(Throws([&]() { DX::OptimizeMesh(&meshIndices, &meshVertices, sizeof(positions[0]), 0); }));
+
+		// 위치가 꼭짓점 밖에 있거나 꼭짓점 버퍼가 보폭의 배수가 아니어도 실패합니다.
+		meshIndices.assign(outOfRange, outOfRange + 2);
+		meshIndices.push_back(3);
+		DX_CHECK(Throws([&]() { DX::OptimizeMesh(&meshIndices, &meshVertices, sizeof(positions[0]), 4); }));
+		meshVertices.resize(sizeof(positions) + 1);
+		DX_CHECK(Throws([&]() { DX::OptimizeMesh(&meshIndices, &meshVertices, sizeof(positions[0]), 0); }));
+		DX_CHECK(!Throws([&]() { DX::AnalyzeVertexCache(outOfRange, 3, 5); }));
+	}
+
+	// 삼각형이 두 개보다 적으면 오버드로 정렬은 그대로 복사합니다. 여러 삼각형도 같은 삼각형의 순열입니다.
+	void TestOptimizeOverdraw()
+	{
+		const float positions[4][3] = { { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 1.0f, 1.0f, 1.0f } };
+		const std::uint32_t single[] = { 2, 0, 1 };
+		std::uint32_t destination[6] = { 9, 9, 9, 9, 9, 9 };
+		DX::OptimizeOverdraw(destination, single, 3, positions[0], 4, sizeof(positions[0]), 1.05f);
+		DX_CHECK(destination[0] == 2 && destination[1] == 0 && destination[2] == 1 && destination[3] == 9);
+
+		DX::OptimizeOverdraw(destination, single, 0, positions[0], 4, sizeof(positions[0]), 1.05f);
+		DX_CHECK(destination[0] == 2 && destination[3] == 9);
+
+		std::vector<std::uint32_t> indices;
+		std::vector<std::uint8_t> vertices;
+		MakeShuffledGrid(16, 3, &indices, &vertices);
+		std::vector<std::uint32_t> sorted(indices.size());
+		const float* gridPositions = reinterpret_cast<const float*>(vertices.data() + c_positionOffset);
+		const std::size_t vertexCount = vertices.size() / sizeof(GridVertex);
+		DX::OptimizeOverdraw(sorted.data(), indices.data(), indices.size(), gridPositions, vertexCount, sizeof(GridVertex), 1.05f);
+		DX_CHECK(GetTriangleSet(sorted, vertices, sizeof(GridVertex)) == GetTriangleSet(indices, vertices, sizeof(GridVertex)));
+	}
+}
+
+int main()
+{
+	TestOptimizeMesh();
+	TestGenerateVertexRemap();
+	TestOptimizeVertexFetch();
+	TestInvalidIndices();
+	TestOptimizeOverdraw();
+	return DX::Test::Finish("MeshOptimizerTests");
+}
@@ -0,0 +1,308 @@
+﻿// MipChain의 정확도 검사와 벤치마크입니다.
+// 2의 거듭제곱 크기에서 상자 필터 레벨 L은 0레벨의 2^L x 2^L 구역 평균과 같으므로, 배정밀도 기준 구현과 비교합니다.
+// Linux에서는 표준 라이브러리만 사용합니다. Windows에서는 ThrowIfFailed 때문에 헤드리스 D3D12 헤더를 함께 씁니다.
+//
+//	g++ -std=c++14 -O2 -pthread -I Tests -o MipChainBenchmark Tests/MipChainBenchmark.cpp Common/MipChain.cpp Common/ProceduralTexture.cpp
+//	cl /std:c++14 /O2 /EHsc /DDX_HEADLESS_D3D12 /I Tests Tests\MipChainBenchmark.cpp Common\MipChain.cpp Common\ProceduralTexture.cpp
+
+#include "pch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include "TestHarness.h"
+#include "../Common/MipChain.h"
+#include "../Common/ProceduralTexture.h"
+
+namespace
+{
+	double DecodeSrgb(double value)
+	{
+		return value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+	}
+
+	double EncodeSrgb(double value)
+	{
+		return value <= 0.0031308 ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055;
+	}
+
+	// 무작위이지만 결정적인 RGBA8 이미지입니다.
+	std::vector<std::uint8_t> MakeRandomImage(std::uint32_t width, std::uint32_t height, std::uint32_t seed)
+	{
+		std::vector<std::uint8_t> image(static_cast<std::size_t>(width) * height * 4);
+		std::uint32_t state = seed;
+		for (auto& value : image)
+		{
+			state = state * 1664525u + 1013904223u;
+			value = static_cast<std::uint8_t>(state >> 24);
+		}
+		return image;
+	}
+
+	// 0레벨의 blockSize x blockSize 구역을 (선형 공간에서) 평균한 채널 값입니다.
+	std::uint8_t ReferenceBoxTexel(const std::vector<std::uint8_t>& image, std::uint32_t width, std::uint32_t x, std::uint32_t y, std::uint32_t blockSize, std::uint32_t channel, bool srgb)
+	{
+		const bool decode = srgb && channel < 3;
+		double sum = 0.0;
+		for (std::uint32_t sy = y * blockSize; sy < (y + 1) * blockSize; sy++)
+		{
+			for (std::uint32_t sx = x * blockSize; sx < (x + 1) * blockSize; sx++)
+			{
+				const double value = image[(static_cast<std::size_t>(sy) * width + sx) * 4 + channel] / 255.0;
+				sum += decode ? DecodeSrgb(value) : value;
+			}
+		}
+
+		const double average = sum / (static_cast<double>(blockSize) * blockSize);
+		const double encoded = decode ? EncodeSrgb(average) : average;
+		return static_cast<std::uint8_t>(std::floor(encoded * 255.0 + 0.5));
+	}
+
+	// 상자 필터의 모든 레벨은 기준 평균과 최대 1만큼만 다릅니다.
+	void TestBoxMatchesReference()
+	{
+		const std::uint32_t size = 64;
+		const std::vector<std::uint8_t> image = MakeRandomImage(size, size, 1);
+
+		for (int srgb = 0; srgb < 2; srgb++)
+		{
+			DX::MipGenerationOptions options;
+			options.filter = DX::MipFilter::Box;
+			options.srgb = srgb != 0;
+			DX::MipChain chain(image.data(), size, size, size * 4, options);
+			DX_CHECK(chain.GetLevelCount() == 7);
+
+			int maxError = 0;
+			for (std::uint32_t level = 0; level < chain.GetLevelCount(); level++)
+			{
+				const DX::MipLevel& mip = chain.GetLevel(level);
+				DX_CHECK(mip.width == size >> level && mip.height == size >> level && mip.rowPitch == mip.width * 4);
+				for (std::uint32_t y = 0; y < mip.height; y++)
+				{
+					for (std::uint32_t x = 0; x < mip.width; x++)
+					{
+						for (std::uint32_t channel = 0; channel < 4; channel++)
+						{
+							const int expected = ReferenceBoxTexel(image, size, x, y, 1u << level, channel, options.srgb);
+							const int actual = mip.data[y * mip.rowPitch + x * 4 + channel];
+							maxError = (std::max)(maxError, std::abs(actual - expected));
+						}
+					}
+				}
+			}
+			DX_CHECK(maxError <= 1);
+		}
+	}
+
+	// 선형 상자 필터의 고정 소수점 경로는 모든 레벨에서 부동 소수점 경로와 최대 1만큼만 다릅니다.
+	// 홀수 너비(스칼라 끝 처리), 정사각형이 아닌 크기(한 축이 1이 되면 부동 소수점 경로로 넘어감)와 홀수 크기(처음부터 부동 소수점 경로)를 포함합니다.
+	void TestFixedPointBoxMatchesFloat()
+	{
+		const std::uint32_t sizes[][2] = { { 256, 256 }, { 6, 6 }, { 512, 8 }, { 4, 64 }, { 200, 120 }, { 37, 21 } };
+		std::size_t differences = 0;
+		std::size_t total = 0;
+		for (const auto& size : sizes)
+		{
+			const std::uint32_t width = size[0];
+			const std::uint32_t height = size[1];
+			const std::vector<std::uint8_t> image = MakeRandomImage(width, height, width * 31 + height);
+
+			for (int wrap = 0; wrap < 2; wrap++)
+			{
+				DX::MipGenerationOptions options;
+				options.filter = DX::MipFilter::Box;
+				options.srgb = false;
+				options.wrap = wrap != 0;
+				const DX::MipChain fixedChain(image.data(), width, height, width * 4, options);
+				options.fixedPointBox = false;
+				const DX::MipChain floatChain(image.data(), width, height, width * 4, options);
+				DX_CHECK(fixedChain.GetLevelCount() == floatChain.GetLevelCount());
+
+				int maxError = 0;
+				for (std::uint32_t level = 0; level < fixedChain.GetLevelCount(); level++)
+				{
+					const DX::MipLevel& fixedMip = fixedChain.GetLevel(level);
+					const DX::MipLevel& floatMip = floatChain.GetLevel(level);
+					DX_CHECK(fixedMip.slicePitch == floatMip.slicePitch);
+					for (std::size_t i = 0; i < fixedMip.slicePitch; i++)
+					{
+						const int error = std::abs(fixedMip.data[i] - floatMip.data[i]);
+						maxError = (std::max)(maxError, error);
+						differences += error != 0 ? 1 : 0;
+					}
+					total += fixedMip.slicePitch;
+				}
+				DX_CHECK(maxError <= 1);
+			}
+		}
+		std::printf("고정 소수점 상자 필터: 부동 소수점 경로와 다른 값 %zu / %zu\n", differences, total);
+	}
+
+	// 단색 이미지는 모든 필터, 색 공간, 가장자리 처리에서 모든 레벨이 같은 색입니다. 홀수 크기도 포함합니다.
+	void TestConstantImage()
+	{
+		const std::uint32_t width = 37;
+		const std::uint32_t height = 21;
+		std::vector<std::uint8_t> image(width * height * 4);
+		for (std::size_t i = 0; i < image.size(); i += 4)
+		{
+			image[i] = 10;
+			image[i + 1] = 128;
+			image[i + 2] = 250;
+			image[i + 3] = 77;
+		}
+
+		const DX::MipFilter filters[] = { DX::MipFilter::Box, DX::MipFilter::Kaiser, DX::MipFilter::Lanczos };
+		for (DX::MipFilter filter : filters)
+		{
+			for (int flags = 0; flags < 4; flags++)
+			{
+				DX::MipGenerationOptions options;
+				options.filter = filter;
+				options.srgb = (flags & 1) != 0;
+				options.wrap = (flags & 2) != 0;
+				DX::MipChain chain(image.data(), width, height, width * 4, options);
+				DX_CHECK(chain.GetLevelCount() == 6);
+
+				bool constant = true;
+				for (std::uint32_t level = 0; level < chain.GetLevelCount(); level++)
+				{
+					const DX::MipLevel& mip = chain.GetLevel(level);
+					for (std::size_t i = 0; i < mip.slicePitch; i += 4)
+					{
+						constant = constant && mip.data[i] == 10 && mip.data[i + 1] == 128 && mip.data[i + 2] == 250 && mip.data[i + 3] == 77;
+					}
+				}
+				DX_CHECK(constant);
+			}
+		}
+	}
+
+	// 모든 8비트 값은 sRGB 디코딩과 인코딩을 거쳐도 그대로입니다.
+	void TestSrgbRoundTrip()
+	{
+		bool exact = true;
+		for (int value = 0; value < 256; value++)
+		{
+			const std::vector<std::uint8_t> image(4 * 4 * 4, static_cast<std::uint8_t>(value));
+			DX::MipChain chain(image.data(), 4, 4, 16);
+			exact = exact && chain.GetLevel(2).data[0] == value && chain.GetLevel(2).data[3] == value;
+		}
+		DX_CHECK(exact);
+	}
+
+	// 알파 적용 범위를 유지하면 모든 레벨에서 기준값을 넘는 픽셀 비율이 0레벨과 가깝습니다.
+	void TestAlphaCoverage()
+	{
+		const std::uint32_t size = 256;
+		std::vector<std::uint8_t> image(size * size * 4);
+		const DX::TextureDestination destination = { image.data(), size, size, size * 4 };
+		DX::GenerateValueNoise(destination, 32, 4, 7, DX::MakeRgba8(0, 0, 0, 0), DX::MakeRgba8(255, 255, 255, 255));
+		for (std::size_t i = 3; i < image.size(); i += 4)
+		{
+			image[i] = static_cast<std::uint8_t>((std::min)(255, (std::max)(0, (image[i] - 128) * 3 + 128)));
+		}
+
+		auto coverage = [](const DX::MipLevel& mip)
+		{
+			std::size_t covered = 0;
+			for (std::size_t i = 3; i < mip.slicePitch; i += 4)
+			{
+				covered += mip.data[i] > 127 ? 1 : 0;
+			}
+			return static_cast<double>(covered) / (mip.width * mip.height);
+		};
+
+		DX::MipGenerationOptions options;
+		options.filter = DX::MipFilter::Kaiser;
+		options.alphaCoverageReference = 0.5f;
+		options.maxLevelCount = 6;		// 32x32 레벨까지만 비교합니다. 그보다 작으면 비율의 해상도가 너무 낮습니다.
+		DX::MipChain chain(image.data(), size, size, size * 4, options);
+		DX_CHECK(chain.GetLevelCount() == 6);
+
+		const double reference = coverage(chain.GetLevel(0));
+		for (std::uint32_t level = 1; level < chain.GetLevelCount(); level++)
+		{
+			DX_CHECK(std::fabs(coverage(chain.GetLevel(level)) - reference) < 0.02);
+		}
+	}
+
+	// 2의 거듭제곱이 아닌 크기는 레벨마다 내림하며, 잘못된 원본은 예외를 발생시킵니다.
+	void TestLevelSizesAndErrors()
+	{
+		DX_CHECK(DX::GetMipLevelCount(1, 1) == 1);
+		DX_CHECK(DX::GetMipLevelCount(5, 3) == 3);
+		DX_CHECK(DX::GetMipLevelCount(4096, 16) == 13);
+
+		const std::vector<std::uint8_t> image(5 * 3 * 4, 50);
+		DX::MipChain chain(image.data(), 5, 3, 20);
+		DX_CHECK(chain.GetLevelCount() == 3);
+		DX_CHECK(chain.GetLevel(1).width == 2 && chain.GetLevel(1).height == 1);
+		DX_CHECK(chain.GetLevel(2).width == 1 && chain.GetLevel(2).height == 1);
+
+		bool threw = false;
+		try
+		{
+			DX::MipChain invalid(nullptr, 1, 1, 4);
+		}
+		catch (const std::exception&)
+		{
+			threw = true;
+		}
+		DX_CHECK(threw);
+	}
+
+	// 4096 x 4096 노이즈 텍스처의 전체 체인을 필터마다 만드는 시간과 원본 처리량입니다.
+	// 선형 상자 필터는 고정 소수점 경로와 부동 소수점 경로를 함께 재며, 고정 소수점 경로가 더 빨라야 합니다.
+	void BenchmarkFilters()
+	{
+		const std::uint32_t size = 4096;
+		std::vector<std::uint8_t> image(static_cast<std::size_t>(size) * size * 4);
+		const DX::TextureDestination destination = { image.data(), size, size, size * 4 };
+		DX::GenerateValueNoise(destination, 64, 5, 1, DX::MakeRgba8(0, 0, 0), DX::MakeRgba8(255, 255, 255));
+
+		const DX::MipFilter filters[] = { DX::MipFilter::Box, DX::MipFilter::Kaiser, DX::MipFilter::Lanczos };
+		const char* const filterNames[] = { "Box", "Kaiser", "Lanczos" };
+		for (int f = 0; f < 3; f++)
+		{
+			for (int srgb = 0; srgb < 2; srgb++)
+			{
+				DX::MipGenerationOptions options;
+				options.filter = filters[f];
+				options.srgb = srgb != 0;
+				const double seconds = DX::Test::MeasureBestSeconds(3, [&]()
+				{
+					DX::MipChain chain(image.data(), size, size, size * 4, options);
+				});
+				std::printf("%-7s %-4s %u x %u: %7.1f ms, 원본 %5.2f GB/s\n",
+					filterNames[f], srgb != 0 ? "sRGB" : "선형", size, size, seconds * 1e3, image.size() / seconds / 1e9);
+
+				if (filters[f] == DX::MipFilter::Box && srgb == 0)
+				{
+					options.fixedPointBox = false;
+					const double floatSeconds = DX::Test::MeasureBestSeconds(3, [&]()
+					{
+						DX::MipChain chain(image.data(), size, size, size * 4, options);
+					});
+					std::printf("%-7s %-4s %u x %u: %7.1f ms, 원본 %5.2f GB/s (부동 소수점 경로)\n",
+						filterNames[f], "선형", size, size, floatSeconds * 1e3, image.size() / floatSeconds / 1e9);
+					DX_CHECK(seconds < floatSeconds);
+				}
+			}
+		}
+	}
+}
+
+int main()
+{
+	TestBoxMatchesReference();
+	TestFixedPointBoxMatchesFloat();
+	TestConstantImage();
+	TestSrgbRoundTrip();
+	TestAlphaCoverage();
+	TestLevelSizesAndErrors();
+	BenchmarkFilters();
+	return DX::Test::Finish("MipChainBenchmark");
+}
@@ -0,0 +1,382 @@
+﻿// 압축 꼭짓점 변환기의 왕복 정확도 검사와 처리량(백만 꼭짓점/s) 벤치마크입니다.
+// SIMD 변환 결과는 같은 부동소수점 연산을 꼭짓점마다 하는 스칼라 변환과 비트 단위로 비교합니다.
+// 표준 라이브러리만 사용하므로 Windows와 Linux에서 모두 빌드됩니다.
+//
+//	g++ -std=c++14 -O2 -pthread -I Tests -o PackedVertexBenchmark Tests/PackedVertexBenchmark.cpp Common/PackedVertex.cpp
+//	cl /std:c++14 /O2 /EHsc /DDX_HEADLESS_D3D12 /I Tests Tests\PackedVertexBenchmark.cpp Common\PackedVertex.cpp
+
+#include "pch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include "TestHarness.h"
+#include "../Common/PackedVertex.h"
+
+namespace
+{
+	const float c_snorm16Max = 32767.0f;
+
+	// 가져온 메시의 꼭짓점처럼 여러 속성이 섞인 원본 꼭짓점입니다(44바이트).
+	struct SourceVertex
+	{
+		float	position[3];
+		float	color[3];
+		float	texCoord[2];
+		float	normal[3];
+	};
+
+	float BitsToFloat(std::uint32_t bits)
+	{
+		float value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	// 가장 가까운 짝수로 반올림합니다. 기본 반올림 모드의 nearbyint와 같습니다.
+	std::int32_t RoundEven(float value)
+	{
+		return static_cast<std::int32_t>(std::nearbyint(value));
+	}
+
+	float Clamp(float value, float low, float high)
+	{
+		return (std::min)((std::max)(value, low), high);
+	}
+
+	// 변환기와 같은 식을 꼭짓점마다 계산하는 스칼라 변환입니다. 벤치마크의 비교 대상이기도 합니다.
+	void PackScalar(const SourceVertex* source, std::size_t count, const DX::PositionQuantization& quantization, DX::PackedVertexPositionColorTexture* destination)
+	{
+		float inverseScale[3];
+		for (int c = 0; c < 3; c++)
+		{
+			inverseScale[c] = c_snorm16Max / quantization.scale[c];
+		}
+
+		for (std::size_t i = 0; i < count; i++)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				destination[i].position[c] = static_cast<std::int16_t>(RoundEven(Clamp((source[i].position[c] - quantization.bias[c]) * inverseScale[c], -c_snorm16Max, c_snorm16Max)));
+			}
+			destination[i].position[3] = 32767;
+
+			std::uint32_t color = 0xff000000u;
+			for (int c = 0; c < 3; c++)
+			{
+				color |= static_cast<std::uint32_t>(RoundEven(Clamp(source[i].color[c], 0.0f, 1.0f) * 255.0f)) << (8 * c);
+			}
+			destination[i].color = color;
+
+			destination[i].texCoord[0] = DX::FloatToHalf(source[i].texCoord[0]);
+			destination[i].texCoord[1] = DX::FloatToHalf(source[i].texCoord[1]);
+		}
+	}
+
+	void PackNormalScalar(const float normal[3], std::int16_t encoded[2])
+	{
+		const float norm = (std::max)(std::fabs(normal[0]) + std::fabs(normal[1]) + std::fabs(normal[2]), 1e-20f);
+		float x = normal[0] / norm;
+		float y = normal[1] / norm;
+		if (normal[2] < 0.0f)
+		{
+			const float foldedX = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+			const float foldedY = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+			x = foldedX;
+			y = foldedY;
+		}
+		encoded[0] = static_cast<std::int16_t>(RoundEven(Clamp(x, -1.0f, 1.0f) * c_snorm16Max));
+		encoded[1] = static_cast<std::int16_t>(RoundEven(Clamp(y, -1.0f, 1.0f) * c_snorm16Max));
+	}
+
+	std::vector<SourceVertex> MakeVertices(std::size_t count, std::uint32_t seed)
+	{
+		std::mt19937 random(seed);
+		std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		std::vector<SourceVertex> vertices(count);
+		for (SourceVertex& vertex : vertices)
+		{
+			vertex.position[0] = unit(random) * 10.0f + 3.0f;
+			vertex.position[1] = unit(random) * 2.0f;
+			vertex.position[2] = unit(random) * 50.0f - 7.0f;
+			for (int c = 0; c < 3; c++)
+			{
+				vertex.color[c] = (unit(random) + 1.0f) * 0.5f;
+			}
+			vertex.texCoord[0] = (unit(random) + 1.0f) * 2.0f;
+			vertex.texCoord[1] = (unit(random) + 1.0f) * 0.5f;
+
+			float length = 0.0f;
+			do
+			{
+				for (int c = 0; c < 3; c++)
+				{
+					vertex.normal[c] = unit(random);
+				}
+				length = std::sqrt(vertex.normal[0] * vertex.normal[0] + vertex.normal[1] * vertex.normal[1] + vertex.normal[2] * vertex.normal[2]);
+			} while (length < 1e-3f);
+			for (int c = 0; c < 3; c++)
+			{
+				vertex.normal[c] /= length;
+			}
+		}
+		return vertices;
+	}
+
+	void PackPositionColorTexture(const std::vector<SourceVertex>& source, const DX::PositionQuantization& quantization, DX::PackedVertexPositionColorTexture* destination)
+	{
+		const std::size_t stride = sizeof(SourceVertex);
+		DX::PackPositions(source[0].position, stride, source.size(), quantization, destination->position, sizeof(*destination));
+		DX::PackColors(source[0].color, stride, 3, source.size(), &destination->color, sizeof(*destination));
+		DX::PackTexCoords(source[0].texCoord, stride, source.size(), destination->texCoord, sizeof(*destination));
+	}
+
+	// NaN을 뺀 모든 half는 float를 거쳐 같은 비트로 돌아옵니다.
+	void TestHalfRoundTrip()
+	{
+		for (std::uint32_t half = 0; half < 0x10000; half++)
+		{
+			const bool isNaN = ((half >> 10) & 0x1f) == 0x1f && (half & 0x3ff) != 0;
+			if (!isNaN)
+			{
+				DX_CHECK(DX::FloatToHalf(DX::HalfToFloat(static_cast<std::uint16_t>(half))) == half);
+			}
+		}
+	}
+
+	// 반올림은 가장 가까운 짝수이고, 범위를 넘으면 무한대, NaN은 조용한 NaN입니다.
+	void TestHalfRounding()
+	{
+		DX_CHECK(DX::FloatToHalf(1.0f + std::ldexp(1.0f, -11)) == 0x3c00);		// 1과 다음 half 사이의 중간값은 짝수 쪽입니다.
+		DX_CHECK(DX::FloatToHalf(1.0f + 3.0f * std::ldexp(1.0f, -11)) == 0x3c02);
+		DX_CHECK(DX::FloatToHalf(-2.0f) == 0xc000);
+		DX_CHECK(DX::FloatToHalf(65504.0f) == 0x7bff);
+		DX_CHECK(DX::FloatToHalf(65519.0f) == 0x7bff);
+		DX_CHECK(DX::FloatToHalf(65520.0f) == 0x7c00);
+		DX_CHECK(DX::FloatToHalf(-1e10f) == 0xfc00);
+		DX_CHECK(DX::FloatToHalf(BitsToFloat(0x7fc00001u)) == 0x7e00);
+		DX_CHECK(DX::FloatToHalf(std::ldexp(1.0f, -25)) == 0x0000);				// 가장 작은 비정규 수의 절반도 짝수 쪽입니다.
+		DX_CHECK(DX::FloatToHalf(3.0f * std::ldexp(1.0f, -26)) == 0x0001);
+		DX_CHECK(DX::FloatToHalf(std::ldexp(1.0f, -14)) == 0x0400);
+
+		// 표현 범위 안의 값은 가장 가까운 half와의 차이가 반 ulp 이하입니다.
+		std::mt19937 random(7);
+		for (int i = 0; i < 100000; i++)
+		{
+			const float value = std::ldexp(static_cast<float>(random() % 2000000) / 1e6f - 1.0f, static_cast<int>(random() % 40) - 24);
+			const std::uint16_t half = DX::FloatToHalf(value);
+			const float decoded = DX::HalfToFloat(half);
+			const float neighbour = DX::HalfToFloat(static_cast<std::uint16_t>((half & 0x7fff) == 0 ? 1 : half + (std::fabs(decoded) < std::fabs(value) ? 1 : -1)));
+			DX_CHECK(std::fabs(decoded - value) <= std::fabs(neighbour - value));
+		}
+	}
+
+	// SIMD 변환은 스칼라 변환과 비트 단위로 같습니다. 네 개로 나누어떨어지지 않는 끝과 여러 스레드로 나뉘는 크기를 모두 씁니다.
+	void TestMatchesScalar()
+	{
+		const std::size_t counts[] = { 1, 3, 4, 5, 1023, 300001 };
+		for (std::size_t count : counts)
+		{
+			const std::vector<SourceVertex> source = MakeVertices(count, static_cast<std::uint32_t>(count));
+			const DX::PositionQuantization quantization = DX::ComputePositionQuantization(source[0].position, sizeof(SourceVertex), count);
+
+			std::vector<DX::PackedVertexPositionColorTexture> expected(count);
+			std::vector<DX::PackedVertexPositionColorTexture> actual(count);
+			PackScalar(source.data(), count, quantization, expected.data());
+			PackPositionColorTexture(source, quantization, actual.data());
+			DX_CHECK(std::memcmp(expected.data(), actual.data(), count * sizeof(actual[0])) == 0);
+
+			std::vector<DX::PackedVertexPositionNormalTexture> normals(count);
+			DX::PackNormals(source[0].normal, sizeof(SourceVertex), count, normals[0].normal, sizeof(normals[0]));
+			std::size_t mismatches = 0;
+			for (std::size_t i = 0; i < count; i++)
+			{
+				std::int16_t encoded[2];
+				PackNormalScalar(source[i].normal, encoded);
+				mismatches += encoded[0] != normals[i].normal[0] || encoded[1] != normals[i].normal[1];
+			}
+			DX_CHECK(mismatches == 0);
+		}
+
+		// 무작위 비트 패턴(무한대, NaN, 비정규 수 포함)의 텍스처 좌표도 스칼라 FloatToHalf와 같습니다.
+		std::mt19937 random(11);
+		std::vector<float> texCoords(2 * 100003);
+		for (float& value : texCoords)
+		{
+			value = BitsToFloat(static_cast<std::uint32_t>(random()));
+		}
+		std::vector<std::uint16_t> halves(texCoords.size());
+		DX::PackTexCoords(texCoords.data(), sizeof(float) * 2, texCoords.size() / 2, halves.data(), sizeof(std::uint16_t) * 2);
+		std::size_t mismatches = 0;
+		for (std::size_t i = 0; i < texCoords.size(); i++)
+		{
+			mismatches += halves[i] != DX::FloatToHalf(texCoords[i]);
+		}
+		DX_CHECK(mismatches == 0);
+	}
+
+	// 위치는 경계 상자 크기의 1/65534 이내로, 색은 1/510 이내로, 법선은 0.01도 이내로 돌아옵니다.
+	void TestRoundTripAccuracy()
+	{
+		const std::size_t count = 100000;
+		const std::vector<SourceVertex> source = MakeVertices(count, 3);
+		const DX::PositionQuantization quantization = DX::ComputePositionQuantization(source[0].position, sizeof(SourceVertex), count);
+
+		std::vector<DX::PackedVertexPositionColorTexture> packed(count);
+		PackPositionColorTexture(source, quantization, packed.data());
+		std::vector<DX::PackedVertexPositionNormalTexture> normals(count);
+		DX::PackNormals(source[0].normal, sizeof(SourceVertex), count, normals[0].normal, sizeof(normals[0]));
+
+		double positionError = 0.0;
+		double colorError = 0.0;
+		double texCoordError = 0.0;
+		double normalError = 0.0;
+		for (std::size_t i = 0; i < count; i++)
+		{
+			DX_CHECK(packed[i].position[3] == 32767 && (packed[i].color >> 24) == 0xff);
+			for (int c = 0; c < 3; c++)
+			{
+				const double decoded = (std::max)(packed[i].position[c] / 32767.0, -1.0) * quantization.scale[c] + quantization.bias[c];
+				positionError = (std::max)(positionError, std::fabs(decoded - source[i].position[c]) / (2.0 * quantization.scale[c]));
+				colorError = (std::max)(colorError, std::fabs(((packed[i].color >> (8 * c)) & 0xff) / 255.0 - source[i].color[c]));
+			}
+			for (int c = 0; c < 2; c++)
+			{
+				const double error = std::fabs(DX::HalfToFloat(packed[i].texCoord[c]) - source[i].texCoord[c]) / (std::max)(std::fabs(source[i].texCoord[c]), 1e-3f);
+				texCoordError = (std::max)(texCoordError, error);
+			}
+
+			float normal[3];
+			DX::DecodeOctahedralNormal(normals[i].normal, normal);
+			// 작은 각은 acos로 재면 반올림 오차가 커지므로 외적의 길이와 내적으로 잽니다.
+			const double n[3] = { normal[0], normal[1], normal[2] };
+			const double b[3] = { source[i].normal[0], source[i].normal[1], source[i].normal[2] };
+			const double cross[3] = { n[1] * b[2] - n[2] * b[1], n[2] * b[0] - n[0] * b[2], n[0] * b[1] - n[1] * b[0] };
+			const double sine = std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+			const double cosine = n[0] * b[0] + n[1] * b[1] + n[2] * b[2];
+			normalError = (std::max)(normalError, std::atan2(sine, cosine) * 180.0 / 3.14159265358979323846);
+		}
+
+		std::printf("왕복 오차: 위치 %.3g(경계 상자 대비), 색 %.3g, 텍스처 좌표 %.3g(상대), 법선 %.4f도\n", positionError, colorError, texCoordError, normalError);
+		DX_CHECK(positionError <= 1.0 / 65534.0 + 1e-6);
+		DX_CHECK(colorError <= 0.5 / 255.0 + 1e-6);
+		DX_CHECK(texCoordError <= std::ldexp(1.0, -11) + 1e-6);
+		DX_CHECK(normalError < 0.01);
+	}
+
+	// 범위 밖의 색은 잘리고, RGBA는 알파를 그대로 쓰며, 크기가 0인 축과 길이가 0인 법선도 정의된 값이 됩니다.
+	void TestEdgeCases()
+	{
+		const float colors[] = { -0.5f, 1.5f, 0.5f, 0.25f };
+		std::uint32_t packed = 0;
+		DX::PackColors(colors, sizeof(colors), 4, 1, &packed, sizeof(packed));
+		DX_CHECK(packed == (0x00u | (0xffu << 8) | (0x80u << 16) | (0x40u << 24)));
+		DX::PackColors(colors, sizeof(colors), 3, 1, &packed, sizeof(packed));
+		DX_CHECK((packed >> 24) == 0xff);
+
+		const float flat[] = { 1.0f, 5.0f, 2.0f, 3.0f, 5.0f, 2.0f };
+		const DX::PositionQuantization quantization = DX::ComputePositionQuantization(flat, sizeof(float) * 3, 2);
+		DX_CHECK(quantization.scale[0] == 1.0f && quantization.bias[0] == 2.0f);
+		DX_CHECK(quantization.scale[1] == 1.0f && quantization.bias[1] == 5.0f);
+		std::int16_t positions[2][4];
+		DX::PackPositions(flat, sizeof(float) * 3, 2, quantization, positions, sizeof(positions[0]));
+		DX_CHECK(positions[0][0] == -32767 && positions[1][0] == 32767 && positions[0][1] == 0 && positions[1][2] == 0);
+
+		const DX::PositionQuantization identity = DX::ComputePositionQuantization(nullptr, 0, 0);
+		DX_CHECK(identity.scale[2] == 1.0f && identity.bias[2] == 0.0f);
+
+		// 길이가 0인 법선은 +z로 펼쳐집니다.
+		const float normals[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, { -1.0f, 0.0f, 0.0f } };
+		const float expected[3][3] = { { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f }, { -1.0f, 0.0f, 0.0f } };
+		std::int16_t encoded[3][2];
+		DX::PackNormals(normals[0], sizeof(normals[0]), 3, encoded, sizeof(encoded[0]));
+		for (int i = 0; i < 3; i++)
+		{
+			float normal[3];
+			DX::DecodeOctahedralNormal(encoded[i], normal);
+			for (int c = 0; c < 3; c++)
+			{
+				DX_CHECK(std::fabs(normal[c] - expected[i][c]) < 1e-4f);
+			}
+		}
+	}
+
+	// 변환기는 자기 필드만 씁니다. 같은 꼭짓점의 다른 필드와 마지막 꼭짓점 뒤는 그대로입니다.
+	void TestWritesOnlyItsField()
+	{
+		for (std::size_t count = 1; count <= 9; count++)
+		{
+			const std::vector<SourceVertex> source = MakeVertices(count, 100 + static_cast<std::uint32_t>(count));
+			std::vector<DX::PackedVertexPositionColorTexture> packed(count + 1);
+			std::memset(packed.data(), 0xcd, packed.size() * sizeof(packed[0]));
+
+			DX::PackColors(source[0].color, sizeof(SourceVertex), 3, count, &packed[0].color, sizeof(packed[0]));
+			bool untouched = true;
+			for (std::size_t i = 0; i < packed.size(); i++)
+			{
+				untouched &= packed[i].position[0] == static_cast<std::int16_t>(0xcdcd) && packed[i].texCoord[1] == 0xcdcd;
+				untouched &= i < count || packed[i].color == 0xcdcdcdcdu;
+			}
+			DX_CHECK(untouched);
+		}
+	}
+
+	// 캐시에 들어가는 16K 꼭짓점과 메모리에서 읽는 1M 꼭짓점을 위치+색+텍스처 좌표, 위치+법선+텍스처 좌표 형식으로 변환하는 처리량입니다.
+	// SIMD 변환은 속성마다 인터리브된 원본을 다시 읽으므로 큰 메시에서는 메모리 대역폭에 묶입니다.
+	// 캐시 안에서는 한 번에 모든 필드를 쓰는 스칼라 변환보다 빨라야 합니다. 꼭짓점 크기가 줄어드는 비율도 함께 출력합니다.
+	void BenchmarkPackers()
+	{
+		const std::size_t counts[] = { 16 * 1024, 1000000 };
+		const std::size_t stride = sizeof(SourceVertex);
+		for (std::size_t count : counts)
+		{
+			const int repeat = count <= 16 * 1024 ? 200 : 10;
+			const std::vector<SourceVertex> source = MakeVertices(count, 1);
+			const DX::PositionQuantization quantization = DX::ComputePositionQuantization(source[0].position, stride, count);
+			std::vector<DX::PackedVertexPositionColorTexture> colorTexture(count);
+			std::vector<DX::PackedVertexPositionNormalTexture> normalTexture(count);
+
+			const double boundsSeconds = DX::Test::MeasureBestSeconds(repeat, [&]()
+			{
+				volatile float scale = DX::ComputePositionQuantization(source[0].position, stride, count).scale[0];
+				(void)scale;
+			});
+			const double scalarSeconds = DX::Test::MeasureBestSeconds(repeat, [&]() { PackScalar(source.data(), count, quantization, colorTexture.data()); });
+			const double colorTextureSeconds = DX::Test::MeasureBestSeconds(repeat, [&]() { PackPositionColorTexture(source, quantization, colorTexture.data()); });
+			const double normalTextureSeconds = DX::Test::MeasureBestSeconds(repeat, [&]()
+			{
+				DX::PackPositions(source[0].position, stride, count, quantization, normalTexture[0].position, sizeof(normalTexture[0]));
+				DX::PackNormals(source[0].normal, stride, count, normalTexture[0].normal, sizeof(normalTexture[0]));
+				DX::PackTexCoords(source[0].texCoord, stride, count, normalTexture[0].texCoord, sizeof(normalTexture[0]));
+			});
+
+			std::printf("%7zu 꼭짓점: 경계 상자 %6.1f M/s, 스칼라(위치+색+UV) %6.1f M/s, SIMD(위치+색+UV) %6.1f M/s, SIMD(위치+법선+UV) %6.1f M/s\n",
+				count,
+				count / boundsSeconds / 1e6,
+				count / scalarSeconds / 1e6,
+				count / colorTextureSeconds / 1e6,
+				count / normalTextureSeconds / 1e6);
+			if (count <= 16 * 1024)
+			{
+				DX_CHECK(colorTextureSeconds < scalarSeconds);
+			}
+		}
+
+		std::printf("꼭짓점 크기: 위치+색 24 -> %zu바이트, 위치+색+UV 32 -> %zu바이트, 위치+법선+UV 32 -> %zu바이트\n",
+			sizeof(DX::PackedVertexPositionColor), sizeof(DX::PackedVertexPositionColorTexture), sizeof(DX::PackedVertexPositionNormalTexture));
+	}
+}
+
+int main()
+{
+	TestHalfRoundTrip();
+	TestHalfRounding();
+	TestMatchesScalar();
+	TestRoundTripAccuracy();
+	TestEdgeCases();
+	TestWritesOnlyItsField();
+	BenchmarkPackers();
+	return DX::Test::Finish("PackedVertexBenchmark");
+}
@@ -0,0 +1,211 @@
+﻿// 파이프라인 캐시 파일 형식과 PipelineHasher 검사입니다. 직렬화 왕복, 손상된 파일 거부와 해시 경계를 확인합니다.
+// 표준 라이브러리만 사용하므로 Windows와 Linux에서 모두 빌드됩니다.
+//
+//	g++ -std=c++14 -O2 -I Tests -o PipelineCacheFormatTests Tests/PipelineCacheFormatTests.cpp
+//	cl /std:c++14 /O2 /EHsc /I Tests Tests\PipelineCacheFormatTests.cpp
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "TestHarness.h"
+#include "../Common/PipelineCacheFormat.h"
+
+namespace
+{
+	const std::size_t c_headerSize = 4 * sizeof(std::uint32_t);
+	const std::size_t c_recordSize = 3 * sizeof(std::uint64_t);
+
+	// 빈 blob을 포함한 여러 항목입니다.
+	DX::PipelineCacheEntries MakeEntries()
+	{
+		DX::PipelineCacheEntries entries;
+		entries[0x0123456789abcdefull] = std::vector<std::uint8_t>{ 1, 2, 3, 4, 5 };
+		entries[42] = std::vector<std::uint8_t>();
+		entries[7] = std::vector<std::uint8_t>(1000, 0xab);
+		entries[~0ull] = std::vector<std::uint8_t>{ 9 };
+		return entries;
+	}
+
+	std::uint32_t ReadUint32(const std::vector<std::uint8_t>& file, std::size_t offset)
+	{
+		std::uint32_t value;
+		std::memcpy(&value, file.data() + offset, sizeof(value));
+		return value;
+	}
+
+	void WriteUint32(std::vector<std::uint8_t>* file, std::size_t offset, std::uint32_t value)
+	{
+		std::memcpy(file->data() + offset, &value, sizeof(value));
+	}
+
+	void WriteUint64(std::vector<std::uint8_t>* file, std::size_t offset, std::uint64_t value)
+	{
+		std::memcpy(file->data() + offset, &value, sizeof(value));
+	}
+
+	// 거부된 파일은 false를 반환하고, 이전 내용이 있던 entries도 비웁니다.
+	bool IsRejected(const std::vector<std::uint8_t>& file)
+	{
+		DX::PipelineCacheEntries entries = MakeEntries();
+		const bool parsed = DX::ParsePipelineCache(file.data(), file.size(), &entries);
+		return !parsed && entries.empty();
+	}
+
+	// 직렬화한 파일을 해석하면 같은 항목이 나오고, 목차와 데이터는 헤더에 적힌 배치를 따릅니다.
+	void TestRoundTrip()
+	{
+		const DX::PipelineCacheEntries entries = MakeEntries();
+		const std::vector<std::uint8_t> file = DX::SerializePipelineCache(entries);
+		DX_CHECK(file.size() == c_headerSize + entries.size() * c_recordSize + 5 + 0 + 1000 + 1);
+		DX_CHECK(ReadUint32(file, 0) == DX::c_pipelineCacheMagic);
+		DX_CHECK(ReadUint32(file, 4) == DX::c_pipelineCacheVersion);
+		DX_CHECK(ReadUint32(file, 8) == entries.size());
+
+		DX::PipelineCacheEntries parsed;
+		DX_CHECK(DX::ParsePipelineCache(file.data(), file.size(), &parsed));
+		DX_CHECK(parsed == entries);
+		DX_CHECK(parsed.count(42) == 1 && parsed[42].empty());
+
+		// 항목이 없는 파일은 헤더뿐이며 그대로 돌아옵니다.
+		const std::vector<std::uint8_t> empty = DX::SerializePipelineCache(DX::PipelineCacheEntries());
+		DX_CHECK(empty.size() == c_headerSize);
+		parsed = MakeEntries();
+		DX_CHECK(DX::ParsePipelineCache(empty.data(), empty.size(), &parsed));
+		DX_CHECK(parsed.empty());
+	}
+
+	// 목차에 같은 해시가 두 번 있으면 항목 하나로 합쳐지고 나중 것이 남습니다.
+	void TestDuplicateHashes()
+	{
+		DX::PipelineCacheEntries entries;
+		entries[1] = std::vector<std::uint8_t>{ 10 };
+		entries[2] = std::vector<std::uint8_t>{ 20, 21 };
+		std::vector<std::uint8_t> file = DX::SerializePipelineCache(entries);
+		WriteUint64(&file, c_headerSize + c_recordSize, 1);
+
+		DX::PipelineCacheEntries parsed;
+		DX_CHECK(DX::ParsePipelineCache(file.data(), file.size(), &parsed));
+		DX_CHECK(parsed.size() == 1 && parsed[1] == (std::vector<std::uint8_t>{ 20, 21 }));
+	}
+
+	// 형식이나 버전이 다르거나, 목차가 잘렸거나, 항목이 파일 밖을 가리키면 거부합니다.
+	void TestRejectsCorruptFiles()
+	{
+		const std::vector<std::uint8_t> valid = DX::SerializePipelineCache(MakeEntries());
+		DX_CHECK(!IsRejected(valid));
+
+		DX::PipelineCacheEntries entries = MakeEntries();
+		DX_CHECK(!DX::ParsePipelineCache(nullptr, 0, &entries) && entries.empty());
+		DX_CHECK(IsRejected(std::vector<std::uint8_t>(valid.begin(), valid.begin() + c_headerSize - 1)));
+
+		std::vector<std::uint8_t> file = valid;
+		WriteUint32(&file, 0, DX::c_pipelineCacheMagic ^ 1);
+		DX_CHECK(IsRejected(file));
+
+		file = valid;
+		WriteUint32(&file, 4, DX::c_pipelineCacheVersion + 1);
+		DX_CHECK(IsRejected(file));
+
+		// 목차 중간에서 잘린 파일입니다.
+		DX_CHECK(IsRejected(std::vector<std::uint8_t>(valid.begin(), valid.begin() + c_headerSize + 2 * c_recordSize + 8)));
+
+		// 항목 수가 파일에 들어갈 수 있는 목차보다 큽니다.
+		file = valid;
+		WriteUint32(&file, 8, 0xffffffffu);
+		DX_CHECK(IsRejected(file));
+		file = valid;
+		WriteUint32(&file, 8, static_cast<std::uint32_t>((valid.size() - c_headerSize) / c_recordSize + 1));
+		DX_CHECK(IsRejected(file));
+
+		// 첫 항목이 통과한 뒤 마지막 항목의 오프셋이나 길이가 파일 끝을 넘습니다.
+		const std::size_t lastRecord = c_headerSize + 3 * c_recordSize;
+		file = valid;
+		WriteUint64(&file, lastRecord + 8, valid.size() + 1);
+		DX_CHECK(IsRejected(file));
+		file = valid;
+		WriteUint64(&file, lastRecord + 16, 2);
+		DX_CHECK(IsRejected(file));
+		file = valid;
+		WriteUint64(&file, lastRecord + 8, 1);
+		WriteUint64(&file, lastRecord + 16, ~0ull);
+		DX_CHECK(IsRejected(file));
+
+		// 데이터 끝이 잘린 파일입니다.
+		DX_CHECK(IsRejected(std::vector<std::uint8_t>(valid.begin(), valid.end() - 1)));
+
+		// 파일 끝에서 끝나는 길이 0 항목은 유효합니다.
+		file = valid;
+		WriteUint64(&file, lastRecord + 8, valid.size());
+		WriteUint64(&file, lastRecord + 16, 0);
+		DX_CHECK(!IsRejected(file));
+	}
+
+	// 같은 입력은 같은 해시가 되고, 문자열 경계나 값이 달라지면 해시가 달라집니다.
+	void TestHasher()
+	{
+		DX::PipelineHasher empty;
+		DX_CHECK(empty.Get() == 14695981039346656037ull);
+
+		// FNV-1a 64의 알려진 값입니다.
+		DX::PipelineHasher known;
+		known.AddBytes("a", 1);
+		DX_CHECK(known.Get() == 0xaf63dc4c8601ec8cull);
+
+		DX::PipelineHasher first;
+		first.AddString("ab");
+		first.AddString("c");
+		DX::PipelineHasher second;
+		second.AddString("a");
+		second.AddString("bc");
+		DX::PipelineHasher repeated;
+		repeated.AddString("ab");
+		repeated.AddString("c");
+		DX_CHECK(first.Get() != second.Get());
+		DX_CHECK(first.Get() == repeated.Get());
+
+		// AddBytes는 경계를 넣지 않으므로 나누어 추가해도 같습니다.
+		DX::PipelineHasher whole;
+		whole.AddBytes("abc", 3);
+		DX::PipelineHasher split;
+		split.AddBytes("a", 1);
+		split.AddBytes("bc", 2);
+		DX_CHECK(whole.Get() == split.Get());
+
+		// nullptr과 빈 문자열은 같고, 문자열이 없을 때와는 다릅니다.
+		DX::PipelineHasher nullString;
+		nullString.AddString(nullptr);
+		DX::PipelineHasher emptyString;
+		emptyString.AddString("");
+		DX_CHECK(nullString.Get() == emptyString.Get() && nullString.Get() != empty.Get());
+
+		// blob은 크기도 해시하므로 빈 blob 두 개와 하나가 다르고, 한 바이트만 달라도 다릅니다.
+		const std::uint8_t blob[4] = { 1, 2, 3, 4 };
+		const std::uint8_t changed[4] = { 1, 2, 3, 5 };
+		DX::PipelineHasher oneEmpty;
+		oneEmpty.AddBlob(nullptr, 0);
+		DX::PipelineHasher twoEmpty;
+		twoEmpty.AddBlob(nullptr, 0);
+		twoEmpty.AddBlob(nullptr, 0);
+		DX::PipelineHasher blobHash;
+		blobHash.AddBlob(blob, sizeof(blob));
+		DX::PipelineHasher changedHash;
+		changedHash.AddBlob(changed, sizeof(changed));
+		DX_CHECK(oneEmpty.Get() != twoEmpty.Get());
+		DX_CHECK(blobHash.Get() != changedHash.Get());
+
+		DX::PipelineHasher value;
+		value.Add(static_cast<std::uint32_t>(1));
+		DX::PipelineHasher otherValue;
+		otherValue.Add(static_cast<std::uint32_t>(2));
+		DX_CHECK(value.Get() != otherValue.Get());
+	}
+}
+
+int main()
+{
+	TestRoundTrip();
+	TestDuplicateHashes();
+	TestRejectsCorruptFiles();
+	TestHasher();
+	return DX::Test::Finish("PipelineCacheFormatTests");
+}
@@ -0,0 +1,184 @@
+﻿// 절차적 텍스처 생성기의 검사와 처리량(GB/s) 벤치마크입니다.
+// 바둑판은 원래 샘플의 픽셀별 스칼라 루프와 결과를 비교하고, 같은 크기에서 두 구현의 처리량을 함께 출력합니다.
+// Linux에서는 표준 라이브러리만 사용합니다. Windows에서는 ThrowIfFailed 때문에 헤드리스 D3D12 헤더를 함께 씁니다.
+//
+//	g++ -std=c++14 -O2 -pthread -I Tests -o ProceduralTextureBenchmark Tests/ProceduralTextureBenchmark.cpp Common/ProceduralTexture.cpp
+//	cl /std:c++14 /O2 /EHsc /DDX_HEADLESS_D3D12 /I Tests Tests\ProceduralTextureBenchmark.cpp Common\ProceduralTexture.cpp
+
+#include "pch.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include "TestHarness.h"
+#include "../Common/ProceduralTexture.h"
+
+namespace
+{
+	const std::uint32_t c_black = DX::MakeRgba8(0x00, 0x00, 0x00);
+	const std::uint32_t c_white = DX::MakeRgba8(0xff, 0xff, 0xff);
+
+	// Sample3DSceneRenderer가 예전에 사용하던 픽셀별 바둑판 루프입니다(8 x 8 칸).
+	void GenerateCheckerScalar(std::uint8_t* data, std::uint32_t width, std::uint32_t height)
+	{
+		const std::uint32_t pixelSize = 4;
+		const std::uint32_t rowPitch = width * pixelSize;
+		const std::uint32_t cellPitch = rowPitch >> 3;
+		const std::uint32_t cellHeight = width >> 3;
+		const std::uint32_t textureSize = rowPitch * height;
+
+		for (std::uint32_t n = 0; n < textureSize; n += pixelSize)
+		{
+			const std::uint32_t x = n % rowPitch;
+			const std::uint32_t y = n / rowPitch;
+			const std::uint32_t i = x / cellPitch;
+			const std::uint32_t j = y / cellHeight;
+			const std::uint8_t value = (i % 2 == j % 2) ? 0x00 : 0xff;
+			data[n] = value;
+			data[n + 1] = value;
+			data[n + 2] = value;
+			data[n + 3] = 0xff;
+		}
+	}
+
+	std::uint32_t ReadPixel(const std::vector<std::uint8_t>& data, std::size_t rowPitch, std::uint32_t x, std::uint32_t y)
+	{
+		std::uint32_t pixel;
+		std::memcpy(&pixel, &data[y * rowPitch + x * 4], sizeof(pixel));
+		return pixel;
+	}
+
+	// 생성기의 바둑판은 원래 스칼라 루프와 바이트 단위로 같습니다.
+	void TestCheckerMatchesScalar()
+	{
+		const std::uint32_t sizes[] = { 8, 64, 256, 1000 };
+		for (std::uint32_t size : sizes)
+		{
+			std::vector<std::uint8_t> expected(static_cast<std::size_t>(size) * size * 4);
+			std::vector<std::uint8_t> actual(expected.size(), 0xcd);
+			GenerateCheckerScalar(expected.data(), size, size);
+
+			const DX::TextureDestination destination = { actual.data(), size, size, static_cast<std::size_t>(size) * 4 };
+			DX::GenerateChecker(destination, size / 8, size / 8, c_black, c_white);
+			DX_CHECK(actual == expected);
+		}
+	}
+
+	// 그러데이션의 양 끝은 주어진 색이고 가운데는 반올림한 중간값입니다. 행 사이의 여백은 건드리지 않습니다.
+	void TestGradientEndpointsAndPadding()
+	{
+		const std::uint32_t width = 5;
+		const std::uint32_t height = 3;
+		const std::size_t rowPitch = 256;
+		std::vector<std::uint8_t> data(rowPitch * height, 0xcd);
+		const DX::TextureDestination destination = { data.data(), width, height, rowPitch };
+
+		DX::GenerateGradient(destination, DX::GradientAxis::Horizontal, DX::MakeRgba8(0, 0, 0, 0), DX::MakeRgba8(255, 255, 255, 255));
+		for (std::uint32_t y = 0; y < height; y++)
+		{
+			DX_CHECK(ReadPixel(data, rowPitch, 0, y) == DX::MakeRgba8(0, 0, 0, 0));
+			DX_CHECK(ReadPixel(data, rowPitch, 2, y) == DX::MakeRgba8(128, 128, 128, 128));
+			DX_CHECK(ReadPixel(data, rowPitch, width - 1, y) == DX::MakeRgba8(255, 255, 255, 255));
+			DX_CHECK(data[y * rowPitch + width * 4] == 0xcd && data[y * rowPitch + rowPitch - 1] == 0xcd);
+		}
+
+		DX::GenerateGradient(destination, DX::GradientAxis::Vertical, DX::MakeRgba8(255, 0, 0), DX::MakeRgba8(0, 0, 255));
+		DX_CHECK(ReadPixel(data, rowPitch, 3, 0) == DX::MakeRgba8(255, 0, 0));
+		DX_CHECK(ReadPixel(data, rowPitch, 3, height - 1) == DX::MakeRgba8(0, 0, 255));
+	}
+
+	// 같은 seed는 같은 노이즈를 내고, 값은 두 색 사이에 있으며 크기가 격자 간격의 배수이면 이음매 없이 반복됩니다.
+	void TestValueNoise()
+	{
+		const std::uint32_t size = 64;
+		const std::size_t rowPitch = size * 4;
+		std::vector<std::uint8_t> first(rowPitch * size);
+		std::vector<std::uint8_t> second(rowPitch * size);
+		const DX::TextureDestination firstDestination = { first.data(), size, size, rowPitch };
+		const DX::TextureDestination secondDestination = { second.data(), size, size, rowPitch };
+
+		DX::GenerateValueNoise(firstDestination, 16, 3, 7, DX::MakeRgba8(0x20, 0x20, 0x20), DX::MakeRgba8(0xe0, 0xe0, 0xe0));
+		DX::GenerateValueNoise(secondDestination, 16, 3, 7, DX::MakeRgba8(0x20, 0x20, 0x20), DX::MakeRgba8(0xe0, 0xe0, 0xe0));
+		DX_CHECK(first == second);
+
+		std::uint8_t low = 0xff;
+		std::uint8_t high = 0x00;
+		for (std::size_t i = 0; i < first.size(); i += 4)
+		{
+			low = (std::min)(low, first[i]);
+			high = (std::max)(high, first[i]);
+		}
+		DX_CHECK(low >= 0x20 && high <= 0xe0 && low < high);
+
+		DX::GenerateValueNoise(secondDestination, 16, 3, 8, DX::MakeRgba8(0x20, 0x20, 0x20), DX::MakeRgba8(0xe0, 0xe0, 0xe0));
+		DX_CHECK(first != second);
+	}
+
+	// 0인 크기와 너무 작은 rowPitch는 예외를 발생시킵니다.
+	void TestInvalidArguments()
+	{
+		std::vector<std::uint8_t> data(64 * 64 * 4);
+		const DX::TextureDestination destinations[] =
+		{
+			{ data.data(), 0, 64, 256 },
+			{ data.data(), 64, 0, 256 },
+			{ data.data(), 64, 64, 255 },
+		};
+
+		for (const auto& destination : destinations)
+		{
+			bool threw = false;
+			try
+			{
+				DX::GenerateChecker(destination, 8, 8, c_black, c_white);
+			}
+			catch (const std::exception&)
+			{
+				threw = true;
+			}
+			DX_CHECK(threw);
+		}
+	}
+
+	// 256²부터 8192²(256MB)까지 크기마다 원래 스칼라 루프와 각 패턴의 처리량을 출력합니다. 바둑판은 스칼라 루프보다 빨라야 합니다.
+	void BenchmarkGenerators()
+	{
+		for (std::uint32_t size = 256; size <= 8192; size *= 2)
+		{
+			const std::size_t bytes = static_cast<std::size_t>(size) * size * 4;
+			const int repeat = size <= 1024 ? 20 : (size <= 4096 ? 5 : 2);
+			std::vector<std::uint8_t> data(bytes);
+			const DX::TextureDestination destination = { data.data(), size, size, static_cast<std::size_t>(size) * 4 };
+
+			const double scalarSeconds = DX::Test::MeasureBestSeconds(repeat, [&]() { GenerateCheckerScalar(data.data(), size, size); });
+			const double checkerSeconds = DX::Test::MeasureBestSeconds(repeat, [&]() { DX::GenerateChecker(destination, size / 8, size / 8, c_black, c_white); });
+			const double gradientSeconds = DX::Test::MeasureBestSeconds(repeat, [&]()
+			{
+				DX::GenerateGradient(destination, DX::GradientAxis::Vertical, DX::MakeRgba8(255, 0, 0), DX::MakeRgba8(0, 0, 255));
+			});
+			const double noiseSeconds = DX::Test::MeasureBestSeconds(repeat, [&]()
+			{
+				DX::GenerateValueNoise(destination, 64, 5, 7, c_black, c_white);
+			});
+
+			std::printf("%4u x %4u: 스칼라 바둑판 %6.2f GB/s, 바둑판 %6.2f GB/s, 그러데이션 %6.2f GB/s, 노이즈(5옥타브) %6.2f GB/s\n",
+				size, size,
+				bytes / scalarSeconds / 1e9,
+				bytes / checkerSeconds / 1e9,
+				bytes / gradientSeconds / 1e9,
+				bytes / noiseSeconds / 1e9);
+			DX_CHECK(checkerSeconds < scalarSeconds);
+		}
+	}
+}
+
+int main()
+{
+	TestCheckerMatchesScalar();
+	TestGradientEndpointsAndPadding();
+	TestValueNoise();
+	TestInvalidArguments();
+	BenchmarkGenerators();
+	return DX::Test::Finish("ProceduralTextureBenchmark");
+}
@@ -0,0 +1,184 @@
+﻿// StepTimer의 고정 timestep 따라잡기와 보간 계수 검사입니다. 스크립트된 클록으로 틱 간격을 정확히 제어합니다.
+// 표준 라이브러리만 사용하므로 Windows와 Linux에서 모두 빌드됩니다.
+//
+//	g++ -std=c++14 -O2 -I Tests -o StepTimerTests Tests/StepTimerTests.cpp
+//	cl /std:c++14 /O2 /EHsc /I Tests Tests\StepTimerTests.cpp
+
+#include "TestHarness.h"
+#include "../Common/StepTimer.h"
+
+namespace
+{
+	class ScriptedClock
+	{
+	public:
+		ScriptedClock() : m_now(0) {}
+
+		DX::uint64 GetFrequency() const			{ return 10000000; }
+		DX::uint64 GetCounter() const			{ return m_now; }
+		void Advance(DX::uint64 ticks)			{ m_now += ticks; }
+
+	private:
+		DX::uint64 m_now;
+	};
+
+	typedef DX::BasicStepTimer<ScriptedClock> ScriptedTimer;
+
+	const DX::uint64 c_millisecond = 10000;
+	const DX::uint64 c_step = ScriptedTimer::TicksPerSecond / 60;
+
+	void ConfigureFixedTimer(ScriptedTimer& timer, DX::FixedStepBacklogPolicy policy)
+	{
+		timer.SetFixedTimeStep(true);
+		timer.SetTargetElapsedTicks(c_step);
+		timer.SetBacklogPolicy(policy);
+	}
+
+	// 클록을 ticks만큼 앞당기고 한 번 틱한 뒤 호출된 Update 수를 반환합니다.
+	DX::uint32 TickAfter(ScriptedTimer& timer, DX::uint64 ticks)
+	{
+		DX::uint32 updates = 0;
+		timer.GetClock().Advance(ticks);
+		timer.Tick([&updates] { updates++; });
+		return updates;
+	}
+
+	// 틱당 90밀리초가 계속되면 기본 예산(5단계, 약 83밀리초)으로는 따라잡을 수 없습니다.
+	// 두 정책 모두 밀린 시간을 매 틱 버려야 하며, 보간 계수는 1에 고정되지 않고 소수 부분을 따라가야 합니다.
+	void TestSustainedSlowFrames(DX::FixedStepBacklogPolicy policy)
+	{
+		ScriptedTimer timer;
+		ConfigureFixedTimer(timer, policy);
+		const int tickCount = 300;
+		const DX::uint64 frameTicks = 90 * c_millisecond;
+
+		bool alwaysFullBudget = true;
+		bool alphaInRange = true;
+		int alphaAtOne = 0;
+		DX::uint64 previousDropped = 0;
+		int dropsAfterWarmup = 0;
+
+		for (int i = 0; i < tickCount; i++)
+		{
+			const DX::uint32 updates = TickAfter(timer, frameTicks);
+			alwaysFullBudget = alwaysFullBudget && updates == ScriptedTimer::c_defaultMaxUpdatesPerTick;
+
+			const double alpha = timer.GetInterpolationAlpha();
+			alphaInRange = alphaInRange && alpha >= 0.0 && alpha < 1.0;
+			alphaAtOne += alpha >= 1.0 ? 1 : 0;
+
+			if (i >= 10 && timer.GetDroppedTicks() > previousDropped)
+			{
+				dropsAfterWarmup++;
+			}
+			previousDropped = timer.GetDroppedTicks();
+		}
+
+		DX_CHECK(alwaysFullBudget);
+		DX_CHECK(alphaInRange);
+		DX_CHECK(alphaAtOne == 0);
+
+		// 밀린 시간은 매 틱 버려지므로 시뮬레이션한 시간과 버린 시간의 합이 실제 시간에서 두 단계 이상 뒤처지지 않습니다.
+		const DX::uint64 realTicks = tickCount * frameTicks;
+		const DX::uint64 accounted = timer.GetTotalTicks() + timer.GetDroppedTicks();
+		DX_CHECK(accounted <= realTicks);
+		DX_CHECK(realTicks - accounted < 2 * c_step);
+		// 틱마다 약 6.7밀리초가 밀리므로 대략 2.5틱마다 한 단계가 버려집니다.
+		DX_CHECK(dropsAfterWarmup >= (tickCount - 10) / 3);
+
+		// 프레임이 목표 속도로 돌아오면 Carry는 넘긴 한 단계를 한 번 더 Update해 소진하고,
+		// 그 뒤에는 틱마다 Update가 정확히 한 번 호출되어야 합니다.
+		const DX::uint64 droppedBeforeRecovery = timer.GetDroppedTicks();
+		DX::uint32 extraUpdates = 0;
+		bool steady = true;
+		for (int i = 0; i < 60; i++)
+		{
+			const DX::uint32 updates = TickAfter(timer, c_step);
+			if (i < 2)
+			{
+				extraUpdates += updates - 1;
+			}
+			else
+			{
+				steady = steady && updates == 1;
+			}
+		}
+		DX_CHECK(steady);
+		DX_CHECK(extraUpdates <= (policy == DX::FixedStepBacklogPolicy::Carry ? 1u : 0u));
+		DX_CHECK(timer.GetDroppedTicks() == droppedBeforeRecovery);
+		DX_CHECK(timer.GetInterpolationAlpha() < 1.0);
+	}
+
+	// 예산을 넘는 한 번의 스파이크는 Carry에서 다음 틱에 따라잡고, DropWholeSteps에서는 버려집니다.
+	void TestSingleSpike()
+	{
+		ScriptedTimer carry;
+		ConfigureFixedTimer(carry, DX::FixedStepBacklogPolicy::Carry);
+		ScriptedTimer drop;
+		ConfigureFixedTimer(drop, DX::FixedStepBacklogPolicy::DropWholeSteps);
+
+		// 최대 델타(100밀리초)로 제한된 뒤 6단계가 조금 넘게 남습니다.
+		DX_CHECK(TickAfter(carry, 250 * c_millisecond) == 5);
+		DX_CHECK(TickAfter(drop, 250 * c_millisecond) == 5);
+		DX_CHECK(carry.GetDroppedTicks() == 0);
+		DX_CHECK(drop.GetDroppedTicks() == c_step);
+
+		DX_CHECK(TickAfter(carry, c_step) == 2);
+		DX_CHECK(TickAfter(drop, c_step) == 1);
+		DX_CHECK(carry.GetTotalTicks() == 7 * c_step);
+		DX_CHECK(drop.GetTotalTicks() == 6 * c_step);
+
+		// 두 정책 모두 소수 부분은 보간 계수로 남습니다.
+		const double expectedAlpha = static_cast<double>((100 * c_millisecond) % c_step) / c_step;
+		DX_CHECK(carry.GetInterpolationAlpha() == expectedAlpha);
+		DX_CHECK(drop.GetInterpolationAlpha() == expectedAlpha);
+	}
+
+	void TestUnlimitedBudget()
+	{
+		// 예산이 0이면 제한된 델타 안의 모든 단계를 Update합니다.
+		ScriptedTimer timer;
+		ConfigureFixedTimer(timer, DX::FixedStepBacklogPolicy::Carry);
+		timer.SetMaxUpdatesPerTick(0);
+		DX_CHECK(TickAfter(timer, 90 * c_millisecond) == 5);
+		DX_CHECK(TickAfter(timer, 90 * c_millisecond) == 5);
+		DX_CHECK(TickAfter(timer, 90 * c_millisecond) == 6);
+		DX_CHECK(timer.GetDroppedTicks() == 0);
+	}
+
+	void TestVariableTimestep()
+	{
+		ScriptedTimer timer;
+		DX_CHECK(TickAfter(timer, 20 * c_millisecond) == 1);
+		DX_CHECK(timer.GetElapsedTicks() == 20 * c_millisecond);
+		DX_CHECK(timer.GetInterpolationAlpha() == 1.0);
+
+		// 너무 긴 델타는 1/10초로 제한됩니다.
+		TickAfter(timer, 5000 * c_millisecond);
+		DX_CHECK(timer.GetElapsedTicks() == 100 * c_millisecond);
+	}
+
+	void TestNearTargetSnapping()
+	{
+		// 목표와 1/4밀리초 이내로 다른 델타는 목표로 맞춰져 오차가 누적되지 않습니다.
+		ScriptedTimer timer;
+		ConfigureFixedTimer(timer, DX::FixedStepBacklogPolicy::DropWholeSteps);
+		for (int i = 0; i < 1000; i++)
+		{
+			DX_CHECK(TickAfter(timer, c_step + (i % 2 == 0 ? 2000 : -2000)) == 1);
+		}
+		DX_CHECK(timer.GetFrameCount() == 1000);
+		DX_CHECK(timer.GetInterpolationAlpha() == 0.0);
+	}
+}
+
+int main()
+{
+	TestSustainedSlowFrames(DX::FixedStepBacklogPolicy::Carry);
+	TestSustainedSlowFrames(DX::FixedStepBacklogPolicy::DropWholeSteps);
+	TestSingleSpike();
+	TestUnlimitedBudget();
+	TestVariableTimestep();
+	TestNearTargetSnapping();
+	return DX::Test::Finish("StepTimerTests");
+}
@@ -0,0 +1,356 @@
+﻿// 헤드리스 D3D12(NullDevice)에서 앱의 프레임 제출 경로를 실행하는 검사 및 벤치마크입니다.
+// DeviceResources가 사용하는 FrameResources와 Sample3DSceneRenderer가 사용하는 RecordCubeFrame을 그대로 호출하므로
+// 실제 GPU 없이 프레임당 CPU 기록·제출 비용과 fence 동기화를 측정합니다.
+// Windows가 아닌 플랫폼에서는 DirectX-Headers(https://github.com/microsoft/DirectX-Headers)가 필요합니다.
+//
+// 들여쓴 줄은 앞 줄의 명령에 이어집니다.
+//	g++ -std=c++14 -O2 -pthread -DDX_HEADLESS_D3D12 -I Tests -I $DXH/include -I $DXH/include/wsl/stubs -o SubmissionBenchmark
+//		Tests/SubmissionBenchmark.cpp Content/CubeFrameRecorder.cpp Common/NullDevice.cpp Common/FrameResources.cpp
+//		Common/CommandListPool.cpp Common/DescriptorHeapAllocator.cpp Common/GpuProfiler.cpp
+//		Common/LinearConstantAllocator.cpp Common/InstanceBuffer.cpp
+//	cl /std:c++14 /O2 /EHsc /DDX_HEADLESS_D3D12 /I Tests Tests\SubmissionBenchmark.cpp Content\CubeFrameRecorder.cpp
+//		Common\NullDevice.cpp Common\FrameResources.cpp Common\CommandListPool.cpp Common\DescriptorHeapAllocator.cpp
+//		Common\GpuProfiler.cpp Common\LinearConstantAllocator.cpp Common\InstanceBuffer.cpp dxguid.lib
+
+#include "pch.h"
+#include "TestHarness.h"
+#include "../Common/FrameResources.h"
+#include "../Common/NullDevice.h"
+#include "../Content/CubeFrameRecorder.h"
+
+using Microsoft::WRL::ComPtr;
+
+namespace
+{
+	// 헤드리스 장치 위에 DeviceResources의 프레임 루프와 큐브 렌더러의 리소스를 구성합니다.
+	class HeadlessScene
+	{
+	public:
+		HeadlessScene(UINT frameCount, UINT instanceCount)
+		{
+			m_device.Attach(new DX::NullDevice());
+
+			D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+			queueDesc.Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
+			DX::ThrowIfFailed(m_device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&m_commandQueue)));
+
+			m_frameResources.reset(new DX::FrameResources(m_device.Get(), m_commandQueue.Get(), frameCount));
+
+			// 직렬화된 루트 서명과 셰이더는 NullDevice가 읽지 않으므로 빈 데이터로 충분합니다.
+			const UINT8 emptyBlob[4] = {};
+			DX::ThrowIfFailed(m_device->CreateRootSignature(0, emptyBlob, sizeof(emptyBlob), IID_PPV_ARGS(&m_rootSignature)));
+			D3D12_GRAPHICS_PIPELINE_STATE_DESC pipelineDesc = {};
+			pipelineDesc.pRootSignature = m_rootSignature.Get();
+			DX::ThrowIfFailed(m_device->CreateGraphicsPipelineState(&pipelineDesc, IID_PPV_ARGS(&m_pipelineState)));
+
+			const CD3DX12_HEAP_PROPERTIES defaultHeap(D3D12_HEAP_TYPE_DEFAULT);
+			const CD3DX12_RESOURCE_DESC renderTargetDesc = CD3DX12_RESOURCE_DESC::Tex2D(DXGI_FORMAT_B8G8R8A8_UNORM, 1280, 720, 1, 1, 1, 0, D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET);
+			DX::ThrowIfFailed(m_device->CreateCommittedResource(&defaultHeap, D3D12_HEAP_FLAG_NONE, &renderTargetDesc, D3D12_RESOURCE_STATE_PRESENT, nullptr, IID_PPV_ARGS(&m_renderTarget)));
+			const CD3DX12_RESOURCE_DESC vertexBufferDesc = CD3DX12_RESOURCE_DESC::Buffer(8 * 16);
+			DX::ThrowIfFailed(m_device->CreateCommittedResource(&defaultHeap, D3D12_HEAP_FLAG_NONE, &vertexBufferDesc, D3D12_RESOURCE_STATE_COMMON, nullptr, IID_PPV_ARGS(&m_vertexBuffer)));
+			const CD3DX12_RESOURCE_DESC indexBufferDesc = CD3DX12_RESOURCE_DESC::Buffer(36 * 2);
+			DX::ThrowIfFailed(m_device->CreateCommittedResource(&defaultHeap, D3D12_HEAP_FLAG_NONE, &indexBufferDesc, D3D12_RESOURCE_STATE_COMMON, nullptr, IID_PPV_ARGS(&m_indexBuffer)));
+			const CD3DX12_RESOURCE_DESC textureDesc = CD3DX12_RESOURCE_DESC::Tex2D(DXGI_FORMAT_R8G8B8A8_UNORM, 256, 256, 1, 9);
+			DX::ThrowIfFailed(m_device->CreateCommittedResource(&defaultHeap, D3D12_HEAP_FLAG_NONE, &textureDesc, D3D12_RESOURCE_STATE_COMMON, nullptr, IID_PPV_ARGS(&m_texture)));
+
+			// 렌더러처럼 텍스처 SRV를 스테이징 힙에 만듭니다.
+			m_stagingHeap.reset(new DX::StagingDescriptorHeap(m_device.Get(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV));
+			m_textureSrv = m_stagingHeap->Allocate();
+			m_device->CreateShaderResourceView(m_texture.Get(), nullptr, m_textureSrv.cpuHandle);
+
+			m_instances.resize(instanceCount);
+			for (UINT i = 0; i < instanceCount; i++)
+			{
+				DX::InstanceTransform& instance = m_instances[i];
+				instance.position[0] = static_cast<float>(i % 316);
+				instance.position[1] = 0.0f;
+				instance.position[2] = static_cast<float>(i / 316);
+				instance.scale = 1.0f;
+				instance.rotation[0] = 0.0f;
+				instance.rotation[1] = 0.0f;
+				instance.rotation[2] = 0.0f;
+				instance.rotation[3] = 1.0f;
+			}
+			std::memset(m_constants, 0, sizeof(m_constants));
+
+			m_state.rootSignature = m_rootSignature.Get();
+			m_state.pipelineState = m_pipelineState.Get();
+			m_state.vertexBufferView.BufferLocation = m_vertexBuffer->GetGPUVirtualAddress();
+			m_state.vertexBufferView.SizeInBytes = 8 * 16;
+			m_state.vertexBufferView.StrideInBytes = 16;
+			m_state.indexBufferView.BufferLocation = m_indexBuffer->GetGPUVirtualAddress();
+			m_state.indexBufferView.SizeInBytes = 36 * 2;
+			m_state.indexBufferView.Format = DXGI_FORMAT_R16_UINT;
+			m_state.indexCount = 36;
+			m_state.constants = m_constants;
+			m_state.constantsSize = sizeof(m_constants);
+			m_state.instances = m_instances.data();
+			m_state.instanceCount = instanceCount;
+			m_state.drawCount = 1;
+			m_state.recordingWorkerCount = 0;
+			m_state.textureDescriptors = &m_textureSrv.cpuHandle;
+			m_state.textureDescriptorCount = 1;
+
+			m_target.renderTarget = m_renderTarget.Get();
+			m_target.renderTargetView.ptr = 1;
+			m_target.depthStencilView.ptr = 2;
+			m_target.viewport = { 0.0f, 0.0f, 1280.0f, 720.0f, 0.0f, 1.0f };
+			m_target.scissorRect = { 0, 0, 1280, 720 };
+		}
+
+		~HeadlessScene()
+		{
+			// 지연된 신호가 fence 참조를 유지하므로 장치를 해제하기 전에 비웁니다.
+			m_frameResources->WaitForGpu();
+			GetDevice()->FlushGpu();
+			m_stagingHeap->Free(m_textureSrv);
+		}
+
+		// Sample3DSceneRenderer::Render와 DeviceResources::Present의 프레임 한 번입니다.
+		void RenderFrame()
+		{
+			RecordFrame();
+			SubmitFrame();
+		}
+
+		void RecordFrame()
+		{
+			m_commandLists.clear();
+			AddingTextures::RecordCubeFrame(m_frameResources.get(), m_state, m_target, &m_commandLists);
+		}
+
+		void SubmitFrame()
+		{
+			m_commandQueue->ExecuteCommandLists(static_cast<UINT>(m_commandLists.size()), m_commandLists.data());
+			m_frameResources->MoveToNextFrame();
+		}
+
+		// 인스턴스를 drawCount번의 그리기로 나누고 workerCount개의 목록에 기록합니다. 0이면 자동입니다.
+		void SetDrawSplit(UINT drawCount, UINT workerCount)
+		{
+			m_state.drawCount = drawCount;
+			m_state.recordingWorkerCount = workerCount;
+		}
+
+		DX::NullDevice* GetDevice() const				{ return static_cast<DX::NullDevice*>(m_device.Get()); }
+		DX::FrameResources* GetFrameResources() const	{ return m_frameResources.get(); }
+		UINT GetSubmittedListCount() const				{ return static_cast<UINT>(m_commandLists.size()); }
+
+	private:
+		ComPtr<ID3D12Device>						m_device;
+		ComPtr<ID3D12CommandQueue>					m_commandQueue;
+		std::unique_ptr<DX::FrameResources>			m_frameResources;
+		ComPtr<ID3D12RootSignature>					m_rootSignature;
+		ComPtr<ID3D12PipelineState>					m_pipelineState;
+		ComPtr<ID3D12Resource>						m_renderTarget;
+		ComPtr<ID3D12Resource>						m_vertexBuffer;
+		ComPtr<ID3D12Resource>						m_indexBuffer;
+		ComPtr<ID3D12Resource>						m_texture;
+		std::unique_ptr<DX::StagingDescriptorHeap>	m_stagingHeap;
+		DX::StagingDescriptor						m_textureSrv;
+		std::vector<DX::InstanceTransform>			m_instances;
+		float										m_constants[48];	// ModelViewProjectionConstantBuffer와 같은 크기입니다.
+		AddingTextures::CubeDrawState				m_state;
+		AddingTextures::CubeFrameTarget				m_target;
+		std::vector<ID3D12CommandList*>				m_commandLists;
+	};
+
+	// 프레임마다 지우기, 그리기, 표현 준비 목록을 한 번에 제출하고 fence를 하나씩 신호합니다.
+	void TestFrameSubmission()
+	{
+		const UINT frameCount = 3;
+		const UINT frames = 20;
+		HeadlessScene scene(frameCount, 16);
+		scene.GetDevice()->ResetStatistics();
+
+		for (UINT frame = 0; frame < frames; frame++)
+		{
+			DX_CHECK(scene.GetFrameResources()->GetCurrentFrameIndex() == frame % frameCount);
+			scene.RecordFrame();
+			DX_CHECK(scene.GetSubmittedListCount() == 3);
+
+			// 텍스처 테이블은 이번 프레임의 셰이더 표시 구간에 한 번 복사됩니다.
+			DX_CHECK(scene.GetFrameResources()->GetShaderVisibleDescriptorHeap()->GetUsedCount() == 1);
+			scene.SubmitFrame();
+		}
+
+		const DX::NullDeviceStatistics statistics = scene.GetDevice()->GetStatistics();
+		DX_CHECK(statistics.executeCalls == frames);
+		DX_CHECK(statistics.commandListsExecuted == frames * 3);
+		DX_CHECK(statistics.drawCalls == frames);
+		DX_CHECK(statistics.resourceBarriers == frames * 2);
+		DX_CHECK(statistics.signals == frames);
+		DX_CHECK(statistics.descriptorTableBinds == frames);
+		DX_CHECK(statistics.unwrittenQueriesResolved == 0);
+
+		// 명령 할당기는 프레임 슬롯마다 세 쌍이면 충분합니다.
+		DX_CHECK(scene.GetFrameResources()->GetCommandListPool()->GetUsedCount() == 0);
+	}
+
+	// GPU가 latency 신호만큼 뒤처지면 CPU는 진행 중인 프레임 수를 넘을 때만 멈춥니다.
+	void TestFrameLatency()
+	{
+		for (UINT frameCount = 1; frameCount <= DX::c_maxFrameCount; frameCount++)
+		{
+			for (UINT latency = 0; latency <= 4; latency++)
+			{
+				HeadlessScene scene(frameCount, 1);
+				scene.GetDevice()->SetGpuLatency(latency);
+				scene.GetDevice()->ResetStatistics();
+
+				const UINT frames = 32;
+				for (UINT frame = 0; frame < frames; frame++)
+				{
+					scene.RenderFrame();
+				}
+
+				const DX::NullDeviceStatistics statistics = scene.GetDevice()->GetStatistics();
+				if (latency < frameCount)
+				{
+					DX_CHECK(statistics.cpuStalls == 0);
+				}
+				else
+				{
+					DX_CHECK(statistics.cpuStalls > 0);
+				}
+			}
+		}
+	}
+
+	// 해제를 미룬 개체는 그 시점까지 제출한 프레임이 끝나야 해제됩니다.
+	void TestDeferredRelease()
+	{
+		HeadlessScene scene(2, 1);
+		scene.GetDevice()->SetGpuLatency(1);
+
+		bool released = false;
+		scene.GetFrameResources()->DeferRelease([&released]() { released = true; });
+		scene.RenderFrame();
+		DX_CHECK(!released);
+		scene.RenderFrame();
+		scene.RenderFrame();
+		DX_CHECK(released);
+
+		released = false;
+		scene.GetFrameResources()->DeferRelease([&released]() { released = true; });
+		scene.GetFrameResources()->WaitForGpu();
+		DX_CHECK(released);
+	}
+
+	// 진행 중인 프레임 수를 바꾸면 GPU를 기다린 뒤 첫 슬롯부터 다시 시작합니다.
+	void TestSetFrameCount()
+	{
+		HeadlessScene scene(3, 1);
+		scene.GetDevice()->SetGpuLatency(2);
+		scene.RenderFrame();
+		scene.RenderFrame();
+
+		scene.GetFrameResources()->SetFrameCount(1);
+		DX_CHECK(scene.GetFrameResources()->GetFrameCount() == 1);
+		DX_CHECK(scene.GetFrameResources()->GetCurrentFrameIndex() == 0);
+		for (UINT frame = 0; frame < 4; frame++)
+		{
+			scene.RenderFrame();
+			DX_CHECK(scene.GetFrameResources()->GetCurrentFrameIndex() == 0);
+		}
+	}
+
+	// 그리기를 여러 작업자로 나누면 작업자마다 그리기 목록 하나가 지우기와 표현 목록 사이에 제출됩니다.
+	void TestParallelRecording()
+	{
+		const UINT workerCounts[] = { 1, 2, 3, 8 };
+		for (UINT workerCount : workerCounts)
+		{
+			HeadlessScene scene(DX::c_defaultFrameCount, 1000);
+			scene.SetDrawSplit(100, workerCount);
+			scene.GetDevice()->ResetStatistics();
+
+			const UINT frames = 5;
+			for (UINT frame = 0; frame < frames; frame++)
+			{
+				scene.RenderFrame();
+				DX_CHECK(scene.GetSubmittedListCount() == 2 + workerCount);
+			}
+
+			const DX::NullDeviceStatistics statistics = scene.GetDevice()->GetStatistics();
+			DX_CHECK(statistics.executeCalls == frames);
+			DX_CHECK(statistics.commandListsExecuted == frames * (2 + workerCount));
+			DX_CHECK(statistics.drawCalls == frames * 100);
+			DX_CHECK(statistics.descriptorTableBinds == frames * workerCount);
+		}
+
+		// 인스턴스보다 그리기가 많으면 빈 구간은 그리지 않습니다.
+		HeadlessScene scene(DX::c_defaultFrameCount, 3);
+		scene.SetDrawSplit(8, 2);
+		scene.GetDevice()->ResetStatistics();
+		scene.RenderFrame();
+		DX_CHECK(scene.GetDevice()->GetStatistics().drawCalls == 3);
+	}
+
+	// 그리기 수 x 작업자 수별 프레임당 CPU 기록·제출 시간입니다. 인스턴스 수는 고정합니다.
+	void BenchmarkParallelRecording()
+	{
+		const UINT instanceCount = 65536;
+		const UINT drawCounts[] = { 1, 256, 4096, 65536 };
+		const UINT workerCounts[] = { 1, 2, 4, 8 };
+		std::printf("하드웨어 스레드 %u개\n", DX::GetHardwareThreadCount());
+		for (UINT drawCount : drawCounts)
+		{
+			for (UINT workerCount : workerCounts)
+			{
+				HeadlessScene scene(DX::c_defaultFrameCount, instanceCount);
+				scene.SetDrawSplit(drawCount, workerCount);
+				const int framesPerRun = 50;
+				for (int frame = 0; frame < 5; frame++)
+				{
+					scene.RenderFrame();
+				}
+
+				const double seconds = DX::Test::MeasureBestSeconds(5, [&]()
+				{
+					for (int frame = 0; frame < framesPerRun; frame++)
+					{
+						scene.RenderFrame();
+					}
+				});
+				std::printf("그리기 %5u번, 작업자 %u개: 프레임당 %8.2f us\n", drawCount, workerCount, seconds * 1e6 / framesPerRun);
+			}
+		}
+	}
+
+	// 인스턴스 수별 프레임당 CPU 기록·제출 시간입니다.
+	void BenchmarkSubmission()
+	{
+		const UINT instanceCounts[] = { 1, 1000, 100000 };
+		for (UINT instanceCount : instanceCounts)
+		{
+			HeadlessScene scene(DX::c_defaultFrameCount, instanceCount);
+			const int framesPerRun = 200;
+			for (int frame = 0; frame < 10; frame++)
+			{
+				scene.RenderFrame();
+			}
+
+			const double seconds = DX::Test::MeasureBestSeconds(5, [&]()
+			{
+				for (int frame = 0; frame < framesPerRun; frame++)
+				{
+					scene.RenderFrame();
+				}
+			});
+			std::printf("인스턴스 %6u개: 프레임당 %8.2f us\n", instanceCount, seconds * 1e6 / framesPerRun);
+		}
+	}
+}
+
+int main()
+{
+	TestFrameSubmission();
+	TestFrameLatency();
+	TestDeferredRelease();
+	TestSetFrameCount();
+	TestParallelRecording();
+	BenchmarkSubmission();
+	BenchmarkParallelRecording();
+	return DX::Test::Finish("SubmissionBenchmark");
+}
@@ -0,0 +1,50 @@
+﻿#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+// Tests 폴더의 검사 및 벤치마크 프로그램이 공유하는 최소 도우미입니다.
+// 각 프로그램은 독립 실행 파일이며, 실패가 하나라도 있으면 0이 아닌 값으로 종료합니다.
+namespace DX
+{
+	namespace Test
+	{
+		inline int& GetFailureCount()
+		{
+			static int failures = 0;
+			return failures;
+		}
+
+		inline void ReportFailure(const char* expression, const char* file, int line)
+		{
+			std::printf("실패: %s (%s:%d)\n", expression, file, line);
+			GetFailureCount()++;
+		}
+
+		// 결과를 출력하고 main의 반환 값을 돌려줍니다.
+		inline int Finish(const char* name)
+		{
+			const int failures = GetFailureCount();
+			std::printf("%s: %s (실패 %d개)\n", name, failures == 0 ? "통과" : "실패", failures);
+			return failures == 0 ? 0 : 1;
+		}
+
+		// body를 repeat번 실행해 가장 짧은 실행 시간(초)을 반환합니다. 첫 실행 전의 준비는 호출자가 합니다.
+		template<typename TBody>
+		double MeasureBestSeconds(int repeat, const TBody& body)
+		{
+			double best = 1e30;
+			for (int i = 0; i < repeat; i++)
+			{
+				const auto begin = std::chrono::steady_clock::now();
+				body();
+				const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+				best = seconds < best ? seconds : best;
+			}
+			return best;
+		}
+	}
+}
+
+#define DX_CHECK(expression) \
+	do { if (!(expression)) { DX::Test::ReportFailure(#expression, __FILE__, __LINE__); } } while (false)
@@ -0,0 +1,213 @@
+﻿// 헤드리스 D3D12(NullDevice)에서 UploadRingBuffer를 실행하는 검사입니다.
+// fence는 CPU Signal로 직접 완료하거나, GPU 지연을 준 큐에 신호를 쌓아 두고 할당이 기다리게 하여 순서대로 완료합니다.
+// Windows가 아닌 플랫폼에서는 DirectX-Headers(https://github.com/microsoft/DirectX-Headers)가 필요합니다.
+//
+//	g++ -std=c++14 -O2 -pthread -DDX_HEADLESS_D3D12 -I Tests -I $DXH/include -I $DXH/include/wsl/stubs -o UploadRingBufferTests Tests/UploadRingBufferTests.cpp Common/UploadRingBuffer.cpp Common/NullDevice.cpp
+//	cl /std:c++14 /O2 /EHsc /DDX_HEADLESS_D3D12 /I Tests Tests\UploadRingBufferTests.cpp Common\UploadRingBuffer.cpp Common\NullDevice.cpp dxguid.lib
+
+#include "pch.h"
+#include "TestHarness.h"
+#include "../Common/DirectXHelper.h"
+#include "../Common/NullDevice.h"
+#include "../Common/UploadRingBuffer.h"
+
+using Microsoft::WRL::ComPtr;
+
+namespace
+{
+	const UINT64 c_capacity = 1024;
+
+	// 헤드리스 장치, 손으로 진행하는 fence와 작은 링 버퍼입니다. 큐 신호는 gpuLatency개가 더 쌓인 뒤에야 완료됩니다.
+	class HeadlessRing
+	{
+	public:
+		explicit HeadlessRing(UINT gpuLatency = 0)
+		{
+			m_device.Attach(new DX::NullDevice());
+			GetDevice()->SetGpuLatency(gpuLatency);
+
+			D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+			queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+			DX::ThrowIfFailed(m_device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&m_commandQueue)));
+			DX::ThrowIfFailed(m_device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_fence)));
+			m_ring.reset(new DX::UploadRingBuffer(m_device.Get(), m_fence.Get(), c_capacity));
+		}
+
+		~HeadlessRing()
+		{
+			m_ring.reset();
+			GetDevice()->FlushGpu();
+		}
+
+		// 마지막 Commit 이후의 할당을 fenceValue로 태그하고 큐에서 신호를 예약합니다.
+		void Submit(UINT64 fenceValue)
+		{
+			m_ring->Commit(fenceValue);
+			DX::ThrowIfFailed(m_commandQueue->Signal(m_fence.Get(), fenceValue));
+		}
+
+		DX::NullDevice* GetDevice() const		{ return static_cast<DX::NullDevice*>(m_device.Get()); }
+		ID3D12Fence* GetFence() const			{ return m_fence.Get(); }
+		DX::UploadRingBuffer* GetRing() const	{ return m_ring.get(); }
+
+	private:
+		ComPtr<ID3D12Device>					m_device;
+		ComPtr<ID3D12CommandQueue>				m_commandQueue;
+		ComPtr<ID3D12Fence>						m_fence;
+		std::unique_ptr<DX::UploadRingBuffer>	m_ring;
+	};
+
+	bool IsConsistent(const DX::UploadAllocation& allocation, const DX::UploadAllocation& first, UINT64 alignment)
+	{
+		return allocation.resource == first.resource &&
+			allocation.offset % alignment == 0 &&
+			allocation.offset + allocation.size <= c_capacity &&
+			allocation.cpuAddress == first.cpuAddress - first.offset + allocation.offset &&
+			allocation.gpuAddress == first.gpuAddress - first.offset + allocation.offset;
+	}
+
+	// 할당은 정렬된 오프셋에 차례로 놓이고, 사용량에는 정렬 여백이 포함됩니다. 크기가 0이거나 용량보다 크면 실패합니다.
+	void TestAllocateAligned()
+	{
+		HeadlessRing ring;
+		DX::UploadRingBuffer* buffer = ring.GetRing();
+		DX_CHECK(buffer->GetCapacity() == c_capacity && buffer->GetUsedSize() == 0);
+
+		DX::UploadAllocation first;
+		DX_CHECK(buffer->TryAllocate(100, 256, &first));
+		DX_CHECK(first.offset == 0 && first.size == 100 && first.cpuAddress != nullptr);
+		DX_CHECK(buffer->GetUsedSize() == 100);
+
+		DX::UploadAllocation second;
+		DX_CHECK(buffer->TryAllocate(10, 256, &second));
+		DX_CHECK(second.offset == 256 && IsConsistent(second, first, 256));
+		DX_CHECK(buffer->GetUsedSize() == 266);
+
+		const DX::UploadAllocation third = buffer->Allocate(3, 1);
+		DX_CHECK(third.offset == 266 && IsConsistent(third, first, 1));
+		DX_CHECK(buffer->GetUsedSize() == 269);
+
+		DX::UploadAllocation unused;
+		DX_CHECK(!buffer->TryAllocate(0, 1, &unused));
+		DX_CHECK(!buffer->TryAllocate(c_capacity + 1, 1, &unused));
+		DX_CHECK(buffer->GetUsedSize() == 269);
+
+		// fence가 태그 값을 넘으면 모두 회수됩니다.
+		ring.Submit(1);
+		buffer->Reclaim();
+		DX_CHECK(buffer->GetUsedSize() == 0);
+	}
+
+	// 끝에 맞지 않는 할당은 남은 부분을 채우고 오프셋 0에서 다시 시작합니다. 앞부분이 회수되기 전에는 실패합니다.
+	void TestWrap()
+	{
+		HeadlessRing ring(4);
+		DX::UploadRingBuffer* buffer = ring.GetRing();
+
+		DX::UploadAllocation first;
+		DX_CHECK(buffer->TryAllocate(600, 256, &first));
+		ring.Submit(1);
+
+		// 768 + 300은 끝을 넘으므로 1024까지 424바이트를 채워야 하며, 600바이트가 아직 사용 중이라 들어가지 않습니다.
+		DX::UploadAllocation wrapped;
+		DX_CHECK(!buffer->TryAllocate(300, 256, &wrapped));
+		DX_CHECK(buffer->GetUsedSize() == 600);
+
+		ring.GetFence()->Signal(1);
+		DX_CHECK(buffer->TryAllocate(300, 256, &wrapped));
+		DX_CHECK(wrapped.offset == 0 && IsConsistent(wrapped, first, 256));
+		DX_CHECK(buffer->GetUsedSize() == 424 + 300);
+
+		// 감은 뒤의 할당도 정렬되고, 회수된 뒤에는 끝까지 다시 씁니다.
+		DX::UploadAllocation next;
+		DX_CHECK(buffer->TryAllocate(1, 256, &next));
+		DX_CHECK(next.offset == 512 && IsConsistent(next, first, 256));
+		DX_CHECK(buffer->GetUsedSize() == 424 + 512 + 1);
+		ring.Submit(2);
+		ring.GetFence()->Signal(2);
+
+		DX::UploadAllocation tail;
+		DX_CHECK(buffer->TryAllocate(c_capacity - 768, 256, &tail));
+		DX_CHECK(tail.offset == 768 && IsConsistent(tail, first, 256));
+		DX_CHECK(buffer->GetUsedSize() == c_capacity - 768 + 255);
+		ring.Submit(3);
+		ring.GetFence()->Signal(3);
+		DX::UploadAllocation full;
+		DX_CHECK(buffer->TryAllocate(c_capacity, 1, &full));
+		DX_CHECK(full.offset == 0 && buffer->GetUsedSize() == c_capacity);
+	}
+
+	// 공간이 없으면 Allocate는 전체 GPU가 아니라 가장 오래된 태그의 fence까지만 기다립니다.
+	void TestAllocateWaitsForOldestBatch()
+	{
+		HeadlessRing ring(8);
+		DX::UploadRingBuffer* buffer = ring.GetRing();
+
+		buffer->Allocate(400, 1);
+		ring.Submit(1);
+		buffer->Allocate(400, 1);
+		ring.Submit(2);
+		buffer->Allocate(200, 1);
+		ring.Submit(3);
+		DX_CHECK(buffer->GetUsedSize() == 1000);
+		DX_CHECK(ring.GetFence()->GetCompletedValue() == 0);
+
+		ring.GetDevice()->ResetStatistics();
+		DX::UploadAllocation unused;
+		DX_CHECK(!buffer->TryAllocate(300, 1, &unused));
+
+		const DX::UploadAllocation allocation = buffer->Allocate(300, 1);
+		const DX::NullDeviceStatistics statistics = ring.GetDevice()->GetStatistics();
+		DX_CHECK(allocation.offset == 0);
+		DX_CHECK(ring.GetFence()->GetCompletedValue() == 1);
+		DX_CHECK(statistics.cpuWaits == 1 && statistics.cpuStalls == 1);
+		DX_CHECK(buffer->GetUsedSize() == 1000 - 400 + 24 + 300);
+	}
+
+	// Commit되지 않은 할당만으로 가득 차면 기다릴 fence가 없으므로 E_OUTOFMEMORY 예외가 발생합니다.
+	// 할당 없이 부른 Commit은 아무것도 태그하지 않으므로, 그 fence 값을 기다리지 않습니다.
+	void TestOutOfMemory()
+	{
+		HeadlessRing ring(8);
+		DX::UploadRingBuffer* buffer = ring.GetRing();
+
+		ring.Submit(1);
+		buffer->Allocate(1000, 1);
+		ring.GetDevice()->ResetStatistics();
+
+		HRESULT result = S_OK;
+		try
+		{
+			buffer->Allocate(100, 1);
+		}
+		catch (const DX::HResultException& exception)
+		{
+			result = exception.GetResult();
+		}
+		DX_CHECK(result == E_OUTOFMEMORY);
+		DX_CHECK(ring.GetDevice()->GetStatistics().cpuWaits == 0);
+		DX_CHECK(ring.GetFence()->GetCompletedValue() == 0);
+		DX_CHECK(buffer->GetUsedSize() == 1000);
+
+		// 용량보다 큰 요청도 회수를 기다리지 않고 실패합니다.
+		result = S_OK;
+		try
+		{
+			buffer->Allocate(c_capacity + 1, 1);
+		}
+		catch (const DX::HResultException& exception)
+		{
+			result = exception.GetResult();
+		}
+		DX_CHECK(result == E_OUTOFMEMORY);
+	}
+}
+
+int main()
+{
+	TestAllocateAligned();
+	TestWrap();
+	TestAllocateWaitsForOldestBatch();
+	TestOutOfMemory();
+	return DX::Test::Finish("UploadRingBufferTests");
+}
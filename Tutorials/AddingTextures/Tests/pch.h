@@ -0,0 +1,32 @@
+﻿#pragma once
+
+// 앱의 pch.h 대신 사용하는 미리 컴파일된 헤더입니다. 검사 프로그램을 -I Tests로 빌드하면
+// Common의 .cpp 파일이 포함하는 "pch.h"가 이 파일로 연결됩니다.
+// 표준 라이브러리만 쓰는 모듈은 추가 헤더가 필요 없습니다. D3D12를 쓰는 모듈은 DX_HEADLESS_D3D12를 정의하여
+// NullDevice.h가 고른 플랫폼 D3D12 헤더와 d3dx12.h, 그리고 Windows SDK에만 있는 도우미의 대체 정의를 받습니다.
+
+#include <memory>
+#include <vector>
+
+#if defined(DX_HEADLESS_D3D12)
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <string>
+#include "../Common/NullDevice.h"
+
+#if defined(_WIN32)
+#include "../Common/d3dx12.h"
+#else
+#include <directx/d3dx12.h>
+#endif
+
+// PIX 이벤트는 헤드리스 빌드에서 기록하지 않습니다.
+#define PIXBeginEvent(...)	((void)0)
+#define PIXEndEvent(...)	((void)0)
+#define PIXSetMarker(...)	((void)0)
+
+#if !defined(_countof)
+#define _countof(array) (sizeof(array) / sizeof((array)[0]))
+#endif
+#endif
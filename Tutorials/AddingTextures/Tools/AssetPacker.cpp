@@ -0,0 +1,161 @@
+﻿// 에셋 팩을 만드는 명령줄 도구입니다. 표준 라이브러리만 사용하므로 Windows와 Linux에서 모두 빌드됩니다.
+//
+//	g++ -std=c++14 -O2 -o AssetPacker Tools/AssetPacker.cpp
+//	cl /std:c++14 /O2 /EHsc Tools\AssetPacker.cpp
+//
+// 사용법:
+//	AssetPacker <출력.pack> [옵션] <파일>...
+//	AssetPacker -l <팩>
+//
+// 옵션은 뒤에 오는 파일에 적용됩니다.
+//	-c		LZ4로 압축합니다(작아지는 경우에만).
+//	-u		압축하지 않습니다(기본값).
+//	-a <n>	페이로드 정렬입니다(기본값 4096, 직접 업로드할 큰 리소스는 65536).
+//
+// 에셋 ID는 경로를 제외한 파일 이름의 해시(DX::MakeAssetId)입니다.
+// -l은 목차를 출력하고 모든 항목의 압축을 풀어 검증합니다.
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "../Common/AssetPackFormat.h"
+
+namespace
+{
+	bool ReadFile(const std::string& path, std::vector<std::uint8_t>* data)
+	{
+		std::ifstream stream(path, std::ios::binary);
+		if (!stream)
+		{
+			return false;
+		}
+		data->assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+		return true;
+	}
+
+	std::string GetFileName(const std::string& path)
+	{
+		const std::size_t separator = path.find_last_of("/\\");
+		return separator == std::string::npos ? path : path.substr(separator + 1);
+	}
+
+	int List(const std::string& path)
+	{
+		std::vector<std::uint8_t> file;
+		std::uint32_t entryCount = 0;
+		if (!ReadFile(path, &file) || !DX::ValidateAssetPack(file.data(), file.size(), &entryCount))
+		{
+			std::fprintf(stderr, "%s: 에셋 팩이 아니거나 손상되었습니다.\n", path.c_str());
+			return 1;
+		}
+
+		int result = 0;
+		for (std::uint32_t i = 0; i < entryCount; i++)
+		{
+			DX::AssetPackEntry entry;
+			std::memcpy(&entry, file.data() + DX::c_assetPackHeaderSize + i * sizeof(entry), sizeof(entry));
+
+			bool valid = true;
+			if ((entry.flags & DX::c_assetEntryCompressed) != 0)
+			{
+				std::vector<std::uint8_t> decompressed(static_cast<std::size_t>(entry.size));
+				valid = DX::Lz4DecompressBlock(file.data() + entry.offset, static_cast<std::size_t>(entry.storedSize), decompressed.data(), decompressed.size());
+			}
+
+			std::printf("%016llx  offset %10llu  stored %10llu  size %10llu  align %6u%s%s\n",
+				static_cast<unsigned long long>(entry.id),
+				static_cast<unsigned long long>(entry.offset),
+				static_cast<unsigned long long>(entry.storedSize),
+				static_cast<unsigned long long>(entry.size),
+				entry.alignment,
+				(entry.flags & DX::c_assetEntryCompressed) != 0 ? "  lz4" : "",
+				valid ? "" : "  손상됨");
+
+			if (!valid)
+			{
+				result = 1;
+			}
+		}
+		return result;
+	}
+
+	int Pack(int argc, char** argv)
+	{
+		const std::string outputPath = argv[1];
+
+		std::vector<DX::AssetPackInput> inputs;
+		std::uint32_t alignment = DX::c_assetPackDefaultAlignment;
+		bool compress = false;
+
+		for (int i = 2; i < argc; i++)
+		{
+			const std::string argument = argv[i];
+			if (argument == "-c")
+			{
+				compress = true;
+			}
+			else if (argument == "-u")
+			{
+				compress = false;
+			}
+			else if (argument == "-a" && i + 1 < argc)
+			{
+				alignment = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 0));
+			}
+			else
+			{
+				DX::AssetPackInput input;
+				if (!ReadFile(argument, &input.data))
+				{
+					std::fprintf(stderr, "%s: 파일을 읽을 수 없습니다.\n", argument.c_str());
+					return 1;
+				}
+
+				const std::string name = GetFileName(argument);
+				input.id = DX::MakeAssetId(name.c_str());
+				input.alignment = alignment;
+				input.compress = compress;
+				inputs.push_back(std::move(input));
+
+				std::printf("%016llx  %s\n", static_cast<unsigned long long>(inputs.back().id), name.c_str());
+			}
+		}
+
+		std::vector<std::uint8_t> file;
+		if (!DX::SerializeAssetPack(inputs, &file))
+		{
+			std::fprintf(stderr, "에셋 ID가 중복되었거나 정렬이 2의 거듭제곱이 아닙니다.\n");
+			return 1;
+		}
+
+		std::ofstream stream(outputPath, std::ios::binary | std::ios::trunc);
+		stream.write(reinterpret_cast<const char*>(file.data()), file.size());
+		if (!stream)
+		{
+			std::fprintf(stderr, "%s: 파일을 쓸 수 없습니다.\n", outputPath.c_str());
+			return 1;
+		}
+
+		std::printf("%s: 항목 %u개, %llu바이트\n", outputPath.c_str(), static_cast<unsigned>(inputs.size()), static_cast<unsigned long long>(file.size()));
+		return 0;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc == 3 && std::string(argv[1]) == "-l")
+	{
+		return List(argv[2]);
+	}
+
+	if (argc < 3)
+	{
+		std::fprintf(stderr, "사용법: AssetPacker <출력.pack> [-c|-u] [-a 정렬] <파일>...\n       AssetPacker -l <팩>\n");
+		return 1;
+	}
+
+	return Pack(argc, argv);
+}
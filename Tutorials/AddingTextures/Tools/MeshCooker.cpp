@@ -0,0 +1,195 @@
+﻿// OBJ/glTF 메시를 쿠킹된 메시 형식으로 바꾸는 명령줄 도구입니다.
+// Linux에서는 표준 라이브러리만 사용합니다. Windows에서는 MeshOptimizer의 ThrowIfFailed 때문에 헤드리스 D3D12 헤더를 함께 씁니다.
+// MeshOptimizer.cpp의 "pch.h"는 Tests/pch.h로 연결합니다.
+//
+//	g++ -std=c++14 -O2 -pthread -I Tests -o MeshCooker Tools/MeshCooker.cpp Common/MeshOptimizer.cpp
+//	cl /std:c++14 /O2 /EHsc /DDX_HEADLESS_D3D12 /I Tests Tools\MeshCooker.cpp Common\MeshOptimizer.cpp
+//
+// 사용법:
+//	MeshCooker <입력.obj|.gltf|.glb> <출력.mesh>
+//	MeshCooker -i <메시>
+//
+// 형식은 확장자로 정합니다. glTF의 외부 버퍼는 입력 파일과 같은 폴더에서 찾습니다.
+// 가져온 메시는 MeshOptimizer(DX::OptimizeMesh)로 꼭짓점을 합치고 캐시, 오버드로, 가져오기 순서로 정렬한 뒤 씁니다.
+// 쿠킹한 파일을 AssetPacker -a 65536으로 팩에 넣으면 DX::CreateCookedMesh가 매핑에서 바로 업로드할 수 있습니다.
+// 샘플 렌더러는 아직 큐브를 코드에서 만들므로 쿠킹된 메시를 읽지 않습니다.
+// -i는 헤더를 출력하고 모든 인덱스가 꼭짓점 범위 안에 있는지 검증합니다.
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "../Common/CookedMeshFormat.h"
+#include "../Common/GltfFormat.h"
+#include "../Common/MeshOptimizer.h"
+#include "../Common/ObjFormat.h"
+
+namespace
+{
+	// 큰 입력을 한 번에 읽습니다. 스트림 반복자로 읽는 것보다 수십 배 빠릅니다.
+	bool ReadFile(const std::string& path, std::vector<std::uint8_t>* data)
+	{
+		std::ifstream stream(path, std::ios::binary | std::ios::ate);
+		if (!stream)
+		{
+			return false;
+		}
+		const std::streamoff size = stream.tellg();
+		data->resize(static_cast<std::size_t>(size));
+		stream.seekg(0);
+		return static_cast<bool>(stream.read(reinterpret_cast<char*>(data->data()), size));
+	}
+
+	std::string GetDirectory(const std::string& path)
+	{
+		const std::size_t separator = path.find_last_of("/\\");
+		return separator == std::string::npos ? std::string() : path.substr(0, separator + 1);
+	}
+
+	std::string GetExtension(const std::string& path)
+	{
+		const std::size_t dot = path.find_last_of('.');
+		std::string extension = dot == std::string::npos ? std::string() : path.substr(dot + 1);
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+		return extension;
+	}
+
+	double GetSeconds(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	int Info(const std::string& path)
+	{
+		std::vector<std::uint8_t> file;
+		DX::CookedMeshView view;
+		if (!ReadFile(path, &file) || !DX::ParseCookedMesh(file.data(), file.size(), &view))
+		{
+			std::fprintf(stderr, "%s: 쿠킹된 메시가 아니거나 손상되었습니다.\n", path.c_str());
+			return 1;
+		}
+
+		const DX::CookedMeshHeader& header = view.header;
+		bool valid = true;
+		for (std::uint32_t i = 0; i < header.indexCount && valid; i++)
+		{
+			std::uint32_t index = 0;
+			std::memcpy(&index, view.indices + i * static_cast<std::size_t>(header.indexSize), header.indexSize);
+			valid = index < header.vertexCount;
+		}
+
+		std::printf("꼭짓점 %u개(%u바이트), 인덱스 %u개(%u비트)%s%s\n",
+			header.vertexCount, header.vertexStride, header.indexCount, header.indexSize * 8,
+			(header.flags & DX::c_cookedMeshHasNormals) != 0 ? ", 법선" : "",
+			(header.flags & DX::c_cookedMeshHasTexCoords) != 0 ? ", 텍스처 좌표" : "");
+		std::printf("경계 (%g, %g, %g) - (%g, %g, %g)\n",
+			header.boundsMin[0], header.boundsMin[1], header.boundsMin[2],
+			header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+		if (!valid)
+		{
+			std::fprintf(stderr, "%s: 인덱스가 꼭짓점 범위를 벗어납니다.\n", path.c_str());
+			return 1;
+		}
+		return 0;
+	}
+
+	int Cook(const std::string& inputPath, const std::string& outputPath)
+	{
+		const std::string extension = GetExtension(inputPath);
+		if (extension != "obj" && extension != "gltf" && extension != "glb")
+		{
+			std::fprintf(stderr, "%s: 지원하지 않는 형식입니다(.obj, .gltf, .glb).\n", inputPath.c_str());
+			return 1;
+		}
+
+		std::vector<std::uint8_t> input;
+		if (!ReadFile(inputPath, &input))
+		{
+			std::fprintf(stderr, "%s: 파일을 읽을 수 없습니다.\n", inputPath.c_str());
+			return 1;
+		}
+
+		DX::ImportedMesh mesh;
+		const auto parseStart = std::chrono::steady_clock::now();
+		bool parsed;
+		if (extension == "obj")
+		{
+			parsed = DX::ParseObj(reinterpret_cast<const char*>(input.data()), input.size(), &mesh);
+		}
+		else
+		{
+			const std::string directory = GetDirectory(inputPath);
+			parsed = DX::ParseGltf(input.data(), input.size(), [&directory](const std::string& uri, std::vector<std::uint8_t>* data)
+			{
+				return ReadFile(directory + uri, data);
+			}, &mesh);
+		}
+		const double parseSeconds = GetSeconds(parseStart);
+		if (!parsed)
+		{
+			std::fprintf(stderr, "%s: 형식이 맞지 않거나 지원하지 않는 기능을 사용합니다.\n", inputPath.c_str());
+			return 1;
+		}
+
+		// 최적화기는 꼭짓점 바이트 배열을 다루므로 MeshVertex 배열을 바이트로 옮겨 처리한 뒤 되돌립니다.
+		const auto optimizeStart = std::chrono::steady_clock::now();
+		std::vector<std::uint8_t> vertexBytes(mesh.vertices.size() * sizeof(DX::MeshVertex));
+		if (!vertexBytes.empty())
+		{
+			std::memcpy(vertexBytes.data(), mesh.vertices.data(), vertexBytes.size());
+		}
+		const DX::MeshOptimizationReport report = DX::OptimizeMesh(&mesh.indices, &vertexBytes, sizeof(DX::MeshVertex), 0);
+		mesh.vertices.resize(vertexBytes.size() / sizeof(DX::MeshVertex));
+		if (!vertexBytes.empty())
+		{
+			std::memcpy(mesh.vertices.data(), vertexBytes.data(), vertexBytes.size());
+		}
+		const double optimizeSeconds = GetSeconds(optimizeStart);
+
+		std::vector<std::uint8_t> file;
+		if (!DX::SerializeCookedMesh(mesh, &file))
+		{
+			std::fprintf(stderr, "%s: 메시가 너무 큽니다(4GB).\n", inputPath.c_str());
+			return 1;
+		}
+
+		std::ofstream stream(outputPath, std::ios::binary | std::ios::trunc);
+		stream.write(reinterpret_cast<const char*>(file.data()), file.size());
+		if (!stream)
+		{
+			std::fprintf(stderr, "%s: 파일을 쓸 수 없습니다.\n", outputPath.c_str());
+			return 1;
+		}
+
+		std::printf("%s: 꼭짓점 %u개, 삼각형 %u개, %llu바이트\n", outputPath.c_str(),
+			static_cast<unsigned>(mesh.vertices.size()), static_cast<unsigned>(mesh.indices.size() / 3), static_cast<unsigned long long>(file.size()));
+		std::printf("가져오기 %.1f ms (%.1f MB/s, 스레드 %u개)\n",
+			parseSeconds * 1000.0, input.size() / (1024.0 * 1024.0) / (std::max)(parseSeconds, 1e-9), DX::GetHardwareThreadCount());
+		std::printf("최적화 %.1f ms: 꼭짓점 %u -> %u개, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n",
+			optimizeSeconds * 1000.0,
+			report.vertexCountBefore, report.vertexCountAfter,
+			report.before.acmr, report.after.acmr,
+			report.before.atvr, report.after.atvr);
+		return 0;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc == 3 && std::string(argv[1]) == "-i")
+	{
+		return Info(argv[2]);
+	}
+
+	if (argc != 3)
+	{
+		std::fprintf(stderr, "사용법: MeshCooker <입력.obj|.gltf|.glb> <출력.mesh>\n       MeshCooker -i <메시>\n");
+		return 1;
+	}
+
+	return Cook(argv[1], argv[2]);
+}